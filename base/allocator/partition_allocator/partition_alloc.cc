@@ -191,6 +191,10 @@ void PartitionRootGeneric::Init() {
   *bucket_ptr = internal::PartitionBucket::get_sentinel_bucket();
 }
 
+void PartitionRootGeneric::EnableThreadCache() {
+  internal::PartitionThreadCache::EnableForRoot(this);
+}
+
 bool PartitionReallocDirectMappedInPlace(PartitionRootGeneric* root,
                                          internal::PartitionPage* page,
                                          size_t raw_size) {
@@ -508,6 +512,10 @@ void PartitionRoot::PurgeMemory(int flags) {
 }
 
 void PartitionRootGeneric::PurgeMemory(int flags) {
+  // Slots held by thread caches keep their pages from being empty.
+  if (this->with_thread_cache)
+    internal::PartitionThreadCache::PurgeAll();
+
   subtle::SpinLock::Guard guard(this->lock);
   if (flags & PartitionPurgeDecommitEmptyPages)
     DecommitEmptyPages();
@@ -681,6 +689,10 @@ void PartitionRootGeneric::DumpStats(const char* partition_name,
 
   stats.total_resident_bytes += direct_mapped_allocations_total_size;
   stats.total_active_bytes += direct_mapped_allocations_total_size;
+  if (this->with_thread_cache) {
+    stats.total_thread_cache_bytes =
+        internal::PartitionThreadCache::GetCachedBytes();
+  }
   dumper->PartitionDumpTotals(partition_name, &stats);
 }
 
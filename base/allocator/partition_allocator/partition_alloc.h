@@ -69,6 +69,7 @@
 #include "base/allocator/partition_allocator/partition_cookie.h"
 #include "base/allocator/partition_allocator/partition_page.h"
 #include "base/allocator/partition_allocator/partition_root_base.h"
+#include "base/allocator/partition_allocator/partition_thread_cache.h"
 #include "base/allocator/partition_allocator/spin_lock.h"
 #include "base/base_export.h"
 #include "base/bits.h"
@@ -140,10 +141,18 @@ struct BASE_EXPORT PartitionRootGeneric : public internal::PartitionRootBase {
       bucket_lookups[((kBitsPerSizeT + 1) * kGenericNumBucketsPerOrder) + 1] =
           {};
   internal::PartitionBucket buckets[kGenericNumBuckets] = {};
+  // True if small allocations go through internal::PartitionThreadCache.
+  bool with_thread_cache = false;
 
   // Public API.
   void Init();
 
+  // Makes allocations of up to internal::PartitionThreadCache::kMaxSlotSize
+  // bytes use a per-thread cache of free slots, which avoids taking |lock|
+  // most of the time. Must be called after Init(), before other threads
+  // allocate, and for at most one partition that is never destroyed.
+  void EnableThreadCache();
+
   ALWAYS_INLINE void* Alloc(size_t size, const char* type_name);
   ALWAYS_INLINE void Free(void* ptr);
 
@@ -170,6 +179,8 @@ struct PartitionMemoryStats {
   size_t total_active_bytes;     // Total active bytes in the partition.
   size_t total_decommittable_bytes;  // Total bytes that could be decommitted.
   size_t total_discardable_bytes;    // Total bytes that could be discarded.
+  size_t total_thread_cache_bytes;   // Total bytes of free slots held by
+                                     // thread caches, counted as active.
 };
 
 // Struct used to retrieve memory statistics about a partition bucket. Used by
@@ -356,7 +367,15 @@ ALWAYS_INLINE void* PartitionAllocGenericFlags(PartitionRootGeneric* root,
   size = internal::PartitionCookieSizeAdjustAdd(size);
   internal::PartitionBucket* bucket = PartitionGenericSizeToBucket(root, size);
   void* ret = nullptr;
-  {
+  if (root->with_thread_cache &&
+      size <= internal::PartitionThreadCache::kMaxSlotSize) {
+    size_t bucket_index = bucket - root->buckets;
+    internal::PartitionThreadCache* thread_cache =
+        internal::PartitionThreadCache::Get();
+    ret = thread_cache->Alloc(bucket_index);
+    if (UNLIKELY(!ret))
+      ret = thread_cache->AllocAndFill(bucket_index, flags, size);
+  } else {
     subtle::SpinLock::Guard guard(root->lock);
     ret = root->AllocFromBucket(bucket, flags, size);
   }
@@ -380,13 +399,20 @@ ALWAYS_INLINE void PartitionRootGeneric::Free(void* ptr) {
     return;
 
   PartitionAllocHooks::FreeHookIfEnabled(ptr);
-  ptr = internal::PartitionCookieFreePointerAdjust(ptr);
-  internal::PartitionPage* page = internal::PartitionPage::FromPointer(ptr);
+  void* slot = internal::PartitionCookieFreePointerAdjust(ptr);
+  internal::PartitionPage* page = internal::PartitionPage::FromPointer(slot);
   // TODO(palmer): See if we can afford to make this a CHECK.
   DCHECK(IsValidPage(page));
+  if (this->with_thread_cache &&
+      page->bucket->slot_size <= internal::PartitionThreadCache::kMaxSlotSize) {
+    // The thread cache takes the pointer given to the application.
+    internal::PartitionThreadCache::Get()->Free(ptr,
+                                                page->bucket - this->buckets);
+    return;
+  }
   {
     subtle::SpinLock::Guard guard(this->lock);
-    page->Free(ptr);
+    page->Free(slot);
   }
 #endif
 }
@@ -0,0 +1,225 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/partition_allocator/partition_thread_cache.h"
+
+#include <algorithm>
+
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/allocator/partition_allocator/partition_page.h"
+#include "base/allocator/partition_allocator/spin_lock.h"
+#include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/no_destructor.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+// Memory pressure halves the cache limits, down to 1/8 of their initial size.
+const int kMaxLimitShift = 3;
+
+PartitionRootGeneric* g_root = nullptr;
+
+// Guards |g_caches| and |g_limit_shift|.
+LazyInstance<subtle::SpinLock>::Leaky g_caches_lock = LAZY_INSTANCE_INITIALIZER;
+PartitionThreadCache* g_caches = nullptr;
+std::atomic<int> g_limit_shift{0};
+
+}  // namespace
+
+const size_t PartitionThreadCache::kMaxSlotSize;
+const size_t PartitionThreadCache::kNumBuckets;
+const size_t PartitionThreadCache::kMaxBytesPerBucket;
+const uint16_t PartitionThreadCache::kMaxSlotsPerBucket;
+
+// static
+void PartitionThreadCache::EnableForRoot(PartitionRootGeneric* root) {
+  DCHECK(root->initialized);
+  CHECK(!g_root);
+  // Cached buckets must all hold slots of at most kMaxSlotSize.
+  DCHECK_EQ(kMaxSlotSize, root->buckets[kNumBuckets - 1].slot_size);
+  g_root = root;
+  root->with_thread_cache = true;
+
+  // Notifications are only delivered synchronously, since the enabling thread
+  // may have no task runner.
+  static NoDestructor<MemoryPressureListener> memory_pressure_listener(
+      BindRepeating([](MemoryPressureListener::MemoryPressureLevel) {}),
+      BindRepeating(&PartitionThreadCache::OnMemoryPressure));
+}
+
+// static
+PartitionThreadCache* PartitionThreadCache::Get() {
+  ThreadLocalStorage::Slot& slot = CurrentCache();
+  PartitionThreadCache* cache = static_cast<PartitionThreadCache*>(slot.Get());
+  if (UNLIKELY(!cache)) {
+    DCHECK(g_root);
+    cache = new PartitionThreadCache(g_root);
+    slot.Set(cache);
+  }
+  return cache;
+}
+
+// static
+size_t PartitionThreadCache::GetCachedBytes() {
+  subtle::SpinLock::Guard guard(g_caches_lock.Get());
+  size_t cached_bytes = 0;
+  for (PartitionThreadCache* cache = g_caches; cache; cache = cache->next_)
+    cached_bytes += cache->cached_bytes_.load(std::memory_order_relaxed);
+  return cached_bytes;
+}
+
+// static
+void PartitionThreadCache::PurgeAll() {
+  {
+    subtle::SpinLock::Guard guard(g_caches_lock.Get());
+    for (PartitionThreadCache* cache = g_caches; cache; cache = cache->next_)
+      cache->should_purge_.store(true, std::memory_order_relaxed);
+  }
+
+  PartitionThreadCache* cache =
+      static_cast<PartitionThreadCache*>(CurrentCache().Get());
+  if (cache)
+    cache->Purge();
+}
+
+// static
+void PartitionThreadCache::OnMemoryPressure(
+    MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL) {
+    subtle::SpinLock::Guard guard(g_caches_lock.Get());
+    int limit_shift = g_limit_shift.load(std::memory_order_relaxed);
+    if (limit_shift < kMaxLimitShift)
+      g_limit_shift.store(limit_shift + 1, std::memory_order_relaxed);
+  }
+  PurgeAll();
+}
+
+void* PartitionThreadCache::AllocAndFill(size_t bucket_index,
+                                         int flags,
+                                         size_t size) {
+  DCHECK_LT(bucket_index, kNumBuckets);
+  if (should_purge_.load(std::memory_order_relaxed))
+    Purge();
+
+  Bucket& bucket = buckets_[bucket_index];
+  DCHECK(!bucket.freelist_head);
+  PartitionBucket* root_bucket = &root_->buckets[bucket_index];
+  void* ret;
+  {
+    subtle::SpinLock::Guard guard(root_->lock);
+    ret = root_->AllocFromBucket(root_bucket, flags, size);
+    if (!ret)
+      return nullptr;
+
+    // Fill half the cache, so that the next frees don't flush it right away.
+    // Running out of memory here is not a failure of this allocation.
+    for (uint16_t i = 0; i < bucket.limit / 2; ++i) {
+      void* slot = root_->AllocFromBucket(
+          root_bucket, PartitionAllocReturnNull, root_bucket->slot_size);
+      if (!slot)
+        break;
+      auto* entry = static_cast<PartitionFreelistEntry*>(slot);
+      entry->next = PartitionFreelistEntry::Transform(bucket.freelist_head);
+      bucket.freelist_head = entry;
+      ++bucket.count;
+    }
+  }
+  cached_bytes_.store(cached_bytes_.load(std::memory_order_relaxed) +
+                          bucket.count * bucket.slot_size,
+                      std::memory_order_relaxed);
+  return ret;
+}
+
+void PartitionThreadCache::Purge() {
+  should_purge_.store(false, std::memory_order_relaxed);
+  {
+    subtle::SpinLock::Guard guard(root_->lock);
+    for (size_t i = 0; i < kNumBuckets; ++i)
+      FlushBucketWhileLocked(i, 0);
+  }
+  UpdateLimits();
+}
+
+PartitionThreadCache::PartitionThreadCache(PartitionRootGeneric* root)
+    : root_(root) {
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    Bucket& bucket = buckets_[i];
+    bucket.freelist_head = nullptr;
+    bucket.count = 0;
+    bucket.slot_size = root_->buckets[i].slot_size;
+  }
+  UpdateLimits();
+
+  subtle::SpinLock::Guard guard(g_caches_lock.Get());
+  next_ = g_caches;
+  if (next_)
+    next_->prev_ = this;
+  g_caches = this;
+}
+
+PartitionThreadCache::~PartitionThreadCache() {
+  Purge();
+
+  subtle::SpinLock::Guard guard(g_caches_lock.Get());
+  if (prev_)
+    prev_->next_ = next_;
+  else
+    g_caches = next_;
+  if (next_)
+    next_->prev_ = prev_;
+}
+
+void PartitionThreadCache::FlushBucket(size_t bucket_index,
+                                       uint16_t count_to_keep) {
+  subtle::SpinLock::Guard guard(root_->lock);
+  FlushBucketWhileLocked(bucket_index, count_to_keep);
+}
+
+void PartitionThreadCache::FlushBucketWhileLocked(size_t bucket_index,
+                                                  uint16_t count_to_keep) {
+  Bucket& bucket = buckets_[bucket_index];
+  if (bucket.count <= count_to_keep)
+    return;
+
+  cached_bytes_.store(cached_bytes_.load(std::memory_order_relaxed) -
+                          (bucket.count - count_to_keep) * bucket.slot_size,
+                      std::memory_order_relaxed);
+  while (bucket.count > count_to_keep) {
+    PartitionFreelistEntry* entry = bucket.freelist_head;
+    bucket.freelist_head = PartitionFreelistEntry::Transform(entry->next);
+    --bucket.count;
+    // Give the slot back as PartitionRootGeneric::Free() would.
+    void* slot = PartitionCookieFreePointerAdjust(entry);
+    PartitionPage::FromPointer(slot)->Free(slot);
+  }
+}
+
+void PartitionThreadCache::UpdateLimits() {
+  const int limit_shift = g_limit_shift.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    Bucket& bucket = buckets_[i];
+    size_t limit = kMaxSlotsPerBucket;
+    if (bucket.slot_size)
+      limit = std::min(limit, kMaxBytesPerBucket / bucket.slot_size);
+    bucket.limit = static_cast<uint16_t>(std::max<size_t>(limit >> limit_shift,
+                                                          1));
+  }
+}
+
+// static
+ThreadLocalStorage::Slot& PartitionThreadCache::CurrentCache() {
+  static NoDestructor<ThreadLocalStorage::Slot> current_cache(&Delete);
+  return *current_cache;
+}
+
+// static
+void PartitionThreadCache::Delete(void* cache) {
+  delete static_cast<PartitionThreadCache*>(cache);
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,188 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_ALLOCATOR_PARTITION_ALLOCATOR_PARTITION_THREAD_CACHE_H_
+#define BASE_ALLOCATOR_PARTITION_ALLOCATOR_PARTITION_THREAD_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "base/allocator/partition_allocator/partition_alloc_constants.h"
+#include "base/allocator/partition_allocator/partition_cookie.h"
+#include "base/allocator/partition_allocator/partition_freelist_entry.h"
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+
+struct PartitionRootGeneric;
+
+namespace internal {
+
+// The allocation order of the largest slot size that is cached.
+static const size_t kThreadCacheMaxSlotSizeOrder = 9;  // 256 bytes.
+
+// PartitionThreadCache keeps a few free slots of each small bucket of a
+// PartitionRootGeneric per thread, so that most allocations and frees of small
+// sizes don't take the root's lock. Slots move between a thread's cache and
+// the root in batches, so threads allocating from the same partition only
+// contend on the lock once per batch.
+//
+// Only one root per process can have thread caches, and it must outlive every
+// thread that allocates from it (in practice, it is never destroyed). The
+// cached slots count as allocated in the root's statistics, and are reported
+// separately by GetCachedBytes().
+//
+// Caches are purged, and shrunk on critical pressure, when memory pressure is
+// signaled. Each thread purges its own cache on its next free, since the
+// slots can't be touched from other threads.
+class BASE_EXPORT PartitionThreadCache {
+ public:
+  // Slots of at most this size are cached. Their buckets are the first
+  // kNumBuckets of the root.
+  static const size_t kMaxSlotSize = 1 << (kThreadCacheMaxSlotSizeOrder - 1);
+  static const size_t kNumBuckets =
+      (kThreadCacheMaxSlotSizeOrder - kGenericMinBucketedOrder) *
+          kGenericNumBucketsPerOrder +
+      1;
+
+  // Each bucket caches up to this many bytes, and no more than
+  // kMaxSlotsPerBucket slots.
+  static const size_t kMaxBytesPerBucket = 4 * 1024;
+  static const uint16_t kMaxSlotsPerBucket = 64;
+
+  // Makes |root| use thread caches, which must be done once, before other
+  // threads allocate from it, and for a single root per process.
+  static void EnableForRoot(PartitionRootGeneric* root);
+
+  // Returns the calling thread's cache, creating it if necessary.
+  static PartitionThreadCache* Get();
+
+  // Returns the total size of the slots held by all thread caches.
+  static size_t GetCachedBytes();
+
+  // Purges the calling thread's cache, and asks the other threads to purge
+  // theirs.
+  static void PurgeAll();
+
+  // Called by a MemoryPressureListener that EnableForRoot() creates.
+  static void OnMemoryPressure(
+      MemoryPressureListener::MemoryPressureLevel level);
+
+  // Returns a slot of the bucket |bucket_index| of the root, as a pointer
+  // that can be given to the application, or null if there is none cached.
+  ALWAYS_INLINE void* Alloc(size_t bucket_index);
+
+  // Allocates a slot of |size| bytes (cookies included) from the root, along
+  // with a batch of other slots of the same bucket for the next Alloc()
+  // calls. |flags| are the same as for PartitionAllocGenericFlags().
+  NOINLINE void* AllocAndFill(size_t bucket_index, int flags, size_t size);
+
+  // Caches |ptr|, a pointer given to the application for a slot of the bucket
+  // |bucket_index| of the root.
+  ALWAYS_INLINE void Free(void* ptr, size_t bucket_index);
+
+  // Returns all the cached slots to the root.
+  void Purge();
+
+ private:
+  struct Bucket {
+    PartitionFreelistEntry* freelist_head;
+    uint16_t count;
+    uint16_t limit;
+    uint32_t slot_size;
+  };
+
+  explicit PartitionThreadCache(PartitionRootGeneric* root);
+  ~PartitionThreadCache();
+
+  // Returns slots of the bucket |bucket_index| to the root until only
+  // |count_to_keep| are left.
+  NOINLINE void FlushBucket(size_t bucket_index, uint16_t count_to_keep);
+
+  // Same as FlushBucket(), but the root's lock must be held.
+  void FlushBucketWhileLocked(size_t bucket_index, uint16_t count_to_keep);
+
+  // Sets the limits of the buckets, after memory pressure shrunk them.
+  void UpdateLimits();
+
+  // The slot holding the calling thread's cache, which is destroyed by
+  // Delete() when the thread exits.
+  static ThreadLocalStorage::Slot& CurrentCache();
+  static void Delete(void* cache);
+
+  PartitionRootGeneric* const root_;
+
+  Bucket buckets_[kNumBuckets];
+
+  // Set by other threads to ask for a purge.
+  std::atomic<bool> should_purge_{false};
+
+  // Only written by the thread owning the cache, and read by GetCachedBytes().
+  std::atomic<size_t> cached_bytes_{0};
+
+  // All the caches are in a list, guarded by a global lock.
+  PartitionThreadCache* prev_ = nullptr;
+  PartitionThreadCache* next_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(PartitionThreadCache);
+};
+
+ALWAYS_INLINE void* PartitionThreadCache::Alloc(size_t bucket_index) {
+  DCHECK_LT(bucket_index, kNumBuckets);
+  Bucket& bucket = buckets_[bucket_index];
+  PartitionFreelistEntry* entry = bucket.freelist_head;
+  if (UNLIKELY(!entry))
+    return nullptr;
+
+  DCHECK(bucket.count);
+  bucket.freelist_head = PartitionFreelistEntry::Transform(entry->next);
+  --bucket.count;
+  cached_bytes_.store(
+      cached_bytes_.load(std::memory_order_relaxed) - bucket.slot_size,
+      std::memory_order_relaxed);
+#if DCHECK_IS_ON()
+  // The cookies around the slot are still in place, only refill the slot.
+  memset(entry, kUninitializedByte,
+         PartitionCookieSizeAdjustSubtract(bucket.slot_size));
+#endif
+  return entry;
+}
+
+ALWAYS_INLINE void PartitionThreadCache::Free(void* ptr, size_t bucket_index) {
+  DCHECK_LT(bucket_index, kNumBuckets);
+  Bucket& bucket = buckets_[bucket_index];
+#if DCHECK_IS_ON()
+  // Same checks as PartitionPage::Free(), but the cookies are kept.
+  size_t no_cookie_size = PartitionCookieSizeAdjustSubtract(bucket.slot_size);
+  PartitionCookieCheckValue(PartitionCookieFreePointerAdjust(ptr));
+  PartitionCookieCheckValue(static_cast<char*>(ptr) + no_cookie_size);
+  memset(ptr, kFreedByte, no_cookie_size);
+#endif
+  CHECK(ptr != bucket.freelist_head);  // Catches an immediate double free.
+  PartitionFreelistEntry* entry = static_cast<PartitionFreelistEntry*>(ptr);
+  entry->next = PartitionFreelistEntry::Transform(bucket.freelist_head);
+  bucket.freelist_head = entry;
+  ++bucket.count;
+  cached_bytes_.store(
+      cached_bytes_.load(std::memory_order_relaxed) + bucket.slot_size,
+      std::memory_order_relaxed);
+
+  if (UNLIKELY(bucket.count > bucket.limit))
+    FlushBucket(bucket_index, bucket.limit / 2);
+  else if (UNLIKELY(should_purge_.load(std::memory_order_relaxed)))
+    Purge();
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_ALLOCATOR_PARTITION_ALLOCATOR_PARTITION_THREAD_CACHE_H_
@@ -0,0 +1,172 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/partition_allocator/partition_thread_cache.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if !defined(MEMORY_TOOL_REPLACES_ALLOCATOR)
+
+namespace base {
+namespace internal {
+
+namespace {
+
+const char* type_name = nullptr;
+const size_t kSmallSize = 32;
+
+// Thread caches can only be enabled for one partition, which must outlive all
+// the threads, so all the tests share a leaked one.
+PartitionRootGeneric* GetRoot() {
+  static PartitionRootGeneric* root = [] {
+    PartitionAllocatorGeneric* allocator = new PartitionAllocatorGeneric;
+    allocator->init();
+    allocator->root()->EnableThreadCache();
+    return allocator->root();
+  }();
+  return root;
+}
+
+class AllocatingThread : public SimpleThread {
+ public:
+  explicit AllocatingThread(int num_allocations)
+      : SimpleThread("AllocatingThread", Options()),
+        num_allocations_(num_allocations) {}
+
+  void Run() override {
+    std::vector<void*> ptrs;
+    for (int round = 0; round < 10; ++round) {
+      for (int i = 0; i < num_allocations_; ++i) {
+        size_t size = 8 + (i % 16) * 8;
+        void* ptr = GetRoot()->Alloc(size, type_name);
+        memset(ptr, round, size);
+        ptrs.push_back(ptr);
+      }
+      for (void* ptr : ptrs)
+        GetRoot()->Free(ptr);
+      ptrs.clear();
+    }
+    EXPECT_LT(0u, PartitionThreadCache::GetCachedBytes());
+  }
+
+ private:
+  const int num_allocations_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocatingThread);
+};
+
+class MockPartitionStatsDumper : public PartitionStatsDumper {
+ public:
+  void PartitionDumpTotals(const char* partition_name,
+                           const PartitionMemoryStats* stats) override {
+    thread_cache_bytes = stats->total_thread_cache_bytes;
+  }
+
+  void PartitionsDumpBucketStats(
+      const char* partition_name,
+      const PartitionBucketMemoryStats* stats) override {}
+
+  size_t thread_cache_bytes = 0;
+};
+
+}  // namespace
+
+class PartitionThreadCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    GetRoot();
+    PartitionThreadCache::PurgeAll();
+    ASSERT_EQ(0u, PartitionThreadCache::GetCachedBytes());
+  }
+
+  void TearDown() override { PartitionThreadCache::PurgeAll(); }
+};
+
+TEST_F(PartitionThreadCacheTest, SmallAllocationsAreCached) {
+  void* ptr = GetRoot()->Alloc(kSmallSize, type_name);
+  ASSERT_TRUE(ptr);
+  // The cache was filled with other slots of the same bucket.
+  size_t cached_bytes = PartitionThreadCache::GetCachedBytes();
+  EXPECT_LT(0u, cached_bytes);
+
+  GetRoot()->Free(ptr);
+  EXPECT_LT(cached_bytes, PartitionThreadCache::GetCachedBytes());
+
+  // The slot that was freed last is reused first.
+  EXPECT_EQ(ptr, GetRoot()->Alloc(kSmallSize, type_name));
+  EXPECT_EQ(cached_bytes, PartitionThreadCache::GetCachedBytes());
+  GetRoot()->Free(ptr);
+
+  PartitionThreadCache::PurgeAll();
+  EXPECT_EQ(0u, PartitionThreadCache::GetCachedBytes());
+}
+
+TEST_F(PartitionThreadCacheTest, LargeAllocationsAreNotCached) {
+  void* ptr =
+      GetRoot()->Alloc(PartitionThreadCache::kMaxSlotSize + 1, type_name);
+  ASSERT_TRUE(ptr);
+  GetRoot()->Free(ptr);
+  EXPECT_EQ(0u, PartitionThreadCache::GetCachedBytes());
+}
+
+TEST_F(PartitionThreadCacheTest, FullBucketsAreFlushed) {
+  const size_t kNumAllocations = 4 * PartitionThreadCache::kMaxSlotsPerBucket;
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < kNumAllocations; ++i)
+    ptrs.push_back(GetRoot()->Alloc(kSmallSize, type_name));
+  for (void* ptr : ptrs)
+    GetRoot()->Free(ptr);
+
+  EXPECT_LT(0u, PartitionThreadCache::GetCachedBytes());
+  EXPECT_GE(PartitionThreadCache::kMaxBytesPerBucket,
+            PartitionThreadCache::GetCachedBytes());
+}
+
+TEST_F(PartitionThreadCacheTest, ThreadsReturnTheirCacheOnExit) {
+  const size_t kNumThreads = 4;
+  std::vector<std::unique_ptr<AllocatingThread>> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<AllocatingThread>(1000));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Join();
+
+  EXPECT_EQ(0u, PartitionThreadCache::GetCachedBytes());
+
+  // All the slots are back in the root, so its pages can be purged.
+  GetRoot()->PurgeMemory(PartitionPurgeDecommitEmptyPages);
+}
+
+TEST_F(PartitionThreadCacheTest, PurgeOnMemoryPressure) {
+  void* ptr = GetRoot()->Alloc(kSmallSize, type_name);
+  GetRoot()->Free(ptr);
+  EXPECT_LT(0u, PartitionThreadCache::GetCachedBytes());
+
+  MemoryPressureListener::SimulatePressureNotification(
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_EQ(0u, PartitionThreadCache::GetCachedBytes());
+}
+
+TEST_F(PartitionThreadCacheTest, DumpStats) {
+  void* ptr = GetRoot()->Alloc(kSmallSize, type_name);
+  GetRoot()->Free(ptr);
+
+  MockPartitionStatsDumper dumper;
+  GetRoot()->DumpStats("thread_cache_test", true /* is_light_dump */,
+                       &dumper);
+  EXPECT_LT(0u, dumper.thread_cache_bytes);
+  EXPECT_EQ(PartitionThreadCache::GetCachedBytes(), dumper.thread_cache_bytes);
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // !defined(MEMORY_TOOL_REPLACES_ALLOCATOR)
@@ -0,0 +1,315 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_map.h"
+#include "base/logging.h"
+
+namespace base {
+
+// flat_hash_map is a container with a std::unordered_map-like interface that
+// stores its contents inline in an open-addressing hash table.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - No allocation per item: values are stored in a single array.
+//  - Lookups usually touch one cache line of metadata, compared 16 slots at a
+//    time on x86, before comparing a single key.
+//  - Inserts and removals are O(1).
+//
+// CONS
+//
+//  - Iterators and references are invalidated by insertions.
+//  - Iteration order is unspecified.
+//  - Values are moved when the table grows.
+//
+// IMPORTANT NOTES
+//
+//  - Like flat_map, the value_type is std::pair<Key, Mapped>: keys must not be
+//    modified through iterators.
+//  - Erasing doesn't invalidate iterators to other values, so it is safe to
+//    erase the current element in a loop using the iterator erase() returns.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from flat_hash_table. Please see
+// flat_hash_table.h for more details for most of these functions. As a quick
+// reference, the functions available are:
+//
+// Constructors (duplicates keep the first):
+//   flat_hash_map(size_t bucket_count = 0, const Hash& = Hash(),
+//                 const Eq& = Eq());
+//   flat_hash_map(InputIterator first, InputIterator last,
+//                 size_t bucket_count = 0, const Hash& = Hash(),
+//                 const Eq& = Eq());
+//   flat_hash_map(const flat_hash_map&);
+//   flat_hash_map(flat_hash_map&&);
+//   flat_hash_map(std::initializer_list<value_type> ilist,
+//                 size_t bucket_count = 0, const Hash& = Hash(),
+//                 const Eq& = Eq());
+//
+// Assignment functions:
+//   flat_hash_map& operator=(const flat_hash_map&);
+//   flat_hash_map& operator=(flat_hash_map&&);
+//   flat_hash_map& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   size_t max_size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator       begin();
+//   const_iterator begin() const;
+//   const_iterator cbegin() const;
+//   iterator       end();
+//   const_iterator end() const;
+//   const_iterator cend() const;
+//
+// Insert and accessor functions:
+//   mapped_type&         operator[](const key_type&);
+//   mapped_type&         operator[](key_type&&);
+//   mapped_type&         at(const K&);
+//   const mapped_type&   at(const K&) const;
+//   pair<iterator, bool> insert(const value_type&);
+//   pair<iterator, bool> insert(value_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> insert_or_assign(K&&, M&&);
+//   pair<iterator, bool> emplace(Args&&...);
+//   pair<iterator, bool> try_emplace(K&&, Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   template <class K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//
+// General functions:
+//   void swap(flat_hash_map&&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_map&, const flat_hash_map);
+//   bool operator!=(const flat_hash_map&, const flat_hash_map);
+//
+template <class Key,
+          class Mapped,
+          class Hash = std::hash<Key>,
+          class Eq = std::equal_to<Key>>
+class flat_hash_map
+    : public ::base::internal::flat_hash_table<
+          Key,
+          std::pair<Key, Mapped>,
+          ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+          Hash,
+          Eq> {
+ private:
+  using table = typename ::base::internal::flat_hash_table<
+      Key,
+      std::pair<Key, Mapped>,
+      ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+      Hash,
+      Eq>;
+
+ public:
+  using key_type = typename table::key_type;
+  using mapped_type = Mapped;
+  using value_type = typename table::value_type;
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+
+  // --------------------------------------------------------------------------
+  // Lifetime and assignments.
+  //
+  // As in flat_map, these are spelled out rather than inherited from |table|
+  // because of https://gcc.gnu.org/bugzilla/show_bug.cgi?id=84782.
+
+  flat_hash_map() = default;
+  explicit flat_hash_map(size_t bucket_count,
+                         const Hash& hash = Hash(),
+                         const Eq& eq = Eq());
+
+  template <class InputIterator>
+  flat_hash_map(InputIterator first,
+                InputIterator last,
+                size_t bucket_count = 0,
+                const Hash& hash = Hash(),
+                const Eq& eq = Eq());
+
+  flat_hash_map(const flat_hash_map&) = default;
+  flat_hash_map(flat_hash_map&&) noexcept = default;
+
+  flat_hash_map(std::initializer_list<value_type> ilist,
+                size_t bucket_count = 0,
+                const Hash& hash = Hash(),
+                const Eq& eq = Eq());
+
+  ~flat_hash_map() = default;
+
+  flat_hash_map& operator=(const flat_hash_map&) = default;
+  flat_hash_map& operator=(flat_hash_map&&) = default;
+  // Takes the first if there are duplicates in the initializer list.
+  flat_hash_map& operator=(std::initializer_list<value_type> ilist);
+
+  // --------------------------------------------------------------------------
+  // Map-specific insert and accessor operations.
+  //
+  // Normal insert() functions are inherited from flat_hash_table.
+  //
+  // Assume that every insertion invalidates iterators and references.
+
+  mapped_type& operator[](const key_type& key);
+  mapped_type& operator[](key_type&& key);
+
+  // The key must be present.
+  template <class K>
+  mapped_type& at(const K& key);
+  template <class K>
+  const mapped_type& at(const K& key) const;
+
+  template <class K, class M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj);
+
+  template <class K, class... Args>
+  std::enable_if_t<std::is_constructible<key_type, K&&>::value,
+                   std::pair<iterator, bool>>
+  try_emplace(K&& key, Args&&... args);
+
+  // --------------------------------------------------------------------------
+  // General operations.
+  //
+  // Assume that swap invalidates iterators and references.
+
+  void swap(flat_hash_map& other) noexcept;
+
+  friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Lifetime.
+
+template <class Key, class Mapped, class Hash, class Eq>
+flat_hash_map<Key, Mapped, Hash, Eq>::flat_hash_map(size_t bucket_count,
+                                                    const Hash& hash,
+                                                    const Eq& eq)
+    : table(bucket_count, hash, eq) {}
+
+template <class Key, class Mapped, class Hash, class Eq>
+template <class InputIterator>
+flat_hash_map<Key, Mapped, Hash, Eq>::flat_hash_map(InputIterator first,
+                                                    InputIterator last,
+                                                    size_t bucket_count,
+                                                    const Hash& hash,
+                                                    const Eq& eq)
+    : table(first, last, bucket_count, hash, eq) {}
+
+template <class Key, class Mapped, class Hash, class Eq>
+flat_hash_map<Key, Mapped, Hash, Eq>::flat_hash_map(
+    std::initializer_list<value_type> ilist,
+    size_t bucket_count,
+    const Hash& hash,
+    const Eq& eq)
+    : flat_hash_map(std::begin(ilist), std::end(ilist), bucket_count, hash,
+                    eq) {}
+
+// ----------------------------------------------------------------------------
+// Assignments.
+
+template <class Key, class Mapped, class Hash, class Eq>
+auto flat_hash_map<Key, Mapped, Hash, Eq>::operator=(
+    std::initializer_list<value_type> ilist) -> flat_hash_map& {
+  table::operator=(ilist);
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+// Insert and accessor operations.
+
+template <class Key, class Mapped, class Hash, class Eq>
+auto flat_hash_map<Key, Mapped, Hash, Eq>::operator[](const key_type& key)
+    -> mapped_type& {
+  return table::emplace_key_args(key, std::piecewise_construct,
+                                 std::forward_as_tuple(key), std::tuple<>())
+      .first->second;
+}
+
+template <class Key, class Mapped, class Hash, class Eq>
+auto flat_hash_map<Key, Mapped, Hash, Eq>::operator[](key_type&& key)
+    -> mapped_type& {
+  return table::emplace_key_args(key, std::piecewise_construct,
+                                 std::forward_as_tuple(std::move(key)),
+                                 std::tuple<>())
+      .first->second;
+}
+
+template <class Key, class Mapped, class Hash, class Eq>
+template <class K>
+auto flat_hash_map<Key, Mapped, Hash, Eq>::at(const K& key) -> mapped_type& {
+  iterator found = table::find(key);
+  CHECK(found != table::end());
+  return found->second;
+}
+
+template <class Key, class Mapped, class Hash, class Eq>
+template <class K>
+auto flat_hash_map<Key, Mapped, Hash, Eq>::at(const K& key) const
+    -> const mapped_type& {
+  const_iterator found = table::find(key);
+  CHECK(found != table::cend());
+  return found->second;
+}
+
+template <class Key, class Mapped, class Hash, class Eq>
+template <class K, class M>
+auto flat_hash_map<Key, Mapped, Hash, Eq>::insert_or_assign(K&& key, M&& obj)
+    -> std::pair<iterator, bool> {
+  auto result = table::emplace_key_args(key, std::forward<K>(key),
+                                        std::forward<M>(obj));
+  if (!result.second)
+    result.first->second = std::forward<M>(obj);
+  return result;
+}
+
+template <class Key, class Mapped, class Hash, class Eq>
+template <class K, class... Args>
+auto flat_hash_map<Key, Mapped, Hash, Eq>::try_emplace(K&& key, Args&&... args)
+    -> std::enable_if_t<std::is_constructible<key_type, K&&>::value,
+                        std::pair<iterator, bool>> {
+  return table::emplace_key_args(
+      key, std::piecewise_construct,
+      std::forward_as_tuple(std::forward<K>(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+// ----------------------------------------------------------------------------
+// General operations.
+
+template <class Key, class Mapped, class Hash, class Eq>
+void flat_hash_map<Key, Mapped, Hash, Eq>::swap(flat_hash_map& other) noexcept {
+  table::swap(other);
+}
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
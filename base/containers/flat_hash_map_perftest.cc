@@ -0,0 +1,126 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr size_t kSizes[] = {4, 16, 128, 1024, 16 * 1024, 256 * 1024};
+
+// Number of lookups per measurement, independent of the map size so that the
+// results are comparable.
+constexpr size_t kNumLookups = 1 << 20;
+
+// Returns |size| distinct pseudo-random keys.
+std::vector<uint64_t> GenerateKeys(size_t size) {
+  std::vector<uint64_t> keys;
+  keys.reserve(size);
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  for (size_t i = 0; i < size; ++i) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    // Keep keys even so that odd keys are guaranteed misses.
+    keys.push_back((state * 0x2545F4914F6CDD1DULL) & ~uint64_t{1});
+  }
+  return keys;
+}
+
+void PrintResult(const std::string& measurement,
+                 const std::string& map_name,
+                 size_t size,
+                 TimeDelta elapsed,
+                 size_t num_operations) {
+  perf_test::PrintResult(measurement, "", map_name + "_" + NumberToString(size),
+                         elapsed.InNanoseconds() /
+                             static_cast<double>(num_operations),
+                         "ns/op", true);
+}
+
+// Measures insertion, successful lookups and failed lookups of |size| keys in
+// a |Map| built by |builder|.
+template <class Map, class Builder>
+void RunMapTest(const std::string& map_name, size_t size, Builder builder) {
+  const std::vector<uint64_t> keys = GenerateKeys(size);
+
+  TimeTicks start = TimeTicks::Now();
+  const Map map = builder(keys);
+  PrintResult("insert", map_name, size, TimeTicks::Now() - start, size);
+  ASSERT_EQ(size, map.size());
+
+  uint64_t sum = 0;
+  start = TimeTicks::Now();
+  for (size_t i = 0; i < kNumLookups; ++i)
+    sum += map.find(keys[i % size])->second;
+  PrintResult("find_hit", map_name, size, TimeTicks::Now() - start,
+              kNumLookups);
+
+  size_t num_found = 0;
+  start = TimeTicks::Now();
+  for (size_t i = 0; i < kNumLookups; ++i)
+    num_found += map.count(keys[i % size] + 1);
+  PrintResult("find_miss", map_name, size, TimeTicks::Now() - start,
+              kNumLookups);
+
+  // Keep the results alive.
+  EXPECT_NE(0U, sum);
+  EXPECT_EQ(0U, num_found);
+}
+
+template <class Map>
+Map InsertEach(const std::vector<uint64_t>& keys) {
+  Map map;
+  for (uint64_t key : keys)
+    map.emplace(key, key);
+  return map;
+}
+
+// flat_map insertions are O(size), so build it from a vector like callers
+// should.
+flat_map<uint64_t, uint64_t> BuildFlatMap(const std::vector<uint64_t>& keys) {
+  std::vector<std::pair<uint64_t, uint64_t>> items;
+  items.reserve(keys.size());
+  for (uint64_t key : keys)
+    items.emplace_back(key, key);
+  return flat_map<uint64_t, uint64_t>(std::move(items));
+}
+
+}  // namespace
+
+TEST(FlatHashMapPerfTest, UnorderedMap) {
+  using Map = std::unordered_map<uint64_t, uint64_t>;
+  for (size_t size : kSizes)
+    RunMapTest<Map>("unordered_map", size, &InsertEach<Map>);
+}
+
+TEST(FlatHashMapPerfTest, FlatMap) {
+  for (size_t size : kSizes) {
+    RunMapTest<flat_map<uint64_t, uint64_t>>("flat_map", size,
+                                             &BuildFlatMap);
+  }
+}
+
+TEST(FlatHashMapPerfTest, FlatHashMap) {
+  using Map = flat_hash_map<uint64_t, uint64_t>;
+  for (size_t size : kSizes)
+    RunMapTest<Map>("flat_hash_map", size, &InsertEach<Map>);
+}
+
+}  // namespace base
@@ -0,0 +1,291 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// flat_hash_set shares its implementation, flat_hash_table, with
+// flat_hash_map. The bulk of the table tests are here; flat_hash_set tests
+// mostly check that things are set up properly.
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+namespace {
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& value) const { return value.data(); }
+};
+
+// Maps all keys to the same bucket.
+struct ConstantHash {
+  size_t operator()(int) const { return 42; }
+};
+
+// Counts live instances to detect leaks and double destructions.
+class InstanceCounter {
+ public:
+  explicit InstanceCounter(int* count) : count_(count) { ++*count_; }
+  InstanceCounter(const InstanceCounter& other) : count_(other.count_) {
+    ++*count_;
+  }
+  InstanceCounter& operator=(const InstanceCounter&) = default;
+  ~InstanceCounter() { --*count_; }
+
+ private:
+  int* count_;
+};
+
+}  // namespace
+
+TEST(FlatHashMap, InsertFindErase) {
+  flat_hash_map<int, std::string> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.end(), map.find(1));
+
+  auto result = map.insert(std::make_pair(1, "one"));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(1, result.first->first);
+  EXPECT_EQ("one", result.first->second);
+
+  result = map.insert(std::make_pair(1, "uno"));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ("one", result.first->second);
+
+  map.emplace(2, "two");
+  EXPECT_EQ(2U, map.size());
+  EXPECT_EQ(1U, map.count(2));
+  EXPECT_EQ(0U, map.count(3));
+  EXPECT_EQ("two", map.find(2)->second);
+
+  EXPECT_EQ(1U, map.erase(1));
+  EXPECT_EQ(0U, map.erase(1));
+  EXPECT_EQ(map.end(), map.find(1));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(2, "two")));
+}
+
+TEST(FlatHashMap, RangeConstructorKeepsFirstOfDupes) {
+  flat_hash_map<int, int>::value_type input_vals[] = {
+      {1, 1}, {1, 2}, {2, 1}, {2, 2}, {3, 1}, {3, 2}};
+
+  flat_hash_map<int, int> map(std::begin(input_vals), std::end(input_vals));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(1, 1), Pair(2, 1), Pair(3, 1)));
+
+  flat_hash_map<int, int> list = {{4, 1}, {4, 2}, {5, 1}};
+  EXPECT_THAT(list, UnorderedElementsAre(Pair(4, 1), Pair(5, 1)));
+
+  list = {{6, 1}, {6, 2}};
+  EXPECT_THAT(list, UnorderedElementsAre(Pair(6, 1)));
+}
+
+TEST(FlatHashMap, CopyAndMove) {
+  flat_hash_map<int, int> original = {{1, 1}, {2, 2}, {3, 3}};
+
+  flat_hash_map<int, int> copy(original);
+  EXPECT_EQ(original, copy);
+
+  flat_hash_map<int, int> moved(std::move(copy));
+  EXPECT_EQ(original, moved);
+  EXPECT_TRUE(copy.empty());  // NOLINT(bugprone-use-after-move)
+
+  flat_hash_map<int, int> assigned;
+  assigned = original;
+  EXPECT_EQ(original, assigned);
+
+  flat_hash_map<int, int> move_assigned = {{4, 4}};
+  move_assigned = std::move(assigned);
+  EXPECT_EQ(original, move_assigned);
+
+  move_assigned[4] = 4;
+  EXPECT_NE(original, move_assigned);
+}
+
+TEST(FlatHashMap, MoveOnly) {
+  using pair = std::pair<MoveOnlyInt, MoveOnlyInt>;
+
+  flat_hash_map<MoveOnlyInt, MoveOnlyInt, MoveOnlyIntHash> map;
+  for (int i = 1; i <= 100; ++i)
+    map.insert(pair(MoveOnlyInt(i), MoveOnlyInt(i * 10)));
+  EXPECT_EQ(100U, map.size());
+
+  for (int i = 1; i <= 100; ++i) {
+    auto it = map.find(MoveOnlyInt(i));
+    ASSERT_NE(map.end(), it);
+    EXPECT_EQ(i * 10, it->second.data());
+  }
+
+  flat_hash_map<MoveOnlyInt, MoveOnlyInt, MoveOnlyIntHash> moved(
+      std::move(map));
+  EXPECT_EQ(100U, moved.size());
+}
+
+TEST(FlatHashMap, SubscriptAndAt) {
+  flat_hash_map<std::string, int> map;
+  map["a"] = 1;
+  ++map["a"];
+  std::string b = "b";
+  map[std::move(b)] = 3;
+
+  EXPECT_EQ(2, map.at("a"));
+  EXPECT_EQ(3, map.at("b"));
+  const auto& const_map = map;
+  EXPECT_EQ(2, const_map.at("a"));
+  EXPECT_EQ(0, map["c"]);
+  EXPECT_EQ(3U, map.size());
+}
+
+TEST(FlatHashMap, InsertOrAssign) {
+  flat_hash_map<MoveOnlyInt, MoveOnlyInt, MoveOnlyIntHash> map;
+  auto result = map.insert_or_assign(MoveOnlyInt(1), MoveOnlyInt(10));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(10, result.first->second.data());
+
+  result = map.insert_or_assign(MoveOnlyInt(1), MoveOnlyInt(20));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(20, result.first->second.data());
+  EXPECT_EQ(1U, map.size());
+}
+
+TEST(FlatHashMap, TryEmplace) {
+  flat_hash_map<int, MoveOnlyInt> map;
+  MoveOnlyInt value(10);
+  auto result = map.try_emplace(1, std::move(value));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(10, result.first->second.data());
+
+  // |other_value| is not moved from when the key already exists.
+  MoveOnlyInt other_value(20);
+  result = map.try_emplace(1, std::move(other_value));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(10, result.first->second.data());
+  EXPECT_EQ(20, other_value.data());  // NOLINT(bugprone-use-after-move)
+}
+
+// Verify that erasing while iterating visits each element once and leaves the
+// other elements in place.
+TEST(FlatHashMap, EraseWhileIterating) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 1000; ++i)
+    map[i] = i;
+
+  size_t num_visited = 0;
+  for (auto it = map.begin(); it != map.end();) {
+    ++num_visited;
+    if (it->first % 2)
+      it = map.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(1000U, num_visited);
+  EXPECT_EQ(500U, map.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i % 2 ? 0U : 1U, map.count(i));
+}
+
+// Verify that the table stays correct through many insertions and erasures,
+// which exercise growth and the reuse of deleted slots.
+TEST(FlatHashMap, MatchesUnorderedMap) {
+  flat_hash_map<int, int> map;
+  std::unordered_map<int, int> reference;
+  uint32_t seed = 1;
+  for (int i = 0; i < 100000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const int key = (seed >> 8) % 3000;
+    switch (seed % 3) {
+      case 0:
+      case 1:
+        EXPECT_EQ(reference.emplace(key, i).second,
+                  map.emplace(key, i).second);
+        break;
+      case 2:
+        EXPECT_EQ(reference.erase(key), map.erase(key));
+        break;
+    }
+  }
+  ASSERT_EQ(reference.size(), map.size());
+  for (const auto& entry : reference) {
+    auto it = map.find(entry.first);
+    ASSERT_NE(map.end(), it);
+    EXPECT_EQ(entry.second, it->second);
+  }
+  size_t num_iterated = 0;
+  for (const auto& entry : map) {
+    ++num_iterated;
+    EXPECT_EQ(1U, reference.count(entry.first));
+  }
+  EXPECT_EQ(reference.size(), num_iterated);
+}
+
+// Verify that lookups still work when all keys have the same hash.
+TEST(FlatHashMap, CollidingHashes) {
+  flat_hash_map<int, int, ConstantHash> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  for (int i = 0; i < 100; i += 2)
+    map.erase(i);
+  EXPECT_EQ(50U, map.size());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i % 2 ? 1U : 0U, map.count(i));
+}
+
+TEST(FlatHashMap, ReserveAndClear) {
+  flat_hash_map<int, int> map;
+  EXPECT_EQ(0U, map.capacity());
+  map.reserve(100);
+  const size_t capacity = map.capacity();
+  EXPECT_GE(capacity, 100U);
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  EXPECT_EQ(capacity, map.capacity());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(capacity, map.capacity());
+  EXPECT_EQ(0U, map.count(1));
+}
+
+// Verify that each value is destroyed exactly once, including values moved
+// when the table grows.
+TEST(FlatHashMap, DestroysValues) {
+  int count = 0;
+  {
+    flat_hash_map<int, InstanceCounter> map;
+    for (int i = 0; i < 1000; ++i)
+      map.emplace(i, InstanceCounter(&count));
+    EXPECT_EQ(1000, count);
+    for (int i = 0; i < 500; ++i)
+      map.erase(i);
+    EXPECT_EQ(500, count);
+
+    flat_hash_map<int, InstanceCounter> copy(map);
+    EXPECT_EQ(1000, count);
+  }
+  EXPECT_EQ(0, count);
+}
+
+TEST(FlatHashMap, Swap) {
+  flat_hash_map<int, int> x = {{1, 1}};
+  flat_hash_map<int, int> y = {{2, 2}, {3, 3}};
+  x.swap(y);
+  EXPECT_THAT(x, UnorderedElementsAre(Pair(2, 2), Pair(3, 3)));
+  EXPECT_THAT(y, UnorderedElementsAre(Pair(1, 1)));
+  swap(x, y);
+  EXPECT_THAT(x, UnorderedElementsAre(Pair(1, 1)));
+}
+
+}  // namespace base
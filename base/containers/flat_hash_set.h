@@ -0,0 +1,116 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_SET_H_
+#define BASE_CONTAINERS_FLAT_HASH_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+// flat_hash_set is a container with a std::unordered_set-like interface that
+// stores its contents inline in an open-addressing hash table.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - No allocation per item: values are stored in a single array.
+//  - Lookups usually touch one cache line of metadata, compared 16 slots at a
+//    time on x86, before comparing a single key.
+//  - Inserts and removals are O(1).
+//
+// CONS
+//
+//  - Iterators and references are invalidated by insertions.
+//  - Iteration order is unspecified.
+//  - Values are moved when the table grows.
+//
+// IMPORTANT NOTES
+//
+//  - Values must not be modified through iterators.
+//  - Erasing doesn't invalidate iterators to other values, so it is safe to
+//    erase the current element in a loop using the iterator erase() returns.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from flat_hash_table. Please see
+// flat_hash_table.h for more details for most of these functions. As a quick
+// reference, the functions available are:
+//
+// Constructors (duplicates keep the first):
+//   flat_hash_set(size_t bucket_count = 0, const Hash& = Hash(),
+//                 const Eq& = Eq());
+//   flat_hash_set(InputIterator first, InputIterator last,
+//                 size_t bucket_count = 0, const Hash& = Hash(),
+//                 const Eq& = Eq());
+//   flat_hash_set(const flat_hash_set&);
+//   flat_hash_set(flat_hash_set&&);
+//   flat_hash_set(std::initializer_list<value_type> ilist,
+//                 size_t bucket_count = 0, const Hash& = Hash(),
+//                 const Eq& = Eq());
+//
+// Assignment functions:
+//   flat_hash_set& operator=(const flat_hash_set&);
+//   flat_hash_set& operator=(flat_hash_set&&);
+//   flat_hash_set& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   size_t max_size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator       begin();
+//   const_iterator begin() const;
+//   const_iterator cbegin() const;
+//   iterator       end();
+//   const_iterator end() const;
+//   const_iterator cend() const;
+//
+// Insert and accessor functions:
+//   pair<iterator, bool> insert(const key_type&);
+//   pair<iterator, bool> insert(key_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> emplace(Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   template <class K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//
+// General functions:
+//   void swap(flat_hash_set&&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_set&, const flat_hash_set);
+//   bool operator!=(const flat_hash_set&, const flat_hash_set);
+//
+template <class Key,
+          class Hash = std::hash<Key>,
+          class Eq = std::equal_to<Key>>
+using flat_hash_set = typename ::base::internal::flat_hash_table<
+    Key,
+    Key,
+    ::base::internal::GetKeyFromValueIdentity<Key>,
+    Hash,
+    Eq>;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_SET_H_
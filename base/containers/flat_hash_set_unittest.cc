@@ -0,0 +1,73 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_set.h"
+
+#include <string>
+#include <utility>
+
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// A flat_hash_set is basically an interface to flat_hash_table. So several
+// basic operations are tested to make sure things are set up properly, but the
+// bulk of the tests are in flat_hash_map_unittest.cc.
+
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+namespace {
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& value) const { return value.data(); }
+};
+
+}  // namespace
+
+TEST(FlatHashSet, InitializerList) {
+  flat_hash_set<int> set = {1, 2, 2, 3};
+  EXPECT_THAT(set, UnorderedElementsAre(1, 2, 3));
+
+  set = {4, 5};
+  EXPECT_THAT(set, UnorderedElementsAre(4, 5));
+}
+
+TEST(FlatHashSet, InsertCountErase) {
+  flat_hash_set<std::string> set;
+  EXPECT_TRUE(set.insert("a").second);
+  EXPECT_FALSE(set.insert("a").second);
+  EXPECT_TRUE(set.emplace("b").second);
+
+  EXPECT_EQ(2U, set.size());
+  EXPECT_EQ(1U, set.count("a"));
+  EXPECT_EQ(0U, set.count("c"));
+  EXPECT_EQ("b", *set.find("b"));
+
+  set.erase(set.find("a"));
+  EXPECT_THAT(set, UnorderedElementsAre("b"));
+}
+
+TEST(FlatHashSet, MoveOnly) {
+  flat_hash_set<MoveOnlyInt, MoveOnlyIntHash> set;
+  for (int i = 0; i < 100; ++i)
+    set.insert(MoveOnlyInt(i));
+  EXPECT_EQ(100U, set.size());
+  EXPECT_EQ(1U, set.count(MoveOnlyInt(50)));
+
+  flat_hash_set<MoveOnlyInt, MoveOnlyIntHash> moved(std::move(set));
+  EXPECT_EQ(100U, moved.size());
+  EXPECT_EQ(1U, moved.erase(MoveOnlyInt(50)));
+}
+
+TEST(FlatHashSet, Equality) {
+  flat_hash_set<int> x = {1, 2, 3};
+  flat_hash_set<int> y = {3, 2, 1};
+  EXPECT_EQ(x, y);
+  y.erase(3);
+  EXPECT_NE(x, y);
+}
+
+}  // namespace base
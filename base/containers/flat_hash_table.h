@@ -0,0 +1,920 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+#define BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/sys_byteorder.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+namespace base {
+
+namespace internal {
+
+// Each slot of a flat_hash_table has a control byte which is either one of the
+// special values below or, if the slot is full, the 7 low bits of the hash of
+// its key (its "H2"). Full control bytes are therefore never negative.
+using FlatHashControl = int8_t;
+constexpr FlatHashControl kFlatHashEmpty = -128;
+constexpr FlatHashControl kFlatHashDeleted = -2;
+// Follows the last control byte so that iterators stop at end().
+constexpr FlatHashControl kFlatHashSentinel = -1;
+
+// Allows range-based for loops over the indices of the set bits of |mask|,
+// where each index is represented by 2^Shift bits.
+template <class T, int Shift>
+class FlatHashBitMask {
+ public:
+  explicit FlatHashBitMask(T mask) : mask_(mask) {}
+
+  explicit operator bool() const { return mask_ != 0; }
+
+  size_t LowestBitSet() const {
+    return bits::CountTrailingZeroBits(mask_) >> Shift;
+  }
+
+  size_t operator*() const { return LowestBitSet(); }
+  FlatHashBitMask& operator++() {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+
+  FlatHashBitMask begin() const { return *this; }
+  FlatHashBitMask end() const { return FlatHashBitMask(0); }
+
+  friend bool operator!=(const FlatHashBitMask& a, const FlatHashBitMask& b) {
+    return a.mask_ != b.mask_;
+  }
+
+ private:
+  T mask_;
+};
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+// A group of 16 control bytes, matched with SSE2 instructions.
+class FlatHashGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+
+  explicit FlatHashGroup(const FlatHashControl* control)
+      : control_(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(control))) {}
+
+  // Returns the slots whose control byte is |h2|.
+  FlatHashBitMask<uint32_t, 0> Match(FlatHashControl h2) const {
+    return FlatHashBitMask<uint32_t, 0>(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), control_))));
+  }
+
+  FlatHashBitMask<uint32_t, 0> MatchEmpty() const {
+    return Match(kFlatHashEmpty);
+  }
+
+  FlatHashBitMask<uint32_t, 0> MatchEmptyOrDeleted() const {
+    // kFlatHashEmpty and kFlatHashDeleted are the only values smaller than
+    // kFlatHashSentinel.
+    return FlatHashBitMask<uint32_t, 0>(
+        static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashSentinel), control_))));
+  }
+
+ private:
+  const __m128i control_;
+};
+
+#else  // defined(ARCH_CPU_X86_FAMILY)
+
+// A group of 8 control bytes, matched with 64-bit integer operations. Each
+// slot is represented by the high bit of its byte in the returned masks.
+class FlatHashGroup {
+ public:
+  static constexpr size_t kWidth = 8;
+
+  explicit FlatHashGroup(const FlatHashControl* control) {
+    memcpy(&control_, control, sizeof(control_));
+    control_ = ByteSwapToLE64(control_);
+  }
+
+  // Returns the slots whose control byte is |h2|. May return false positives,
+  // which are filtered out by the key comparison that follows.
+  FlatHashBitMask<uint64_t, 3> Match(FlatHashControl h2) const {
+    const uint64_t x = control_ ^ (kLsbs * static_cast<uint8_t>(h2));
+    return FlatHashBitMask<uint64_t, 3>((x - kLsbs) & ~x & kMsbs);
+  }
+
+  FlatHashBitMask<uint64_t, 3> MatchEmpty() const {
+    // kFlatHashEmpty is the only value with the high bit set and the second
+    // lowest bit unset.
+    return FlatHashBitMask<uint64_t, 3>((control_ & (~control_ << 6)) & kMsbs);
+  }
+
+  FlatHashBitMask<uint64_t, 3> MatchEmptyOrDeleted() const {
+    // kFlatHashEmpty and kFlatHashDeleted are the only values with the high bit
+    // set and the lowest bit unset.
+    return FlatHashBitMask<uint64_t, 3>((control_ & (~control_ << 7)) & kMsbs);
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+  static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+  uint64_t control_;
+};
+
+#endif  // defined(ARCH_CPU_X86_FAMILY)
+
+// Implementation -------------------------------------------------------------
+
+// Implementation of an open-addressing hash table for backing flat_hash_set
+// and flat_hash_map. Do not use directly.
+//
+// The design follows the "Swiss table" of Abseil: values are stored inline in
+// an array of slots, next to an array of one control byte per slot. A lookup
+// compares the 7 low bits of the hash with a whole group of control bytes at
+// once and only compares keys for the slots that match. Groups are probed
+// quadratically starting at a position given by the remaining bits of the
+// hash, until a group with an empty slot is found.
+//
+// As with flat_tree, "value" is the thing contained and "key" is how things
+// are looked up. GetKeyFromValue extracts the key from a value and should
+// implement:
+//   const Key& operator()(const Value&).
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+class flat_hash_table {
+ private:
+  template <class T>
+  class iterator_impl;
+
+ public:
+  // --------------------------------------------------------------------------
+  // Types.
+  //
+  using key_type = Key;
+  using value_type = Value;
+  using hasher = Hash;
+  using key_equal = Eq;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = iterator_impl<value_type>;
+  using const_iterator = iterator_impl<const value_type>;
+
+  // --------------------------------------------------------------------------
+  // Lifetime.
+  //
+  // Assume that move constructors invalidate iterators and references.
+  //
+  // The constructors that take ranges and lists keep the first of duplicates.
+
+  flat_hash_table();
+  explicit flat_hash_table(size_type bucket_count,
+                           const hasher& hash = hasher(),
+                           const key_equal& eq = key_equal());
+
+  template <class InputIterator>
+  flat_hash_table(InputIterator first,
+                  InputIterator last,
+                  size_type bucket_count = 0,
+                  const hasher& hash = hasher(),
+                  const key_equal& eq = key_equal());
+
+  flat_hash_table(const flat_hash_table&);
+  flat_hash_table(flat_hash_table&&) noexcept;
+
+  flat_hash_table(std::initializer_list<value_type> ilist,
+                  size_type bucket_count = 0,
+                  const hasher& hash = hasher(),
+                  const key_equal& eq = key_equal());
+
+  ~flat_hash_table();
+
+  // --------------------------------------------------------------------------
+  // Assignments.
+  //
+  // Assume that assignments invalidate iterators and references.
+
+  flat_hash_table& operator=(const flat_hash_table&);
+  flat_hash_table& operator=(flat_hash_table&&) noexcept;
+  // Takes the first if there are duplicates in the initializer list.
+  flat_hash_table& operator=(std::initializer_list<value_type> ilist);
+
+  // --------------------------------------------------------------------------
+  // Memory management.
+  //
+  // capacity() is the number of slots. The table grows when it is 7/8 full.
+  //
+  // reserve() invalidates iterators and references.
+
+  void reserve(size_type new_size);
+  size_type capacity() const { return capacity_; }
+
+  // --------------------------------------------------------------------------
+  // Size management.
+  //
+  // clear() leaves the capacity() of the flat_hash_table unchanged.
+
+  void clear();
+
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  bool empty() const { return size_ == 0; }
+
+  // --------------------------------------------------------------------------
+  // Iterators.
+  //
+  // The iteration order is unspecified. begin() is O(capacity()) in the worst
+  // case; incrementing an iterator is amortized O(1).
+
+  iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const { return end(); }
+
+  // --------------------------------------------------------------------------
+  // Insert operations.
+  //
+  // Assume that every insertion invalidates iterators and references, since it
+  // may grow the table.
+
+  std::pair<iterator, bool> insert(const value_type& val);
+  std::pair<iterator, bool> insert(value_type&& val);
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last);
+
+  void insert(std::initializer_list<value_type> ilist);
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  // --------------------------------------------------------------------------
+  // Erase operations.
+  //
+  // Erasing never moves other values: iterators and references to other values
+  // stay valid, so it is safe to erase while iterating.
+
+  iterator erase(iterator position);
+  iterator erase(const_iterator position);
+  template <class K>
+  size_type erase(const K& key);
+
+  // --------------------------------------------------------------------------
+  // Observers.
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+
+  // --------------------------------------------------------------------------
+  // Search operations.
+  //
+  // Search operations have O(1) expected complexity. |key| must be hashable
+  // by |hasher| and comparable by |key_equal| with a key_type.
+
+  template <class K>
+  size_type count(const K& key) const;
+
+  template <class K>
+  iterator find(const K& key);
+
+  template <class K>
+  const_iterator find(const K& key) const;
+
+  // --------------------------------------------------------------------------
+  // General operations.
+  //
+  // Assume that swap invalidates iterators and references.
+
+  void swap(flat_hash_table& other) noexcept;
+
+  // Order-independent comparison of the contained values.
+  friend bool operator==(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    if (lhs.size() != rhs.size())
+      return false;
+    for (const value_type& value : lhs) {
+      auto it = rhs.find(GetKeyFromValue()(value));
+      if (it == rhs.end() || !(*it == value))
+        return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend void swap(flat_hash_table& lhs, flat_hash_table& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+ protected:
+  // Returns the value whose key is |key|, or inserts a value constructed from
+  // |args| if there was none. |args| must construct a value whose key is
+  // |key|.
+  template <class K, class... Args>
+  std::pair<iterator, bool> emplace_key_args(const K& key, Args&&... args);
+
+ private:
+  // Forward iterator over the full slots. Skips empty and deleted slots using
+  // their control bytes, and stops at the sentinel that follows them.
+  template <class T>
+  class iterator_impl {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename flat_hash_table::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    iterator_impl() = default;
+
+    // Allows converting an iterator to a const_iterator.
+    template <class U,
+              class = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    iterator_impl(const iterator_impl<U>& other)  // NOLINT
+        : control_(other.control_), slot_(other.slot_) {}
+
+    reference operator*() const {
+      DCHECK_GE(*control_, 0);
+      return *slot_;
+    }
+    pointer operator->() const { return &operator*(); }
+
+    iterator_impl& operator++() {
+      DCHECK_GE(*control_, 0);
+      ++control_;
+      ++slot_;
+      SkipEmptyOrDeleted();
+      return *this;
+    }
+    iterator_impl operator++(int) {
+      iterator_impl copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+      return a.control_ == b.control_;
+    }
+    friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+      return !(a == b);
+    }
+
+   private:
+    friend class flat_hash_table;
+    template <class U>
+    friend class iterator_impl;
+
+    iterator_impl(const FlatHashControl* control, T* slot)
+        : control_(control), slot_(slot) {}
+
+    void SkipEmptyOrDeleted() {
+      while (*control_ < kFlatHashSentinel) {
+        ++control_;
+        ++slot_;
+      }
+    }
+
+    const FlatHashControl* control_ = nullptr;
+    T* slot_ = nullptr;
+  };
+
+  using slot_allocator = std::allocator<value_type>;
+
+  // Returns the maximum number of values a table with |capacity| slots holds
+  // before it grows.
+  static size_type MaxLoad(size_type capacity) {
+    return capacity - capacity / 8;
+  }
+
+  // Returns the smallest capacity that can hold |size| values.
+  static size_type CapacityForSize(size_type size);
+
+  // Mixes the bits of the hash of |key|: several standard libraries implement
+  // std::hash of integers as the identity, while the table relies on both the
+  // low bits (H2) and the high bits (H1) to be well distributed.
+  template <class K>
+  size_t HashOf(const K& key) const {
+    const uint64_t hash =
+        static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  static size_t H1(size_t hash) { return hash >> 7; }
+  static FlatHashControl H2(size_t hash) {
+    return static_cast<FlatHashControl>(hash & 0x7F);
+  }
+
+  // Returns the index of the slot holding |key|, or |capacity_| if none.
+  template <class K>
+  size_type FindIndex(const K& key, size_t hash) const;
+
+  // Returns the index of the first empty or deleted slot in the probe sequence
+  // of |hash|. The table must have such a slot.
+  size_type FindFirstNonFull(size_t hash) const;
+
+  // Marks the slot for a new value with |hash|, growing the table if needed,
+  // and returns its index. The caller must construct the value in the slot.
+  size_type PrepareInsert(size_t hash);
+
+  // Destroys the value at |index| and frees its slot.
+  void EraseAt(size_type index);
+
+  // Moves all values to new storage with |new_capacity| slots.
+  void Resize(size_type new_capacity);
+
+  // Allocates storage for |capacity| empty slots. Does not free the current
+  // storage.
+  void AllocateStorage(size_type capacity);
+
+  // Destroys all values and frees the storage.
+  void DestroyStorage();
+
+  iterator IteratorAt(size_type index) {
+    return iterator(control_ + index, slots_ + index);
+  }
+  const_iterator IteratorAt(size_type index) const {
+    return const_iterator(control_ + index, slots_ + index);
+  }
+
+  // |capacity_| + 1 control bytes, the last being kFlatHashSentinel.
+  FlatHashControl* control_ = nullptr;
+  value_type* slots_ = nullptr;
+  // 0 or a power of two no smaller than FlatHashGroup::kWidth.
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  // Number of values that can be inserted in empty slots before the table
+  // grows. Deleted slots count against it until the table is rehashed.
+  size_type growth_left_ = 0;
+  hasher hash_;
+  key_equal eq_;
+};
+
+// ----------------------------------------------------------------------------
+// Lifetime.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table() =
+    default;
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    size_type bucket_count,
+    const hasher& hash,
+    const key_equal& eq)
+    : hash_(hash), eq_(eq) {
+  reserve(bucket_count);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class InputIterator>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    InputIterator first,
+    InputIterator last,
+    size_type bucket_count,
+    const hasher& hash,
+    const key_equal& eq)
+    : flat_hash_table(bucket_count, hash, eq) {
+  insert(first, last);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    const flat_hash_table& other)
+    : hash_(other.hash_), eq_(other.eq_) {
+  reserve(other.size());
+  // Keys of |other| are unique: skip the lookups.
+  for (const value_type& value : other) {
+    const size_type index = PrepareInsert(HashOf(GetKeyFromValue()(value)));
+    new (slots_ + index) value_type(value);
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    flat_hash_table&& other) noexcept
+    : control_(other.control_),
+      slots_(other.slots_),
+      capacity_(other.capacity_),
+      size_(other.size_),
+      growth_left_(other.growth_left_),
+      hash_(std::move(other.hash_)),
+      eq_(std::move(other.eq_)) {
+  other.control_ = nullptr;
+  other.slots_ = nullptr;
+  other.capacity_ = 0;
+  other.size_ = 0;
+  other.growth_left_ = 0;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    std::initializer_list<value_type> ilist,
+    size_type bucket_count,
+    const hasher& hash,
+    const key_equal& eq)
+    : flat_hash_table(std::begin(ilist), std::end(ilist), bucket_count, hash,
+                      eq) {}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::~flat_hash_table() {
+  DestroyStorage();
+}
+
+// ----------------------------------------------------------------------------
+// Assignments.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::operator=(
+    const flat_hash_table& other) -> flat_hash_table& {
+  if (this != &other) {
+    flat_hash_table copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::operator=(
+    flat_hash_table&& other) noexcept -> flat_hash_table& {
+  flat_hash_table moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::operator=(
+    std::initializer_list<value_type> ilist) -> flat_hash_table& {
+  clear();
+  insert(ilist);
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+// Memory management.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::reserve(
+    size_type new_size) {
+  if (new_size > MaxLoad(capacity_))
+    Resize(CapacityForSize(new_size));
+}
+
+// ----------------------------------------------------------------------------
+// Size management.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::clear() {
+  if (capacity_ == 0)
+    return;
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (control_[i] >= 0)
+      slots_[i].~value_type();
+  }
+  memset(control_, kFlatHashEmpty, capacity_);
+  size_ = 0;
+  growth_left_ = MaxLoad(capacity_);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::max_size() const
+    -> size_type {
+  return MaxLoad(std::numeric_limits<size_type>::max() /
+                 (sizeof(value_type) + sizeof(FlatHashControl)));
+}
+
+// ----------------------------------------------------------------------------
+// Iterators.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::begin()
+    -> iterator {
+  if (size_ == 0)
+    return end();
+  iterator it = IteratorAt(0);
+  it.SkipEmptyOrDeleted();
+  return it;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::begin() const
+    -> const_iterator {
+  return const_cast<flat_hash_table*>(this)->begin();
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::end()
+    -> iterator {
+  return IteratorAt(capacity_);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::end() const
+    -> const_iterator {
+  return IteratorAt(capacity_);
+}
+
+// ----------------------------------------------------------------------------
+// Insert operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    const value_type& val) -> std::pair<iterator, bool> {
+  return emplace_key_args(GetKeyFromValue()(val), val);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    value_type&& val) -> std::pair<iterator, bool> {
+  return emplace_key_args(GetKeyFromValue()(val), std::move(val));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class InputIterator>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    InputIterator first,
+    InputIterator last) {
+  using iterator_category =
+      typename std::iterator_traits<InputIterator>::iterator_category;
+  if (std::is_base_of<std::forward_iterator_tag, iterator_category>::value)
+    reserve(size_ + std::distance(first, last));
+  for (; first != last; ++first)
+    insert(*first);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    std::initializer_list<value_type> ilist) {
+  insert(std::begin(ilist), std::end(ilist));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class... Args>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::emplace(
+    Args&&... args) -> std::pair<iterator, bool> {
+  value_type new_value(std::forward<Args>(args)...);
+  return insert(std::move(new_value));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K, class... Args>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::emplace_key_args(
+    const K& key,
+    Args&&... args) -> std::pair<iterator, bool> {
+  const size_t hash = HashOf(key);
+  size_type index = FindIndex(key, hash);
+  if (index != capacity_)
+    return {IteratorAt(index), false};
+  index = PrepareInsert(hash);
+  new (slots_ + index) value_type(std::forward<Args>(args)...);
+  return {IteratorAt(index), true};
+}
+
+// ----------------------------------------------------------------------------
+// Erase operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::erase(
+    iterator position) -> iterator {
+  return erase(const_iterator(position));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::erase(
+    const_iterator position) -> iterator {
+  DCHECK(position != cend());
+  const size_type index = position.control_ - control_;
+  iterator next = IteratorAt(index);
+  ++next;
+  EraseAt(index);
+  return next;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::erase(
+    const K& key) -> size_type {
+  const size_type index = FindIndex(key, HashOf(key));
+  if (index == capacity_)
+    return 0;
+  EraseAt(index);
+  return 1;
+}
+
+// ----------------------------------------------------------------------------
+// Search operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::count(
+    const K& key) const -> size_type {
+  return FindIndex(key, HashOf(key)) != capacity_ ? 1 : 0;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::find(
+    const K& key) -> iterator {
+  return IteratorAt(FindIndex(key, HashOf(key)));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::find(
+    const K& key) const -> const_iterator {
+  return IteratorAt(FindIndex(key, HashOf(key)));
+}
+
+// ----------------------------------------------------------------------------
+// General operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::swap(
+    flat_hash_table& other) noexcept {
+  std::swap(control_, other.control_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(hash_, other.hash_);
+  std::swap(eq_, other.eq_);
+}
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+
+// static
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::CapacityForSize(
+    size_type size) -> size_type {
+  size_type capacity = FlatHashGroup::kWidth;
+  while (MaxLoad(capacity) < size)
+    capacity *= 2;
+  return capacity;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::FindIndex(
+    const K& key,
+    size_t hash) const -> size_type {
+  if (size_ == 0)
+    return capacity_;
+  const size_type group_mask = capacity_ / FlatHashGroup::kWidth - 1;
+  size_type group = H1(hash) & group_mask;
+  // Quadratic probing over a power of two number of groups visits each group
+  // exactly once in the first |group_mask| + 1 steps.
+  for (size_type step = 1;; ++step) {
+    DCHECK_LE(step, group_mask + 1);
+    const size_type first_index = group * FlatHashGroup::kWidth;
+    const FlatHashGroup group_control(control_ + first_index);
+    for (size_t i : group_control.Match(H2(hash))) {
+      if (eq_(GetKeyFromValue()(slots_[first_index + i]), key))
+        return first_index + i;
+    }
+    if (group_control.MatchEmpty())
+      return capacity_;
+    group = (group + step) & group_mask;
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::FindFirstNonFull(
+    size_t hash) const -> size_type {
+  const size_type group_mask = capacity_ / FlatHashGroup::kWidth - 1;
+  size_type group = H1(hash) & group_mask;
+  for (size_type step = 1;; ++step) {
+    DCHECK_LE(step, group_mask + 1);
+    const size_type first_index = group * FlatHashGroup::kWidth;
+    const auto non_full =
+        FlatHashGroup(control_ + first_index).MatchEmptyOrDeleted();
+    if (non_full)
+      return first_index + non_full.LowestBitSet();
+    group = (group + step) & group_mask;
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::PrepareInsert(
+    size_t hash) -> size_type {
+  if (capacity_ == 0)
+    Resize(FlatHashGroup::kWidth);
+  size_type index = FindFirstNonFull(hash);
+  if (growth_left_ == 0 && control_[index] != kFlatHashDeleted) {
+    // Drop the deleted slots if they account for a large part of the load,
+    // otherwise grow.
+    Resize(size_ < MaxLoad(capacity_) / 2 ? capacity_ : capacity_ * 2);
+    index = FindFirstNonFull(hash);
+  }
+  if (control_[index] == kFlatHashEmpty)
+    --growth_left_;
+  control_[index] = H2(hash);
+  ++size_;
+  return index;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::EraseAt(
+    size_type index) {
+  DCHECK_LT(index, capacity_);
+  DCHECK_GE(control_[index], 0);
+  slots_[index].~value_type();
+  --size_;
+  // Lookups stop at the first group with an empty slot, so no probe sequence
+  // goes past a group that already has one: the slot can be reused freely.
+  // Otherwise, it must be marked deleted to keep later groups reachable.
+  const size_type first_index = index & ~(FlatHashGroup::kWidth - 1);
+  if (FlatHashGroup(control_ + first_index).MatchEmpty()) {
+    control_[index] = kFlatHashEmpty;
+    ++growth_left_;
+  } else {
+    control_[index] = kFlatHashDeleted;
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::Resize(
+    size_type new_capacity) {
+  DCHECK(bits::IsPowerOfTwo(new_capacity));
+  DCHECK(new_capacity >= FlatHashGroup::kWidth);
+  DCHECK_LE(size_, MaxLoad(new_capacity));
+
+  FlatHashControl* const old_control = control_;
+  value_type* const old_slots = slots_;
+  const size_type old_capacity = capacity_;
+
+  AllocateStorage(new_capacity);
+  for (size_type i = 0; i < old_capacity; ++i) {
+    if (old_control[i] < 0)
+      continue;
+    const size_t hash = HashOf(GetKeyFromValue()(old_slots[i]));
+    const size_type index = FindFirstNonFull(hash);
+    control_[index] = H2(hash);
+    new (slots_ + index) value_type(std::move(old_slots[i]));
+    old_slots[i].~value_type();
+  }
+  growth_left_ = MaxLoad(capacity_) - size_;
+
+  if (old_capacity) {
+    delete[] old_control;
+    slot_allocator().deallocate(old_slots, old_capacity);
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::AllocateStorage(
+    size_type capacity) {
+  control_ = new FlatHashControl[capacity + 1];
+  memset(control_, kFlatHashEmpty, capacity);
+  control_[capacity] = kFlatHashSentinel;
+  slots_ = slot_allocator().allocate(capacity);
+  capacity_ = capacity;
+  growth_left_ = MaxLoad(capacity);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::DestroyStorage() {
+  if (capacity_ == 0)
+    return;
+  clear();
+  delete[] control_;
+  slot_allocator().deallocate(slots_, capacity_);
+  control_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = 0;
+  growth_left_ = 0;
+}
+
+}  // namespace internal
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_TABLE_H_
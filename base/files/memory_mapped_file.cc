@@ -6,10 +6,16 @@
 
 #include <utility>
 
+#include "base/bind.h"
+#include "base/debug/alias.h"
 #include "base/files/file_path.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/numerics/safe_math.h"
+#include "base/process/process_metrics.h"
 #include "base/sys_info.h"
+#include "base/task_runner.h"
+#include "base/threading/thread_restrictions.h"
 #include "build/build_config.h"
 
 namespace base {
@@ -112,6 +118,48 @@ bool MemoryMappedFile::IsValid() const {
   return data_ != nullptr;
 }
 
+bool MemoryMappedFile::AdviseSequential() {
+  return AdviseAccessPattern(AccessPattern::SEQUENTIAL);
+}
+
+bool MemoryMappedFile::AdviseRandom() {
+  return AdviseAccessPattern(AccessPattern::RANDOM);
+}
+
+void MemoryMappedFile::PrefetchAsync(size_t offset,
+                                     size_t size,
+                                     scoped_refptr<TaskRunner> task_runner,
+                                     OnceClosure reply) {
+  DCHECK(IsValidRange(offset, size));
+  // Unretained() is safe because the caller keeps this object alive until
+  // |reply| runs, which is after WarmUp().
+  task_runner->PostTaskAndReply(
+      FROM_HERE,
+      BindOnce(&MemoryMappedFile::WarmUp, Unretained(this), offset, size),
+      std::move(reply));
+}
+
+bool MemoryMappedFile::IsValidRange(size_t offset, size_t size) const {
+  return IsValid() && size > 0 && offset < length_ &&
+         size <= length_ - offset;
+}
+
+void MemoryMappedFile::WarmUp(size_t offset, size_t size) {
+  AssertBlockingAllowed();
+
+  // Prefetching lets the OS read the pages in with a few large reads rather
+  // than a fault per page.
+  Prefetch(offset, size);
+
+  const size_t page_size = GetPageSize();
+  const volatile uint8_t* const data = data_ + offset;
+  uint8_t sum = 0;
+  for (size_t i = 0; i < size; i += page_size)
+    sum += data[i];
+  sum += data[size - 1];
+  debug::Alias(&sum);
+}
+
 // static
 void MemoryMappedFile::CalculateVMAlignedBoundaries(int64_t start,
                                                     size_t size,
@@ -9,8 +9,10 @@
 #include <stdint.h>
 
 #include "base/base_export.h"
+#include "base/callback_forward.h"
 #include "base/files/file.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "build/build_config.h"
 
 #if defined(OS_WIN)
@@ -20,6 +22,7 @@
 namespace base {
 
 class FilePath;
+class TaskRunner;
 
 class BASE_EXPORT MemoryMappedFile {
  public:
@@ -100,6 +103,45 @@ class BASE_EXPORT MemoryMappedFile {
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
+  // The following are hints for the OS about how the mapped memory will be
+  // used, to avoid page faults on hot paths. They act on every page that
+  // overlaps [offset, offset + size) of data(), which must be within
+  // length(), and never change the contents of the mapping. They return false
+  // if the OS doesn't support the operation or it failed.
+
+  // Starts reading the pages in from the file without waiting for them, so
+  // that the first access to them doesn't block on disk I/O
+  // (madvise(MADV_WILLNEED) on POSIX, PrefetchVirtualMemory() on Windows 8+).
+  bool Prefetch(size_t offset, size_t size);
+
+  // Tells the OS that the whole mapping will be read sequentially, so that it
+  // reads ahead aggressively, or randomly, so that it doesn't read ahead at
+  // all. Not supported on Windows, where this is decided when opening the
+  // file.
+  bool AdviseSequential();
+  bool AdviseRandom();
+
+  // Reads the pages in and keeps them in physical memory until they are
+  // unlocked or the file is closed, so that accessing them never faults.
+  // The amount of memory a process can lock is limited (RLIMIT_MEMLOCK on
+  // POSIX, the minimum working set size on Windows).
+  bool Lock(size_t offset, size_t size);
+  bool Unlock(size_t offset, size_t size);
+
+  // Removes the pages from this process's memory, so that the next access
+  // reads them back in. Writes to a writable mapping are not lost. Locked
+  // pages must be unlocked first.
+  bool Evict(size_t offset, size_t size);
+
+  // Prefetches the pages and then touches every one of them on |task_runner|,
+  // which must allow blocking, so that they are resident before first use.
+  // Replies with |reply| on the current sequence once done. This object must
+  // not be closed or destroyed before |reply| runs.
+  void PrefetchAsync(size_t offset,
+                     size_t size,
+                     scoped_refptr<TaskRunner> task_runner,
+                     OnceClosure reply);
+
  private:
   // Given the arbitrarily aligned memory region [start, size], returns the
   // boundaries of the region aligned to the granularity specified by the OS,
@@ -120,6 +162,22 @@ class BASE_EXPORT MemoryMappedFile {
   // Closes all open handles.
   void CloseHandles();
 
+  enum class AccessPattern {
+    SEQUENTIAL,
+    RANDOM,
+  };
+
+  // Implements AdviseSequential() and AdviseRandom().
+  bool AdviseAccessPattern(AccessPattern pattern);
+
+  // Returns true if [offset, offset + size) is a non-empty range of data().
+  bool IsValidRange(size_t offset, size_t size) const;
+
+  // Prefetches the pages overlapping [offset, offset + size) of data() and
+  // reads one byte from each of them, which blocks until they are resident.
+  // This is a helper for PrefetchAsync().
+  void WarmUp(size_t offset, size_t size);
+
   File file_;
   uint8_t* data_;
   size_t length_;
@@ -13,6 +13,7 @@
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/process/process_metrics.h"
 #include "base/threading/thread_restrictions.h"
 #include "build/build_config.h"
 
@@ -22,6 +23,38 @@
 
 namespace base {
 
+#if !defined(OS_NACL)
+namespace {
+
+// madvise() and mlock() act on whole pages, and madvise() requires |addr| to
+// be page-aligned, so widen the |size| bytes at |data| to the pages containing
+// them.
+void AlignToPages(uint8_t* data,
+                  size_t size,
+                  void** aligned_data,
+                  size_t* aligned_size) {
+  const uintptr_t page_mask = GetPageSize() - 1;
+  const uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~page_mask;
+  const uintptr_t end =
+      (reinterpret_cast<uintptr_t>(data) + size + page_mask) & ~page_mask;
+  *aligned_data = reinterpret_cast<void*>(start);
+  *aligned_size = end - start;
+}
+
+bool Advise(uint8_t* data, size_t size, int advice) {
+  void* aligned_data;
+  size_t aligned_size;
+  AlignToPages(data, size, &aligned_data, &aligned_size);
+  if (madvise(aligned_data, aligned_size, advice) != 0) {
+    DPLOG(ERROR) << "madvise " << advice;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+#endif  // !defined(OS_NACL)
+
 MemoryMappedFile::MemoryMappedFile() : data_(nullptr), length_(0) {}
 
 #if !defined(OS_NACL)
@@ -169,6 +202,52 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   data_ += data_offset;
   return true;
 }
+
+bool MemoryMappedFile::Prefetch(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+  return Advise(data_ + offset, size, MADV_WILLNEED);
+}
+
+bool MemoryMappedFile::AdviseAccessPattern(AccessPattern pattern) {
+  DCHECK(IsValid());
+  return Advise(data_, length_, pattern == AccessPattern::SEQUENTIAL
+                                    ? MADV_SEQUENTIAL
+                                    : MADV_RANDOM);
+}
+
+bool MemoryMappedFile::Lock(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+  AssertBlockingAllowed();
+
+  void* aligned_data;
+  size_t aligned_size;
+  AlignToPages(data_ + offset, size, &aligned_data, &aligned_size);
+  if (mlock(aligned_data, aligned_size) != 0) {
+    DPLOG(ERROR) << "mlock";
+    return false;
+  }
+  return true;
+}
+
+bool MemoryMappedFile::Unlock(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+
+  void* aligned_data;
+  size_t aligned_size;
+  AlignToPages(data_ + offset, size, &aligned_data, &aligned_size);
+  if (munlock(aligned_data, aligned_size) != 0) {
+    DPLOG(ERROR) << "munlock";
+    return false;
+  }
+  return true;
+}
+
+bool MemoryMappedFile::Evict(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+  // The mapping is MAP_SHARED, so this only drops this process's references
+  // to the pages. Dirty pages are still written back to the file.
+  return Advise(data_ + offset, size, MADV_DONTNEED);
+}
 #endif
 
 void MemoryMappedFile::CloseHandles() {
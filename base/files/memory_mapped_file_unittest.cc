@@ -11,6 +11,10 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/run_loop.h"
+#include "base/task/post_task.h"
+#include "base/test/scoped_task_environment.h"
+#include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
 
@@ -238,6 +242,71 @@ TEST_F(MemoryMappedFileTest, ExtendableFile) {
   EXPECT_EQ("BAZ", contents.substr(kFileSize, 3));
 }
 
+TEST_F(MemoryMappedFileTest, PageHints) {
+  const size_t kFileSize = 256 * 1024 + 17;
+  const int64_t kOffset = 4097;
+  const size_t kPartialSize = 128 * 1024 + 3;
+  CreateTemporaryTestFile(kFileSize);
+
+  File file(temp_file_path(), File::FLAG_OPEN | File::FLAG_READ);
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(std::move(file), {kOffset, kPartialSize}));
+
+  // None of the hints changes the contents of the mapping, even though they
+  // act on the whole pages around the unaligned region.
+#if defined(OS_POSIX) && !defined(OS_FUCHSIA)
+  EXPECT_TRUE(map.Prefetch(0, kPartialSize));
+  EXPECT_TRUE(map.AdviseSequential());
+  EXPECT_TRUE(map.AdviseRandom());
+  EXPECT_TRUE(map.Evict(1, kPartialSize - 2));
+#else
+  map.Prefetch(0, kPartialSize);
+  map.AdviseSequential();
+  map.AdviseRandom();
+  map.Evict(1, kPartialSize - 2);
+#endif
+  EXPECT_TRUE(CheckBufferContents(map.data(), kPartialSize, kOffset));
+
+  // Locking can fail because of limits on locked memory, but unlocking pages
+  // that were locked can't.
+  if (map.Lock(100, 1000))
+    EXPECT_TRUE(map.Unlock(100, 1000));
+  EXPECT_TRUE(CheckBufferContents(map.data(), kPartialSize, kOffset));
+}
+
+TEST_F(MemoryMappedFileTest, EvictWritableFile) {
+  const size_t kFileSize = 64 * 1024;
+  CreateTemporaryTestFile(kFileSize);
+
+  {
+    MemoryMappedFile map;
+    ASSERT_TRUE(map.Initialize(temp_file_path(), MemoryMappedFile::READ_WRITE));
+    map.data()[kFileSize - 1] = '!';
+    map.Evict(0, kFileSize);
+    EXPECT_EQ('!', map.data()[kFileSize - 1]);
+    EXPECT_TRUE(CheckBufferContents(map.data(), kFileSize - 1, 0));
+  }
+
+  std::string contents;
+  ASSERT_TRUE(ReadFileToString(temp_file_path(), &contents));
+  EXPECT_EQ("!", contents.substr(kFileSize - 1, 1));
+}
+
+TEST_F(MemoryMappedFileTest, PrefetchAsync) {
+  const size_t kFileSize = 256 * 1024 + 17;
+  CreateTemporaryTestFile(kFileSize);
+
+  test::ScopedTaskEnvironment scoped_task_environment;
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(temp_file_path()));
+
+  RunLoop run_loop;
+  map.PrefetchAsync(0, kFileSize, CreateTaskRunnerWithTraits({MayBlock()}),
+                    run_loop.QuitClosure());
+  run_loop.Run();
+  EXPECT_TRUE(CheckBufferContents(map.data(), kFileSize, 0));
+}
+
 }  // namespace
 
 }  // namespace base
@@ -10,6 +10,7 @@
 #include <limits>
 
 #include "base/files/file_path.h"
+#include "base/logging.h"
 #include "base/strings/string16.h"
 #include "base/threading/thread_restrictions.h"
 
@@ -17,6 +18,20 @@
 
 namespace base {
 
+namespace {
+
+// PrefetchVirtualMemory() is only available on Windows 8 and later.
+using PrefetchVirtualMemoryFunction = decltype(&::PrefetchVirtualMemory);
+
+PrefetchVirtualMemoryFunction GetPrefetchVirtualMemoryFunction() {
+  static const PrefetchVirtualMemoryFunction prefetch_virtual_memory =
+      reinterpret_cast<PrefetchVirtualMemoryFunction>(::GetProcAddress(
+          ::GetModuleHandle(L"kernel32.dll"), "PrefetchVirtualMemory"));
+  return prefetch_virtual_memory;
+}
+
+}  // namespace
+
 MemoryMappedFile::MemoryMappedFile() : data_(NULL), length_(0) {
 }
 
@@ -94,6 +109,59 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   return true;
 }
 
+bool MemoryMappedFile::Prefetch(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+  PrefetchVirtualMemoryFunction prefetch_virtual_memory =
+      GetPrefetchVirtualMemoryFunction();
+  if (!prefetch_virtual_memory)
+    return false;
+
+  WIN32_MEMORY_RANGE_ENTRY range = {data_ + offset, size};
+  if (!prefetch_virtual_memory(::GetCurrentProcess(), 1, &range, 0)) {
+    DPLOG(ERROR) << "PrefetchVirtualMemory";
+    return false;
+  }
+  return true;
+}
+
+bool MemoryMappedFile::AdviseAccessPattern(AccessPattern pattern) {
+  DCHECK(IsValid());
+  // Windows only takes this hint when opening the file, through
+  // FILE_FLAG_SEQUENTIAL_SCAN and FILE_FLAG_RANDOM_ACCESS.
+  return false;
+}
+
+bool MemoryMappedFile::Lock(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+  AssertBlockingAllowed();
+
+  if (!::VirtualLock(data_ + offset, size)) {
+    DPLOG(ERROR) << "VirtualLock";
+    return false;
+  }
+  return true;
+}
+
+bool MemoryMappedFile::Unlock(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+
+  if (!::VirtualUnlock(data_ + offset, size)) {
+    DPLOG(ERROR) << "VirtualUnlock";
+    return false;
+  }
+  return true;
+}
+
+bool MemoryMappedFile::Evict(size_t offset, size_t size) {
+  DCHECK(IsValidRange(offset, size));
+  // Calling VirtualUnlock() on pages that aren't locked removes them from the
+  // working set, and reports ERROR_NOT_LOCKED when it did so. Locked pages
+  // are unlocked instead, which callers must not rely on.
+  if (::VirtualUnlock(data_ + offset, size))
+    return false;
+  return ::GetLastError() == ERROR_NOT_LOCKED;
+}
+
 void MemoryMappedFile::CloseHandles() {
   if (data_)
     ::UnmapViewOfFile(data_);
@@ -4,10 +4,13 @@
 
 #include "base/json/json_parser.h"
 
+#include <string.h>
+
 #include <cmath>
 #include <utility>
 #include <vector>
 
+#include "base/bits.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/numerics/safe_conversions.h"
@@ -17,8 +20,14 @@
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversion_utils.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/sys_byteorder.h"
 #include "base/third_party/icu/icu_utf.h"
 #include "base/values.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace base {
 namespace internal {
@@ -50,6 +59,107 @@ class StackMarker {
 
 constexpr uint32_t kUnicodeReplacementPoint = 0xFFFD;
 
+// The scanners below look at a block of input at a time: 16 bytes with SSE2,
+// which every x86 CPU Chrome supports, and otherwise 8 bytes packed into a
+// uint64_t. The tail of the input is scanned one byte at a time.
+
+#if !defined(ARCH_CPU_X86_FAMILY)
+constexpr uint64_t kLowBits = 0x7F7F7F7F7F7F7F7FULL;
+
+// Returns a word with the high bit of each byte set iff that byte of |word|
+// is zero, and all other bits clear.
+inline uint64_t ZeroBytes(uint64_t word) {
+  return ~(((word & kLowBits) + kLowBits) | word | kLowBits);
+}
+
+// Returns a word with every byte equal to |c|.
+inline uint64_t Broadcast(char c) {
+  return 0x0101010101010101ULL * static_cast<uint8_t>(c);
+}
+
+// Loads 8 bytes so that the first byte in memory is the least significant.
+inline uint64_t LoadWord(const char* p) {
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  return ByteSwapToLE64(word);
+}
+
+// Returns the index of the first byte whose high bit is set in |mask|, which
+// must be non-zero.
+inline size_t FirstMarkedByte(uint64_t mask) {
+  return bits::CountTrailingZeroBits(mask) / 8;
+}
+#endif  // !defined(ARCH_CPU_X86_FAMILY)
+
+// Returns true if |c| is stored as-is in a string: it is ASCII and neither
+// ends the string nor starts an escape sequence.
+inline bool IsPlainStringChar(char c) {
+  return static_cast<uint8_t>(c) < kExtendedASCIIStart && c != '"' &&
+         c != '\\';
+}
+
+// Returns the number of leading bytes of [begin, end) for which
+// IsPlainStringChar() is true.
+size_t CountPlainStringChars(const char* begin, const char* end) {
+  const char* p = begin;
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  for (; end - p >= 16; p += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // Non-ASCII bytes already have their high bit set.
+    const __m128i special =
+        _mm_or_si128(chars, _mm_or_si128(_mm_cmpeq_epi8(chars, quote),
+                                         _mm_cmpeq_epi8(chars, backslash)));
+    const uint32_t mask = _mm_movemask_epi8(special);
+    if (mask)
+      return (p - begin) + bits::CountTrailingZeroBits(mask);
+  }
+#else
+  for (; end - p >= 8; p += 8) {
+    const uint64_t word = LoadWord(p);
+    const uint64_t special = (word & ~kLowBits) |
+                             ZeroBytes(word ^ Broadcast('"')) |
+                             ZeroBytes(word ^ Broadcast('\\'));
+    if (special)
+      return (p - begin) + FirstMarkedByte(special);
+  }
+#endif
+  while (p != end && IsPlainStringChar(*p))
+    ++p;
+  return p - begin;
+}
+
+// Returns the number of leading bytes of [begin, end) that are spaces or
+// tabs, which is how pretty-printed JSON is usually indented.
+size_t CountSpacesAndTabs(const char* begin, const char* end) {
+  const char* p = begin;
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  for (; end - p >= 16; p += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i blank =
+        _mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab));
+    const uint32_t mask = ~_mm_movemask_epi8(blank) & 0xFFFF;
+    if (mask)
+      return (p - begin) + bits::CountTrailingZeroBits(mask);
+  }
+#else
+  for (; end - p >= 8; p += 8) {
+    const uint64_t word = LoadWord(p);
+    const uint64_t blank =
+        ZeroBytes(word ^ Broadcast(' ')) | ZeroBytes(word ^ Broadcast('\t'));
+    const uint64_t other = ~blank & ~kLowBits;
+    if (other)
+      return (p - begin) + FirstMarkedByte(other);
+  }
+#endif
+  while (p != end && (*p == ' ' || *p == '\t'))
+    ++p;
+  return p - begin;
+}
+
 }  // namespace
 
 // This is U+FFFD.
@@ -151,6 +261,15 @@ void JSONParser::StringBuilder::Append(uint32_t point) {
   }
 }
 
+void JSONParser::StringBuilder::AppendInput(const char* chars, size_t count) {
+  if (!string_) {
+    DCHECK_EQ(pos_ + length_, chars);
+    length_ += count;
+  } else {
+    string_->append(chars, count);
+  }
+}
+
 void JSONParser::StringBuilder::Convert() {
   if (string_)
     return;
@@ -254,10 +373,11 @@ void JSONParser::EatWhitespaceAndComments() {
         if (!(c == '\n' && index_ > 0 && input_[index_ - 1] == '\r')) {
           ++line_number_;
         }
-        FALLTHROUGH;
+        ConsumeChar();
+        break;
       case ' ':
       case '\t':
-        ConsumeChar();
+        index_ += CountSpacesAndTabs(pos(), input_.data() + input_.length());
         break;
       case '/':
         if (!EatComment())
@@ -446,12 +566,24 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
     return false;
   }
 
-  // StringBuilder will internally build a StringPiece unless a UTF-16
-  // conversion occurs, at which point it will perform a copy into a
-  // std::string.
+  // StringBuilder will internally build a StringPiece unless an escape
+  // sequence or invalid character has to be decoded, at which point it will
+  // perform a copy into a std::string.
   StringBuilder string(pos());
+  const char* const input_end = input_.data() + input_.length();
 
   while (PeekChar()) {
+    // Most strings are mostly ASCII without escapes, so skip over runs of
+    // characters that are stored as-is before decoding the next one.
+    const char* run = pos();
+    const size_t run_length = CountPlainStringChars(run, input_end);
+    if (run_length) {
+      string.AppendInput(run, run_length);
+      index_ += run_length;
+      continue;
+    }
+
+    const int32_t char_start = index_;
     uint32_t next_char = 0;
     if (!ReadUnicodeCharacter(input_.data(),
                               static_cast<int32_t>(input_.length()),
@@ -472,9 +604,10 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
       *out = std::move(string);
       return true;
     } else if (next_char != '\\') {
-      // If this character is not an escape sequence...
+      // If this character is not an escape sequence, its UTF-8 encoding in
+      // the input is also its encoding in the output.
       ConsumeChar();
-      string.Append(next_char);
+      string.AppendInput(input_.data() + char_start, index_ - char_start);
     } else {
       // And if it is an escape sequence, the input string will be adjusted
       // (either by combining the two characters of an encoded escape sequence,
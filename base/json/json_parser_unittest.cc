@@ -458,5 +458,68 @@ TEST_F(JSONParserTest, UnterminatedInputs) {
   }
 }
 
+// Strings are scanned several bytes at a time, so verify that characters
+// that need decoding are handled at every offset within a block.
+TEST_F(JSONParserTest, ConsumeLongStrings) {
+  const struct {
+    const char* input;
+    const char* expected;
+  } kSpecialChars[] = {
+      {"\\n", "\n"},
+      {"\\\"", "\""},
+      {"\\u00e9", "\xC3\xA9"},
+      {"\xC3\xA9", "\xC3\xA9"},
+      {"\xF0\x9F\x98\x87", "\xF0\x9F\x98\x87"},
+  };
+
+  for (const auto& special : kSpecialChars) {
+    for (int prefix = 0; prefix < 40; ++prefix) {
+      SCOPED_TRACE(StringPrintf("%s after %d chars", special.input, prefix));
+      const std::string padding(prefix, 'a');
+      const std::string input =
+          "\"" + padding + special.input + padding + "\"";
+      std::unique_ptr<JSONParser> parser(NewTestParser(input));
+      Optional<Value> value(parser->ConsumeString());
+      ASSERT_TRUE(value);
+      std::string str;
+      EXPECT_TRUE(value->GetAsString(&str));
+      EXPECT_EQ(padding + special.expected + padding, str);
+      EXPECT_EQ(input.length(), static_cast<size_t>(parser->index_));
+    }
+  }
+}
+
+TEST_F(JSONParserTest, UnterminatedLongString) {
+  for (int length = 0; length < 40; ++length) {
+    SCOPED_TRACE(StringPrintf("length %d", length));
+    const std::string input = "[\"" + std::string(length, 'a');
+    std::unique_ptr<char[]> input_owner;
+    EXPECT_FALSE(JSONReader::Read(
+        MakeNotNullTerminatedInput(input.c_str(), &input_owner)));
+  }
+}
+
+TEST_F(JSONParserTest, IndentedInput) {
+  const char kIndented[] =
+      "{\n"
+      "                    \"a\":\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t1,\n"
+      "  \t  \t  \t  \t  \t  \t  \t  \"b\": [ 2 ,  3 ]\r\n"
+      "                                        }";
+  std::unique_ptr<Value> root = JSONReader::Read(kIndented);
+  ASSERT_TRUE(root);
+  EXPECT_EQ(1, root->FindKey("a")->GetInt());
+  EXPECT_EQ(2U, root->FindKey("b")->GetList().size());
+
+  // Errors after long runs of whitespace still have the right position.
+  std::string error_message;
+  int error_code = 0;
+  root = JSONReader::ReadAndReturnError(
+      "[\n                                    1,\n         \t        2 3]",
+      JSON_PARSE_RFC, &error_code, &error_message);
+  EXPECT_FALSE(root);
+  EXPECT_EQ(JSONParser::FormatErrorMessage(3, 22, JSONReader::kSyntaxError),
+            error_message);
+}
+
 }  // namespace internal
 }  // namespace base
@@ -47,6 +47,20 @@ std::unique_ptr<DictionaryValue> GenerateLayeredDict(int breadth, int depth) {
   return root;
 }
 
+// Generates a list of |count| strings of |length| characters, each of which
+// starts with |prefix|.
+std::unique_ptr<ListValue> GenerateStringList(int count,
+                                              int length,
+                                              const std::string& prefix) {
+  auto list = std::make_unique<ListValue>();
+  std::string str = prefix;
+  for (int i = static_cast<int>(str.length()); i < length; ++i)
+    str.push_back('a' + i % 26);
+  for (int i = 0; i < count; ++i)
+    list->AppendString(str);
+  return list;
+}
+
 }  // namespace
 
 class JSONPerfTest : public testing::Test {
@@ -71,6 +85,15 @@ class JSONPerfTest : public testing::Test {
                            (end_read - start_read).InMillisecondsF(), "ms",
                            true);
   }
+
+  void TestRead(const std::string& description, const std::string& json) {
+    TimeTicks start_read = TimeTicks::Now();
+    EXPECT_TRUE(JSONReader::Read(json));
+    TimeTicks end_read = TimeTicks::Now();
+    perf_test::PrintResult("Read", "", description,
+                           (end_read - start_read).InMillisecondsF(), "ms",
+                           true);
+  }
 };
 
 TEST_F(JSONPerfTest, StressTest) {
@@ -81,4 +104,28 @@ TEST_F(JSONPerfTest, StressTest) {
   }
 }
 
+TEST_F(JSONPerfTest, LongStrings) {
+  const struct {
+    const char* description;
+    const char* prefix;
+  } kCases[] = {
+      {"ASCII strings", ""},
+      {"UTF-8 strings", "\xC3\xA9t\xC3\xA9"},
+      {"Escaped strings", "\"quoted\"\n"},
+  };
+  for (const auto& test_case : kCases) {
+    std::string json;
+    JSONWriter::Write(*GenerateStringList(10000, 1000, test_case.prefix),
+                      &json);
+    TestRead(test_case.description, json);
+  }
+}
+
+TEST_F(JSONPerfTest, PrettyPrinted) {
+  std::string json;
+  JSONWriter::WriteWithOptions(*GenerateLayeredDict(3, 9),
+                               JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+  TestRead("Pretty printed, Breadth: 3, Depth: 9", json);
+}
+
 }  // namespace base
@@ -27,6 +27,7 @@
 #include "base/metrics/persistent_histogram_allocator.h"
 #include "base/metrics/persistent_memory_allocator.h"
 #include "base/metrics/sample_vector.h"
+#include "base/metrics/sharded_sample_counts.h"
 #include "base/metrics/statistics_recorder.h"
 #include "base/pickle.h"
 #include "base/strings/string_util.h"
@@ -211,6 +212,16 @@ HistogramBase* Histogram::Factory::Build() {
       tentative_histogram->SetFlags(flags_);
     }
 
+    // Sharded samples live on the heap of this process even for persistent
+    // histograms; they are moved to the (persistent) unlogged samples by
+    // MergeShardedSamples().
+    if (flags_ & HistogramBase::kShardedSamples) {
+      Histogram* sharded_histogram =
+          static_cast<Histogram*>(tentative_histogram.get());
+      sharded_histogram->sharded_samples_ =
+          std::make_unique<ShardedSampleCounts>(registered_ranges);
+    }
+
     FillHistogram(tentative_histogram.get());
 
     // Register this histogram with the StatisticsRecorder. Keep a copy of
@@ -500,7 +511,10 @@ void Histogram::AddCount(int value, int count) {
     NOTREACHED();
     return;
   }
-  unlogged_samples_->Accumulate(value, count);
+  if (sharded_samples_)
+    sharded_samples_->Accumulate(value, count);
+  else
+    unlogged_samples_->Accumulate(value, count);
 
   FindAndRunCallback(value);
 }
@@ -524,7 +538,10 @@ std::unique_ptr<HistogramSamples> Histogram::SnapshotDelta() {
   // a snapshot is captured. Note that this is why it's important to subtract
   // exactly the snapshotted unlogged samples, rather than simply resetting the
   // vector: this way, the next snapshot will include any concurrent updates
-  // missed by the current snapshot.
+  // missed by the current snapshot. Sharded samples are extracted the same
+  // way, so samples recorded while they are moved stay for the next snapshot.
+
+  MergeShardedSamples();
 
   std::unique_ptr<HistogramSamples> snapshot = SnapshotUnloggedSamples();
   unlogged_samples_->Subtract(*snapshot);
@@ -539,7 +556,12 @@ std::unique_ptr<HistogramSamples> Histogram::SnapshotFinalDelta() const {
   final_delta_created_ = true;
 #endif
 
-  return SnapshotUnloggedSamples();
+  return SnapshotPendingSamples();
+}
+
+void Histogram::MergeShardedSamples() {
+  if (sharded_samples_)
+    unlogged_samples_->Add(*sharded_samples_->Extract(unlogged_samples_->id()));
 }
 
 void Histogram::AddSamples(const HistogramSamples& samples) {
@@ -662,7 +684,7 @@ HistogramBase* Histogram::DeserializeInfoImpl(PickleIterator* iter) {
 }
 
 std::unique_ptr<SampleVector> Histogram::SnapshotAllSamples() const {
-  std::unique_ptr<SampleVector> samples = SnapshotUnloggedSamples();
+  std::unique_ptr<SampleVector> samples = SnapshotPendingSamples();
   samples->Add(*logged_samples_);
   return samples;
 }
@@ -674,6 +696,13 @@ std::unique_ptr<SampleVector> Histogram::SnapshotUnloggedSamples() const {
   return samples;
 }
 
+std::unique_ptr<SampleVector> Histogram::SnapshotPendingSamples() const {
+  std::unique_ptr<SampleVector> samples = SnapshotUnloggedSamples();
+  if (sharded_samples_)
+    samples->Add(*sharded_samples_->Snapshot(unlogged_samples_->id()));
+  return samples;
+}
+
 void Histogram::WriteAsciiImpl(bool graph_it,
                                const std::string& newline,
                                std::string* output) const {
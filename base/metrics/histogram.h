@@ -95,6 +95,7 @@ class LinearHistogram;
 class Pickle;
 class PickleIterator;
 class SampleVector;
+class ShardedSampleCounts;
 class SampleVectorBase;
 
 class BASE_EXPORT Histogram : public HistogramBase {
@@ -215,6 +216,7 @@ class BASE_EXPORT Histogram : public HistogramBase {
   std::unique_ptr<HistogramSamples> SnapshotSamples() const override;
   std::unique_ptr<HistogramSamples> SnapshotDelta() override;
   std::unique_ptr<HistogramSamples> SnapshotFinalDelta() const override;
+  void MergeShardedSamples() override;
   void AddSamples(const HistogramSamples& samples) override;
   bool AddSamplesFromPickle(base::PickleIterator* iter) override;
   void WriteHTMLGraph(std::string* output) const override;
@@ -290,6 +292,10 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // Create a copy of unlogged samples.
   std::unique_ptr<SampleVector> SnapshotUnloggedSamples() const;
 
+  // Like SnapshotUnloggedSamples(), but also includes the samples that are
+  // still held in |sharded_samples_|.
+  std::unique_ptr<SampleVector> SnapshotPendingSamples() const;
+
   //----------------------------------------------------------------------------
   // Helpers for emitting Ascii graphic.  Each method appends data to output.
 
@@ -326,6 +332,11 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // Accumulation of all samples that have been logged with SnapshotDelta().
   std::unique_ptr<SampleVectorBase> logged_samples_;
 
+  // Samples recorded in a histogram with the kShardedSamples flag, which are
+  // moved to |unlogged_samples_| by MergeShardedSamples(). It is set up by the
+  // Factory before the histogram is registered, and null otherwise.
+  std::unique_ptr<ShardedSampleCounts> sharded_samples_;
+
 #if DCHECK_IS_ON()  // Don't waste memory if it won't be used.
   // Flag to indicate if PrepareFinalDelta has been previously called. It is
   // used to DCHECK that a final delta is not created multiple times.
@@ -131,6 +131,15 @@ class BASE_EXPORT HistogramBase {
     // MemoryAllocator, and that loaded into the Histogram module before this
     // histogram is created.
     kIsPersistent = 0x40,
+
+    // Indicates that samples are recorded into per-thread shards which are
+    // merged when deltas are prepared, so that threads recording at the
+    // same time don't contend on the same counts. Intended for histograms
+    // that are recorded very frequently from many threads. Samples held in
+    // the shards are only visible to other processes reading persistent
+    // memory after the next StatisticsRecorder::PrepareDeltas() call in this
+    // process.
+    kShardedSamples = 0x80,
   };
 
   // Histogram data inconsistency types.
@@ -232,6 +241,11 @@ class BASE_EXPORT HistogramBase {
   // read-only memory.
   virtual std::unique_ptr<HistogramSamples> SnapshotFinalDelta() const = 0;
 
+  // Moves samples that are held outside of the histogram's sample storage
+  // (see kShardedSamples) to it, so that they are visible to other processes
+  // reading persistent memory. Snapshots already include these samples.
+  virtual void MergeShardedSamples();
+
   // The following methods provide graphical histogram displays.
   virtual void WriteHTMLGraph(std::string* output) const = 0;
   virtual void WriteAscii(std::string* output) const = 0;
@@ -17,6 +17,7 @@
 #include "base/logging.h"
 #include "base/metrics/bucket_ranges.h"
 #include "base/metrics/dummy_histogram.h"
+#include "base/metrics/histogram_delta_serialization.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/metrics_hashes.h"
 #include "base/metrics/persistent_histogram_allocator.h"
@@ -222,6 +223,85 @@ TEST_P(HistogramTest, FinalDeltaTest) {
   EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
 }
 
+// Check that samples of a sharded histogram are moved into the delta.
+TEST_P(HistogramTest, ShardedDeltaTest) {
+  HistogramBase* histogram =
+      Histogram::FactoryGet("ShardedDeltaHistogram", 1, 64, 8,
+                            HistogramBase::kShardedSamples);
+  EXPECT_TRUE(histogram->flags() & HistogramBase::kShardedSamples);
+  histogram->Add(1);
+  histogram->Add(10);
+  histogram->AddCount(50, 3);
+
+  // Snapshots that aren't deltas include the samples still in the shards.
+  std::unique_ptr<HistogramSamples> samples = histogram->SnapshotSamples();
+  EXPECT_EQ(5, samples->TotalCount());
+  EXPECT_EQ(3, samples->GetCount(50));
+  EXPECT_EQ(161, samples->sum());
+
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(5, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(1));
+  EXPECT_EQ(1, samples->GetCount(10));
+  EXPECT_EQ(3, samples->GetCount(50));
+  EXPECT_EQ(161, samples->sum());
+  EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
+
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(0, samples->TotalCount());
+
+  histogram->Add(10);
+  histogram->Add(10);
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(2, samples->TotalCount());
+  EXPECT_EQ(2, samples->GetCount(10));
+
+  histogram->Add(2);
+  samples = histogram->SnapshotFinalDelta();
+  EXPECT_EQ(1, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(2));
+
+  samples = histogram->SnapshotSamples();
+  EXPECT_EQ(8, samples->TotalCount());
+  EXPECT_EQ(4, samples->GetCount(10));
+}
+
+// Check that the sharded samples of a persistent histogram reach persistent
+// memory when deltas that exclude persistent histograms are prepared, like
+// child processes do.
+TEST_P(HistogramTest, ShardedSamplesReachPersistentMemory) {
+  if (!use_persistent_histogram_allocator_)
+    return;
+
+  HistogramBase* histogram =
+      Histogram::FactoryGet("ShardedPersistentHistogram", 1, 64, 8,
+                            HistogramBase::kShardedSamples);
+  ASSERT_TRUE(histogram->flags() & HistogramBase::kIsPersistent);
+  histogram->Add(10);
+  histogram->AddCount(50, 3);
+
+  HistogramDeltaSerialization serializer("HistogramTest");
+  std::vector<std::string> deltas;
+  serializer.PrepareAndSerializeDeltas(&deltas, false);
+
+  // Read the histogram back from persistent memory, as the browser process
+  // does for child processes.
+  std::unique_ptr<HistogramBase> persistent_histogram;
+  PersistentHistogramAllocator::Iterator iter(GlobalHistogramAllocator::Get());
+  while (std::unique_ptr<HistogramBase> found = iter.GetNext()) {
+    if (StringPiece(found->histogram_name()) == "ShardedPersistentHistogram") {
+      persistent_histogram = std::move(found);
+      break;
+    }
+  }
+  ASSERT_TRUE(persistent_histogram);
+  std::unique_ptr<HistogramSamples> samples =
+      persistent_histogram->SnapshotDelta();
+  EXPECT_EQ(4, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(10));
+  EXPECT_EQ(3, samples->GetCount(50));
+}
+
 TEST_P(HistogramTest, ExponentialRangesTest) {
   // Check that we got a nice exponential when there was enough room.
   BucketRanges ranges(9);
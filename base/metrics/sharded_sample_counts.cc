@@ -0,0 +1,162 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/sharded_sample_counts.h"
+
+#include <vector>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/metrics/bucket_ranges.h"
+#include "base/metrics/sample_vector.h"
+#include "base/no_destructor.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+
+typedef HistogramBase::Count Count;
+typedef HistogramBase::Sample Sample;
+
+namespace {
+
+constexpr size_t kCacheLineSize = 64;
+
+// The slot holding the shard index of the calling thread, plus one so that
+// threads that haven't recorded yet can be told apart.
+ThreadLocalStorage::Slot& CurrentShardIndexPlusOne() {
+  static NoDestructor<ThreadLocalStorage::Slot> shard_index;
+  return *shard_index;
+}
+
+size_t GetCurrentShardIndex() {
+  ThreadLocalStorage::Slot& slot = CurrentShardIndexPlusOne();
+  uintptr_t index_plus_one = reinterpret_cast<uintptr_t>(slot.Get());
+  if (!index_plus_one) {
+    static std::atomic<uintptr_t> next_index{0};
+    index_plus_one =
+        next_index.fetch_add(1, std::memory_order_relaxed) %
+            ShardedSampleCounts::kNumShards +
+        1;
+    slot.Set(reinterpret_cast<void*>(index_plus_one));
+  }
+  return index_plus_one - 1;
+}
+
+// A SampleVector holding samples collected from the shards. The sum and the
+// redundant count can't be derived from the bucket counts, so they are set
+// directly.
+class CollectedSampleVector : public SampleVector {
+ public:
+  CollectedSampleVector(uint64_t id,
+                        const BucketRanges* bucket_ranges,
+                        int64_t sum,
+                        Count redundant_count,
+                        const std::vector<HistogramBase::AtomicCount>& counts)
+      : SampleVector(id, bucket_ranges) {
+    IncreaseSumAndCount(sum, redundant_count);
+    SampleVectorIterator iter(&counts, bucket_ranges);
+    AddSubtractImpl(&iter, ADD);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(CollectedSampleVector);
+};
+
+}  // namespace
+
+// The sum and redundant count of one shard. It is padded so that shards don't
+// share cache lines, except partially with their neighbours if the array
+// isn't aligned.
+struct ShardedSampleCounts::Shard {
+  std::atomic<int64_t> sum{0};
+  std::atomic<Count> redundant_count{0};
+  char padding[kCacheLineSize - sizeof(int64_t) - sizeof(Count)];
+};
+
+constexpr size_t ShardedSampleCounts::kNumShards;
+
+ShardedSampleCounts::ShardedSampleCounts(const BucketRanges* bucket_ranges)
+    : bucket_ranges_(bucket_ranges),
+      counts_stride_(bits::Align(bucket_ranges->bucket_count(),
+                                 kCacheLineSize / sizeof(Count))),
+      shards_(new Shard[kNumShards]),
+      counts_(new std::atomic<Count>[kNumShards * counts_stride_]) {
+  CHECK_GE(bucket_ranges_->bucket_count(), 1u);
+  for (size_t i = 0; i < kNumShards * counts_stride_; ++i)
+    counts_[i].store(0, std::memory_order_relaxed);
+}
+
+ShardedSampleCounts::~ShardedSampleCounts() = default;
+
+void ShardedSampleCounts::Accumulate(Sample value, Count count) {
+  const size_t bucket_index = GetBucketIndex(value);
+  const size_t shard_index = GetCurrentShardIndex();
+  Shard& shard = shards_[shard_index];
+
+  // Other threads only read the shard or swap it out with atomic exchanges,
+  // so relaxed increments are enough; the shard's lines normally stay in the
+  // cache of the core recording into it.
+  counts_[shard_index * counts_stride_ + bucket_index].fetch_add(
+      count, std::memory_order_relaxed);
+  shard.sum.fetch_add(strict_cast<int64_t>(count) * value,
+                      std::memory_order_relaxed);
+  shard.redundant_count.fetch_add(count, std::memory_order_relaxed);
+}
+
+std::unique_ptr<SampleVector> ShardedSampleCounts::Extract(uint64_t id) {
+  return CollectSamples(id, /*extract=*/true);
+}
+
+std::unique_ptr<SampleVector> ShardedSampleCounts::Snapshot(
+    uint64_t id) const {
+  return CollectSamples(id, /*extract=*/false);
+}
+
+size_t ShardedSampleCounts::GetBucketIndex(Sample value) const {
+  // This is the same search as SampleVectorBase::GetBucketIndex().
+  size_t under = 0;
+  size_t over = bucket_ranges_->bucket_count();
+  DCHECK_GE(value, bucket_ranges_->range(under));
+  DCHECK_LT(value, bucket_ranges_->range(over));
+  while (over - under > 1) {
+    const size_t mid = under + (over - under) / 2;
+    if (bucket_ranges_->range(mid) <= value)
+      under = mid;
+    else
+      over = mid;
+  }
+  return under;
+}
+
+std::unique_ptr<SampleVector> ShardedSampleCounts::CollectSamples(
+    uint64_t id,
+    bool extract) const {
+  const size_t bucket_count = bucket_ranges_->bucket_count();
+  auto take = [extract](std::atomic<Count>* value) {
+    return extract ? value->exchange(0, std::memory_order_relaxed)
+                   : value->load(std::memory_order_relaxed);
+  };
+
+  // As with SampleVector, the sum and counts of a shard are only eventually
+  // consistent with each other. Since everything taken out is returned, the
+  // samples recorded concurrently all end up in this or the next collection.
+  int64_t sum = 0;
+  Count redundant_count = 0;
+  std::vector<HistogramBase::AtomicCount> counts(bucket_count, 0);
+  for (size_t shard_index = 0; shard_index < kNumShards; ++shard_index) {
+    Shard& shard = shards_[shard_index];
+    sum += extract ? shard.sum.exchange(0, std::memory_order_relaxed)
+                   : shard.sum.load(std::memory_order_relaxed);
+    redundant_count += take(&shard.redundant_count);
+    std::atomic<Count>* shard_counts = &counts_[shard_index * counts_stride_];
+    for (size_t i = 0; i < bucket_count; ++i)
+      counts[i] += take(&shard_counts[i]);
+  }
+
+  return std::make_unique<CollectedSampleVector>(id, bucket_ranges_, sum,
+                                                 redundant_count, counts);
+}
+
+}  // namespace base
@@ -0,0 +1,69 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// ShardedSampleCounts holds the samples of a hot histogram in a set of
+// shards, so that threads recording at the same time don't write to the same
+// cache lines. It backs histograms created with the kShardedSamples flag.
+
+#ifndef BASE_METRICS_SHARDED_SAMPLE_COUNTS_H_
+#define BASE_METRICS_SHARDED_SAMPLE_COUNTS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/metrics/histogram_base.h"
+
+namespace base {
+
+class BucketRanges;
+class SampleVector;
+
+class BASE_EXPORT ShardedSampleCounts {
+ public:
+  // Threads are assigned shards round-robin, so up to this many threads can
+  // record without sharing a shard.
+  static constexpr size_t kNumShards = 16;
+
+  explicit ShardedSampleCounts(const BucketRanges* bucket_ranges);
+  ~ShardedSampleCounts();
+
+  // Adds |count| samples of |value| to the calling thread's shard.
+  void Accumulate(HistogramBase::Sample value, HistogramBase::Count count);
+
+  // Removes the samples of all shards and returns them with the given |id|.
+  // Samples accumulated concurrently are either returned or kept for the next
+  // call, but never lost.
+  std::unique_ptr<SampleVector> Extract(uint64_t id);
+
+  // Returns a copy of the samples of all shards with the given |id|.
+  std::unique_ptr<SampleVector> Snapshot(uint64_t id) const;
+
+ private:
+  struct Shard;
+
+  size_t GetBucketIndex(HistogramBase::Sample value) const;
+
+  // Collects the samples of all shards, resetting them if |extract| is true.
+  std::unique_ptr<SampleVector> CollectSamples(uint64_t id, bool extract) const;
+
+  const BucketRanges* const bucket_ranges_;
+
+  // The number of counts of each shard, rounded up to a whole number of cache
+  // lines.
+  const size_t counts_stride_;
+
+  std::unique_ptr<Shard[]> shards_;
+  std::unique_ptr<std::atomic<HistogramBase::Count>[]> counts_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedSampleCounts);
+};
+
+}  // namespace base
+
+#endif  // BASE_METRICS_SHARDED_SAMPLE_COUNTS_H_
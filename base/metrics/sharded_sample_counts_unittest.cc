@@ -0,0 +1,120 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/sharded_sample_counts.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/metrics/bucket_ranges.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/sample_vector.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const uint64_t kId = 1234;
+
+class AccumulateThread : public SimpleThread {
+ public:
+  AccumulateThread(ShardedSampleCounts* counts, int num_samples)
+      : SimpleThread("AccumulateThread", Options()),
+        counts_(counts),
+        num_samples_(num_samples) {}
+
+  void Run() override {
+    for (int i = 0; i < num_samples_; ++i)
+      counts_->Accumulate(i % 20, 1);
+  }
+
+ private:
+  ShardedSampleCounts* const counts_;
+  const int num_samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(AccumulateThread);
+};
+
+}  // namespace
+
+class ShardedSampleCountsTest : public testing::Test {
+ protected:
+  ShardedSampleCountsTest() : ranges_(11) {
+    // Buckets of width 2 between 0 and 20.
+    for (size_t i = 0; i < ranges_.bucket_count(); ++i)
+      ranges_.set_range(i, static_cast<HistogramBase::Sample>(i * 2));
+    ranges_.set_range(ranges_.bucket_count(), HistogramBase::kSampleType_MAX);
+    ranges_.ResetChecksum();
+  }
+
+  BucketRanges ranges_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ShardedSampleCountsTest);
+};
+
+TEST_F(ShardedSampleCountsTest, ExtractAndSnapshot) {
+  ShardedSampleCounts counts(&ranges_);
+  counts.Accumulate(0, 1);
+  counts.Accumulate(3, 2);
+  counts.Accumulate(19, 1);
+  counts.Accumulate(1000, 5);
+
+  std::unique_ptr<SampleVector> samples = counts.Snapshot(kId);
+  EXPECT_EQ(kId, samples->id());
+  EXPECT_EQ(9, samples->TotalCount());
+  EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
+  EXPECT_EQ(0 + 3 * 2 + 19 + 1000 * 5, samples->sum());
+  EXPECT_EQ(1, samples->GetCountAtIndex(0));
+  EXPECT_EQ(2, samples->GetCountAtIndex(1));
+  EXPECT_EQ(1, samples->GetCountAtIndex(9));
+  EXPECT_EQ(5, samples->GetCountAtIndex(10));
+
+  // Snapshots don't remove anything.
+  samples = counts.Extract(kId);
+  EXPECT_EQ(9, samples->TotalCount());
+  EXPECT_EQ(0 + 3 * 2 + 19 + 1000 * 5, samples->sum());
+
+  samples = counts.Extract(kId);
+  EXPECT_EQ(0, samples->TotalCount());
+  EXPECT_EQ(0, samples->sum());
+
+  counts.Accumulate(4, 1);
+  samples = counts.Extract(kId);
+  EXPECT_EQ(1, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCountAtIndex(2));
+}
+
+TEST_F(ShardedSampleCountsTest, ConcurrentAccumulate) {
+  const size_t kNumThreads = ShardedSampleCounts::kNumShards + 3;
+  const int kSamplesPerThread = 20000;
+  ShardedSampleCounts counts(&ranges_);
+
+  std::vector<std::unique_ptr<AccumulateThread>> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.push_back(
+        std::make_unique<AccumulateThread>(&counts, kSamplesPerThread));
+    threads.back()->Start();
+  }
+
+  // Extract while the threads are recording; nothing may be lost.
+  SampleVector total(kId, &ranges_);
+  total.Add(*counts.Extract(kId));
+  for (auto& thread : threads)
+    thread->Join();
+  total.Add(*counts.Extract(kId));
+
+  const int kTotalSamples = static_cast<int>(kNumThreads) * kSamplesPerThread;
+  EXPECT_EQ(kTotalSamples, total.TotalCount());
+  EXPECT_EQ(kTotalSamples, total.redundant_count());
+  // Each thread records the values 0 to 19 in turn.
+  EXPECT_EQ(static_cast<int64_t>(kTotalSamples) / 20 * (19 * 20 / 2),
+            total.sum());
+  for (size_t i = 0; i < 10; ++i)
+    EXPECT_EQ(kTotalSamples / 10, total.GetCountAtIndex(i));
+}
+
+}  // namespace base
@@ -224,8 +224,15 @@ void StatisticsRecorder::PrepareDeltas(
     HistogramBase::Flags required_flags,
     HistogramSnapshotManager* snapshot_manager) {
   Histograms histograms = GetHistograms();
-  if (!include_persistent)
+  if (!include_persistent) {
+    // Persistent histograms are snapshotted by whichever process reads the
+    // persistent memory, so their sharded samples must be moved there.
+    for (HistogramBase* histogram : histograms) {
+      if (histogram->flags() & HistogramBase::kIsPersistent)
+        histogram->MergeShardedSamples();
+    }
     histograms = NonPersistent(std::move(histograms));
+  }
   snapshot_manager->PrepareDeltas(Sort(std::move(histograms)), flags_to_set,
                                   required_flags);
 }
@@ -137,7 +137,9 @@ class BASE_EXPORT StatisticsRecorder {
   // set flags for each histogram. |required_flags| is used to select
   // histograms to be recorded. Only histograms that have all the flags
   // specified by the argument will be chosen. If all histograms should be
-  // recorded, set it to |Histogram::kNoFlags|.
+  // recorded, set it to |Histogram::kNoFlags|. If |include_persistent| is
+  // false, persistent histograms aren't snapshotted but their sharded samples
+  // are merged to persistent memory.
   static void PrepareDeltas(bool include_persistent,
                             HistogramBase::Flags flags_to_set,
                             HistogramBase::Flags required_flags,
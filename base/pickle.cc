@@ -418,7 +418,10 @@ inline void* Pickle::ClaimUninitializedBytesInternal(size_t length) {
   }
 
   char* write = mutable_payload() + write_offset_;
-  memset(write + length, 0, data_len - length);  // Always initialize padding
+  // Always initialize padding. Most writes are of whole uint32_t units and
+  // have none, so skip the call for them.
+  if (data_len != length)
+    memset(write + length, 0, data_len - length);
   header_->payload_size = static_cast<uint32_t>(new_size);
   write_offset_ = new_size;
   return write;
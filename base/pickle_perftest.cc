@@ -0,0 +1,98 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/pickle.h"
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/strings/string16.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr int kIterations = 1000000;
+
+// Writes the kind of fields a small IPC message carries through ParamTraits:
+// a few integers and flags, a URL-sized string and a short title.
+void WriteTypicalParams(Pickle* pickle,
+                        const std::string& url,
+                        const string16& title) {
+  pickle->WriteInt(42);
+  pickle->WriteUInt32(7);
+  pickle->WriteInt64(1234567890123);
+  pickle->WriteBool(true);
+  pickle->WriteDouble(3.5);
+  pickle->WriteString(url);
+  pickle->WriteString16(title);
+  pickle->WriteUInt16(80);
+  pickle->WriteBool(false);
+}
+
+bool ReadTypicalParams(const Pickle& pickle) {
+  PickleIterator iter(pickle);
+  int i;
+  uint32_t u32;
+  int64_t i64;
+  bool b1, b2;
+  double d;
+  std::string url;
+  string16 title;
+  uint16_t u16;
+  return iter.ReadInt(&i) && iter.ReadUInt32(&u32) && iter.ReadInt64(&i64) &&
+         iter.ReadBool(&b1) && iter.ReadDouble(&d) && iter.ReadString(&url) &&
+         iter.ReadString16(&title) && iter.ReadUInt16(&u16) &&
+         iter.ReadBool(&b2);
+}
+
+}  // namespace
+
+class PicklePerfTest : public testing::Test {
+ public:
+  PicklePerfTest()
+      : url_("https://www.example.com/path/to/some/page.html?query=value"),
+        title_(ASCIIToUTF16("Example page title")) {}
+
+  void RunWriteTest(const std::string& test_name, bool reserve) {
+    TimeTicks start = TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i) {
+      Pickle pickle;
+      if (reserve)
+        pickle.Reserve(128);
+      WriteTypicalParams(&pickle, url_, title_);
+    }
+    perf_test::PrintResult("pickle_write", "", test_name,
+                           (TimeTicks::Now() - start).InMillisecondsF(), "ms",
+                           true);
+  }
+
+ protected:
+  const std::string url_;
+  const string16 title_;
+};
+
+TEST_F(PicklePerfTest, WriteTypicalParams) {
+  RunWriteTest("grow", false);
+  RunWriteTest("reserve", true);
+}
+
+TEST_F(PicklePerfTest, ReadTypicalParams) {
+  Pickle pickle;
+  WriteTypicalParams(&pickle, url_, title_);
+
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i)
+    ASSERT_TRUE(ReadTypicalParams(pickle));
+  perf_test::PrintResult("pickle_read", "", "typical_params",
+                         (TimeTicks::Now() - start).InMillisecondsF(), "ms",
+                         true);
+}
+
+}  // namespace base
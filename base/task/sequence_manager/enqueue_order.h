@@ -10,6 +10,7 @@
 #include <atomic>
 
 #include "base/base_export.h"
+#include "base/logging.h"
 #include "base/macros.h"
 
 namespace base {
@@ -30,6 +31,10 @@ class EnqueueOrder {
   // that some non-zero values have a special meaning.
   operator uint64_t() const { return value_; }
 
+  // Returns the EnqueueOrder following this one in a range reserved by
+  // Generator::GenerateNextRange().
+  EnqueueOrder NextInRange() const { return EnqueueOrder(value_ + 1); }
+
   static EnqueueOrder FromIntForTesting(uint64_t value) {
     return EnqueueOrder(value);
   }
@@ -47,6 +52,15 @@ class EnqueueOrder {
           &counter_, uint64_t(1), std::memory_order_relaxed));
     }
 
+    // Reserves |count| consecutive EnqueueOrders with a single atomic
+    // operation and returns the first one. The following ones are obtained
+    // with EnqueueOrder::NextInRange(). Can be called from any thread.
+    EnqueueOrder GenerateNextRange(uint64_t count) {
+      DCHECK_GT(count, 0u);
+      return EnqueueOrder(std::atomic_fetch_add_explicit(
+          &counter_, count, std::memory_order_relaxed));
+    }
+
    private:
     std::atomic<uint64_t> counter_;
     DISALLOW_COPY_AND_ASSIGN(Generator);
@@ -622,6 +622,11 @@ internal::EnqueueOrder SequenceManagerImpl::GetNextSequenceNumber() {
   return enqueue_order_generator_.GenerateNext();
 }
 
+internal::EnqueueOrder SequenceManagerImpl::GetNextSequenceNumbers(
+    size_t count) {
+  return enqueue_order_generator_.GenerateNextRange(count);
+}
+
 std::unique_ptr<trace_event::ConvertableToTraceFormat>
 SequenceManagerImpl::AsValueWithSelectorResult(
     bool should_run,
@@ -278,6 +278,9 @@ class BASE_EXPORT SequenceManagerImpl
 
   internal::EnqueueOrder GetNextSequenceNumber();
 
+  // Reserves |count| consecutive sequence numbers and returns the first one.
+  internal::EnqueueOrder GetNextSequenceNumbers(size_t count);
+
   std::unique_ptr<trace_event::ConvertableToTraceFormat>
   AsValueWithSelectorResult(bool should_run,
                             internal::WorkQueue* selected_work_queue) const;
@@ -312,6 +312,51 @@ TEST_P(SequenceManagerTest, MultiQueuePosting) {
   EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u, 4u, 5u, 6u));
 }
 
+TEST_P(SequenceManagerTest, PostTasks) {
+  CreateTaskQueues(1u);
+
+  std::vector<EnqueueOrder> run_order;
+  std::vector<TaskQueue::PostedTask> tasks;
+  for (uint64_t i = 1; i <= 3; ++i)
+    tasks.emplace_back(BindOnce(&TestTask, i, &run_order), FROM_HERE);
+  EXPECT_TRUE(runners_[0]->PostTasks(std::move(tasks)));
+
+  // All tasks are run from a single DoWork.
+  EXPECT_EQ(1u, test_task_runner_->GetPendingTaskCount());
+  RunLoop().RunUntilIdle();
+  EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u));
+}
+
+TEST_P(SequenceManagerTest, PostTasks_MixedImmediateAndDelayed) {
+  CreateTaskQueues(1u);
+
+  std::vector<EnqueueOrder> run_order;
+  std::vector<TaskQueue::PostedTask> tasks;
+  tasks.emplace_back(BindOnce(&TestTask, 1, &run_order), FROM_HERE,
+                     TimeDelta::FromMilliseconds(10));
+  tasks.emplace_back(BindOnce(&TestTask, 2, &run_order), FROM_HERE);
+  tasks.emplace_back(BindOnce(&TestTask, 3, &run_order), FROM_HERE);
+  EXPECT_TRUE(runners_[0]->PostTasks(std::move(tasks)));
+
+  RunLoop().RunUntilIdle();
+  EXPECT_THAT(run_order, ElementsAre(2u, 3u));
+  test_task_runner_->FastForwardUntilNoTasksRemain();
+  EXPECT_THAT(run_order, ElementsAre(2u, 3u, 1u));
+}
+
+TEST_P(SequenceManagerTest, PostTasks_AfterShutdown) {
+  CreateTaskQueues(1u);
+  runners_[0]->ShutdownTaskQueue();
+
+  std::vector<EnqueueOrder> run_order;
+  std::vector<TaskQueue::PostedTask> tasks;
+  tasks.emplace_back(BindOnce(&TestTask, 1, &run_order), FROM_HERE);
+  EXPECT_FALSE(runners_[0]->PostTasks(std::move(tasks)));
+
+  RunLoop().RunUntilIdle();
+  EXPECT_TRUE(run_order.empty());
+}
+
 TEST_P(SequenceManagerTestWithMessageLoop, NonNestableTaskPosting) {
   CreateTaskQueues(1u);
 
@@ -78,6 +78,9 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
     immediate_task_closure_ = BindRepeating(
         &SequenceManagerPerfTest::TestImmediateTask, Unretained(this));
 
+    immediate_task_batch_closure_ = BindRepeating(
+        &SequenceManagerPerfTest::TestImmediateTaskBatch, Unretained(this));
+
     switch (GetParam()) {
       case PerfTestType::kUseMessageLoop:
         CreateSequenceManagerWithMessageLoop();
@@ -112,6 +115,7 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
 
   void TearDown() override {
     queues_.clear();
+    task_queues_.clear();
     manager_->UnregisterTimeDomain(time_domain_.get());
     manager_.reset();
   }
@@ -119,8 +123,9 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
   void Initialize(size_t num_queues) {
     num_queues_ = num_queues;
     for (size_t i = 0; i < num_queues; i++) {
-      queues_.push_back(manager_->CreateTaskQueue<TestTaskQueue>(
+      task_queues_.push_back(manager_->CreateTaskQueue<TestTaskQueue>(
           TaskQueue::Spec("test").SetTimeDomain(time_domain_.get())));
+      queues_.push_back(task_queues_.back());
     }
   }
 
@@ -188,6 +193,39 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
     }
   }
 
+  // Same as TestImmediateTask() but each queue receives its tasks through a
+  // single TaskQueue::PostTasks() call.
+  void TestImmediateTaskBatch() {
+    if (--num_tasks_to_run_ == 0) {
+      run_loop_->QuitWhenIdle();
+      return;
+    }
+
+    num_tasks_in_flight_--;
+    unsigned int lower_num_tasks_to_post =
+        num_tasks_in_flight_ < (max_tasks_in_flight_ / 2) ? 1 : 0;
+    unsigned int max_tasks_to_post =
+        num_tasks_to_post_ % 2 ? lower_num_tasks_to_post : 10;
+    std::vector<std::vector<TaskQueue::PostedTask>> batches(num_queues_);
+    for (unsigned int i = 0;
+         i < max_tasks_to_post && num_tasks_in_flight_ < max_tasks_in_flight_ &&
+         num_tasks_to_post_ > 0;
+         i++) {
+      // Choose a queue weighted towards queue 0.
+      unsigned int queue = num_tasks_to_post_ % (num_queues_ + 1);
+      if (queue == num_queues_) {
+        queue = 0;
+      }
+      batches[queue].emplace_back(immediate_task_batch_closure_, FROM_HERE);
+      num_tasks_in_flight_++;
+      num_tasks_to_post_--;
+    }
+    for (size_t queue = 0; queue < num_queues_; queue++) {
+      if (!batches[queue].empty())
+        task_queues_[queue]->PostTasks(std::move(batches[queue]));
+    }
+  }
+
   void ResetAndCallTestDelayedTask(unsigned int num_tasks_to_run) {
     num_tasks_in_flight_ = 1;
     num_tasks_to_post_ = num_tasks_to_run;
@@ -202,6 +240,13 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
     TestImmediateTask();
   }
 
+  void ResetAndCallTestImmediateTaskBatch(unsigned int num_tasks_to_run) {
+    num_tasks_in_flight_ = 1;
+    num_tasks_to_post_ = num_tasks_to_run;
+    num_tasks_to_run_ = num_tasks_to_run;
+    TestImmediateTaskBatch();
+  }
+
   void Benchmark(const std::string& trace, const RepeatingClosure& test_task) {
     ThreadTicks start = ThreadTicks::Now();
     ThreadTicks now;
@@ -240,8 +285,10 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
   std::unique_ptr<RunLoop> run_loop_;
   std::unique_ptr<TimeDomain> time_domain_;
   std::vector<scoped_refptr<SingleThreadTaskRunner>> queues_;
+  std::vector<scoped_refptr<TestTaskQueue>> task_queues_;
   RepeatingClosure delayed_task_closure_;
   RepeatingClosure immediate_task_closure_;
+  RepeatingClosure immediate_task_batch_closure_;
   // TODO(alexclarke): parameterize so we can measure with and without a
   // TaskTimeObserver.
   TestTaskTimeObserver test_task_time_observer_;
@@ -347,5 +394,32 @@ TEST_P(SequenceManagerPerfTest, RunTenThousandImmediateTasks_ThirtyTwoQueues) {
 // TODO(alexclarke): Add additional tests with different mixes of non-delayed vs
 // delayed tasks.
 
+TEST_P(SequenceManagerPerfTest, RunTenThousandImmediateTaskBatches_OneQueue) {
+  if (!ThreadTicks::IsSupported())
+    return;
+  Initialize(1u);
+
+  max_tasks_in_flight_ = 200;
+  Benchmark(
+      "run 10000 batched immediate tasks with one queue",
+      BindRepeating(
+          &SequenceManagerPerfTest::ResetAndCallTestImmediateTaskBatch,
+          Unretained(this), 10000));
+}
+
+TEST_P(SequenceManagerPerfTest,
+       RunTenThousandImmediateTaskBatches_ThirtyTwoQueues) {
+  if (!ThreadTicks::IsSupported())
+    return;
+  Initialize(32u);
+
+  max_tasks_in_flight_ = 200;
+  Benchmark(
+      "run 10000 batched immediate tasks with thirty two queues",
+      BindRepeating(
+          &SequenceManagerPerfTest::ResetAndCallTestImmediateTaskBatch,
+          Unretained(this), 10000));
+}
+
 }  // namespace sequence_manager
 }  // namespace base
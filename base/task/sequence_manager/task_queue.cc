@@ -137,6 +137,19 @@ bool TaskQueue::PostTaskWithMetadata(PostedTask task) {
   return false;
 }
 
+bool TaskQueue::PostTasks(std::vector<PostedTask> tasks) {
+  Optional<MoveableAutoLock> lock = AcquireImplReadLockIfNeeded();
+  if (!impl_)
+    return false;
+  if (impl_->PostTasks(&tasks))
+    return true;
+  // If posting tasks was unsuccessful then |tasks| contains the original tasks
+  // which should be destructed outside of the lock.
+  lock = nullopt;
+  // Tasks get implicitly destructed here.
+  return false;
+}
+
 std::unique_ptr<TaskQueue::QueueEnabledVoter>
 TaskQueue::CreateQueueEnabledVoter() {
   DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
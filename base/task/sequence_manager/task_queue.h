@@ -6,6 +6,7 @@
 #define BASE_TASK_SEQUENCE_MANAGER_TASK_QUEUE_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
@@ -330,6 +331,13 @@ class BASE_EXPORT TaskQueue : public SingleThreadTaskRunner {
 
   bool PostTaskWithMetadata(PostedTask task);
 
+  // Posts all of |tasks|. Immediate tasks are enqueued under a single
+  // acquisition of the queue's cross-thread lock, get consecutive sequence
+  // numbers and cause at most one DoWork to be scheduled. Delayed tasks are
+  // posted as if by PostTaskWithMetadata(). Returns false if the queue was
+  // shut down, in which case none of the immediate tasks were posted.
+  bool PostTasks(std::vector<PostedTask> tasks);
+
  protected:
   TaskQueue(std::unique_ptr<internal::TaskQueueImpl> impl,
             const TaskQueue::Spec& spec);
@@ -211,6 +211,52 @@ TaskQueueImpl::PostTaskResult TaskQueueImpl::PostImmediateTaskImpl(
   return PostTaskResult::Success();
 }
 
+bool TaskQueueImpl::PostTasks(std::vector<TaskQueue::PostedTask>* tasks) {
+  std::vector<TaskQueue::PostedTask> delayed_tasks;
+  size_t num_immediate_tasks = 0;
+  for (const TaskQueue::PostedTask& task : *tasks) {
+    // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
+    // for details.
+    CHECK(task.callback);
+    if (task.delay.is_zero())
+      ++num_immediate_tasks;
+  }
+
+  if (num_immediate_tasks) {
+    std::vector<Task> immediate_tasks;
+    immediate_tasks.reserve(num_immediate_tasks);
+
+    AutoLock lock(any_thread_lock_);
+    if (!any_thread().sequence_manager)
+      return false;
+
+    EnqueueOrder sequence_number =
+        any_thread().sequence_manager->GetNextSequenceNumbers(
+            num_immediate_tasks);
+    TimeTicks time_domain_now = any_thread().time_domain->Now();
+    for (TaskQueue::PostedTask& task : *tasks) {
+      if (!task.delay.is_zero()) {
+        delayed_tasks.push_back(std::move(task));
+        continue;
+      }
+      immediate_tasks.emplace_back(std::move(task), time_domain_now,
+                                   sequence_number, sequence_number);
+      sequence_number = sequence_number.NextInRange();
+    }
+    PushOntoImmediateIncomingQueueLocked(std::move(immediate_tasks));
+  } else {
+    delayed_tasks = std::move(*tasks);
+  }
+  tasks->clear();
+
+  for (TaskQueue::PostedTask& task : delayed_tasks) {
+    PostTaskResult result = PostDelayedTaskImpl(std::move(task));
+    if (!result.success)
+      tasks->push_back(std::move(result.task));
+  }
+  return tasks->empty();
+}
+
 TaskQueueImpl::PostTaskResult TaskQueueImpl::PostDelayedTaskImpl(
     TaskQueue::PostedTask task) {
   // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
@@ -314,20 +360,52 @@ void TaskQueueImpl::PushOntoImmediateIncomingQueueLocked(Task task) {
   }
 
   if (was_immediate_incoming_queue_empty) {
-    // However there's no point posting a DoWork for a blocked queue. NB we can
-    // only tell if it's disabled from the main thread.
-    bool queue_is_blocked =
-        RunsTasksInCurrentSequence() &&
-        (!IsQueueEnabled() || main_thread_only().current_fence);
-    any_thread().sequence_manager->OnQueueHasIncomingImmediateWork(
-        this, sequence_number, queue_is_blocked);
-    if (!any_thread().on_next_wake_up_changed_callback.is_null())
-      any_thread().on_next_wake_up_changed_callback.Run(desired_run_time);
+    OnImmediateIncomingQueueBecameNonEmptyLocked(sequence_number,
+                                                 desired_run_time);
   }
 
   TraceQueueSize();
 }
 
+void TaskQueueImpl::PushOntoImmediateIncomingQueueLocked(
+    std::vector<Task> tasks) {
+  DCHECK(!tasks.empty());
+  bool was_immediate_incoming_queue_empty;
+
+  EnqueueOrder sequence_number = tasks.front().enqueue_order();
+  TimeTicks desired_run_time = tasks.front().delayed_run_time;
+
+  {
+    AutoLock lock(immediate_incoming_queue_lock_);
+    was_immediate_incoming_queue_empty = immediate_incoming_queue().empty();
+    for (Task& task : tasks) {
+      any_thread().sequence_manager->WillQueueTask(&task);
+      immediate_incoming_queue().push_back(std::move(task));
+    }
+  }
+
+  if (was_immediate_incoming_queue_empty) {
+    OnImmediateIncomingQueueBecameNonEmptyLocked(sequence_number,
+                                                 desired_run_time);
+  }
+
+  TraceQueueSize();
+}
+
+void TaskQueueImpl::OnImmediateIncomingQueueBecameNonEmptyLocked(
+    EnqueueOrder sequence_number,
+    TimeTicks desired_run_time) {
+  // However there's no point posting a DoWork for a blocked queue. NB we can
+  // only tell if it's disabled from the main thread.
+  bool queue_is_blocked =
+      RunsTasksInCurrentSequence() &&
+      (!IsQueueEnabled() || main_thread_only().current_fence);
+  any_thread().sequence_manager->OnQueueHasIncomingImmediateWork(
+      this, sequence_number, queue_is_blocked);
+  if (!any_thread().on_next_wake_up_changed_callback.is_null())
+    any_thread().on_next_wake_up_changed_callback.Run(desired_run_time);
+}
+
 void TaskQueueImpl::ReloadImmediateWorkQueueIfEmpty() {
   if (!main_thread_only().immediate_work_queue->Empty())
     return;
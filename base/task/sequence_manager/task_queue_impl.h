@@ -10,6 +10,7 @@
 #include <memory>
 #include <queue>
 #include <set>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/containers/circular_deque.h"
@@ -185,6 +186,10 @@ class BASE_EXPORT TaskQueueImpl {
   const char* GetName() const;
   bool RunsTasksInCurrentSequence() const;
   PostTaskResult PostDelayedTask(TaskQueue::PostedTask task);
+  // Posts |*tasks| in bulk (see TaskQueue::PostTasks()). On failure, the tasks
+  // which weren't posted are left in |*tasks| so that they can be destroyed
+  // outside of the lock.
+  bool PostTasks(std::vector<TaskQueue::PostedTask>* tasks);
   // Require a reference to enclosing task queue for lifetime control.
   std::unique_ptr<TaskQueue::QueueEnabledVoter> CreateQueueEnabledVoter(
       scoped_refptr<TaskQueue> owning_task_queue);
@@ -393,6 +398,18 @@ class BASE_EXPORT TaskQueueImpl {
   // empty.
   void PushOntoImmediateIncomingQueueLocked(Task task);
 
+  // Same as PushOntoImmediateIncomingQueueLocked() for a batch of tasks. Takes
+  // |immediate_incoming_queue_lock_| once and notifies the SequenceManager at
+  // most once.
+  void PushOntoImmediateIncomingQueueLocked(std::vector<Task> tasks);
+
+  // Called after pushing tasks onto an empty |immediate_incoming_queue|.
+  // Schedules a DoWork unless the queue is blocked, and notifies the wake up
+  // observer.
+  void OnImmediateIncomingQueueBecameNonEmptyLocked(
+      EnqueueOrder sequence_number,
+      TimeTicks desired_run_time);
+
   using TaskDeque = circular_deque<Task>;
 
   // Extracts all the tasks from the immediate incoming queue and swaps it with
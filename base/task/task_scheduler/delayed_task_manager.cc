@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/logging.h"
 #include "base/task/task_scheduler/task.h"
 #include "base/task_runner.h"
@@ -14,9 +15,20 @@
 namespace base {
 namespace internal {
 
+namespace {
+
+// The deadline of a TaskPriority::BEST_EFFORT task can slip by up to
+// 1/kBestEffortSlackDivisor of its delay, up to kMaxBestEffortSlack.
+constexpr int kBestEffortSlackDivisor = 10;
+constexpr TimeDelta kMaxBestEffortSlack = TimeDelta::FromSeconds(1);
+
+}  // namespace
+
 DelayedTaskManager::DelayedTaskManager(
     std::unique_ptr<const TickClock> tick_clock)
-    : tick_clock_(std::move(tick_clock)) {
+    : tick_clock_(std::move(tick_clock)),
+      timing_wheel_lock_(&lock_),
+      timing_wheel_(tick_clock_->NowTicks()) {
   DCHECK(tick_clock_);
 }
 
@@ -84,11 +96,81 @@ void DelayedTaskManager::AddDelayedTaskNow(
     PostTaskNowCallback post_task_now_callback) {
   DCHECK(task.task);
   DCHECK(started_.IsSet());
-  // TODO(fdoray): Use |task->delayed_run_time| on the service thread
-  // MessageLoop rather than recomputing it from |delay|.
+
+  const TimeTicks now = tick_clock_->NowTicks();
+  const TimeTicks run_time =
+      GetCoalescedRunTime(now + delay, delay, task.traits.priority());
+
+  {
+    AutoSchedulerLock auto_lock(timing_wheel_lock_);
+    timing_wheel_.Insert(DelayedTaskTimingWheel::Entry(
+        run_time,
+        BindOnce(std::move(post_task_now_callback), std::move(task))));
+    // A wake up already pending at or before |run_time| will forward the task.
+    if (run_time >= next_wake_up_time_)
+      return;
+    next_wake_up_time_ = run_time;
+  }
+  ScheduleWakeUp(run_time, now);
+}
+
+// static
+TimeTicks DelayedTaskManager::GetCoalescedRunTime(TimeTicks delayed_run_time,
+                                                  TimeDelta delay,
+                                                  TaskPriority priority) {
+  if (priority != TaskPriority::BEST_EFFORT)
+    return delayed_run_time;
+
+  const TimeDelta slack =
+      std::min(delay / kBestEffortSlackDivisor, kMaxBestEffortSlack);
+  if (slack < DelayedTaskTimingWheel::kTickDuration)
+    return delayed_run_time;
+
+  // Align on the largest power of two number of ticks that fits in |slack|, so
+  // that tasks with a similar slack get the same run time.
+  TimeDelta granularity = DelayedTaskTimingWheel::kTickDuration;
+  while (granularity * 2 <= slack)
+    granularity *= 2;
+  const TimeDelta remainder = (delayed_run_time - TimeTicks()) % granularity;
+  if (remainder.is_zero())
+    return delayed_run_time;
+  return delayed_run_time + (granularity - remainder);
+}
+
+void DelayedTaskManager::ProcessRipeTasks() {
+  std::vector<DelayedTaskTimingWheel::Entry> ripe_entries;
+  const TimeTicks now = tick_clock_->NowTicks();
+  TimeTicks next_wake_up_time;
+  {
+    AutoSchedulerLock auto_lock(timing_wheel_lock_);
+    timing_wheel_.TakeRipeEntries(now, &ripe_entries);
+    next_wake_up_time = timing_wheel_.GetNextWakeUpTime();
+    // Another call to ProcessRipeTasks() may already be pending for an earlier
+    // time, e.g. if this call was scheduled before an earlier task was added.
+    if (next_wake_up_time_ > now && next_wake_up_time_ <= next_wake_up_time) {
+      next_wake_up_time = TimeTicks::Max();
+    } else {
+      next_wake_up_time_ = next_wake_up_time;
+    }
+  }
+
+  if (!next_wake_up_time.is_max())
+    ScheduleWakeUp(next_wake_up_time, now);
+
+  // Forward tasks outside of |timing_wheel_lock_| since post task callbacks
+  // acquire other scheduler locks.
+  for (auto& entry : ripe_entries)
+    std::move(entry.closure).Run();
+}
+
+void DelayedTaskManager::ScheduleWakeUp(TimeTicks wake_up_time,
+                                        TimeTicks now) {
+  // Unretained() is safe because the service thread is stopped before |this|
+  // is destroyed (cf. class comment).
   service_thread_task_runner_->PostDelayedTask(
-      FROM_HERE, BindOnce(std::move(post_task_now_callback), std::move(task)),
-      delay);
+      FROM_HERE,
+      BindOnce(&DelayedTaskManager::ProcessRipeTasks, Unretained(this)),
+      std::max(TimeDelta(), wake_up_time - now));
 }
 
 }  // namespace internal
@@ -15,7 +15,9 @@
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/atomic_flag.h"
+#include "base/task/task_scheduler/delayed_task_timing_wheel.h"
 #include "base/task/task_scheduler/scheduler_lock.h"
+#include "base/task/task_traits.h"
 #include "base/time/default_tick_clock.h"
 #include "base/time/tick_clock.h"
 
@@ -30,6 +32,15 @@ struct Task;
 // The DelayedTaskManager forwards tasks to post task callbacks when they become
 // ripe for execution. Tasks are not forwarded before Start() is called. This
 // class is thread-safe.
+//
+// Delayed tasks are kept in a hierarchical timing wheel and a single wake up is
+// scheduled on the service thread for the earliest of them. The deadline of
+// TaskPriority::BEST_EFFORT tasks is allowed to slip by a fraction of their
+// delay so that timers with similar deadlines are forwarded in batches.
+//
+// Wake ups posted to the service thread refer to the DelayedTaskManager with
+// Unretained(), so the service thread must be stopped before the
+// DelayedTaskManager is destroyed.
 class BASE_EXPORT DelayedTaskManager {
  public:
   // Posts |task| for execution immediately.
@@ -50,6 +61,14 @@ class BASE_EXPORT DelayedTaskManager {
   // |task| is ripe for execution and Start() has been called.
   void AddDelayedTask(Task task, PostTaskNowCallback post_task_now_callback);
 
+  // Returns the time at which a task with |priority| whose delay of |delay|
+  // expires at |delayed_run_time| is forwarded. This is |delayed_run_time|
+  // rounded up to a coalescing boundary for TaskPriority::BEST_EFFORT tasks,
+  // and |delayed_run_time| for other priorities.
+  static TimeTicks GetCoalescedRunTime(TimeTicks delayed_run_time,
+                                       TimeDelta delay,
+                                       TaskPriority priority);
+
  private:
   // Schedules a call to |post_task_now_callback| with |task| as argument when
   // |delay| expires. Start() must have been called before this.
@@ -57,6 +76,14 @@ class BASE_EXPORT DelayedTaskManager {
                          TimeDelta delay,
                          PostTaskNowCallback post_task_now_callback);
 
+  // Forwards ripe tasks from |timing_wheel_| and schedules the next wake up.
+  // Runs on the service thread.
+  void ProcessRipeTasks();
+
+  // Posts a call to ProcessRipeTasks() on the service thread at
+  // |wake_up_time|.
+  void ScheduleWakeUp(TimeTicks wake_up_time, TimeTicks now);
+
   const std::unique_ptr<const TickClock> tick_clock_;
 
   AtomicFlag started_;
@@ -71,6 +98,18 @@ class BASE_EXPORT DelayedTaskManager {
   scoped_refptr<TaskRunner> service_thread_task_runner_;
   std::vector<std::pair<Task, PostTaskNowCallback>> tasks_added_before_start_;
 
+  // Synchronizes access to |timing_wheel_| and |next_wake_up_time_|. Can be
+  // acquired while holding |lock_|, from AddDelayedTask() before |started_| is
+  // observed as set.
+  SchedulerLock timing_wheel_lock_;
+
+  // Delayed tasks added after Start(), bound to their post task callback.
+  DelayedTaskTimingWheel timing_wheel_;
+
+  // Time of the earliest pending call to ProcessRipeTasks(), or
+  // TimeTicks::Max() if none is pending.
+  TimeTicks next_wake_up_time_ = TimeTicks::Max();
+
   DISALLOW_COPY_AND_ASSIGN(DelayedTaskManager);
 };
 
@@ -180,6 +180,52 @@ TEST_F(TaskSchedulerDelayedTaskManagerTest, DelayedTasksRunAfterDelay) {
   testing::Mock::VerifyAndClear(&mock_task_b);
 }
 
+// Verify that a BEST_EFFORT delayed task isn't forwarded before its delay
+// expires and is forwarded within the coalescing slack after that.
+TEST_F(TaskSchedulerDelayedTaskManagerTest,
+       BestEffortDelayedTaskRunsAfterDelay) {
+  delayed_task_manager_.Start(service_thread_task_runner_);
+
+  testing::StrictMock<MockTask> mock_task;
+  Task task(FROM_HERE, BindOnce(&MockTask::Run, Unretained(&mock_task)),
+            {TaskPriority::BEST_EFFORT}, TimeDelta::FromSeconds(10));
+  delayed_task_manager_.AddDelayedTask(std::move(task), BindOnce(&RunTask));
+
+  service_thread_task_runner_->FastForwardBy(TimeDelta::FromSeconds(10) -
+                                             TimeDelta::FromMicroseconds(1));
+  testing::Mock::VerifyAndClear(&mock_task);
+
+  EXPECT_CALL(mock_task, Run());
+  service_thread_task_runner_->FastForwardBy(TimeDelta::FromSeconds(1));
+}
+
+// Verify that only BEST_EFFORT run times are coalesced, that the coalesced run
+// time is within the slack of the requested run time and that close run times
+// are coalesced together.
+TEST(TaskSchedulerDelayedTaskManagerCoalescingTest, GetCoalescedRunTime) {
+  const TimeDelta kDelay = TimeDelta::FromSeconds(10);
+  const TimeTicks run_time = TimeTicks() + TimeDelta::FromSeconds(100) +
+                             TimeDelta::FromMilliseconds(3);
+
+  EXPECT_EQ(run_time, DelayedTaskManager::GetCoalescedRunTime(
+                          run_time, kDelay, TaskPriority::USER_BLOCKING));
+  EXPECT_EQ(run_time, DelayedTaskManager::GetCoalescedRunTime(
+                          run_time, kDelay, TaskPriority::USER_VISIBLE));
+  // The slack of a short delay is smaller than a tick.
+  EXPECT_EQ(run_time, DelayedTaskManager::GetCoalescedRunTime(
+                          run_time, TimeDelta::FromMilliseconds(5),
+                          TaskPriority::BEST_EFFORT));
+
+  const TimeTicks coalesced_run_time = DelayedTaskManager::GetCoalescedRunTime(
+      run_time, kDelay, TaskPriority::BEST_EFFORT);
+  EXPECT_GE(coalesced_run_time, run_time);
+  EXPECT_LE(coalesced_run_time, run_time + TimeDelta::FromSeconds(1));
+  EXPECT_EQ(coalesced_run_time,
+            DelayedTaskManager::GetCoalescedRunTime(
+                run_time + TimeDelta::FromMilliseconds(1), kDelay,
+                TaskPriority::BEST_EFFORT));
+}
+
 TEST_F(TaskSchedulerDelayedTaskManagerTest, PostTaskDuringStart) {
   Thread other_thread("Test");
   other_thread.StartAndWaitForTesting();
@@ -0,0 +1,155 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/task_scheduler/delayed_task_timing_wheel.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "base/logging.h"
+
+namespace base {
+namespace internal {
+
+constexpr TimeDelta DelayedTaskTimingWheel::kTickDuration;
+constexpr int DelayedTaskTimingWheel::kSlotsPerLevelBits;
+constexpr size_t DelayedTaskTimingWheel::kSlotsPerLevel;
+constexpr size_t DelayedTaskTimingWheel::kNumLevels;
+
+namespace {
+
+constexpr uint64_t kSlotMask = DelayedTaskTimingWheel::kSlotsPerLevel - 1;
+
+// Returns the number of bits to shift a tick by to get its slot index at
+// |level| (before masking).
+constexpr int LevelShift(size_t level) {
+  return static_cast<int>(level) * DelayedTaskTimingWheel::kSlotsPerLevelBits;
+}
+
+}  // namespace
+
+DelayedTaskTimingWheel::Entry::Entry(TimeTicks deadline, OnceClosure closure)
+    : deadline(deadline), closure(std::move(closure)) {}
+
+DelayedTaskTimingWheel::Entry::Entry(Entry&& other) = default;
+
+DelayedTaskTimingWheel::Entry& DelayedTaskTimingWheel::Entry::operator=(
+    Entry&& other) = default;
+
+DelayedTaskTimingWheel::Entry::~Entry() = default;
+
+DelayedTaskTimingWheel::DelayedTaskTimingWheel(TimeTicks now) : origin_(now) {}
+
+DelayedTaskTimingWheel::~DelayedTaskTimingWheel() = default;
+
+void DelayedTaskTimingWheel::Insert(Entry entry) {
+  const uint64_t tick = TimeToTick(entry.deadline);
+  InsertAtTick(std::move(entry), tick);
+}
+
+void DelayedTaskTimingWheel::TakeRipeEntries(TimeTicks now,
+                                             std::vector<Entry>* ripe_entries) {
+  DCHECK(ripe_entries);
+  const uint64_t target_tick = TimeToTick(now);
+  DCHECK_GE(target_tick, current_tick_);
+
+  // Collect the entries of all slots that the wheel goes over. Entries that
+  // aren't ripe yet are re-inserted below, which cascades them to lower levels.
+  std::vector<Entry> candidates;
+  for (size_t level = 0; level < kNumLevels; ++level) {
+    const uint64_t first_slot = current_tick_ >> LevelShift(level);
+    const uint64_t last_slot = target_tick >> LevelShift(level);
+    const uint64_t num_slots =
+        std::min<uint64_t>(last_slot - first_slot + 1, kSlotsPerLevel);
+    for (uint64_t i = 0; i < num_slots; ++i) {
+      Slot& slot = slots_[level][(first_slot + i) & kSlotMask];
+      std::move(slot.begin(), slot.end(), std::back_inserter(candidates));
+      slot.clear();
+    }
+  }
+  // Overflow entries can only fit in the wheel once the highest level advances.
+  if ((current_tick_ >> LevelShift(kNumLevels)) !=
+      (target_tick >> LevelShift(kNumLevels))) {
+    std::move(overflow_.begin(), overflow_.end(),
+              std::back_inserter(candidates));
+    overflow_.clear();
+  }
+
+  DCHECK_GE(size_, candidates.size());
+  size_ -= candidates.size();
+  current_tick_ = target_tick;
+
+  const size_t first_ripe_index = ripe_entries->size();
+  for (Entry& entry : candidates) {
+    if (entry.deadline <= now) {
+      ripe_entries->push_back(std::move(entry));
+    } else {
+      const uint64_t tick = TimeToTick(entry.deadline);
+      InsertAtTick(std::move(entry), tick);
+    }
+  }
+  std::stable_sort(ripe_entries->begin() + first_ripe_index,
+                   ripe_entries->end(), [](const Entry& a, const Entry& b) {
+                     return a.deadline < b.deadline;
+                   });
+}
+
+TimeTicks DelayedTaskTimingWheel::GetNextWakeUpTime() const {
+  if (empty())
+    return TimeTicks::Max();
+
+  TimeTicks next_wake_up_time = TimeTicks::Max();
+  for (size_t level = 0; level < kNumLevels; ++level) {
+    const uint64_t first_slot = current_tick_ >> LevelShift(level);
+    for (uint64_t i = 0; i < kSlotsPerLevel; ++i) {
+      const Slot& slot = slots_[level][(first_slot + i) & kSlotMask];
+      if (slot.empty())
+        continue;
+      if (level == 0) {
+        // Level 0 slots are one tick wide: look at the exact deadlines so that
+        // entries aren't delivered late by up to a tick.
+        for (const Entry& entry : slot)
+          next_wake_up_time = std::min(next_wake_up_time, entry.deadline);
+      } else {
+        // Wake up at the start of the slot to cascade its entries.
+        next_wake_up_time = std::min(
+            next_wake_up_time, TickToTime((first_slot + i)
+                                          << LevelShift(level)));
+      }
+      break;
+    }
+  }
+  for (const Entry& entry : overflow_)
+    next_wake_up_time = std::min(next_wake_up_time, entry.deadline);
+  return next_wake_up_time;
+}
+
+uint64_t DelayedTaskTimingWheel::TimeToTick(TimeTicks time) const {
+  if (time <= origin_)
+    return 0;
+  return static_cast<uint64_t>((time - origin_) / kTickDuration);
+}
+
+TimeTicks DelayedTaskTimingWheel::TickToTime(uint64_t tick) const {
+  return origin_ + kTickDuration * static_cast<int64_t>(tick);
+}
+
+void DelayedTaskTimingWheel::InsertAtTick(Entry entry, uint64_t tick) {
+  tick = std::max(tick, current_tick_);
+  ++size_;
+  // An entry goes in the lowest level at which its tick and |current_tick_|
+  // belong to the same slot of the level above.
+  for (size_t level = 0; level < kNumLevels; ++level) {
+    if (((tick ^ current_tick_) >> LevelShift(level + 1)) == 0) {
+      slots_[level][(tick >> LevelShift(level)) & kSlotMask].push_back(
+          std::move(entry));
+      return;
+    }
+  }
+  overflow_.push_back(std::move(entry));
+}
+
+}  // namespace internal
+}  // namespace base
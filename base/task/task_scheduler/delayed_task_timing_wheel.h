@@ -0,0 +1,104 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_TASK_SCHEDULER_DELAYED_TASK_TIMING_WHEEL_H_
+#define BASE_TASK_TASK_SCHEDULER_DELAYED_TASK_TIMING_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace base {
+namespace internal {
+
+// A hierarchical timing wheel of closures to run at a given deadline. Insertion
+// is O(1) and each closure is moved between levels at most kNumLevels times
+// before it becomes ripe, regardless of the number of pending closures.
+//
+// Level 0 has kSlotsPerLevel slots of kTickDuration each. Each slot of level N
+// covers kSlotsPerLevel slots of level N - 1. Closures whose deadline is too
+// far in the future to fit in the wheel are kept in an overflow list and
+// re-inserted when the wheel gets close to their deadline.
+//
+// This class is not thread-safe.
+class BASE_EXPORT DelayedTaskTimingWheel {
+ public:
+  struct BASE_EXPORT Entry {
+    Entry(TimeTicks deadline, OnceClosure closure);
+    Entry(Entry&& other);
+    Entry& operator=(Entry&& other);
+    ~Entry();
+
+    TimeTicks deadline;
+    OnceClosure closure;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  static constexpr TimeDelta kTickDuration = TimeDelta::FromMilliseconds(1);
+  static constexpr int kSlotsPerLevelBits = 6;
+  static constexpr size_t kSlotsPerLevel = 1 << kSlotsPerLevelBits;
+  static constexpr size_t kNumLevels = 4;
+
+  // |now| is the time origin of the wheel.
+  explicit DelayedTaskTimingWheel(TimeTicks now);
+  ~DelayedTaskTimingWheel();
+
+  // Inserts |entry| in the wheel. If |entry.deadline| is in the past, it is
+  // returned by the next call to TakeRipeEntries().
+  void Insert(Entry entry);
+
+  // Advances the wheel to |now| and appends all entries whose deadline is
+  // <= |now| to |ripe_entries|, sorted by deadline. |now| must not be smaller
+  // than the |now| of previous calls.
+  void TakeRipeEntries(TimeTicks now, std::vector<Entry>* ripe_entries);
+
+  // Returns a time at or before the earliest deadline in the wheel, at which
+  // TakeRipeEntries() should be called. The returned time is exact when the
+  // earliest entry is within the current level 0 range. Returns
+  // TimeTicks::Max() if the wheel is empty.
+  TimeTicks GetNextWakeUpTime() const;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  using Slot = std::vector<Entry>;
+
+  // Returns the tick containing |time|. Times before |origin_| map to 0.
+  uint64_t TimeToTick(TimeTicks time) const;
+
+  // Returns the time at which |tick| starts.
+  TimeTicks TickToTime(uint64_t tick) const;
+
+  // Inserts |entry|, whose deadline is in |tick|, in the slot determined by
+  // the distance between |tick| and |current_tick_|.
+  void InsertAtTick(Entry entry, uint64_t tick);
+
+  const TimeTicks origin_;
+
+  // Tick of the last call to TakeRipeEntries().
+  uint64_t current_tick_ = 0;
+
+  Slot slots_[kNumLevels][kSlotsPerLevel];
+
+  // Entries beyond the range of the highest level.
+  Slot overflow_;
+
+  size_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(DelayedTaskTimingWheel);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_TASK_TASK_SCHEDULER_DELAYED_TASK_TIMING_WHEEL_H_
@@ -0,0 +1,165 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/task_scheduler/delayed_task_timing_wheel.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr TimeDelta kTick = DelayedTaskTimingWheel::kTickDuration;
+
+class TaskSchedulerDelayedTaskTimingWheelTest : public testing::Test {
+ protected:
+  TaskSchedulerDelayedTaskTimingWheelTest() : wheel_(kOrigin) {}
+
+  // Inserts an entry with a deadline of |delay| after |kOrigin| which
+  // increments |num_run_| when it runs.
+  void InsertAt(TimeDelta delay) {
+    wheel_.Insert(DelayedTaskTimingWheel::Entry(
+        kOrigin + delay, BindOnce([](int* num_run) { ++*num_run; },
+                                  Unretained(&num_run_))));
+  }
+
+  // Takes and runs the entries ripe at |delay| after |kOrigin|. Returns the
+  // number of entries taken.
+  size_t TakeAndRunRipeEntriesAt(TimeDelta delay) {
+    std::vector<DelayedTaskTimingWheel::Entry> ripe_entries;
+    wheel_.TakeRipeEntries(kOrigin + delay, &ripe_entries);
+    for (size_t i = 1; i < ripe_entries.size(); ++i)
+      EXPECT_LE(ripe_entries[i - 1].deadline, ripe_entries[i].deadline);
+    for (auto& entry : ripe_entries)
+      std::move(entry.closure).Run();
+    return ripe_entries.size();
+  }
+
+  const TimeTicks kOrigin = TimeTicks() + TimeDelta::FromSeconds(1000);
+  DelayedTaskTimingWheel wheel_;
+  int num_run_ = 0;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TaskSchedulerDelayedTaskTimingWheelTest);
+};
+
+}  // namespace
+
+TEST_F(TaskSchedulerDelayedTaskTimingWheelTest, Empty) {
+  EXPECT_TRUE(wheel_.empty());
+  EXPECT_EQ(0U, wheel_.size());
+  EXPECT_TRUE(wheel_.GetNextWakeUpTime().is_max());
+  EXPECT_EQ(0U, TakeAndRunRipeEntriesAt(TimeDelta::FromSeconds(1)));
+}
+
+// Verify that an entry in level 0 is returned when its deadline is reached,
+// and not before.
+TEST_F(TaskSchedulerDelayedTaskTimingWheelTest, ShortDelay) {
+  InsertAt(kTick * 10);
+  EXPECT_EQ(1U, wheel_.size());
+  EXPECT_EQ(kOrigin + kTick * 10, wheel_.GetNextWakeUpTime());
+
+  EXPECT_EQ(0U, TakeAndRunRipeEntriesAt(kTick * 10 -
+                                        TimeDelta::FromMicroseconds(1)));
+  EXPECT_EQ(1U, TakeAndRunRipeEntriesAt(kTick * 10));
+  EXPECT_EQ(1, num_run_);
+  EXPECT_TRUE(wheel_.empty());
+}
+
+// Verify that a deadline in the middle of a tick is honored exactly.
+TEST_F(TaskSchedulerDelayedTaskTimingWheelTest, DeadlineWithinTick) {
+  const TimeDelta delay = kTick * 3 + kTick / 2;
+  InsertAt(delay);
+  EXPECT_EQ(kOrigin + delay, wheel_.GetNextWakeUpTime());
+  EXPECT_EQ(0U, TakeAndRunRipeEntriesAt(kTick * 3));
+  EXPECT_EQ(kOrigin + delay, wheel_.GetNextWakeUpTime());
+  EXPECT_EQ(1U, TakeAndRunRipeEntriesAt(delay));
+}
+
+// Verify that entries in higher levels cascade down and are returned exactly
+// when their deadline is reached when following GetNextWakeUpTime().
+TEST_F(TaskSchedulerDelayedTaskTimingWheelTest, Cascade) {
+  const TimeDelta kDelays[] = {
+      kTick * 5, kTick * 100, kTick * 5000, TimeDelta::FromMinutes(10),
+      TimeDelta::FromHours(2),
+  };
+  for (TimeDelta delay : kDelays)
+    InsertAt(delay);
+  EXPECT_EQ(arraysize(kDelays), wheel_.size());
+
+  size_t num_wake_ups = 0;
+  for (TimeDelta delay : kDelays) {
+    // Wake up repeatedly until the next entry is ripe. No entry should be
+    // returned before its deadline.
+    while (true) {
+      const TimeTicks wake_up_time = wheel_.GetNextWakeUpTime();
+      ASSERT_FALSE(wake_up_time.is_max());
+      ASSERT_LE(wake_up_time, kOrigin + delay);
+      ++num_wake_ups;
+      const size_t num_ripe = TakeAndRunRipeEntriesAt(wake_up_time - kOrigin);
+      if (wake_up_time == kOrigin + delay) {
+        EXPECT_EQ(1U, num_ripe);
+        break;
+      }
+      EXPECT_EQ(0U, num_ripe);
+    }
+  }
+  EXPECT_EQ(static_cast<int>(arraysize(kDelays)), num_run_);
+  EXPECT_TRUE(wheel_.empty());
+  // Each entry cascades at most once per level.
+  EXPECT_LE(num_wake_ups,
+            arraysize(kDelays) * DelayedTaskTimingWheel::kNumLevels);
+}
+
+// Verify that a large jump in time returns all ripe entries, sorted by
+// deadline, and keeps the others.
+TEST_F(TaskSchedulerDelayedTaskTimingWheelTest, LargeJump) {
+  InsertAt(TimeDelta::FromMinutes(30));
+  InsertAt(kTick);
+  InsertAt(TimeDelta::FromSeconds(2));
+  InsertAt(TimeDelta::FromMinutes(90));
+
+  EXPECT_EQ(3U, TakeAndRunRipeEntriesAt(TimeDelta::FromHours(1)));
+  EXPECT_EQ(3, num_run_);
+  EXPECT_EQ(1U, wheel_.size());
+  EXPECT_GT(wheel_.GetNextWakeUpTime(), kOrigin + TimeDelta::FromHours(1));
+  EXPECT_LE(wheel_.GetNextWakeUpTime(), kOrigin + TimeDelta::FromMinutes(90));
+
+  EXPECT_EQ(1U, TakeAndRunRipeEntriesAt(TimeDelta::FromMinutes(90)));
+  EXPECT_TRUE(wheel_.empty());
+}
+
+// Verify that entries beyond the range of the wheel are kept in overflow and
+// returned when their deadline is reached.
+TEST_F(TaskSchedulerDelayedTaskTimingWheelTest, Overflow) {
+  const TimeDelta kFarDelay = TimeDelta::FromDays(2);
+  InsertAt(kFarDelay);
+  InsertAt(kTick);
+  EXPECT_EQ(kOrigin + kTick, wheel_.GetNextWakeUpTime());
+  EXPECT_EQ(1U, TakeAndRunRipeEntriesAt(kTick));
+
+  EXPECT_EQ(kOrigin + kFarDelay, wheel_.GetNextWakeUpTime());
+  EXPECT_EQ(0U, TakeAndRunRipeEntriesAt(TimeDelta::FromDays(1)));
+  EXPECT_EQ(1U, wheel_.size());
+  EXPECT_EQ(1U, TakeAndRunRipeEntriesAt(kFarDelay));
+  EXPECT_TRUE(wheel_.empty());
+}
+
+// Verify that an entry whose deadline is in the past is returned by the next
+// call to TakeRipeEntries().
+TEST_F(TaskSchedulerDelayedTaskTimingWheelTest, DeadlineInThePast) {
+  EXPECT_EQ(0U, TakeAndRunRipeEntriesAt(TimeDelta::FromSeconds(10)));
+  InsertAt(TimeDelta::FromSeconds(5));
+  EXPECT_EQ(kOrigin + TimeDelta::FromSeconds(5), wheel_.GetNextWakeUpTime());
+  EXPECT_EQ(1U, TakeAndRunRipeEntriesAt(TimeDelta::FromSeconds(10)));
+}
+
+}  // namespace internal
+}  // namespace base
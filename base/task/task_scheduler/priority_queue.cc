@@ -12,6 +12,8 @@
 namespace base {
 namespace internal {
 
+constexpr size_t PriorityQueue::kNumPriorities;
+
 // A class combining a Sequence and the SequenceSortKey that determines its
 // position in a PriorityQueue. Instances are only mutable via take_sequence()
 // which can only be called once and renders its instance invalid after the
@@ -66,6 +68,12 @@ PriorityQueue::Transaction::~Transaction() = default;
 void PriorityQueue::Transaction::Push(
     scoped_refptr<Sequence> sequence,
     const SequenceSortKey& sequence_sort_key) {
+  const size_t index = static_cast<size_t>(sequence_sort_key.priority());
+  DCHECK_LT(index, kNumPriorities);
+  if (outer_queue_->num_sequences_per_priority_[index]++ == 0) {
+    outer_queue_->non_empty_priorities_.fetch_or(1U << index,
+                                                 std::memory_order_relaxed);
+  }
   outer_queue_->container_.emplace(std::move(sequence), sequence_sort_key);
 }
 
@@ -81,11 +89,17 @@ scoped_refptr<Sequence> PriorityQueue::Transaction::PopSequence() {
   // transactionally being popped from |container_| right after and taking its
   // Sequence does not alter its sort order (a requirement for the Windows STL's
   // consistency debug-checks for std::priority_queue::top()).
+  const size_t index = static_cast<size_t>(
+      outer_queue_->container_.top().sort_key().priority());
   scoped_refptr<Sequence> sequence =
       const_cast<PriorityQueue::SequenceAndSortKey&>(
           outer_queue_->container_.top())
           .take_sequence();
   outer_queue_->container_.pop();
+  if (--outer_queue_->num_sequences_per_priority_[index] == 0) {
+    outer_queue_->non_empty_priorities_.fetch_and(~(1U << index),
+                                                  std::memory_order_relaxed);
+  }
   return sequence;
 }
 
@@ -99,11 +113,19 @@ size_t PriorityQueue::Transaction::Size() const {
 
 PriorityQueue::PriorityQueue() = default;
 
+PriorityQueue::PriorityQueue(const SchedulerLock* predecessor_lock)
+    : container_lock_(predecessor_lock) {}
+
 PriorityQueue::~PriorityQueue() = default;
 
 std::unique_ptr<PriorityQueue::Transaction> PriorityQueue::BeginTransaction() {
   return WrapUnique(new Transaction(this));
 }
 
+bool PriorityQueue::IsEmptyAtOrAbovePriorityRacy(TaskPriority priority) const {
+  return (non_empty_priorities_.load(std::memory_order_relaxed) >>
+          static_cast<uint32_t>(priority)) == 0;
+}
+
 }  // namespace internal
 }  // namespace base
@@ -5,6 +5,9 @@
 #ifndef BASE_TASK_TASK_SCHEDULER_PRIORITY_QUEUE_H_
 #define BASE_TASK_TASK_SCHEDULER_PRIORITY_QUEUE_H_
 
+#include <stdint.h>
+
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -15,11 +18,16 @@
 #include "base/task/task_scheduler/scheduler_lock.h"
 #include "base/task/task_scheduler/sequence.h"
 #include "base/task/task_scheduler/sequence_sort_key.h"
+#include "base/task/task_traits.h"
 
 namespace base {
 namespace internal {
 
 // A PriorityQueue holds Sequences of Tasks. This class is thread-safe.
+//
+// A bitmap of the priorities that have Sequences is maintained atomically, so
+// that callers can check whether there is work at a given priority without
+// beginning a Transaction.
 class BASE_EXPORT PriorityQueue {
  public:
   // A Transaction can perform multiple operations atomically on a
@@ -73,6 +81,10 @@ class BASE_EXPORT PriorityQueue {
 
   PriorityQueue();
 
+  // Constructs a PriorityQueue whose lock can be acquired while
+  // |predecessor_lock| is held.
+  explicit PriorityQueue(const SchedulerLock* predecessor_lock);
+
   ~PriorityQueue();
 
   // Begins a Transaction. This method cannot be called on a thread which has an
@@ -83,6 +95,12 @@ class BASE_EXPORT PriorityQueue {
 
   const SchedulerLock* container_lock() const { return &container_lock_; }
 
+  // Returns true if this PriorityQueue had no Sequence with a priority greater
+  // than or equal to |priority| at the end of its last modification. Can be
+  // called without a Transaction, but the result may be stale by the time it
+  // is used: it must only be used as a hint.
+  bool IsEmptyAtOrAbovePriorityRacy(TaskPriority priority) const;
+
  private:
   // A class combining a Sequence and the SequenceSortKey that determines its
   // position in a PriorityQueue.
@@ -90,11 +108,22 @@ class BASE_EXPORT PriorityQueue {
 
   using ContainerType = std::priority_queue<SequenceAndSortKey>;
 
-  // Synchronizes access to |container_|.
+  static constexpr size_t kNumPriorities =
+      static_cast<size_t>(TaskPriority::HIGHEST) + 1;
+
+  // Synchronizes access to |container_| and |num_sequences_per_priority_|.
   SchedulerLock container_lock_;
 
   ContainerType container_;
 
+  // Number of Sequences in |container_| for each TaskPriority, indexed by
+  // priority.
+  size_t num_sequences_per_priority_[kNumPriorities] = {};
+
+  // Bit N is set when |num_sequences_per_priority_[N]| isn't zero. Only
+  // modified with |container_lock_| held but can be read without it.
+  std::atomic<uint32_t> non_empty_priorities_{0};
+
   DISALLOW_COPY_AND_ASSIGN(PriorityQueue);
 };
 
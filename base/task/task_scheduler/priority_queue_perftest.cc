@@ -0,0 +1,126 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/task_scheduler/priority_queue.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind_helpers.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/task/task_scheduler/sequence.h"
+#include "base/task/task_scheduler/task.h"
+#include "base/task/task_traits.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr size_t kNumOperationsPerThread = 200000;
+constexpr size_t kNumSequencesPerThread = 16;
+
+constexpr TaskPriority kPriorities[] = {TaskPriority::BEST_EFFORT,
+                                        TaskPriority::USER_VISIBLE,
+                                        TaskPriority::USER_BLOCKING};
+
+// Pushes Sequences of all priorities to a PriorityQueue and pops them back,
+// one Transaction per operation, like workers and posting threads do.
+class PushPopThread : public SimpleThread {
+ public:
+  explicit PushPopThread(PriorityQueue* priority_queue)
+      : SimpleThread("PushPopThread"), priority_queue_(priority_queue) {
+    for (size_t i = 0; i < kNumSequencesPerThread; ++i) {
+      const TaskTraits traits(kPriorities[i % arraysize(kPriorities)]);
+      scoped_refptr<Sequence> sequence(new Sequence);
+      sequence->PushTask(Task(FROM_HERE, DoNothing(), traits, TimeDelta()));
+      sort_keys_.push_back(sequence->GetSortKey());
+      sequences_.push_back(std::move(sequence));
+    }
+  }
+
+ private:
+  void Run() override {
+    for (size_t i = 0; i < kNumOperationsPerThread; ++i) {
+      const size_t index = i % kNumSequencesPerThread;
+      priority_queue_->BeginTransaction()->Push(sequences_[index],
+                                                sort_keys_[index]);
+      // Sequences pushed by other threads may be popped instead; only the
+      // number of Sequences in |priority_queue_| matters.
+      priority_queue_->BeginTransaction()->PopSequence();
+    }
+  }
+
+  PriorityQueue* const priority_queue_;
+  std::vector<scoped_refptr<Sequence>> sequences_;
+  std::vector<SequenceSortKey> sort_keys_;
+
+  DISALLOW_COPY_AND_ASSIGN(PushPopThread);
+};
+
+void RunPushPopTest(const std::string& test_name, size_t num_threads) {
+  PriorityQueue priority_queue;
+  std::vector<std::unique_ptr<PushPopThread>> threads;
+  for (size_t i = 0; i < num_threads; ++i)
+    threads.push_back(std::make_unique<PushPopThread>(&priority_queue));
+
+  const TimeTicks start = TimeTicks::Now();
+  for (auto& thread : threads)
+    thread->Start();
+  for (auto& thread : threads)
+    thread->Join();
+  const TimeDelta elapsed = TimeTicks::Now() - start;
+
+  EXPECT_TRUE(priority_queue.BeginTransaction()->IsEmpty());
+  perf_test::PrintResult(
+      "task_scheduler_priority_queue", "", test_name,
+      num_threads * kNumOperationsPerThread / elapsed.InMillisecondsF(),
+      "push_pop/ms", true);
+}
+
+}  // namespace
+
+TEST(TaskSchedulerPriorityQueuePerfTest, PushPopOneThread) {
+  RunPushPopTest("push_pop_1_thread", 1);
+}
+
+TEST(TaskSchedulerPriorityQueuePerfTest, PushPopFourThreads) {
+  RunPushPopTest("push_pop_4_threads", 4);
+}
+
+TEST(TaskSchedulerPriorityQueuePerfTest, IsEmptyAtOrAbovePriorityRacy) {
+  PriorityQueue priority_queue;
+  scoped_refptr<Sequence> sequence(new Sequence);
+  sequence->PushTask(Task(FROM_HERE, DoNothing(),
+                          TaskTraits(TaskPriority::USER_VISIBLE), TimeDelta()));
+  priority_queue.BeginTransaction()->Push(sequence, sequence->GetSortKey());
+
+  size_t num_empty = 0;
+  const TimeTicks start = TimeTicks::Now();
+  for (size_t i = 0; i < kNumOperationsPerThread; ++i) {
+    if (priority_queue.IsEmptyAtOrAbovePriorityRacy(
+            kPriorities[i % arraysize(kPriorities)])) {
+      ++num_empty;
+    }
+  }
+  const TimeDelta elapsed = TimeTicks::Now() - start;
+
+  EXPECT_EQ(kNumOperationsPerThread / arraysize(kPriorities), num_empty);
+  perf_test::PrintResult("task_scheduler_priority_queue", "",
+                         "is_empty_at_or_above_priority_racy",
+                         kNumOperationsPerThread / elapsed.InMillisecondsF(),
+                         "checks/ms", true);
+}
+
+}  // namespace internal
+}  // namespace base
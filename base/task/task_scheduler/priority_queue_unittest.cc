@@ -126,6 +126,45 @@ TEST(TaskSchedulerPriorityQueueTest, PushPopPeek) {
   EXPECT_TRUE(transaction->IsEmpty());
 }
 
+// Check that the racy per-priority emptiness check reflects the content of the
+// PriorityQueue once Transactions have ended.
+TEST(TaskSchedulerPriorityQueueTest, IsEmptyAtOrAbovePriorityRacy) {
+  scoped_refptr<Sequence> sequence_a(new Sequence);
+  sequence_a->PushTask(Task(FROM_HERE, DoNothing(),
+                            TaskTraits(TaskPriority::USER_VISIBLE),
+                            TimeDelta()));
+  SequenceSortKey sort_key_a = sequence_a->GetSortKey();
+
+  scoped_refptr<Sequence> sequence_b(new Sequence);
+  sequence_b->PushTask(Task(FROM_HERE, DoNothing(),
+                            TaskTraits(TaskPriority::BEST_EFFORT),
+                            TimeDelta()));
+  SequenceSortKey sort_key_b = sequence_b->GetSortKey();
+
+  PriorityQueue pq;
+  EXPECT_TRUE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::LOWEST));
+
+  pq.BeginTransaction()->Push(sequence_b, sort_key_b);
+  EXPECT_FALSE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::BEST_EFFORT));
+  EXPECT_TRUE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::USER_VISIBLE));
+
+  pq.BeginTransaction()->Push(sequence_a, sort_key_a);
+  EXPECT_FALSE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::USER_VISIBLE));
+  EXPECT_TRUE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::USER_BLOCKING));
+
+  {
+    auto transaction(pq.BeginTransaction());
+    EXPECT_EQ(2U, transaction->Size());
+    EXPECT_EQ(sequence_a, transaction->PopSequence());
+    EXPECT_EQ(1U, transaction->Size());
+  }
+  EXPECT_TRUE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::USER_VISIBLE));
+  EXPECT_FALSE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::BEST_EFFORT));
+
+  EXPECT_EQ(sequence_b, pq.BeginTransaction()->PopSequence());
+  EXPECT_TRUE(pq.IsEmptyAtOrAbovePriorityRacy(TaskPriority::LOWEST));
+}
+
 // Check that creating Transactions on the same thread for 2 unrelated
 // PriorityQueues causes a crash.
 TEST(TaskSchedulerPriorityQueueTest, IllegalTwoTransactionsSameThread) {
@@ -19,6 +19,18 @@ enum class SchedulerBackwardCompatibility {
   INIT_COM_STA,
 };
 
+enum class SchedulerWorkStealing {
+  // All workers of a pool get their work from the pool's shared
+  // PriorityQueue.
+  DISABLED,
+
+  // Each worker keeps the Sequences it re-enqueues in a local PriorityQueue
+  // and only goes through the pool's shared PriorityQueue for new Sequences and
+  // cross-priority fairness. Idle workers steal Sequences from the local
+  // PriorityQueues of their siblings before going to sleep.
+  ENABLED,
+};
+
 }  // namespace base
 
 #endif  // BASE_TASK_TASK_SCHEDULER_SCHEDULER_WORKER_PARAMS_H_
@@ -27,6 +27,7 @@
 #include "base/threading/scoped_blocking_call.h"
 #include "base/threading/thread_checker.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 
 #if defined(OS_WIN)
 #include "base/win/scoped_com_initializer.h"
@@ -52,6 +53,12 @@ constexpr char kNumTasksBetweenWaitsHistogramPrefix[] =
 constexpr char kNumThreadsHistogramPrefix[] = "TaskScheduler.NumWorkers.";
 constexpr size_t kMaxNumberOfWorkers = 256;
 
+// In work-stealing mode, the maximum number of Sequences that a worker gets
+// from its local PriorityQueue before it compares the local and shared
+// PriorityQueues. This bounds how long higher priority work posted to the
+// shared PriorityQueue can be starved by a busy local PriorityQueue.
+constexpr size_t kMaxLocalSequencesBeforeSharedQueueCheck = 8;
+
 // Only used in DCHECKs.
 bool ContainsWorker(const std::vector<scoped_refptr<SchedulerWorker>>& workers,
                     const SchedulerWorker* worker) {
@@ -100,7 +107,30 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
     return is_running_background_task_;
   }
 
+  // Removes and returns the highest priority Sequence from this worker's local
+  // PriorityQueue, or nullptr if it is empty. Called by siblings of this worker
+  // in work-stealing mode.
+  scoped_refptr<Sequence> StealSequence();
+
  private:
+  // In work-stealing mode, returns a Sequence from |local_priority_queue_| if
+  // it isn't empty and a shared PriorityQueue check isn't due. Returns nullptr
+  // otherwise.
+  scoped_refptr<Sequence> GetWorkFromLocalQueue();
+
+  // In work-stealing mode, steals a Sequence from the local PriorityQueue of
+  // one of the workers in |siblings|, starting after |worker| so that siblings
+  // aren't all robbed in the same order. Returns nullptr if all local
+  // PriorityQueues are empty. Must be called within the scope of a Transaction
+  // on |outer_->shared_priority_queue_|.
+  scoped_refptr<Sequence> StealFromSiblings(
+      const SchedulerWorker* worker,
+      const std::vector<scoped_refptr<SchedulerWorker>>& siblings);
+
+  // Moves all Sequences from |local_priority_queue_| to
+  // |outer_->shared_priority_queue_|. Returns true if any Sequence was moved.
+  bool FlushLocalQueueToSharedQueue();
+
   // Returns true if |worker| is allowed to cleanup and remove itself from the
   // pool. Called from GetWork() when no work is available.
   bool CanCleanupLockRequired(const SchedulerWorker* worker) const;
@@ -115,6 +145,16 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
 
   const TrackedRef<SchedulerWorkerPoolImpl> outer_;
 
+  // In work-stealing mode, holds the Sequences re-enqueued by this worker. Its
+  // lock has |outer_->shared_priority_queue_|'s lock as predecessor so that the
+  // local and shared PriorityQueues can be compared within one Transaction.
+  PriorityQueue local_priority_queue_;
+
+  // Number of Sequences obtained from |local_priority_queue_| since the last
+  // time GetWork() compared it with |outer_->shared_priority_queue_|. Only
+  // accessed on the worker thread.
+  size_t num_local_sequences_since_shared_queue_check_ = 0;
+
   // Time of the last detach.
   TimeTicks last_detach_time_;
 
@@ -231,6 +271,7 @@ void SchedulerWorkerPoolImpl::Start(
   max_background_tasks_ = max_background_tasks;
   suggested_reclaim_time_ = params.suggested_reclaim_time();
   backward_compatibility_ = params.backward_compatibility();
+  work_stealing_ = params.work_stealing();
   worker_environment_ = worker_environment;
 
   service_thread_task_runner_ = std::move(service_thread_task_runner);
@@ -273,8 +314,16 @@ SchedulerWorkerPoolImpl::~SchedulerWorkerPoolImpl() {
 void SchedulerWorkerPoolImpl::OnCanScheduleSequence(
     scoped_refptr<Sequence> sequence) {
   const auto sequence_sort_key = sequence->GetSortKey();
-  shared_priority_queue_.BeginTransaction()->Push(std::move(sequence),
-                                                  sequence_sort_key);
+  size_t num_queued_sequences;
+  {
+    std::unique_ptr<PriorityQueue::Transaction> transaction(
+        shared_priority_queue_.BeginTransaction());
+    transaction->Push(std::move(sequence), sequence_sort_key);
+    num_queued_sequences = transaction->Size();
+  }
+  TRACE_COUNTER_ID1(TRACE_DISABLED_BY_DEFAULT("task_scheduler_diagnostics"),
+                    "SchedulerWorkerPool queued sequences", this,
+                    num_queued_sequences);
 
   WakeUpOneWorker();
 }
@@ -381,7 +430,8 @@ void SchedulerWorkerPoolImpl::RecordNumWorkersHistogram() const {
 
 SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
     SchedulerWorkerDelegateImpl(TrackedRef<SchedulerWorkerPoolImpl> outer)
-    : outer_(std::move(outer)) {
+    : outer_(std::move(outer)),
+      local_priority_queue_(outer_->shared_priority_queue_.container_lock()) {
   // Bound in OnMainEntry().
   DETACH_FROM_THREAD(worker_thread_checker_);
 }
@@ -440,6 +490,9 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
   DCHECK(!is_running_task_);
   DCHECK(!is_running_background_task_);
 
+  const bool work_stealing_enabled =
+      outer_->work_stealing_ == SchedulerWorkStealing::ENABLED;
+  bool is_excess_worker = false;
   {
     AutoSchedulerLock auto_lock(outer_->lock_);
 
@@ -469,15 +522,55 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
     if (outer_->NumberOfExcessWorkersLockRequired() >
         outer_->idle_workers_stack_.Size()) {
       OnWorkerBecomesIdleLockRequired(worker);
-      return nullptr;
+      is_excess_worker = true;
     }
   }
+
+  if (is_excess_worker) {
+    // Sequences left in the local PriorityQueue of a worker that goes idle
+    // must be made available to the rest of the pool.
+    if (work_stealing_enabled && FlushLocalQueueToSharedQueue())
+      outer_->WakeUpOneWorker();
+    return nullptr;
+  }
+
   scoped_refptr<Sequence> sequence;
-  {
+  if (work_stealing_enabled)
+    sequence = GetWorkFromLocalQueue();
+
+  // Snapshot of the workers of the pool, from which Sequences can be stolen if
+  // the shared PriorityQueue is empty.
+  std::vector<scoped_refptr<SchedulerWorker>> siblings;
+
+  if (!sequence) {
     std::unique_ptr<PriorityQueue::Transaction> transaction(
         outer_->shared_priority_queue_.BeginTransaction());
 
-    if (transaction->IsEmpty()) {
+    if (work_stealing_enabled) {
+      num_local_sequences_since_shared_queue_check_ = 0;
+
+      // Respect cross-priority fairness: only get work from the shared
+      // PriorityQueue if it has higher priority work than the local one.
+      std::unique_ptr<PriorityQueue::Transaction> local_transaction(
+          local_priority_queue_.BeginTransaction());
+      if (!local_transaction->IsEmpty() &&
+          (transaction->IsEmpty() ||
+           transaction->PeekSortKey() < local_transaction->PeekSortKey())) {
+        sequence = local_transaction->PopSequence();
+      }
+    }
+
+    if (!sequence && transaction->IsEmpty() && work_stealing_enabled) {
+      {
+        AutoSchedulerLock auto_lock(outer_->lock_);
+        siblings = outer_->workers_;
+      }
+      sequence = StealFromSiblings(worker, siblings);
+    }
+
+    if (sequence) {
+      // Got work from a local PriorityQueue.
+    } else if (transaction->IsEmpty()) {
       // |transaction| is kept alive while |worker| is added to
       // |idle_workers_stack_| to avoid this race:
       // 1. This thread creates a Transaction, finds |shared_priority_queue_|
@@ -490,26 +583,30 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
       //    |idle_workers_stack_| is empty.
       // 4. This thread adds itself to |idle_workers_stack_| and goes to sleep.
       //    No thread runs the Sequence inserted in step 2.
+      //
+      // The same reasoning applies to Sequences re-enqueued in the local
+      // PriorityQueues of other workers: they are only pushed by their owner,
+      // which always calls GetWork() afterwards.
       AutoSchedulerLock auto_lock(outer_->lock_);
       OnWorkerBecomesIdleLockRequired(worker);
       return nullptr;
-    }
-
-    // Enforce that no more than |max_background_tasks_| run concurrently.
-    const TaskPriority priority = transaction->PeekSortKey().priority();
-    if (priority == TaskPriority::BEST_EFFORT) {
-      AutoSchedulerLock auto_lock(outer_->lock_);
-      if (outer_->num_running_background_tasks_ <
-          outer_->max_background_tasks_) {
-        ++outer_->num_running_background_tasks_;
-        is_running_background_task_ = true;
-      } else {
-        OnWorkerBecomesIdleLockRequired(worker);
-        return nullptr;
+    } else {
+      // Enforce that no more than |max_background_tasks_| run concurrently.
+      const TaskPriority priority = transaction->PeekSortKey().priority();
+      if (priority == TaskPriority::BEST_EFFORT) {
+        AutoSchedulerLock auto_lock(outer_->lock_);
+        if (outer_->num_running_background_tasks_ <
+            outer_->max_background_tasks_) {
+          ++outer_->num_running_background_tasks_;
+          is_running_background_task_ = true;
+        } else {
+          OnWorkerBecomesIdleLockRequired(worker);
+          return nullptr;
+        }
       }
-    }
 
-    sequence = transaction->PopSequence();
+      sequence = transaction->PopSequence();
+    }
   }
   DCHECK(sequence);
 #if DCHECK_IS_ON()
@@ -546,6 +643,17 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::ReEnqueueSequence(
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
 
   const SequenceSortKey sequence_sort_key = sequence->GetSortKey();
+
+  // In work-stealing mode, keep the Sequence local unless it is
+  // TaskPriority::BEST_EFFORT: |max_background_tasks_| is enforced when a
+  // Sequence is popped from the shared PriorityQueue.
+  if (outer_->work_stealing_ == SchedulerWorkStealing::ENABLED &&
+      sequence_sort_key.priority() != TaskPriority::BEST_EFFORT) {
+    local_priority_queue_.BeginTransaction()->Push(std::move(sequence),
+                                                   sequence_sort_key);
+    return;
+  }
+
   outer_->shared_priority_queue_.BeginTransaction()->Push(std::move(sequence),
                                                           sequence_sort_key);
   // This worker will soon call GetWork(). Therefore, there is no need to wake
@@ -553,6 +661,88 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::ReEnqueueSequence(
   // |outer_->shared_priority_queue_|.
 }
 
+scoped_refptr<Sequence>
+SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::StealSequence() {
+  std::unique_ptr<PriorityQueue::Transaction> transaction(
+      local_priority_queue_.BeginTransaction());
+  if (transaction->IsEmpty())
+    return nullptr;
+  return transaction->PopSequence();
+}
+
+scoped_refptr<Sequence>
+SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWorkFromLocalQueue() {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  if (num_local_sequences_since_shared_queue_check_ >=
+      kMaxLocalSequencesBeforeSharedQueueCheck) {
+    return nullptr;
+  }
+
+  std::unique_ptr<PriorityQueue::Transaction> transaction(
+      local_priority_queue_.BeginTransaction());
+  if (transaction->IsEmpty())
+    return nullptr;
+
+  // Defer to the fairness check in GetWork() if the shared PriorityQueue
+  // appears to have higher priority work. This doesn't require a Transaction on
+  // the shared PriorityQueue.
+  const TaskPriority local_priority = transaction->PeekSortKey().priority();
+  if (local_priority != TaskPriority::HIGHEST &&
+      !outer_->shared_priority_queue_.IsEmptyAtOrAbovePriorityRacy(
+          static_cast<TaskPriority>(static_cast<int>(local_priority) + 1))) {
+    return nullptr;
+  }
+
+  ++num_local_sequences_since_shared_queue_check_;
+  return transaction->PopSequence();
+}
+
+scoped_refptr<Sequence>
+SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::StealFromSiblings(
+    const SchedulerWorker* worker,
+    const std::vector<scoped_refptr<SchedulerWorker>>& siblings) {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  auto self = std::find(siblings.begin(), siblings.end(), worker);
+  const size_t start =
+      self == siblings.end() ? 0 : (self - siblings.begin()) + 1;
+  for (size_t i = 0; i < siblings.size(); ++i) {
+    SchedulerWorker* sibling = siblings[(start + i) % siblings.size()].get();
+    if (sibling == worker)
+      continue;
+    scoped_refptr<Sequence> sequence =
+        static_cast<SchedulerWorkerDelegateImpl*>(sibling->delegate())
+            ->StealSequence();
+    if (sequence)
+      return sequence;
+  }
+  return nullptr;
+}
+
+bool SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
+    FlushLocalQueueToSharedQueue() {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  std::vector<scoped_refptr<Sequence>> sequences;
+  {
+    std::unique_ptr<PriorityQueue::Transaction> transaction(
+        local_priority_queue_.BeginTransaction());
+    while (!transaction->IsEmpty())
+      sequences.push_back(transaction->PopSequence());
+  }
+  if (sequences.empty())
+    return false;
+
+  std::unique_ptr<PriorityQueue::Transaction> transaction(
+      outer_->shared_priority_queue_.BeginTransaction());
+  for (auto& sequence : sequences) {
+    const SequenceSortKey sequence_sort_key = sequence->GetSortKey();
+    transaction->Push(std::move(sequence), sequence_sort_key);
+  }
+  return true;
+}
+
 TimeDelta
 SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetSleepTimeout() {
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
@@ -667,6 +857,14 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::BlockingStarted(
   if (!is_running_task_)
     return;
 
+  // Sequences in the local PriorityQueue can't run while this worker is
+  // blocked, and the max tasks adjustments below only look at the shared
+  // PriorityQueue. Make them available to the rest of the pool.
+  if (outer_->work_stealing_ == SchedulerWorkStealing::ENABLED &&
+      FlushLocalQueueToSharedQueue()) {
+    outer_->WakeUpOneWorker();
+  }
+
   switch (blocking_type) {
     case BlockingType::MAY_BLOCK:
       MayBlockEntered();
@@ -238,6 +238,11 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
 
   SchedulerBackwardCompatibility backward_compatibility_;
 
+  // Whether workers keep re-enqueued Sequences in a local PriorityQueue and
+  // steal from each other. Initialized by Start(). Never modified afterwards
+  // (i.e. can be read without synchronization after Start()).
+  SchedulerWorkStealing work_stealing_ = SchedulerWorkStealing::DISABLED;
+
   // Synchronizes accesses to |workers_|, |max_tasks_|, |max_background_tasks_|,
   // |num_running_background_tasks_|, |num_pending_may_block_workers_|,
   // |idle_workers_stack_|, |idle_workers_stack_cv_for_testing_|,
@@ -0,0 +1,169 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/task_scheduler/scheduler_worker_pool_impl.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/macros.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/task/task_scheduler/delayed_task_manager.h"
+#include "base/task/task_scheduler/scheduler_worker_pool_params.h"
+#include "base/task/task_scheduler/task_tracker.h"
+#include "base/task/task_scheduler/test_utils.h"
+#include "base/task_runner.h"
+#include "base/threading/simple_thread.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr size_t kNumPostingThreads = 4;
+constexpr size_t kNumTasksPerPostingThread = 100000;
+constexpr size_t kNumSequencesPerPostingThread = 8;
+
+// Posts |num_tasks| tasks round-robin to |task_runners|. Each task decrements
+// |*num_tasks_pending| and signals |*all_tasks_ran| when it reaches zero.
+class PostingThread : public SimpleThread {
+ public:
+  PostingThread(std::vector<scoped_refptr<TaskRunner>> task_runners,
+                size_t num_tasks,
+                subtle::Atomic32* num_tasks_pending,
+                WaitableEvent* all_tasks_ran)
+      : SimpleThread("PostingThread"),
+        task_runners_(std::move(task_runners)),
+        num_tasks_(num_tasks),
+        num_tasks_pending_(num_tasks_pending),
+        all_tasks_ran_(all_tasks_ran) {}
+
+ private:
+  static void RunTask(subtle::Atomic32* num_tasks_pending,
+                      WaitableEvent* all_tasks_ran) {
+    if (subtle::NoBarrier_AtomicIncrement(num_tasks_pending, -1) == 0)
+      all_tasks_ran->Signal();
+  }
+
+  void Run() override {
+    for (size_t i = 0; i < num_tasks_; ++i) {
+      task_runners_[i % task_runners_.size()]->PostTask(
+          FROM_HERE, BindOnce(&RunTask, Unretained(num_tasks_pending_),
+                              Unretained(all_tasks_ran_)));
+    }
+  }
+
+  const std::vector<scoped_refptr<TaskRunner>> task_runners_;
+  const size_t num_tasks_;
+  subtle::Atomic32* const num_tasks_pending_;
+  WaitableEvent* const all_tasks_ran_;
+
+  DISALLOW_COPY_AND_ASSIGN(PostingThread);
+};
+
+class TaskSchedulerWorkerPoolPerfTest
+    : public testing::TestWithParam<SchedulerWorkStealing> {
+ protected:
+  TaskSchedulerWorkerPoolPerfTest()
+      : service_thread_("TaskSchedulerServiceThread") {}
+
+  void SetUp() override {
+    service_thread_.Start();
+    delayed_task_manager_.Start(service_thread_.task_runner());
+    worker_pool_ = std::make_unique<SchedulerWorkerPoolImpl>(
+        "PerfTestWorkerPool", "A", ThreadPriority::NORMAL,
+        task_tracker_.GetTrackedRef(), &delayed_task_manager_);
+    const int max_tasks = SysInfo::NumberOfProcessors();
+    worker_pool_->Start(
+        SchedulerWorkerPoolParams(max_tasks, TimeDelta::Max(),
+                                  SchedulerBackwardCompatibility::DISABLED,
+                                  GetParam()),
+        max_tasks, service_thread_.task_runner(), nullptr,
+        SchedulerWorkerPoolImpl::WorkerEnvironment::NONE);
+  }
+
+  void TearDown() override {
+    service_thread_.Stop();
+    task_tracker_.FlushForTesting();
+    worker_pool_->JoinForTesting();
+    worker_pool_.reset();
+  }
+
+  // Posts kNumTasksPerPostingThread tasks from each of kNumPostingThreads
+  // threads to |execution_mode| TaskRunners and reports the time it took for
+  // all of them to run.
+  void RunPostTaskTest(const std::string& trace,
+                       test::ExecutionMode execution_mode) {
+    const size_t num_tasks = kNumPostingThreads * kNumTasksPerPostingThread;
+    subtle::Atomic32 num_tasks_pending = num_tasks;
+    WaitableEvent all_tasks_ran;
+
+    std::vector<std::unique_ptr<PostingThread>> threads;
+    for (size_t i = 0; i < kNumPostingThreads; ++i) {
+      std::vector<scoped_refptr<TaskRunner>> task_runners;
+      for (size_t j = 0; j < kNumSequencesPerPostingThread; ++j) {
+        task_runners.push_back(test::CreateTaskRunnerWithExecutionMode(
+            worker_pool_.get(), execution_mode));
+      }
+      threads.push_back(std::make_unique<PostingThread>(
+          std::move(task_runners), kNumTasksPerPostingThread,
+          &num_tasks_pending, &all_tasks_ran));
+    }
+
+    const TimeTicks start = TimeTicks::Now();
+    for (auto& thread : threads)
+      thread->Start();
+    for (auto& thread : threads)
+      thread->Join();
+    all_tasks_ran.Wait();
+    const TimeDelta elapsed = TimeTicks::Now() - start;
+
+    perf_test::PrintResult(
+        "task", "",
+        trace + (GetParam() == SchedulerWorkStealing::ENABLED
+                     ? "_work_stealing"
+                     : "_shared_queue"),
+        elapsed.InMicrosecondsF() / num_tasks, "us/task", true);
+  }
+
+ private:
+  Thread service_thread_;
+  TaskTracker task_tracker_ = {"PerfTest"};
+  DelayedTaskManager delayed_task_manager_;
+  std::unique_ptr<SchedulerWorkerPoolImpl> worker_pool_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskSchedulerWorkerPoolPerfTest);
+};
+
+}  // namespace
+
+TEST_P(TaskSchedulerWorkerPoolPerfTest, PostParallelTasks) {
+  RunPostTaskTest("parallel", test::ExecutionMode::PARALLEL);
+}
+
+TEST_P(TaskSchedulerWorkerPoolPerfTest, PostSequencedTasks) {
+  RunPostTaskTest("sequenced", test::ExecutionMode::SEQUENCED);
+}
+
+INSTANTIATE_TEST_CASE_P(SharedQueue,
+                        TaskSchedulerWorkerPoolPerfTest,
+                        ::testing::Values(SchedulerWorkStealing::DISABLED));
+INSTANTIATE_TEST_CASE_P(WorkStealing,
+                        TaskSchedulerWorkerPoolPerfTest,
+                        ::testing::Values(SchedulerWorkStealing::ENABLED));
+
+}  // namespace internal
+}  // namespace base
@@ -307,6 +307,172 @@ INSTANTIATE_TEST_CASE_P(Sequenced,
                         TaskSchedulerWorkerPoolImplTestParam,
                         ::testing::Values(test::ExecutionMode::SEQUENCED));
 
+namespace {
+
+class TaskSchedulerWorkerPoolImplWorkStealingTest
+    : public TaskSchedulerWorkerPoolImplTestBase,
+      public testing::TestWithParam<test::ExecutionMode> {
+ protected:
+  TaskSchedulerWorkerPoolImplWorkStealingTest() = default;
+
+  void SetUp() override { TaskSchedulerWorkerPoolImplTestBase::CommonSetUp(); }
+
+  void TearDown() override {
+    TaskSchedulerWorkerPoolImplTestBase::CommonTearDown();
+  }
+
+ private:
+  void StartWorkerPool(TimeDelta suggested_reclaim_time,
+                       size_t max_tasks) override {
+    ASSERT_TRUE(worker_pool_);
+    worker_pool_->Start(
+        SchedulerWorkerPoolParams(max_tasks, suggested_reclaim_time,
+                                  SchedulerBackwardCompatibility::DISABLED,
+                                  SchedulerWorkStealing::ENABLED),
+        max_tasks, service_thread_.task_runner(), nullptr,
+        SchedulerWorkerPoolImpl::WorkerEnvironment::NONE);
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(TaskSchedulerWorkerPoolImplWorkStealingTest);
+};
+
+}  // namespace
+
+// Verify that tasks posted from many threads all run when workers keep
+// re-enqueued Sequences in their local PriorityQueue.
+TEST_P(TaskSchedulerWorkerPoolImplWorkStealingTest,
+       PostTasksWaitAllWorkersIdle) {
+  std::vector<std::unique_ptr<ThreadPostingTasksWaitIdle>>
+      threads_posting_tasks;
+  for (size_t i = 0; i < kNumThreadsPostingTasks; ++i) {
+    threads_posting_tasks.push_back(
+        std::make_unique<ThreadPostingTasksWaitIdle>(worker_pool_.get(),
+                                                     GetParam()));
+    threads_posting_tasks.back()->Start();
+  }
+
+  for (const auto& thread_posting_tasks : threads_posting_tasks) {
+    thread_posting_tasks->Join();
+    thread_posting_tasks->factory()->WaitForAllTasksToRun();
+  }
+
+  worker_pool_->WaitForAllWorkersIdleForTesting();
+}
+
+// Verify that Sequences re-enqueued by busy workers don't get stuck in their
+// local PriorityQueue when only one worker is available.
+TEST_P(TaskSchedulerWorkerPoolImplWorkStealingTest,
+       PostTasksWithOneAvailableWorker) {
+  WaitableEvent event;
+  std::vector<std::unique_ptr<test::TestTaskFactory>> blocked_task_factories;
+  for (size_t i = 0; i < (kMaxTasks - 1); ++i) {
+    blocked_task_factories.push_back(std::make_unique<test::TestTaskFactory>(
+        CreateTaskRunnerWithExecutionMode(worker_pool_.get(), GetParam()),
+        GetParam()));
+    EXPECT_TRUE(blocked_task_factories.back()->PostTask(
+        PostNestedTask::NO,
+        BindOnce(&WaitWithoutBlockingObserver, Unretained(&event))));
+    blocked_task_factories.back()->WaitForAllTasksToRun();
+  }
+
+  std::vector<std::unique_ptr<test::TestTaskFactory>> short_task_factories;
+  for (size_t i = 0; i < kNumThreadsPostingTasks; ++i) {
+    short_task_factories.push_back(std::make_unique<test::TestTaskFactory>(
+        CreateTaskRunnerWithExecutionMode(worker_pool_.get(), GetParam()),
+        GetParam()));
+    for (size_t j = 0; j < kNumTasksPostedPerThread; ++j) {
+      EXPECT_TRUE(short_task_factories.back()->PostTask(PostNestedTask::NO,
+                                                        Closure()));
+    }
+  }
+  for (const auto& factory : short_task_factories)
+    factory->WaitForAllTasksToRun();
+
+  event.Signal();
+  worker_pool_->WaitForAllWorkersIdleForTesting();
+}
+
+// Verify that a Sequence in the local PriorityQueue of a worker runs while that
+// worker is blocked in a MAY_BLOCK ScopedBlockingCall.
+TEST_P(TaskSchedulerWorkerPoolImplWorkStealingTest,
+       LocalSequenceRunsWhileWorkerBlocks) {
+  // Occupy all workers but one.
+  WaitableEvent other_workers_continue;
+  WaitableEvent other_worker_running(WaitableEvent::ResetPolicy::AUTOMATIC);
+  scoped_refptr<TaskRunner> other_task_runner =
+      test::CreateTaskRunnerWithExecutionMode(worker_pool_.get(),
+                                              test::ExecutionMode::PARALLEL);
+  for (size_t i = 0; i < (kMaxTasks - 1); ++i) {
+    other_task_runner->PostTask(
+        FROM_HERE, BindOnce(
+                       [](WaitableEvent* other_worker_running,
+                          WaitableEvent* other_workers_continue) {
+                         other_worker_running->Signal();
+                         WaitWithoutBlockingObserver(other_workers_continue);
+                       },
+                       Unretained(&other_worker_running),
+                       Unretained(&other_workers_continue)));
+    other_worker_running.Wait();
+  }
+
+  // Run enough tasks from |local_task_runner| for the remaining worker's next
+  // GetWork() to compare its local PriorityQueue with the shared one, then
+  // hold it in a task.
+  scoped_refptr<TaskRunner> local_task_runner =
+      test::CreateTaskRunnerWithExecutionMode(worker_pool_.get(),
+                                              test::ExecutionMode::SEQUENCED);
+  for (size_t i = 0; i < 8; ++i)
+    local_task_runner->PostTask(FROM_HERE, DoNothing());
+  WaitableEvent local_task_running;
+  WaitableEvent local_task_continue;
+  local_task_runner->PostTask(
+      FROM_HERE,
+      BindOnce(
+          [](WaitableEvent* local_task_running,
+             WaitableEvent* local_task_continue) {
+            local_task_running->Signal();
+            WaitWithoutBlockingObserver(local_task_continue);
+          },
+          Unretained(&local_task_running), Unretained(&local_task_continue)));
+  local_task_running.Wait();
+
+  // The blocking task is posted before the next task of |local_task_runner|,
+  // so the worker gets it from the shared PriorityQueue and leaves the
+  // Sequence of |local_task_runner| in its local PriorityQueue.
+  WaitableEvent local_sequence_ran;
+  WaitableEvent blocking_task_done;
+  test::CreateTaskRunnerWithExecutionMode(worker_pool_.get(),
+                                          test::ExecutionMode::SEQUENCED)
+      ->PostTask(FROM_HERE,
+                 BindOnce(
+                     [](WaitableEvent* local_sequence_ran,
+                        WaitableEvent* blocking_task_done) {
+                       ScopedBlockingCall scoped_blocking_call(
+                           BlockingType::MAY_BLOCK);
+                       WaitWithoutBlockingObserver(local_sequence_ran);
+                       blocking_task_done->Signal();
+                     },
+                     Unretained(&local_sequence_ran),
+                     Unretained(&blocking_task_done)));
+  local_task_runner->PostTask(FROM_HERE,
+                              BindOnce(&WaitableEvent::Signal,
+                                       Unretained(&local_sequence_ran)));
+  local_task_continue.Signal();
+
+  // Should not block forever.
+  blocking_task_done.Wait();
+
+  other_workers_continue.Signal();
+  worker_pool_->WaitForAllWorkersIdleForTesting();
+}
+
+INSTANTIATE_TEST_CASE_P(Parallel,
+                        TaskSchedulerWorkerPoolImplWorkStealingTest,
+                        ::testing::Values(test::ExecutionMode::PARALLEL));
+INSTANTIATE_TEST_CASE_P(Sequenced,
+                        TaskSchedulerWorkerPoolImplWorkStealingTest,
+                        ::testing::Values(test::ExecutionMode::SEQUENCED));
+
 #if defined(OS_WIN)
 
 namespace {
@@ -17,12 +17,14 @@ class BASE_EXPORT SchedulerWorkerPoolParams final {
   // |suggested_reclaim_time| sets a suggestion on when to reclaim idle threads.
   // The pool is free to ignore this value for performance or correctness
   // reasons. |backward_compatibility| indicates whether backward compatibility
-  // is enabled.
+  // is enabled. |work_stealing| indicates whether workers keep a local queue of
+  // Sequences and steal from each other (see SchedulerWorkStealing).
   SchedulerWorkerPoolParams(
       int max_tasks,
       TimeDelta suggested_reclaim_time,
       SchedulerBackwardCompatibility backward_compatibility =
-          SchedulerBackwardCompatibility::DISABLED);
+          SchedulerBackwardCompatibility::DISABLED,
+      SchedulerWorkStealing work_stealing = SchedulerWorkStealing::DISABLED);
 
   SchedulerWorkerPoolParams(const SchedulerWorkerPoolParams& other);
   SchedulerWorkerPoolParams& operator=(const SchedulerWorkerPoolParams& other);
@@ -32,11 +34,13 @@ class BASE_EXPORT SchedulerWorkerPoolParams final {
   SchedulerBackwardCompatibility backward_compatibility() const {
     return backward_compatibility_;
   }
+  SchedulerWorkStealing work_stealing() const { return work_stealing_; }
 
  private:
   int max_tasks_;
   TimeDelta suggested_reclaim_time_;
   SchedulerBackwardCompatibility backward_compatibility_;
+  SchedulerWorkStealing work_stealing_;
 };
 
 }  // namespace base
@@ -87,6 +87,9 @@ TaskSchedulerImpl::~TaskSchedulerImpl() {
 #if DCHECK_IS_ON()
   DCHECK(join_for_testing_returned_.IsSet());
 #endif
+  // |delayed_task_manager_| must not be reached from the service thread once
+  // it is destroyed.
+  DCHECK(!service_thread_->IsRunning());
 }
 
 void TaskSchedulerImpl::Start(
@@ -103,8 +103,11 @@ class BASE_EXPORT TaskSchedulerImpl : public TaskScheduler {
   void ReportHeartbeatMetrics() const;
 
   const std::unique_ptr<TaskTrackerImpl> task_tracker_;
-  std::unique_ptr<Thread> service_thread_;
+  // Declared before |service_thread_| so that it outlives it: wake ups posted
+  // to the service thread by |delayed_task_manager_| are bound to it with
+  // Unretained().
   DelayedTaskManager delayed_task_manager_;
+  std::unique_ptr<Thread> service_thread_;
   SchedulerSingleThreadTaskRunnerManager single_thread_task_runner_manager_;
 
   // Indicates that all tasks are handled as if they had been posted with
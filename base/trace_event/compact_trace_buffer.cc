@@ -0,0 +1,207 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/compact_trace_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "base/callback.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/threading/platform_thread.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_memory_overhead.h"
+
+namespace base {
+namespace trace_event {
+
+// static
+bool CompactTraceRecord::CanRecord(unsigned int flags,
+                                   int num_args,
+                                   const unsigned char* arg_types) {
+  if (flags & TRACE_EVENT_FLAG_COPY)
+    return false;
+  for (int i = 0; i < num_args; ++i) {
+    if (arg_types[i] == TRACE_VALUE_TYPE_COPY_STRING ||
+        arg_types[i] == TRACE_VALUE_TYPE_CONVERTABLE) {
+      return false;
+    }
+  }
+  return num_args <= kTraceMaxNumArgs;
+}
+
+void CompactTraceRecord::CopyTo(TraceEvent* trace_event) const {
+  trace_event->Initialize(thread_id, timestamp, thread_timestamp, phase,
+                          category_group_enabled, name, scope, id, bind_id,
+                          num_args, arg_names, arg_types, arg_values, nullptr,
+                          flags);
+}
+
+// The records of one thread. Only that thread appends to it, until it is
+// sealed. Sealing can happen on any thread and waits for the current append
+// to finish, after which the records can be read from any thread.
+class CompactTraceBuffer::ThreadBuffer
+    : public RefCountedThreadSafe<ThreadBuffer> {
+ public:
+  explicit ThreadBuffer(size_t max_chunks)
+      : capacity_(max_chunks * kRecordsPerChunk) {}
+
+  bool Add(const CompactTraceRecord& record) {
+    // Announce the write before checking for a seal, while Seal() does the
+    // opposite: either this sees the seal, or Seal() waits for this write.
+    // That is only guaranteed with sequentially consistent accesses.
+    writing_.store(true, std::memory_order_seq_cst);
+    if (sealed_.load(std::memory_order_seq_cst)) {
+      writing_.store(false, std::memory_order_release);
+      return false;
+    }
+
+    const size_t num_records = num_records_.load(std::memory_order_relaxed);
+    const size_t index = num_records % capacity_;
+    if (index / kRecordsPerChunk == chunks_.size())
+      chunks_.push_back(std::make_unique<Chunk>());
+    chunks_[index / kRecordsPerChunk]->records[index % kRecordsPerChunk] =
+        record;
+    num_records_.store(num_records + 1, std::memory_order_relaxed);
+
+    writing_.store(false, std::memory_order_release);
+    return true;
+  }
+
+  void Seal() {
+    sealed_.store(true, std::memory_order_seq_cst);
+    while (writing_.load(std::memory_order_seq_cst))
+      PlatformThread::YieldCurrentThread();
+  }
+
+  bool is_sealed() const {
+    return sealed_.load(std::memory_order_relaxed);
+  }
+
+  void ForEachRecord(
+      const RepeatingCallback<void(const CompactTraceRecord&)>& callback)
+      const {
+    DCHECK(is_sealed());
+    const size_t num_records = num_records_.load(std::memory_order_relaxed);
+    for (size_t i = num_records - size(); i < num_records; ++i) {
+      const size_t index = i % capacity_;
+      callback.Run(
+          chunks_[index / kRecordsPerChunk]->records[index % kRecordsPerChunk]);
+    }
+  }
+
+  size_t size() const {
+    return std::min(num_records_.load(std::memory_order_relaxed), capacity_);
+  }
+
+  size_t allocated_size() const { return chunks_.size() * sizeof(Chunk); }
+
+ private:
+  friend class RefCountedThreadSafe<ThreadBuffer>;
+
+  struct Chunk {
+    CompactTraceRecord records[kRecordsPerChunk];
+  };
+
+  ~ThreadBuffer() = default;
+
+  const size_t capacity_;
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  // The number of records ever appended. Only the last |capacity_| are kept.
+  // It is atomic so that size() can be called while recording.
+  std::atomic<size_t> num_records_{0};
+  std::atomic<bool> writing_{false};
+  std::atomic<bool> sealed_{false};
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+constexpr size_t CompactTraceBuffer::kRecordsPerChunk;
+
+CompactTraceBuffer::CompactTraceBuffer(size_t max_chunks_per_thread)
+    : max_chunks_per_thread_(max_chunks_per_thread), sealed_(false) {
+  DCHECK_GT(max_chunks_per_thread, 0u);
+}
+
+CompactTraceBuffer::~CompactTraceBuffer() {
+  Seal();
+}
+
+// static
+bool CompactTraceBuffer::TryAddRecord(const CompactTraceRecord& record) {
+  ThreadBuffer* thread_buffer =
+      static_cast<ThreadBuffer*>(CurrentThreadBuffer().Get());
+  return thread_buffer && thread_buffer->Add(record);
+}
+
+bool CompactTraceBuffer::AddRecordSlow(const CompactTraceRecord& record) {
+  scoped_refptr<ThreadBuffer> thread_buffer;
+  {
+    AutoLock lock(lock_);
+    if (sealed_)
+      return false;
+    thread_buffer = MakeRefCounted<ThreadBuffer>(max_chunks_per_thread_);
+    thread_buffers_.push_back(thread_buffer);
+  }
+
+  // The slot keeps a reference of its own, which replaces the one to the
+  // thread's ring in a previous buffer.
+  ReleaseThreadBuffer(CurrentThreadBuffer().Get());
+  thread_buffer->AddRef();
+  CurrentThreadBuffer().Set(thread_buffer.get());
+  return thread_buffer->Add(record);
+}
+
+void CompactTraceBuffer::Seal() {
+  AutoLock lock(lock_);
+  sealed_ = true;
+  for (const auto& thread_buffer : thread_buffers_)
+    thread_buffer->Seal();
+}
+
+void CompactTraceBuffer::ForEachRecord(
+    const RepeatingCallback<void(const CompactTraceRecord&)>& callback) const {
+  AutoLock lock(lock_);
+  DCHECK(sealed_);
+  for (const auto& thread_buffer : thread_buffers_)
+    thread_buffer->ForEachRecord(callback);
+}
+
+size_t CompactTraceBuffer::Size() const {
+  AutoLock lock(lock_);
+  size_t size = 0;
+  for (const auto& thread_buffer : thread_buffers_)
+    size += thread_buffer->size();
+  return size;
+}
+
+void CompactTraceBuffer::EstimateTraceMemoryOverhead(
+    TraceEventMemoryOverhead* overhead) {
+  // Records are appended concurrently, so only count the allocated chunks,
+  // and only once the buffer is sealed.
+  AutoLock lock(lock_);
+  size_t allocated_size = sizeof(*this);
+  if (sealed_) {
+    for (const auto& thread_buffer : thread_buffers_)
+      allocated_size += thread_buffer->allocated_size();
+  }
+  overhead->Add(TraceEventMemoryOverhead::kTraceBuffer, allocated_size);
+}
+
+// static
+ThreadLocalStorage::Slot& CompactTraceBuffer::CurrentThreadBuffer() {
+  static NoDestructor<ThreadLocalStorage::Slot> current_thread_buffer(
+      &ReleaseThreadBuffer);
+  return *current_thread_buffer;
+}
+
+// static
+void CompactTraceBuffer::ReleaseThreadBuffer(void* thread_buffer) {
+  if (thread_buffer)
+    static_cast<ThreadBuffer*>(thread_buffer)->Release();
+}
+
+}  // namespace trace_event
+}  // namespace base
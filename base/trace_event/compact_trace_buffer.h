@@ -0,0 +1,122 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_COMPACT_TRACE_BUFFER_H_
+#define BASE_TRACE_EVENT_COMPACT_TRACE_BUFFER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/callback_forward.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_local_storage.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event_impl.h"
+
+namespace base {
+namespace trace_event {
+
+class TraceEventMemoryOverhead;
+
+// A trace event with a fixed layout. Unlike TraceEvent, it owns no memory: its
+// strings must outlive the trace, so events with copied strings or convertable
+// arguments can't be recorded this way (see CanRecord()).
+struct BASE_EXPORT CompactTraceRecord {
+  // Returns true if an event with these |flags| and arguments can be recorded
+  // as a CompactTraceRecord.
+  static bool CanRecord(unsigned int flags,
+                        int num_args,
+                        const unsigned char* arg_types);
+
+  // Initializes |trace_event| with the contents of this record.
+  void CopyTo(TraceEvent* trace_event) const;
+
+  TimeTicks timestamp;
+  ThreadTicks thread_timestamp;
+  const unsigned char* category_group_enabled;
+  const char* name;
+  const char* scope;
+  unsigned long long id;
+  unsigned long long bind_id;
+  const char* arg_names[kTraceMaxNumArgs];
+  unsigned long long arg_values[kTraceMaxNumArgs];
+  unsigned int flags;
+  // The process id instead if |flags| has TRACE_EVENT_FLAG_HAS_PROCESS_ID.
+  int thread_id;
+  unsigned char arg_types[kTraceMaxNumArgs];
+  char phase;
+  unsigned char num_args;
+};
+
+// CompactTraceBuffer records CompactTraceRecords into a ring buffer of chunks
+// per thread, so that recording never takes a lock after the first record of
+// each thread. When a thread's ring is full, its oldest records are
+// overwritten.
+//
+// Only one CompactTraceBuffer may be recording at a time, because each thread
+// caches its ring in a single thread-local slot. Recording stops for good once
+// the buffer is sealed, after which its records can be read from any thread.
+class BASE_EXPORT CompactTraceBuffer {
+ public:
+  static constexpr size_t kRecordsPerChunk = 256;
+
+  // Each thread's ring holds up to |max_chunks_per_thread| chunks, which are
+  // allocated as needed.
+  explicit CompactTraceBuffer(size_t max_chunks_per_thread);
+
+  // Seals the buffer if needed.
+  ~CompactTraceBuffer();
+
+  // Appends |record| to the calling thread's ring without locking, and returns
+  // true. Returns false if the calling thread has no ring in a buffer that is
+  // still recording, in which case AddRecordSlow() must be called instead.
+  static bool TryAddRecord(const CompactTraceRecord& record);
+
+  // Creates a ring in this buffer for the calling thread and appends |record|
+  // to it. Returns false if the buffer is sealed. The buffer must not be
+  // destroyed during this call, so callers synchronize it with their own lock.
+  bool AddRecordSlow(const CompactTraceRecord& record);
+
+  // Stops recording, waiting for the records being appended by other threads
+  // to be complete.
+  void Seal();
+
+  // Calls |callback| with each record, oldest first within each thread. Must
+  // be called after Seal().
+  void ForEachRecord(
+      const RepeatingCallback<void(const CompactTraceRecord&)>& callback) const;
+
+  // Returns the number of records that ForEachRecord() would visit.
+  size_t Size() const;
+
+  // Computes an estimate of the size of the buffer.
+  void EstimateTraceMemoryOverhead(TraceEventMemoryOverhead* overhead);
+
+ private:
+  class ThreadBuffer;
+
+  // The slot holding a reference to the calling thread's ring, which is
+  // released when the thread exits.
+  static ThreadLocalStorage::Slot& CurrentThreadBuffer();
+  static void ReleaseThreadBuffer(void* thread_buffer);
+
+  const size_t max_chunks_per_thread_;
+
+  // Protects |thread_buffers_| and |sealed_|.
+  mutable Lock lock_;
+  std::vector<scoped_refptr<ThreadBuffer>> thread_buffers_;
+  bool sealed_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompactTraceBuffer);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_COMPACT_TRACE_BUFFER_H_
@@ -0,0 +1,182 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/compact_trace_buffer.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/trace_event/trace_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+const unsigned char kCategoryEnabled = 1;
+
+CompactTraceRecord MakeRecord(unsigned long long id) {
+  CompactTraceRecord record;
+  record.timestamp = TimeTicks::FromInternalValue(id + 1);
+  record.thread_timestamp = ThreadTicks();
+  record.category_group_enabled = &kCategoryEnabled;
+  record.name = "name";
+  record.scope = trace_event_internal::kGlobalScope;
+  record.id = id;
+  record.bind_id = trace_event_internal::kNoId;
+  record.arg_names[0] = "arg";
+  record.arg_types[0] = TRACE_VALUE_TYPE_UINT;
+  record.arg_values[0] = id * 2;
+  record.flags = TRACE_EVENT_FLAG_HAS_ID;
+  record.thread_id = 1;
+  record.phase = TRACE_EVENT_PHASE_INSTANT;
+  record.num_args = 1;
+  return record;
+}
+
+bool AddRecord(CompactTraceBuffer* buffer, const CompactTraceRecord& record) {
+  return CompactTraceBuffer::TryAddRecord(record) ||
+         buffer->AddRecordSlow(record);
+}
+
+std::vector<unsigned long long> GetIds(const CompactTraceBuffer& buffer) {
+  std::vector<unsigned long long> ids;
+  buffer.ForEachRecord(BindRepeating(
+      [](std::vector<unsigned long long>* ids,
+         const CompactTraceRecord& record) { ids->push_back(record.id); },
+      Unretained(&ids)));
+  return ids;
+}
+
+// Adds records with ids from |first_id| until |buffer| is sealed, then
+// signals |done|.
+void AddRecordsUntilSealed(CompactTraceBuffer* buffer,
+                           unsigned long long first_id,
+                           WaitableEvent* started,
+                           WaitableEvent* done) {
+  unsigned long long id = first_id;
+  EXPECT_TRUE(AddRecord(buffer, MakeRecord(id++)));
+  started->Signal();
+  while (AddRecord(buffer, MakeRecord(id++))) {
+  }
+  done->Signal();
+}
+
+}  // namespace
+
+TEST(CompactTraceBufferTest, CanRecord) {
+  const unsigned char kTypes[] = {TRACE_VALUE_TYPE_INT,
+                                  TRACE_VALUE_TYPE_STRING};
+  EXPECT_TRUE(CompactTraceRecord::CanRecord(TRACE_EVENT_FLAG_NONE, 0, kTypes));
+  EXPECT_TRUE(
+      CompactTraceRecord::CanRecord(TRACE_EVENT_FLAG_HAS_ID, 2, kTypes));
+  EXPECT_FALSE(CompactTraceRecord::CanRecord(TRACE_EVENT_FLAG_COPY, 0, kTypes));
+
+  const unsigned char kCopyTypes[] = {TRACE_VALUE_TYPE_INT,
+                                      TRACE_VALUE_TYPE_COPY_STRING};
+  EXPECT_TRUE(
+      CompactTraceRecord::CanRecord(TRACE_EVENT_FLAG_NONE, 1, kCopyTypes));
+  EXPECT_FALSE(
+      CompactTraceRecord::CanRecord(TRACE_EVENT_FLAG_NONE, 2, kCopyTypes));
+
+  const unsigned char kConvertableTypes[] = {TRACE_VALUE_TYPE_CONVERTABLE};
+  EXPECT_FALSE(CompactTraceRecord::CanRecord(TRACE_EVENT_FLAG_NONE, 1,
+                                             kConvertableTypes));
+}
+
+TEST(CompactTraceBufferTest, CopyTo) {
+  const CompactTraceRecord record = MakeRecord(42);
+  TraceEvent trace_event;
+  record.CopyTo(&trace_event);
+  EXPECT_EQ(record.timestamp, trace_event.timestamp());
+  EXPECT_EQ(TRACE_EVENT_PHASE_INSTANT, trace_event.phase());
+  EXPECT_STREQ("name", trace_event.name());
+  EXPECT_EQ(42u, trace_event.id());
+  EXPECT_EQ(TRACE_EVENT_FLAG_HAS_ID, trace_event.flags());
+  EXPECT_EQ(1, trace_event.thread_id());
+  EXPECT_STREQ("arg", trace_event.arg_name(0));
+  EXPECT_EQ(84u, trace_event.arg_value(0).as_uint);
+  EXPECT_EQ(nullptr, trace_event.arg_name(1));
+  EXPECT_EQ(nullptr, trace_event.parameter_copy_storage());
+}
+
+TEST(CompactTraceBufferTest, OverwritesOldestRecords) {
+  CompactTraceBuffer buffer(2);
+  const size_t kNumRecords = CompactTraceBuffer::kRecordsPerChunk * 5 + 3;
+  for (size_t i = 0; i < kNumRecords; ++i)
+    ASSERT_TRUE(AddRecord(&buffer, MakeRecord(i)));
+  EXPECT_EQ(2 * CompactTraceBuffer::kRecordsPerChunk, buffer.Size());
+
+  buffer.Seal();
+  const std::vector<unsigned long long> ids = GetIds(buffer);
+  ASSERT_EQ(2 * CompactTraceBuffer::kRecordsPerChunk, ids.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+    EXPECT_EQ(kNumRecords - ids.size() + i, ids[i]);
+}
+
+TEST(CompactTraceBufferTest, NoRecordsAfterSeal) {
+  auto buffer = std::make_unique<CompactTraceBuffer>(1);
+  EXPECT_TRUE(AddRecord(buffer.get(), MakeRecord(1)));
+  buffer->Seal();
+  EXPECT_FALSE(CompactTraceBuffer::TryAddRecord(MakeRecord(2)));
+  EXPECT_FALSE(buffer->AddRecordSlow(MakeRecord(3)));
+  EXPECT_EQ(std::vector<unsigned long long>({1}), GetIds(*buffer));
+
+  // The next buffer gets a ring of its own.
+  CompactTraceBuffer next_buffer(1);
+  EXPECT_FALSE(CompactTraceBuffer::TryAddRecord(MakeRecord(4)));
+  EXPECT_TRUE(next_buffer.AddRecordSlow(MakeRecord(5)));
+  EXPECT_TRUE(CompactTraceBuffer::TryAddRecord(MakeRecord(6)));
+  buffer.reset();
+  next_buffer.Seal();
+  EXPECT_EQ(std::vector<unsigned long long>({5, 6}), GetIds(next_buffer));
+}
+
+TEST(CompactTraceBufferTest, SealWhileRecordingOnOtherThreads) {
+  const int kNumThreads = 4;
+  const unsigned long long kIdsPerThread = 1ull << 40;
+  CompactTraceBuffer buffer(4);
+  std::unique_ptr<Thread> threads[kNumThreads];
+  std::unique_ptr<WaitableEvent> started[kNumThreads];
+  std::unique_ptr<WaitableEvent> done[kNumThreads];
+  for (int i = 0; i < kNumThreads; i++) {
+    threads[i] = std::make_unique<Thread>("recording thread");
+    threads[i]->Start();
+    started[i] = std::make_unique<WaitableEvent>(
+        WaitableEvent::ResetPolicy::MANUAL,
+        WaitableEvent::InitialState::NOT_SIGNALED);
+    done[i] = std::make_unique<WaitableEvent>(
+        WaitableEvent::ResetPolicy::MANUAL,
+        WaitableEvent::InitialState::NOT_SIGNALED);
+    threads[i]->task_runner()->PostTask(
+        FROM_HERE, BindOnce(&AddRecordsUntilSealed, Unretained(&buffer),
+                            i * kIdsPerThread, Unretained(started[i].get()),
+                            Unretained(done[i].get())));
+  }
+  for (int i = 0; i < kNumThreads; i++)
+    started[i]->Wait();
+
+  buffer.Seal();
+  const std::vector<unsigned long long> ids = GetIds(buffer);
+  EXPECT_EQ(buffer.Size(), ids.size());
+  for (int i = 0; i < kNumThreads; i++)
+    done[i]->Wait();
+  EXPECT_EQ(ids, GetIds(buffer));
+
+  // Each thread's records are consecutive, and the oldest come first.
+  for (size_t i = 1; i < ids.size(); ++i) {
+    if (ids[i] / kIdsPerThread == ids[i - 1] / kIdsPerThread)
+      EXPECT_EQ(ids[i - 1] + 1, ids[i]);
+  }
+
+  for (int i = 0; i < kNumThreads; i++)
+    threads[i]->Stop();
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -65,6 +65,7 @@ const char* const kDumpProviderWhitelist[] = {
 const char* const kAllocatorDumpNameWhitelist[] = {
     "blink_gc",
     "blink_gc/allocated_objects",
+    "blink_gc/compaction",
     "blink_objects/AdSubframe",
     "blink_objects/AudioHandler",
     "blink_objects/DetachedScriptState",
@@ -250,6 +251,7 @@ const char* const kAllocatorDumpNameWhitelist[] = {
     "web_cache/XSL stylesheet_resources",
     "web_cache/Font_resources",
     "web_cache/Other_resources",
+    "web_cache/requests",
     "partition_alloc/allocated_objects",
     "partition_alloc/partitions",
     "partition_alloc/partitions/array_buffer",
@@ -26,6 +26,7 @@ const char kRecordUntilFull[] = "record-until-full";
 const char kRecordContinuously[] = "record-continuously";
 const char kRecordAsMuchAsPossible[] = "record-as-much-as-possible";
 const char kTraceToConsole[] = "trace-to-console";
+const char kRecordCompact[] = "record-compact";
 const char kEnableSystrace[] = "enable-systrace";
 const char kEnableArgumentFilter[] = "enable-argument-filter";
 
@@ -247,6 +248,8 @@ std::string TraceConfig::TraceRecordModeToStr(TraceRecordMode record_mode) {
       return kRecordAsMuchAsPossible;
     case ECHO_TO_CONSOLE:
       return kTraceToConsole;
+    case RECORD_COMPACT:
+      return kRecordCompact;
     default:
       NOTREACHED();
   }
@@ -369,6 +372,8 @@ void TraceConfig::InitializeFromConfigDict(const DictionaryValue& dict) {
       record_mode_ = ECHO_TO_CONSOLE;
     } else if (record_mode == kRecordAsMuchAsPossible) {
       record_mode_ = RECORD_AS_MUCH_AS_POSSIBLE;
+    } else if (record_mode == kRecordCompact) {
+      record_mode_ = RECORD_COMPACT;
     }
   }
   int buffer_size = 0;
@@ -427,6 +432,8 @@ void TraceConfig::InitializeFromStrings(StringPiece category_filter_string,
         record_mode_ = ECHO_TO_CONSOLE;
       } else if (token == kRecordAsMuchAsPossible) {
         record_mode_ = RECORD_AS_MUCH_AS_POSSIBLE;
+      } else if (token == kRecordCompact) {
+        record_mode_ = RECORD_COMPACT;
       } else if (token == kEnableSystrace) {
         enable_systrace_ = true;
       } else if (token == kEnableArgumentFilter) {
@@ -616,6 +623,9 @@ std::string TraceConfig::ToTraceOptionsString() const {
     case ECHO_TO_CONSOLE:
       ret = kTraceToConsole;
       break;
+    case RECORD_COMPACT:
+      ret = kRecordCompact;
+      break;
     default:
       NOTREACHED();
   }
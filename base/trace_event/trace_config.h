@@ -41,6 +41,11 @@ enum TraceRecordMode {
 
   // Echo to console. Events are discarded.
   ECHO_TO_CONSOLE,
+
+  // Record until the user ends the trace, into a fixed size ring buffer per
+  // thread that is appended to without locking. Events that can't be recorded
+  // that way, like those with copied strings, go to a shared ring buffer.
+  RECORD_COMPACT,
 };
 
 class BASE_EXPORT TraceConfig {
@@ -159,9 +164,9 @@ class BASE_EXPORT TraceConfig {
   //
   // |trace_options_string| is a comma-delimited list of trace options.
   // Possible options are: "record-until-full", "record-continuously",
-  // "record-as-much-as-possible", "trace-to-console", "enable-systrace" and
-  // "enable-argument-filter".
-  // The first 4 options are trace recoding modes and hence
+  // "record-as-much-as-possible", "trace-to-console", "record-compact",
+  // "enable-systrace" and "enable-argument-filter".
+  // The first 5 options are trace recoding modes and hence
   // mutually exclusive. If more than one trace recording modes appear in the
   // options_string, the last one takes precedence. If none of the trace
   // recording mode is specified, recording mode is RECORD_UNTIL_FULL.
@@ -110,6 +110,12 @@ TEST(TraceConfigTest, TraceConfigFromValidLegacyFormat) {
   EXPECT_STREQ("record-as-much-as-possible",
                config.ToTraceOptionsString().c_str());
 
+  config = TraceConfig("", "record-compact");
+  EXPECT_EQ(RECORD_COMPACT, config.GetTraceRecordMode());
+  EXPECT_FALSE(config.IsSystraceEnabled());
+  EXPECT_FALSE(config.IsArgumentFilterEnabled());
+  EXPECT_STREQ("record-compact", config.ToTraceOptionsString().c_str());
+
   config = TraceConfig("", "enable-systrace, record-continuously");
   EXPECT_EQ(RECORD_CONTINUOUSLY, config.GetTraceRecordMode());
   EXPECT_TRUE(config.IsSystraceEnabled());
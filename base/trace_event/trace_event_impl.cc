@@ -5,13 +5,16 @@
 #include "base/trace_event/trace_event_impl.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include "base/bit_cast.h"
 #include "base/format_macros.h"
 #include "base/json/string_escape.h"
 #include "base/memory/ptr_util.h"
 #include "base/process/process_handle.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -39,6 +42,113 @@ void CopyTraceEventParameter(char** buffer,
   }
 }
 
+// Field numbers of ChromeEventBundle and ChromeTraceEvent in perfetto's
+// chrome_trace_event.proto.
+enum ProtoField {
+  kBundleTraceEventsField = 1,
+
+  kEventNameField = 1,
+  kEventTimestampField = 2,
+  kEventPhaseField = 3,
+  kEventThreadIdField = 4,
+  kEventDurationField = 5,
+  kEventThreadDurationField = 6,
+  kEventScopeField = 7,
+  kEventIdField = 8,
+  kEventFlagsField = 9,
+  kEventCategoryGroupNameField = 10,
+  kEventProcessIdField = 11,
+  kEventThreadTimestampField = 12,
+  kEventBindIdField = 13,
+  kEventArgsField = 14,
+
+  kArgNameField = 1,
+  kArgBoolValueField = 2,
+  kArgUintValueField = 3,
+  kArgIntValueField = 4,
+  kArgDoubleValueField = 5,
+  kArgStringValueField = 6,
+  kArgPointerValueField = 7,
+  kArgJsonValueField = 8,
+};
+
+enum ProtoWireType {
+  kVarintWireType = 0,
+  kFixed64WireType = 1,
+  kLengthDelimitedWireType = 2,
+};
+
+void AppendProtoVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendProtoTag(ProtoField field, ProtoWireType type, std::string* out) {
+  AppendProtoVarint((static_cast<uint64_t>(field) << 3) | type, out);
+}
+
+// Negative int32 and int64 values are sign extended, like protobuf does.
+void AppendProtoVarintField(ProtoField field,
+                            uint64_t value,
+                            std::string* out) {
+  AppendProtoTag(field, kVarintWireType, out);
+  AppendProtoVarint(value, out);
+}
+
+void AppendProtoFixed64Field(ProtoField field,
+                             uint64_t value,
+                             std::string* out) {
+  AppendProtoTag(field, kFixed64WireType, out);
+  for (int i = 0; i < 8; ++i)
+    out->push_back(static_cast<char>(value >> (i * 8)));
+}
+
+void AppendProtoStringField(ProtoField field,
+                            StringPiece value,
+                            std::string* out) {
+  AppendProtoTag(field, kLengthDelimitedWireType, out);
+  AppendProtoVarint(value.size(), out);
+  value.AppendToString(out);
+}
+
+void AppendValueAsProto(unsigned char type,
+                        TraceEvent::TraceValue value,
+                        std::string* out) {
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      AppendProtoVarintField(kArgBoolValueField, value.as_bool, out);
+      break;
+    case TRACE_VALUE_TYPE_UINT:
+      AppendProtoVarintField(kArgUintValueField, value.as_uint, out);
+      break;
+    case TRACE_VALUE_TYPE_INT:
+      AppendProtoVarintField(kArgIntValueField,
+                             static_cast<uint64_t>(value.as_int), out);
+      break;
+    case TRACE_VALUE_TYPE_DOUBLE:
+      AppendProtoFixed64Field(kArgDoubleValueField,
+                              bit_cast<uint64_t>(value.as_double), out);
+      break;
+    case TRACE_VALUE_TYPE_POINTER:
+      AppendProtoVarintField(
+          kArgPointerValueField,
+          static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value.as_pointer)),
+          out);
+      break;
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING:
+      AppendProtoStringField(kArgStringValueField,
+                             value.as_string ? value.as_string : "NULL", out);
+      break;
+    default:
+      NOTREACHED() << "Don't know how to print this value";
+      break;
+  }
+}
+
 }  // namespace
 
 TraceEvent::TraceEvent()
@@ -423,6 +533,79 @@ void TraceEvent::AppendAsJSON(
   *out += "}";
 }
 
+void TraceEvent::AppendAsProto(
+    std::string* out,
+    const ArgumentFilterPredicate& argument_filter_predicate) const {
+  std::string event;
+  const char* category_group_name =
+      TraceLog::GetCategoryGroupName(category_group_enabled_);
+  AppendProtoStringField(kEventNameField, name_, &event);
+  AppendProtoVarintField(kEventTimestampField, timestamp_.ToInternalValue(),
+                         &event);
+  AppendProtoVarintField(kEventPhaseField, phase_, &event);
+  if ((flags_ & TRACE_EVENT_FLAG_HAS_PROCESS_ID) &&
+      process_id_ != kNullProcessId) {
+    AppendProtoVarintField(kEventProcessIdField, process_id_, &event);
+    AppendProtoVarintField(kEventThreadIdField, static_cast<uint64_t>(-1),
+                           &event);
+  } else {
+    AppendProtoVarintField(kEventProcessIdField,
+                           TraceLog::GetInstance()->process_id(), &event);
+    AppendProtoVarintField(kEventThreadIdField, thread_id_, &event);
+  }
+  if (phase_ == TRACE_EVENT_PHASE_COMPLETE) {
+    if (duration_.ToInternalValue() != -1) {
+      AppendProtoVarintField(kEventDurationField, duration_.ToInternalValue(),
+                             &event);
+    }
+    if (!thread_timestamp_.is_null() &&
+        thread_duration_.ToInternalValue() != -1) {
+      AppendProtoVarintField(kEventThreadDurationField,
+                             thread_duration_.ToInternalValue(), &event);
+    }
+  }
+  if (!thread_timestamp_.is_null()) {
+    AppendProtoVarintField(kEventThreadTimestampField,
+                           thread_timestamp_.ToInternalValue(), &event);
+  }
+  if (scope_ != trace_event_internal::kGlobalScope)
+    AppendProtoStringField(kEventScopeField, scope_, &event);
+  if (flags_ & (TRACE_EVENT_FLAG_HAS_ID | TRACE_EVENT_FLAG_HAS_LOCAL_ID |
+                TRACE_EVENT_FLAG_HAS_GLOBAL_ID)) {
+    AppendProtoVarintField(kEventIdField, id_, &event);
+  }
+  if (flags_ & (TRACE_EVENT_FLAG_FLOW_OUT | TRACE_EVENT_FLAG_FLOW_IN))
+    AppendProtoVarintField(kEventBindIdField, bind_id_, &event);
+  AppendProtoVarintField(kEventFlagsField, flags_, &event);
+  AppendProtoStringField(kEventCategoryGroupNameField, category_group_name,
+                         &event);
+
+  // Like AppendAsJSON(), but stripped arguments are left out.
+  ArgumentNameFilterPredicate argument_name_filter_predicate;
+  bool strip_args =
+      arg_names_[0] && !argument_filter_predicate.is_null() &&
+      !argument_filter_predicate.Run(category_group_name, name_,
+                                     &argument_name_filter_predicate);
+  for (int i = 0; !strip_args && i < kTraceMaxNumArgs && arg_names_[i]; ++i) {
+    if (!argument_name_filter_predicate.is_null() &&
+        !argument_name_filter_predicate.Run(arg_names_[i])) {
+      continue;
+    }
+    std::string arg;
+    AppendProtoStringField(kArgNameField, arg_names_[i], &arg);
+    if (arg_types_[i] == TRACE_VALUE_TYPE_CONVERTABLE) {
+      std::string json;
+      convertable_values_[i]->AppendAsTraceFormat(&json);
+      AppendProtoStringField(kArgJsonValueField, json, &arg);
+    } else {
+      AppendValueAsProto(arg_types_[i], arg_values_[i], &arg);
+    }
+    AppendProtoStringField(kEventArgsField, arg, &event);
+  }
+
+  AppendProtoStringField(kBundleTraceEventsField, event, out);
+}
+
 void TraceEvent::AppendPrettyPrinted(std::ostringstream* out) const {
   *out << name_ << "[";
   *out << TraceLog::GetCategoryGroupName(category_group_enabled_);
@@ -114,6 +114,11 @@ class BASE_EXPORT TraceEvent {
   void AppendAsJSON(
       std::string* out,
       const ArgumentFilterPredicate& argument_filter_predicate) const;
+  // Serialize event data as a ChromeEventBundle proto holding a single
+  // ChromeTraceEvent. Concatenated bundles parse as one bundle.
+  void AppendAsProto(
+      std::string* out,
+      const ArgumentFilterPredicate& argument_filter_predicate) const;
   void AppendPrettyPrinted(std::ostringstream* out) const;
 
   static void AppendValueAsJSON(unsigned char type,
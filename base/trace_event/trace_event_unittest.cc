@@ -2714,6 +2714,147 @@ TEST_F(TraceEventTestFixture, TraceRecordAsMuchAsPossibleMode) {
   TraceLog::GetInstance()->SetDisabled();
 }
 
+TEST_F(TraceEventTestFixture, TraceRecordCompactMode) {
+  TraceLog::GetInstance()->SetEnabled(
+      TraceConfig(kRecordAllCategoryFilter, RECORD_COMPACT),
+      TraceLog::RECORDING_MODE);
+  {
+    TRACE_EVENT0("category", "compact");
+    TRACE_EVENT_INSTANT1("category", "instant", TRACE_EVENT_SCOPE_THREAD, "a",
+                         "b");
+    std::string copied_name = "copied";
+    TRACE_EVENT_COPY_INSTANT0("category", copied_name.c_str(),
+                              TRACE_EVENT_SCOPE_THREAD);
+  }
+  Thread thread("compact");
+  thread.Start();
+  thread.task_runner()->PostTask(FROM_HERE, BindOnce([]() {
+                                   TRACE_EVENT_INSTANT0(
+                                       "category", "other thread",
+                                       TRACE_EVENT_SCOPE_THREAD);
+                                 }));
+  thread.Stop();
+  EndTraceAndFlush();
+
+  // Compact COMPLETE events are recorded as BEGIN and END pairs.
+  EXPECT_FALSE(FindNamePhase("compact", "X"));
+  EXPECT_TRUE(FindNamePhase("compact", "B"));
+  EXPECT_TRUE(FindNamePhase("compact", "E"));
+  EXPECT_TRUE(FindNamePhaseKeyValue("instant", "I", "a", "b"));
+  EXPECT_TRUE(FindNamePhase("copied", "I"));
+  EXPECT_TRUE(FindNamePhase("other thread", "I"));
+}
+
+namespace {
+
+void AppendTraceData(std::string* out,
+                     WaitableEvent* flush_complete_event,
+                     const scoped_refptr<RefCountedString>& events_str,
+                     bool has_more_events) {
+  out->append(events_str->data());
+  if (!has_more_events)
+    flush_complete_event->Signal();
+}
+
+bool ReadVarint(const std::string& data, size_t* pos, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; *pos < data.size() && shift < 64; shift += 7) {
+    uint8_t byte = static_cast<uint8_t>(data[(*pos)++]);
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+// Returns the name and phase of each ChromeTraceEvent in a ChromeEventBundle,
+// or nothing if |bundle| can't be parsed.
+std::vector<std::pair<std::string, char>> ParseTraceEventBundle(
+    const std::string& bundle) {
+  std::vector<std::pair<std::string, char>> events;
+  size_t pos = 0;
+  while (pos < bundle.size()) {
+    uint64_t tag;
+    uint64_t size;
+    if (!ReadVarint(bundle, &pos, &tag) || tag != ((1 << 3) | 2) ||
+        !ReadVarint(bundle, &pos, &size) || size > bundle.size() - pos) {
+      return {};
+    }
+    const std::string event = bundle.substr(pos, size);
+    pos += size;
+
+    std::pair<std::string, char> name_and_phase;
+    size_t event_pos = 0;
+    while (event_pos < event.size()) {
+      uint64_t value;
+      if (!ReadVarint(event, &event_pos, &tag))
+        return {};
+      switch (tag & 7) {
+        case 0:
+          if (!ReadVarint(event, &event_pos, &value))
+            return {};
+          if (tag >> 3 == 3)
+            name_and_phase.second = static_cast<char>(value);
+          break;
+        case 1:
+          event_pos += 8;
+          break;
+        case 2:
+          if (!ReadVarint(event, &event_pos, &value) ||
+              value > event.size() - event_pos) {
+            return {};
+          }
+          if (tag >> 3 == 1)
+            name_and_phase.first = event.substr(event_pos, value);
+          event_pos += value;
+          break;
+        default:
+          return {};
+      }
+    }
+    if (event_pos != event.size())
+      return {};
+    events.push_back(name_and_phase);
+  }
+  return events;
+}
+
+}  // namespace
+
+TEST_F(TraceEventTestFixture, FlushAsProto) {
+  TraceLog::GetInstance()->SetEnabled(
+      TraceConfig(kRecordAllCategoryFilter, RECORD_COMPACT),
+      TraceLog::RECORDING_MODE);
+  {
+    TRACE_EVENT1("category", "compact", "a", 1.5);
+    std::string copied_name = "copied";
+    TRACE_EVENT_COPY_INSTANT1("category", copied_name.c_str(),
+                              TRACE_EVENT_SCOPE_THREAD, "b", "string");
+  }
+  TraceLog::GetInstance()->SetDisabled();
+
+  std::string bundle;
+  WaitableEvent flush_complete_event(
+      WaitableEvent::ResetPolicy::AUTOMATIC,
+      WaitableEvent::InitialState::NOT_SIGNALED);
+  TraceLog::GetInstance()->FlushAsProto(
+      BindRepeating(&AppendTraceData, Unretained(&bundle),
+                    Unretained(&flush_complete_event)));
+  flush_complete_event.Wait();
+
+  const std::vector<std::pair<std::string, char>> events =
+      ParseTraceEventBundle(bundle);
+  ASSERT_FALSE(events.empty());
+  const std::string kCompact = "compact";
+  const std::string kCopied = "copied";
+  EXPECT_TRUE(ContainsValue(
+      events, std::make_pair(kCompact, char{TRACE_EVENT_PHASE_BEGIN})));
+  EXPECT_TRUE(ContainsValue(
+      events, std::make_pair(kCompact, char{TRACE_EVENT_PHASE_END})));
+  EXPECT_TRUE(ContainsValue(
+      events, std::make_pair(kCopied, char{TRACE_EVENT_PHASE_INSTANT})));
+}
+
 TEST_F(TraceEventTestFixture, ConfigTraceBufferLimit) {
   const size_t kLimit = 2048;
   TraceConfig config(kRecordAllCategoryFilter, RECORD_UNTIL_FULL);
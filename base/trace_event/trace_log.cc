@@ -35,6 +35,7 @@
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "base/trace_event/category_registry.h"
+#include "base/trace_event/compact_trace_buffer.h"
 #include "base/trace_event/event_name_filter.h"
 #include "base/trace_event/heap_profiler.h"
 #include "base/trace_event/heap_profiler_allocation_context_tracker.h"
@@ -79,6 +80,17 @@ const size_t kTraceEventRingBufferChunks = kTraceEventVectorBufferChunks / 4;
 // ECHO_TO_CONSOLE needs a small buffer to hold the unfinished COMPLETE events.
 const size_t kEchoToConsoleTraceEventBufferChunks = 256;
 
+// RECORD_COMPACT keeps the last 4096 compact events of each thread. Its ring
+// buffer only holds the events that can't be recorded compactly.
+const size_t kCompactTraceEventChunksPerThread = 16;
+const size_t kCompactTraceEventRingBufferChunks =
+    kTraceEventRingBufferChunks / 4;
+
+// The handle of a COMPLETE event recorded compactly, whose end is recorded as
+// a separate END event. No TraceBuffer has that many chunks.
+const TraceEventHandle kCompactTraceEventHandle = {
+    0, TraceBufferChunk::kMaxChunkIndex, 0};
+
 const size_t kTraceEventBufferSizeInBytes = 100 * 1024;
 const int kThreadFlushTimeoutMs = 3000;
 
@@ -374,6 +386,7 @@ TraceLog::TraceLog()
       thread_shared_chunk_index_(0),
       generation_(0),
       use_worker_thread_(false),
+      flush_as_proto_(false),
       trace_event_override_(0),
       on_flush_callback_(0),
       filter_factory_for_testing_(nullptr) {
@@ -434,6 +447,8 @@ bool TraceLog::OnMemoryDump(const MemoryDumpArgs& args,
     AutoLock lock(lock_);
     if (logged_events_)
       logged_events_->EstimateTraceMemoryOverhead(&overhead);
+    if (compact_events_)
+      compact_events_->EstimateTraceMemoryOverhead(&overhead);
 
     for (auto& metadata_event : metadata_events_)
       metadata_event->EstimateTraceMemoryOverhead(&overhead);
@@ -679,6 +694,8 @@ TraceLog::InternalTraceOptions TraceLog::GetInternalOptionsFromTraceConfig(
       return ret | kInternalEchoToConsole;
     case RECORD_AS_MUCH_AS_POSSIBLE:
       return ret | kInternalRecordAsMuchAsPossible;
+    case RECORD_COMPACT:
+      return ret | kInternalRecordCompact;
   }
   NOTREACHED();
   return kInternalNone;
@@ -851,18 +868,25 @@ void TraceLog::CheckIfBufferIsFullWhileLocked() {
 // 4. If any thread hasn't finish its flush in time, finish the flush.
 void TraceLog::Flush(const TraceLog::OutputCallback& cb,
                      bool use_worker_thread) {
-  FlushInternal(cb, use_worker_thread, false);
+  FlushInternal(cb, use_worker_thread, false, false);
+}
+
+void TraceLog::FlushAsProto(const TraceLog::OutputCallback& cb,
+                            bool use_worker_thread) {
+  FlushInternal(cb, use_worker_thread, false, true);
 }
 
 void TraceLog::CancelTracing(const OutputCallback& cb) {
   SetDisabled();
-  FlushInternal(cb, false, true);
+  FlushInternal(cb, false, true, false);
 }
 
 void TraceLog::FlushInternal(const TraceLog::OutputCallback& cb,
                              bool use_worker_thread,
-                             bool discard_events) {
+                             bool discard_events,
+                             bool as_proto) {
   use_worker_thread_ = use_worker_thread;
+  flush_as_proto_ = as_proto;
   if (IsEnabled()) {
     // Can't flush when tracing is enabled because otherwise PostTask would
     // - generate more trace events;
@@ -914,39 +938,89 @@ void TraceLog::FlushInternal(const TraceLog::OutputCallback& cb,
   FinishFlush(gen, discard_events);
 }
 
+// Serializes trace events into strings of about kTraceEventBufferSizeInBytes
+// for the output callback of a flush.
+class TraceLog::TraceFormatWriter {
+ public:
+  TraceFormatWriter(bool as_proto,
+                    const OutputCallback& flush_output_callback,
+                    const ArgumentFilterPredicate& argument_filter_predicate)
+      : as_proto_(as_proto),
+        flush_output_callback_(flush_output_callback),
+        argument_filter_predicate_(argument_filter_predicate) {
+    StartString();
+  }
+
+  void AppendEvent(const TraceEvent& trace_event) {
+    size_t size = events_str_ptr_->size();
+    if (size > kTraceEventBufferSizeInBytes) {
+      flush_output_callback_.Run(events_str_ptr_, true);
+      StartString();
+    } else if (size && !as_proto_) {
+      events_str_ptr_->data().append(",\n");
+    }
+    if (as_proto_) {
+      trace_event.AppendAsProto(&events_str_ptr_->data(),
+                                argument_filter_predicate_);
+    } else {
+      trace_event.AppendAsJSON(&events_str_ptr_->data(),
+                               argument_filter_predicate_);
+    }
+  }
+
+  void AppendRecord(const CompactTraceRecord& record) {
+    TraceEvent trace_event;
+    record.CopyTo(&trace_event);
+    AppendEvent(trace_event);
+  }
+
+  // The callback need to be called at least once even if there is no events
+  // to let the caller know the completion of flush.
+  void Finish() { flush_output_callback_.Run(events_str_ptr_, false); }
+
+ private:
+  void StartString() {
+    const size_t kReserveCapacity = kTraceEventBufferSizeInBytes * 5 / 4;
+    events_str_ptr_ = new RefCountedString();
+    events_str_ptr_->data().reserve(kReserveCapacity);
+  }
+
+  const bool as_proto_;
+  const OutputCallback& flush_output_callback_;
+  const ArgumentFilterPredicate& argument_filter_predicate_;
+  scoped_refptr<RefCountedString> events_str_ptr_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceFormatWriter);
+};
+
 // Usually it runs on a different thread.
 void TraceLog::ConvertTraceEventsToTraceFormat(
     std::unique_ptr<TraceBuffer> logged_events,
+    std::unique_ptr<CompactTraceBuffer> compact_events,
+    bool as_proto,
     const OutputCallback& flush_output_callback,
     const ArgumentFilterPredicate& argument_filter_predicate) {
   if (flush_output_callback.is_null())
     return;
 
   HEAP_PROFILER_SCOPED_IGNORE;
-  // The callback need to be called at least once even if there is no events
-  // to let the caller know the completion of flush.
-  scoped_refptr<RefCountedString> json_events_str_ptr = new RefCountedString();
-  const size_t kReserveCapacity = kTraceEventBufferSizeInBytes * 5 / 4;
-  json_events_str_ptr->data().reserve(kReserveCapacity);
+  TraceFormatWriter writer(as_proto, flush_output_callback,
+                           argument_filter_predicate);
   while (const TraceBufferChunk* chunk = logged_events->NextChunk()) {
-    for (size_t j = 0; j < chunk->size(); ++j) {
-      size_t size = json_events_str_ptr->size();
-      if (size > kTraceEventBufferSizeInBytes) {
-        flush_output_callback.Run(json_events_str_ptr, true);
-        json_events_str_ptr = new RefCountedString();
-        json_events_str_ptr->data().reserve(kReserveCapacity);
-      } else if (size) {
-        json_events_str_ptr->data().append(",\n");
-      }
-      chunk->GetEventAt(j)->AppendAsJSON(&(json_events_str_ptr->data()),
-                                         argument_filter_predicate);
-    }
+    for (size_t j = 0; j < chunk->size(); ++j)
+      writer.AppendEvent(*chunk->GetEventAt(j));
+  }
+  if (compact_events) {
+    compact_events->Seal();
+    compact_events->ForEachRecord(BindRepeating(
+        &TraceFormatWriter::AppendRecord, Unretained(&writer)));
   }
-  flush_output_callback.Run(json_events_str_ptr, false);
+  writer.Finish();
 }
 
 void TraceLog::FinishFlush(int generation, bool discard_events) {
   std::unique_ptr<TraceBuffer> previous_logged_events;
+  std::unique_ptr<CompactTraceBuffer> previous_compact_events;
   OutputCallback flush_output_callback;
   ArgumentFilterPredicate argument_filter_predicate;
 
@@ -957,6 +1031,7 @@ void TraceLog::FinishFlush(int generation, bool discard_events) {
     AutoLock lock(lock_);
 
     previous_logged_events.swap(logged_events_);
+    previous_compact_events.swap(compact_events_);
     UseNextTraceBuffer();
     thread_message_loops_.clear();
 
@@ -984,13 +1059,15 @@ void TraceLog::FinishFlush(int generation, bool discard_events) {
         {MayBlock(), TaskPriority::BEST_EFFORT,
          TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
         BindOnce(&TraceLog::ConvertTraceEventsToTraceFormat,
-                 std::move(previous_logged_events), flush_output_callback,
-                 argument_filter_predicate));
+                 std::move(previous_logged_events),
+                 std::move(previous_compact_events), flush_as_proto_,
+                 flush_output_callback, argument_filter_predicate));
     return;
   }
 
   ConvertTraceEventsToTraceFormat(std::move(previous_logged_events),
-                                  flush_output_callback,
+                                  std::move(previous_compact_events),
+                                  flush_as_proto_, flush_output_callback,
                                   argument_filter_predicate);
 }
 
@@ -1054,6 +1131,11 @@ void TraceLog::OnFlushTimeout(int generation, bool discard_events) {
 
 void TraceLog::UseNextTraceBuffer() {
   logged_events_.reset(CreateTraceBuffer());
+  // Seals the previous buffer, so that threads stop recording into it.
+  compact_events_.reset(
+      trace_options() & kInternalRecordCompact
+          ? new CompactTraceBuffer(kCompactTraceEventChunksPerThread)
+          : nullptr);
   subtle::NoBarrier_AtomicIncrement(&generation_, 1);
   thread_shared_chunk_.reset();
   thread_shared_chunk_index_ = 0;
@@ -1226,8 +1308,15 @@ TraceEventHandle TraceLog::AddTraceEventWithThreadIdAndTimestamp(
   TimeTicks offset_event_timestamp = OffsetTimestamp(timestamp);
   ThreadTicks thread_now = ThreadNow();
 
+  // Compact events go to the thread's own CompactTraceBuffer ring, so the
+  // other events, which are rare, don't need a thread local buffer.
+  const bool record_compact =
+      (trace_options() & kInternalRecordCompact) &&
+      CompactTraceRecord::CanRecord(flags, num_args, arg_types);
+
   ThreadLocalEventBuffer* thread_local_event_buffer = nullptr;
-  if (*category_group_enabled & RECORDING_MODE) {
+  if ((*category_group_enabled & RECORDING_MODE) &&
+      !(trace_options() & kInternalRecordCompact)) {
     // |thread_local_event_buffer_| can be null if the current thread doesn't
     // have a message loop or the message loop is blocked.
     InitializeThreadLocalEventBufferIfSupported();
@@ -1321,6 +1410,35 @@ TraceEventHandle TraceLog::AddTraceEventWithThreadIdAndTimestamp(
 
   // If enabled for recording, the event should be added only if one of the
   // filters indicates or category is not enabled for filtering.
+  if ((*category_group_enabled & TraceCategory::ENABLED_FOR_RECORDING) &&
+      !disabled_by_filters && record_compact) {
+    CompactTraceRecord record;
+    record.timestamp = offset_event_timestamp;
+    record.thread_timestamp = thread_now;
+    record.category_group_enabled = category_group_enabled;
+    record.name = name;
+    record.scope = scope;
+    record.id = id;
+    record.bind_id = bind_id;
+    for (int i = 0; i < num_args; ++i) {
+      record.arg_names[i] = arg_names[i];
+      record.arg_types[i] = arg_types[i];
+      record.arg_values[i] = arg_values[i];
+    }
+    record.flags = flags;
+    record.thread_id = thread_id;
+    // Like with |trace_event_override|, the duration of COMPLETE events isn't
+    // updated. A separate END event is recorded instead.
+    record.phase =
+        phase == TRACE_EVENT_PHASE_COMPLETE ? TRACE_EVENT_PHASE_BEGIN : phase;
+    record.num_args = static_cast<unsigned char>(num_args);
+
+    AddCompactRecord(record);
+    if (phase == TRACE_EVENT_PHASE_COMPLETE)
+      handle = kCompactTraceEventHandle;
+    return handle;
+  }
+
   if ((*category_group_enabled & TraceCategory::ENABLED_FOR_RECORDING) &&
       !disabled_by_filters) {
     OptionalAutoLock lock(&lock_);
@@ -1505,6 +1623,26 @@ void TraceLog::UpdateTraceEventDurationExplicit(
       return;
     }
 
+    if (handle.chunk_index == kCompactTraceEventHandle.chunk_index) {
+      CompactTraceRecord record;
+      record.timestamp = now;
+      record.thread_timestamp = thread_now;
+      record.category_group_enabled = category_group_enabled;
+      record.name = name;
+      record.scope = trace_event_internal::kGlobalScope;
+      record.id = trace_event_internal::kNoId;
+      record.bind_id = trace_event_internal::kNoId;
+      record.flags = TRACE_EVENT_FLAG_NONE;
+      record.thread_id = static_cast<int>(PlatformThread::CurrentId());
+      record.phase = TRACE_EVENT_PHASE_END;
+      record.num_args = 0;
+      AddCompactRecord(record);
+
+      if (category_group_enabled_local & TraceCategory::ENABLED_FOR_FILTERING)
+        EndFilteredEvent(category_group_enabled, name, handle);
+      return;
+    }
+
     OptionalAutoLock lock(&lock_);
 
     TraceEvent* trace_event = GetEventByHandleInternal(handle, &lock);
@@ -1541,6 +1679,16 @@ void TraceLog::UpdateTraceEventDurationExplicit(
     EndFilteredEvent(category_group_enabled, name, handle);
 }
 
+void TraceLog::AddCompactRecord(const CompactTraceRecord& record) {
+  if (CompactTraceBuffer::TryAddRecord(record))
+    return;
+  // This is the first compact event of the thread in this trace. The lock
+  // keeps |compact_events_| alive.
+  AutoLock lock(lock_);
+  if (compact_events_)
+    compact_events_->AddRecordSlow(record);
+}
+
 uint64_t TraceLog::MangleEventId(uint64_t id) {
   return id ^ process_id_hash_;
 }
@@ -1741,6 +1889,11 @@ TraceBuffer* TraceLog::CreateTraceBuffer() {
         config_buffer_chunks > 0 ? config_buffer_chunks
                                  : kEchoToConsoleTraceEventBufferChunks);
   }
+  if (options & kInternalRecordCompact) {
+    return TraceBuffer::CreateTraceBufferRingBuffer(
+        config_buffer_chunks > 0 ? config_buffer_chunks
+                                 : kCompactTraceEventRingBufferChunks);
+  }
   if (options & kInternalRecordAsMuchAsPossible) {
     return TraceBuffer::CreateTraceBufferVectorOfSize(
         config_buffer_chunks > 0 ? config_buffer_chunks
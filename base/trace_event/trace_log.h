@@ -10,10 +10,10 @@
 
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/atomicops.h"
+#include "base/containers/flat_hash_map.h"
 #include "base/containers/stack.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
@@ -34,6 +34,8 @@ class NoDestructor;
 namespace trace_event {
 
 struct TraceCategory;
+class CompactTraceBuffer;
+struct CompactTraceRecord;
 class TraceBuffer;
 class TraceBufferChunk;
 class TraceEvent;
@@ -180,6 +182,11 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
                               bool has_more_events)> OutputCallback;
   void Flush(const OutputCallback& cb, bool use_worker_thread = false);
 
+  // Like Flush(), but the strings are serialized ChromeEventBundle protos
+  // (see perfetto's chrome_trace_event.proto), which can be concatenated.
+  // This skips the cost of formatting and parsing JSON.
+  void FlushAsProto(const OutputCallback& cb, bool use_worker_thread = false);
+
   // Cancels tracing and discards collected data.
   void CancelTracing(const OutputCallback& cb);
 
@@ -397,6 +404,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
 
   class ThreadLocalEventBuffer;
   class OptionalAutoLock;
+  class TraceFormatWriter;
   struct RegisteredAsyncObserver;
 
   TraceLog();
@@ -423,6 +431,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   TraceEvent* AddEventToThreadSharedChunkWhileLocked(TraceEventHandle* handle,
                                                      bool check_buffer_is_full);
   void CheckIfBufferIsFullWhileLocked();
+  void AddCompactRecord(const CompactTraceRecord& record);
   void SetDisabledWhileLocked(uint8_t modes);
 
   TraceEvent* GetEventByHandleInternal(TraceEventHandle handle,
@@ -430,7 +439,8 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
 
   void FlushInternal(const OutputCallback& cb,
                      bool use_worker_thread,
-                     bool discard_events);
+                     bool discard_events,
+                     bool as_proto);
 
   // |generation| is used in the following callbacks to check if the callback
   // is called for the flush of the current |logged_events_|.
@@ -438,6 +448,8 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   // Usually it runs on a different thread.
   static void ConvertTraceEventsToTraceFormat(
       std::unique_ptr<TraceBuffer> logged_events,
+      std::unique_ptr<CompactTraceBuffer> compact_events,
+      bool as_proto,
       const TraceLog::OutputCallback& flush_output_callback,
       const ArgumentFilterPredicate& argument_filter_predicate);
   void FinishFlush(int generation, bool discard_events);
@@ -467,6 +479,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   static const InternalTraceOptions kInternalEchoToConsole;
   static const InternalTraceOptions kInternalRecordAsMuchAsPossible;
   static const InternalTraceOptions kInternalEnableArgumentFilter;
+  static const InternalTraceOptions kInternalRecordCompact;
 
   // This lock protects TraceLog member accesses (except for members protected
   // by thread_info_lock_) from arbitrary threads.
@@ -477,6 +490,9 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   uint8_t enabled_modes_;  // See TraceLog::Mode.
   int num_traces_recorded_;
   std::unique_ptr<TraceBuffer> logged_events_;
+  // Only used with RECORD_COMPACT, for the events that CompactTraceRecord can
+  // hold. The others are added to |logged_events_|.
+  std::unique_ptr<CompactTraceBuffer> compact_events_;
   std::vector<std::unique_ptr<TraceEvent>> metadata_events_;
   bool dispatching_to_observer_list_;
   std::vector<EnabledStateObserver*> enabled_state_observer_list_;
@@ -488,15 +504,15 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
       owned_enabled_state_observer_copy_;
 
   std::string process_name_;
-  std::unordered_map<int, std::string> process_labels_;
+  base::flat_hash_map<int, std::string> process_labels_;
   int process_sort_index_;
-  std::unordered_map<int, int> thread_sort_indices_;
-  std::unordered_map<int, std::string> thread_names_;
+  base::flat_hash_map<int, int> thread_sort_indices_;
+  base::flat_hash_map<int, std::string> thread_names_;
   base::Time process_creation_time_;
 
   // The following two maps are used only when ECHO_TO_CONSOLE.
-  std::unordered_map<int, base::stack<TimeTicks>> thread_event_start_times_;
-  std::unordered_map<std::string, int> thread_colors_;
+  base::flat_hash_map<int, base::stack<TimeTicks>> thread_event_start_times_;
+  base::flat_hash_map<std::string, int> thread_colors_;
 
   TimeTicks buffer_limit_reached_timestamp_;
 
@@ -532,6 +548,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   ArgumentFilterPredicate argument_filter_predicate_;
   subtle::AtomicWord generation_;
   bool use_worker_thread_;
+  bool flush_as_proto_;
   subtle::AtomicWord trace_event_override_;
   subtle::AtomicWord on_flush_callback_;
 
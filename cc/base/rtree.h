@@ -250,10 +250,10 @@ auto RTree<T>::BuildRecursive(std::vector<Branch<T>>* branches, int level)
       }
       Node<T>* node = AllocateNodeAtLevel(level);
       node->num_children = 1;
-      node->children[0] = (*branches)[current_branch];
+      node->children[0] = std::move((*branches)[current_branch]);
 
       Branch<T> branch;
-      branch.bounds = (*branches)[current_branch].bounds;
+      branch.bounds = node->children[0].bounds;
       branch.subtree = node;
       ++current_branch;
       int x = branch.bounds.x();
@@ -271,7 +271,7 @@ auto RTree<T>::BuildRecursive(std::vector<Branch<T>>* branches, int level)
         right = std::max(right, bounds.right());
         bottom = std::max(bottom, bounds.bottom());
 
-        node->children[k] = (*branches)[current_branch];
+        node->children[k] = std::move((*branches)[current_branch]);
         ++node->num_children;
         ++current_branch;
       }
@@ -440,7 +440,10 @@ void DiscardableImageMap::Generate(const PaintOpBuffer* paint_op_buffer,
       [](const std::vector<std::pair<DrawImage, gfx::Rect>>& items,
          size_t index) { return items[index].second; },
       [](const std::vector<std::pair<DrawImage, gfx::Rect>>& items,
-         size_t index) { return items[index].first; });
+         size_t index) { return index; });
+  images_.reserve(images.size());
+  for (auto& image : images)
+    images_.push_back(std::move(image.first));
 }
 
 base::flat_map<PaintImage::Id, PaintImage::DecodingMode>
@@ -451,7 +454,11 @@ DiscardableImageMap::TakeDecodingModeMap() {
 void DiscardableImageMap::GetDiscardableImagesInRect(
     const gfx::Rect& rect,
     std::vector<const DrawImage*>* images) const {
-  *images = images_rtree_.SearchRefs(rect);
+  std::vector<size_t> indices = images_rtree_.Search(rect);
+  images->clear();
+  images->reserve(indices.size());
+  for (size_t index : indices)
+    images->push_back(&images_[index]);
 }
 
 const DiscardableImageMap::Rects& DiscardableImageMap::GetRectsForImage(
@@ -464,6 +471,8 @@ const DiscardableImageMap::Rects& DiscardableImageMap::GetRectsForImage(
 void DiscardableImageMap::Reset() {
   image_id_to_rects_.clear();
   image_id_to_rects_.shrink_to_fit();
+  images_.clear();
+  images_.shrink_to_fit();
   images_rtree_.Reset();
 }
 
@@ -85,7 +85,10 @@ class CC_PAINT_EXPORT DiscardableImageMap {
   base::flat_map<PaintImage::Id, PaintImage::DecodingMode> decoding_mode_map_;
   bool all_images_are_srgb_ = false;
 
-  RTree<DrawImage> images_rtree_;
+  // The rtree indexes into |images_| so that its nodes stay small and building
+  // it doesn't copy every DrawImage.
+  std::vector<DrawImage> images_;
+  RTree<size_t> images_rtree_;
 };
 
 }  // namespace cc
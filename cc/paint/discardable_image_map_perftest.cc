@@ -0,0 +1,103 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/discardable_image_map.h"
+
+#include <cmath>
+
+#include "cc/base/lap_timer.h"
+#include "cc/paint/paint_op_buffer.h"
+#include "cc/test/skia_common.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+// Images laid out in a grid of |kImageSize| cells, like a photo gallery.
+static const int kImageSize = 64;
+
+class DiscardableImageMapPerfTest : public testing::Test {
+ public:
+  DiscardableImageMapPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  void BuildBuffer(int image_count) {
+    buffer_.Reset();
+    columns_ = std::sqrt(image_count);
+    for (int i = 0; i < image_count; ++i) {
+      buffer_.push<DrawImageOp>(
+          CreateDiscardablePaintImage(gfx::Size(kImageSize, kImageSize)),
+          static_cast<SkScalar>((i % columns_) * kImageSize),
+          static_cast<SkScalar>((i / columns_) * kImageSize), nullptr);
+    }
+    bounds_ = gfx::Rect(columns_ * kImageSize,
+                        (image_count / columns_ + 1) * kImageSize);
+  }
+
+  void RunGenerateTest(const std::string& test_name, int image_count) {
+    BuildBuffer(image_count);
+
+    timer_.Reset();
+    do {
+      DiscardableImageMap image_map;
+      image_map.Generate(&buffer_, bounds_);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("discardable_image_map_generate", "", test_name,
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+  void RunSearchTest(const std::string& test_name, int image_count) {
+    BuildBuffer(image_count);
+    DiscardableImageMap image_map;
+    image_map.Generate(&buffer_, bounds_);
+
+    // Tile sized queries walking across the content.
+    const int kTileSize = 256;
+    std::vector<gfx::Rect> queries;
+    for (int y = 0; y < bounds_.height(); y += kTileSize) {
+      for (int x = 0; x < bounds_.width(); x += kTileSize)
+        queries.push_back(gfx::Rect(x, y, kTileSize, kTileSize));
+    }
+    size_t query_index = 0;
+
+    std::vector<const DrawImage*> images;
+    timer_.Reset();
+    do {
+      image_map.GetDiscardableImagesInRect(queries[query_index], &images);
+      query_index = (query_index + 1) % queries.size();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("discardable_image_map_search", "", test_name,
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+ protected:
+  LapTimer timer_;
+  PaintOpBuffer buffer_;
+  gfx::Rect bounds_;
+  int columns_ = 0;
+};
+
+TEST_F(DiscardableImageMapPerfTest, Generate) {
+  RunGenerateTest("1000", 1000);
+  RunGenerateTest("10_000", 10000);
+}
+
+TEST_F(DiscardableImageMapPerfTest, Search) {
+  RunSearchTest("1000", 1000);
+  RunSearchTest("10_000", 10000);
+}
+
+}  // namespace
+}  // namespace cc
@@ -1969,6 +1969,12 @@ bool PaintOp::QuickRejectDraw(const PaintOp* op, const SkCanvas* canvas) {
   if (!PaintOp::GetBounds(op, &rect))
     return false;
 
+  // Inverse fills paint everything outside of the path's bounds.
+  if (op->GetType() == PaintOpType::DrawPath &&
+      static_cast<const DrawPathOp*>(op)->path.isInverseFillType()) {
+    return false;
+  }
+
   if (op->IsPaintOpWithFlags()) {
     SkPaint paint = static_cast<const PaintOpWithFlags*>(op)->flags.ToSkPaint();
     if (!paint.canComputeFastBounds())
@@ -56,6 +56,24 @@ SkTextBlobCacheDiffCanvas::Settings MakeCanvasSettings(
   return settings;
 }
 
+// Whether serializing |op| sends more than its inline data: decoded images,
+// glyphs for the strike server, path transfer cache entries or shaders. These
+// are worth a quick reject against the clip even when the op would be cheap to
+// play back.
+bool HasOutOfLineData(const PaintOp* op) {
+  if (PaintOp::OpHasDiscardableImages(op))
+    return true;
+  switch (op->GetType()) {
+    case PaintOpType::DrawPath:
+    case PaintOpType::DrawTextBlob:
+      return true;
+    default:
+      break;
+  }
+  return op->IsPaintOpWithFlags() &&
+         static_cast<const PaintOpWithFlags*>(op)->flags.HasShader();
+}
+
 // Use half of the max int as the extent for the SkNoDrawCanvas. The correct
 // clip is applied to the canvas during serialization.
 const int kMaxExtent = std::numeric_limits<int>::max() >> 1;
@@ -286,10 +304,11 @@ void PaintOpBufferSerializer::SerializeBuffer(
        ++iter) {
     const PaintOp* op = *iter;
 
-    // Skip ops outside the current clip if they have images. This saves
-    // performing an unnecessary expensive decode.
-    const bool skip_op = PaintOp::OpHasDiscardableImages(op) &&
-                         PaintOp::QuickRejectDraw(op, canvas_);
+    // Skip ops outside the current clip if they have images, glyphs or other
+    // out of line data. This saves performing an unnecessary expensive decode
+    // and sending resources that will never be rastered.
+    const bool skip_op =
+        HasOutOfLineData(op) && PaintOp::QuickRejectDraw(op, canvas_);
     if (skip_op)
       continue;
 
@@ -2231,6 +2231,103 @@ TEST(PaintOpBufferTest, ClipsImagesDuringSerialization) {
   }
 }
 
+TEST(PaintOpBufferTest, SkipsPathsOutsideClipDuringSerialization) {
+  PaintOpBuffer buffer;
+  SkPath path;
+  path.addCircle(500, 500, 10);
+  buffer.push<DrawPathOp>(path, PaintFlags());
+  path.reset();
+  path.addCircle(50, 50, 10);
+  buffer.push<DrawPathOp>(path, PaintFlags());
+
+  std::unique_ptr<char, base::AlignedFreeDeleter> memory(
+      static_cast<char*>(base::AlignedAlloc(PaintOpBuffer::kInitialBufferSize,
+                                            PaintOpBuffer::PaintOpAlign)));
+  TestOptionsProvider options_provider;
+  SimpleBufferSerializer serializer(
+      memory.get(), PaintOpBuffer::kInitialBufferSize,
+      options_provider.image_provider(),
+      options_provider.transfer_cache_helper(),
+      options_provider.strike_server(), options_provider.color_space(),
+      options_provider.can_use_lcd_text(),
+      options_provider.context_supports_distance_field_text(),
+      options_provider.max_texture_size(),
+      options_provider.max_texture_bytes());
+  PaintOpBufferSerializer::Preamble preamble;
+  preamble.playback_rect = gfx::Rect(0, 0, 100, 100);
+  preamble.full_raster_rect = preamble.playback_rect;
+  preamble.content_size = gfx::Size(1000, 1000);
+  preamble.requires_clear = false;
+  serializer.Serialize(&buffer, nullptr, preamble);
+  ASSERT_NE(serializer.written(), 0u);
+
+  auto deserialized_buffer =
+      PaintOpBuffer::MakeFromMemory(memory.get(), serializer.written(),
+                                    options_provider.deserialize_options());
+  ASSERT_TRUE(deserialized_buffer);
+
+  auto deserialized_iter = PaintOpBuffer::Iterator(deserialized_buffer.get());
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::Save);
+  ++deserialized_iter;
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::ClipRect);
+  ++deserialized_iter;
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::DrawPath);
+  EXPECT_EQ(static_cast<const DrawPathOp*>(*deserialized_iter)
+                ->path.getBounds(),
+            path.getBounds());
+  ++deserialized_iter;
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::Restore);
+  ++deserialized_iter;
+  ASSERT_EQ(deserialized_iter.end(), deserialized_iter);
+}
+
+TEST(PaintOpBufferTest, SerializesInverseFillPathsOutsideClip) {
+  PaintOpBuffer buffer;
+  SkPath path;
+  path.addCircle(500, 500, 10);
+  path.setFillType(SkPath::kInverseWinding_FillType);
+  buffer.push<DrawPathOp>(path, PaintFlags());
+
+  std::unique_ptr<char, base::AlignedFreeDeleter> memory(
+      static_cast<char*>(base::AlignedAlloc(PaintOpBuffer::kInitialBufferSize,
+                                            PaintOpBuffer::PaintOpAlign)));
+  TestOptionsProvider options_provider;
+  SimpleBufferSerializer serializer(
+      memory.get(), PaintOpBuffer::kInitialBufferSize,
+      options_provider.image_provider(),
+      options_provider.transfer_cache_helper(),
+      options_provider.strike_server(), options_provider.color_space(),
+      options_provider.can_use_lcd_text(),
+      options_provider.context_supports_distance_field_text(),
+      options_provider.max_texture_size(),
+      options_provider.max_texture_bytes());
+  PaintOpBufferSerializer::Preamble preamble;
+  preamble.playback_rect = gfx::Rect(0, 0, 100, 100);
+  preamble.full_raster_rect = preamble.playback_rect;
+  preamble.content_size = gfx::Size(1000, 1000);
+  preamble.requires_clear = false;
+  serializer.Serialize(&buffer, nullptr, preamble);
+  ASSERT_NE(serializer.written(), 0u);
+
+  auto deserialized_buffer =
+      PaintOpBuffer::MakeFromMemory(memory.get(), serializer.written(),
+                                    options_provider.deserialize_options());
+  ASSERT_TRUE(deserialized_buffer);
+
+  auto deserialized_iter = PaintOpBuffer::Iterator(deserialized_buffer.get());
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::Save);
+  ++deserialized_iter;
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::ClipRect);
+  ++deserialized_iter;
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::DrawPath);
+  EXPECT_TRUE(static_cast<const DrawPathOp*>(*deserialized_iter)
+                  ->path.isInverseFillType());
+  ++deserialized_iter;
+  ASSERT_EQ((*deserialized_iter)->GetType(), PaintOpType::Restore);
+  ++deserialized_iter;
+  ASSERT_EQ(deserialized_iter.end(), deserialized_iter);
+}
+
 TEST(PaintOpBufferSerializationTest, AlphaFoldingDuringSerialization) {
   PaintOpBuffer buffer;
 
@@ -39,11 +39,13 @@ class PaintOpPerfTest : public testing::Test {
             base::AlignedAlloc(sizeof(LargestPaintOp),
                                PaintOpBuffer::PaintOpAlign))) {}
 
-  void RunTest(const std::string& name, const PaintOpBuffer& buffer) {
+  void RunTest(const std::string& name,
+               const PaintOpBuffer& buffer,
+               const PaintOpBufferSerializer::Preamble& preamble =
+                   PaintOpBufferSerializer::Preamble()) {
     TestOptionsProvider test_options_provider;
 
     size_t bytes_written = 0u;
-    PaintOpBufferSerializer::Preamble preamble;
 
     timer_.Reset();
     do {
@@ -178,5 +180,34 @@ TEST_F(PaintOpPerfTest, TextOps) {
   RunTest("text", buffer);
 }
 
+// DrawTextBlobOps outside of the tile being rastered.
+TEST_F(PaintOpPerfTest, OffscreenTextOps) {
+  PaintOpBuffer buffer;
+
+  auto typeface = PaintTypeface::TestTypeface();
+
+  SkPaint font;
+  font.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+  font.setTypeface(typeface.ToSkTypeface());
+
+  SkTextBlobBuilder builder;
+  int glyph_count = 5;
+  SkRect rect = SkRect::MakeXYWH(1, 1, 1, 1);
+  const auto& run = builder.allocRun(font, glyph_count, 1.2f, 2.3f, &rect);
+  std::fill(run.glyphs, run.glyphs + glyph_count, 0);
+  std::vector<PaintTypeface> typefaces = {typeface};
+  auto blob = base::MakeRefCounted<PaintTextBlob>(builder.make(), typefaces);
+
+  PaintFlags flags;
+  for (size_t i = 0; i < 100; ++i)
+    buffer.push<DrawTextBlobOp>(blob, 0.f, 1000.f, flags);
+
+  PaintOpBufferSerializer::Preamble preamble;
+  preamble.content_size = gfx::Size(100, 2000);
+  preamble.full_raster_rect = gfx::Rect(0, 0, 100, 100);
+  preamble.playback_rect = preamble.full_raster_rect;
+  RunTest("offscreen_text", buffer, preamble);
+}
+
 }  // namespace
 }  // namespace cc
@@ -12,6 +12,7 @@
 #include "base/trace_event/memory_dump_manager.h"
 #include "cc/base/container_util.h"
 #include "components/viz/common/gpu/raster_context_provider.h"
+#include "components/viz/common/resources/resource_format_utils.h"
 #include "components/viz/common/resources/resource_sizes.h"
 #include "gpu/command_buffer/client/raster_interface.h"
 #include "third_party/khronos/GLES2/gl2.h"
@@ -35,6 +36,11 @@ const int kMaxCheckForQueryResultAvailableAttempts = 256;
 // Delay before a staging buffer might be released.
 const int kStagingBufferExpirationDelayMs = 1000;
 
+// A free staging buffer larger than the requested size may be used when at
+// least this fraction of its bytes would be used. This avoids reallocating
+// GpuMemoryBuffers while tile sizes change during zoom and resize.
+const int kMinStagingBufferUtilizationPercent = 50;
+
 bool CheckForQueryResult(gpu::raster::RasterInterface* ri, unsigned query_id) {
   unsigned complete = 1;
   ri->GetQueryObjectuivEXT(query_id, GL_QUERY_RESULT_AVAILABLE_EXT, &complete);
@@ -186,6 +192,10 @@ bool StagingBufferPool::OnMemoryDump(
     dump->AddScalar(MemoryAllocatorDump::kNameSize,
                     MemoryAllocatorDump::kUnitsBytes,
                     staging_buffer_usage_in_bytes_);
+    dump->AddScalar("free_size", MemoryAllocatorDump::kUnitsBytes,
+                    free_staging_buffer_usage_in_bytes_);
+    dump->AddScalar(MemoryAllocatorDump::kNameObjectCount,
+                    MemoryAllocatorDump::kUnitsObjects, buffers_.size());
   } else {
     for (const auto* buffer : buffers_) {
       auto in_free_buffers =
@@ -318,6 +328,39 @@ std::unique_ptr<StagingBuffer> StagingBufferPool::AcquireStagingBuffer(
     }
   }
 
+  // Find the smallest staging buffer of correct format that is large enough.
+  // Compressed formats are copied to the resource in full so they must match
+  // exactly.
+  if (!staging_buffer && !viz::IsResourceFormatCompressed(format)) {
+    int requested_bytes =
+        viz::ResourceSizes::UncheckedSizeInBytes<int>(size, format);
+    StagingBufferDeque::iterator best_it = free_buffers_.end();
+    int best_bytes = 0;
+    for (auto it = free_buffers_.begin(); it != free_buffers_.end(); ++it) {
+      const StagingBuffer* buffer = it->get();
+      if (buffer->format != format ||
+          buffer->size.width() < size.width() ||
+          buffer->size.height() < size.height()) {
+        continue;
+      }
+      int buffer_bytes =
+          viz::ResourceSizes::UncheckedSizeInBytes<int>(buffer->size, format);
+      if (requested_bytes * 100 <
+          buffer_bytes * kMinStagingBufferUtilizationPercent) {
+        continue;
+      }
+      if (best_it == free_buffers_.end() || buffer_bytes < best_bytes) {
+        best_it = it;
+        best_bytes = buffer_bytes;
+      }
+    }
+    if (best_it != free_buffers_.end()) {
+      staging_buffer = std::move(*best_it);
+      free_buffers_.erase(best_it);
+      MarkStagingBufferAsBusy(staging_buffer.get());
+    }
+  }
+
   // Create new staging buffer if necessary.
   if (!staging_buffer) {
     staging_buffer = std::make_unique<StagingBuffer>(size, format);
@@ -435,7 +478,11 @@ void StagingBufferPool::OnMemoryPressure(
   base::AutoLock lock(lock_);
   switch (level) {
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      break;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      // Release idle buffers early but keep the recently used ones around.
+      ReleaseBuffersNotUsedSince(base::TimeTicks::Now() -
+                                 staging_buffer_expiration_delay_ / 4);
       break;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
       ReleaseBuffersNotUsedSince(base::TimeTicks() + base::TimeDelta::Max());
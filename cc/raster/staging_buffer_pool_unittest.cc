@@ -45,4 +45,34 @@ TEST(StagingBufferPoolTest, ShutdownImmediatelyAfterCreation) {
   // No crash.
 }
 
+TEST(StagingBufferPoolTest, ReusesLargerFreeBuffer) {
+  auto context_provider = viz::TestContextProvider::CreateWorker();
+  bool use_partial_raster = false;
+  // Room for exactly one 16x16 RGBA buffer, so acquiring a second buffer
+  // waits for the first one to become free.
+  int max_staging_buffer_usage_in_bytes = 16 * 16 * 4;
+  auto task_runner = base::ThreadTaskRunnerHandle::Get();
+  auto pool = std::make_unique<StagingBufferPool>(
+      task_runner.get(), context_provider.get(), use_partial_raster,
+      max_staging_buffer_usage_in_bytes);
+
+  std::unique_ptr<StagingBuffer> buffer =
+      pool->AcquireStagingBuffer(gfx::Size(16, 16), viz::RGBA_8888, 0);
+  const StagingBuffer* first_buffer = buffer.get();
+  pool->ReleaseStagingBuffer(std::move(buffer));
+
+  // A slightly smaller request reuses the free buffer.
+  buffer = pool->AcquireStagingBuffer(gfx::Size(12, 12), viz::RGBA_8888, 0);
+  EXPECT_EQ(first_buffer, buffer.get());
+  EXPECT_EQ(gfx::Size(16, 16), buffer->size);
+  pool->ReleaseStagingBuffer(std::move(buffer));
+
+  // A much smaller request would waste most of it.
+  buffer = pool->AcquireStagingBuffer(gfx::Size(4, 4), viz::RGBA_8888, 0);
+  EXPECT_EQ(gfx::Size(4, 4), buffer->size);
+  pool->ReleaseStagingBuffer(std::move(buffer));
+
+  pool->Shutdown();
+}
+
 }  // namespace cc
@@ -311,6 +311,8 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("2_32_0", 2, 32, 0);
   RunScheduleAndExecuteTasksTest("2_1_1", 2, 1, 1);
   RunScheduleAndExecuteTasksTest("2_32_1", 2, 32, 1);
+  RunScheduleAndExecuteTasksTest("2_512_0", 2, 512, 0);
+  RunScheduleAndExecuteTasksTest("2_512_1", 2, 512, 1);
 }
 
 }  // namespace
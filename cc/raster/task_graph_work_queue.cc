@@ -100,6 +100,24 @@ class DependentIterator {
   TaskGraph::Node* current_node_;
 };
 
+bool CompareEdgeTask(const TaskGraph::Edge& a, const TaskGraph::Edge& b) {
+  return a.task < b.task;
+}
+
+// Sorts the edges of |task_namespace|'s graph by task and indexes its nodes,
+// so that CompleteTask(), which runs under the worker pool lock for every
+// task, only visits the completed task's own edges.
+void IndexGraph(TaskGraphWorkQueue::TaskNamespace* task_namespace) {
+  TaskGraph& graph = task_namespace->graph;
+  // Stable so that dependents are still visited in the order they were added.
+  std::stable_sort(graph.edges.begin(), graph.edges.end(), CompareEdgeTask);
+
+  task_namespace->node_indices.clear();
+  task_namespace->node_indices.reserve(graph.nodes.size());
+  for (size_t i = 0; i < graph.nodes.size(); ++i)
+    task_namespace->node_indices[graph.nodes[i].task.get()] = i;
+}
+
 }  // namespace
 
 TaskGraphWorkQueue::TaskNamespace::TaskNamespace() = default;
@@ -120,7 +138,13 @@ TaskGraphWorkQueue::PrioritizedTask::PrioritizedTask(
     : task(std::move(task)),
       task_namespace(task_namespace),
       category(category),
-      priority(priority) {}
+      priority(priority) {
+  bool tracing_enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("cc.debug"),
+                                     &tracing_enabled);
+  if (tracing_enabled)
+    ready_time = base::TimeTicks::Now();
+}
 
 TaskGraphWorkQueue::PrioritizedTask::PrioritizedTask(PrioritizedTask&& other) =
     default;
@@ -198,6 +222,7 @@ void TaskGraphWorkQueue::ScheduleTasks(NamespaceToken token, TaskGraph* graph) {
 
   // Swap task graph.
   task_namespace.graph.Swap(graph);
+  IndexGraph(&task_namespace);
 
   // Determine what tasks in old graph need to be canceled.
   for (TaskGraph::Node::Vector::iterator it = graph->nodes.begin();
@@ -302,8 +327,15 @@ void TaskGraphWorkQueue::CompleteTask(PrioritizedTask completed_task) {
   // Now iterate over all dependents to decrement dependencies and check if they
   // are ready to run.
   bool ready_to_run_namespaces_has_heap_properties = true;
-  for (DependentIterator it(&task_namespace->graph, task.get()); it; ++it) {
-    TaskGraph::Node& dependent_node = *it;
+  TaskGraph& graph = task_namespace->graph;
+  TaskGraph::Edge key(task.get(), nullptr);
+  for (auto edge_it = std::lower_bound(graph.edges.begin(), graph.edges.end(),
+                                       key, CompareEdgeTask);
+       edge_it != graph.edges.end() && edge_it->task == task.get();
+       ++edge_it) {
+    DCHECK(task_namespace->node_indices.count(edge_it->dependent));
+    TaskGraph::Node& dependent_node =
+        graph.nodes[task_namespace->node_indices[edge_it->dependent]];
 
     DCHECK_LT(0u, dependent_node.dependencies);
     dependent_node.dependencies--;
@@ -9,8 +9,10 @@
 
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
+#include "base/time/time.h"
 #include "cc/cc_export.h"
 #include "cc/raster/task_graph_runner.h"
 
@@ -44,6 +46,11 @@ class CC_EXPORT TaskGraphWorkQueue {
     TaskNamespace* task_namespace;
     uint16_t category;
     uint16_t priority;
+    // When the task became ready to run, or was last rescheduled by
+    // ScheduleTasks(). Only recorded while the disabled-by-default "cc.debug"
+    // trace category is enabled, so that runners can trace queue delay; null
+    // otherwise.
+    base::TimeTicks ready_time;
 
    private:
     DISALLOW_COPY_AND_ASSIGN(PrioritizedTask);
@@ -59,9 +66,13 @@ class CC_EXPORT TaskGraphWorkQueue {
     TaskNamespace(TaskNamespace&& other);
     ~TaskNamespace();
 
-    // Current task graph.
+    // Current task graph. Its edges are kept sorted by task so that the
+    // dependents of a completed task can be found without a full scan.
     TaskGraph graph;
 
+    // Index of each task's node in |graph|.
+    std::unordered_map<const Task*, size_t> node_indices;
+
     // Map from category to a vector of tasks that are ready to run for that
     // category.
     std::map<uint16_t, PrioritizedTask::Vector> ready_to_run_tasks;
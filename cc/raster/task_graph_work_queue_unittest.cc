@@ -58,5 +58,50 @@ TEST(TaskGraphWorkQueueTest, TestChangingDependency) {
   EXPECT_FALSE(work_queue.HasReadyToRunTasks());
 }
 
+TEST(TaskGraphWorkQueueTest, CompletingTaskSchedulesItsDependents) {
+  TaskGraphWorkQueue work_queue;
+  NamespaceToken token = work_queue.GenerateNamespaceToken();
+
+  // |dependent3| depends on both leaves, the others on a single leaf. Edges
+  // are interleaved so that a task's edges are not contiguous.
+  scoped_refptr<FakeTaskImpl> leaf1(new FakeTaskImpl());
+  scoped_refptr<FakeTaskImpl> leaf2(new FakeTaskImpl());
+  scoped_refptr<FakeTaskImpl> dependent1(new FakeTaskImpl());
+  scoped_refptr<FakeTaskImpl> dependent2(new FakeTaskImpl());
+  scoped_refptr<FakeTaskImpl> dependent3(new FakeTaskImpl());
+  TaskGraph graph;
+  graph.nodes.push_back(TaskGraph::Node(dependent1.get(), 0u, 2u, 1u));
+  graph.nodes.push_back(TaskGraph::Node(dependent2.get(), 0u, 1u, 1u));
+  graph.nodes.push_back(TaskGraph::Node(dependent3.get(), 0u, 0u, 2u));
+  graph.nodes.push_back(TaskGraph::Node(leaf1.get(), 0u, 0u, 0u));
+  graph.nodes.push_back(TaskGraph::Node(leaf2.get(), 0u, 1u, 0u));
+  graph.edges.push_back(TaskGraph::Edge(leaf1.get(), dependent1.get()));
+  graph.edges.push_back(TaskGraph::Edge(leaf2.get(), dependent2.get()));
+  graph.edges.push_back(TaskGraph::Edge(leaf1.get(), dependent3.get()));
+  graph.edges.push_back(TaskGraph::Edge(leaf2.get(), dependent3.get()));
+  work_queue.ScheduleTasks(token, &graph);
+
+  TaskGraphWorkQueue::PrioritizedTask task = work_queue.GetNextTaskToRun(0u);
+  EXPECT_EQ(leaf1.get(), task.task.get());
+  work_queue.CompleteTask(std::move(task));
+
+  task = work_queue.GetNextTaskToRun(0u);
+  EXPECT_EQ(leaf2.get(), task.task.get());
+  work_queue.CompleteTask(std::move(task));
+
+  // All dependents are now ready and run in priority order.
+  for (const auto& expected : {dependent3, dependent2, dependent1}) {
+    ASSERT_TRUE(work_queue.HasReadyToRunTasks());
+    task = work_queue.GetNextTaskToRun(0u);
+    EXPECT_EQ(expected.get(), task.task.get());
+    work_queue.CompleteTask(std::move(task));
+  }
+  EXPECT_FALSE(work_queue.HasReadyToRunTasks());
+
+  Task::Vector completed_tasks;
+  work_queue.CollectCompletedTasks(token, &completed_tasks);
+  EXPECT_EQ(5u, completed_tasks.size());
+}
+
 }  // namespace
 }  // namespace cc
@@ -141,17 +141,21 @@ void ComputeLuminance(uint8_t* block,
   WritePixelData(block, pix_data);
 }
 
-/**
- * Tries to compress the block under the assumption that it's a single color
- * block. If it's not the function will bail out without writing anything to
- * the destination buffer.
- */
-bool TryCompressSolidBlock(uint8_t* dst, const Color* src) {
-  for (unsigned int i = 1; i < 16; ++i) {
-    if (src[i].bits != src[0].bits)
-      return false;
+// Returns true if all 16 texels of the 4x4 block starting at |row0| have the
+// same color. |width| is the row stride in texels.
+bool IsSolidBlock(const Color* row0, int width) {
+  const uint32_t bits = row0[0].bits;
+  for (unsigned int y = 0; y < 4; ++y, row0 += width) {
+    for (unsigned int x = 0; x < 4; ++x) {
+      if (row0[x].bits != bits)
+        return false;
+    }
   }
+  return true;
+}
 
+// Compresses a block where every texel has the color |*src|.
+void CompressSolidBlock(uint8_t* dst, const Color* src) {
   // Clear destination buffer so that we can "or" in the results.
   memset(dst, 0, 8);
 
@@ -210,13 +214,9 @@ bool TryCompressSolidBlock(uint8_t* dst, const Color* src) {
   }
 
   WritePixelData(dst, pix_data);
-  return true;
 }
 
 void CompressBlock(uint8_t* dst, const Color* ver_src, const Color* hor_src) {
-  if (TryCompressSolidBlock(dst, ver_src))
-    return;
-
   const Color* sub_block_src[4] = {ver_src, ver_src + 8, hor_src, hor_src + 8};
 
   Color sub_block_avg[4];
@@ -304,6 +304,12 @@ void TextureCompressorETC1::Compress(const uint8_t* src,
   Color ver_blocks[16];
   Color hor_blocks[16];
 
+  // Solid blocks of the same color compress to the same 8 bytes, so remember
+  // the last one. Tiles tend to have large areas of a single background color.
+  bool has_last_solid = false;
+  uint32_t last_solid_bits = 0;
+  uint8_t last_solid_block[8];
+
   for (int y = 0; y < height; y += 4, src += width * 4 * 4) {
     for (int x = 0; x < width; x += 4, dst += 8) {
       const Color* row0 = reinterpret_cast<const Color*>(src + x * 4);
@@ -311,6 +317,18 @@ void TextureCompressorETC1::Compress(const uint8_t* src,
       const Color* row2 = row1 + width;
       const Color* row3 = row2 + width;
 
+      // Check for a solid block before transposing the texels, which is
+      // wasted work in that case.
+      if (IsSolidBlock(row0, width)) {
+        if (!has_last_solid || row0->bits != last_solid_bits) {
+          CompressSolidBlock(last_solid_block, row0);
+          last_solid_bits = row0->bits;
+          has_last_solid = true;
+        }
+        memcpy(dst, last_solid_block, 8);
+        continue;
+      }
+
       memcpy(ver_blocks, row0, 8);
       memcpy(ver_blocks + 2, row1, 8);
       memcpy(ver_blocks + 4, row2, 8);
@@ -5,6 +5,7 @@
 #include "cc/raster/texture_compressor.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -53,5 +54,34 @@ TEST(TextureCompressorETC1Test, Compress256x256Ratio) {
   EXPECT_EQ(kImageSizeInBytes, compressed_size * 8);
 }
 
+TEST(TextureCompressorETC1Test, SolidBlocksCompressIdentically) {
+  std::unique_ptr<TextureCompressor> compressor =
+      TextureCompressor::Create(TextureCompressor::kFormatETC1);
+  uint8_t src[kImageSizeInBytes];
+  uint8_t dst[kImageSizeInBytes / 8];
+
+  // Left half is one solid color, right half another.
+  for (int i = 0; i < kImageSizeInBytes; i += kImageChannels) {
+    bool left = (i / kImageChannels) % kImageWidth < kImageWidth / 2;
+    src[i] = left ? 0x20 : 0xC0;
+    src[i + 1] = left ? 0x40 : 0x80;
+    src[i + 2] = left ? 0x60 : 0x10;
+    src[i + 3] = 0xFF;
+  }
+
+  compressor->Compress(src, dst, kImageWidth, kImageHeight,
+                       TextureCompressor::kQualityHigh);
+
+  const int kBlocksPerRow = kImageWidth / 4;
+  const uint8_t* left_block = dst;
+  const uint8_t* right_block = dst + (kBlocksPerRow - 1) * 8;
+  EXPECT_NE(0, memcmp(left_block, right_block, 8));
+  for (int block = 0; block < kBlocksPerRow * (kImageHeight / 4); ++block) {
+    const uint8_t* expected =
+        block % kBlocksPerRow < kBlocksPerRow / 2 ? left_block : right_block;
+    EXPECT_EQ(0, memcmp(expected, dst + block * 8, 8)) << block;
+  }
+}
+
 }  // namespace
 }  // namespace cc
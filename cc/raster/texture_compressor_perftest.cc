@@ -73,6 +73,8 @@ class TextureCompressorPerfTest
     std::string str = FormatName(format) + " " + QualityName(quality);
     perf_test::PrintResult("Compress256x256", name, str, timer_.MsPerLap(),
                            "us", true);
+    perf_test::PrintResult("Compress256x256_throughput", name, str,
+                           timer_.LapsPerSecond(), "tiles/s", true);
   }
 
  protected:
@@ -102,6 +104,18 @@ TEST_P(TextureCompressorPerfTest, Compress256x256SolidColorImage) {
   RunTest("SolidColorImage");
 }
 
+TEST_P(TextureCompressorPerfTest, Compress256x256BackgroundWithTextImage) {
+  // Typical web content: a solid background with a few rows of busier texels.
+  unsigned int kImageSeed = 1234567890;
+  srand(kImageSeed);
+  for (int i = 0; i < kImageSizeInBytes; ++i) {
+    int row = i / (kImageWidth * kImageChannels);
+    src_[i] = (row % 32 < 8) ? rand() % 256 : 0xF0;  // NOLINT
+  }
+
+  RunTest("BackgroundWithTextImage");
+}
+
 TEST_P(TextureCompressorPerfTest, Compress256x256RandomColorImage) {
   unsigned int kImageSeed = 1234567890;
   srand(kImageSeed);
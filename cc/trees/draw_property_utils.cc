@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "base/containers/stack.h"
@@ -783,7 +784,9 @@ void FindLayersThatNeedUpdates(LayerTreeImpl* layer_tree_impl,
 void ComputeTransforms(TransformTree* transform_tree) {
   if (!transform_tree->needs_update())
     return;
-  for (int i = TransformTree::kContentsRootNodeId;
+  // Nodes before the first dirty node are unaffected by the change.
+  for (int i = std::max(static_cast<int>(TransformTree::kContentsRootNodeId),
+                        transform_tree->first_dirty_node_id());
        i < static_cast<int>(transform_tree->size()); ++i)
     transform_tree->UpdateTransforms(i);
   transform_tree->set_needs_update(false);
@@ -792,7 +795,8 @@ void ComputeTransforms(TransformTree* transform_tree) {
 void ComputeEffects(EffectTree* effect_tree) {
   if (!effect_tree->needs_update())
     return;
-  for (int i = EffectTree::kContentsRootNodeId;
+  for (int i = std::max(static_cast<int>(EffectTree::kContentsRootNodeId),
+                        effect_tree->first_dirty_node_id());
        i < static_cast<int>(effect_tree->size()); ++i)
     effect_tree->UpdateEffects(i);
   effect_tree->set_needs_update(false);
@@ -758,7 +758,7 @@ void LayerTreeImpl::UpdatePropertyTreeAnimationFromMainThread() {
       continue;
     }
     node->opacity = element_id_to_opacity->second;
-    property_trees_.effect_tree.set_needs_update(true);
+    property_trees_.effect_tree.SetNeedsUpdateFromNode(node->id);
     ++element_id_to_opacity;
   }
 
@@ -772,7 +772,7 @@ void LayerTreeImpl::UpdatePropertyTreeAnimationFromMainThread() {
       continue;
     }
     node->filters = element_id_to_filter->second;
-    property_trees_.effect_tree.set_needs_update(true);
+    property_trees_.effect_tree.SetNeedsUpdateFromNode(node->id);
     ++element_id_to_filter;
   }
 
@@ -788,7 +788,7 @@ void LayerTreeImpl::UpdatePropertyTreeAnimationFromMainThread() {
     }
     node->local = element_id_to_transform->second;
     node->needs_local_transform_update = true;
-    property_trees_.transform_tree.set_needs_update(true);
+    property_trees_.transform_tree.SetNeedsUpdateFromNode(node->id);
     ++element_id_to_transform;
   }
 
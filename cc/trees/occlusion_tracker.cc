@@ -136,6 +136,9 @@ void OcclusionTracker::EnterRenderTarget(
       new_target_surface->nearest_occlusion_immune_ancestor();
 
   stack_.emplace_back(new_target_surface);
+  stack_.back().screen_space_clip_rect_in_target =
+      ScreenSpaceClipRectInTargetSurface(new_target_surface,
+                                         screen_space_clip_rect_);
 
   // We copy the screen occlusion into the new RenderSurfaceImpl subtree, but we
   // never copy in the occlusion from inside the target, since we are looking
@@ -310,6 +313,9 @@ void OcclusionTracker::LeaveToRenderTarget(
   } else {
     // Replace the top of the stack with the new pushed surface.
     stack_.back().target = new_target_surface;
+    stack_.back().screen_space_clip_rect_in_target =
+        ScreenSpaceClipRectInTargetSurface(new_target_surface,
+                                           screen_space_clip_rect_);
     stack_.back().occlusion_from_inside_target =
         old_occlusion_from_inside_target_in_new_target;
     if (!is_root) {
@@ -352,8 +358,8 @@ void OcclusionTracker::MarkOccludedBehindLayer(const LayerImpl* layer) {
   if (!draw_transform.Preserves2dAxisAlignment())
     return;
 
-  gfx::Rect clip_rect_in_target = ScreenSpaceClipRectInTargetSurface(
-      layer->render_target(), screen_space_clip_rect_);
+  gfx::Rect clip_rect_in_target =
+      stack_.back().screen_space_clip_rect_in_target;
   if (layer->is_clipped()) {
     clip_rect_in_target.Intersect(layer->clip_rect());
   } else {
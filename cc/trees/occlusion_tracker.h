@@ -62,6 +62,10 @@ class CC_EXPORT OcclusionTracker {
     const RenderSurfaceImpl* target;
     SimpleEnclosedRegion occlusion_from_outside_target;
     SimpleEnclosedRegion occlusion_from_inside_target;
+    // The tracker's screen space clip rect mapped into |target|'s space. This
+    // is the same for every layer drawing into |target|, so it is computed
+    // once when |target| is set.
+    gfx::Rect screen_space_clip_rect_in_target;
   };
 
   // The stack holds occluded regions for subtrees in the
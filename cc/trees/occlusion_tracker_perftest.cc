@@ -0,0 +1,115 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/trees/occlusion_tracker.h"
+
+#include "base/threading/thread_task_runner_handle.h"
+#include "cc/base/lap_timer.h"
+#include "cc/layers/effect_tree_layer_list_iterator.h"
+#include "cc/layers/layer_impl.h"
+#include "cc/test/fake_impl_task_runner_provider.h"
+#include "cc/test/fake_layer_tree_frame_sink.h"
+#include "cc/test/fake_layer_tree_host_impl.h"
+#include "cc/test/test_task_graph_runner.h"
+#include "cc/trees/layer_tree_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+static const int kViewportSize = 1000;
+
+class OcclusionTrackerPerfTest : public testing::Test {
+ public:
+  OcclusionTrackerPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval),
+        task_runner_provider_(base::ThreadTaskRunnerHandle::Get()),
+        layer_tree_frame_sink_(FakeLayerTreeFrameSink::Create3d()),
+        host_impl_(LayerTreeSettings(),
+                   &task_runner_provider_,
+                   &task_graph_runner_) {}
+
+  void SetUp() override {
+    host_impl_.SetVisible(true);
+    host_impl_.InitializeFrameSink(layer_tree_frame_sink_.get());
+  }
+
+  // Builds |layer_count| opaque layers that overlap their neighbours, under
+  // |surface_count| render surfaces.
+  void BuildLayerTree(int layer_count, int surface_count) {
+    LayerTreeImpl* active_tree = host_impl_.active_tree();
+    active_tree->DetachLayers();
+    active_tree->SetDeviceViewportSize(gfx::Size(kViewportSize, kViewportSize));
+
+    int next_id = 1;
+    std::unique_ptr<LayerImpl> root = LayerImpl::Create(active_tree, next_id++);
+    root->SetBounds(gfx::Size(kViewportSize, kViewportSize));
+
+    int layers_per_surface = layer_count / surface_count;
+    for (int s = 0; s < surface_count; ++s) {
+      std::unique_ptr<LayerImpl> surface =
+          LayerImpl::Create(active_tree, next_id++);
+      surface->SetBounds(gfx::Size(kViewportSize, kViewportSize));
+      surface->test_properties()->force_render_surface = true;
+      for (int i = 0; i < layers_per_surface; ++i) {
+        std::unique_ptr<LayerImpl> layer =
+            LayerImpl::Create(active_tree, next_id++);
+        int offset = (i * 7) % (kViewportSize / 2);
+        layer->SetPosition(gfx::PointF(offset, offset));
+        layer->SetBounds(gfx::Size(kViewportSize / 2, kViewportSize / 2));
+        layer->SetDrawsContent(true);
+        layer->SetContentsOpaque(true);
+        surface->test_properties()->AddChild(std::move(layer));
+      }
+      root->test_properties()->AddChild(std::move(surface));
+    }
+
+    active_tree->SetRootLayerForTesting(std::move(root));
+    host_impl_.UpdateNumChildrenAndDrawPropertiesForActiveTree();
+  }
+
+  void RunOcclusionWalkTest(const std::string& test_name,
+                            int layer_count,
+                            int surface_count) {
+    BuildLayerTree(layer_count, surface_count);
+    LayerTreeImpl* active_tree = host_impl_.active_tree();
+
+    timer_.Reset();
+    do {
+      OcclusionTracker tracker(
+          active_tree->RootRenderSurface()->content_rect());
+      for (EffectTreeLayerListIterator it(active_tree);
+           it.state() != EffectTreeLayerListIterator::State::END; ++it) {
+        tracker.EnterLayer(it);
+        tracker.LeaveLayer(it);
+      }
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("occlusion_tracker_walk", "", test_name,
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+ protected:
+  LapTimer timer_;
+  FakeImplTaskRunnerProvider task_runner_provider_;
+  TestTaskGraphRunner task_graph_runner_;
+  std::unique_ptr<LayerTreeFrameSink> layer_tree_frame_sink_;
+  FakeLayerTreeHostImpl host_impl_;
+};
+
+TEST_F(OcclusionTrackerPerfTest, OverlappingOpaqueLayers) {
+  RunOcclusionWalkTest("1000_layers_1_surface", 1000, 1);
+  RunOcclusionWalkTest("1000_layers_10_surfaces", 1000, 10);
+}
+
+}  // namespace
+}  // namespace cc
@@ -27,7 +27,7 @@ namespace cc {
 
 template <typename T>
 PropertyTree<T>::PropertyTree()
-    : needs_update_(false) {
+    : needs_update_(false), first_dirty_node_id_(kInvalidNodeId) {
   nodes_.push_back(T());
   back()->id = kRootNodeId;
   back()->parent_id = kInvalidNodeId;
@@ -73,6 +73,7 @@ int PropertyTree<T>::Insert(const T& tree_node, int parent_id) {
 template <typename T>
 void PropertyTree<T>::clear() {
   needs_update_ = false;
+  first_dirty_node_id_ = kInvalidNodeId;
   nodes_.clear();
   nodes_.push_back(T());
   back()->id = kRootNodeId;
@@ -198,7 +199,7 @@ bool TransformTree::OnTransformAnimated(ElementId element_id,
   node->needs_local_transform_update = true;
   node->transform_changed = true;
   property_trees()->changed = true;
-  set_needs_update(true);
+  SetNeedsUpdateFromNode(node->id);
   return true;
 }
 
@@ -881,7 +882,7 @@ bool EffectTree::OnOpacityAnimated(ElementId id, float opacity) {
   node->opacity = opacity;
   node->effect_changed = true;
   property_trees()->changed = true;
-  property_trees()->effect_tree.set_needs_update(true);
+  property_trees()->effect_tree.SetNeedsUpdateFromNode(node->id);
   return true;
 }
 
@@ -894,7 +895,7 @@ bool EffectTree::OnFilterAnimated(ElementId id,
   node->filters = filters;
   node->effect_changed = true;
   property_trees()->changed = true;
-  property_trees()->effect_tree.set_needs_update(true);
+  property_trees()->effect_tree.SetNeedsUpdateFromNode(node->id);
   return true;
 }
 
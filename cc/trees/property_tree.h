@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -90,9 +91,21 @@ class CC_EXPORT PropertyTree {
 
   virtual void set_needs_update(bool needs_update) {
     needs_update_ = needs_update;
+    first_dirty_node_id_ = needs_update ? kRootNodeId : kInvalidNodeId;
   }
   bool needs_update() const { return needs_update_; }
 
+  // Like set_needs_update(true), but only the node at |id| has changed. Nodes
+  // are stored so that parents come before their children, so an update only
+  // needs to visit the nodes from first_dirty_node_id() onwards.
+  void SetNeedsUpdateFromNode(int id) {
+    int first_dirty_node_id =
+        needs_update_ ? std::min(first_dirty_node_id_, id) : id;
+    set_needs_update(true);
+    first_dirty_node_id_ = first_dirty_node_id;
+  }
+  int first_dirty_node_id() const { return first_dirty_node_id_; }
+
   std::vector<T>& nodes() { return nodes_; }
   const std::vector<T>& nodes() const { return nodes_; }
 
@@ -108,6 +121,7 @@ class CC_EXPORT PropertyTree {
  protected:
   std::vector<T> nodes_;
   bool needs_update_;
+  int first_dirty_node_id_;
   PropertyTrees* property_trees_;
 };
 
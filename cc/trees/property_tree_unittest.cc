@@ -55,6 +55,42 @@ TEST(PropertyTreeTest, SetNeedsUpdate) {
   EXPECT_FALSE(tree.needs_update());
 }
 
+TEST(PropertyTreeTest, SetNeedsUpdateFromNode) {
+  PropertyTrees property_trees;
+  TransformTree& tree = property_trees.transform_tree;
+  int contents_root = tree.Insert(TransformNode(), 0);
+  tree.Node(contents_root)->source_node_id = 0;
+  int sibling = tree.Insert(TransformNode(), contents_root);
+  tree.Node(sibling)->source_node_id = contents_root;
+  int parent = tree.Insert(TransformNode(), contents_root);
+  tree.Node(parent)->source_node_id = contents_root;
+  int child = tree.Insert(TransformNode(), parent);
+  tree.Node(child)->source_node_id = parent;
+  tree.Node(child)->local.Translate(1, 1);
+  tree.set_needs_update(true);
+  draw_property_utils::ComputeTransforms(&tree);
+  EXPECT_EQ(TransformTree::kInvalidNodeId, tree.first_dirty_node_id());
+
+  tree.Node(parent)->local.Translate(2, 2);
+  tree.Node(parent)->needs_local_transform_update = true;
+  tree.SetNeedsUpdateFromNode(child);
+  tree.SetNeedsUpdateFromNode(parent);
+  EXPECT_TRUE(tree.needs_update());
+  EXPECT_EQ(parent, tree.first_dirty_node_id());
+  draw_property_utils::ComputeTransforms(&tree);
+  EXPECT_FALSE(tree.needs_update());
+
+  gfx::Transform expected;
+  expected.Translate(3, 3);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(child));
+  EXPECT_TRANSFORMATION_MATRIX_EQ(gfx::Transform(), tree.ToScreen(sibling));
+
+  // A whole tree update overrides a pending partial one.
+  tree.SetNeedsUpdateFromNode(child);
+  tree.set_needs_update(true);
+  EXPECT_EQ(TransformTree::kRootNodeId, tree.first_dirty_node_id());
+}
+
 TEST(PropertyTreeTest, ComputeTransformChild) {
   PropertyTrees property_trees;
   TransformTree& tree = property_trees.transform_tree;
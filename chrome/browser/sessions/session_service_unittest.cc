@@ -899,6 +899,46 @@ TEST_F(SessionServiceTest, ReplacePendingNavigationAndPrune) {
             windows[0]->tabs[0]->navigations[0].virtual_url());
 }
 
+TEST_F(SessionServiceTest, ReplacePendingNavigationInterleavedTabs) {
+  const std::string base_url("http://google.com/");
+  SessionID tab_id = SessionID::NewUnique();
+  SessionID tab2_id = SessionID::NewUnique();
+
+  helper_.PrepareTabInWindow(window_id, tab_id, 0, true);
+  helper_.PrepareTabInWindow(window_id, tab2_id, 1, false);
+  const size_t initial_command_count = helper_.service()
+                                           ->GetBaseSessionServiceForTest()
+                                           ->pending_commands()
+                                           .size();
+
+  // Alternate updates between the two tabs, always at index 0.
+  for (int i = 0; i < 4; ++i) {
+    SerializedNavigationEntry nav =
+        SerializedNavigationEntryTestHelper::CreateNavigation(
+            base_url + base::IntToString(i), "a");
+    nav.set_index(0);
+    UpdateNavigation(window_id, i % 2 ? tab2_id : tab_id, nav, false);
+  }
+
+  // Only the latest update of each tab should still be pending.
+  EXPECT_EQ(initial_command_count + 2, helper_.service()
+                                           ->GetBaseSessionServiceForTest()
+                                           ->pending_commands()
+                                           .size());
+
+  std::vector<std::unique_ptr<sessions::SessionWindow>> windows;
+  ReadWindows(&windows, NULL);
+
+  ASSERT_EQ(1U, windows.size());
+  ASSERT_EQ(2U, windows[0]->tabs.size());
+  ASSERT_EQ(1U, windows[0]->tabs[0]->navigations.size());
+  EXPECT_EQ(GURL(base_url + base::IntToString(2)),
+            windows[0]->tabs[0]->navigations[0].virtual_url());
+  ASSERT_EQ(1U, windows[0]->tabs[1]->navigations.size());
+  EXPECT_EQ(GURL(base_url + base::IntToString(3)),
+            windows[0]->tabs[1]->navigations[0].virtual_url());
+}
+
 TEST_F(SessionServiceTest, RestoreActivation1) {
   SessionID window2_id = SessionID::NewUnique();
   SessionID tab1_id = SessionID::NewUnique();
@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <utility>
+
 #include "base/i18n/case_conversion.h"
 #include "base/i18n/unicodestring.h"
 #include "base/logging.h"
@@ -201,24 +203,23 @@ bool TitledUrlIndex::GetResultsMatchingTerm(
     }
     base::EraseIf(*matches, base::IsNotIn<TitledUrlNodeSet>(i->second));
   } else {
-    // Loop through index adding all entries that start with term to
-    // |prefix_matches|.
-    TitledUrlNodeSet tmp_prefix_matches;
-    // If this is the first term, then store the result directly in |matches|
-    // to avoid calling stl intersection (which requires a copy).
-    TitledUrlNodeSet* prefix_matches =
-        first_term ? matches : &tmp_prefix_matches;
+    // Loop through index collecting all entries that start with term. The
+    // per-word sets interleave, so gather them unsorted and build the set in
+    // one pass; inserting into a flat_set one by one is quadratic.
+    TitledUrlNodes prefix_nodes;
     while (i != index_.end() &&
            i->first.size() >= term.size() &&
            term.compare(0, term.size(), i->first, 0, term.size()) == 0) {
-      for (TitledUrlNodeSet::const_iterator n = i->second.begin();
-           n != i->second.end(); ++n) {
-        prefix_matches->insert(prefix_matches->end(), *n);
-      }
+      prefix_nodes.insert(prefix_nodes.end(), i->second.begin(),
+                          i->second.end());
       ++i;
     }
-    if (!first_term) {
-      base::EraseIf(*matches, base::IsNotIn<TitledUrlNodeSet>(*prefix_matches));
+    TitledUrlNodeSet prefix_matches(std::move(prefix_nodes),
+                                    base::KEEP_FIRST_OF_DUPES);
+    if (first_term) {
+      *matches = std::move(prefix_matches);
+    } else {
+      base::EraseIf(*matches, base::IsNotIn<TitledUrlNodeSet>(prefix_matches));
     }
   }
   return !matches->empty();
@@ -185,15 +185,23 @@ void ParallelDownloadJob::BuildParallelRequests() {
     UMA_HISTOGRAM_CUSTOM_COUNTS(
         "Download.ParallelDownload.RemainingTimeWhenBuildingRequests",
         remaining_time, 0, base::TimeDelta::FromDays(1).InSeconds(), 50);
-    if (remaining_bytes / current_bytes_per_second >
-        GetMinRemainingTimeInSeconds()) {
-      // Fork more requests to accelerate, only if one slice is left to download
-      // and remaining time seems to be long enough.
+    // Fork more requests to accelerate, only if one slice is left to download
+    // and remaining time seems to be long enough. The number of requests
+    // depends on how long the single stream measured so far would take, and
+    // may leave the initial request alone.
+    int request_count = 1;
+    if (remaining_time > GetMinRemainingTimeInSeconds()) {
+      request_count = GetParallelRequestCountForRemainingTime(
+          base::TimeDelta::FromSeconds(remaining_time),
+          base::TimeDelta::FromSeconds(GetMinRemainingTimeInSeconds()),
+          GetParallelRequestCount());
+    }
+    if (request_count > 1) {
       slices_to_download = FindSlicesForRemainingContent(
           first_slice_offset,
           content_length_ - first_slice_offset + initial_request_offset_,
-          GetParallelRequestCount(), GetMinSliceSize());
-    } else {
+          request_count, GetMinSliceSize());
+    } else if (GetParallelRequestCount() > 1) {
       RecordParallelDownloadCreationEvent(
           ParallelDownloadCreationEvent::FALLBACK_REASON_REMAINING_TIME);
     }
@@ -8,12 +8,14 @@
 #include <vector>
 
 #include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/mock_callback.h"
 #include "base/test/scoped_task_environment.h"
 #include "components/download/internal/common/parallel_download_utils.h"
 #include "components/download/public/common/download_create_info.h"
 #include "components/download/public/common/download_destination_observer.h"
 #include "components/download/public/common/download_file_impl.h"
+#include "components/download/public/common/download_stats.h"
 #include "components/download/public/common/download_task_runner.h"
 #include "components/download/public/common/mock_download_item.h"
 #include "components/download/public/common/mock_input_stream.h"
@@ -474,6 +476,21 @@ TEST_F(ParallelDownloadJobTest, RemainingContentWillFinishSoon) {
   DestroyParallelJob();
 }
 
+// Test that no parallel request is created if a second request would save less
+// than the minimum remaining time, and that the fallback is recorded.
+TEST_F(ParallelDownloadJobTest, SecondRequestWouldNotSaveEnoughTime) {
+  base::HistogramTester histogram_tester;
+  // 15 seconds left at 1 byte per second; two requests would only save 7.
+  CreateParallelJob(0, 15, DownloadItem::ReceivedSlices(), 3, 1, 10);
+  BuildParallelRequests();
+  EXPECT_TRUE(job_->workers().empty());
+  histogram_tester.ExpectUniqueSample(
+      "Download.ParallelDownload.CreationEvent",
+      ParallelDownloadCreationEvent::FALLBACK_REASON_REMAINING_TIME, 1);
+
+  DestroyParallelJob();
+}
+
 // Test that parallel request is not created until download file is initialized.
 TEST_F(ParallelDownloadJobTest, ParallelRequestNotCreatedUntilFileInitialized) {
   auto save_info = std::make_unique<DownloadSaveInfo>();
@@ -4,6 +4,8 @@
 
 #include "components/download/internal/common/parallel_download_utils.h"
 
+#include <algorithm>
+
 #include "base/metrics/field_trial_params.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
@@ -160,6 +162,24 @@ std::vector<DownloadItem::ReceivedSlice> FindSlicesForRemainingContent(
   return new_slices;
 }
 
+int GetParallelRequestCountForRemainingTime(base::TimeDelta remaining_time,
+                                            base::TimeDelta min_remaining_time,
+                                            int max_request_count) {
+  if (min_remaining_time <= base::TimeDelta())
+    return max_request_count;
+
+  // Going from n to n + 1 requests shortens the download from
+  // |remaining_time| / n to |remaining_time| / (n + 1), i.e. by
+  // |remaining_time| / (n * (n + 1)).
+  int request_count = 1;
+  while (request_count < max_request_count &&
+         remaining_time >=
+             min_remaining_time * (request_count * (request_count + 1))) {
+    ++request_count;
+  }
+  return std::min(request_count, max_request_count);
+}
+
 int64_t GetMinSliceSizeConfig() {
   std::string finch_value = base::GetFieldTrialParamValueByFeature(
       features::kParallelDownloading, kMinSliceSizeFinchKey);
@@ -44,6 +44,17 @@ FindSlicesForRemainingContent(int64_t current_offset,
                               int request_count,
                               int64_t min_slice_size);
 
+// Returns how many requests, at most |max_request_count|, should download
+// content which a single request would finish in |remaining_time|, assuming
+// that the throughput grows with the number of requests. A request is only
+// added if it shortens the download by at least |min_remaining_time|, so that
+// slow links and large files get more requests than fast links and small
+// files.
+COMPONENTS_DOWNLOAD_EXPORT int GetParallelRequestCountForRemainingTime(
+    base::TimeDelta remaining_time,
+    base::TimeDelta min_remaining_time,
+    int max_request_count);
+
 // Finch configuration utilities.
 //
 // Get the minimum slice size to use parallel download from finch configuration.
@@ -331,6 +331,33 @@ TEST_F(ParallelDownloadUtilsTest, GetMaxContiguousDataBlockSizeFromBeginning) {
   EXPECT_EQ(1000, GetMaxContiguousDataBlockSizeFromBeginning(slices));
 }
 
+TEST_F(ParallelDownloadUtilsTest, GetParallelRequestCountForRemainingTime) {
+  const base::TimeDelta kMinRemainingTime = base::TimeDelta::FromSeconds(2);
+
+  // A request is added while it saves at least 2 seconds: the second one
+  // needs 4 seconds left, the third one 12 seconds and the fourth one 24.
+  EXPECT_EQ(1, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromSeconds(3), kMinRemainingTime, 5));
+  EXPECT_EQ(2, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromSeconds(4), kMinRemainingTime, 5));
+  EXPECT_EQ(2, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromSeconds(11), kMinRemainingTime, 5));
+  EXPECT_EQ(3, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromSeconds(12), kMinRemainingTime, 5));
+  EXPECT_EQ(4, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromSeconds(24), kMinRemainingTime, 5));
+
+  // The count never exceeds the configured maximum.
+  EXPECT_EQ(3, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromHours(1), kMinRemainingTime, 3));
+  EXPECT_EQ(0, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromHours(1), kMinRemainingTime, 0));
+
+  // Without a minimum remaining time, the maximum is always used.
+  EXPECT_EQ(3, GetParallelRequestCountForRemainingTime(
+                   base::TimeDelta::FromSeconds(1), base::TimeDelta(), 3));
+}
+
 // Test to verify Finch parameters for enabled experiment group is read
 // correctly.
 TEST_F(ParallelDownloadUtilsTest, FinchConfigEnabled) {
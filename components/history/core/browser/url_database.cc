@@ -353,7 +353,7 @@ bool URLDatabase::FindShortestURLFromBase(const std::string& base,
   sql.append(" ? AND url < :end AND url = substr(:end, 1, length(url)) "
              "AND hidden = 0 AND visit_count >= ? AND typed_count >= ? "
              "ORDER BY url LIMIT 1");
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  sql::Statement statement(GetDB().GetCachedDynamicStatement(sql.c_str()));
   statement.BindString(0, base);
   statement.BindString(1, url);   // :end
   statement.BindInt(2, min_visits);
@@ -384,8 +384,10 @@ bool URLDatabase::GetTextMatchesWithAlgorithm(
   sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "SELECT" HISTORY_URL_ROW_FIELDS "FROM urls WHERE hidden = 0"));
 
+  // Reused across rows so its storage is only grown once.
+  query_parser::QueryWordVector query_words;
   while (statement.Step()) {
-    query_parser::QueryWordVector query_words;
+    query_words.clear();
     base::string16 url = base::i18n::ToLower(statement.ColumnString16(1));
     query_parser_.ExtractQueryWords(url, &query_words);
     GURL gurl(url);
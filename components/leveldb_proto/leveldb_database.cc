@@ -190,8 +190,7 @@ bool LevelDB::LoadWithFilter(const KeyFilter& filter,
         continue;
     }
     leveldb::Slice value_slice = db_iterator->value();
-    std::string entry(value_slice.data(), value_slice.size());
-    entries->push_back(entry);
+    entries->emplace_back(value_slice.data(), value_slice.size());
   }
   return true;
 }
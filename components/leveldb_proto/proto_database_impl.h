@@ -157,10 +157,9 @@ void UpdateEntriesFromTaskRunner(
 
   // Serialize the values from Proto to string before passing on to database.
   KeyValueVector pairs_to_save;
-  for (const auto& pair : *entries_to_save) {
-    pairs_to_save.push_back(
-        std::make_pair(pair.first, pair.second.SerializeAsString()));
-  }
+  pairs_to_save.reserve(entries_to_save->size());
+  for (const auto& pair : *entries_to_save)
+    pairs_to_save.emplace_back(pair.first, pair.second.SerializeAsString());
 
   *success = database->Save(pairs_to_save, *keys_to_remove);
 }
@@ -175,10 +174,9 @@ void UpdateEntriesWithRemoveFilterFromTaskRunner(
 
   // Serialize the values from Proto to string before passing on to database.
   KeyValueVector pairs_to_save;
-  for (const auto& pair : *entries_to_save) {
-    pairs_to_save.push_back(
-        std::make_pair(pair.first, pair.second.SerializeAsString()));
-  }
+  pairs_to_save.reserve(entries_to_save->size());
+  for (const auto& pair : *entries_to_save)
+    pairs_to_save.emplace_back(pair.first, pair.second.SerializeAsString());
 
   *success = database->UpdateWithRemoveFilter(pairs_to_save, delete_key_filter);
 }
@@ -199,14 +197,17 @@ void LoadEntriesFromTaskRunner(LevelDB* database,
   *success =
       database->LoadWithFilter(filter, &loaded_entries, options, target_prefix);
 
-  for (const auto& serialized_entry : loaded_entries) {
-    T entry;
-    if (!entry.ParseFromString(serialized_entry)) {
+  entries->reserve(loaded_entries.size());
+  for (auto& serialized_entry : loaded_entries) {
+    entries->emplace_back();
+    if (!entries->back().ParseFromString(serialized_entry)) {
       DLOG(WARNING) << "Unable to parse leveldb_proto entry";
       // TODO(cjhopman): Decide what to do about un-parseable entries.
     }
 
-    entries->push_back(entry);
+    // Free each serialized copy once parsed so that both representations of
+    // the whole table are never held at the same time.
+    std::string().swap(serialized_entry);
   }
 }
 
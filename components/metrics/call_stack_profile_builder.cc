@@ -207,6 +207,8 @@ void CallStackProfileBuilder::OnSampleCompleted(
     CallStackProfile::Sample* sample_proto =
         proto_profile_.mutable_deprecated_sample(existing_sample_index);
     sample_proto->set_count(sample_proto->count() + 1);
+    // Reset |sample_| so the next sample doesn't start with these frames.
+    sample_ = Sample();
     return;
   }
 
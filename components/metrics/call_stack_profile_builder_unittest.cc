@@ -216,6 +216,42 @@ TEST(CallStackProfileBuilderTest, SamplesDeduped) {
   ASSERT_EQ(1, proto.call_stack_profile().deprecated_sample_size());
 }
 
+TEST(CallStackProfileBuilderTest, RepeatedSamplesDeduped) {
+  auto profile_builder =
+      std::make_unique<TestingCallStackProfileBuilder>(kProfileParams);
+
+#if defined(OS_WIN)
+  base::FilePath module_path(L"c:\\some\\path\\to\\chrome.exe");
+#else
+  base::FilePath module_path("/some/path/to/chrome");
+#endif
+
+  const uintptr_t module_base_address = 0x1000;
+  Module module = {module_base_address, "1", module_path};
+  Frame frame = {module_base_address + 0x10, module};
+
+  std::vector<Frame> frames = {frame};
+
+  // Every repetition of the same stack, not just the second, is folded into
+  // the first sample's count.
+  CallStackProfileBuilder::SetProcessMilestone(0);
+  for (int i = 0; i < 3; ++i) {
+    profile_builder->RecordAnnotations();
+    profile_builder->OnSampleCompleted(frames);
+  }
+
+  profile_builder->OnProfileCompleted(base::TimeDelta(), base::TimeDelta());
+
+  const SampledProfile& proto = profile_builder->sampled_profile();
+
+  ASSERT_TRUE(proto.has_call_stack_profile());
+  ASSERT_EQ(1, proto.call_stack_profile().deprecated_sample_size());
+  const CallStackProfile::Sample& sample =
+      proto.call_stack_profile().deprecated_sample(0);
+  EXPECT_EQ(1, sample.frame_size());
+  EXPECT_EQ(3, sample.count());
+}
+
 TEST(CallStackProfileBuilderTest, SamplesNotDeduped) {
   auto profile_builder =
       std::make_unique<TestingCallStackProfileBuilder>(kProfileParams);
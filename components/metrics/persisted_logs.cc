@@ -14,6 +14,7 @@
 #include "base/sha1.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/timer/elapsed_timer.h"
+#include "base/values.h"
 #include "components/metrics/persisted_logs_metrics.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -214,9 +215,13 @@ void PersistedLogs::WriteLogsToPrefList(base::ListValue* list_value) const {
     }
     std::unique_ptr<base::DictionaryValue> dict_value(
         new base::DictionaryValue);
-    dict_value->SetString(kLogHashKey, EncodeToBase64(list_[i].hash));
-    dict_value->SetString(kLogDataKey,
-                          EncodeToBase64(list_[i].compressed_log_data));
+    // Move the encoded strings into the dictionary; SetString() would copy
+    // each (potentially large) log a second time.
+    dict_value->SetKey(kLogHashKey,
+                       base::Value(EncodeToBase64(list_[i].hash)));
+    dict_value->SetKey(
+        kLogDataKey,
+        base::Value(EncodeToBase64(list_[i].compressed_log_data)));
     dict_value->SetString(kLogTimestampKey, list_[i].timestamp);
     list_value->Append(std::move(dict_value));
   }
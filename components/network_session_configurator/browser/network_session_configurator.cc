@@ -593,6 +593,8 @@ void ParseCommandLineAndFieldTrials(const base::CommandLine& command_line,
 
   params->enable_channel_id =
       base::FeatureList::IsEnabled(features::kChannelID);
+  params->enable_http_preconnect_predictor =
+      base::FeatureList::IsEnabled(features::kHttpPreconnectPredictor);
 }
 
 net::URLRequestContextBuilder::HttpCacheParams::Type ChooseCacheType(
@@ -13,4 +13,7 @@ const base::Feature kChannelID{"channel-id", base::FEATURE_DISABLED_BY_DEFAULT};
 const base::Feature kDnsOverHttps{"dns-over-https",
                                   base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::Feature kHttpPreconnectPredictor{"HttpPreconnectPredictor",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
@@ -17,6 +17,11 @@ NETWORK_SESSION_CONFIGURATOR_EXPORT extern const base::Feature kChannelID;
 // (https://tools.ietf.org/id/draft-ietf-doh-dns-over-https-12.txt).
 NETWORK_SESSION_CONFIGURATOR_EXPORT extern const base::Feature kDnsOverHttps;
 
+// Enables preconnects to the origins that earlier navigations to the same site
+// connected to.
+NETWORK_SESSION_CONFIGURATOR_EXPORT extern const base::Feature
+    kHttpPreconnectPredictor;
+
 }  // namespace features
 
 #endif  // COMPONENTS_NETWORK_SESSION_CONFIGURATOR_COMMON_NETWORK_FEATURES_H_
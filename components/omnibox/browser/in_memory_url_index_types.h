@@ -10,6 +10,7 @@
 #include <map>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/containers/hash_tables.h"
 #include "base/strings/string16.h"
@@ -137,8 +138,11 @@ typedef size_t WordID;
 typedef std::map<base::string16, WordID> WordMap;
 
 // A map from character to the word_ids of words containing that character.
+// There are only as many keys as distinct characters in the index, and new
+// ones are rare once the index is built, so a flat_map keeps lookups from
+// HistoryIDSetFromWords() on contiguous memory.
 typedef base::flat_set<WordID> WordIDSet;  // An index into the WordList.
-typedef std::map<base::char16, WordIDSet> CharWordIDMap;
+typedef base::flat_map<base::char16, WordIDSet> CharWordIDMap;
 
 // A map from word (by word_id) to history items containing that word.
 typedef history::URLID HistoryID;
@@ -191,7 +191,11 @@ void PolicyServiceImpl::MergeAndTriggerUpdates() {
     PolicyBundle provided_bundle;
     provided_bundle.CopyFrom(provider->policies());
     RemapProxyPolicies(&provided_bundle.Get(chrome_namespace));
-    bundle.MergeFrom(provided_bundle);
+    // Merging into an empty bundle would just copy |provided_bundle| again.
+    if (bundle.begin() == bundle.end())
+      bundle.Swap(&provided_bundle);
+    else
+      bundle.MergeFrom(provided_bundle);
   }
 
   // Swap first, so that observers that call GetPolicies() see the current
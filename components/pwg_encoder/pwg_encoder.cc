@@ -64,21 +64,27 @@ struct BGRA8 {
   uint8_t alpha;
 };
 
+const int kMaxBytesPerPixel = 3;
+
+// Writes the encoded pixel to |output| and returns the position just after
+// it.
 template <class InputStruct>
-void EncodePixelToRGB(const void* pixel, std::string* output) {
+char* EncodePixelToRGB(const void* pixel, char* output) {
   const InputStruct* i = reinterpret_cast<const InputStruct*>(pixel);
-  output->push_back(static_cast<char>(i->red));
-  output->push_back(static_cast<char>(i->green));
-  output->push_back(static_cast<char>(i->blue));
+  *output++ = static_cast<char>(i->red);
+  *output++ = static_cast<char>(i->green);
+  *output++ = static_cast<char>(i->blue);
+  return output;
 }
 
 template <class InputStruct>
-void EncodePixelToMonochrome(const void* pixel, std::string* output) {
+char* EncodePixelToMonochrome(const void* pixel, char* output) {
   const InputStruct* i = reinterpret_cast<const InputStruct*>(pixel);
-  output->push_back(static_cast<char>((i->red * kRedCoefficient +
-                                       i->green * kGreenCoefficient +
-                                       i->blue * kBlueCoefficient) /
-                                      kColorCoefficientDenominator));
+  *output++ = static_cast<char>((i->red * kRedCoefficient +
+                                 i->green * kGreenCoefficient +
+                                 i->blue * kBlueCoefficient) /
+                                kColorCoefficientDenominator);
+  return output;
 }
 
 std::string EncodePageHeader(const BitmapImage& image,
@@ -138,6 +144,10 @@ void EncodeRow(RandomAccessIterator pos,
   // usually saves the most space. Every other pixel should be encoded in the
   // smallest number of generic sequences.
   // NOTE: the algorithm is not optimal especially in case of monochrome.
+  //
+  // Each sequence is assembled in |sequence| and appended to |output| at once,
+  // rather than growing |output| one byte at a time.
+  char sequence[1 + kPwgMaxPackedPixels * kMaxBytesPerPixel];
   while (pos != row_end) {
     RandomAccessIterator it = pos + 1;
     RandomAccessIterator end = std::min(pos + kPwgMaxPackedPixels, row_end);
@@ -146,12 +156,15 @@ void EncodeRow(RandomAccessIterator pos,
     while (it != end && *pos == *it) {
       ++it;
     }
+    char* sequence_end = sequence;
     if (it != pos + 1) {  // More than one pixel
-      output->push_back(static_cast<char>((it - pos) - 1));
-      if (monochrome)
-        EncodePixelToMonochrome<InputStruct>(&*pos, output);
-      else
-        EncodePixelToRGB<InputStruct>(&*pos, output);
+      *sequence_end++ = static_cast<char>((it - pos) - 1);
+      if (monochrome) {
+        sequence_end =
+            EncodePixelToMonochrome<InputStruct>(&*pos, sequence_end);
+      } else {
+        sequence_end = EncodePixelToRGB<InputStruct>(&*pos, sequence_end);
+      }
       pos = it;
     } else {
       // Finds how many pixels there are each different from the previous one.
@@ -168,15 +181,18 @@ void EncodeRow(RandomAccessIterator pos,
       if (it != row_end && *it == *(it - 1)) {
         --it;
       }
-      output->push_back(static_cast<char>(1 - (it - pos)));
+      *sequence_end++ = static_cast<char>(1 - (it - pos));
       while (pos != it) {
-        if (monochrome)
-          EncodePixelToMonochrome<InputStruct>(&*pos, output);
-        else
-          EncodePixelToRGB<InputStruct>(&*pos, output);
+        if (monochrome) {
+          sequence_end =
+              EncodePixelToMonochrome<InputStruct>(&*pos, sequence_end);
+        } else {
+          sequence_end = EncodePixelToRGB<InputStruct>(&*pos, sequence_end);
+        }
         ++pos;
       }
     }
+    output->append(sequence, sequence_end - sequence);
   }
 }
 
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "base/compiler_specific.h"
 #include "base/i18n/break_iterator.h"
@@ -464,7 +465,7 @@ void QueryParser::ExtractQueryWords(const base::string16& text,
       base::string16 word = iter.GetString();
       if (!word.empty()) {
         words->push_back(QueryWord());
-        words->back().word = word;
+        words->back().word = std::move(word);
         words->back().position = iter.prev();
      }
     }
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/big_endian.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/metrics/histogram_functions.h"
@@ -323,8 +324,9 @@ ApplyUpdateResult V4Store::ProcessUpdate(
     DCHECK(!raw_removals);
     // We delay the checksum check at startup to be able to load the DB
     // quickly. In this case, the |hash_prefix_map_old| should be empty, so just
-    // copy over the |hash_prefix_map|.
-    hash_prefix_map_ = hash_prefix_map;
+    // move over the |hash_prefix_map|. Copying it would briefly hold the whole
+    // store twice.
+    hash_prefix_map_ = std::move(hash_prefix_map);
 
     // Calculate the checksum asynchronously later and if it doesn't match,
     // reset the store.
@@ -787,6 +789,29 @@ HashPrefix V4Store::GetMatchingHashPrefix(base::StringPiece full_hash) {
 bool V4Store::HashPrefixMatches(base::StringPiece prefix,
                                 const HashPrefixes& prefixes,
                                 const PrefixSize& size) {
+  // Nearly all prefixes are 4 bytes long. Read those as big-endian integers,
+  // which order the same way as the bytes, so each probe is a single integer
+  // compare instead of building a StringPiece and calling memcmp().
+  if (size == kMinHashPrefixLength && prefix.size() == kMinHashPrefixLength) {
+    uint32_t target;
+    base::ReadBigEndian(prefix.data(), &target);
+    const char* data = prefixes.data();
+    size_t low = 0;
+    size_t high = prefixes.size() / kMinHashPrefixLength;
+    while (low < high) {
+      const size_t mid = low + (high - low) / 2;
+      uint32_t value;
+      base::ReadBigEndian(data + mid * kMinHashPrefixLength, &value);
+      if (value < target)
+        low = mid + 1;
+      else if (target < value)
+        high = mid;
+      else
+        return true;
+    }
+    return false;
+  }
+
   return std::binary_search(
       PrefixIterator(prefixes, 0, size),
       PrefixIterator(prefixes, prefixes.size() / size, size), prefix);
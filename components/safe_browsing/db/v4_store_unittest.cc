@@ -625,6 +625,26 @@ TEST_F(V4StoreTest, TestHashPrefixDoesNotExistInConcatenatedList) {
   EXPECT_FALSE(V4Store::HashPrefixMatches(hash_prefix, hash_prefixes, 5));
 }
 
+TEST_F(V4StoreTest, TestFourBytePrefixMatches) {
+  // Sorted bytewise, including bytes with the high bit set.
+  const char kPrefixes[] =
+      "aaaa"
+      "bbbb"
+      "\x7f\xff\xff\xff"
+      "\x80\x00\x00\x00"
+      "\xff\xff\xff\xff";
+  HashPrefixes hash_prefixes(kPrefixes, sizeof(kPrefixes) - 1);
+  EXPECT_TRUE(V4Store::HashPrefixMatches("aaaa", hash_prefixes, 4));
+  EXPECT_TRUE(V4Store::HashPrefixMatches("bbbb", hash_prefixes, 4));
+  EXPECT_TRUE(V4Store::HashPrefixMatches(
+      base::StringPiece("\x80\x00\x00\x00", 4), hash_prefixes, 4));
+  EXPECT_TRUE(
+      V4Store::HashPrefixMatches("\xff\xff\xff\xff", hash_prefixes, 4));
+  EXPECT_FALSE(V4Store::HashPrefixMatches("aaab", hash_prefixes, 4));
+  EXPECT_FALSE(V4Store::HashPrefixMatches(
+      base::StringPiece("\x80\x00\x00\x01", 4), hash_prefixes, 4));
+}
+
 TEST_F(V4StoreTest, TestFullHashExistsInMapWithSingleSize) {
   V4Store store(task_runner_, store_path_);
   store.hash_prefix_map_[32] =
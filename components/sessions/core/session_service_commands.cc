@@ -824,20 +824,22 @@ bool ReplacePendingCommand(BaseSessionService* base_session_service,
       (*command)->id() != kCommandSetActiveWindow) {
     return false;
   }
+  SessionID::id_type command_tab_id = 0;
+  int command_nav_index = 0;
+  if ((*command)->id() == kCommandUpdateTabNavigation) {
+    std::unique_ptr<base::Pickle> command_pickle(
+        (*command)->PayloadAsPickle());
+    base::PickleIterator iterator(*command_pickle);
+    if (!iterator.ReadInt(&command_tab_id) ||
+        !iterator.ReadInt(&command_nav_index)) {
+      return false;
+    }
+  }
   for (auto i = base_session_service->pending_commands().rbegin();
        i != base_session_service->pending_commands().rend(); ++i) {
     SessionCommand* existing_command = i->get();
     if ((*command)->id() == kCommandUpdateTabNavigation &&
         existing_command->id() == kCommandUpdateTabNavigation) {
-      std::unique_ptr<base::Pickle> command_pickle(
-          (*command)->PayloadAsPickle());
-      base::PickleIterator iterator(*command_pickle);
-      SessionID::id_type command_tab_id;
-      int command_nav_index;
-      if (!iterator.ReadInt(&command_tab_id) ||
-          !iterator.ReadInt(&command_nav_index)) {
-        return false;
-      }
       SessionID::id_type existing_tab_id;
       int existing_nav_index;
       {
@@ -846,14 +848,17 @@ bool ReplacePendingCommand(BaseSessionService* base_session_service,
         // the pickle references deleted memory.
         std::unique_ptr<base::Pickle> existing_pickle(
             existing_command->PayloadAsPickle());
-        iterator = base::PickleIterator(*existing_pickle);
+        base::PickleIterator iterator(*existing_pickle);
         if (!iterator.ReadInt(&existing_tab_id) ||
             !iterator.ReadInt(&existing_nav_index)) {
           return false;
         }
       }
-      if (existing_tab_id == command_tab_id &&
-          existing_nav_index == command_nav_index) {
+      // Updates for other tabs are independent of this one, so keep looking
+      // past them; with many active tabs they are usually interleaved.
+      if (existing_tab_id != command_tab_id)
+        continue;
+      if (existing_nav_index == command_nav_index) {
         // existing_command is an update for the same tab/index pair. Replace
         // it with the new one. We need to add to the end of the list just in
         // case there is a prune command after the update command.
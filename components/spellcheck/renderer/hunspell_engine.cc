@@ -30,6 +30,9 @@ namespace {
   // 24 is the observed limits for OSX system checker.
   const size_t kMaxSuggestLen = 24;
 
+  // Number of spellcheck results remembered per dictionary.
+  const size_t kWordCacheSize = 1000;
+
   static_assert(kMaxCheckedLen <= size_t(MAXWORDLEN),
                 "MaxCheckedLen too long");
   static_assert(kMaxSuggestLen <= kMaxCheckedLen,
@@ -46,7 +49,8 @@ SpellingEngine* CreateNativeSpellingEngine(
 
 HunspellEngine::HunspellEngine(
     service_manager::LocalInterfaceProvider* embedder_provider)
-    : hunspell_enabled_(false),
+    : word_cache_(kWordCacheSize),
+      hunspell_enabled_(false),
       initialized_(false),
       dictionary_requested_(false),
       embedder_provider_(embedder_provider) {
@@ -60,6 +64,7 @@ void HunspellEngine::Init(base::File file) {
   initialized_ = true;
   hunspell_.reset();
   bdict_file_.reset();
+  word_cache_.Clear();
   file_ = std::move(file);
   hunspell_enabled_ = file_.IsValid();
   // Delay the actual initialization of hunspell until it is needed.
@@ -91,8 +96,12 @@ bool HunspellEngine::CheckSpelling(const base::string16& word_to_check,
     // If |hunspell_| is NULL here, an error has occurred, but it's better
     // to check rather than crash.
     if (hunspell_) {
+      auto cached = word_cache_.Get(word_to_check_utf8);
+      if (cached != word_cache_.end())
+        return cached->second;
       // |hunspell_->spell| returns 0 if the word is misspelled.
       word_correct = (hunspell_->spell(word_to_check_utf8) != 0);
+      word_cache_.Put(word_to_check_utf8, word_correct);
     }
   }
 
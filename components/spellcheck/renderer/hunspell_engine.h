@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/strings/string16.h"
 #include "base/strings/utf_string_conversions.h"
 #include "components/spellcheck/common/spellcheck_common.h"
@@ -46,6 +47,11 @@ class HunspellEngine : public SpellingEngine {
   // The hunspell dictionary in use.
   std::unique_ptr<Hunspell> hunspell_;
 
+  // Recent results of |hunspell_->spell()|, keyed on the UTF-8 word. Text is
+  // re-checked paragraph by paragraph as it is edited, so the same words are
+  // looked up over and over.
+  base::MRUCache<std::string, bool> word_cache_;
+
   base::File file_;
 
   // This flag is true if hunspell is enabled.
@@ -24,6 +24,10 @@ scoped_refptr<MemoryMappedRuleset> MemoryMappedRuleset::CreateAndInitialize(
       !ruleset->ruleset_.Initialize(std::move(ruleset_file)))
     return nullptr;
   DCHECK(ruleset->ruleset_.IsValid());
+  // The ruleset is consulted on every subresource load, so start paging it in
+  // now rather than faulting on the first loads.
+  if (ruleset->length())
+    ruleset->ruleset_.Prefetch(0, ruleset->length());
   return ruleset;
 }
 
@@ -8,7 +8,9 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/feature_list.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/field_trial_params.h"
@@ -260,12 +262,18 @@ void UkmRecorderImpl::SetIsWebstoreExtensionCallback(
 void UkmRecorderImpl::StoreRecordingsInReport(Report* report) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  std::set<SourceId> ids_seen;
+  report->mutable_entries()->Reserve(recordings_.entries.size());
+  std::vector<SourceId> entry_source_ids;
+  entry_source_ids.reserve(recordings_.entries.size());
   for (const auto& entry : recordings_.entries) {
     Entry* proto_entry = report->add_entries();
     StoreEntryProto(*entry, proto_entry);
-    ids_seen.insert(entry->source_id);
+    entry_source_ids.push_back(entry->source_id);
   }
+  // Built in one go rather than by repeated insertion, since there are
+  // usually many entries per source.
+  base::flat_set<SourceId> ids_seen(std::move(entry_source_ids),
+                                    base::KEEP_FIRST_OF_DUPES);
 
   std::unordered_set<std::string> url_whitelist;
   recordings_.carryover_urls_whitelist.swap(url_whitelist);
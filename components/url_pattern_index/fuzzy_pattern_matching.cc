@@ -4,6 +4,8 @@
 
 #include "components/url_pattern_index/fuzzy_pattern_matching.h"
 
+#include <string.h>
+
 #include <algorithm>
 
 namespace url_pattern_index {
@@ -45,6 +47,25 @@ size_t FindFuzzy(base::StringPiece text,
   if (subpattern.empty())
     return from;
 
+  // Most subpatterns start with a literal character, so skip ahead to its
+  // occurrences with memchr(), which is vectorized by the C library, and only
+  // compare the whole subpattern there.
+  if (subpattern[0] != kSeparatorPlaceholder) {
+    if (subpattern.size() > text.size() - from)
+      return base::StringPiece::npos;
+    const size_t last_start = text.size() - subpattern.size();
+    for (size_t i = from; i <= last_start; ++i) {
+      const void* candidate =
+          memchr(text.data() + i, subpattern[0], last_start - i + 1);
+      if (!candidate)
+        return base::StringPiece::npos;
+      i = static_cast<const char*>(candidate) - text.data();
+      if (StartsWithFuzzyImpl(text.substr(i), subpattern))
+        return i;
+    }
+    return base::StringPiece::npos;
+  }
+
   auto fuzzy_compare = [](char text_char, char subpattern_char) {
     return text_char == subpattern_char ||
            (subpattern_char == kSeparatorPlaceholder && IsSeparator(text_char));
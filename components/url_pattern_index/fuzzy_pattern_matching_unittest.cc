@@ -86,6 +86,10 @@ TEST(SubresourceFilterFuzzyPatternMatchingTest, FindFuzzy) {
       {"a/a/a/a", "^a^a^a", {1}},
       {"a/a/a/a", "^a^a?a", std::vector<size_t>()},
       {"a/a/a/a", "?a?a?a", std::vector<size_t>()},
+
+      {"xxab/ab^", "ab^", {2, 5}},
+      {"xxab/ab", "ab^", {2}},
+      {"ab", "abc", std::vector<size_t>()},
   };
 
   for (const auto& test_case : kTestCases) {
@@ -208,4 +208,63 @@ TEST_F(GLHelperBenchmark, ScaleBenchmark) {
   }
 }
 
+// Measures the per-capture cost for clients that create a new scaler for each
+// readback, which includes the intermediate texture setup of multi-stage
+// pipelines.
+TEST_F(GLHelperBenchmark, CreateAndScaleBenchmark) {
+  const gfx::Size src_size(2560, 1476);
+  const gfx::Size dst_size(1249, 720);
+
+  uint32_t src_texture;
+  gl_->GenTextures(1, &src_texture);
+  uint32_t dst_texture;
+  gl_->GenTextures(1, &dst_texture);
+  gl_->BindTexture(GL_TEXTURE_2D, dst_texture);
+  gl_->TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dst_size.width(),
+                  dst_size.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  gl_->BindTexture(GL_TEXTURE_2D, src_texture);
+  gl_->TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, src_size.width(),
+                  src_size.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  const gfx::Rect output_rect(dst_size);
+
+  for (size_t q = 0; q < arraysize(kQualities); q++) {
+    base::TimeTicks start_time = base::TimeTicks::Now();
+    int iterations = 0;
+    base::TimeTicks end_time;
+    while (true) {
+      for (int i = 0; i < 50; i++) {
+        iterations++;
+        std::unique_ptr<GLHelper::ScalerInterface> scaler =
+            helper_->CreateScaler(
+                kQualities[q],
+                gfx::Vector2d(src_size.width(), src_size.height()),
+                gfx::Vector2d(dst_size.width(), dst_size.height()), false,
+                false, false);
+        scaler->Scale(src_texture, src_size, gfx::Vector2dF(), dst_texture,
+                      output_rect);
+        gl_->Flush();
+      }
+      gl_->Finish();
+      end_time = base::TimeTicks::Now();
+      if (iterations > 2000) {
+        break;
+      }
+      if ((end_time - start_time).InMillisecondsF() > 1000) {
+        break;
+      }
+    }
+
+    std::string name = base::StringPrintf(
+        "create_and_scale_%dx%d_to_%dx%d_%s", src_size.width(),
+        src_size.height(), dst_size.width(), dst_size.height(),
+        kQualityNames[q]);
+    float ms = (end_time - start_time).InMillisecondsF() / iterations;
+    VLOG(0) << base::StringPrintf("*RESULT gpu_scale_time: %s=%.2f ms\n",
+                                  name.c_str(), ms);
+  }
+
+  gl_->DeleteTextures(1, &dst_texture);
+  gl_->DeleteTextures(1, &src_texture);
+}
+
 }  // namespace viz
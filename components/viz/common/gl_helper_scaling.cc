@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -66,7 +67,10 @@ GLHelperScaling::GLHelperScaling(GLES2Interface* gl, GLHelper* helper)
   InitBuffer();
 }
 
-GLHelperScaling::~GLHelperScaling() {}
+GLHelperScaling::~GLHelperScaling() {
+  for (const auto& free_texture : free_intermediate_textures_)
+    gl_->DeleteTextures(1, &free_texture.texture);
+}
 
 // Used to keep track of a generated shader program. The program
 // is passed in as text through Setup and is used by calling
@@ -165,7 +169,8 @@ class ScalerImpl : public GLHelper::ScalerInterface {
 
   ~ScalerImpl() override {
     if (intermediate_texture_) {
-      gl_->DeleteTextures(1, &intermediate_texture_);
+      scaler_helper_->ReturnIntermediateTexture(intermediate_texture_,
+                                                intermediate_texture_size_);
     }
   }
 
@@ -428,9 +433,11 @@ class ScalerImpl : public GLHelper::ScalerInterface {
   // Generates the intermediate texture and/or re-defines it if its size has
   // changed.
   void EnsureIntermediateTextureDefined(const gfx::Size& size) {
-    // Reallocate a new texture, if needed.
-    if (!intermediate_texture_)
-      gl_->GenTextures(1, &intermediate_texture_);
+    // Reuse a pooled texture, or allocate a new one, if needed.
+    if (!intermediate_texture_) {
+      intermediate_texture_ = scaler_helper_->TakeIntermediateTexture(
+          size, &intermediate_texture_size_);
+    }
     if (intermediate_texture_size_ != size) {
       gl_->BindTexture(GL_TEXTURE_2D, intermediate_texture_);
       gl_->TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.width(), size.height(), 0,
@@ -760,6 +767,34 @@ std::unique_ptr<GLHelper::ScalerInterface> GLHelperScaling::CreateScaler(
   return ret;
 }
 
+GLuint GLHelperScaling::TakeIntermediateTexture(const gfx::Size& size,
+                                               gfx::Size* texture_size) {
+  for (auto it = free_intermediate_textures_.rbegin();
+       it != free_intermediate_textures_.rend(); ++it) {
+    if (it->size == size) {
+      GLuint texture = it->texture;
+      *texture_size = it->size;
+      free_intermediate_textures_.erase(std::next(it).base());
+      return texture;
+    }
+  }
+  GLuint texture = 0;
+  gl_->GenTextures(1, &texture);
+  *texture_size = gfx::Size();
+  return texture;
+}
+
+void GLHelperScaling::ReturnIntermediateTexture(GLuint texture,
+                                                const gfx::Size& size) {
+  // Enough for a few multi-stage scalers of different sizes.
+  constexpr size_t kMaxFreeIntermediateTextures = 8;
+  if (free_intermediate_textures_.size() == kMaxFreeIntermediateTextures) {
+    gl_->DeleteTextures(1, &free_intermediate_textures_.front().texture);
+    free_intermediate_textures_.erase(free_intermediate_textures_.begin());
+  }
+  free_intermediate_textures_.push_back({texture, size});
+}
+
 std::unique_ptr<GLHelper::ScalerInterface>
 GLHelperScaling::CreateGrayscalePlanerizer(bool flipped_source,
                                            bool flip_output,
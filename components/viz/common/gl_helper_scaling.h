@@ -12,6 +12,7 @@
 #include "base/macros.h"
 #include "components/viz/common/gl_helper.h"
 #include "components/viz/common/viz_common_export.h"
+#include "ui/gfx/geometry/size.h"
 #include "ui/gfx/geometry/vector2d.h"
 
 namespace viz {
@@ -172,6 +173,17 @@ class VIZ_COMMON_EXPORT GLHelperScaling {
 
   scoped_refptr<ShaderProgram> GetShaderProgram(ShaderType type, bool swizzle);
 
+  // Intermediate textures are recycled across ScalerImpl lifetimes, since
+  // readback clients tend to create a new scaler for each capture of the same
+  // size. TakeIntermediateTexture() returns a free texture already defined
+  // with |size| if there is one, and otherwise a new, undefined texture (with
+  // an empty |*texture_size|). ReturnIntermediateTexture() hands a texture
+  // back to the pool, deleting the least recently returned one if the pool is
+  // full.
+  GLuint TakeIntermediateTexture(const gfx::Size& size,
+                                 gfx::Size* texture_size);
+  void ReturnIntermediateTexture(GLuint texture, const gfx::Size& size);
+
   // Interleaved array of 2-dimentional vertex positions (x, y) and
   // 2-dimentional texture coordinates (s, t).
   static const GLfloat kVertexAttributes[];
@@ -185,6 +197,13 @@ class VIZ_COMMON_EXPORT GLHelperScaling {
 
   std::map<ShaderProgramKeyType, scoped_refptr<ShaderProgram>> shader_programs_;
 
+  struct FreeIntermediateTexture {
+    GLuint texture;
+    gfx::Size size;
+  };
+  // Ordered from least to most recently returned.
+  std::vector<FreeIntermediateTexture> free_intermediate_textures_;
+
   friend class ShaderProgram;
   friend class ScalerImpl;
   friend class GLHelperBenchmark;
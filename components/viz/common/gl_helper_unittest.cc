@@ -1250,6 +1250,29 @@ class GLHelperTest : public testing::Test {
                    "8x1 -> 1x1 bilinear4 X\n");
   }
 
+  void CheckIntermediateTexturePoolTest() {
+    const gfx::Size size(64, 32);
+    gfx::Size texture_size;
+    GLuint texture =
+        helper_scaling_->TakeIntermediateTexture(size, &texture_size);
+    EXPECT_NE(0u, texture);
+    EXPECT_TRUE(texture_size.IsEmpty());
+    helper_scaling_->ReturnIntermediateTexture(texture, size);
+
+    // A texture of another size is not handed out for |size|.
+    GLuint other_texture = helper_scaling_->TakeIntermediateTexture(
+        gfx::Size(16, 16), &texture_size);
+    EXPECT_NE(texture, other_texture);
+    EXPECT_TRUE(texture_size.IsEmpty());
+
+    EXPECT_EQ(texture,
+              helper_scaling_->TakeIntermediateTexture(size, &texture_size));
+    EXPECT_EQ(size, texture_size);
+
+    gl_->DeleteTextures(1, &texture);
+    gl_->DeleteTextures(1, &other_texture);
+  }
+
   std::unique_ptr<gpu::GLInProcessContext> context_;
   gpu::gles2::GLES2Interface* gl_;
   std::unique_ptr<GLHelper> helper_;
@@ -1396,6 +1419,11 @@ TEST_F(GLHelperTest, CheckOptimizations) {
   CheckOptimizationsTest();
 }
 
+TEST_F(GLHelperTest, IntermediateTexturePool) {
+  // Test in baseclass since it is friends with GLHelperScaling
+  CheckIntermediateTexturePoolTest();
+}
+
 }  // namespace viz
 
 #endif  // OS_ANDROID
@@ -346,6 +346,28 @@ TEST_F(SurfaceReferencesTest, LiveSurfaceStillReachable) {
   EXPECT_EQ(nullptr, GetSurfaceManager().GetSurfaceForId(id2));
 }
 
+// Verify that a destroyed surface with one unreachable parent and one live
+// parent is kept, and that deleting the unreachable parent drops its reference.
+TEST_F(SurfaceReferencesTest, SurfaceWithLiveAndDeadParentsStillReachable) {
+  SurfaceId id1 = CreateSurface(kFrameSink1, 1);
+  SurfaceId id2 = CreateSurface(kFrameSink2, 1);
+  SurfaceId id3 = CreateSurface(kFrameSink3, 1);
+
+  AddSurfaceReference(GetSurfaceManager().GetRootSurfaceId(), id1);
+  AddSurfaceReference(id1, id3);
+  AddSurfaceReference(id2, id3);
+  ASSERT_THAT(GetReferencesFor(id3), UnorderedElementsAre(id1, id2));
+
+  DestroySurface(id2);
+  DestroySurface(id3);
+  GetSurfaceManager().GarbageCollectSurfaces();
+
+  EXPECT_NE(nullptr, GetSurfaceManager().GetSurfaceForId(id1));
+  EXPECT_EQ(nullptr, GetSurfaceManager().GetSurfaceForId(id2));
+  EXPECT_NE(nullptr, GetSurfaceManager().GetSurfaceForId(id3));
+  EXPECT_THAT(GetReferencesFor(id3), ElementsAre(id1));
+}
+
 TEST_F(SurfaceReferencesTest, TryAddReferenceSameReferenceTwice) {
   frame_sink_manager_client_->SetFrameSinkHierarchy(kFrameSink1, kFrameSink2);
 
@@ -10,6 +10,7 @@
 
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/lazy_instance.h"
 #include "base/memory/shared_memory.h"
 #include "base/run_loop.h"
@@ -25,6 +26,7 @@
 #include "gpu/command_buffer/service/scheduler.h"
 #include "gpu/command_buffer/service/sync_point_manager.h"
 #include "gpu/config/dx_diag_node.h"
+#include "gpu/config/gpu_finch_features.h"
 #include "gpu/config/gpu_info_collector.h"
 #include "gpu/config/gpu_switches.h"
 #include "gpu/config/gpu_util.h"
@@ -84,6 +86,12 @@ namespace viz {
 
 namespace {
 
+// Long enough that a client flushing a normal frame's worth of commands is not
+// interrupted, short enough to keep other clients of the same priority within
+// a frame when time slicing is enabled.
+constexpr base::TimeDelta kSchedulerTimeSlice =
+    base::TimeDelta::FromMilliseconds(4);
+
 static base::LazyInstance<base::Callback<
     void(int severity, size_t message_start, const std::string& message)>>::
     Leaky g_log_callback = LAZY_INSTANCE_INITIALIZER;
@@ -275,6 +283,8 @@ void GpuServiceImpl::InitializeWithHost(
 
   scheduler_ =
       std::make_unique<gpu::Scheduler>(main_runner_, sync_point_manager_);
+  if (base::FeatureList::IsEnabled(features::kGpuSchedulerTimeSlicing))
+    scheduler_->SetTimeSlice(kSchedulerTimeSlice);
 
   skia_output_surface_sequence_id_ =
       scheduler_->CreateSequence(gpu::SchedulingPriority::kHigh);
@@ -4,6 +4,8 @@
 
 #include "components/viz/service/surfaces/surface_hittest.h"
 
+#include "base/metrics/histogram_macros.h"
+#include "base/timer/elapsed_timer.h"
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/quads/draw_quad.h"
 #include "components/viz/common/quads/render_pass_draw_quad.h"
@@ -35,10 +37,15 @@ SurfaceId SurfaceHittest::GetTargetSurfaceAtPoint(
 
   *out_query_renderer = false;
 
+  base::ElapsedTimer hittest_timer;
   std::set<const RenderPass*> referenced_passes;
   GetTargetSurfaceAtPointInternal(root_surface_id, 0, point, &referenced_passes,
                                   &out_surface_id, transform,
                                   out_query_renderer);
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Event.VizHitTest.SurfaceHittestTimeUs", hittest_timer.Elapsed(),
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(10),
+      50);
   // Any point that hits an OOPIF can defer to renderer-based hit testing
   // in order to check whether there might be transparent elements
   // occluding it. Such elements would not have DrawQuads present here.
@@ -124,11 +131,12 @@ bool SurfaceHittest::GetTargetSurfaceAtPointInternal(
   gfx::Point point_in_render_pass_space(point_in_root_target);
   transform_from_root_target.TransformPoint(&point_in_render_pass_space);
   bool non_surface_was_hit = false;
+  InverseTransformCache inverse_transform_cache;
 
   for (const DrawQuad* quad : render_pass->quad_list) {
     gfx::Transform target_to_quad_transform;
     gfx::Point point_in_quad_space;
-    if (!PointInQuad(quad, point_in_render_pass_space,
+    if (!PointInQuad(quad, point_in_render_pass_space, &inverse_transform_cache,
                      &target_to_quad_transform, &point_in_quad_space)) {
       if (target_to_quad_transform.HasPerspective()) {
         *out_query_renderer = true;
@@ -328,10 +336,12 @@ const RenderPass* SurfaceHittest::GetRenderPassForSurfaceById(
   return nullptr;
 }
 
-bool SurfaceHittest::PointInQuad(const DrawQuad* quad,
-                                 const gfx::Point& point_in_render_pass_space,
-                                 gfx::Transform* target_to_quad_transform,
-                                 gfx::Point* point_in_quad_space) {
+bool SurfaceHittest::PointInQuad(
+    const DrawQuad* quad,
+    const gfx::Point& point_in_render_pass_space,
+    InverseTransformCache* inverse_transform_cache,
+    gfx::Transform* target_to_quad_transform,
+    gfx::Point* point_in_quad_space) {
   // First we test against the clip_rect. The clip_rect is in target space, so
   // we can test the point directly.
   if (quad->shared_quad_state->is_clipped &&
@@ -342,9 +352,16 @@ bool SurfaceHittest::PointInQuad(const DrawQuad* quad,
 
   // We now transform the point to content space and test if it hits the
   // rect.
-  gfx::Transform transform = quad->shared_quad_state->quad_to_target_transform;
-  transform.FlattenTo2d();
-  if (!transform.GetInverse(target_to_quad_transform) ||
+  if (inverse_transform_cache->shared_quad_state != quad->shared_quad_state) {
+    gfx::Transform transform =
+        quad->shared_quad_state->quad_to_target_transform;
+    transform.FlattenTo2d();
+    inverse_transform_cache->shared_quad_state = quad->shared_quad_state;
+    inverse_transform_cache->invertible = transform.GetInverse(
+        &inverse_transform_cache->target_to_quad_transform);
+  }
+  *target_to_quad_transform = inverse_transform_cache->target_to_quad_transform;
+  if (!inverse_transform_cache->invertible ||
       target_to_quad_transform->HasPerspective()) {
     return false;
   }
@@ -10,10 +10,10 @@
 #include "components/viz/common/quads/render_pass.h"
 #include "components/viz/common/surfaces/surface_id.h"
 #include "components/viz/service/viz_service_export.h"
+#include "ui/gfx/transform.h"
 
 namespace gfx {
 class Point;
-class Transform;
 }  // namespace gfx
 
 namespace cc {
@@ -23,6 +23,7 @@ class RenderPass;
 
 namespace viz {
 
+class SharedQuadState;
 class SurfaceHittestDelegate;
 class SurfaceManager;
 
@@ -62,6 +63,15 @@ class VIZ_SERVICE_EXPORT SurfaceHittest {
                                      gfx::PointF* point);
 
  private:
+  // The inverse of the last SharedQuadState's transform seen while walking a
+  // RenderPass. Consecutive quads usually share a SharedQuadState, so this
+  // avoids inverting the same matrix for each of them.
+  struct InverseTransformCache {
+    const SharedQuadState* shared_quad_state = nullptr;
+    bool invertible = false;
+    gfx::Transform target_to_quad_transform;
+  };
+
   bool GetTargetSurfaceAtPointInternal(
       const SurfaceId& surface_id,
       RenderPassId render_pass_id,
@@ -83,6 +93,7 @@ class VIZ_SERVICE_EXPORT SurfaceHittest {
 
   bool PointInQuad(const DrawQuad* quad,
                    const gfx::Point& point_in_render_pass_space,
+                   InverseTransformCache* inverse_transform_cache,
                    gfx::Transform* target_to_quad_transform,
                    gfx::Point* point_in_quad_space);
 
@@ -28,7 +28,8 @@
 namespace viz {
 namespace {
 
-const char kUmaAliveSurfaces[] = "Compositing.SurfaceManager.AliveSurfaces";
+const char kUmaSurfacesAfterGarbageCollection[] =
+    "Compositing.SurfaceManager.SurfacesAfterGarbageCollection";
 
 const char kUmaTemporaryReferences[] =
     "Compositing.SurfaceManager.TemporaryReferences";
@@ -228,21 +229,14 @@ void SurfaceManager::GarbageCollectSurfaces() {
   if (surfaces_to_destroy_.empty())
     return;
 
-  SurfaceIdSet reachable_surfaces = GetLiveSurfacesForReferences();
-
-  // Log the number of reachable surfaces after a garbage collection.
-  UMA_HISTOGRAM_CUSTOM_COUNTS(kUmaAliveSurfaces, reachable_surfaces.size(), 1,
-                              200, 50);
-  // Log the number of temporary references after a garbage collection.
-  UMA_HISTOGRAM_CUSTOM_COUNTS(kUmaTemporaryReferences,
-                              temporary_references_.size(), 1, 200, 50);
-
   std::vector<SurfaceId> surfaces_to_delete;
+  SurfaceIdSet unreachable_surfaces;
 
-  // Delete all destroyed and unreachable surfaces.
+  // Delete all destroyed and unreachable surfaces. Only the destroyed surfaces
+  // and their ancestors are visited, rather than the whole reference graph.
   for (auto iter = surfaces_to_destroy_.begin();
        iter != surfaces_to_destroy_.end();) {
-    if (reachable_surfaces.count(*iter) == 0) {
+    if (!IsSurfaceReachable(*iter, &unreachable_surfaces)) {
       surfaces_to_delete.push_back(*iter);
       iter = surfaces_to_destroy_.erase(iter);
     } else {
@@ -253,6 +247,15 @@ void SurfaceManager::GarbageCollectSurfaces() {
   // ~Surface() draw callback could modify |surfaces_to_destroy_|.
   for (const SurfaceId& surface_id : surfaces_to_delete)
     DestroySurfaceInternal(surface_id);
+
+  // Log the number of surfaces that are still alive after a garbage
+  // collection. This replaces AliveSurfaces, which counted the surfaces found
+  // reachable from the root, as that walk is gone.
+  UMA_HISTOGRAM_CUSTOM_COUNTS(kUmaSurfacesAfterGarbageCollection,
+                              surface_map_.size(), 1, 200, 50);
+  // Log the number of temporary references after a garbage collection.
+  UMA_HISTOGRAM_CUSTOM_COUNTS(kUmaTemporaryReferences,
+                              temporary_references_.size(), 1, 200, 50);
 }
 
 const base::flat_set<SurfaceId>& SurfaceManager::GetSurfacesReferencedByParent(
@@ -266,13 +269,10 @@ const base::flat_set<SurfaceId>& SurfaceManager::GetSurfacesReferencedByParent(
 base::flat_set<SurfaceId>
 SurfaceManager::GetSurfacesThatReferenceChildForTesting(
     const SurfaceId& surface_id) const {
-  base::flat_set<SurfaceId> parents;
-
-  for (auto& parent : references_) {
-    if (parent.second.find(surface_id) != parent.second.end())
-      parents.insert(parent.first);
-  }
-  return parents;
+  auto iter = parent_references_.find(surface_id);
+  if (iter == parent_references_.end())
+    return base::flat_set<SurfaceId>();
+  return iter->second;
 }
 
 Surface* SurfaceManager::GetLatestInFlightSurfaceForFrameSinkId(
@@ -312,41 +312,40 @@ Surface* SurfaceManager::GetLatestInFlightSurfaceForFrameSinkId(
   return nullptr;
 }
 
-SurfaceManager::SurfaceIdSet SurfaceManager::GetLiveSurfacesForReferences() {
-  SurfaceIdSet reachable_surfaces;
-
-  // Walk down from the root and mark each SurfaceId we encounter as
-  // reachable.
+bool SurfaceManager::IsSurfaceReachable(const SurfaceId& surface_id,
+                                        SurfaceIdSet* unreachable_surfaces) {
+  SurfaceIdSet visited_surfaces;
   base::queue<SurfaceId> surface_queue;
-  surface_queue.push(root_surface_id_);
+  visited_surfaces.insert(surface_id);
+  surface_queue.push(surface_id);
 
-  // All surfaces not marked for destruction are reachable.
-  for (auto& map_entry : surface_map_) {
-    if (!IsMarkedForDestruction(map_entry.first)) {
-      reachable_surfaces.insert(map_entry.first);
-      surface_queue.push(map_entry.first);
-    }
-  }
+  while (!surface_queue.empty()) {
+    SurfaceId current_id = surface_queue.front();
+    surface_queue.pop();
 
-  // All surfaces with temporary references are also reachable.
-  for (auto& map_entry : temporary_references_) {
-    const SurfaceId& surface_id = map_entry.first;
-    if (reachable_surfaces.insert(surface_id).second) {
-      surface_queue.push(surface_id);
+    // The root, surfaces not marked for destruction and surfaces with temporary
+    // references are always reachable, and so is everything they reference.
+    if (current_id == root_surface_id_ || HasTemporaryReference(current_id) ||
+        (surface_map_.count(current_id) &&
+         !IsMarkedForDestruction(current_id))) {
+      return true;
     }
-  }
 
-  while (!surface_queue.empty()) {
-    const auto& children = GetSurfacesReferencedByParent(surface_queue.front());
-    for (const SurfaceId& child_id : children) {
-      // Check for cycles when inserting into |reachable_surfaces|.
-      if (reachable_surfaces.insert(child_id).second)
-        surface_queue.push(child_id);
+    auto iter = parent_references_.find(current_id);
+    if (iter != parent_references_.end()) {
+      for (const SurfaceId& parent_id : iter->second) {
+        // Check for cycles when inserting into |visited_surfaces|.
+        if (!unreachable_surfaces->count(parent_id) &&
+            visited_surfaces.insert(parent_id).second) {
+          surface_queue.push(parent_id);
+        }
+      }
     }
-    surface_queue.pop();
   }
 
-  return reachable_surfaces;
+  unreachable_surfaces->insert(visited_surfaces.begin(),
+                               visited_surfaces.end());
+  return false;
 }
 
 void SurfaceManager::AddSurfaceReferenceImpl(
@@ -368,6 +367,7 @@ void SurfaceManager::AddSurfaceReferenceImpl(
   }
 
   references_[parent_id].insert(child_id);
+  parent_references_[child_id].insert(parent_id);
 
   // Add a real reference to child_id.
   persistent_references_by_frame_sink_id_[child_id.frame_sink_id()].insert(
@@ -399,6 +399,7 @@ void SurfaceManager::RemoveSurfaceReferenceImpl(
   iter_parent->second.erase(child_iter);
   if (iter_parent->second.empty())
     references_.erase(iter_parent);
+  RemoveParentReference(parent_id, child_id);
 
   // Remove the presistent reference.
   const FrameSinkId& sink_id = child_id.frame_sink_id();
@@ -641,7 +642,22 @@ void SurfaceManager::DestroySurfaceInternal(const SurfaceId& surface_id) {
   // and that's not desirable.
   std::unique_ptr<Surface> doomed = std::move(it->second);
   surface_map_.erase(it);
-  references_.erase(surface_id);
+
+  auto iter = references_.find(surface_id);
+  if (iter != references_.end()) {
+    for (const SurfaceId& child_id : iter->second)
+      RemoveParentReference(surface_id, child_id);
+    references_.erase(iter);
+  }
+}
+
+void SurfaceManager::RemoveParentReference(const SurfaceId& parent_id,
+                                           const SurfaceId& child_id) {
+  auto iter = parent_references_.find(child_id);
+  DCHECK(iter != parent_references_.end());
+  iter->second.erase(parent_id);
+  if (iter->second.empty())
+    parent_references_.erase(iter);
 }
 
 #if DCHECK_IS_ON()
@@ -236,8 +236,13 @@ class VIZ_SERVICE_EXPORT SurfaceManager {
       const SurfaceRange& surface_range,
       const FrameSinkId& sink_id);
 
-  // Returns set of live surfaces for |lifetime_manager_| is REFERENCES.
-  SurfaceIdSet GetLiveSurfacesForReferences();
+  // Returns true if |surface_id| is reachable from the root, from a surface
+  // that isn't marked for destruction or from a temporary reference. Walks the
+  // reference graph upwards from |surface_id|. Every surface visited by a walk
+  // that fails is unreachable and gets added to |unreachable_surfaces|, which
+  // lets later walks in the same garbage collection stop early.
+  bool IsSurfaceReachable(const SurfaceId& surface_id,
+                          SurfaceIdSet* unreachable_surfaces);
 
   // Returns set of live surfaces for |lifetime_manager_| is SEQUENCES.
   SurfaceIdSet GetLiveSurfacesForSequences();
@@ -249,6 +254,11 @@ class VIZ_SERVICE_EXPORT SurfaceManager {
   // Removes a reference from a |parent_id| to |child_id|.
   void RemoveSurfaceReferenceImpl(const SurfaceReference& reference);
 
+  // Removes |parent_id| from the parents of |child_id| in
+  // |parent_references_|.
+  void RemoveParentReference(const SurfaceId& parent_id,
+                             const SurfaceId& child_id);
+
   // Returns whether |surface_id| has a temporary reference or not.
   bool HasTemporaryReference(const SurfaceId& surface_id) const;
 
@@ -311,6 +321,12 @@ class VIZ_SERVICE_EXPORT SurfaceManager {
   std::unordered_map<SurfaceId, base::flat_set<SurfaceId>, SurfaceIdHash>
       references_;
 
+  // The same graph as |references_| in child to parent direction, i.e. the map
+  // stores all direct parents of the surface specified by |SurfaceId|. Garbage
+  // collection walks this so it only visits surfaces near the destroyed ones.
+  std::unordered_map<SurfaceId, base::flat_set<SurfaceId>, SurfaceIdHash>
+      parent_references_;
+
   // A map of surfaces that have temporary references.
   std::unordered_map<SurfaceId, TemporaryReferenceData, SurfaceIdHash>
       temporary_references_;
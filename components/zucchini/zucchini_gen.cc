@@ -15,6 +15,7 @@
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/time/time.h"
 #include "components/zucchini/disassembler.h"
 #include "components/zucchini/element_detection.h"
 #include "components/zucchini/encoded_view.h"
@@ -363,8 +364,12 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
 
     ConstBufferView old_sub_image = old_image[match.old_element.region()];
     ConstBufferView new_sub_image = new_image[new_region];
+    base::TimeTicks element_start_time = base::TimeTicks::Now();
     if (GenerateExecutableElement(match.exe_type(), old_sub_image,
                                   new_sub_image, &patch_element)) {
+      LOG(INFO) << "Element generated in "
+                << (base::TimeTicks::Now() - element_start_time).InSecondsF()
+                << " s";
       covered_new_regions.push_back(new_region);
       covered_new_bytes += new_region.size;
     } else {
@@ -381,8 +386,13 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
     Element entire_old_element(old_image.local_region(), kExeTypeNoOp);
     ImageIndex old_image_index(old_image);
     EncodedView old_view_raw(old_image_index);
+    base::TimeTicks suffix_array_start_time = base::TimeTicks::Now();
     std::vector<offset_t> old_sa_raw =
         MakeSuffixArray<InducedSuffixSort>(old_view_raw, size_t(256));
+    LOG(INFO) << "Gap suffix array built in "
+              << (base::TimeTicks::Now() - suffix_array_start_time)
+                     .InSecondsF()
+              << " s";
 
     offset_t gap_lo = 0;
     // Add sentinel that points to end of "new" file, to simplify gap iteration.
@@ -22,6 +22,22 @@
 
 namespace content {
 
+namespace {
+
+// Drops the responses that the HttpCache of |getter| holds in memory, since
+// they may have been read from entries that were doomed through its backend.
+void ClearHotEntries(net::URLRequestContextGetter* getter) {
+  // Caches might not exist in tests.
+  if (!getter)
+    return;
+  getter->GetURLRequestContext()
+      ->http_transaction_factory()
+      ->GetCache()
+      ->ClearHotEntries();
+}
+
+}  // namespace
+
 StoragePartitionHttpCacheDataRemover::StoragePartitionHttpCacheDataRemover(
     base::Callback<bool(const GURL&)> url_predicate,
     base::Time delete_begin,
@@ -192,6 +208,9 @@ void StoragePartitionHttpCacheDataRemover::DoClearCache(int rv) {
         cache_ = nullptr;
         next_cache_state_ = CacheState::NONE;
 
+        ClearHotEntries(main_context_getter_.get());
+        ClearHotEntries(media_context_getter_.get());
+
         // Notify the UI thread that we are done.
         BrowserThread::PostTask(
             BrowserThread::UI, FROM_HERE,
@@ -4,6 +4,7 @@
 
 #include "content/browser/byte_stream.h"
 
+#include <iterator>
 #include <set>
 #include <utility>
 
@@ -392,9 +393,16 @@ void ByteStreamReaderImpl::TransferDataInternal(
   bool was_empty = available_contents_.empty();
 
   if (transfer_buffer) {
-    available_contents_.insert(available_contents_.end(),
-                               transfer_buffer->begin(),
-                               transfer_buffer->end());
+    // Take the writer's batch wholesale when we have nothing queued, and move
+    // the buffers otherwise, to avoid a refcount round trip per chunk.
+    if (was_empty) {
+      available_contents_.swap(*transfer_buffer);
+    } else {
+      available_contents_.insert(
+          available_contents_.end(),
+          std::make_move_iterator(transfer_buffer->begin()),
+          std::make_move_iterator(transfer_buffer->end()));
+    }
   }
 
   if (source_complete) {
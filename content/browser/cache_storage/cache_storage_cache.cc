@@ -67,6 +67,9 @@ const size_t kMaxQueryCacheResultBytes =
 
 const char kRecordBytesLabel[] = "DiskCache.CacheStorage";
 
+// The number of parsed entry metadata protos kept in memory per cache.
+const size_t kMaxCachedMetadataEntries = 512;
+
 // The range of the padding added to response sizes for opaque resources.
 // Increment padding version if changed.
 const uint64_t kPaddingRange = 14431 * 1024;
@@ -899,6 +902,7 @@ CacheStorageCache::CacheStorageCache(
       owner_(owner),
       cache_name_(cache_name),
       path_(path),
+      metadata_cache_(kMaxCachedMetadataEntries),
       cache_storage_(cache_storage),
       request_context_getter_(std::move(request_context_getter)),
       quota_manager_proxy_(std::move(quota_manager_proxy)),
@@ -1058,6 +1062,14 @@ void CacheStorageCache::QueryCacheFilterEntry(
     }
   }
 
+  auto cached_metadata = metadata_cache_.Get(entry->GetKey());
+  if (cached_metadata != metadata_cache_.end()) {
+    QueryCacheDidReadMetadata(
+        std::move(query_cache_context), std::move(entry),
+        std::make_unique<proto::CacheMetadata>(*cached_metadata->second));
+    return;
+  }
+
   disk_cache::Entry* entry_ptr = entry.get();
   ReadMetadata(
       entry_ptr,
@@ -1076,6 +1088,11 @@ void CacheStorageCache::QueryCacheDidReadMetadata(
     return;
   }
 
+  if (metadata_cache_.Peek(entry->GetKey()) == metadata_cache_.end()) {
+    metadata_cache_.Put(entry->GetKey(),
+                        std::make_unique<proto::CacheMetadata>(*metadata));
+  }
+
   // If the entry was created before we started adding entry times, then
   // default to using the Response object's time for sorting purposes.
   int64_t entry_time = metadata->has_entry_time()
@@ -1365,6 +1382,7 @@ void CacheStorageCache::WriteSideDataDidWrite(
     int side_data_size_before_write,
     int rv) {
   if (rv != expected_bytes) {
+    ForgetCachedMetadata(entry->GetKey());
     entry->Doom();
     UpdateCacheSize(
         base::BindOnce(std::move(callback), CacheStorageError::kErrorNotFound));
@@ -1494,6 +1512,9 @@ void CacheStorageCache::PutDidCreateEntry(
     return;
   }
 
+  // The new entry replaces whatever was stored under this key.
+  ForgetCachedMetadata(put_context->request->url.spec());
+
   proto::CacheMetadata metadata;
   metadata.set_entry_time(base::Time::Now().ToInternalValue());
   proto::CacheRequest* request_metadata = metadata.mutable_request();
@@ -1780,6 +1801,7 @@ void CacheStorageCache::DeleteDidQueryCache(
           CalculateResponsePadding(*result.response, cache_padding_key_.get(),
                                    entry->GetDataSize(INDEX_SIDE_DATA));
     }
+    ForgetCachedMetadata(entry->GetKey());
     entry->Doom();
   }
 
@@ -1820,9 +1842,16 @@ void CacheStorageCache::KeysDidQueryCache(
   std::move(callback).Run(CacheStorageError::kSuccess, std::move(out_requests));
 }
 
+void CacheStorageCache::ForgetCachedMetadata(const std::string& key) {
+  auto it = metadata_cache_.Peek(key);
+  if (it != metadata_cache_.end())
+    metadata_cache_.Erase(it);
+}
+
 void CacheStorageCache::CloseImpl(base::OnceClosure callback) {
   DCHECK_EQ(BACKEND_OPEN, backend_state_);
 
+  metadata_cache_.Clear();
   backend_.reset();
   post_backend_closed_callback_ = std::move(callback);
 }
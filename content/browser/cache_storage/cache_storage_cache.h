@@ -13,6 +13,7 @@
 
 #include "base/callback.h"
 #include "base/containers/id_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
@@ -413,6 +414,10 @@ class CONTENT_EXPORT CacheStorageCache {
       blink::mojom::CacheStorageError error,
       std::unique_ptr<QueryCacheResults> query_cache_results);
 
+  // Drops the cached metadata for |key|, if any. Called whenever the entry
+  // for |key| is doomed or replaced.
+  void ForgetCachedMetadata(const std::string& key);
+
   void CloseImpl(base::OnceClosure callback);
 
   void SizeImpl(SizeCallback callback);
@@ -466,6 +471,12 @@ class CONTENT_EXPORT CacheStorageCache {
   const std::string cache_name_;
   base::FilePath path_;
 
+  // Parsed metadata of recently read entries, keyed by entry key (the request
+  // URL). Lets repeated matches skip the INDEX_HEADERS read and proto parse.
+  // Entries are erased whenever the backend entry is doomed or replaced.
+  base::MRUCache<std::string, std::unique_ptr<proto::CacheMetadata>>
+      metadata_cache_;
+
   // Raw pointer is safe because CacheStorage owns this object.
   CacheStorage* cache_storage_;
 
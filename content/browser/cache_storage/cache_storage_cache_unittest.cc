@@ -1310,6 +1310,20 @@ TEST_P(CacheStorageCacheTestP, Vary) {
   EXPECT_FALSE(Match(body_request_));
 }
 
+TEST_P(CacheStorageCacheTestP, VaryReplaced) {
+  body_request_.headers["vary_foo"] = "foo";
+  blink::mojom::FetchAPIResponsePtr body_response = CreateBlobBodyResponse();
+  body_response->headers["vary"] = "vary_foo";
+  EXPECT_TRUE(Put(body_request_, std::move(body_response)));
+  EXPECT_TRUE(Match(body_request_));
+
+  // Replacing the entry must drop the Vary header remembered from the
+  // previous match.
+  EXPECT_TRUE(Put(body_request_, CreateBlobBodyResponse()));
+  body_request_.headers["vary_foo"] = "bar";
+  EXPECT_TRUE(Match(body_request_));
+}
+
 TEST_P(CacheStorageCacheTestP, EmptyVary) {
   blink::mojom::FetchAPIResponsePtr body_response = CreateBlobBodyResponse();
   body_response->headers["vary"] = "";
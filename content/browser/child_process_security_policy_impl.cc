@@ -5,6 +5,7 @@
 #include "content/browser/child_process_security_policy_impl.h"
 
 #include <algorithm>
+#include <unordered_map>
 #include <utility>
 
 #include "base/command_line.h"
@@ -38,6 +39,7 @@
 #include "storage/browser/fileapi/isolated_context.h"
 #include "storage/common/fileapi/file_system_util.h"
 #include "url/gurl.h"
+#include "url/interned_origin.h"
 
 namespace content {
 
@@ -121,7 +123,8 @@ class ChildProcessSecurityPolicyImpl::SecurityState {
   void GrantCommitOrigin(const url::Origin& origin) {
     if (origin.unique())
       return;
-    origin_map_[origin] = CommitRequestPolicy::kCommitAndRequest;
+    origin_map_[url::InternedOrigin::Intern(origin)] =
+        CommitRequestPolicy::kCommitAndRequest;
   }
 
   void GrantRequestOrigin(const url::Origin& origin) {
@@ -129,7 +132,8 @@ class ChildProcessSecurityPolicyImpl::SecurityState {
       return;
     // Anything already in |origin_map_| must have at least request permission
     // already. In that case, the emplace() below will be a no-op.
-    origin_map_.emplace(origin, CommitRequestPolicy::kRequestOnly);
+    origin_map_.emplace(url::InternedOrigin::Intern(origin),
+                        CommitRequestPolicy::kRequestOnly);
   }
 
   void GrantCommitScheme(const std::string& scheme) {
@@ -213,30 +217,8 @@ class ChildProcessSecurityPolicyImpl::SecurityState {
 
   // Determine whether permission has been granted to commit |url|.
   bool CanCommitURL(const GURL& url) {
-    DCHECK(!url.SchemeIsBlob() && !url.SchemeIsFileSystem())
-        << "inner_url extraction should be done already.";
-    // Having permission to a scheme implies permission to all of its URLs.
-    auto scheme_judgment = scheme_map_.find(url.scheme());
-    if (scheme_judgment != scheme_map_.end() &&
-        scheme_judgment->second == CommitRequestPolicy::kCommitAndRequest) {
-      return true;
-    }
-
-    // Check for permission for specific origin.
-    if (CanCommitOrigin(url::Origin::Create(url)))
-      return true;
-
-    // file:// URLs may sometimes be more granular, e.g. dragging and dropping a
-    // file from the local filesystem. The child itself may not have been
-    // granted access to the entire file:// scheme, but it should still be
-    // allowed to request the dragged and dropped file.
-    if (url.SchemeIs(url::kFileScheme)) {
-      base::FilePath path;
-      if (net::FileURLToFilePath(url, &path))
-        return base::ContainsKey(request_file_set_, path);
-    }
-
-    return false;  // Unmentioned schemes are disallowed.
+    return CanCommitURL(url,
+                        url::InternedOrigin::Find(url::Origin::Create(url)));
   }
 
   bool CanRequestURL(const GURL& url) {
@@ -247,12 +229,14 @@ class ChildProcessSecurityPolicyImpl::SecurityState {
     if (scheme_judgment != scheme_map_.end())
       return true;
 
-    if (CanRequestOrigin(url::Origin::Create(url)))
+    // Only granted origins are interned, so there's no need to intern others.
+    url::InternedOrigin origin =
+        url::InternedOrigin::Find(url::Origin::Create(url));
+    if (CanRequestOrigin(origin))
       return true;
 
     // Otherwise, delegate to CanCommitURL. Unmentioned schemes are disallowed.
-    // TODO(dcheng): It would be nice to avoid constructing the origin twice.
-    return CanCommitURL(url);
+    return CanCommitURL(url, origin);
   }
 
   // Determine if the certain permissions have been granted to a file.
@@ -329,21 +313,54 @@ class ChildProcessSecurityPolicyImpl::SecurityState {
     kCommitAndRequest,
   };
 
-  bool CanCommitOrigin(const url::Origin& origin) {
+  // Same as CanCommitURL(url), given the origin of |url|.
+  bool CanCommitURL(const GURL& url, const url::InternedOrigin& origin) {
+    DCHECK(!url.SchemeIsBlob() && !url.SchemeIsFileSystem())
+        << "inner_url extraction should be done already.";
+    // Having permission to a scheme implies permission to all of its URLs.
+    auto scheme_judgment = scheme_map_.find(url.scheme());
+    if (scheme_judgment != scheme_map_.end() &&
+        scheme_judgment->second == CommitRequestPolicy::kCommitAndRequest) {
+      return true;
+    }
+
+    // Check for permission for specific origin.
+    if (CanCommitOrigin(origin))
+      return true;
+
+    // file:// URLs may sometimes be more granular, e.g. dragging and dropping a
+    // file from the local filesystem. The child itself may not have been
+    // granted access to the entire file:// scheme, but it should still be
+    // allowed to request the dragged and dropped file.
+    if (url.SchemeIs(url::kFileScheme)) {
+      base::FilePath path;
+      if (net::FileURLToFilePath(url, &path))
+        return base::ContainsKey(request_file_set_, path);
+    }
+
+    return false;  // Unmentioned schemes are disallowed.
+  }
+
+  bool CanCommitOrigin(const url::InternedOrigin& origin) {
     auto it = origin_map_.find(origin);
     if (it == origin_map_.end())
       return false;
     return it->second == CommitRequestPolicy::kCommitAndRequest;
   }
 
-  bool CanRequestOrigin(const url::Origin& origin) {
+  bool CanRequestOrigin(const url::InternedOrigin& origin) {
     // Anything already in |origin_map_| must have at least request permissions
     // already.
     return origin_map_.find(origin) != origin_map_.end();
   }
 
   typedef std::map<std::string, CommitRequestPolicy> SchemeMap;
-  typedef std::map<url::Origin, CommitRequestPolicy> OriginMap;
+  // Keyed by interned origins, since it's looked up for most navigation and
+  // request checks.
+  typedef std::unordered_map<url::InternedOrigin,
+                             CommitRequestPolicy,
+                             url::InternedOrigin::Hash>
+      OriginMap;
 
   typedef int FilePermissionFlags;  // bit-set of base::File::Flags
   typedef std::map<base::FilePath, FilePermissionFlags> FileMap;
@@ -1086,6 +1086,28 @@ TEST_F(ChildProcessSecurityPolicyTest, OriginGranting) {
 
   p->Remove(kRendererID);
 }
+
+// File origins of different hosts serialize the same, but are granted
+// separately.
+TEST_F(ChildProcessSecurityPolicyTest, OriginGrantingForFileHosts) {
+  ChildProcessSecurityPolicyImpl* p =
+      ChildProcessSecurityPolicyImpl::GetInstance();
+
+  p->Add(kRendererID);
+
+  GURL url_host_a("file://host-a/share/file");
+  GURL url_host_b("file://host-b/share/file");
+
+  p->GrantCommitOrigin(kRendererID, url::Origin::Create(url_host_a));
+
+  EXPECT_TRUE(p->CanRequestURL(kRendererID, url_host_a));
+  EXPECT_TRUE(p->CanCommitURL(kRendererID, url_host_a));
+  EXPECT_FALSE(p->CanRequestURL(kRendererID, url_host_b));
+  EXPECT_FALSE(p->CanCommitURL(kRendererID, url_host_b));
+
+  p->Remove(kRendererID);
+}
+
 // Verifies ChildProcessSecurityPolicyImpl::AddIsolatedOrigins method.
 TEST_F(ChildProcessSecurityPolicyTest, AddIsolatedOrigins) {
   url::Origin foo = url::Origin::Create(GURL("https://foo.com/"));
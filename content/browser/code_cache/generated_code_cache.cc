@@ -269,6 +269,7 @@ int GeneratedCodeCache::ClearCache(net::CompletionCallback callback) {
     return net::ERR_IO_PENDING;
   }
 
+  active_fetches_.clear();
   return backend_->DoomAllEntries(std::move(callback));
 }
 
@@ -337,6 +338,8 @@ void GeneratedCodeCache::WriteDataImpl(
   if (backend_state_ != kInitialized)
     return;
 
+  active_fetches_.erase(key);
+
   scoped_refptr<base::RefCountedData<disk_cache::Entry*>> entry_ptr =
       new base::RefCountedData<disk_cache::Entry*>();
   net::CompletionOnceCallback callback =
@@ -402,28 +405,41 @@ void GeneratedCodeCache::FetchEntryImpl(const std::string& key,
     return;
   }
 
+  // Join a read of the same entry if there is one in progress.
+  auto it = active_fetches_.find(key);
+  if (it != active_fetches_.end()) {
+    it->second->data.push_back(std::move(read_data_callback));
+    return;
+  }
+
+  scoped_refptr<FetchCallbacks> callbacks =
+      base::MakeRefCounted<FetchCallbacks>();
+  callbacks->data.push_back(std::move(read_data_callback));
+  active_fetches_.emplace(key, callbacks);
+
   scoped_refptr<base::RefCountedData<disk_cache::Entry*>> entry_ptr =
       new base::RefCountedData<disk_cache::Entry*>();
 
   net::CompletionOnceCallback callback = base::BindOnce(
       &GeneratedCodeCache::OpenCompleteForReadData,
-      weak_ptr_factory_.GetWeakPtr(), read_data_callback, entry_ptr);
+      weak_ptr_factory_.GetWeakPtr(), key, callbacks, entry_ptr);
 
   // This is a part of loading cycle and hence should run with a high priority.
   int result = backend_->OpenEntry(key, net::HIGHEST, &entry_ptr->data,
                                    std::move(callback));
   if (result != net::ERR_IO_PENDING) {
-    OpenCompleteForReadData(read_data_callback, entry_ptr, result);
+    OpenCompleteForReadData(key, callbacks, entry_ptr, result);
   }
 }
 
 void GeneratedCodeCache::OpenCompleteForReadData(
-    ReadDataCallback read_data_callback,
+    const std::string& key,
+    scoped_refptr<FetchCallbacks> callbacks,
     scoped_refptr<base::RefCountedData<disk_cache::Entry*>> entry,
     int rv) {
   if (rv != net::OK) {
-    CollectStatistics(CacheEntryStatus::kMiss);
-    std::move(read_data_callback).Run(base::Time(), std::vector<uint8_t>());
+    RunFetchCallbacks(key, callbacks, CacheEntryStatus::kMiss, base::Time(),
+                      std::vector<uint8_t>());
     return;
   }
 
@@ -436,28 +452,50 @@ void GeneratedCodeCache::OpenCompleteForReadData(
       base::MakeRefCounted<net::IOBufferWithSize>(size);
   net::CompletionOnceCallback callback = base::BindOnce(
       &GeneratedCodeCache::ReadDataComplete, weak_ptr_factory_.GetWeakPtr(),
-      read_data_callback, buffer);
+      key, callbacks, buffer);
   int result = disk_entry->ReadData(kDataIndex, 0, buffer.get(), size,
                                     std::move(callback));
   if (result != net::ERR_IO_PENDING) {
-    ReadDataComplete(read_data_callback, buffer, result);
+    ReadDataComplete(key, callbacks, buffer, result);
   }
 }
 
 void GeneratedCodeCache::ReadDataComplete(
-    ReadDataCallback callback,
+    const std::string& key,
+    scoped_refptr<FetchCallbacks> callbacks,
     scoped_refptr<net::IOBufferWithSize> buffer,
     int rv) {
-  if (rv != buffer->size()) {
-    CollectStatistics(CacheEntryStatus::kMiss);
-    std::move(callback).Run(base::Time(), std::vector<uint8_t>());
-  } else {
-    CollectStatistics(CacheEntryStatus::kHit);
-    int64_t raw_response_time = *(reinterpret_cast<int64_t*>(buffer->data()));
-    base::Time response_time = base::Time::FromDeltaSinceWindowsEpoch(
-        base::TimeDelta::FromMicroseconds(raw_response_time));
-    std::vector<uint8_t> data(buffer->data() + kResponseTimeSizeInBytes,
-                              buffer->data() + buffer->size());
+  if (rv != buffer->size() || rv < kResponseTimeSizeInBytes) {
+    RunFetchCallbacks(key, callbacks, CacheEntryStatus::kMiss, base::Time(),
+                      std::vector<uint8_t>());
+    return;
+  }
+
+  int64_t raw_response_time = *(reinterpret_cast<int64_t*>(buffer->data()));
+  base::Time response_time = base::Time::FromDeltaSinceWindowsEpoch(
+      base::TimeDelta::FromMicroseconds(raw_response_time));
+  std::vector<uint8_t> data(buffer->data() + kResponseTimeSizeInBytes,
+                            buffer->data() + buffer->size());
+  RunFetchCallbacks(key, callbacks, CacheEntryStatus::kHit, response_time,
+                    data);
+}
+
+void GeneratedCodeCache::RunFetchCallbacks(
+    const std::string& key,
+    scoped_refptr<FetchCallbacks> callbacks,
+    CacheEntryStatus status,
+    const base::Time& response_time,
+    const std::vector<uint8_t>& data) {
+  // A write or delete may have removed this read already and a newer read
+  // of the same key may be in progress.
+  auto it = active_fetches_.find(key);
+  if (it != active_fetches_.end() && it->second == callbacks)
+    active_fetches_.erase(it);
+
+  std::vector<ReadDataCallback> read_callbacks;
+  read_callbacks.swap(callbacks->data);
+  for (ReadDataCallback& callback : read_callbacks) {
+    CollectStatistics(status);
     std::move(callback).Run(response_time, data);
   }
 }
@@ -466,12 +504,14 @@ void GeneratedCodeCache::DeleteEntryImpl(const std::string& key) {
   if (backend_state_ != kInitialized)
     return;
 
+  active_fetches_.erase(key);
   CollectStatistics(CacheEntryStatus::kClear);
   backend_->DoomEntry(key, net::LOWEST, net::CompletionOnceCallback());
 }
 
 void GeneratedCodeCache::DoPendingClearCache(
     net::CompletionCallback user_callback) {
+  active_fetches_.clear();
   int result = backend_->DoomAllEntries(user_callback);
   if (result != net::ERR_IO_PENDING) {
     // Call the callback here because we returned ERR_IO_PENDING for initial
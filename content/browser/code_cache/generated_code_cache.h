@@ -5,6 +5,8 @@
 #ifndef CONTENT_BROWSER_CODE_CACHE_GENERATED_CODE_CACHE_H_
 #define CONTENT_BROWSER_CODE_CACHE_GENERATED_CODE_CACHE_H_
 
+#include <map>
+
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
@@ -63,7 +65,8 @@ class CONTENT_EXPORT GeneratedCodeCache {
                  const std::vector<uint8_t>& data);
 
   // Fetch entry corresponding to <url, origin> from the cache and pass
-  // it using the ReadDataCallback.
+  // it using the ReadDataCallback. Fetches for an entry that is already being
+  // read from the disk share that read.
   void FetchEntry(const GURL& url, const url::Origin& origin, ReadDataCallback);
 
   // Delete the entry corresponding to <url, origin>
@@ -115,15 +118,25 @@ class CONTENT_EXPORT GeneratedCodeCache {
       scoped_refptr<base::RefCountedData<disk_cache::Entry*>> entry,
       int rv);
 
+  // Callbacks waiting for a single read of an entry from the disk.
+  using FetchCallbacks = base::RefCountedData<std::vector<ReadDataCallback>>;
+
   // Fetch entry from cache
   void FetchEntryImpl(const std::string& key, ReadDataCallback);
   void OpenCompleteForReadData(
-      ReadDataCallback callback,
+      const std::string& key,
+      scoped_refptr<FetchCallbacks> callbacks,
       scoped_refptr<base::RefCountedData<disk_cache::Entry*>> entry,
       int rv);
-  void ReadDataComplete(ReadDataCallback callback,
+  void ReadDataComplete(const std::string& key,
+                        scoped_refptr<FetchCallbacks> callbacks,
                         scoped_refptr<net::IOBufferWithSize> buffer,
                         int rv);
+  void RunFetchCallbacks(const std::string& key,
+                         scoped_refptr<FetchCallbacks> callbacks,
+                         CacheEntryStatus status,
+                         const base::Time& response_time,
+                         const std::vector<uint8_t>& data);
 
   // Delete entry from cache
   void DeleteEntryImpl(const std::string& key);
@@ -136,6 +149,10 @@ class CONTENT_EXPORT GeneratedCodeCache {
 
   std::vector<std::unique_ptr<PendingOperation>> pending_ops_;
 
+  // Reads that are in progress, keyed on the cache key. Writes and deletes
+  // remove the key so that later fetches don't join a read of stale data.
+  std::map<std::string, scoped_refptr<FetchCallbacks>> active_fetches_;
+
   base::FilePath path_;
   int max_size_bytes_;
 
@@ -80,6 +80,7 @@ class GeneratedCodeCacheTest : public testing::Test {
 
   void FetchEntryCallback(const base::Time& response_time,
                           const std::vector<uint8_t>& data) {
+    fetch_count_++;
     if (data.size() == 0) {
       received_ = true;
       received_null_ = true;
@@ -101,6 +102,7 @@ class GeneratedCodeCacheTest : public testing::Test {
   base::Time received_response_time_;
   bool received_;
   bool received_null_;
+  int fetch_count_ = 0;
   base::FilePath cache_path_;
 };
 
@@ -226,6 +228,38 @@ TEST_F(GeneratedCodeCacheTest, UpdateDataOfExistingEntry) {
   EXPECT_EQ(response_time, received_response_time_);
 }
 
+TEST_F(GeneratedCodeCacheTest, ConcurrentFetchesOfSameEntry) {
+  GURL url(kInitialUrl);
+  url::Origin origin = url::Origin::Create(GURL(kInitialOrigin));
+
+  InitializeCache();
+  FetchFromCache(url, origin);
+  FetchFromCache(url, origin);
+  scoped_task_environment_.RunUntilIdle();
+
+  ASSERT_TRUE(received_);
+  EXPECT_EQ(2, fetch_count_);
+  EXPECT_EQ(kInitialData, received_data_);
+}
+
+TEST_F(GeneratedCodeCacheTest, FetchAfterWriteDoesNotJoinEarlierFetch) {
+  GURL url(kInitialUrl);
+  url::Origin origin = url::Origin::Create(GURL(kInitialOrigin));
+
+  InitializeCache();
+  FetchFromCache(url, origin);
+  std::string new_data = "SerializedCodeForScriptOverwrite";
+  base::Time response_time = base::Time::Now();
+  WriteToCache(url, origin, new_data, response_time);
+  FetchFromCache(url, origin);
+  scoped_task_environment_.RunUntilIdle();
+
+  ASSERT_TRUE(received_);
+  EXPECT_EQ(2, fetch_count_);
+  EXPECT_EQ(new_data, received_data_);
+  EXPECT_EQ(response_time, received_response_time_);
+}
+
 TEST_F(GeneratedCodeCacheTest, FetchFailsForNonexistingOrigin) {
   InitializeCache();
   url::Origin new_origin = url::Origin::Create(GURL("http://not-example.com"));
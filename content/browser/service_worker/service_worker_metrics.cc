@@ -44,6 +44,15 @@ const char* StartSituationToSuffix(
   return ".Unknown";
 }
 
+// Records a StartTiming phase split by |situation|, so process launch cost
+// can be told apart from script evaluation cost.
+void RecordStartPhaseTiming(const char* name,
+                            ServiceWorkerMetrics::StartSituation situation,
+                            base::TimeDelta time) {
+  base::UmaHistogramMediumTimes(
+      base::StrCat({name, StartSituationToSuffix(situation)}), time);
+}
+
 // TODO(falken): Remove this when the associated UMA are removed.
 const char* StartSituationToDeprecatedSuffix(
     ServiceWorkerMetrics::StartSituation situation) {
@@ -716,6 +725,9 @@ void ServiceWorkerMetrics::RecordStartWorkerTiming(const StartTimes& times,
   // SentStartWorker milestone.
   UMA_HISTOGRAM_MEDIUM_TIMES("ServiceWorker.StartTiming.StartToSentStartWorker",
                              times.local_start_worker_sent - times.local_start);
+  RecordStartPhaseTiming("ServiceWorker.StartTiming.StartToSentStartWorker",
+                         situation,
+                         times.local_start_worker_sent - times.local_start);
 
   // ReceivedStartWorker milestone.
   UMA_HISTOGRAM_MEDIUM_TIMES(
@@ -724,6 +736,10 @@ void ServiceWorkerMetrics::RecordStartWorkerTiming(const StartTimes& times,
   UMA_HISTOGRAM_MEDIUM_TIMES(
       "ServiceWorker.StartTiming.SentStartWorkerToReceivedStartWorker",
       times.remote_start_worker_received - times.local_start_worker_sent);
+  RecordStartPhaseTiming(
+      "ServiceWorker.StartTiming.SentStartWorkerToReceivedStartWorker",
+      situation,
+      times.remote_start_worker_received - times.local_start_worker_sent);
 
   // ScriptEvaluationStart milestone.
   UMA_HISTOGRAM_MEDIUM_TIMES(
@@ -733,6 +749,11 @@ void ServiceWorkerMetrics::RecordStartWorkerTiming(const StartTimes& times,
       "ServiceWorker.StartTiming.ReceivedStartWorkerToScriptEvaluationStart",
       times.remote_script_evaluation_start -
           times.remote_start_worker_received);
+  RecordStartPhaseTiming(
+      "ServiceWorker.StartTiming.ReceivedStartWorkerToScriptEvaluationStart",
+      situation,
+      times.remote_script_evaluation_start -
+          times.remote_start_worker_received);
 
   // ScriptEvaluationEnd milestone.
   UMA_HISTOGRAM_MEDIUM_TIMES(
@@ -742,11 +763,19 @@ void ServiceWorkerMetrics::RecordStartWorkerTiming(const StartTimes& times,
       "ServiceWorker.StartTiming.ScriptEvaluationStartToScriptEvaluationEnd",
       times.remote_script_evaluation_end -
           times.remote_script_evaluation_start);
+  RecordStartPhaseTiming(
+      "ServiceWorker.StartTiming.ScriptEvaluationStartToScriptEvaluationEnd",
+      situation,
+      times.remote_script_evaluation_end -
+          times.remote_script_evaluation_start);
 
   // End milestone.
   UMA_HISTOGRAM_MEDIUM_TIMES(
       "ServiceWorker.StartTiming.ScriptEvaluationEndToEnd",
       times.local_end - times.remote_script_evaluation_end);
+  RecordStartPhaseTiming("ServiceWorker.StartTiming.ScriptEvaluationEndToEnd",
+                         situation,
+                         times.local_end - times.remote_script_evaluation_end);
 }
 
 void ServiceWorkerMetrics::RecordStartWorkerTimingClockConsistency(
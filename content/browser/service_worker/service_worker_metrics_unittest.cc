@@ -472,6 +472,45 @@ TEST(ServiceWorkerMetricsTest, EmbeddedWorkerStartTiming) {
       CrossProcessTimeDelta::NORMAL, 1);
 }
 
+TEST(ServiceWorkerMetricsTest, EmbeddedWorkerStartTiming_PhasesBySituation) {
+  ServiceWorkerMetrics::StartTimes times;
+  auto current = base::TimeTicks::Now();
+  times.local_start = current;
+  times.local_start_worker_sent = AdvanceTime(&current, 11);
+  times.remote_start_worker_received = AdvanceTime(&current, 333);
+  times.remote_script_evaluation_start = AdvanceTime(&current, 55);
+  times.remote_script_evaluation_end = AdvanceTime(&current, 77);
+  times.local_end = AdvanceTime(&current, 22);
+
+  base::HistogramTester histogram_tester;
+  ServiceWorkerMetrics::RecordStartWorkerTiming(times,
+                                                StartSituation::NEW_PROCESS);
+
+  histogram_tester.ExpectTimeBucketCount(
+      "ServiceWorker.StartTiming.StartToSentStartWorker.NewProcess",
+      times.local_start_worker_sent - times.local_start, 1);
+  histogram_tester.ExpectTimeBucketCount(
+      "ServiceWorker.StartTiming.SentStartWorkerToReceivedStartWorker."
+      "NewProcess",
+      times.remote_start_worker_received - times.local_start_worker_sent, 1);
+  histogram_tester.ExpectTimeBucketCount(
+      "ServiceWorker.StartTiming.ReceivedStartWorkerToScriptEvaluationStart."
+      "NewProcess",
+      times.remote_script_evaluation_start - times.remote_start_worker_received,
+      1);
+  histogram_tester.ExpectTimeBucketCount(
+      "ServiceWorker.StartTiming.ScriptEvaluationStartToScriptEvaluationEnd."
+      "NewProcess",
+      times.remote_script_evaluation_end - times.remote_script_evaluation_start,
+      1);
+  histogram_tester.ExpectTimeBucketCount(
+      "ServiceWorker.StartTiming.ScriptEvaluationEndToEnd.NewProcess",
+      times.local_end - times.remote_script_evaluation_end, 1);
+  histogram_tester.ExpectTotalCount(
+      "ServiceWorker.StartTiming.ScriptEvaluationEndToEnd.ExistingReadyProcess",
+      0);
+}
+
 TEST(ServiceWorkerMetricsTest, EmbeddedWorkerStartTiming_BrowserStartup) {
   ServiceWorkerMetrics::StartTimes times;
   auto current = base::TimeTicks::Now();
@@ -4,6 +4,8 @@
 
 #include "content/browser/startup_task_runner.h"
 
+#include <utility>
+
 #include "base/bind.h"
 #include "base/location.h"
 
@@ -18,7 +20,7 @@ StartupTaskRunner::StartupTaskRunner(
 StartupTaskRunner::~StartupTaskRunner() {}
 
 void StartupTaskRunner::AddTask(StartupTask callback) {
-  task_list_.push_back(callback);
+  task_list_.push_back(std::move(callback));
 }
 
 void StartupTaskRunner::StartRunningTasksAsync() {
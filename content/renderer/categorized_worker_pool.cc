@@ -385,6 +385,14 @@ void CategorizedWorkerPool::RunTaskInCategoryWithLockAcquired(
   lock_.AssertAcquired();
 
   auto prioritized_task = work_queue_.GetNextTaskToRun(category);
+  if (!prioritized_task.ready_time.is_null()) {
+    TRACE_EVENT_INSTANT2(
+        TRACE_DISABLED_BY_DEFAULT("cc.debug"),
+        "CategorizedWorkerPool::QueueDelay", TRACE_EVENT_SCOPE_THREAD,
+        "category", static_cast<int>(category), "delay_us",
+        (base::TimeTicks::Now() - prioritized_task.ready_time)
+            .InMicroseconds());
+  }
 
   // There may be more work available, so wake up another worker thread.
   SignalHasReadyToRunTasksWithLockAcquired();
@@ -56,13 +56,18 @@ class CONTENT_EXPORT WebIDBCursorImpl : public blink::WebIDBCursor {
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorReset);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorTransactionId);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdvancePrefetchTest);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchAmountIsCapped);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchReset);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchTest);
 
   enum { kInvalidCursorId = -1 };
   enum { kPrefetchContinueThreshold = 2 };
   enum { kMinPrefetchAmount = 5 };
-  enum { kMaxPrefetchAmount = 100 };
+  // Long sequential scans (e.g. a sync pass over a whole object store) keep
+  // doubling up to this many records per round trip. The back-end also stops
+  // a prefetch once its size estimate exceeds the IPC budget, so large values
+  // don't make the batch unbounded.
+  enum { kMaxPrefetchAmount = 2000 };
 
   int64_t transaction_id_;
 
@@ -296,6 +296,44 @@ TEST_F(WebIDBCursorImplTest, AdvancePrefetchTest) {
   EXPECT_TRUE(mock_cursor_->destroyed());
 }
 
+TEST_F(WebIDBCursorImplTest, PrefetchAmountIsCapped) {
+  for (int i = 0; i < WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor_->CursorContinue(null_key_.View(), null_key_.View(),
+                            new MockContinueCallbacks());
+  }
+  base::RunLoop().RunUntilIdle();
+
+  // Serve each prefetch with a single record so the cache drains right away,
+  // until the requested amount stops growing.
+  int last_prefetch_count = 0;
+  for (int repetitions = 0; repetitions < 20; ++repetitions) {
+    cursor_->CursorContinue(null_key_.View(), null_key_.View(),
+                            new MockContinueCallbacks());
+    base::RunLoop().RunUntilIdle();
+    EXPECT_EQ(repetitions + 1, mock_cursor_->prefetch_calls());
+
+    int prefetch_count = mock_cursor_->last_prefetch_count();
+    EXPECT_GE(prefetch_count, last_prefetch_count);
+    EXPECT_LE(prefetch_count, WebIDBCursorImpl::kMaxPrefetchAmount);
+    last_prefetch_count = prefetch_count;
+
+    std::vector<IndexedDBKey> keys(1);
+    std::vector<IndexedDBKey> primary_keys(1);
+    std::vector<WebIDBValue> values;
+    values.emplace_back(WebData(), WebVector<WebBlobInfo>());
+    cursor_->SetPrefetchData(std::move(keys), std::move(primary_keys),
+                             std::move(values));
+    MockContinueCallbacks callbacks;
+    cursor_->CachedContinue(&callbacks);
+  }
+  EXPECT_EQ(static_cast<int>(WebIDBCursorImpl::kMaxPrefetchAmount),
+            last_prefetch_count);
+
+  cursor_.reset();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(mock_cursor_->destroyed());
+}
+
 TEST_F(WebIDBCursorImplTest, PrefetchReset) {
   // Call continue() until prefetching should kick in.
   int continue_calls = 0;
@@ -4,15 +4,27 @@
 
 #include "content/renderer/loader/url_response_body_consumer.h"
 
+#include <algorithm>
+
 #include "base/auto_reset.h"
 #include "base/bind.h"
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "content/public/renderer/request_peer.h"
 #include "content/renderer/loader/resource_dispatcher.h"
 #include "services/network/public/cpp/url_loader_completion_status.h"
 
 namespace content {
 
+namespace {
+
+// The time budget for dispatching chunks in a single task. Checked between
+// chunks, so at least one chunk is always dispatched.
+constexpr base::TimeDelta kMaxTimeInTask = base::TimeDelta::FromMilliseconds(2);
+
+}  // namespace
+
+constexpr uint32_t URLResponseBodyConsumer::kMaxChunkSize;
 constexpr uint32_t URLResponseBodyConsumer::kMaxNumConsumedBytesInTask;
 
 class URLResponseBodyConsumer::ReceivedData final
@@ -102,6 +114,7 @@ void URLResponseBodyConsumer::OnReadable(MojoResult unused) {
 
   DCHECK(!is_in_on_readable_);
   uint32_t num_bytes_consumed = 0;
+  const base::TimeTicks start_time = base::TimeTicks::Now();
 
   // Protect |this| as RequestPeer::OnReceivedData may call deref.
   scoped_refptr<URLResponseBodyConsumer> protect(this);
@@ -131,11 +144,13 @@ void URLResponseBodyConsumer::OnReadable(MojoResult unused) {
       return;
     }
     DCHECK_LE(num_bytes_consumed, kMaxNumConsumedBytesInTask);
-    available =
-        std::min(available, kMaxNumConsumedBytesInTask - num_bytes_consumed);
-    if (available == 0) {
-      // We've already consumed many bytes in this task. Defer the remaining
-      // to the next task.
+    available = std::min({available, kMaxChunkSize,
+                          kMaxNumConsumedBytesInTask - num_bytes_consumed});
+    if (available == 0 ||
+        (num_bytes_consumed > 0 &&
+         base::TimeTicks::Now() - start_time >= kMaxTimeInTask)) {
+      // We've already consumed many bytes, or spent long enough, in this
+      // task. Defer the remaining to the next task.
       result = handle_->EndReadData(0);
       DCHECK_EQ(result, MOJO_RESULT_OK);
       handle_watcher_.ArmOrNotify();
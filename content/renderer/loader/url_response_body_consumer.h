@@ -59,12 +59,17 @@ class CONTENT_EXPORT URLResponseBodyConsumer final
 
   void ArmOrNotify();
 
-  // The maximal number of bytes consumed in a task. When there are more bytes
-  // in the data pipe, they will be consumed in following tasks. Setting a too
-  // small number will generate ton of tasks but setting a too large number will
-  // lead to thread janks. Also, some clients cannot handle too large chunks
-  // (512k for example).
-  static constexpr uint32_t kMaxNumConsumedBytesInTask = 64 * 1024;
+  // The maximal number of bytes passed to the peer in a single
+  // OnReceivedData call. Some clients cannot handle too large chunks (512k for
+  // example).
+  static constexpr uint32_t kMaxChunkSize = 64 * 1024;
+
+  // The maximal number of bytes consumed in a task. A task keeps dispatching
+  // chunks while the peer releases them synchronously, until either this
+  // limit or a short time budget is hit; the remaining bytes are consumed in
+  // following tasks. Setting a too small number will generate ton of tasks
+  // but setting a too large number will lead to thread janks.
+  static constexpr uint32_t kMaxNumConsumedBytesInTask = 1024 * 1024;
 
  private:
   friend class base::RefCounted<URLResponseBodyConsumer>;
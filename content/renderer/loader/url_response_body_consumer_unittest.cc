@@ -58,6 +58,7 @@ class TestRequestPeer : public RequestPeer {
   void OnReceivedData(std::unique_ptr<ReceivedData> data) override {
     EXPECT_FALSE(context_->complete);
     context_->data.append(data->payload(), data->length());
+    context_->chunk_lengths.push_back(data->length());
     if (context_->release_data_asynchronously)
       task_runner_->DeleteSoon(FROM_HERE, data.release());
     context_->run_loop_quit_closure.Run();
@@ -76,6 +77,8 @@ class TestRequestPeer : public RequestPeer {
   struct Context {
     // Data received. If downloading to file, remains empty.
     std::string data;
+    // Length of each chunk passed to OnReceivedData.
+    std::vector<int> chunk_lengths;
     bool complete = false;
     base::Closure run_loop_quit_closure;
     int error_code = net::OK;
@@ -290,13 +293,13 @@ TEST_F(URLResponseBodyConsumerTest, CloseThenOnComplete) {
 }
 
 TEST_F(URLResponseBodyConsumerTest, TooBigChunkShouldBeSplit) {
-  constexpr auto kMaxNumConsumedBytesInTask =
-      URLResponseBodyConsumer::kMaxNumConsumedBytesInTask;
+  constexpr auto kMaxChunkSize = URLResponseBodyConsumer::kMaxChunkSize;
   TestRequestPeer::Context context;
+  context.release_data_asynchronously = true;
   std::unique_ptr<network::ResourceRequest> request(CreateResourceRequest());
   int request_id = SetUpRequestPeer(std::move(request), &context);
   auto options = CreateDataPipeOptions();
-  options.capacity_num_bytes = 2 * kMaxNumConsumedBytesInTask;
+  options.capacity_num_bytes = 2 * kMaxChunkSize;
   mojo::DataPipe data_pipe(options);
 
   mojo::ScopedDataPipeProducerHandle writer =
@@ -308,9 +311,8 @@ TEST_F(URLResponseBodyConsumerTest, TooBigChunkShouldBeSplit) {
   ASSERT_EQ(MOJO_RESULT_OK, result);
   ASSERT_EQ(options.capacity_num_bytes, size);
 
-  memset(buffer, 'a', kMaxNumConsumedBytesInTask);
-  memset(static_cast<char*>(buffer) + kMaxNumConsumedBytesInTask, 'b',
-         kMaxNumConsumedBytesInTask);
+  memset(buffer, 'a', kMaxChunkSize);
+  memset(static_cast<char*>(buffer) + kMaxChunkSize, 'b', kMaxChunkSize);
 
   result = writer->EndWriteData(size);
   ASSERT_EQ(MOJO_RESULT_OK, result);
@@ -321,11 +323,53 @@ TEST_F(URLResponseBodyConsumerTest, TooBigChunkShouldBeSplit) {
   consumer->ArmOrNotify();
 
   Run(&context);
-  EXPECT_EQ(std::string(kMaxNumConsumedBytesInTask, 'a'), context.data);
+  EXPECT_EQ(std::string(kMaxChunkSize, 'a'), context.data);
   context.data.clear();
 
   Run(&context);
-  EXPECT_EQ(std::string(kMaxNumConsumedBytesInTask, 'b'), context.data);
+  EXPECT_EQ(std::string(kMaxChunkSize, 'b'), context.data);
+}
+
+TEST_F(URLResponseBodyConsumerTest, ChunksAreBatchedWithinTask) {
+  constexpr auto kMaxChunkSize = URLResponseBodyConsumer::kMaxChunkSize;
+  constexpr auto kMaxNumConsumedBytesInTask =
+      URLResponseBodyConsumer::kMaxNumConsumedBytesInTask;
+  TestRequestPeer::Context context;
+  std::unique_ptr<network::ResourceRequest> request(CreateResourceRequest());
+  int request_id = SetUpRequestPeer(std::move(request), &context);
+  auto options = CreateDataPipeOptions();
+  options.capacity_num_bytes = kMaxNumConsumedBytesInTask + kMaxChunkSize;
+  mojo::DataPipe data_pipe(options);
+
+  mojo::ScopedDataPipeProducerHandle writer =
+      std::move(data_pipe.producer_handle);
+  void* buffer = nullptr;
+  uint32_t size = 0;
+  MojoResult result = writer->BeginWriteData(&buffer, &size, kNone);
+
+  ASSERT_EQ(MOJO_RESULT_OK, result);
+  ASSERT_EQ(options.capacity_num_bytes, size);
+  memset(buffer, 'a', size);
+  result = writer->EndWriteData(size);
+  ASSERT_EQ(MOJO_RESULT_OK, result);
+
+  scoped_refptr<URLResponseBodyConsumer> consumer(new URLResponseBodyConsumer(
+      request_id, dispatcher_.get(), std::move(data_pipe.consumer_handle),
+      message_loop_.task_runner()));
+  consumer->ArmOrNotify();
+
+  // The first task dispatches several chunks of at most kMaxChunkSize bytes,
+  // and stops at the per-task budget before draining the pipe.
+  Run(&context);
+  EXPECT_GT(context.data.size(), kMaxChunkSize);
+  EXPECT_GT(context.chunk_lengths.size(), 1u);
+  EXPECT_LE(context.data.size(), kMaxNumConsumedBytesInTask);
+  for (int length : context.chunk_lengths)
+    EXPECT_LE(static_cast<uint32_t>(length), kMaxChunkSize);
+
+  while (context.data.size() < size)
+    Run(&context);
+  EXPECT_EQ(std::string(size, 'a'), context.data);
 }
 
 }  // namespace
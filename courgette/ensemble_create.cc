@@ -283,6 +283,7 @@ Status GenerateEnsemblePatch(SourceStream* base,
   //
   // Generate sub-patch for parameters.
   //
+  base::Time start_parameters_time = base::Time::Now();
   SinkStreamSet predicted_parameters_sink;
   SinkStreamSet corrected_parameters_sink;
 
@@ -324,9 +325,13 @@ Status GenerateEnsemblePatch(SourceStream* base,
   if (delta1_status != C_OK)
     return delta1_status;
 
+  VLOG(1) << "done parameters sub-patch "
+          << (base::Time::Now() - start_parameters_time).InSecondsF() << "s";
+
   //
   // Generate sub-patch for elements.
   //
+  base::Time start_elements_time = base::Time::Now();
   corrected_parameters_source.Init(linearized_corrected_parameters);
   SourceStreamSet corrected_parameters_source_set;
   if (!corrected_parameters_source_set.Init(&corrected_parameters_source))
@@ -384,12 +389,16 @@ Status GenerateEnsemblePatch(SourceStream* base,
   if (delta2_status != C_OK)
     return delta2_status;
 
+  VLOG(1) << "done elements sub-patch "
+          << (base::Time::Now() - start_elements_time).InSecondsF() << "s";
+
   // Last use, free storage.
   linearized_predicted_transformed_elements.Retire();
 
   //
   // Generate sub-patch for whole enchilada.
   //
+  base::Time start_ensemble_time = base::Time::Now();
   SinkStream predicted_ensemble;
 
   if (!predicted_ensemble.Write(base->Buffer(), base->Remaining()))
@@ -432,6 +441,9 @@ Status GenerateEnsemblePatch(SourceStream* base,
   if (delta3_status != C_OK)
     return delta3_status;
 
+  VLOG(1) << "done ensemble sub-patch "
+          << (base::Time::Now() - start_ensemble_time).InSecondsF() << "s";
+
   //
   // Final output stream has a header followed by a StreamSet.
   //
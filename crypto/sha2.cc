@@ -5,18 +5,20 @@
 #include "crypto/sha2.h"
 
 #include <stddef.h>
-
-#include <memory>
+#include <stdint.h>
 
 #include "base/stl_util.h"
-#include "crypto/secure_hash.h"
+#include "crypto/openssl_util.h"
+#include "third_party/boringssl/src/include/openssl/sha.h"
 
 namespace crypto {
 
 void SHA256HashString(base::StringPiece str, void* output, size_t len) {
-  std::unique_ptr<SecureHash> ctx(SecureHash::Create(SecureHash::SHA256));
-  ctx->Update(str.data(), str.length());
-  ctx->Finish(output, len);
+  // One-shot hashing needs no heap-allocated SecureHash context.
+  ScopedOpenSSLSafeSizeBuffer<SHA256_DIGEST_LENGTH> result(
+      static_cast<unsigned char*>(output), len);
+  SHA256(reinterpret_cast<const uint8_t*>(str.data()), str.length(),
+         result.safe_buffer());
 }
 
 std::string SHA256HashString(base::StringPiece str) {
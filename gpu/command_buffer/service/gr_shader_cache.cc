@@ -4,6 +4,7 @@
 
 #include "gpu/command_buffer/service/gr_shader_cache.h"
 
+#include "base/metrics/histogram_macros.h"
 #include "base/trace_event/trace_event.h"
 
 namespace gpu {
@@ -33,8 +34,12 @@ sk_sp<SkData> GrShaderCache::load(const SkData& key) {
 
   CacheKey cache_key(SkData::MakeWithoutCopy(key.data(), key.size()));
   auto it = store_.Get(cache_key);
-  if (it == store_.end())
+  UMA_HISTOGRAM_BOOLEAN("GPU.GrShaderCache.LoadHit", it != store_.end());
+  if (it == store_.end()) {
+    pending_compile_key_hash_ = cache_key.hash;
+    pending_compile_start_time_ = base::TimeTicks::Now();
     return nullptr;
+  }
 
   WriteToDisk(it->first, &it->second);
   return it->second.data;
@@ -44,17 +49,29 @@ void GrShaderCache::store(const SkData& key, const SkData& data) {
   TRACE_EVENT0("gpu", "GrShaderCache::store");
   DCHECK_NE(current_client_id_, kInvalidClientId);
 
+  CacheKey cache_key(SkData::MakeWithCopy(key.data(), key.size()));
+  if (!pending_compile_start_time_.is_null() &&
+      pending_compile_key_hash_ == cache_key.hash) {
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "GPU.GrShaderCache.ShaderCompileTime",
+        base::TimeTicks::Now() - pending_compile_start_time_,
+        base::TimeDelta::FromMicroseconds(10), base::TimeDelta::FromSeconds(1),
+        50);
+  }
+  pending_compile_start_time_ = base::TimeTicks();
+
   if (data.size() > cache_size_limit_)
     return;
-  EnforceLimits(data.size());
 
-  CacheKey cache_key(SkData::MakeWithCopy(key.data(), key.size()));
-  auto existing_it = store_.Get(cache_key);
+  auto existing_it = store_.Peek(cache_key);
   if (existing_it != store_.end()) {
     // Skia may ignore the cached entry and regenerate a shader if it fails to
     // link, in which case replace the current version with the latest one.
+    // This is done before enforcing limits so that the stale entry is not
+    // counted against the space needed for its replacement.
     EraseFromCache(existing_it);
   }
+  EnforceLimits(data.size());
 
   CacheData cache_data(SkData::MakeWithCopy(data.data(), data.size()));
   auto it = AddToCache(cache_key, std::move(cache_data));
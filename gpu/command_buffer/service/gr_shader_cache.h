@@ -9,6 +9,7 @@
 #include "base/containers/mru_cache.h"
 #include "base/hash.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/time/time.h"
 #include "gpu/gpu_gles2_export.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
@@ -103,6 +104,12 @@ class GPU_GLES2_EXPORT GrShaderCache
 
   int32_t current_client_id_ = kInvalidClientId;
 
+  // Skia compiles a shader right after load() misses the cache and then
+  // store()s the result, so the time until the store() with the same key
+  // is the compile time. These track the last miss.
+  size_t pending_compile_key_hash_ = 0u;
+  base::TimeTicks pending_compile_start_time_;
+
   DISALLOW_COPY_AND_ASSIGN(GrShaderCache);
 };
 
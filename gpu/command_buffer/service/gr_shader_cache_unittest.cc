@@ -4,6 +4,7 @@
 
 #include "gpu/command_buffer/service/gr_shader_cache.h"
 
+#include "base/test/metrics/histogram_tester.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace gpu {
@@ -180,5 +181,28 @@ TEST_F(GrShaderCacheTest, PopulateFromDiskAfterStoring) {
   EXPECT_EQ(disk_cache_.size(), 1u);
 }
 
+TEST_F(GrShaderCacheTest, RecordsCompileTimeAfterMiss) {
+  base::HistogramTester histogram_tester;
+  int32_t regular_client_id = 3;
+  auto key = SkData::MakeWithCString(kShaderKey);
+  auto shader = SkData::MakeWithCString(kShader);
+  {
+    GrShaderCache::ScopedCacheUse cache_use(&cache_, regular_client_id);
+    EXPECT_EQ(cache_.load(*key), nullptr);
+    cache_.store(*key, *shader);
+  }
+  histogram_tester.ExpectTotalCount("GPU.GrShaderCache.ShaderCompileTime", 1);
+  histogram_tester.ExpectBucketCount("GPU.GrShaderCache.LoadHit", false, 1);
+
+  // A store() without a preceding miss is not a compile we timed.
+  {
+    GrShaderCache::ScopedCacheUse cache_use(&cache_, regular_client_id);
+    EXPECT_TRUE(cache_.load(*key));
+    cache_.store(*key, *shader);
+  }
+  histogram_tester.ExpectTotalCount("GPU.GrShaderCache.ShaderCompileTime", 1);
+  histogram_tester.ExpectBucketCount("GPU.GrShaderCache.LoadHit", true, 1);
+}
+
 }  // namespace raster
 }  // namespace gpu
@@ -10,6 +10,7 @@
 
 #include "base/containers/queue.h"
 #include "base/synchronization/lock.h"
+#include "base/trace_event/trace_event.h"
 #include "gpu/command_buffer/common/sync_token.h"
 #include "gpu/command_buffer/service/texture_manager.h"
 #include "ui/gl/gl_fence.h"
@@ -27,6 +28,28 @@ namespace {
 base::LazyInstance<base::Lock>::DestructorAtExit g_lock =
     LAZY_INSTANCE_INITIALIZER;
 
+// Protected by |g_lock|.
+int g_lock_contention_count = 0;
+
+// Bumped whenever any texture group gets a new definition, so that
+// PullTextureUpdates() can tell when there is nothing to pull. Protected by
+// |g_lock|.
+uint64_t g_definition_generation = 0;
+
+// Acquires |g_lock|. Acquisitions that have to wait for another thread are
+// counted and traced, since every texture exchange between contexts goes
+// through this lock.
+base::Lock& AcquireLock() {
+  base::Lock& lock = g_lock.Get();
+  if (!lock.Try()) {
+    TRACE_EVENT0("gpu", "MailboxManagerSync::WaitForLock");
+    lock.Acquire();
+    TRACE_COUNTER1("gpu", "MailboxManagerSyncLockContention",
+                   ++g_lock_contention_count);
+  }
+  return lock;
+}
+
 #if !defined(OS_MACOSX)
 typedef std::map<SyncToken, std::unique_ptr<gl::GLFence>> SyncTokenToFenceMap;
 base::LazyInstance<SyncTokenToFenceMap>::DestructorAtExit
@@ -191,7 +214,7 @@ bool MailboxManagerSync::UsesSync() {
 }
 
 Texture* MailboxManagerSync::ConsumeTexture(const Mailbox& mailbox) {
-  base::AutoLock lock(g_lock.Get());
+  base::AutoLock lock(AcquireLock(), base::AutoLock::AlreadyAcquired());
   // Relax the cross-thread access restriction to non-thread-safe RefCount.
   // The lock above protects non-thread-safe RefCount in TextureGroup.
   base::ScopedAllowCrossThreadRefCountAccess
@@ -223,7 +246,7 @@ Texture* MailboxManagerSync::ConsumeTexture(const Mailbox& mailbox) {
 void MailboxManagerSync::ProduceTexture(const Mailbox& mailbox,
                                         TextureBase* texture_base) {
   DCHECK(texture_base);
-  base::AutoLock lock(g_lock.Get());
+  base::AutoLock lock(AcquireLock(), base::AutoLock::AlreadyAcquired());
   // Relax the cross-thread access restriction to non-thread-safe RefCount.
   // The lock above protects non-thread-safe RefCount in TextureGroup.
   base::ScopedAllowCrossThreadRefCountAccess
@@ -260,7 +283,7 @@ void MailboxManagerSync::ProduceTexture(const Mailbox& mailbox,
 }
 
 void MailboxManagerSync::TextureDeleted(TextureBase* texture_base) {
-  base::AutoLock lock(g_lock.Get());
+  base::AutoLock lock(AcquireLock(), base::AutoLock::AlreadyAcquired());
   // Relax the cross-thread access restriction to non-thread-safe RefCount.
   // The lock above protects non-thread-safe RefCount in TextureGroup.
   base::ScopedAllowCrossThreadRefCountAccess
@@ -308,10 +331,11 @@ void MailboxManagerSync::UpdateDefinitionLocked(TextureBase* texture_base,
 
   group->SetDefinition(TextureDefinition(texture, ++group_ref->version,
                                          image ? image_buffer : nullptr));
+  g_definition_generation++;
 }
 
 void MailboxManagerSync::PushTextureUpdates(const SyncToken& token) {
-  base::AutoLock lock(g_lock.Get());
+  base::AutoLock lock(AcquireLock(), base::AutoLock::AlreadyAcquired());
   // Relax the cross-thread access restriction to non-thread-safe RefCount.
   // The lock above protects non-thread-safe RefCount in TextureGroup.
   base::ScopedAllowCrossThreadRefCountAccess
@@ -328,13 +352,18 @@ void MailboxManagerSync::PullTextureUpdates(const SyncToken& token) {
   using TextureUpdatePair = std::pair<Texture*, TextureDefinition>;
   std::vector<TextureUpdatePair> needs_update;
   {
-    base::AutoLock lock(g_lock.Get());
+    base::AutoLock lock(AcquireLock(), base::AutoLock::AlreadyAcquired());
     // Relax the cross-thread access restriction to non-thread-safe RefCount.
     // The lock above protects non-thread-safe RefCount in TextureGroup.
     base::ScopedAllowCrossThreadRefCountAccess
         scoped_allow_cross_thread_ref_count_access;
     AcquireFenceLocked(token);
 
+    // Nothing was pushed by any manager since the last pull.
+    if (pulled_definition_generation_ == g_definition_generation)
+      return;
+    pulled_definition_generation_ = g_definition_generation;
+
     for (TextureToGroupMap::iterator it = texture_to_group_.begin();
          it != texture_to_group_.end(); it++) {
       const TextureDefinition& definition = it->second.group->GetDefinition();
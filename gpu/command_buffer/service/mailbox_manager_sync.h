@@ -5,6 +5,8 @@
 #ifndef GPU_COMMAND_BUFFER_SERVICE_MAILBOX_MANAGER_SYNC_H_
 #define GPU_COMMAND_BUFFER_SERVICE_MAILBOX_MANAGER_SYNC_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <utility>
 
@@ -86,6 +88,10 @@ class GPU_GLES2_EXPORT MailboxManagerSync : public MailboxManager {
   typedef std::map<Texture*, TextureGroupRef> TextureToGroupMap;
   TextureToGroupMap texture_to_group_;
 
+  // The value of the global definition generation when this manager last
+  // pulled texture updates.
+  uint64_t pulled_definition_generation_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(MailboxManagerSync);
 };
 
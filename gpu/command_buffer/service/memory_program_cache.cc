@@ -10,6 +10,7 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/checked_math.h"
@@ -23,6 +24,7 @@
 #include "gpu/command_buffer/service/gl_utils.h"
 #include "gpu/command_buffer/service/gles2_cmd_decoder.h"
 #include "gpu/command_buffer/service/shader_manager.h"
+#include "gpu/config/gpu_finch_features.h"
 #include "gpu/config/gpu_preferences.h"
 #include "third_party/zlib/zlib.h"
 #include "ui/gl/gl_bindings.h"
@@ -274,6 +276,8 @@ std::vector<uint8_t> DecompressData(const std::vector<uint8_t>& data,
 }
 
 bool CompressProgramBinaries() {
+  if (base::FeatureList::IsEnabled(features::kCompressProgramBinaries))
+    return true;
 #if !defined(OS_ANDROID)
   return false;
 #else   // !defined(OS_ANDROID)
@@ -547,6 +551,20 @@ void MemoryProgramCache::LoadProgram(const std::string& key,
           &fragment_interface_blocks);
     }
 
+    if (proto->program().length() > max_size_bytes())
+      return;
+
+    // Programs are loaded from the disk cache when the GPU process starts,
+    // which may hold more than fits in memory. Keep the most recently loaded
+    // ones, as SaveLinkedProgram() does.
+    ProgramMRUCache::iterator existing = store_.Peek(proto->sha());
+    if (existing != store_.end())
+      store_.Erase(existing);
+    while (curr_size_bytes_ + proto->program().length() > max_size_bytes()) {
+      DCHECK(!store_.empty());
+      store_.Erase(store_.rbegin());
+    }
+
     std::vector<uint8_t> binary(proto->program().length());
     memcpy(binary.data(), proto->program().c_str(), proto->program().length());
 
@@ -557,6 +557,53 @@ TEST_F(MemoryProgramCacheTest, MemoryProgramCacheEviction) {
                                      old_sig, nullptr, varyings_, GL_NONE));
 }
 
+TEST_F(MemoryProgramCacheTest, LoadProgramEvictsToFitCacheSize) {
+  const GLenum kFormat = 1;
+  const int kProgramId = 10;
+  const int kBinaryLength = 20;
+  char test_binary[kBinaryLength];
+  for (int i = 0; i < kBinaryLength; ++i) {
+    test_binary[i] = i;
+  }
+  ProgramBinaryEmulator emulator1(kBinaryLength, kFormat, test_binary);
+
+  SetExpectationsForSaveLinkedProgram(kProgramId, &emulator1);
+  cache_->SaveLinkedProgram(kProgramId, vertex_shader_, fragment_shader_,
+                            nullptr, varyings_, GL_NONE, this);
+  const std::string small_program = shader_cache_shader();
+  const std::string small_sig = fragment_shader_->last_compiled_signature();
+
+  // A program big enough that it cannot share the cache with the first one.
+  const int kBigProgramId = 11;
+  const GLuint kBigBinaryLength = kCacheSizeBytes - kBinaryLength + 1;
+  fragment_shader_->set_source("al sdfkjdk");
+  TestHelper::SetShaderStates(gl_.get(), fragment_shader_, true);
+  std::unique_ptr<char[]> big_test_binary(new char[kBigBinaryLength]);
+  for (size_t i = 0; i < kBigBinaryLength; ++i) {
+    big_test_binary[i] = i % 250;
+  }
+  ProgramBinaryEmulator emulator2(kBigBinaryLength, kFormat,
+                                  big_test_binary.get());
+
+  SetExpectationsForSaveLinkedProgram(kBigProgramId, &emulator2);
+  cache_->SaveLinkedProgram(kBigProgramId, vertex_shader_, fragment_shader_,
+                            nullptr, varyings_, GL_NONE, this);
+
+  // Loading the first program from disk must evict the big one rather than
+  // grow the cache past its limit.
+  std::string blank;
+  cache_->LoadProgram(blank, small_program);
+  EXPECT_EQ(
+      ProgramCache::LINK_SUCCEEDED,
+      cache_->GetLinkedProgramStatus(vertex_shader_->last_compiled_signature(),
+                                     small_sig, nullptr, varyings_, GL_NONE));
+  EXPECT_EQ(ProgramCache::LINK_UNKNOWN,
+            cache_->GetLinkedProgramStatus(
+                vertex_shader_->last_compiled_signature(),
+                fragment_shader_->last_compiled_signature(), nullptr, varyings_,
+                GL_NONE));
+}
+
 TEST_F(MemoryProgramCacheTest, SaveCorrectProgram) {
   const GLenum kFormat = 1;
   const int kProgramId = 10;
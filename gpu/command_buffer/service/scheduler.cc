@@ -36,6 +36,7 @@ Scheduler::SchedulingState::AsValue() const {
       new base::trace_event::TracedValue());
   state->SetInteger("sequence_id", sequence_id.GetUnsafeValue());
   state->SetString("priority", SchedulingPriorityToString(priority));
+  state->SetBoolean("time_slice_expired", time_slice_expired);
   state->SetInteger("order_num", order_num);
   return std::move(state);
 }
@@ -142,6 +143,7 @@ Scheduler::SchedulingState Scheduler::Sequence::SetScheduled() {
 
   scheduling_state_.sequence_id = sequence_id_;
   scheduling_state_.priority = current_priority();
+  scheduling_state_.time_slice_expired = time_slice_expired_;
   scheduling_state_.order_num = tasks_.front().order_num;
 
   return scheduling_state_;
@@ -171,6 +173,10 @@ uint32_t Scheduler::Sequence::BeginTask(base::OnceClosure* closure) {
   DCHECK_EQ(running_state_, SCHEDULED);
 
   running_state_ = RUNNING;
+  // The sequence got its turn, so it competes normally again. This also keeps
+  // ShouldYieldTo() from yielding to every other sequence of its priority.
+  time_slice_expired_ = false;
+  scheduling_state_.time_slice_expired = false;
 
   *closure = std::move(tasks_.front().closure);
   uint32_t order_num = tasks_.front().order_num;
@@ -429,7 +435,23 @@ bool Scheduler::ShouldYield(SequenceId sequence_id) {
   DCHECK(next_sequence);
   DCHECK(next_sequence->scheduled());
 
-  return running_sequence->ShouldYieldTo(next_sequence);
+  if (running_sequence->ShouldYieldTo(next_sequence))
+    return true;
+
+  if (time_slice_.is_zero() ||
+      scheduling_queue_.front().priority !=
+          running_sequence->current_priority() ||
+      base::TimeTicks::Now() - task_start_time_ < time_slice_) {
+    return false;
+  }
+  running_sequence->SetTimeSliceExpired();
+  return true;
+}
+
+void Scheduler::SetTimeSlice(base::TimeDelta time_slice) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  base::AutoLock auto_lock(lock_);
+  time_slice_ = time_slice;
 }
 
 void Scheduler::SyncTokenFenceReleased(const SyncToken& sync_token,
@@ -516,6 +538,8 @@ void Scheduler::RunNextTask() {
   base::OnceClosure closure;
   uint32_t order_num = sequence->BeginTask(&closure);
   DCHECK_EQ(order_num, state.order_num);
+  if (!time_slice_.is_zero())
+    task_start_time_ = base::TimeTicks::Now();
 
   // Begin/FinishProcessingOrderNumber must be called with the lock released
   // because they can renter the scheduler in Enable/DisableSequence.
@@ -17,6 +17,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "gpu/command_buffer/common/command_buffer_id.h"
 #include "gpu/command_buffer/common/scheduling_priority.h"
 #include "gpu/command_buffer/common/sync_token.h"
@@ -88,8 +89,15 @@ class GPU_EXPORT Scheduler {
   void ContinueTask(SequenceId sequence_id, base::OnceClosure closure);
 
   // If the sequence should yield so that a higher priority sequence may run.
+  // With time slicing enabled, also yields to a sequence of the same priority
+  // once the current task has run for longer than the time slice.
   bool ShouldYield(SequenceId sequence_id);
 
+  // Enables round-robin time slicing between sequences of the same priority,
+  // so that a client submitting long running tasks (e.g. a busy WebGL
+  // context) cannot starve other clients. Disabled when |time_slice| is zero.
+  void SetTimeSlice(base::TimeDelta time_slice);
+
  private:
 
   struct SchedulingState {
@@ -103,8 +111,9 @@ class GPU_EXPORT Scheduler {
     ~SchedulingState();
 
     bool RunsBefore(const SchedulingState& other) const {
-      return std::tie(priority, order_num) <
-             std::tie(other.priority, other.order_num);
+      return std::tie(priority, time_slice_expired, order_num) <
+             std::tie(other.priority, other.time_slice_expired,
+                      other.order_num);
     }
 
     std::unique_ptr<base::trace_event::ConvertableToTraceFormat> AsValue()
@@ -112,6 +121,9 @@ class GPU_EXPORT Scheduler {
 
     SequenceId sequence_id;
     SchedulingPriority priority = SchedulingPriority::kLow;
+    // Set if the sequence yielded because its time slice ran out. It then
+    // runs after other sequences of the same priority.
+    bool time_slice_expired = false;
     uint32_t order_num = 0;
   };
 
@@ -158,6 +170,9 @@ class GPU_EXPORT Scheduler {
     // Update cached scheduling priority while running.
     void UpdateRunningPriority();
 
+    // Called when the running task yields because its time slice expired.
+    void SetTimeSliceExpired() { time_slice_expired_ = true; }
+
     // Returns the next order number and closure. Sets running state to RUNNING.
     uint32_t BeginTask(base::OnceClosure* closure);
 
@@ -275,6 +290,10 @@ class GPU_EXPORT Scheduler {
     const SchedulingPriority default_priority_;
     SchedulingPriority current_priority_;
 
+    // If the last task yielded because its time slice expired. Cleared when
+    // the next task begins.
+    bool time_slice_expired_ = false;
+
     scoped_refptr<SyncPointOrderData> order_data_;
 
     // Deque of tasks. Tasks are inserted at the back with increasing order
@@ -331,6 +350,12 @@ class GPU_EXPORT Scheduler {
   // priority.
   bool rebuild_scheduling_queue_ = false;
 
+  // See SetTimeSlice(). Zero if time slicing is disabled.
+  base::TimeDelta time_slice_;
+
+  // When the currently running task began, if time slicing is enabled.
+  base::TimeTicks task_start_time_;
+
   base::ThreadChecker thread_checker_;
 
   base::WeakPtrFactory<Scheduler> weak_factory_;
@@ -396,6 +396,45 @@ TEST_F(SchedulerTest, ReleaseSequenceShouldYield) {
   release_state->Destroy();
 }
 
+TEST_F(SchedulerTest, TimeSliceExpiredShouldYieldToSamePriority) {
+  scheduler()->SetTimeSlice(base::TimeDelta::FromMicroseconds(1));
+
+  SequenceId sequence_id1 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+  SequenceId sequence_id2 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+
+  bool ran1 = false;
+  bool continued1 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id1, GetClosure([&] {
+        // Spin until the time slice runs out.
+        while (!scheduler()->ShouldYield(sequence_id1)) {
+        }
+        scheduler()->ContinueTask(sequence_id1,
+                                  GetClosure([&] { continued1 = true; }));
+        ran1 = true;
+      }),
+      std::vector<SyncToken>()));
+
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] { ran2 = true; }), std::vector<SyncToken>()));
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran1);
+  EXPECT_FALSE(ran2);
+  EXPECT_FALSE(continued1);
+
+  // The second sequence runs before the continuation of the first one.
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran2);
+  EXPECT_FALSE(continued1);
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(continued1);
+}
+
 TEST_F(SchedulerTest, ReentrantEnableSequenceShouldNotDeadlock) {
   SequenceId sequence_id1 =
       scheduler()->CreateSequence(SchedulingPriority::kHigh);
@@ -22,6 +22,10 @@ namespace {
 // unbounded handle growth with tiny entries.
 static size_t kMaxCacheEntries = 2000;
 
+// Entries at least this big are evicted first when the cache is over its size
+// limit. Decoded images are usually above it, paths and typefaces below.
+constexpr size_t kLargeEntrySizeBytes = 64 * 1024;
+
 size_t ServiceTransferCacheSizeLimit() {
   size_t memory_usage = 128 * 1024 * 1024;
   if (base::SysInfo::IsLowEndDevice()) {
@@ -156,12 +160,29 @@ bool ServiceTransferCache::DeleteEntry(const EntryKey& key) {
 cc::ServiceTransferCacheEntry* ServiceTransferCache::GetEntry(
     const EntryKey& key) {
   auto found = entries_.Get(key);
-  if (found == entries_.end())
+  if (found == entries_.end()) {
+    cache_misses_++;
     return nullptr;
+  }
+  cache_hits_++;
   return found->second.entry.get();
 }
 
 void ServiceTransferCache::EnforceLimits() {
+  // Free space from large entries first, in LRU order.
+  for (auto it = entries_.rbegin();
+       it != entries_.rend() && total_size_ > cache_size_limit_;) {
+    if (it->second.entry->CachedSize() < kLargeEntrySizeBytes ||
+        (it->second.handle && !it->second.handle->Delete())) {
+      ++it;
+      continue;
+    }
+
+    total_size_ -= it->second.entry->CachedSize();
+    it = entries_.Erase(it);
+    evictions_++;
+  }
+
   for (auto it = entries_.rbegin(); it != entries_.rend();) {
     if (total_size_ <= cache_size_limit_ &&
         entries_.size() <= max_cache_entries_) {
@@ -174,6 +195,7 @@ void ServiceTransferCache::EnforceLimits() {
 
     total_size_ -= it->second.entry->CachedSize();
     it = entries_.Erase(it);
+    evictions_++;
   }
 }
 
@@ -202,18 +224,27 @@ bool ServiceTransferCache::OnMemoryDump(
   using base::trace_event::MemoryAllocatorDump;
   using base::trace_event::MemoryDumpLevelOfDetail;
 
-  if (args.level_of_detail == MemoryDumpLevelOfDetail::BACKGROUND) {
-    std::string dump_name =
-        base::StringPrintf("gpu/transfer_cache/cache_0x%" PRIXPTR,
-                           reinterpret_cast<uintptr_t>(this));
-    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(dump_name);
-    dump->AddScalar(MemoryAllocatorDump::kNameSize,
-                    MemoryAllocatorDump::kUnitsBytes, total_size_);
+  std::string cache_dump_name =
+      base::StringPrintf("gpu/transfer_cache/cache_0x%" PRIXPTR,
+                         reinterpret_cast<uintptr_t>(this));
+  MemoryAllocatorDump* cache_dump = pmd->CreateAllocatorDump(cache_dump_name);
+  cache_dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                        MemoryAllocatorDump::kUnitsBytes, total_size_);
 
+  if (args.level_of_detail == MemoryDumpLevelOfDetail::BACKGROUND) {
     // Early out, no need for more detail in a BACKGROUND dump.
     return true;
   }
 
+  cache_dump->AddScalar(MemoryAllocatorDump::kNameObjectCount,
+                        MemoryAllocatorDump::kUnitsObjects, entries_.size());
+  cache_dump->AddScalar("cache_hits", MemoryAllocatorDump::kUnitsObjects,
+                        cache_hits_);
+  cache_dump->AddScalar("cache_misses", MemoryAllocatorDump::kUnitsObjects,
+                        cache_misses_);
+  cache_dump->AddScalar("evictions", MemoryAllocatorDump::kUnitsObjects,
+                        evictions_);
+
   for (auto it = entries_.begin(); it != entries_.end(); it++) {
     auto entry_type = it->first.entry_type;
     const auto* entry = it->second.entry.get();
@@ -24,7 +24,9 @@ namespace gpu {
 // In addition to access, the ServiceTransferCache is also responsible for
 // unlocking and deleting entries when no longer needed, as well as enforcing
 // cache limits. If the cache exceeds its specified limits, unlocked transfer
-// cache entries may be deleted.
+// cache entries may be deleted. When over the size limit, large entries (such
+// as decoded images) are evicted before small ones (such as paths and
+// typefaces), which are cheap to keep but costly for the client to re-upload.
 class GPU_GLES2_EXPORT ServiceTransferCache
     : public base::trace_event::MemoryDumpProvider {
  public:
@@ -104,6 +106,11 @@ class GPU_GLES2_EXPORT ServiceTransferCache
   // The max number of entries we will hold in the cache.
   size_t max_cache_entries_ = 0;
 
+  // Statistics reported in detailed memory dumps.
+  size_t cache_hits_ = 0;
+  size_t cache_misses_ = 0;
+  size_t evictions_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(ServiceTransferCache);
 };
 
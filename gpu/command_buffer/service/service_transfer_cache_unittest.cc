@@ -56,6 +56,32 @@ TEST(ServiceTransferCacheTest, EnforcesOnPurgeMemory) {
   EXPECT_EQ(cache.cache_size_for_testing(), entry_size);
 }
 
+TEST(ServiceTransferCacheTest, EvictsLargeEntriesFirst) {
+  ServiceTransferCache cache;
+  const size_t kSmallEntrySize = 1024u;
+  const size_t kLargeEntrySize = 64 * 1024u;
+  cache.SetCacheSizeLimitForTesting(kLargeEntrySize + 3 * kSmallEntrySize);
+
+  ServiceTransferCache::EntryKey small_key(kDecoderId, kEntryType, 1u);
+  ServiceTransferCache::EntryKey large_key(kDecoderId, kEntryType, 2u);
+  cache.CreateLocalEntry(small_key, CreateEntry(kSmallEntrySize));
+  cache.CreateLocalEntry(large_key, CreateEntry(kLargeEntrySize));
+  cache.CreateLocalEntry(
+      ServiceTransferCache::EntryKey(kDecoderId, kEntryType, 3u),
+      CreateEntry(kSmallEntrySize));
+  EXPECT_EQ(cache.cache_size_for_testing(),
+            kLargeEntrySize + 2 * kSmallEntrySize);
+
+  // Going over the limit evicts the large entry even though the first small
+  // entry was used less recently.
+  cache.CreateLocalEntry(
+      ServiceTransferCache::EntryKey(kDecoderId, kEntryType, 4u),
+      CreateEntry(2 * kSmallEntrySize));
+  EXPECT_EQ(cache.cache_size_for_testing(), 4 * kSmallEntrySize);
+  EXPECT_TRUE(cache.GetEntry(small_key));
+  EXPECT_FALSE(cache.GetEntry(large_key));
+}
+
 TEST(ServiceTransferCache, MultipleDecoderUse) {
   ServiceTransferCache cache;
   const uint32_t entry_id = 0u;
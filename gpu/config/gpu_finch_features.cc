@@ -5,6 +5,11 @@
 
 namespace features {
 
+// Store cached program binaries zlib-compressed, both in memory and in the
+// shader disk cache. Always on for low-end Android devices.
+const base::Feature kCompressProgramBinaries{"CompressProgramBinaries",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Enable GPU Rasterization by default. This can still be overridden by
 // --force-gpu-rasterization or --disable-gpu-rasterization.
 #if defined(OS_MACOSX) || defined(OS_WIN) || defined(OS_CHROMEOS) || \
@@ -49,4 +54,9 @@ const base::Feature kAImageReaderMediaPlayer{"AImageReaderMediaPlayer",
 const base::Feature kDirectCompositionPreferNV12Overlays{
     "DirectCompositionPreferNV12Overlays", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Round-robin between GPU scheduler sequences of the same priority when a task
+// runs past its time slice, so one busy client cannot starve the others.
+const base::Feature kGpuSchedulerTimeSlicing{"GpuSchedulerTimeSlicing",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
@@ -16,6 +16,8 @@ namespace features {
 
 // All features in alphabetical order. The features should be documented
 // alongside the definition of their values in the .cc file.
+GPU_EXPORT extern const base::Feature kCompressProgramBinaries;
+
 GPU_EXPORT extern const base::Feature kDefaultEnableGpuRasterization;
 
 GPU_EXPORT extern const base::Feature kDefaultEnableOopRasterization;
@@ -30,6 +32,8 @@ GPU_EXPORT extern const base::Feature kAImageReaderMediaPlayer;
 
 GPU_EXPORT extern const base::Feature kDirectCompositionPreferNV12Overlays;
 
+GPU_EXPORT extern const base::Feature kGpuSchedulerTimeSlicing;
+
 }  // namespace features
 
 #endif  // GPU_CONFIG_GPU_FEATURES_H_
@@ -30,8 +30,24 @@ void PostCallback(const scoped_refptr<base::TaskRunner>& task_runner,
   task_runner->PostTask(FROM_HERE, base::Bind(callback, error));
 }
 
+// Drops the responses that the HttpCache of |getter| holds in memory, since
+// they may have been read from entries that were just doomed, and posts
+// |callback| on |task_runner|.
+void ClearHotEntriesAndPostCallback(
+    const scoped_refptr<net::URLRequestContextGetter>& getter,
+    const scoped_refptr<base::TaskRunner>& task_runner,
+    const net::CompletionCallback& callback,
+    int error) {
+  getter->GetURLRequestContext()
+      ->http_transaction_factory()
+      ->GetCache()
+      ->ClearHotEntries();
+  PostCallback(task_runner, callback, error);
+}
+
 // Clears the disk_cache::Backend on the IO thread and deletes |backend|.
 void DoomHttpCache(std::unique_ptr<disk_cache::Backend*> backend,
+                   const scoped_refptr<net::URLRequestContextGetter>& getter,
                    const scoped_refptr<base::TaskRunner>& client_task_runner,
                    const base::Time& delete_begin,
                    const base::Time& delete_end,
@@ -41,11 +57,11 @@ void DoomHttpCache(std::unique_ptr<disk_cache::Backend*> backend,
   if (*backend) {
     const int rv = (*backend)->DoomEntriesBetween(
         delete_begin, delete_end,
-        base::Bind(&PostCallback, client_task_runner, callback));
+        base::Bind(&ClearHotEntriesAndPostCallback, getter, client_task_runner,
+                   callback));
     // DoomEntriesBetween does not invoke callback unless rv is ERR_IO_PENDING.
-    if (rv != net::ERR_IO_PENDING) {
-      client_task_runner->PostTask(FROM_HERE, base::BindOnce(callback, rv));
-    }
+    if (rv != net::ERR_IO_PENDING)
+      ClearHotEntriesAndPostCallback(getter, client_task_runner, callback, rv);
   } else {
     client_task_runner->PostTask(FROM_HERE, base::Bind(callback, error));
   }
@@ -71,7 +87,7 @@ void ClearHttpCacheOnIOThread(
       new disk_cache::Backend*(nullptr));
   disk_cache::Backend** backend_ptr = backend.get();
   net::CompletionCallback doom_callback =
-      base::Bind(&DoomHttpCache, base::Passed(std::move(backend)),
+      base::Bind(&DoomHttpCache, base::Passed(std::move(backend)), getter,
                  client_task_runner, delete_begin, delete_end, callback);
 
   const int rv = http_cache->GetBackend(backend_ptr, doom_callback);
@@ -296,6 +296,21 @@ void AudioBus::CopyConvertFromInterleavedSourceToAudioBus(
     int num_frames_to_write,
     AudioBus* dest) {
   const int channels = dest->channels();
+  if (channels > 2) {
+    // With many channels, striding through the source once per channel
+    // touches each cache line of it |channels| times. Read it once in order
+    // instead.
+    const typename SourceSampleTypeTraits::ValueType* source = source_buffer;
+    for (int target_frame_index = write_offset_in_frames;
+         target_frame_index < write_offset_in_frames + num_frames_to_write;
+         ++target_frame_index) {
+      for (int ch = 0; ch < channels; ++ch, ++source) {
+        dest->channel(ch)[target_frame_index] =
+            SourceSampleTypeTraits::ToFloat(*source);
+      }
+    }
+    return;
+  }
   for (int ch = 0; ch < channels; ++ch) {
     float* channel_data = dest->channel(ch);
     for (int target_frame_index = write_offset_in_frames,
@@ -318,6 +333,20 @@ void AudioBus::CopyConvertFromAudioBusToInterleavedTarget(
     int num_frames_to_read,
     typename TargetSampleTypeTraits::ValueType* dest_buffer) {
   const int channels = source->channels();
+  if (channels > 2) {
+    // Write the destination once in order; see
+    // CopyConvertFromInterleavedSourceToAudioBus().
+    typename TargetSampleTypeTraits::ValueType* dest = dest_buffer;
+    for (int source_frame_index = read_offset_in_frames;
+         source_frame_index < read_offset_in_frames + num_frames_to_read;
+         ++source_frame_index) {
+      for (int ch = 0; ch < channels; ++ch, ++dest) {
+        *dest = TargetSampleTypeTraits::FromFloat(
+            source->channel(ch)[source_frame_index]);
+      }
+    }
+    return;
+  }
   for (int ch = 0; ch < channels; ++ch) {
     const float* channel_data = source->channel(ch);
     for (int source_frame_index = read_offset_in_frames, write_pos_in_dest = ch;
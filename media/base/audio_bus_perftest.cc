@@ -52,4 +52,15 @@ TEST(AudioBusPerfTest, Interleave) {
   RunInterleaveBench<float, Float32SampleTypeTraits>(bus.get(), "float");
 }
 
+// Same as above, for a 7.1 layout, which takes the frame-major path.
+TEST(AudioBusPerfTest, InterleaveMultichannel) {
+  std::unique_ptr<AudioBus> bus = AudioBus::Create(8, kSampleRate * 30);
+  FakeAudioRenderCallback callback(0.2, kSampleRate);
+  callback.Render(base::TimeDelta(), base::TimeTicks::Now(), 0, bus.get());
+
+  RunInterleaveBench<int16_t, SignedInt16SampleTypeTraits>(bus.get(),
+                                                           "int16_t_8ch");
+  RunInterleaveBench<float, Float32SampleTypeTraits>(bus.get(), "float_8ch");
+}
+
 }  // namespace media
@@ -544,6 +544,36 @@ TEST_F(AudioBusTest, ToInterleavedSanitized) {
             memcmp(test_array, kTestVectorFloat32, sizeof(kTestVectorFloat32)));
 }
 
+// Verify interleaving round trips with more than two channels, including
+// partial reads and writes.
+TEST_F(AudioBusTest, InterleaveMultichannel) {
+  static const int kChannels = 6;
+  static const int kFrames = 4;
+  static const int kPartialStart = 1;
+  float interleaved[kChannels * kFrames];
+  for (int i = 0; i < kChannels * kFrames; ++i)
+    interleaved[i] = (i - kChannels * kFrames / 2) / 16.0f;
+
+  std::unique_ptr<AudioBus> bus = AudioBus::Create(kChannels, kFrames);
+  bus->Zero();
+  bus->FromInterleavedPartial<Float32SampleTypeTraits>(
+      interleaved, kPartialStart, kFrames - kPartialStart);
+  for (int ch = 0; ch < kChannels; ++ch) {
+    SCOPED_TRACE(ch);
+    EXPECT_EQ(0.0f, bus->channel(ch)[0]);
+    for (int i = kPartialStart; i < kFrames; ++i) {
+      EXPECT_EQ(interleaved[(i - kPartialStart) * kChannels + ch],
+                bus->channel(ch)[i]);
+    }
+  }
+
+  float round_trip[kChannels * kFrames];
+  bus->ToInterleavedPartial<Float32SampleTypeTraits>(
+      kPartialStart, kFrames - kPartialStart, round_trip);
+  EXPECT_EQ(0, memcmp(round_trip, interleaved,
+                      (kFrames - kPartialStart) * kChannels * sizeof(float)));
+}
+
 // Verify ToInterleavedPartial() interleaves audio correctly.
 TEST_F(AudioBusTest, ToInterleavedPartial) {
   // Only interleave the middle two frames in each channel.
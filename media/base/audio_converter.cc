@@ -167,12 +167,6 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
                fifo_frame_delay);
   const bool needs_downmix = channel_mixer_ && downmix_early_;
 
-  if (!mixer_input_audio_bus_ ||
-      mixer_input_audio_bus_->frames() != dest->frames()) {
-    mixer_input_audio_bus_ =
-        AudioBus::Create(input_channel_count_, dest->frames());
-  }
-
   // If we're downmixing early we need a temporary AudioBus which matches
   // the the input channel count and input frame size since we're passing
   // |unmixed_audio_| directly to the |source_callback_|.
@@ -181,9 +175,18 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
 
   AudioBus* const temp_dest = needs_downmix ? unmixed_audio_.get() : dest;
 
+  // Only needed as scratch space for the second and later inputs.
+  if (transform_inputs_.size() > 1 &&
+      (!mixer_input_audio_bus_ ||
+       mixer_input_audio_bus_->frames() != dest->frames())) {
+    mixer_input_audio_bus_ =
+        AudioBus::Create(input_channel_count_, dest->frames());
+  }
+
   // Sanity check our inputs.
-  DCHECK_EQ(temp_dest->frames(), mixer_input_audio_bus_->frames());
-  DCHECK_EQ(temp_dest->channels(), mixer_input_audio_bus_->channels());
+  DCHECK_EQ(temp_dest->channels(), input_channel_count_);
+  DCHECK(transform_inputs_.size() == 1 ||
+         temp_dest->frames() == mixer_input_audio_bus_->frames());
 
   // |total_frames_delayed| is reported to the *input* source in terms of the
   // *input* sample rate. |initial_frames_delayed_| is given in terms of the
@@ -201,34 +204,30 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
     total_frames_delayed += fifo_frame_delay;
   }
 
-  // If we only have a single input, avoid an extra copy.
-  AudioBus* const provide_input_dest =
-      transform_inputs_.size() == 1 ? temp_dest : mixer_input_audio_bus_.get();
-
   // Have each mixer render its data into an output buffer then mix the result.
   for (auto* input : transform_inputs_) {
-    const float volume =
-        input->ProvideInput(provide_input_dest, total_frames_delayed);
-    // Optimize the most common single input, full volume case.
+    // The first input renders straight into |temp_dest|, which avoids a copy
+    // and leaves a buffer the remaining inputs can accumulate into.
     if (input == transform_inputs_.front()) {
-      if (volume == 1.0f) {
-        if (temp_dest != provide_input_dest)
-          provide_input_dest->CopyTo(temp_dest);
-      } else if (volume > 0) {
-        for (int i = 0; i < provide_input_dest->channels(); ++i) {
-          vector_math::FMUL(
-              provide_input_dest->channel(i), volume,
-              provide_input_dest->frames(), temp_dest->channel(i));
+      const float volume = input->ProvideInput(temp_dest, total_frames_delayed);
+      // Optimize the most common full volume case.
+      if (volume == 1.0f)
+        continue;
+      if (volume > 0) {
+        for (int i = 0; i < temp_dest->channels(); ++i) {
+          vector_math::FMUL(temp_dest->channel(i), volume, temp_dest->frames(),
+                            temp_dest->channel(i));
         }
       } else {
         // Zero |temp_dest| otherwise, so we're mixing into a clean buffer.
         temp_dest->Zero();
       }
-
       continue;
     }
 
     // Volume adjust and mix each mixer input into |temp_dest| after rendering.
+    const float volume =
+        input->ProvideInput(mixer_input_audio_bus_.get(), total_frames_delayed);
     if (volume > 0) {
       for (int i = 0; i < mixer_input_audio_bus_->channels(); ++i) {
         vector_math::FMAC(
@@ -208,12 +208,20 @@ void SincResampler::SetRatio(double io_sample_rate_ratio) {
     return;
   }
 
+  const double previous_sinc_scale_factor =
+      SincScaleFactor(io_sample_rate_ratio_);
   io_sample_rate_ratio_ = io_sample_rate_ratio;
   chunk_size_ = CalculateChunkSize(block_size_, io_sample_rate_ratio_);
 
+  // The kernels depend on the ratio only through |sinc_scale_factor|, which is
+  // constant for all upsampling ratios.  Clock drift compensation calls this
+  // often with ratios close to 1.0, so skip the rebuild when possible.
+  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
+  if (sinc_scale_factor == previous_sinc_scale_factor)
+    return;
+
   // Optimize reinitialization by reusing values which are independent of
   // |sinc_scale_factor|.  Provides a 3x speedup.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
   for (int offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
     for (int i = 0; i < kKernelSize; ++i) {
       const int idx = i + offset_idx * kKernelSize;
@@ -72,8 +72,9 @@ class MEDIA_EXPORT SincResampler {
   void Flush();
 
   // Update |io_sample_rate_ratio_|.  SetRatio() will cause a reconstruction of
-  // the kernels used for resampling.  Not thread safe, do not call while
-  // Resample() is in progress.
+  // the kernels used for resampling unless both the old and new ratio are
+  // upsampling (<= 1.0), which share the same kernels.  Not thread safe, do not
+  // call while Resample() is in progress.
   void SetRatio(double io_sample_rate_ratio);
 
   float* get_kernel_for_testing() { return kernel_storage_.get(); }
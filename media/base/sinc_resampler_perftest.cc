@@ -67,4 +67,27 @@ TEST(SincResamplerPerfTest, Convolve_optimized_unaligned) {
 
 #undef CONVOLVE_FUNC
 
+static const int kSetRatioIterations = 10000;
+
+// Simulates clock drift compensation, which nudges the ratio on every call.
+static void RunSetRatioBenchmark(double base_ratio,
+                                 const std::string& trace_name) {
+  SincResampler resampler(base_ratio, SincResampler::kDefaultRequestSize,
+                          base::DoNothing());
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kSetRatioIterations; ++i)
+    resampler.SetRatio(base_ratio * (1.0 + (i % 100 - 50) * 1e-5));
+  double total_time_milliseconds =
+      (base::TimeTicks::Now() - start).InMillisecondsF();
+  perf_test::PrintResult("sinc_resampler_set_ratio", "", trace_name,
+                         kSetRatioIterations / total_time_milliseconds,
+                         "runs/ms", true);
+}
+
+TEST(SincResamplerPerfTest, SetRatio) {
+  RunSetRatioBenchmark(44100.0 / 48000.0, "upsample_drift");
+  RunSetRatioBenchmark(48000.0 / 44100.0, "downsample_drift");
+}
+
 } // namespace media
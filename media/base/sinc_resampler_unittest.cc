@@ -148,6 +148,30 @@ TEST(SincResamplerTest, DISABLED_SetRatioBench) {
   printf("SetRatio() took %.2fms.\n", total_time_c_ms);
 }
 
+// Verify SetRatio() between upsampling ratios, which skips rebuilding the
+// kernels, still matches a resampler constructed at the new ratio.
+TEST(SincResamplerTest, SetRatioUpsamplingMatchesFreshKernel) {
+  static const double kInitialRatio = 44100.0 / 48000.0;
+  static const double kDriftedRatio = 44110.0 / 48000.0;
+  SincResampler resampler(kInitialRatio, SincResampler::kDefaultRequestSize,
+                          base::DoNothing());
+  SincResampler fresh_resampler(
+      kDriftedRatio, SincResampler::kDefaultRequestSize, base::DoNothing());
+
+  resampler.SetRatio(kDriftedRatio);
+  EXPECT_EQ(fresh_resampler.ChunkSize(), resampler.ChunkSize());
+  EXPECT_EQ(0, memcmp(fresh_resampler.get_kernel_for_testing(),
+                      resampler.get_kernel_for_testing(),
+                      sizeof(float) * SincResampler::kKernelStorageSize));
+
+  // Moving to a downsampling ratio and back must rebuild both times.
+  resampler.SetRatio(2.0);
+  resampler.SetRatio(kDriftedRatio);
+  EXPECT_EQ(0, memcmp(fresh_resampler.get_kernel_for_testing(),
+                      resampler.get_kernel_for_testing(),
+                      sizeof(float) * SincResampler::kKernelStorageSize));
+}
+
 
 // Define platform independent function name for Convolve* tests.
 #if defined(ARCH_CPU_X86_FAMILY)
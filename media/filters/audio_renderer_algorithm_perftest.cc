@@ -0,0 +1,73 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/audio_renderer_algorithm.h"
+
+#include <memory>
+#include <string>
+
+#include "base/time/time.h"
+#include "media/base/audio_buffer.h"
+#include "media/base/audio_bus.h"
+#include "media/base/audio_parameters.h"
+#include "media/base/test_helpers.h"
+#include "media/base/timestamp_constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kSampleRate = 48000;
+static const int kFramesPerBuffer = 1024;
+static const int kOutputDurationInSec = 60;
+
+class AudioRendererAlgorithmPerfTest : public testing::Test {
+ public:
+  AudioRendererAlgorithmPerfTest() {
+    AudioParameters params(AudioParameters::AUDIO_PCM_LINEAR,
+                           CHANNEL_LAYOUT_STEREO, kSampleRate,
+                           kFramesPerBuffer);
+    algorithm_.Initialize(params, false);
+  }
+
+  void FillAlgorithmQueue() {
+    while (!algorithm_.IsQueueFull()) {
+      algorithm_.EnqueueBuffer(MakeAudioBuffer<float>(
+          kSampleFormatF32, CHANNEL_LAYOUT_STEREO, 2, kSampleRate, 0.0f,
+          1.0f / kFramesPerBuffer, kFramesPerBuffer, kNoTimestamp));
+    }
+  }
+
+  // Renders |kOutputDurationInSec| of output at |playback_rate|, which runs
+  // the WSOLA search for every output block.
+  void RunFillBufferTest(const std::string& test_name, double playback_rate) {
+    std::unique_ptr<AudioBus> dest = AudioBus::Create(2, kFramesPerBuffer);
+    const int total_buffers =
+        kOutputDurationInSec * kSampleRate / kFramesPerBuffer;
+
+    base::TimeDelta total_time;
+    for (int i = 0; i < total_buffers; ++i) {
+      FillAlgorithmQueue();
+      base::TimeTicks start = base::TimeTicks::Now();
+      algorithm_.FillBuffer(dest.get(), 0, kFramesPerBuffer, playback_rate);
+      total_time += base::TimeTicks::Now() - start;
+    }
+
+    perf_test::PrintResult("audio_renderer_algorithm_fill_buffer", "",
+                           test_name,
+                           total_buffers / total_time.InMillisecondsF(),
+                           "runs/ms", true);
+  }
+
+ protected:
+  AudioRendererAlgorithm algorithm_;
+};
+
+TEST_F(AudioRendererAlgorithmPerfTest, FillBuffer) {
+  RunFillBufferTest("1.5x", 1.5);
+  RunFillBufferTest("2x", 2.0);
+  RunFillBufferTest("3x", 3.0);
+}
+
+}  // namespace media
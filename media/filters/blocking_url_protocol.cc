@@ -5,6 +5,9 @@
 #include "media/filters/blocking_url_protocol.h"
 
 #include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
 
 #include "base/bind.h"
 #include "base/macros.h"
@@ -14,6 +17,9 @@
 
 namespace media {
 
+constexpr int BlockingUrlProtocol::kMinReadAheadSize;
+constexpr int BlockingUrlProtocol::kMaxReadAheadSize;
+
 BlockingUrlProtocol::BlockingUrlProtocol(DataSource* data_source,
                                          const base::Closure& error_cb)
     : data_source_(data_source),
@@ -27,7 +33,10 @@ BlockingUrlProtocol::BlockingUrlProtocol(DataSource* data_source,
       read_complete_(base::WaitableEvent::ResetPolicy::AUTOMATIC,
                      base::WaitableEvent::InitialState::NOT_SIGNALED),
       last_read_bytes_(0),
-      read_position_(0) {}
+      read_position_(0),
+      read_ahead_position_(0),
+      read_ahead_size_(0),
+      read_ahead_window_(kMinReadAheadSize) {}
 
 BlockingUrlProtocol::~BlockingUrlProtocol() = default;
 
@@ -38,6 +47,60 @@ void BlockingUrlProtocol::Abort() {
 }
 
 int BlockingUrlProtocol::Read(int size, uint8_t* data) {
+  int bytes_read = ReadFromReadAheadBuffer(size, data);
+  if (bytes_read > 0) {
+    read_position_ += bytes_read;
+    return bytes_read;
+  }
+
+  // Streaming sources may block until the full amount arrives, so never ask
+  // them for more than FFmpeg wants. Large reads gain nothing from a copy.
+  if (is_streaming_ || size >= read_ahead_window_) {
+    bytes_read = ReadFromDataSource(read_position_, size, data);
+    if (bytes_read > 0)
+      read_position_ += bytes_read;
+    return bytes_read;
+  }
+
+  // Grow the window while FFmpeg keeps reading where the last fill ended;
+  // anything else is a seek, so start small again.
+  if (read_ahead_size_ > 0 &&
+      read_position_ == read_ahead_position_ + read_ahead_size_) {
+    read_ahead_window_ = std::min(read_ahead_window_ * 2, kMaxReadAheadSize);
+  } else {
+    read_ahead_window_ = kMinReadAheadSize;
+  }
+  if (!read_ahead_buffer_)
+    read_ahead_buffer_.reset(new uint8_t[kMaxReadAheadSize]);
+
+  read_ahead_size_ = 0;
+  bytes_read = ReadFromDataSource(read_position_, read_ahead_window_,
+                                  read_ahead_buffer_.get());
+  if (bytes_read <= 0)
+    return bytes_read;
+  read_ahead_position_ = read_position_;
+  read_ahead_size_ = bytes_read;
+
+  bytes_read = ReadFromReadAheadBuffer(size, data);
+  read_position_ += bytes_read;
+  return bytes_read;
+}
+
+int BlockingUrlProtocol::ReadFromReadAheadBuffer(int size, uint8_t* data) {
+  if (read_position_ < read_ahead_position_ ||
+      read_position_ >= read_ahead_position_ + read_ahead_size_) {
+    return 0;
+  }
+
+  const int offset = static_cast<int>(read_position_ - read_ahead_position_);
+  const int bytes_to_copy = std::min(size, read_ahead_size_ - offset);
+  memcpy(data, read_ahead_buffer_.get() + offset, bytes_to_copy);
+  return bytes_to_copy;
+}
+
+int BlockingUrlProtocol::ReadFromDataSource(int64_t position,
+                                            int size,
+                                            uint8_t* data) {
   {
     // Read errors are unrecoverable.
     base::AutoLock lock(data_source_lock_);
@@ -49,13 +112,13 @@ int BlockingUrlProtocol::Read(int size, uint8_t* data) {
     // Even though FFmpeg defines AVERROR_EOF, it's not to be used with I/O
     // routines. Instead return 0 for any read at or past EOF.
     int64_t file_size;
-    if (data_source_->GetSize(&file_size) && read_position_ >= file_size)
+    if (data_source_->GetSize(&file_size) && position >= file_size)
       return 0;
 
     // Blocking read from data source until either:
     //   1) |last_read_bytes_| is set and |read_complete_| is signalled
     //   2) |aborted_| is signalled
-    data_source_->Read(read_position_, size, data,
+    data_source_->Read(position, size, data,
                        base::Bind(&BlockingUrlProtocol::SignalReadCompleted,
                                   base::Unretained(this)));
   }
@@ -79,7 +142,6 @@ int BlockingUrlProtocol::Read(int size, uint8_t* data) {
   if (last_read_bytes_ == DataSource::kAborted)
     return AVERROR(EIO);
 
-  read_position_ += last_read_bytes_;
   return last_read_bytes_;
 }
 
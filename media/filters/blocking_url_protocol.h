@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <memory>
+
 #include "base/callback.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
@@ -21,6 +23,10 @@ class DataSource;
 // asynchronous DataSource::Read() operation completes. Generally constructed on
 // the media thread and used by ffmpeg through the AVIO interface from a
 // sequenced blocking pool.
+//
+// For non-streaming sources, small reads are served from a read-ahead buffer
+// whose size grows while reads stay sequential and shrinks back after a seek,
+// so that each blocking round trip to the DataSource fetches more data.
 class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
  public:
   // Implements FFmpegURLProtocol using the given |data_source|. |error_cb| is
@@ -40,7 +46,19 @@ class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
   bool GetSize(int64_t* size_out) override;
   bool IsStreaming() override;
 
+  // Bounds for the adaptive read-ahead window, in bytes.
+  static constexpr int kMinReadAheadSize = 64 * 1024;
+  static constexpr int kMaxReadAheadSize = 1024 * 1024;
+
  private:
+  // Blocks on DataSource::Read() of |size| bytes at |position| into |data|.
+  // Returns the number of bytes read, 0 at EOF or AVERROR(EIO) on failure.
+  int ReadFromDataSource(int64_t position, int size, uint8_t* data);
+
+  // Copies up to |size| bytes at |read_position_| out of the read-ahead buffer.
+  // Returns the number of bytes copied, which is 0 on a miss.
+  int ReadFromReadAheadBuffer(int size, uint8_t* data);
+
   // Sets |last_read_bytes_| and signals the blocked thread that the read
   // has completed.
   void SignalReadCompleted(int size);
@@ -64,6 +82,15 @@ class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
   // Cached position within the data source.
   int64_t read_position_;
 
+  // Data read ahead of |read_position_|. Holds |read_ahead_size_| valid bytes
+  // starting at |read_ahead_position_|. Only touched by the reading thread.
+  std::unique_ptr<uint8_t[]> read_ahead_buffer_;
+  int64_t read_ahead_position_;
+  int read_ahead_size_;
+
+  // Size of the next read-ahead fill; see kMin/kMaxReadAheadSize.
+  int read_ahead_window_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(BlockingUrlProtocol);
 };
 
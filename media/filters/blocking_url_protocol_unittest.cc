@@ -4,8 +4,11 @@
 
 #include <stdint.h>
 
+#include <string>
+
 #include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/macros.h"
 #include "base/synchronization/waitable_event.h"
 #include "media/base/test_data_util.h"
@@ -74,6 +77,35 @@ TEST_F(BlockingUrlProtocolTest, Read) {
   EXPECT_EQ(size, position);
 }
 
+TEST_F(BlockingUrlProtocolTest, ReadAhead) {
+  std::string file_contents;
+  ASSERT_TRUE(base::ReadFileToString(GetTestDataFilePath("bear-320x240.webm"),
+                                     &file_contents));
+  const int64_t size = file_contents.size();
+
+  // Read the whole file in small sequential chunks, which are served from the
+  // read-ahead buffer, and verify nothing is lost or reordered.
+  EXPECT_TRUE(url_protocol_->SetPosition(0));
+  std::string read_contents;
+  uint8_t buffer[1000];
+  int bytes_read;
+  while ((bytes_read = url_protocol_->Read(sizeof(buffer), buffer)) > 0)
+    read_contents.append(reinterpret_cast<char*>(buffer), bytes_read);
+  EXPECT_EQ(0, bytes_read);
+  EXPECT_EQ(file_contents, read_contents);
+
+  // Seeking backwards must not return stale read-ahead data.
+  const int64_t kSeekPosition = size / 2 + 7;
+  EXPECT_TRUE(url_protocol_->SetPosition(kSeekPosition));
+  bytes_read = url_protocol_->Read(sizeof(buffer), buffer);
+  ASSERT_GT(bytes_read, 0);
+  EXPECT_EQ(file_contents.substr(kSeekPosition, bytes_read),
+            std::string(reinterpret_cast<char*>(buffer), bytes_read));
+  int64_t position = 0;
+  EXPECT_TRUE(url_protocol_->GetPosition(&position));
+  EXPECT_EQ(kSeekPosition + bytes_read, position);
+}
+
 TEST_F(BlockingUrlProtocolTest, ReadError) {
   data_source_.force_read_errors_for_testing();
 
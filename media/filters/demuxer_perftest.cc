@@ -173,6 +173,7 @@ int StreamReader::GetNextStreamIndexToRead() {
 static void RunDemuxerBenchmark(const std::string& filename) {
   base::FilePath file_path(GetTestDataFilePath(filename));
   base::TimeDelta total_time;
+  int64_t file_size = 0;
   MediaLog media_log_;
   for (int i = 0; i < kBenchmarkIterations; ++i) {
     // Setup.
@@ -180,6 +181,7 @@ static void RunDemuxerBenchmark(const std::string& filename) {
     DemuxerHostImpl demuxer_host;
     FileDataSource data_source;
     ASSERT_TRUE(data_source.Initialize(file_path));
+    ASSERT_TRUE(data_source.GetSize(&file_size));
 
     Demuxer::EncryptedMediaInitDataCB encrypted_media_init_data_cb =
         base::BindRepeating(&OnEncryptedMediaInitData);
@@ -210,6 +212,11 @@ static void RunDemuxerBenchmark(const std::string& filename) {
   perf_test::PrintResult("demuxer_bench", "", filename,
                          kBenchmarkIterations / total_time.InSecondsF(),
                          "runs/s", true);
+  const double total_megabytes =
+      kBenchmarkIterations * file_size / (1024.0 * 1024.0);
+  perf_test::PrintResult("demuxer_throughput", "", filename,
+                         total_megabytes / total_time.InSecondsF(), "MB/s",
+                         true);
 }
 
 class DemuxerPerfTest : public testing::TestWithParam<const char*> {};
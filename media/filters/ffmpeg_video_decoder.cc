@@ -9,11 +9,14 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "base/bind.h"
+#include "base/bits.h"
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/location.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/sys_info.h"
@@ -28,6 +31,7 @@
 #include "media/base/video_util.h"
 #include "media/ffmpeg/ffmpeg_common.h"
 #include "media/ffmpeg/ffmpeg_decoding_loop.h"
+#include "media/filters/frame_buffer_pool.h"
 
 namespace media {
 
@@ -115,7 +119,10 @@ bool FFmpegVideoDecoder::IsCodecSupported(VideoCodec codec) {
 }
 
 FFmpegVideoDecoder::FFmpegVideoDecoder(MediaLog* media_log)
-    : media_log_(media_log), state_(kUninitialized), decode_nalus_(false) {
+    : media_log_(media_log),
+      state_(kUninitialized),
+      decode_nalus_(false),
+      decoded_frame_count_(0) {
   thread_checker_.DetachFromThread();
 }
 
@@ -169,13 +176,50 @@ int FFmpegVideoDecoder::GetVideoBuffer(struct AVCodecContext* codec_context,
     return AVERROR(EINVAL);
   }
 
+  // Lay the planes out the same way VideoFrame::AllocateMemory() does, which in
+  // turn mirrors ffmpeg's get_video_buffer().
+  const std::vector<int32_t> strides =
+      VideoFrame::ComputeStrides(format, coded_size);
+  size_t plane_offsets[VideoFrame::kMaxPlanes] = {};
+  size_t allocation_size = 0;
+  for (size_t plane = 0; plane < strides.size(); ++plane) {
+    plane_offsets[plane] = allocation_size;
+    allocation_size +=
+        strides[plane] *
+        base::bits::Align(VideoFrame::Rows(plane, format, coded_size.height()),
+                          VideoFrame::kFrameAddressAlignment);
+  }
+  // h264 chroma MC overreads by one line; see VideoFrame::CalculatePlaneSize().
+  allocation_size +=
+      strides[VideoFrame::kUPlane] + VideoFrame::kFrameSizePadding;
+
   // FFmpeg expects the initialize allocation to be zero-initialized.  Failure
   // to do so can lead to unitialized value usage.  See http://crbug.com/390941
-  scoped_refptr<VideoFrame> video_frame = frame_pool_.CreateFrame(
-      format, coded_size, gfx::Rect(size), natural_size, kNoTimestamp);
-
-  if (!video_frame)
+  // |frame_pool_| is created with zero initialization for this reason.
+  void* fb_priv = nullptr;
+  uint8_t* data = frame_pool_->GetFrameBuffer(
+      allocation_size + VideoFrame::kFrameAddressAlignment - 1, &fb_priv);
+  data = reinterpret_cast<uint8_t*>(
+      base::bits::Align(reinterpret_cast<uintptr_t>(data),
+                        VideoFrame::kFrameAddressAlignment));
+
+  scoped_refptr<VideoFrame> video_frame = VideoFrame::WrapExternalYuvData(
+      format, coded_size, gfx::Rect(size), natural_size,
+      strides[VideoFrame::kYPlane], strides[VideoFrame::kUPlane],
+      strides[VideoFrame::kVPlane],
+      data + plane_offsets[VideoFrame::kYPlane],
+      data + plane_offsets[VideoFrame::kUPlane],
+      data + plane_offsets[VideoFrame::kVPlane], kNoTimestamp);
+  if (!video_frame) {
+    frame_pool_->ReleaseFrameBuffer(fb_priv);
     return AVERROR(EINVAL);
+  }
+
+  // The buffer now lives exactly as long as |video_frame|, which FFmpeg keeps
+  // alive through the AVBufferRef created below.
+  video_frame->AddDestructionObserver(
+      frame_pool_->CreateFrameCallback(fb_priv));
+  frame_pool_->ReleaseFrameBuffer(fb_priv);
 
   // Prefer the color space from the codec context. If it's not specified (or is
   // set to an unsupported value), fall back on the value from the config.
@@ -223,12 +267,8 @@ int FFmpegVideoDecoder::GetVideoBuffer(struct AVCodecContext* codec_context,
   // reference to the VideoFrame object.
   VideoFrame* opaque = video_frame.get();
   opaque->AddRef();
-  frame->buf[0] =
-      av_buffer_create(frame->data[0],
-                       VideoFrame::AllocationSize(format, coded_size),
-                       ReleaseVideoBufferImpl,
-                       opaque,
-                       0);
+  frame->buf[0] = av_buffer_create(frame->data[0], allocation_size,
+                                   ReleaseVideoBufferImpl, opaque, 0);
   return 0;
 }
 
@@ -331,8 +371,15 @@ void FFmpegVideoDecoder::Reset(const base::Closure& closure) {
 FFmpegVideoDecoder::~FFmpegVideoDecoder() {
   DCHECK(thread_checker_.CalledOnValidThread());
 
-  if (state_ != kUninitialized)
+  if (state_ != kUninitialized) {
+    RecordDecodeFps();
     ReleaseFFmpegResources();
+  }
+
+  // FFmpeg has released all of its buffers above; frames still held by the
+  // renderer return their memory as they are destroyed.
+  if (frame_pool_)
+    frame_pool_->Shutdown();
 }
 
 bool FFmpegVideoDecoder::FFmpegDecode(const DecoderBuffer& buffer) {
@@ -354,9 +401,14 @@ bool FFmpegVideoDecoder::FFmpegDecode(const DecoderBuffer& buffer) {
     codec_context_->reordered_opaque = buffer.timestamp().InMicroseconds();
   }
 
-  switch (decoding_loop_->DecodePacket(
-      &packet, base::BindRepeating(&FFmpegVideoDecoder::OnNewFrame,
-                                   base::Unretained(this)))) {
+  const base::TimeTicks decode_start = base::TimeTicks::Now();
+  const FFmpegDecodingLoop::DecodeStatus decode_status =
+      decoding_loop_->DecodePacket(
+          &packet, base::BindRepeating(&FFmpegVideoDecoder::OnNewFrame,
+                                       base::Unretained(this)));
+  total_decode_time_ += base::TimeTicks::Now() - decode_start;
+
+  switch (decode_status) {
     case FFmpegDecodingLoop::DecodeStatus::kSendPacketFailed:
       MEDIA_LOG(ERROR, media_log_)
           << "Failed to send video packet for decoding: "
@@ -394,10 +446,26 @@ bool FFmpegVideoDecoder::OnNewFrame(AVFrame* frame) {
       base::TimeDelta::FromMicroseconds(frame->reordered_opaque));
   video_frame->metadata()->SetBoolean(VideoFrameMetadata::POWER_EFFICIENT,
                                       false);
+  ++decoded_frame_count_;
   output_cb_.Run(video_frame);
   return true;
 }
 
+void FFmpegVideoDecoder::RecordDecodeFps() {
+  // Report how many frames per second of decode time FFmpeg sustained, which
+  // is what limits software playback of high resolution content.
+  if (decoded_frame_count_ == 0 || total_decode_time_.is_zero())
+    return;
+
+  const int decode_fps = decoded_frame_count_ / total_decode_time_.InSecondsF();
+  if (config_.coded_size().height() > 1080) {
+    UMA_HISTOGRAM_COUNTS_1000("Media.FFmpegVideoDecoder.DecodeFps.Above1080p",
+                              decode_fps);
+  } else {
+    UMA_HISTOGRAM_COUNTS_1000("Media.FFmpegVideoDecoder.DecodeFps", decode_fps);
+  }
+}
+
 void FFmpegVideoDecoder::ReleaseFFmpegResources() {
   decoding_loop_.reset();
   codec_context_.reset();
@@ -411,6 +479,14 @@ bool FFmpegVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config,
   // Release existing decoder resources if necessary.
   ReleaseFFmpegResources();
 
+  // Only the last configuration is reported, since the decode rate depends on
+  // it.
+  decoded_frame_count_ = 0;
+  total_decode_time_ = base::TimeDelta();
+
+  if (!frame_pool_)
+    frame_pool_ = new FrameBufferPool(/*zero_initialize_memory=*/true);
+
   // Initialize AVCodecContext structure.
   codec_context_.reset(avcodec_alloc_context3(NULL));
   VideoDecoderConfigToAVCodecContext(config, codec_context_.get());
@@ -12,9 +12,9 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "media/base/video_decoder.h"
 #include "media/base/video_decoder_config.h"
-#include "media/base/video_frame_pool.h"
 #include "media/ffmpeg/ffmpeg_deleters.h"
 
 struct AVCodecContext;
@@ -24,6 +24,7 @@ namespace media {
 
 class DecoderBuffer;
 class FFmpegDecodingLoop;
+class FrameBufferPool;
 class MediaLog;
 
 class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
@@ -74,6 +75,9 @@ class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
   // Returns true if initialization was successful.
   bool ConfigureDecoder(const VideoDecoderConfig& config, bool low_delay);
 
+  // Records the decode rate of the current configuration.
+  void RecordDecodeFps();
+
   // Releases resources associated with |codec_context_|.
   void ReleaseFFmpegResources();
 
@@ -89,12 +93,19 @@ class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
 
   VideoDecoderConfig config_;
 
-  VideoFramePool frame_pool_;
+  // Backs the frames handed to FFmpeg. Any free buffer that is large enough is
+  // reused, so resolution changes do not throw away the pool.
+  scoped_refptr<FrameBufferPool> frame_pool_;
 
   bool decode_nalus_;
 
   std::unique_ptr<FFmpegDecodingLoop> decoding_loop_;
 
+  // Frames output and time spent in FFmpegDecode() since the last
+  // (re-)configuration, reported as the decode frame rate on destruction.
+  int decoded_frame_count_;
+  base::TimeDelta total_decode_time_;
+
   DISALLOW_COPY_AND_ASSIGN(FFmpegVideoDecoder);
 };
 
@@ -17,10 +17,13 @@
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
 #include "base/strings/string_util.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_command_line.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/gmock_callback_support.h"
 #include "media/base/limits.h"
 #include "media/base/media_log.h"
+#include "media/base/media_switches.h"
 #include "media/base/media_util.h"
 #include "media/base/mock_filters.h"
 #include "media/base/mock_media_log.h"
@@ -260,6 +263,47 @@ TEST_F(FFmpegVideoDecoderTest, DecodeFrame_Normal) {
   ASSERT_EQ(1U, output_frames_.size());
 }
 
+// Decodes with several frame threads, which return buffers and release frames
+// on FFmpeg's worker threads, across a reconfiguration and past the decoder's
+// destruction.
+TEST_F(FFmpegVideoDecoderTest, DecodeFrame_FrameThreading) {
+  base::test::ScopedCommandLine scoped_command_line;
+  scoped_command_line.GetProcessCommandLine()->AppendSwitchASCII(
+      switches::kVideoThreads, "4");
+  base::HistogramTester histogram_tester;
+  Initialize();
+
+  const size_t kNumFrames = 16;
+  InputBuffers input_buffers(kNumFrames, i_frame_buffer_);
+  input_buffers.push_back(end_of_stream_buffer_);
+  EXPECT_EQ(DecodeStatus::OK, DecodeMultipleFrames(input_buffers));
+  ASSERT_EQ(kNumFrames, output_frames_.size());
+
+  // Return half of the frames, which the next configuration may reuse.
+  output_frames_.resize(kNumFrames / 2);
+  base::RunLoop().RunUntilIdle();
+
+  Reinitialize();
+  histogram_tester.ExpectTotalCount("Media.FFmpegVideoDecoder.DecodeFps", 0);
+
+  EXPECT_EQ(DecodeStatus::OK, DecodeMultipleFrames(input_buffers));
+  ASSERT_EQ(kNumFrames / 2 + kNumFrames, output_frames_.size());
+
+  Destroy();
+  histogram_tester.ExpectTotalCount("Media.FFmpegVideoDecoder.DecodeFps", 1);
+
+  // The frames remain valid after the decoder and its pool are gone. They were
+  // all decoded from the same I-frame.
+  for (const auto& frame : output_frames_) {
+    EXPECT_EQ(kVisibleRect, frame->visible_rect());
+    EXPECT_EQ(0, memcmp(output_frames_[0]->data(VideoFrame::kYPlane),
+                        frame->data(VideoFrame::kYPlane),
+                        kVisibleRect.width()));
+  }
+  output_frames_.clear();
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST_F(FFmpegVideoDecoderTest, DecodeFrame_DecodeError) {
   Initialize();
 
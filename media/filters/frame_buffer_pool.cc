@@ -6,10 +6,8 @@
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
-#include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
-#include "base/sequenced_task_runner.h"
 #include "base/stl_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/trace_event/memory_allocator_dump.h"
@@ -31,8 +29,9 @@ struct FrameBufferPool::FrameBuffer {
   base::TimeTicks last_use_time;
 };
 
-FrameBufferPool::FrameBufferPool()
-    : tick_clock_(base::DefaultTickClock::GetInstance()) {
+FrameBufferPool::FrameBufferPool(bool zero_initialize_memory)
+    : zero_initialize_memory_(zero_initialize_memory),
+      tick_clock_(base::DefaultTickClock::GetInstance()) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -44,7 +43,6 @@ FrameBufferPool::~FrameBufferPool() {
 
 uint8_t* FrameBufferPool::GetFrameBuffer(size_t min_size, void** fb_priv) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  DCHECK(!in_shutdown_);
 
   if (!registered_dump_provider_) {
     base::trace_event::MemoryDumpManager::GetInstance()
@@ -54,6 +52,9 @@ uint8_t* FrameBufferPool::GetFrameBuffer(size_t min_size, void** fb_priv) {
     registered_dump_provider_ = true;
   }
 
+  base::AutoLock auto_lock(lock_);
+  DCHECK(!in_shutdown_);
+
   // Check if a free frame buffer exists.
   auto it = std::find_if(
       frame_buffers_.begin(), frame_buffers_.end(),
@@ -69,9 +70,11 @@ uint8_t* FrameBufferPool::GetFrameBuffer(size_t min_size, void** fb_priv) {
   frame_buffer->held_by_library = true;
   if (frame_buffer->data_size < min_size) {
     // Free the existing |data| first so that the memory can be reused,
-    // if possible. Note that the new array is purposely not initialized.
+    // if possible. Note that the new array is purposely not initialized
+    // unless the library requires it.
     frame_buffer->data.reset();
-    frame_buffer->data.reset(new uint8_t[min_size]);
+    frame_buffer->data.reset(zero_initialize_memory_ ? new uint8_t[min_size]()
+                                                     : new uint8_t[min_size]);
     frame_buffer->data_size = min_size;
   }
 
@@ -85,6 +88,7 @@ void FrameBufferPool::ReleaseFrameBuffer(void* fb_priv) {
 
   // Note: The library may invoke this method multiple times for the same frame,
   // so we can't DCHECK that |held_by_library| is true.
+  base::AutoLock auto_lock(lock_);
   auto* frame_buffer = static_cast<FrameBuffer*>(fb_priv);
   frame_buffer->held_by_library = false;
 
@@ -96,6 +100,7 @@ uint8_t* FrameBufferPool::AllocateAlphaPlaneForFrameBuffer(size_t min_size,
                                                            void* fb_priv) {
   DCHECK(fb_priv);
 
+  base::AutoLock auto_lock(lock_);
   auto* frame_buffer = static_cast<FrameBuffer*>(fb_priv);
   DCHECK(IsUsed(frame_buffer));
   if (frame_buffer->alpha_data_size < min_size) {
@@ -111,11 +116,12 @@ uint8_t* FrameBufferPool::AllocateAlphaPlaneForFrameBuffer(size_t min_size,
 base::Closure FrameBufferPool::CreateFrameCallback(void* fb_priv) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+  base::AutoLock auto_lock(lock_);
   auto* frame_buffer = static_cast<FrameBuffer*>(fb_priv);
   ++frame_buffer->held_by_frame;
 
   return base::Bind(&FrameBufferPool::OnVideoFrameDestroyed, this,
-                    base::SequencedTaskRunnerHandle::Get(), frame_buffer);
+                    frame_buffer);
 }
 
 bool FrameBufferPool::OnMemoryDump(
@@ -133,6 +139,7 @@ bool FrameBufferPool::OnMemoryDump(
                             ->system_allocator_pool_name());
   size_t bytes_used = 0;
   size_t bytes_reserved = 0;
+  base::AutoLock auto_lock(lock_);
   for (const auto& frame_buffer : frame_buffers_) {
     if (IsUsed(frame_buffer.get()))
       bytes_used += frame_buffer->data_size + frame_buffer->alpha_data_size;
@@ -151,13 +158,15 @@ bool FrameBufferPool::OnMemoryDump(
 
 void FrameBufferPool::Shutdown() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  in_shutdown_ = true;
 
   if (registered_dump_provider_) {
     base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
         this);
   }
 
+  base::AutoLock auto_lock(lock_);
+  in_shutdown_ = true;
+
   // Clear any refs held by the library which isn't good about cleaning up after
   // itself. This is safe since the library has already been shutdown by this
   // point.
@@ -173,23 +182,14 @@ bool FrameBufferPool::IsUsed(const FrameBuffer* buf) {
 }
 
 void FrameBufferPool::EraseUnusedResources() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  lock_.AssertAcquired();
   base::EraseIf(frame_buffers_, [](const std::unique_ptr<FrameBuffer>& buf) {
     return !IsUsed(buf.get());
   });
 }
 
-void FrameBufferPool::OnVideoFrameDestroyed(
-    scoped_refptr<base::SequencedTaskRunner> task_runner,
-    FrameBuffer* frame_buffer) {
-  if (!task_runner->RunsTasksInCurrentSequence()) {
-    task_runner->PostTask(
-        FROM_HERE, base::Bind(&FrameBufferPool::OnVideoFrameDestroyed, this,
-                              task_runner, frame_buffer));
-    return;
-  }
-
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+void FrameBufferPool::OnVideoFrameDestroyed(FrameBuffer* frame_buffer) {
+  base::AutoLock auto_lock(lock_);
   DCHECK_GT(frame_buffer->held_by_frame, 0);
   --frame_buffer->held_by_frame;
 
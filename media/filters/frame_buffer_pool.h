@@ -13,25 +13,28 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
 #include "base/time/default_tick_clock.h"
 #include "base/time/time.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "media/base/media_export.h"
 
-namespace base {
-class SequencedTaskRunner;
-}
-
 namespace media {
 
 // FrameBufferPool is a pool of simple CPU memory. This class needs to be ref-
 // counted since frames created using this memory may live beyond the lifetime
 // of the caller to this class.
+//
+// Buffers are handed out, and the pool is shut down, on a single sequence.
+// Libraries may return buffers, and frames using them may be destroyed, on any
+// thread, e.g. on a decoder's worker threads.
 class MEDIA_EXPORT FrameBufferPool
     : public base::RefCountedThreadSafe<FrameBufferPool>,
       public base::trace_event::MemoryDumpProvider {
  public:
-  FrameBufferPool();
+  // Set |zero_initialize_memory| for libraries which require newly allocated
+  // frame buffers to be zeroed, like FFmpeg.
+  explicit FrameBufferPool(bool zero_initialize_memory = false);
 
   // Called when a frame buffer allocation is needed. Upon return |fb_priv| will
   // be set to a private value used to identify the buffer in future calls and a
@@ -49,7 +52,10 @@ class MEDIA_EXPORT FrameBufferPool
   // |fb_priv| must be a value previously returned by GetFrameBuffer().
   base::Closure CreateFrameCallback(void* fb_priv);
 
-  size_t get_pool_size_for_testing() const { return frame_buffers_.size(); }
+  size_t get_pool_size_for_testing() const {
+    base::AutoLock auto_lock(lock_);
+    return frame_buffers_.size();
+  }
 
   void set_tick_clock_for_testing(const base::TickClock* tick_clock) {
     tick_clock_ = tick_clock;
@@ -80,14 +86,17 @@ class MEDIA_EXPORT FrameBufferPool
   void EraseUnusedResources();
 
   // Method that gets called when a VideoFrame that references this pool gets
-  // destroyed.
-  void OnVideoFrameDestroyed(
-      scoped_refptr<base::SequencedTaskRunner> task_runner,
-      FrameBuffer* frame_buffer);
+  // destroyed. May be called on any thread.
+  void OnVideoFrameDestroyed(FrameBuffer* frame_buffer);
+
+  // Guards |frame_buffers_|, the FrameBuffers in it and |in_shutdown_|.
+  mutable base::Lock lock_;
 
   // Allocated frame buffers.
   std::vector<std::unique_ptr<FrameBuffer>> frame_buffers_;
 
+  const bool zero_initialize_memory_;
+
   bool in_shutdown_ = false;
 
   bool registered_dump_provider_ = false;
@@ -57,6 +57,30 @@ TEST(FrameBufferPool, BasicFunctionality) {
   EXPECT_EQ(0u, pool->get_pool_size_for_testing());
 }
 
+TEST(FrameBufferPool, ZeroInitializedAndReusedAcrossSizes) {
+  base::TestMessageLoop message_loop;
+  scoped_refptr<FrameBufferPool> pool =
+      new FrameBufferPool(/*zero_initialize_memory=*/true);
+
+  void* priv1 = nullptr;
+  uint8_t* buf1 = pool->GetFrameBuffer(kBufferSize, &priv1);
+  for (size_t i = 0; i < kBufferSize; ++i)
+    ASSERT_EQ(0, buf1[i]);
+  auto frame_release_cb = pool->CreateFrameCallback(priv1);
+  pool->ReleaseFrameBuffer(priv1);
+  frame_release_cb.Run();
+
+  // A smaller request, e.g. after a resolution change, reuses the buffer.
+  void* priv2 = nullptr;
+  uint8_t* buf2 = pool->GetFrameBuffer(kBufferSize / 2, &priv2);
+  EXPECT_EQ(priv1, priv2);
+  EXPECT_EQ(buf1, buf2);
+  EXPECT_EQ(1u, pool->get_pool_size_for_testing());
+
+  pool->ReleaseFrameBuffer(priv2);
+  pool->Shutdown();
+}
+
 TEST(FrameBufferPool, DeferredDestruction) {
   base::TestMessageLoop message_loop;
   scoped_refptr<FrameBufferPool> pool = new FrameBufferPool();
@@ -5,6 +5,7 @@
 #include "media/filters/source_buffer_stream.h"
 
 #include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -1818,6 +1819,10 @@ SourceBufferStream<RangeClass>::FindExistingRangeFor(
     DecodeTimestamp start_timestamp) {
   for (typename RangeList::iterator itr = ranges_.begin(); itr != ranges_.end();
        ++itr) {
+    // |ranges_| is sorted, and a range never accepts timestamps before its
+    // start, so no later range can match either.
+    if (RangeGetStartTimestamp(itr->get()) > start_timestamp)
+      break;
     if (RangeBelongsToRange(itr->get(), start_timestamp))
       return itr;
   }
@@ -1829,10 +1834,14 @@ typename SourceBufferStream<RangeClass>::RangeList::iterator
 SourceBufferStream<RangeClass>::AddToRanges(
     std::unique_ptr<RangeClass> new_range) {
   DecodeTimestamp start_timestamp = RangeGetStartTimestamp(new_range.get());
+  // Search from the back, since new ranges are almost always created at the
+  // live edge or just behind it, and long sessions can accumulate many ranges.
   typename RangeList::iterator itr = ranges_.end();
-  for (itr = ranges_.begin(); itr != ranges_.end(); ++itr) {
-    if (RangeGetStartTimestamp(itr->get()) > start_timestamp)
+  while (itr != ranges_.begin()) {
+    typename RangeList::iterator prev = std::prev(itr);
+    if (RangeGetStartTimestamp(prev->get()) <= start_timestamp)
       break;
+    itr = prev;
   }
   return ranges_.insert(itr, std::move(new_range));
 }
@@ -0,0 +1,102 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/source_buffer_stream.h"
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+
+#include "base/time/time.h"
+#include "media/base/media_log.h"
+#include "media/base/stream_parser_buffer.h"
+#include "media/base/test_helpers.h"
+#include "media/filters/source_buffer_range_by_pts.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kFramesPerSecond = 30;
+static const int kFramesPerGop = 30;
+static const uint8_t kData[] = {0};
+
+class SourceBufferStreamPerfTest : public testing::Test {
+ public:
+  SourceBufferStreamPerfTest()
+      : stream_(new SourceBufferStream<SourceBufferRangeByPts>(
+            TestVideoConfig::Normal(),
+            &media_log_)),
+        frame_duration_(base::TimeDelta::FromSeconds(1) / kFramesPerSecond) {}
+
+  // Appends one GOP as its own coded frame group starting at frame
+  // |start_frame|.
+  void AppendGop(int start_frame) {
+    base::TimeDelta start = frame_duration_ * start_frame;
+    stream_->OnStartOfCodedFrameGroup(
+        DecodeTimestamp::FromPresentationTime(start), start);
+
+    SourceBufferStream<SourceBufferRangeByPts>::BufferQueue buffers;
+    for (int i = 0; i < kFramesPerGop; ++i) {
+      scoped_refptr<StreamParserBuffer> buffer = StreamParserBuffer::CopyFrom(
+          kData, sizeof(kData), i == 0, DemuxerStream::VIDEO, 0);
+      base::TimeDelta timestamp = frame_duration_ * (start_frame + i);
+      buffer->set_timestamp(timestamp);
+      buffer->SetDecodeTimestamp(
+          DecodeTimestamp::FromPresentationTime(timestamp));
+      buffer->set_duration(frame_duration_);
+      buffers.push_back(buffer);
+    }
+    ASSERT_TRUE(stream_->Append(buffers));
+  }
+
+  // Simulates a live stream: GOPs are appended back to back while playback
+  // trails the live edge and garbage collection keeps memory bounded.
+  void RunLiveAppendTest(const std::string& test_name, int gop_count) {
+    stream_->set_memory_limit(kFramesPerGop * 60 * sizeof(kData));
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int gop = 0; gop < gop_count; ++gop) {
+      int start_frame = gop * kFramesPerGop;
+      AppendGop(start_frame);
+      stream_->GarbageCollectIfNeeded(
+          DecodeTimestamp::FromPresentationTime(frame_duration_ * start_frame),
+          0);
+    }
+    double total_time_milliseconds =
+        (base::TimeTicks::Now() - start).InMillisecondsF();
+    perf_test::PrintResult("source_buffer_stream_live_append", "", test_name,
+                           gop_count / total_time_milliseconds, "runs/ms",
+                           true);
+  }
+
+  // Appends GOPs separated by gaps, so every GOP becomes its own range, as
+  // happens with sparse seeking over a long session.
+  void RunSparseAppendTest(const std::string& test_name, int range_count) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int range = 0; range < range_count; ++range)
+      AppendGop(range * kFramesPerGop * 2);
+    double total_time_milliseconds =
+        (base::TimeTicks::Now() - start).InMillisecondsF();
+    perf_test::PrintResult("source_buffer_stream_sparse_append", "", test_name,
+                           range_count / total_time_milliseconds, "runs/ms",
+                           true);
+  }
+
+ protected:
+  MediaLog media_log_;
+  std::unique_ptr<SourceBufferStream<SourceBufferRangeByPts>> stream_;
+  base::TimeDelta frame_duration_;
+};
+
+TEST_F(SourceBufferStreamPerfTest, LiveAppend) {
+  // Ten hours of 1s GOPs.
+  RunLiveAppendTest("36000_gops", 36000);
+}
+
+TEST_F(SourceBufferStreamPerfTest, SparseAppend) {
+  RunSparseAppendTest("1000_ranges", 1000);
+}
+
+}  // namespace media
@@ -85,6 +85,9 @@ VideoCadenceEstimator::~VideoCadenceEstimator() = default;
 void VideoCadenceEstimator::Reset() {
   cadence_.clear();
   pending_cadence_.clear();
+  last_calculated_cadence_.clear();
+  last_render_interval_ = last_frame_duration_ = last_max_acceptable_drift_ =
+      last_time_until_max_drift_ = base::TimeDelta();
   cadence_changes_ = render_intervals_cadence_held_ = 0;
   first_update_call_ = true;
 }
@@ -113,12 +116,19 @@ bool VideoCadenceEstimator::UpdateCadenceEstimate(
     return false;
   }
 
-  base::TimeDelta time_until_max_drift;
-
-  // See if we can find a cadence which fits the data.
-  Cadence new_cadence =
-      CalculateCadence(render_interval, frame_duration, max_acceptable_drift,
-                       &time_until_max_drift);
+  // See if we can find a cadence which fits the data.  The inputs are stable
+  // between most Render() calls, so only recalculate when they change.
+  if (render_interval != last_render_interval_ ||
+      frame_duration != last_frame_duration_ ||
+      max_acceptable_drift != last_max_acceptable_drift_) {
+    last_render_interval_ = render_interval;
+    last_frame_duration_ = frame_duration;
+    last_max_acceptable_drift_ = max_acceptable_drift;
+    last_calculated_cadence_ =
+        CalculateCadence(render_interval, frame_duration, max_acceptable_drift,
+                         &last_time_until_max_drift_);
+  }
+  const Cadence& new_cadence = last_calculated_cadence_;
 
   // If this is the first time UpdateCadenceEstimate() has been called,
   // initialize the histogram with a zero count for cadence changes; this
@@ -145,8 +155,9 @@ bool VideoCadenceEstimator::UpdateCadenceEstimate(
         cadence_hysteresis_threshold_) {
       DVLOG(1) << "Cadence switch: " << CadenceToString(cadence_) << " -> "
                << CadenceToString(new_cadence)
-               << " :: Time until drift exceeded: " << time_until_max_drift;
-      cadence_.swap(new_cadence);
+               << " :: Time until drift exceeded: "
+               << last_time_until_max_drift_;
+      cadence_ = new_cadence;
 
       // Note: Because this class is transitively owned by a garbage collected
       // object, WebMediaPlayer, we log cadence changes as they are encountered.
@@ -162,7 +173,7 @@ bool VideoCadenceEstimator::UpdateCadenceEstimate(
            << CadenceToString(new_cadence);
 
   if (update_pending_cadence) {
-    pending_cadence_.swap(new_cadence);
+    pending_cadence_ = new_cadence;
     render_intervals_cadence_held_ = 1;
   }
 
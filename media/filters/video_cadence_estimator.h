@@ -149,6 +149,15 @@ class MEDIA_EXPORT VideoCadenceEstimator {
   int render_intervals_cadence_held_;
   base::TimeDelta cadence_hysteresis_threshold_;
 
+  // Inputs and result of the last CalculateCadence() call.  The render
+  // interval and frame duration rarely change between UpdateCadenceEstimate()
+  // calls, so the result is reused instead of rebuilt on every Render().
+  base::TimeDelta last_render_interval_;
+  base::TimeDelta last_frame_duration_;
+  base::TimeDelta last_max_acceptable_drift_;
+  base::TimeDelta last_time_until_max_drift_;
+  Cadence last_calculated_cadence_;
+
   // Tracks how many times cadence has switched during a given playback, used to
   // histogram the number of cadence changes in a playback.
   bool first_update_call_;
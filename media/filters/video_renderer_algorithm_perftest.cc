@@ -0,0 +1,102 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/video_renderer_algorithm.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "base/time/time.h"
+#include "media/base/media_log.h"
+#include "media/base/video_frame_pool.h"
+#include "media/base/wall_clock_time_source.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+// Number of Render() calls made for each frame rate and refresh rate pair.
+static const int kRenderCount = 100000;
+
+class VideoRendererAlgorithmPerfTest : public testing::Test {
+ public:
+  VideoRendererAlgorithmPerfTest()
+      : tick_clock_(new base::SimpleTestTickClock()),
+        algorithm_(base::Bind(&WallClockTimeSource::GetWallClockTimes,
+                              base::Unretained(&time_source_)),
+                   &media_log_) {
+    // Always start the TickClock at a non-zero value since null values have
+    // special connotations.
+    tick_clock_->Advance(base::TimeDelta::FromMicroseconds(10000));
+    time_source_.set_tick_clock_for_testing(tick_clock_.get());
+  }
+
+  scoped_refptr<VideoFrame> CreateFrame(base::TimeDelta timestamp) {
+    const gfx::Size natural_size(8, 8);
+    return frame_pool_.CreateFrame(PIXEL_FORMAT_I420, natural_size,
+                                   gfx::Rect(natural_size), natural_size,
+                                   timestamp);
+  }
+
+  // Renders |fps| content into a |hertz| display for |kRenderCount| vsyncs,
+  // keeping a few frames queued ahead of the media time as the pipeline would.
+  void RunRenderTest(double fps, double hertz) {
+    algorithm_.Reset();
+    time_source_.StartTicking();
+
+    const base::TimeDelta frame_duration =
+        base::TimeDelta::FromSecondsD(1.0 / fps);
+    const base::TimeDelta render_interval =
+        base::TimeDelta::FromSecondsD(1.0 / hertz);
+    base::TimeDelta next_frame_timestamp = time_source_.CurrentMediaTime();
+    base::TimeTicks deadline_min = tick_clock_->NowTicks();
+
+    base::TimeDelta total_time;
+    for (int i = 0; i < kRenderCount; ++i) {
+      while (algorithm_.effective_frames_queued() < 3) {
+        algorithm_.EnqueueFrame(CreateFrame(next_frame_timestamp));
+        next_frame_timestamp += frame_duration;
+      }
+
+      const base::TimeTicks deadline_max = deadline_min + render_interval;
+      size_t frames_dropped = 0;
+      base::TimeTicks start = base::TimeTicks::Now();
+      scoped_refptr<VideoFrame> frame =
+          algorithm_.Render(deadline_min, deadline_max, &frames_dropped);
+      total_time += base::TimeTicks::Now() - start;
+      ASSERT_TRUE(frame);
+
+      tick_clock_->Advance(render_interval);
+      deadline_min = deadline_max;
+    }
+
+    time_source_.StopTicking();
+    perf_test::PrintResult(
+        "video_renderer_algorithm_render", "",
+        base::StringPrintf("%.0ffps_%.0fhz", fps, hertz),
+        kRenderCount / total_time.InMillisecondsF(), "runs/ms", true);
+  }
+
+ protected:
+  MediaLog media_log_;
+  VideoFramePool frame_pool_;
+  std::unique_ptr<base::SimpleTestTickClock> tick_clock_;
+  WallClockTimeSource time_source_;
+  VideoRendererAlgorithm algorithm_;
+};
+
+TEST_F(VideoRendererAlgorithmPerfTest, Render) {
+  const double kFrameRates[] = {24, 25, 30, 60};
+  const double kRefreshRates[] = {60, 90, 120, 144};
+  for (double fps : kFrameRates) {
+    for (double hertz : kRefreshRates)
+      RunRenderTest(fps, hertz);
+  }
+}
+
+}  // namespace media
@@ -65,12 +65,22 @@ void MultiChannelDotProduct(const AudioBus* a,
     const float* b_src = b->channel(ch) + frame_offset_b;
 
 #if defined(ARCH_CPU_X86_FAMILY)
-    // First sum all components.
+    // First sum all components. Two independent accumulators hide the latency
+    // of the dependent adds, which otherwise bounds this loop.
     __m128 m_sum = _mm_setzero_ps();
-    for (int s = 0; s < last_index; s += 4) {
+    __m128 m_sum2 = _mm_setzero_ps();
+    int s = 0;
+    for (; s + 8 <= last_index; s += 8) {
       m_sum = _mm_add_ps(
           m_sum, _mm_mul_ps(_mm_loadu_ps(a_src + s), _mm_loadu_ps(b_src + s)));
+      m_sum2 = _mm_add_ps(m_sum2, _mm_mul_ps(_mm_loadu_ps(a_src + s + 4),
+                                             _mm_loadu_ps(b_src + s + 4)));
     }
+    if (s < last_index) {
+      m_sum = _mm_add_ps(
+          m_sum, _mm_mul_ps(_mm_loadu_ps(a_src + s), _mm_loadu_ps(b_src + s)));
+    }
+    m_sum = _mm_add_ps(m_sum, m_sum2);
 
     // Reduce to a single float for this channel. Sadly, SSE1,2 doesn't have a
     // horizontal sum function, so we have to condense manually.
@@ -78,10 +88,18 @@ void MultiChannelDotProduct(const AudioBus* a,
     _mm_store_ss(dot_product + ch,
                  _mm_add_ss(m_sum, _mm_shuffle_ps(m_sum, m_sum, 1)));
 #elif defined(ARCH_CPU_ARM_FAMILY)
-    // First sum all components.
+    // First sum all components, using two accumulators as above.
     float32x4_t m_sum = vmovq_n_f32(0);
-    for (int s = 0; s < last_index; s += 4)
+    float32x4_t m_sum2 = vmovq_n_f32(0);
+    int s = 0;
+    for (; s + 8 <= last_index; s += 8) {
+      m_sum = vmlaq_f32(m_sum, vld1q_f32(a_src + s), vld1q_f32(b_src + s));
+      m_sum2 =
+          vmlaq_f32(m_sum2, vld1q_f32(a_src + s + 4), vld1q_f32(b_src + s + 4));
+    }
+    if (s < last_index)
       m_sum = vmlaq_f32(m_sum, vld1q_f32(a_src + s), vld1q_f32(b_src + s));
+    m_sum = vaddq_f32(m_sum, m_sum2);
 
     // Reduce to a single float for this channel.
     float32x2_t m_half = vadd_f32(vget_high_f32(m_sum), vget_low_f32(m_sum));
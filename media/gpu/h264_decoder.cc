@@ -1273,12 +1273,19 @@ H264Decoder::DecodeResult H264Decoder::Decode() {
     H264Parser::Result par_res;
 
     if (!curr_nalu_) {
-      curr_nalu_.reset(new H264NALU());
+      if (spare_nalu_)
+        curr_nalu_ = std::move(spare_nalu_);
+      else
+        curr_nalu_.reset(new H264NALU());
       par_res = parser_.AdvanceToNextNALU(curr_nalu_.get());
-      if (par_res == H264Parser::kEOStream)
+      if (par_res == H264Parser::kEOStream) {
+        // Don't leave a recycled NALU behind to be handled again on the next
+        // call; its fields were not updated by the parser.
+        spare_nalu_ = std::move(curr_nalu_);
         return kRanOutOfStreamData;
-      else if (par_res != H264Parser::kOk)
+      } else if (par_res != H264Parser::kOk) {
         SET_ERROR_AND_RETURN();
+      }
 
       DVLOG(4) << "New NALU: " << static_cast<int>(curr_nalu_->nal_unit_type);
     }
@@ -1308,7 +1315,10 @@ H264Decoder::DecodeResult H264Decoder::Decode() {
         // steps will be executed.
 
         if (!curr_slice_hdr_) {
-          curr_slice_hdr_.reset(new H264SliceHeader());
+          if (spare_slice_hdr_)
+            curr_slice_hdr_ = std::move(spare_slice_hdr_);
+          else
+            curr_slice_hdr_.reset(new H264SliceHeader());
           par_res =
               parser_.ParseSliceHeader(*curr_nalu_, curr_slice_hdr_.get());
           if (par_res != H264Parser::kOk)
@@ -1346,7 +1356,7 @@ H264Decoder::DecodeResult H264Decoder::Decode() {
 
         DCHECK_EQ(state_, kTryCurrentSlice);
         CHECK_ACCELERATOR_RESULT(ProcessCurrentSlice());
-        curr_slice_hdr_.reset();
+        spare_slice_hdr_ = std::move(curr_slice_hdr_);
         state_ = kDecoding;
         break;
       }
@@ -1404,7 +1414,7 @@ H264Decoder::DecodeResult H264Decoder::Decode() {
     }
 
     DVLOG(4) << "NALU done";
-    curr_nalu_.reset();
+    spare_nalu_ = std::move(curr_nalu_);
   }
 }
 
@@ -324,6 +324,12 @@ class MEDIA_GPU_EXPORT H264Decoder : public AcceleratedVideoDecoder {
   std::unique_ptr<H264NALU> curr_nalu_;
   std::unique_ptr<H264SliceHeader> curr_slice_hdr_;
 
+  // Storage recycled from the previous NALU and slice header, so that parsing
+  // a slice does not allocate and zero a new H264SliceHeader each time.
+  // ParseSliceHeader() fully reinitializes the header it is given.
+  std::unique_ptr<H264NALU> spare_nalu_;
+  std::unique_ptr<H264SliceHeader> spare_slice_hdr_;
+
   // Output picture size.
   gfx::Size pic_size_;
   // Output visible cropping rect.
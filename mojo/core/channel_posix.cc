@@ -39,6 +39,14 @@ namespace {
 
 const size_t kMaxBatchReadCapacity = 256 * 1024;
 
+// Reads never ask for less than this, even when the channel only hints at the
+// remainder of a partially received message, so that a burst of small
+// messages is drained with few recvmsg() calls.
+const size_t kMinReadSize = 4096;
+
+// The maximum number of queued messages gathered into a single writev().
+const size_t kMaxBatchWriteMessages = 64;
+
 // A view over a Channel::Message object. The write queue uses these since
 // large messages may need to be sent in chunks.
 class MessageView {
@@ -74,6 +82,8 @@ class MessageView {
     offset_ += num_bytes;
   }
 
+  bool has_handles() const { return !handles_.empty(); }
+
   std::vector<PlatformHandleInTransit> TakeHandles() {
     return std::move(handles_);
   }
@@ -448,7 +458,7 @@ class ChannelPosix : public Channel,
     size_t total_bytes_read = 0;
     size_t bytes_read = 0;
     do {
-      buffer_capacity = next_read_size;
+      buffer_capacity = std::max(next_read_size, kMinReadSize);
       char* buffer = GetReadBuffer(&buffer_capacity);
       DCHECK_GT(buffer_capacity, 0u);
 
@@ -458,6 +468,7 @@ class ChannelPosix : public Channel,
       for (auto& fd : incoming_fds)
         incoming_fds_.emplace_back(std::move(fd));
 
+      bytes_read = 0;
       if (read_result > 0) {
         bytes_read = static_cast<size_t>(read_result);
         total_bytes_read += bytes_read;
@@ -471,8 +482,10 @@ class ChannelPosix : public Channel,
         read_error = true;
         break;
       }
+      // A full buffer means more data is likely waiting, so keep reading even
+      // if the last read ended on a message boundary.
     } while (bytes_read == buffer_capacity &&
-             total_bytes_read < kMaxBatchReadCapacity && next_read_size > 0);
+             total_bytes_read < kMaxBatchReadCapacity);
     if (read_error) {
       // Stop receiving read notifications.
       read_watcher_.reset();
@@ -586,11 +599,65 @@ class ChannelPosix : public Channel,
     return FlushOutgoingMessagesNoLock();
   }
 
+  // Writes as many of the leading handle-less messages in |messages| as the
+  // socket accepts with a single writev(), removing those fully written. Sets
+  // |*blocked| if the socket could not accept any data.
+  bool WriteBatchNoLock(base::circular_deque<MessageView>* messages,
+                        bool* blocked) {
+    iovec iov[kMaxBatchWriteMessages];
+    size_t num_iov = 0;
+    for (const MessageView& message_view : *messages) {
+      if (num_iov == kMaxBatchWriteMessages || message_view.has_handles())
+        break;
+      iov[num_iov].iov_base = const_cast<void*>(message_view.data());
+      iov[num_iov].iov_len = message_view.data_num_bytes();
+      ++num_iov;
+    }
+    DCHECK_GT(num_iov, 0u);
+
+    *blocked = false;
+    ssize_t result = SocketWritev(socket_.get(), iov, num_iov);
+    if (result < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        return false;
+      *blocked = true;
+      return true;
+    }
+
+    size_t bytes_written = static_cast<size_t>(result);
+    while (bytes_written > 0) {
+      MessageView& message_view = messages->front();
+      if (bytes_written < message_view.data_num_bytes()) {
+        message_view.advance_data_offset(bytes_written);
+        break;
+      }
+      bytes_written -= message_view.data_num_bytes();
+      messages->pop_front();
+    }
+    return true;
+  }
+
   bool FlushOutgoingMessagesNoLock() {
     base::circular_deque<MessageView> messages;
     std::swap(outgoing_messages_, messages);
 
     while (!messages.empty()) {
+      // Messages queued while the socket was blocked are flushed together,
+      // one writev() for each run of messages that carry no handles.
+      if (messages.size() > 1 && !messages.front().has_handles() &&
+          !server_.is_valid()) {
+        DCHECK(outgoing_messages_.empty());
+        bool blocked;
+        if (!WriteBatchNoLock(&messages, &blocked))
+          return false;
+        if (blocked) {
+          std::swap(messages, outgoing_messages_);
+          WaitForWriteOnIOThreadNoLock();
+          return true;
+        }
+        continue;
+      }
+
       if (!WriteNoLock(std::move(messages.front())))
         return false;
 
@@ -28,6 +28,10 @@ namespace mojo {
 namespace core {
 namespace {
 
+// Marks the end of a burst in the burst tests; payload messages are never this
+// small.
+const char kEndOfBurstMessage[] = "!";
+
 class MessagePipePerfTest : public test::MojoTestBase {
  public:
   MessagePipePerfTest() : message_count_(0), message_size_(0) {}
@@ -89,6 +93,74 @@ class MessagePipePerfTest : public test::MojoTestBase {
     SendQuitMessage(mp);
   }
 
+  // Writes |burst_size| messages back to back and waits for the client to
+  // acknowledge the whole burst, |burst_count| times. Most of these writes find
+  // the channel busy and are queued, so this measures how queued messages are
+  // flushed rather than round trip latency.
+  void MeasureBurst(MojoHandle mp, int burst_count, int burst_size) {
+    std::string test_name = base::StringPrintf(
+        "IPC_Burst_Perf_%dx%d_%u", burst_count, burst_size,
+        static_cast<unsigned>(message_size_));
+    base::PerfTimeLogger logger(test_name.c_str());
+
+    for (int i = 0; i < burst_count; ++i) {
+      for (int j = 0; j < burst_size; ++j) {
+        CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), payload_.data(),
+                                 payload_.size(), nullptr, 0,
+                                 MOJO_WRITE_MESSAGE_FLAG_NONE),
+                 MOJO_RESULT_OK);
+      }
+      CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), kEndOfBurstMessage,
+                               sizeof(kEndOfBurstMessage), nullptr, 0,
+                               MOJO_WRITE_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+      HandleSignalsState hss;
+      CHECK_EQ(WaitForSignals(mp, MOJO_HANDLE_SIGNAL_READABLE, &hss),
+               MOJO_RESULT_OK);
+      CHECK_EQ(ReadMessageRaw(MessagePipeHandle(mp), &read_buffer_, nullptr,
+                              MOJO_READ_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+    }
+
+    logger.Done();
+  }
+
+  void RunBurstServer(MojoHandle mp) {
+    const size_t kMsgSize[2] = {12, 144};
+    for (size_t i = 0; i < 2; i++) {
+      SetUpMeasurement(0, kMsgSize[i]);
+      MeasureBurst(mp, 1000, 100);
+    }
+
+    SendQuitMessage(mp);
+  }
+
+  static int RunBurstClient(MojoHandle mp) {
+    std::vector<uint8_t> buffer;
+    while (true) {
+      HandleSignalsState hss;
+      MojoResult result = WaitForSignals(mp, MOJO_HANDLE_SIGNAL_READABLE, &hss);
+      if (result != MOJO_RESULT_OK)
+        return result;
+
+      // Drain everything that has arrived, acknowledging each burst.
+      while ((result = ReadMessageRaw(MessagePipeHandle(mp), &buffer, nullptr,
+                                      MOJO_READ_MESSAGE_FLAG_NONE)) ==
+             MOJO_RESULT_OK) {
+        // Empty message indicates quit.
+        if (buffer.empty())
+          return 0;
+        if (buffer.size() == sizeof(kEndOfBurstMessage)) {
+          CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), kEndOfBurstMessage,
+                                   sizeof(kEndOfBurstMessage), nullptr, 0,
+                                   MOJO_WRITE_MESSAGE_FLAG_NONE),
+                   MOJO_RESULT_OK);
+        }
+      }
+      CHECK_EQ(result, MOJO_RESULT_SHOULD_WAIT);
+    }
+  }
+
   static int RunPingPongClient(MojoHandle mp) {
     std::vector<uint8_t> buffer;
     int rv = 0;
@@ -141,6 +213,40 @@ TEST_F(MessagePipePerfTest, PingPong) {
   RunPingPongServer(server_handle);
 }
 
+// Writes batches of small messages into one end of a pipe and reads them all
+// from the other end on the same thread, measuring local routing throughput.
+TEST_F(MessagePipePerfTest, LocalThroughput) {
+  MojoHandle a, b;
+  CreateMessagePipe(&a, &b);
+
+  const int kBatchSize = 100;
+  const int kBatchCount = 10000;
+  const std::string kPayload(12, '*');
+  std::vector<uint8_t> buffer;
+
+  base::PerfTimeLogger logger(
+      base::StringPrintf("IPC_Local_Perf_%dx_%u", kBatchSize * kBatchCount,
+                         static_cast<unsigned>(kPayload.size()))
+          .c_str());
+  for (int i = 0; i < kBatchCount; ++i) {
+    for (int j = 0; j < kBatchSize; ++j) {
+      CHECK_EQ(WriteMessageRaw(MessagePipeHandle(a), kPayload.data(),
+                               kPayload.size(), nullptr, 0,
+                               MOJO_WRITE_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+    }
+    for (int j = 0; j < kBatchSize; ++j) {
+      CHECK_EQ(ReadMessageRaw(MessagePipeHandle(b), &buffer, nullptr,
+                              MOJO_READ_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+    }
+  }
+  logger.Done();
+
+  CloseHandle(a);
+  CloseHandle(b);
+}
+
 // For each message received, sends a reply message with the same contents
 // repeated twice, until the other end is closed or it receives "quitquitquit"
 // (which it doesn't reply to). It'll return the number of messages received,
@@ -156,6 +262,16 @@ TEST_F(MessagePipePerfTest, MultiprocessPingPong) {
   RunTestClient("PingPongClient", [&](MojoHandle h) { RunPingPongServer(h); });
 }
 
+DEFINE_TEST_CLIENT_WITH_PIPE(BurstClient, MessagePipePerfTest, h) {
+  return RunBurstClient(h);
+}
+
+// Sends bursts of small messages to the child, which acknowledges each burst
+// once it has read all of it.
+TEST_F(MessagePipePerfTest, MultiprocessBurst) {
+  RunTestClient("BurstClient", [&](MojoHandle h) { RunBurstServer(h); });
+}
+
 }  // namespace
 }  // namespace core
 }  // namespace mojo
@@ -148,18 +148,11 @@ bool Node::CanShutdownCleanly(ShutdownPolicy policy) {
 }
 
 int Node::GetPort(const PortName& port_name, PortRef* port_ref) {
-  PortLocker::AssertNoPortsLockedOnCurrentThread();
-  base::AutoLock lock(ports_lock_);
-  auto iter = ports_.find(port_name);
-  if (iter == ports_.end())
+  scoped_refptr<Port> port = FindPort(port_name);
+  if (!port)
     return ERROR_PORT_UNKNOWN;
 
-#if defined(OS_ANDROID) && defined(ARCH_CPU_ARM64)
-  // Workaround for https://crbug.com/665869.
-  base::subtle::MemoryBarrier();
-#endif
-
-  *port_ref = PortRef(port_name, iter->second);
+  *port_ref = PortRef(port_name, std::move(port));
   return OK;
 }
 
@@ -489,6 +482,11 @@ int Node::OnUserMessage(std::unique_ptr<UserMessageEvent> message) {
 
   PortRef port_ref;
   GetPort(port_name, &port_ref);
+  return AcceptUserMessage(port_ref, std::move(message));
+}
+
+int Node::AcceptUserMessage(const PortRef& port_ref,
+                            std::unique_ptr<UserMessageEvent> message) {
   bool has_next_message = false;
   bool message_accepted = false;
   bool should_forward_messages = false;
@@ -794,6 +792,21 @@ int Node::AddPortWithName(const PortName& port_name, scoped_refptr<Port> port) {
   return OK;
 }
 
+scoped_refptr<Port> Node::FindPort(const PortName& port_name) {
+  PortLocker::AssertNoPortsLockedOnCurrentThread();
+  base::AutoLock lock(ports_lock_);
+  auto iter = ports_.find(port_name);
+  if (iter == ports_.end())
+    return nullptr;
+
+#if defined(OS_ANDROID) && defined(ARCH_CPU_ARM64)
+  // Workaround for https://crbug.com/665869.
+  base::subtle::MemoryBarrier();
+#endif
+
+  return iter->second;
+}
+
 void Node::ErasePort(const PortName& port_name) {
   PortLocker::AssertNoPortsLockedOnCurrentThread();
   scoped_refptr<Port> port;
@@ -808,14 +821,49 @@ void Node::ErasePort(const PortName& port_name) {
   // NOTE: We are careful not to release the port's messages while holding any
   // locks, since they may run arbitrary user code upon destruction.
   std::vector<std::unique_ptr<UserMessageEvent>> messages;
+  scoped_refptr<Port> local_peer_port;
   {
     PortRef port_ref(port_name, std::move(port));
     SinglePortLocker locker(&port_ref);
     locker.port()->message_queue.TakeAllMessages(&messages);
+    // Break any reference cycle with a local peer which caches this port.
+    local_peer_port = std::move(locker.port()->local_peer_port);
   }
   DVLOG(2) << "Deleted port " << port_name << "@" << name_;
 }
 
+bool Node::GetLocalPeerPort(const PortRef& port_ref,
+                            const PortName& peer_port_name,
+                            PortRef* peer_port_ref) {
+  {
+    SinglePortLocker locker(&port_ref);
+    auto* port = locker.port();
+    if (port->local_peer_port && port->local_peer_port_name == peer_port_name) {
+      *peer_port_ref = PortRef(peer_port_name, port->local_peer_port);
+      return true;
+    }
+  }
+
+  scoped_refptr<Port> peer_port = FindPort(peer_port_name);
+  if (!peer_port)
+    return false;
+  *peer_port_ref = PortRef(peer_port_name, peer_port);
+
+  // Released outside of the port lock, since it may be the last reference.
+  scoped_refptr<Port> stale_peer_port;
+  {
+    SinglePortLocker locker(&port_ref);
+    auto* port = locker.port();
+    if (port->state == Port::kReceiving &&
+        port->peer_port_name == peer_port_name) {
+      stale_peer_port = std::move(port->local_peer_port);
+      port->local_peer_port_name = peer_port_name;
+      port->local_peer_port = std::move(peer_port);
+    }
+  }
+  return true;
+}
+
 int Node::SendUserMessageInternal(const PortRef& port_ref,
                                   std::unique_ptr<UserMessageEvent>* message) {
   std::unique_ptr<UserMessageEvent>& m = *message;
@@ -842,7 +890,17 @@ int Node::SendUserMessageInternal(const PortRef& port_ref,
     return OK;
   }
 
-  int accept_result = AcceptEvent(std::move(m));
+  // A message carrying no ports to a peer on this node needs none of the port
+  // acceptance done by OnUserMessage(), and the peer can usually be found
+  // without taking |ports_lock_|.
+  int accept_result;
+  PortRef peer_port_ref;
+  if (m->num_ports() == 0 &&
+      GetLocalPeerPort(port_ref, m->port_name(), &peer_port_ref)) {
+    accept_result = AcceptUserMessage(peer_port_ref, std::move(m));
+  } else {
+    accept_result = AcceptEvent(std::move(m));
+  }
   if (accept_result != OK) {
     // See comment above for why we don't return an error in this case.
     DVLOG(2) << "AcceptEvent failed: " << accept_result;
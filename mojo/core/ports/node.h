@@ -200,6 +200,20 @@ class COMPONENT_EXPORT(MOJO_CORE_PORTS) Node {
   int OnObserveClosure(std::unique_ptr<ObserveClosureEvent> event);
   int OnMergePort(std::unique_ptr<MergePortEvent> event);
 
+  // Delivers a user message to |port_ref|, a port on this node. |port_ref|
+  // may be invalid if the target port is unknown, in which case the message
+  // and any ports attached to it are discarded.
+  int AcceptUserMessage(const PortRef& port_ref,
+                        std::unique_ptr<UserMessageEvent> message);
+
+  // Returns the local port named |peer_port_name|, which must be the current
+  // peer of |port_ref|. Uses the reference cached on |port_ref|'s Port when
+  // possible, and otherwise looks the peer up and caches it.
+  bool GetLocalPeerPort(const PortRef& port_ref,
+                        const PortName& peer_port_name,
+                        PortRef* peer_port_ref);
+
+  scoped_refptr<Port> FindPort(const PortName& port_name);
   int AddPortWithName(const PortName& port_name, scoped_refptr<Port> port);
   void ErasePort(const PortName& port_name);
 
@@ -148,6 +148,13 @@ class Port : public base::RefCountedThreadSafe<Port> {
   // non-zero cyclic routing distance) receiving Port has been closed.
   bool peer_closed;
 
+  // A reference to this Port's peer when the peer lives on the same Node,
+  // cached so that local user messages can be delivered without looking the
+  // peer up in the Node's port map. Only valid while |peer_port_name| is still
+  // |local_peer_port_name|. Released when this Port is erased from its Node.
+  PortName local_peer_port_name;
+  scoped_refptr<Port> local_peer_port;
+
   Port(uint64_t next_sequence_num_to_send,
        uint64_t next_sequence_num_to_receive);
 
@@ -812,6 +812,52 @@ TEST_F(PortsTest, Delegation1) {
   EXPECT_TRUE(node1.node().CanShutdownCleanly());
 }
 
+TEST_F(PortsTest, SendToLocalPeerAfterPeerMoves) {
+  TestNode node0(0);
+  AddNode(&node0);
+
+  TestNode node1(1);
+  AddNode(&node1);
+
+  PortRef x0, x1;
+  CreatePortPair(&node0, &x0, &node1, &x1);
+
+  // The first message is delivered to a1 locally, which lets node0 remember
+  // a1 as a0's local peer.
+  PortRef a0, a1;
+  EXPECT_EQ(OK, node0.node().CreatePortPair(&a0, &a1));
+  EXPECT_EQ(OK, node0.SendStringMessage(a0, "1"));
+
+  // Move a1 to node1. Messages sent before and after a0 learns of the move
+  // must all arrive in order.
+  EXPECT_EQ(OK, node0.SendStringMessageWithPort(x0, "a1", a1));
+  EXPECT_EQ(OK, node0.SendStringMessage(a0, "2"));
+  WaitForIdle();
+  EXPECT_EQ(OK, node0.SendStringMessage(a0, "3"));
+  WaitForIdle();
+
+  ScopedMessage message;
+  ASSERT_TRUE(node1.ReadMessage(x1, &message));
+  ASSERT_EQ(1u, message->num_ports());
+  PortRef a2;
+  EXPECT_EQ(OK, node1.node().GetPort(message->ports()[0], &a2));
+
+  for (const char* expected : {"1", "2", "3"}) {
+    ASSERT_TRUE(node1.ReadMessage(a2, &message));
+    EXPECT_TRUE(MessageEquals(message, expected));
+  }
+
+  EXPECT_EQ(OK, node0.node().ClosePort(a0));
+  EXPECT_EQ(OK, node1.node().ClosePort(a2));
+  EXPECT_EQ(OK, node0.node().ClosePort(x0));
+  EXPECT_EQ(OK, node1.node().ClosePort(x1));
+
+  WaitForIdle();
+
+  EXPECT_TRUE(node0.node().CanShutdownCleanly());
+  EXPECT_TRUE(node1.node().CanShutdownCleanly());
+}
+
 TEST_F(PortsTest, Delegation2) {
   TestNode node0(0);
   AddNode(&node0);
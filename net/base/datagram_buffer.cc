@@ -28,6 +28,20 @@ void DatagramBufferPool::Enqueue(const char* buffer,
   buffers->emplace_back(std::move(datagram_buffer));
 }
 
+void DatagramBufferPool::EnqueueUninitialized(size_t count,
+                                              DatagramBuffers* buffers) {
+  // Buffers are never larger than |max_buffer_size_|, so setting the length
+  // is all there is to do.
+  for (size_t i = 0; i < count; ++i) {
+    if (free_list_.empty()) {
+      free_list_.emplace_back(quic::QuicWrapUnique<DatagramBuffer>(
+          new DatagramBuffer(max_buffer_size_)));
+    }
+    free_list_.front()->length_ = max_buffer_size_;
+    buffers->splice(buffers->cend(), free_list_, free_list_.begin());
+  }
+}
+
 void DatagramBufferPool::Dequeue(DatagramBuffers* buffers) {
   if (buffers->size() == 0)
     return;
@@ -53,4 +67,9 @@ size_t DatagramBuffer::length() const {
   return length_;
 }
 
+void DatagramBuffer::SetLength(size_t length) {
+  DCHECK_LE(length, length_);
+  length_ = length;
+}
+
 }  // namespace net
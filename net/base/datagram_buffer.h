@@ -51,6 +51,10 @@ class NET_EXPORT_PRIVATE DatagramBufferPool {
   // Insert a new element (drawn from the pool) containing a copy of
   // |buffer| to |buffers|. Caller retains owenership of |buffers| and |buffer|.
   void Enqueue(const char* buffer, size_t buf_len, DatagramBuffers* buffers);
+  // Insert |count| new elements (drawn from the pool) of |max_buffer_size()|
+  // bytes, holding garbage, to |buffers|. They are meant to be filled, e.g.
+  // by reading datagrams, and then shrunk with |DatagramBuffer::SetLength()|.
+  void EnqueueUninitialized(size_t count, DatagramBuffers* buffers);
   // Return all elements of |buffers| to the pool.  Caller retains
   // ownership of |buffers|.
   void Dequeue(DatagramBuffers* buffers);
@@ -85,6 +89,10 @@ class NET_EXPORT_PRIVATE DatagramBuffer {
   char* data() const;
   size_t length() const;
 
+  // Shrinks the buffer to |length| bytes, which must not be more than its
+  // current length.
+  void SetLength(size_t length);
+
  protected:
   DatagramBuffer(size_t max_packet_size);
 
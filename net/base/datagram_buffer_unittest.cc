@@ -49,6 +49,23 @@ TEST_F(DatagramBufferTest, DatgramBufferPoolRecycles) {
   EXPECT_EQ(buffer2_ptr, buffers.back().get());
 }
 
+TEST_F(DatagramBufferTest, EnqueueUninitialized) {
+  DatagramBuffers buffers;
+  const char data[] = "foo";
+  pool_.Enqueue(data, sizeof(data), &buffers);
+  DatagramBuffer* buffer_ptr = buffers.back().get();
+  pool_.Dequeue(&buffers);
+
+  pool_.EnqueueUninitialized(2, &buffers);
+  ASSERT_EQ(2u, buffers.size());
+  EXPECT_EQ(buffer_ptr, buffers.front().get());
+  EXPECT_EQ(kMaxBufferSize, buffers.front()->length());
+  EXPECT_EQ(kMaxBufferSize, buffers.back()->length());
+
+  buffers.back()->SetLength(10);
+  EXPECT_EQ(10u, buffers.back()->length());
+}
+
 }  // namespace test
 
 }  // namespace net
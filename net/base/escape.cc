@@ -265,8 +265,22 @@ std::string UnescapeURLWithAdjustmentsImpl(
   std::string result;
   result.reserve(escaped_text.length());
 
+  // Only '%' and, for REPLACE_PLUS_WITH_SPACE, '+' can change the output.
+  const base::StringPiece special_chars =
+      (rules & UnescapeRule::REPLACE_PLUS_WITH_SPACE) ? "%+" : "%";
+
   // Locations of adjusted text.
   for (size_t i = 0, max = escaped_text.size(); i < max;) {
+    // Copy the run of bytes before the next special character in one go.
+    size_t span_end = escaped_text.find_first_of(special_chars, i);
+    if (span_end == base::StringPiece::npos)
+      span_end = max;
+    if (span_end > i) {
+      result.append(escaped_text.data() + i, span_end - i);
+      i = span_end;
+      continue;
+    }
+
     // Try to unescape the character.
     uint32_t code_point;
     std::string unescaped;
@@ -84,6 +84,9 @@
 // definition and roughly the same as Firefox's definition.
 
 #include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
 #include <string>
 
 #include "net/base/mime_sniffer.h"
@@ -309,8 +312,25 @@ static bool MagicMaskCmp(const char* magic_entry,
   return true;
 }
 
+// Returns false if |magic_entry| can't match content starting with
+// |first_byte|, which rules out most entries without comparing them fully.
+static bool MatchMagicFirstByte(const MagicNumber& magic_entry,
+                                char first_byte) {
+  const char magic = magic_entry.magic[0];
+  if (magic == '.')
+    return true;
+  if (magic_entry.is_string)
+    return base::ToLowerASCII(magic) == base::ToLowerASCII(first_byte);
+  if (magic_entry.mask)
+    return magic == (magic_entry.mask[0] & first_byte);
+  return magic == first_byte;
+}
+
+// |content_strlen| is the length of the null-terminated string at |content|,
+// or |size| if there is no null character.
 static bool MatchMagicNumber(const char* content,
                              size_t size,
+                             size_t content_strlen,
                              const MagicNumber& magic_entry,
                              std::string* result) {
   const size_t len = magic_entry.magic_len;
@@ -318,13 +338,6 @@ static bool MatchMagicNumber(const char* content,
   // Keep kBytesRequiredForMagic honest.
   DCHECK_LE(len, kBytesRequiredForMagic);
 
-  // To compare with magic strings, we need to compute strlen(content), but
-  // content might not actually have a null terminator.  In that case, we
-  // pretend the length is content_size.
-  const char* end = static_cast<const char*>(memchr(content, '\0', size));
-  const size_t content_strlen =
-      (end != NULL) ? static_cast<size_t>(end - content) : size;
-
   bool match = false;
   if (magic_entry.is_string) {
     if (content_strlen >= len) {
@@ -354,9 +367,26 @@ static bool CheckForMagicNumbers(const char* content,
                                  size_t size,
                                  base::span<const MagicNumber> magic_numbers,
                                  std::string* result) {
+  if (!size)
+    return false;
+
+  // To compare with magic strings, we need to compute strlen(content), but
+  // content might not actually have a null terminator.  In that case, we
+  // pretend the length is content_size. No magic number is longer than
+  // kBytesRequiredForMagic, so there's no need to look any further.
+  const size_t strlen_limit = std::min(size, kBytesRequiredForMagic);
+  const char* end =
+      static_cast<const char*>(memchr(content, '\0', strlen_limit));
+  const size_t content_strlen =
+      (end != NULL) ? static_cast<size_t>(end - content) : size;
+
+  // The entries are tried in order, since the first match wins, but their
+  // first byte is checked before anything else.
   for (const MagicNumber& magic : magic_numbers) {
-    if (MatchMagicNumber(content, size, magic, result))
+    if (MatchMagicFirstByte(magic, content[0]) &&
+        MatchMagicNumber(content, size, content_strlen, magic, result)) {
       return true;
+    }
   }
   return false;
 }
@@ -847,7 +877,7 @@ bool SniffMimeTypeFromLocalData(const char* content,
   return CheckForMagicNumbers(content, size, kMagicNumbers, result);
 }
 
-bool LooksLikeBinary(const char* content, size_t size) {
+static bool IsBinaryByte(char c) {
   // The definition of "binary bytes" is from the spec at
   // https://mimesniff.spec.whatwg.org/#binary-data-byte
   //
@@ -857,9 +887,30 @@ bool LooksLikeBinary(const char* content, size_t size) {
   // represents byte 0x1F.
   const uint32_t kBinaryBits =
       ~(1u << '\t' | 1u << '\n' | 1u << '\r' | 1u << '\f' | 1u << '\x1b');
-  for (size_t i = 0; i < size; ++i) {
-    uint8_t byte = static_cast<uint8_t>(content[i]);
-    if (byte < 0x20 && (kBinaryBits & (1u << byte)))
+  uint8_t byte = static_cast<uint8_t>(c);
+  return byte < 0x20 && (kBinaryBits & (1u << byte));
+}
+
+bool LooksLikeBinary(const char* content, size_t size) {
+  // Look at 8 bytes at a time, and only check the bytes one by one in the
+  // words which have a byte < 0x20. Most of the words of text don't.
+  const uint64_t kOnes = 0x0101010101010101ull;
+  const char* pos = content;
+  const char* const end = content + size;
+  for (; static_cast<size_t>(end - pos) >= sizeof(uint64_t);
+       pos += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, pos, sizeof(word));
+    // This is non-zero if, and only if, some byte of |word| is < 0x20.
+    if (!((word - kOnes * 0x20) & ~word & (kOnes * 0x80)))
+      continue;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      if (IsBinaryByte(pos[i]))
+        return true;
+    }
+  }
+  for (; pos < end; ++pos) {
+    if (IsBinaryByte(*pos))
       return true;
   }
   return false;
@@ -4,12 +4,14 @@
 
 #include "net/base/mime_sniffer.h"
 
+#include <string>
 #include <vector>
 
 #include "base/bits.h"
 #include "base/logging.h"
 #include "base/timer/elapsed_timer.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
 
 namespace net {
 namespace {
@@ -99,5 +101,29 @@ TEST(MimeSnifferTest, PlainTextPerfTest) {
             << "ns per KB";
 }
 
+void RunSniffMimeType(const std::string& content, size_t iterations) {
+  GURL url("http://www.example.com/");
+  std::string mime_type;
+  for (size_t i = 0; i < iterations; ++i) {
+    SniffMimeType(content.data(), content.size(), url, std::string(),
+                  ForceSniffFileUrlsForHtml::kDisabled, &mime_type);
+  }
+  CHECK_EQ("text/plain", mime_type);
+}
+
+// Measures sniffing a whole response which doesn't match any magic number, so
+// that all the tables are checked.
+TEST(MimeSnifferTest, UnknownTypePerfTest) {
+  const size_t kWarmupIterations = 16;
+  const size_t kMeasuredIterations = 1 << 18;
+  std::string plaintext = kRepresentativePlainText;
+  RunSniffMimeType(plaintext, kWarmupIterations);
+  base::ElapsedTimer elapsed_timer;
+  RunSniffMimeType(plaintext, kMeasuredIterations);
+  LOG(INFO) << (elapsed_timer.Elapsed().InMicroseconds() * 1000 /
+                static_cast<int64_t>(kMeasuredIterations))
+            << "ns per response";
+}
+
 }  // namespace
 }  // namespace net
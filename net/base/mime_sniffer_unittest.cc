@@ -519,5 +519,26 @@ INSTANTIATE_TEST_CASE_P(MimeSnifferControlCodesEdgeCaseTest,
                                "_\x02_"   // a byte in the middle is binary
                                ));
 
+// LooksLikeBinary() reads several bytes at a time, so check every position in
+// a buffer which is longer than that, at every alignment.
+TEST(MimeSnifferTest, LooksLikeBinaryAtEveryOffset) {
+  const std::string kText = "Some text,\r\n\twith \x1b[1mcontrol codes\f.";
+  for (size_t offset = 0; offset < 8; ++offset) {
+    std::string buffer = std::string(offset, '_') + kText;
+    const char* text = buffer.data() + offset;
+    EXPECT_FALSE(LooksLikeBinary(text, kText.size())) << offset;
+    for (size_t i = 0; i < kText.size(); ++i) {
+      std::string binary = kText;
+      binary[i] = '\x01';
+      buffer = std::string(offset, '_') + binary;
+      EXPECT_TRUE(LooksLikeBinary(buffer.data() + offset, binary.size()))
+          << offset << " " << i;
+      // Not when the binary byte is past the end.
+      EXPECT_FALSE(LooksLikeBinary(buffer.data() + offset, i))
+          << offset << " " << i;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace net
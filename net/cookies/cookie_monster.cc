@@ -44,6 +44,7 @@
 
 #include "net/cookies/cookie_monster.h"
 
+#include <algorithm>
 #include <functional>
 #include <set>
 
@@ -181,6 +182,23 @@ typedef std::vector<CanonicalCookie*> CanonicalCookieVector;
 // will update it again.
 const int kDefaultAccessUpdateThresholdSeconds = 60;
 
+// Number of domains whose key is cached.
+const size_t kKeyCacheSize = 64;
+
+// Number of (URL, options) pairs whose cookies are cached. A page's
+// subresources usually come from a handful of hosts and paths.
+const size_t kLookupCacheSize = 16;
+
+// Returns the key of the cookies for a request to |url| with |options| in
+// CookieMonster::lookup_cache_, which covers all the inputs of
+// CanonicalCookie::IncludeForRequestURL().
+std::string GetLookupCacheKey(const GURL& url, const CookieOptions& options) {
+  return base::StringPrintf("%d%d%d", url.SchemeIsCryptographic(),
+                            options.exclude_httponly(),
+                            static_cast<int>(options.same_site_cookie_mode())) +
+         url.host() + url.path();
+}
+
 // Comparator to sort cookies from highest creation date to lowest
 // creation date.
 struct OrderByCreationTimeDesc {
@@ -372,6 +390,8 @@ CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
     : initialized_(false),
       started_fetching_all_cookies_(false),
       finished_fetching_all_cookies_(false),
+      key_cache_(kKeyCacheSize),
+      lookup_cache_(kLookupCacheSize),
       seen_global_task_(false),
       net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::COOKIE_STORE)),
       store_(std::move(store)),
@@ -666,7 +686,8 @@ void CookieMonster::GetCookieListWithOptions(const GURL& url,
   if (HasCookieableScheme(url)) {
     std::vector<CanonicalCookie*> cookie_ptrs;
     FindCookiesForHostAndDomain(url, options, &cookie_ptrs);
-    std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
+    DCHECK(std::is_sorted(cookie_ptrs.begin(), cookie_ptrs.end(),
+                          CookieSorter));
 
     cookies.reserve(cookie_ptrs.size());
     for (std::vector<CanonicalCookie*>::const_iterator it = cookie_ptrs.begin();
@@ -1083,9 +1104,31 @@ void CookieMonster::FindCookiesForHostAndDomain(
   // want to collect statistics whenever the browser's being used.
   RecordPeriodicStats(current_time);
 
+  // Reuse the cookies found for a recent request, unless one of them expired
+  // since then.
+  const std::string lookup_key(GetLookupCacheKey(url, options));
+  auto cached = lookup_cache_.Get(lookup_key);
+  if (cached != lookup_cache_.end() &&
+      std::none_of(cached->second.begin(), cached->second.end(),
+                   [&current_time](CanonicalCookie* cc) {
+                     return cc->IsExpired(current_time);
+                   })) {
+    for (CanonicalCookie* cc : cached->second) {
+      if (options.update_access_time())
+        InternalUpdateCookieAccessTime(cc, current_time);
+      cookies->push_back(cc);
+    }
+    return;
+  }
+
   // Can just dispatch to FindCookiesForKey
-  const std::string key(GetKey(url.host_piece()));
+  const std::string key(GetCachedKey(url.host_piece()));
+  const size_t first_cookie = cookies->size();
   FindCookiesForKey(key, url, options, current_time, cookies);
+  lookup_cache_.Put(
+      lookup_key,
+      std::vector<CanonicalCookie*>(cookies->begin() + first_cookie,
+                                    cookies->end()));
 }
 
 void CookieMonster::FindCookiesForKey(const std::string& key,
@@ -1214,8 +1257,18 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
       sync_to_store) {
     store_->AddCookie(*cc_ptr);
   }
+  // Insert the cookie right before the first cookie of |key| that should come
+  // after it in requests.
+  CookieMapItPair its = cookies_.equal_range(key);
+  CookieMap::iterator next = std::upper_bound(
+      its.first, its.second, cc_ptr,
+      [](CanonicalCookie* cc, const CookieMap::value_type& other) {
+        return CookieSorter(cc, other.second.get());
+      });
   CookieMap::iterator inserted =
-      cookies_.insert(CookieMap::value_type(key, std::move(cc)));
+      cookies_.insert(next, CookieMap::value_type(key, std::move(cc)));
+  DCHECK(std::next(inserted) == next);
+  lookup_cache_.Clear();
 
   // See InitializeHistograms() for details.
   int32_t type_sample = cc_ptr->SameSite() != CookieSameSite::NO_RESTRICTION
@@ -1242,7 +1295,7 @@ void CookieMonster::SetCanonicalCookie(std::unique_ptr<CanonicalCookie> cc,
     return;
   }
 
-  const std::string key(GetKey(cc->Domain()));
+  const std::string key(GetCachedKey(cc->Domain()));
 
   // TODO(mmenke): This class assumes each cookie to have a unique creation
   // time. Allowing the caller to set the creation time violates that
@@ -1399,6 +1452,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
   }
   change_dispatcher_.DispatchChange(*cc, mapping.cause, mapping.notify);
   cookies_.erase(it);
+  lookup_cache_.Clear();
 }
 
 // Domain expiry behavior is unchanged by key/expiry scheme (the
@@ -1715,6 +1769,16 @@ std::string CookieMonster::GetKey(base::StringPiece domain) {
   return effective_domain;
 }
 
+std::string CookieMonster::GetCachedKey(base::StringPiece domain) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+
+  std::string domain_string = domain.as_string();
+  auto it = key_cache_.Get(domain_string);
+  if (it == key_cache_.end())
+    it = key_cache_.Put(domain_string, GetKey(domain));
+  return it->second;
+}
+
 bool CookieMonster::HasCookieableScheme(const GURL& url) {
   DCHECK(thread_checker_.CalledOnValidThread());
 
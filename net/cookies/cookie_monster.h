@@ -19,6 +19,7 @@
 
 #include "base/callback_forward.h"
 #include "base/containers/circular_deque.h"
+#include "base/containers/mru_cache.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -88,6 +89,10 @@ class NET_EXPORT CookieMonster : public CookieStore {
   // not legal to have domain cookies without an eTLD+1).  This rule
   // excludes cookies for, e.g, ".com", ".co.uk", or ".internalnetwork".
   // This behavior is the same as the behavior in Firefox v 3.6.10.
+  //
+  // The cookies of a key are kept in the order in which they are returned for
+  // a request: longest path first, then oldest first, so that the cookies
+  // found for a request don't need to be sorted.
 
   // NOTE(deanm):
   // I benchmarked hash_multimap vs multimap.  We're going to be query-heavy
@@ -446,6 +451,9 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   void SetDefaultCookieableSchemes();
 
+  // Appends to |cookies| the cookies to send with a request to |url|, in the
+  // order of the Cookie header. The results of recent calls are cached, since
+  // the subresource requests of a page usually share their host and path.
   void FindCookiesForHostAndDomain(const GURL& url,
                                    const CookieOptions& options,
                                    std::vector<CanonicalCookie*>* cookies);
@@ -477,8 +485,9 @@ class NET_EXPORT CookieMonster : public CookieStore {
                                  bool already_expired,
                                  base::Time* creation_date_to_inherit);
 
-  // Inserts |cc| into cookies_. Returns an iterator that points to the inserted
-  // cookie in cookies_. Guarantee: all iterators to cookies_ remain valid.
+  // Inserts |cc| into cookies_, keeping the cookies of |key| sorted. Returns an
+  // iterator that points to the inserted cookie in cookies_. Guarantee: all
+  // iterators to cookies_ remain valid.
   CookieMap::iterator InternalInsertCookie(const std::string& key,
                                            std::unique_ptr<CanonicalCookie> cc,
                                            bool sync_to_store);
@@ -579,6 +588,9 @@ class NET_EXPORT CookieMonster : public CookieStore {
   void DoCookieCallbackForHostOrDomain(base::OnceClosure callback,
                                        base::StringPiece host_or_domain);
 
+  // Same as GetKey(), but keys of recently seen domains are cached.
+  std::string GetCachedKey(base::StringPiece domain);
+
   // Histogram variables; see CookieMonster::InitializeHistograms() in
   // cookie_monster.cc for details.
   base::HistogramBase* histogram_expiration_duration_minutes_;
@@ -590,6 +602,15 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // Keys of recently seen domains, since computing keys takes a lookup in the
+  // registry controlled domains table.
+  base::MRUCache<std::string, std::string> key_cache_;
+
+  // Cookies found by recent FindCookiesForHostAndDomain() calls, by URL and
+  // options. They point into |cookies_|, so the cache is emptied whenever a
+  // cookie is added or deleted.
+  base::MRUCache<std::string, std::vector<CanonicalCookie*>> lookup_cache_;
+
   CookieMonsterChangeDispatcher change_dispatcher_;
 
   // Indicates whether the cookie store has been initialized.
@@ -4,8 +4,10 @@
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "base/bind.h"
+#include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
@@ -296,6 +298,58 @@ TEST_F(CookieMonsterTest, TestDomainLine) {
   timer2.Done();
 }
 
+// A page loading its subresources from a few hosts and paths of one site,
+// which queries the same URLs over and over.
+TEST_F(CookieMonsterTest, TestQuerySubresources) {
+  auto cm = std::make_unique<CookieMonster>(nullptr, nullptr, nullptr);
+  SetCookieCallback setCookieCallback;
+  GetCookieListCallback getCookieListCallback;
+  const char* const kHosts[] = {"www.site.com", "static.site.com",
+                                "img.site.com", "api.site.com"};
+  const char* const kPaths[] = {"/", "/js/", "/css/", "/img/", "/api/v1/"};
+
+  for (int i = 0; i < 50; i++) {
+    setCookieCallback.SetCookie(
+        cm.get(), GURL("https://www.site.com/"),
+        base::StringPrintf("d%02d=1; domain=site.com", i));
+  }
+  for (const char* host : kHosts) {
+    for (const char* path : kPaths) {
+      GURL gurl(base::StringPrintf("https://%s%s", host, path));
+      for (int i = 0; i < 4; i++) {
+        setCookieCallback.SetCookie(
+            cm.get(), gurl, base::StringPrintf("p%d=1; path=%s", i, path));
+      }
+    }
+  }
+
+  std::vector<GURL> subresources;
+  for (const char* host : kHosts) {
+    for (const char* path : kPaths) {
+      subresources.push_back(
+          GURL(base::StringPrintf("https://%s%sresource.js", host, path)));
+    }
+  }
+
+  base::PerfTimeLogger timer("Cookie_monster_query_subresources");
+  for (int i = 0; i < kNumCookies; i++) {
+    getCookieListCallback.GetCookieList(
+        cm.get(), subresources[i % subresources.size()]);
+  }
+  timer.Done();
+
+  // Distinct paths are never found in the cache of recent lookups.
+  std::vector<GURL> distinct_urls;
+  for (int i = 0; i < kNumCookies; i++) {
+    distinct_urls.push_back(GURL(base::StringPrintf(
+        "https://%s/img/%d.png", kHosts[i % arraysize(kHosts)], i)));
+  }
+  base::PerfTimeLogger timer2("Cookie_monster_query_distinct_paths");
+  for (const GURL& gurl : distinct_urls)
+    getCookieListCallback.GetCookieList(cm.get(), gurl);
+  timer2.Done();
+}
+
 TEST_F(CookieMonsterTest, TestImport) {
   scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
   std::vector<std::unique_ptr<CanonicalCookie>> initial_cookies;
@@ -1690,6 +1690,34 @@ TEST_F(CookieMonsterTest, CookieSorting) {
   EXPECT_EQ("A1", cookies[5].Value());
 }
 
+// Repeated lookups for a URL see the cookies that were added or deleted in
+// between.
+TEST_F(CookieMonsterTest, RepeatedLookups) {
+  std::unique_ptr<CookieMonster> cm(
+      new CookieMonster(nullptr, nullptr, &net_log_));
+  CookieOptions options;
+  options.set_include_httponly();
+
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_foo_.url(), "A=B; path=/"));
+  EXPECT_EQ("A=B", GetCookies(cm.get(), www_foo_foo_.url()));
+  EXPECT_EQ("A=B", GetCookies(cm.get(), www_foo_foo_.url()));
+
+  EXPECT_TRUE(SetCookie(cm.get(), www_foo_foo_.url(), "C=D; path=/foo"));
+  EXPECT_EQ("C=D; A=B", GetCookies(cm.get(), www_foo_foo_.url()));
+  EXPECT_EQ("A=B", GetCookies(cm.get(), www_foo_bar_.url()));
+
+  // The options that filter cookies are taken into account.
+  EXPECT_TRUE(SetCookieWithOptions(cm.get(), http_www_foo_.url(),
+                                   "E=F; httponly", options));
+  EXPECT_EQ("C=D; A=B", GetCookies(cm.get(), www_foo_foo_.url()));
+  EXPECT_EQ("C=D; A=B; E=F",
+            GetCookiesWithOptions(cm.get(), www_foo_foo_.url(), options));
+  EXPECT_EQ("C=D; A=B", GetCookies(cm.get(), www_foo_foo_.url()));
+
+  DeleteCookie(cm.get(), www_foo_foo_.url(), "C");
+  EXPECT_EQ("A=B", GetCookies(cm.get(), www_foo_foo_.url()));
+}
+
 TEST_F(CookieMonsterTest, InheritCreationDate) {
   std::unique_ptr<CookieMonster> cm(
       new CookieMonster(nullptr, nullptr, &net_log_));
@@ -28,6 +28,7 @@
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_index_delegate.h"
 #include "net/disk_cache/simple/simple_index_file.h"
+#include "net/disk_cache/simple/simple_index_table.h"
 #include "net/disk_cache/simple/simple_synchronous_entry.h"
 #include "net/disk_cache/simple/simple_util.h"
 
@@ -212,6 +213,19 @@ int SimpleIndex::ExecuteWhenReady(net::CompletionOnceCallback task) {
   return net::ERR_IO_PENDING;
 }
 
+template <typename Function>
+void SimpleIndex::ForEachEntry(Function function) const {
+  for (const auto& entry : entries_set_)
+    function(entry.first, entry.second);
+  if (!index_table_)
+    return;
+  for (size_t i = 0; i < index_table_->size(); ++i) {
+    const uint64_t entry_hash = index_table_->GetHashAt(i);
+    if (!shadowed_table_entries_.count(entry_hash))
+      function(entry_hash, index_table_->GetMetadataAt(i));
+  }
+}
+
 std::unique_ptr<SimpleIndex::HashList> SimpleIndex::GetEntriesBetween(
     base::Time initial_time,
     base::Time end_time) {
@@ -226,12 +240,11 @@ std::unique_ptr<SimpleIndex::HashList> SimpleIndex::GetEntriesBetween(
   DCHECK(end_time >= initial_time);
 
   std::unique_ptr<HashList> ret_hashes(new HashList());
-  for (const auto& entry : entries_set_) {
-    const EntryMetadata& metadata = entry.second;
+  ForEachEntry([&](uint64_t entry_hash, const EntryMetadata& metadata) {
     base::Time entry_time = metadata.GetLastUsedTime();
     if (initial_time <= entry_time && entry_time < end_time)
-      ret_hashes->push_back(entry.first);
-  }
+      ret_hashes->push_back(entry_hash);
+  });
   return ret_hashes;
 }
 
@@ -241,7 +254,10 @@ std::unique_ptr<SimpleIndex::HashList> SimpleIndex::GetAllHashes() {
 
 int32_t SimpleIndex::GetEntryCount() const {
   // TODO(pasko): return a meaningful initial estimate before initialized.
-  return entries_set_.size();
+  size_t entry_count = entries_set_.size();
+  if (index_table_)
+    entry_count += index_table_->size() - shadowed_table_entries_.size();
+  return entry_count;
 }
 
 uint64_t SimpleIndex::GetCacheSize() const {
@@ -262,23 +278,23 @@ uint64_t SimpleIndex::GetCacheSizeBetween(base::Time initial_time,
 
   DCHECK(end_time >= initial_time);
   uint64_t size = 0;
-  for (const auto& entry : entries_set_) {
-    const EntryMetadata& metadata = entry.second;
+  ForEachEntry([&](uint64_t entry_hash, const EntryMetadata& metadata) {
     base::Time entry_time = metadata.GetLastUsedTime();
     if (initial_time <= entry_time && entry_time < end_time)
       size += metadata.GetEntrySize();
-  }
+  });
   return size;
 }
 
 size_t SimpleIndex::EstimateMemoryUsage() const {
   return base::trace_event::EstimateMemoryUsage(entries_set_) +
+         base::trace_event::EstimateMemoryUsage(shadowed_table_entries_) +
          base::trace_event::EstimateMemoryUsage(removed_entries_);
 }
 
 void SimpleIndex::SetLastUsedTimeForTest(uint64_t entry_hash,
                                          const base::Time last_used) {
-  EntrySet::iterator it = entries_set_.find(entry_hash);
+  EntrySet::iterator it = FindEntry(entry_hash);
   DCHECK(it != entries_set_.end());
   it->second.SetLastUsedTime(last_used);
 }
@@ -288,8 +304,10 @@ void SimpleIndex::Insert(uint64_t entry_hash) {
   // Upon insert we don't know yet the size of the entry.
   // It will be updated later when the SimpleEntryImpl finishes opening or
   // creating the new entry, and then UpdateEntrySize will be called.
-  InsertInEntrySet(entry_hash, EntryMetadata(base::Time::Now(), 0u),
-                   &entries_set_);
+  if (FindEntry(entry_hash) == entries_set_.end()) {
+    InsertInEntrySet(entry_hash, EntryMetadata(base::Time::Now(), 0u),
+                     &entries_set_);
+  }
   if (!initialized_)
     removed_entries_.erase(entry_hash);
   PostponeWritingToDisk();
@@ -297,7 +315,8 @@ void SimpleIndex::Insert(uint64_t entry_hash) {
 
 void SimpleIndex::Remove(uint64_t entry_hash) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
-  EntrySet::iterator it = entries_set_.find(entry_hash);
+  // If the entry came from |index_table_|, it stays shadowed once removed.
+  EntrySet::iterator it = FindEntry(entry_hash);
   if (it != entries_set_.end()) {
     UpdateEntryIteratorSize(&it, 0u);
     entries_set_.erase(it);
@@ -311,20 +330,25 @@ void SimpleIndex::Remove(uint64_t entry_hash) {
 bool SimpleIndex::Has(uint64_t hash) const {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   // If not initialized, always return true, forcing it to go to the disk.
-  return !initialized_ || entries_set_.count(hash) > 0;
+  EntryMetadata metadata;
+  return !initialized_ || entries_set_.count(hash) > 0 ||
+         FindTableEntry(hash, &metadata);
 }
 
 uint8_t SimpleIndex::GetEntryInMemoryData(uint64_t entry_hash) const {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   EntrySet::const_iterator it = entries_set_.find(entry_hash);
-  if (it == entries_set_.end())
-    return 0;
-  return it->second.GetInMemoryData();
+  if (it != entries_set_.end())
+    return it->second.GetInMemoryData();
+  EntryMetadata metadata;
+  if (FindTableEntry(entry_hash, &metadata))
+    return metadata.GetInMemoryData();
+  return 0;
 }
 
 void SimpleIndex::SetEntryInMemoryData(uint64_t entry_hash, uint8_t value) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
-  EntrySet::iterator it = entries_set_.find(entry_hash);
+  EntrySet::iterator it = FindEntry(entry_hash);
   if (it == entries_set_.end())
     return;
   return it->second.SetInMemoryData(value);
@@ -334,7 +358,7 @@ bool SimpleIndex::UseIfExists(uint64_t entry_hash) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   // Always update the last used time, even if it is during initialization.
   // It will be merged later.
-  EntrySet::iterator it = entries_set_.find(entry_hash);
+  EntrySet::iterator it = FindEntry(entry_hash);
   if (it == entries_set_.end())
     // If not initialized, always return true, forcing it to go to the disk.
     return !initialized_;
@@ -357,33 +381,34 @@ void SimpleIndex::StartEvictionIfNeeded() {
       MEMORY_KB, "Eviction.MaxCacheSizeOnStart2", cache_type_,
       static_cast<base::HistogramBase::Sample>(max_size_ / kBytesInKb));
 
-  // Flatten for sorting.
-  std::vector<std::pair<uint64_t, const EntrySet::value_type*>> entries;
-  entries.reserve(entries_set_.size());
+  // Flatten for sorting. The entries may not all be in |entries_set_|, so
+  // their hashes and sizes are copied.
+  std::vector<std::pair<uint64_t, std::pair<uint64_t, uint32_t>>> entries;
+  entries.reserve(GetEntryCount());
   uint32_t now = (base::Time::Now() - base::Time::UnixEpoch()).InSeconds();
   bool use_size = base::FeatureList::IsEnabled(kSimpleCacheEvictionWithSize);
-  for (EntrySet::const_iterator i = entries_set_.begin();
-       i != entries_set_.end(); ++i) {
-    uint64_t sort_value = now - i->second.RawTimeForSorting();
+  ForEachEntry([&](uint64_t entry_hash, const EntryMetadata& metadata) {
+    uint64_t sort_value = now - metadata.RawTimeForSorting();
     if (use_size) {
       // Will not overflow since we're multiplying two 32-bit values and storing
       // them in a 64-bit variable.
-      sort_value *= i->second.GetEntrySize() + kEstimatedEntryOverhead;
+      sort_value *= metadata.GetEntrySize() + kEstimatedEntryOverhead;
     }
     // Subtract so we don't need a custom comparator.
-    entries.emplace_back(std::numeric_limits<uint64_t>::max() - sort_value,
-                         &*i);
-  }
+    entries.emplace_back(
+        std::numeric_limits<uint64_t>::max() - sort_value,
+        std::make_pair(entry_hash, metadata.GetEntrySize()));
+  });
 
   uint64_t evicted_so_far_size = 0;
   const uint64_t amount_to_evict = cache_size_ - low_watermark_;
   std::vector<uint64_t> entry_hashes;
   std::sort(entries.begin(), entries.end());
-  for (const auto& score_metadata_pair : entries) {
+  for (const auto& score_entry_pair : entries) {
     if (evicted_so_far_size >= amount_to_evict)
       break;
-    evicted_so_far_size += score_metadata_pair.second->second.GetEntrySize();
-    entry_hashes.push_back(score_metadata_pair.second->first);
+    evicted_so_far_size += score_entry_pair.second.second;
+    entry_hashes.push_back(score_entry_pair.second.first);
   }
 
   SIMPLE_CACHE_UMA(COUNTS_1M,
@@ -403,7 +428,7 @@ void SimpleIndex::StartEvictionIfNeeded() {
 bool SimpleIndex::UpdateEntrySize(uint64_t entry_hash,
                                   base::StrictNumeric<uint32_t> entry_size) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
-  EntrySet::iterator it = entries_set_.find(entry_hash);
+  EntrySet::iterator it = FindEntry(entry_hash);
   if (it == entries_set_.end())
     return false;
 
@@ -438,7 +463,9 @@ void SimpleIndex::InsertInEntrySet(
 
 void SimpleIndex::InsertEntryForTesting(uint64_t entry_hash,
                                         const EntryMetadata& entry_metadata) {
-  DCHECK(entries_set_.find(entry_hash) == entries_set_.end());
+  EntryMetadata table_metadata;
+  DCHECK(entries_set_.find(entry_hash) == entries_set_.end() &&
+         !FindTableEntry(entry_hash, &table_metadata));
   InsertInEntrySet(entry_hash, entry_metadata, &entries_set_);
   cache_size_ += entry_metadata.GetEntrySize();
 }
@@ -453,6 +480,21 @@ void SimpleIndex::PostponeWritingToDisk() {
       FROM_HERE, base::TimeDelta::FromMilliseconds(delay), write_to_disk_cb_);
 }
 
+SimpleIndex::EntrySet::iterator SimpleIndex::FindEntry(uint64_t entry_hash) {
+  EntrySet::iterator it = entries_set_.find(entry_hash);
+  EntryMetadata metadata;
+  if (it != entries_set_.end() || !FindTableEntry(entry_hash, &metadata))
+    return it;
+  shadowed_table_entries_.insert(entry_hash);
+  return entries_set_.insert(std::make_pair(entry_hash, metadata)).first;
+}
+
+bool SimpleIndex::FindTableEntry(uint64_t entry_hash,
+                                 EntryMetadata* out_metadata) const {
+  return index_table_ && !shadowed_table_entries_.count(entry_hash) &&
+         index_table_->Find(entry_hash, out_metadata);
+}
+
 void SimpleIndex::UpdateEntryIteratorSize(
     EntrySet::iterator* it,
     base::StrictNumeric<uint32_t> entry_size) {
@@ -469,33 +511,37 @@ void SimpleIndex::MergeInitializingSet(
     std::unique_ptr<SimpleIndexLoadResult> load_result) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
 
-  EntrySet* index_file_entries = &load_result->entries;
+  if (load_result->table) {
+    MergeInitializingSetWithTable(std::move(load_result->table));
+  } else {
+    EntrySet* index_file_entries = &load_result->entries;
 
-  for (std::unordered_set<uint64_t>::const_iterator it =
-           removed_entries_.begin();
-       it != removed_entries_.end(); ++it) {
-    index_file_entries->erase(*it);
-  }
-  removed_entries_.clear();
+    for (std::unordered_set<uint64_t>::const_iterator it =
+             removed_entries_.begin();
+         it != removed_entries_.end(); ++it) {
+      index_file_entries->erase(*it);
+    }
+    removed_entries_.clear();
+
+    for (EntrySet::const_iterator it = entries_set_.begin();
+         it != entries_set_.end(); ++it) {
+      const uint64_t entry_hash = it->first;
+      std::pair<EntrySet::iterator, bool> insert_result =
+          index_file_entries->insert(EntrySet::value_type(entry_hash,
+                                                          EntryMetadata()));
+      EntrySet::iterator& possibly_inserted_entry = insert_result.first;
+      possibly_inserted_entry->second = it->second;
+    }
 
-  for (EntrySet::const_iterator it = entries_set_.begin();
-       it != entries_set_.end(); ++it) {
-    const uint64_t entry_hash = it->first;
-    std::pair<EntrySet::iterator, bool> insert_result =
-        index_file_entries->insert(EntrySet::value_type(entry_hash,
-                                                        EntryMetadata()));
-    EntrySet::iterator& possibly_inserted_entry = insert_result.first;
-    possibly_inserted_entry->second = it->second;
-  }
+    uint64_t merged_cache_size = 0;
+    for (EntrySet::iterator it = index_file_entries->begin();
+         it != index_file_entries->end(); ++it) {
+      merged_cache_size += it->second.GetEntrySize();
+    }
 
-  uint64_t merged_cache_size = 0;
-  for (EntrySet::iterator it = index_file_entries->begin();
-       it != index_file_entries->end(); ++it) {
-    merged_cache_size += it->second.GetEntrySize();
+    entries_set_.swap(*index_file_entries);
+    cache_size_ = merged_cache_size;
   }
-
-  entries_set_.swap(*index_file_entries);
-  cache_size_ = merged_cache_size;
   initialized_ = true;
   init_method_ = load_result->init_method;
 
@@ -508,7 +554,7 @@ void SimpleIndex::MergeInitializingSet(
                    "IndexInitializationWaiters", cache_type_,
                    to_run_when_initialized_.size(), 0, 100, 20);
   SIMPLE_CACHE_UMA(CUSTOM_COUNTS, "IndexNumEntriesOnInit", cache_type_,
-                   entries_set_.size(), 0, 100000, 50);
+                   GetEntryCount(), 0, 100000, 50);
   SIMPLE_CACHE_UMA(
       MEMORY_KB, "CacheSizeOnInit", cache_type_,
       static_cast<base::HistogramBase::Sample>(cache_size_ / kBytesInKb));
@@ -529,6 +575,35 @@ void SimpleIndex::MergeInitializingSet(
   to_run_when_initialized_.clear();
 }
 
+void SimpleIndex::MergeInitializingSetWithTable(
+    scoped_refptr<SimpleIndexTable> table) {
+  DCHECK(io_thread_checker_.CalledOnValidThread());
+  DCHECK(!index_table_);
+  index_table_ = std::move(table);
+
+  // The table stays as it is on disk: the entries removed or inserted during
+  // initialization shadow its own.
+  uint64_t shadowed_size = 0;
+  auto shadow = [this, &shadowed_size](uint64_t entry_hash) {
+    EntryMetadata metadata;
+    if (FindTableEntry(entry_hash, &metadata)) {
+      shadowed_table_entries_.insert(entry_hash);
+      shadowed_size += metadata.GetEntrySize();
+    }
+  };
+  for (uint64_t entry_hash : removed_entries_)
+    shadow(entry_hash);
+  removed_entries_.clear();
+
+  uint64_t merged_cache_size = index_table_->cache_size();
+  for (const auto& entry : entries_set_) {
+    shadow(entry.first);
+    merged_cache_size += entry.second.GetEntrySize();
+  }
+  // The records aren't checksummed, so don't trust them to add up.
+  cache_size_ = merged_cache_size - std::min(merged_cache_size, shadowed_size);
+}
+
 #if defined(OS_ANDROID)
 void SimpleIndex::OnApplicationStateChange(
     base::android::ApplicationState state) {
@@ -551,7 +626,7 @@ void SimpleIndex::WriteToDisk(IndexWriteToDiskReason reason) {
     return;
   SIMPLE_CACHE_UMA(CUSTOM_COUNTS,
                    "IndexNumEntriesOnWrite", cache_type_,
-                   entries_set_.size(), 0, 100000, 50);
+                   GetEntryCount(), 0, 100000, 50);
   const base::TimeTicks start = base::TimeTicks::Now();
   if (!last_write_to_disk_.is_null()) {
     if (app_on_background_) {
@@ -575,6 +650,14 @@ void SimpleIndex::WriteToDisk(IndexWriteToDiskReason reason) {
         cleanup_tracker_);
   }
 
+  if (index_table_ || SimpleIndexTable::IsEnabled()) {
+    // Only the changes to the table are copied here, the new table is merged
+    // on the cache thread.
+    index_file_->WriteTableToDisk(reason, index_table_, shadowed_table_entries_,
+                                  entries_set_, start, app_on_background_,
+                                  after_write);
+    return;
+  }
   index_file_->WriteToDisk(reason, entries_set_, cache_size_, start,
                            app_on_background_, after_write);
 }
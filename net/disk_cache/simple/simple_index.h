@@ -42,6 +42,7 @@ namespace disk_cache {
 class BackendCleanupTracker;
 class SimpleIndexDelegate;
 class SimpleIndexFile;
+class SimpleIndexTable;
 struct SimpleIndexLoadResult;
 
 NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheEvictionWithSize;
@@ -80,6 +81,7 @@ class NET_EXPORT_PRIVATE EntryMetadata {
 
  private:
   friend class SimpleIndexFileTest;
+  friend class SimpleIndexTable;
 
   // There are tens of thousands of instances of EntryMetadata in memory, so the
   // size of each entry matters.  Even when the values used to set these members
@@ -206,12 +208,27 @@ class NET_EXPORT_PRIVATE SimpleIndex
 
   void PostponeWritingToDisk();
 
+  // Returns the entry with |entry_hash| in |entries_set_|, first copying it
+  // there from |index_table_| if needed, or entries_set_.end() if there is
+  // none.
+  EntrySet::iterator FindEntry(uint64_t entry_hash);
+
+  // Looks up an entry of |index_table_| that was neither changed nor removed.
+  bool FindTableEntry(uint64_t entry_hash, EntryMetadata* out_metadata) const;
+
+  // Calls |function| with the hash and metadata of each entry.
+  template <typename Function>
+  void ForEachEntry(Function function) const;
+
   void UpdateEntryIteratorSize(EntrySet::iterator* it,
                                base::StrictNumeric<uint32_t> entry_size);
 
   // Must run on IO Thread.
   void MergeInitializingSet(std::unique_ptr<SimpleIndexLoadResult> load_result);
 
+  // Called by MergeInitializingSet() when the index was loaded as a table.
+  void MergeInitializingSetWithTable(scoped_refptr<SimpleIndexTable> table);
+
 #if defined(OS_ANDROID)
   void OnApplicationStateChange(base::android::ApplicationState state);
 
@@ -226,6 +243,12 @@ class NET_EXPORT_PRIVATE SimpleIndex
 
   EntrySet entries_set_;
 
+  // When the index was loaded from a SimpleIndexTable, |entries_set_| only
+  // holds the entries that were added or changed since, and the table's
+  // entries that were changed or removed are in |shadowed_table_entries_|.
+  scoped_refptr<SimpleIndexTable> index_table_;
+  std::unordered_set<uint64_t> shadowed_table_entries_;
+
   const net::CacheType cache_type_;
   uint64_t cache_size_;  // Total cache storage size in bytes.
   uint64_t max_size_;
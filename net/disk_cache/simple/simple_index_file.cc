@@ -22,6 +22,7 @@
 #include "net/disk_cache/simple/simple_entry_format.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_index.h"
+#include "net/disk_cache/simple/simple_index_table.h"
 #include "net/disk_cache/simple/simple_synchronous_entry.h"
 #include "net/disk_cache/simple/simple_util.h"
 
@@ -133,6 +134,47 @@ bool WritePickleFile(base::Pickle* pickle, const base::FilePath& file_name) {
   return true;
 }
 
+// Makes sure the directory holding the index exists, and gets the
+// modification time of the cache directory to save in the index.
+bool PrepareIndexWrite(const base::FilePath& cache_directory,
+                       const base::FilePath& index_filename,
+                       const base::FilePath& temp_index_filename,
+                       base::Time* out_cache_dir_mtime) {
+  DCHECK_EQ(index_filename.DirName().value(),
+            temp_index_filename.DirName().value());
+  base::FilePath index_file_directory = temp_index_filename.DirName();
+  if (!base::DirectoryExists(index_file_directory) &&
+      !base::CreateDirectory(index_file_directory)) {
+    LOG(ERROR) << "Could not create a directory to hold the index file";
+    return false;
+  }
+
+  // There is a chance that the index containing all the necessary data about
+  // newly created entries will appear to be stale. This can happen if on-disk
+  // part of a Create operation does not fit into the time budget for the index
+  // flush delay. This simple approach will be reconsidered if it does not allow
+  // for maintaining freshness.
+  if (!simple_util::GetMTime(cache_directory, out_cache_dir_mtime)) {
+    LOG(ERROR) << "Could obtain information about cache age";
+    return false;
+  }
+  return true;
+}
+
+void UmaRecordIndexWriteTime(net::CacheType cache_type,
+                             const base::TimeTicks& start_time,
+                             bool app_on_background) {
+  if (app_on_background) {
+    SIMPLE_CACHE_UMA(TIMES,
+                     "IndexWriteToDiskTime.Background", cache_type,
+                     (base::TimeTicks::Now() - start_time));
+  } else {
+    SIMPLE_CACHE_UMA(TIMES,
+                     "IndexWriteToDiskTime.Foreground", cache_type,
+                     (base::TimeTicks::Now() - start_time));
+  }
+}
+
 // Called for each cache directory traversal iteration.
 void ProcessEntryFile(SimpleIndex::EntrySet* entries,
                       const base::FilePath& file_path,
@@ -236,6 +278,7 @@ void SimpleIndexLoadResult::Reset() {
   index_write_reason = SimpleIndex::INDEX_WRITE_REASON_MAX;
   flush_required = false;
   entries.clear();
+  table = nullptr;
 }
 
 // static
@@ -303,23 +346,9 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
                                       std::unique_ptr<base::Pickle> pickle,
                                       const base::TimeTicks& start_time,
                                       bool app_on_background) {
-  DCHECK_EQ(index_filename.DirName().value(),
-            temp_index_filename.DirName().value());
-  base::FilePath index_file_directory = temp_index_filename.DirName();
-  if (!base::DirectoryExists(index_file_directory) &&
-      !base::CreateDirectory(index_file_directory)) {
-    LOG(ERROR) << "Could not create a directory to hold the index file";
-    return;
-  }
-
-  // There is a chance that the index containing all the necessary data about
-  // newly created entries will appear to be stale. This can happen if on-disk
-  // part of a Create operation does not fit into the time budget for the index
-  // flush delay. This simple approach will be reconsidered if it does not allow
-  // for maintaining freshness.
   base::Time cache_dir_mtime;
-  if (!simple_util::GetMTime(cache_directory, &cache_dir_mtime)) {
-    LOG(ERROR) << "Could obtain information about cache age";
+  if (!PrepareIndexWrite(cache_directory, index_filename, temp_index_filename,
+                         &cache_dir_mtime)) {
     return;
   }
   SerializeFinalData(cache_dir_mtime, pickle.get());
@@ -332,15 +361,36 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
   if (!base::ReplaceFile(temp_index_filename, index_filename, NULL))
     return;
 
-  if (app_on_background) {
-    SIMPLE_CACHE_UMA(TIMES,
-                     "IndexWriteToDiskTime.Background", cache_type,
-                     (base::TimeTicks::Now() - start_time));
-  } else {
-    SIMPLE_CACHE_UMA(TIMES,
-                     "IndexWriteToDiskTime.Foreground", cache_type,
-                     (base::TimeTicks::Now() - start_time));
+  UmaRecordIndexWriteTime(cache_type, start_time, app_on_background);
+}
+
+// static
+void SimpleIndexFile::SyncWriteTableToDisk(
+    net::CacheType cache_type,
+    const base::FilePath& cache_directory,
+    const base::FilePath& index_filename,
+    const base::FilePath& temp_index_filename,
+    SimpleIndex::IndexWriteToDiskReason reason,
+    scoped_refptr<SimpleIndexTable> table,
+    std::unique_ptr<std::unordered_set<uint64_t>> removed_hashes,
+    std::unique_ptr<SimpleIndex::EntrySet> entries,
+    const base::TimeTicks& start_time,
+    bool app_on_background) {
+  base::Time cache_dir_mtime;
+  if (!PrepareIndexWrite(cache_directory, index_filename, temp_index_filename,
+                         &cache_dir_mtime)) {
+    return;
   }
+  if (!SimpleIndexTable::Write(temp_index_filename, reason, cache_dir_mtime,
+                               table.get(), *removed_hashes, *entries)) {
+    LOG(ERROR) << "Failed to write the temporary index file";
+    return;
+  }
+
+  if (!base::ReplaceFile(temp_index_filename, index_filename, NULL))
+    return;
+
+  UmaRecordIndexWriteTime(cache_type, start_time, app_on_background);
 }
 
 bool SimpleIndexFile::IndexMetadata::CheckIndexMetadata() {
@@ -402,6 +452,28 @@ void SimpleIndexFile::WriteToDisk(SimpleIndex::IndexWriteToDiskReason reason,
     cache_runner_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
+void SimpleIndexFile::WriteTableToDisk(
+    SimpleIndex::IndexWriteToDiskReason reason,
+    scoped_refptr<SimpleIndexTable> table,
+    const std::unordered_set<uint64_t>& removed_hashes,
+    const SimpleIndex::EntrySet& entries,
+    const base::TimeTicks& start,
+    bool app_on_background,
+    const base::Closure& callback) {
+  UmaRecordIndexWriteReason(reason, cache_type_);
+  base::Closure task = base::Bind(
+      &SimpleIndexFile::SyncWriteTableToDisk, cache_type_, cache_directory_,
+      index_file_, temp_index_file_, reason, std::move(table),
+      base::Passed(
+          std::make_unique<std::unordered_set<uint64_t>>(removed_hashes)),
+      base::Passed(std::make_unique<SimpleIndex::EntrySet>(entries)), start,
+      app_on_background);
+  if (callback.is_null())
+    cache_runner_->PostTask(FROM_HERE, task);
+  else
+    cache_runner_->PostTaskAndReply(FROM_HERE, task, callback);
+}
+
 // static
 void SimpleIndexFile::SyncLoadIndexEntries(
     net::CacheType cache_type,
@@ -443,6 +515,10 @@ void SimpleIndexFile::SyncLoadIndexEntries(
   // Reconstruct the index by scanning the disk for entries.
   SimpleIndex::EntrySet entries_from_stale_index;
   entries_from_stale_index.swap(out_result->entries);
+  if (out_result->table) {
+    out_result->table->CopyEntriesTo(&entries_from_stale_index);
+    out_result->table = nullptr;
+  }
   const base::TimeTicks start = base::TimeTicks::Now();
   SyncRestoreFromDisk(cache_directory, index_file_path, out_result);
   SIMPLE_CACHE_UMA(MEDIUM_TIMES, "IndexRestoreTime", cache_type,
@@ -494,6 +570,25 @@ void SimpleIndexFile::SyncLoadFromDisk(const base::FilePath& index_filename,
     return;
   }
 
+  if (SimpleIndexTable::IsTableFile(&file)) {
+    scoped_refptr<SimpleIndexTable> table =
+        SimpleIndexTable::Open(std::move(file));
+    if (!table) {
+      LOG(WARNING) << "Corrupt Simple Index table.";
+      simple_util::SimpleCacheDeleteFile(index_filename);
+      return;
+    }
+    *out_last_cache_seen_by_index = table->cache_last_modified();
+    out_result->index_write_reason = table->reason();
+    out_result->did_load = true;
+    // Tables written before the feature was disabled are still read.
+    if (SimpleIndexTable::IsEnabled())
+      out_result->table = std::move(table);
+    else
+      table->CopyEntriesTo(&out_result->entries);
+    return;
+  }
+
   // Make sure to preallocate in one chunk, so we don't induce fragmentation
   // reallocating a growing buffer.
   auto buffer = std::make_unique<char[]>(file_length);
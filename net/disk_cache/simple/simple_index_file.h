@@ -9,12 +9,14 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/pickle.h"
 #include "net/base/cache_type.h"
 #include "net/base/net_export.h"
@@ -27,6 +29,8 @@ class TaskRunner;
 
 namespace disk_cache {
 
+class SimpleIndexTable;
+
 const uint64_t kSimpleIndexMagicNumber = UINT64_C(0x656e74657220796f);
 
 struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
@@ -36,6 +40,8 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 
   bool did_load;
   SimpleIndex::EntrySet entries;
+  // Set instead of |entries| when the index file is a SimpleIndexTable.
+  scoped_refptr<SimpleIndexTable> table;
   SimpleIndex::IndexWriteToDiskReason index_write_reason;
   SimpleIndex::IndexInitMethod init_method;
   bool flush_required;
@@ -45,7 +51,8 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 // objects. The file format is as follows: one instance of |IndexMetadata|
 // followed by |EntryMetadata| repeated |entry_count| times. To learn more about
 // the format see |SimpleIndexFile::Serialize()| and
-// |SimpleIndexFile::LoadFromDisk()|.
+// |SimpleIndexFile::LoadFromDisk()|. The index may instead be written as a
+// SimpleIndexTable, see simple_index_table.h.
 //
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
@@ -105,6 +112,18 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                            bool app_on_background,
                            const base::Closure& callback);
 
+  // Writes a SimpleIndexTable merging |table|, which may be null, with the
+  // changes to it, as described by SimpleIndexTable::Write(). Only the
+  // changes are copied, the merge runs on the cache thread.
+  virtual void WriteTableToDisk(
+      SimpleIndex::IndexWriteToDiskReason reason,
+      scoped_refptr<SimpleIndexTable> table,
+      const std::unordered_set<uint64_t>& removed_hashes,
+      const SimpleIndex::EntrySet& entries,
+      const base::TimeTicks& start,
+      bool app_on_background,
+      const base::Closure& callback);
+
  private:
   friend class WrappedSimpleIndexFile;
 
@@ -170,6 +189,19 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                               const base::TimeTicks& start_time,
                               bool app_on_background);
 
+  // Writes the index table to disk atomically.
+  static void SyncWriteTableToDisk(
+      net::CacheType cache_type,
+      const base::FilePath& cache_directory,
+      const base::FilePath& index_filename,
+      const base::FilePath& temp_index_filename,
+      SimpleIndex::IndexWriteToDiskReason reason,
+      scoped_refptr<SimpleIndexTable> table,
+      std::unique_ptr<std::unordered_set<uint64_t>> removed_hashes,
+      std::unique_ptr<SimpleIndex::EntrySet> entries,
+      const base::TimeTicks& start_time,
+      bool app_on_background);
+
   // Scan the index directory for entries, returning an EntrySet of all entries
   // found.
   static void SyncRestoreFromDisk(const base::FilePath& cache_directory,
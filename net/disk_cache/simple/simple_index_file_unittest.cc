@@ -5,6 +5,7 @@
 #include "net/disk_cache/simple/simple_index_file.h"
 
 #include <memory>
+#include <unordered_set>
 
 #include "base/files/file.h"
 #include "base/files/file_util.h"
@@ -15,6 +16,7 @@
 #include "base/pickle.h"
 #include "base/run_loop.h"
 #include "base/single_thread_task_runner.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
@@ -26,6 +28,7 @@
 #include "net/disk_cache/simple/simple_backend_version.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
 #include "net/disk_cache/simple/simple_index.h"
+#include "net/disk_cache/simple/simple_index_table.h"
 #include "net/disk_cache/simple/simple_util.h"
 #include "net/disk_cache/simple/simple_version_upgrade.h"
 #include "net/test/gtest_util.h"
@@ -339,6 +342,91 @@ TEST_F(SimpleIndexFileTest, WriteThenLoadIndex) {
     EXPECT_EQ(1U, load_index_result.entries.count(kHashes[i]));
 }
 
+TEST_F(SimpleIndexFileTest, WriteThenLoadIndexTable) {
+  base::test::ScopedFeatureList features;
+  features.InitAndEnableFeature(kSimpleCacheIndexTable);
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+  WrappedSimpleIndexFile simple_index_file(cache_dir.GetPath());
+
+  SimpleIndex::EntrySet entries;
+  for (uint64_t hash : {33u, 11u, 22u}) {
+    SimpleIndex::InsertInEntrySet(
+        hash, EntryMetadata(Time(), static_cast<uint32_t>(hash * 256)),
+        &entries);
+  }
+  net::TestClosure closure;
+  simple_index_file.WriteTableToDisk(
+      SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, nullptr,
+      std::unordered_set<uint64_t>(), entries, base::TimeTicks(), false,
+      closure.closure());
+  closure.WaitForResult();
+
+  base::Time fake_cache_mtime;
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &fake_cache_mtime));
+  SimpleIndexLoadResult load_index_result;
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &load_index_result);
+  closure.WaitForResult();
+
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_FALSE(load_index_result.flush_required);
+  EXPECT_TRUE(load_index_result.entries.empty());
+  scoped_refptr<SimpleIndexTable> table = load_index_result.table;
+  ASSERT_TRUE(table);
+  EXPECT_EQ(SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, table->reason());
+  ASSERT_EQ(3u, table->size());
+  EXPECT_EQ(11u, table->GetHashAt(0));
+  EXPECT_EQ(22u, table->GetHashAt(1));
+  EXPECT_EQ(33u, table->GetHashAt(2));
+  EXPECT_EQ((11u + 22u + 33u) * 256, table->cache_size());
+  EntryMetadata metadata;
+  ASSERT_TRUE(table->Find(22, &metadata));
+  EXPECT_TRUE(CompareTwoEntryMetadata(entries[22], metadata));
+  EXPECT_FALSE(table->Find(44, &metadata));
+
+  // Write a table without 11, with a new 22 and with 44.
+  std::unordered_set<uint64_t> removed_hashes = {11, 22};
+  SimpleIndex::EntrySet changes;
+  SimpleIndex::InsertInEntrySet(22, EntryMetadata(Time(), 512u), &changes);
+  SimpleIndex::InsertInEntrySet(44, EntryMetadata(Time(), 1024u), &changes);
+  simple_index_file.WriteTableToDisk(SimpleIndex::INDEX_WRITE_REASON_IDLE,
+                                     table, removed_hashes, changes,
+                                     base::TimeTicks(), false,
+                                     closure.closure());
+  closure.WaitForResult();
+  // The old table is unaffected.
+  EXPECT_EQ(3u, table->size());
+  EXPECT_TRUE(table->Find(11, &metadata));
+
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &fake_cache_mtime));
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &load_index_result);
+  closure.WaitForResult();
+  table = load_index_result.table;
+  ASSERT_TRUE(table);
+  EXPECT_EQ(SimpleIndex::INDEX_WRITE_REASON_IDLE, table->reason());
+  ASSERT_EQ(3u, table->size());
+  EXPECT_EQ(22u, table->GetHashAt(0));
+  EXPECT_EQ(33u, table->GetHashAt(1));
+  EXPECT_EQ(44u, table->GetHashAt(2));
+  EXPECT_EQ(512u + 33u * 256 + 1024u, table->cache_size());
+  ASSERT_TRUE(table->Find(22, &metadata));
+  EXPECT_EQ(512u, metadata.GetEntrySize());
+
+  // Without the feature, tables are read into the entries.
+  base::test::ScopedFeatureList disable_features;
+  disable_features.InitAndDisableFeature(kSimpleCacheIndexTable);
+  table = nullptr;
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &load_index_result);
+  closure.WaitForResult();
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_FALSE(load_index_result.table);
+  EXPECT_EQ(3u, load_index_result.entries.size());
+  EXPECT_EQ(1u, load_index_result.entries.count(44));
+}
+
 TEST_F(SimpleIndexFileTest, LoadCorruptIndex) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
@@ -0,0 +1,226 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_index_table.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
+#include "net/disk_cache/simple/simple_util.h"
+
+namespace disk_cache {
+
+namespace {
+
+// Limit on the number of entries of a table, to avoid crashes when its
+// header is corrupt. Same as for pickled indexes.
+const uint64_t kMaxEntriesInTable = 1000000;
+
+}  // namespace
+
+const base::Feature kSimpleCacheIndexTable = {
+    "SimpleCacheIndexTable", base::FEATURE_DISABLED_BY_DEFAULT};
+
+// If you change the layout of the header or of the records, be sure to update
+// kVersion.
+struct SimpleIndexTable::Header {
+  uint64_t magic_number;
+  uint32_t version;
+  uint32_t reason;
+  uint64_t entry_count;
+  uint64_t cache_size;
+  int64_t cache_last_modified;
+  uint32_t padding;
+  // Of the fields above.
+  uint32_t crc;
+};
+
+struct SimpleIndexTable::Record {
+  uint64_t hash;
+  uint32_t last_used_time_seconds_since_epoch;
+  // The entry size in 256-byte chunks, shifted left by 8, and the in-memory
+  // data, as in pickled indexes.
+  uint32_t packed_entry_info;
+};
+
+const uint32_t SimpleIndexTable::kVersion;
+
+// static
+bool SimpleIndexTable::IsEnabled() {
+  return base::FeatureList::IsEnabled(kSimpleCacheIndexTable);
+}
+
+// static
+bool SimpleIndexTable::IsTableFile(base::File* file) {
+  uint64_t magic_number = 0;
+  return file->Read(0, reinterpret_cast<char*>(&magic_number),
+                    sizeof(magic_number)) == sizeof(magic_number) &&
+         magic_number == kSimpleIndexTableMagicNumber;
+}
+
+// static
+scoped_refptr<SimpleIndexTable> SimpleIndexTable::Open(base::File file) {
+  Header header;
+  if (file.Read(0, reinterpret_cast<char*>(&header), sizeof(header)) !=
+      static_cast<int>(sizeof(header))) {
+    return nullptr;
+  }
+  const uint32_t crc = simple_util::Crc32(
+      reinterpret_cast<const char*>(&header), offsetof(Header, crc));
+  if (header.magic_number != kSimpleIndexTableMagicNumber ||
+      header.version != kVersion || header.crc != crc ||
+      header.reason >= SimpleIndex::INDEX_WRITE_REASON_MAX ||
+      header.entry_count > kMaxEntriesInTable ||
+      file.GetLength() !=
+          static_cast<int64_t>(sizeof(Header) +
+                               header.entry_count * sizeof(Record))) {
+    return nullptr;
+  }
+
+  scoped_refptr<SimpleIndexTable> table(new SimpleIndexTable);
+  table->entry_count_ = static_cast<size_t>(header.entry_count);
+  table->records_ = std::make_unique<Record[]>(table->entry_count_);
+  const int records_size =
+      base::checked_cast<int>(table->entry_count_ * sizeof(Record));
+  if (records_size &&
+      file.Read(sizeof(Header), reinterpret_cast<char*>(table->records_.get()),
+                records_size) != records_size) {
+    return nullptr;
+  }
+  table->reason_ =
+      static_cast<SimpleIndex::IndexWriteToDiskReason>(header.reason);
+  table->cache_size_ = header.cache_size;
+  table->cache_last_modified_ =
+      base::Time::FromInternalValue(header.cache_last_modified);
+  return table;
+}
+
+// static
+bool SimpleIndexTable::Write(const base::FilePath& file_name,
+                             SimpleIndex::IndexWriteToDiskReason reason,
+                             base::Time cache_last_modified,
+                             const SimpleIndexTable* base,
+                             const std::unordered_set<uint64_t>& removed_hashes,
+                             const SimpleIndex::EntrySet& entries) {
+  std::vector<Record> changes(entries.size());
+  size_t i = 0;
+  for (const auto& entry : entries)
+    FillRecord(entry.first, entry.second, &changes[i++]);
+  auto hash_less = [](const Record& a, const Record& b) {
+    return a.hash < b.hash;
+  };
+  std::sort(changes.begin(), changes.end(), hash_less);
+
+  // Both |changes| and the records of |base| are sorted, so they can be
+  // merged in a single pass.
+  std::vector<Record> records;
+  records.reserve((base ? base->size() : 0) + changes.size());
+  auto change = changes.begin();
+  for (size_t j = 0; base && j < base->size(); ++j) {
+    const Record& record = base->records()[j];
+    if (removed_hashes.count(record.hash) || entries.count(record.hash))
+      continue;
+    for (; change != changes.end() && change->hash < record.hash; ++change)
+      records.push_back(*change);
+    records.push_back(record);
+  }
+  records.insert(records.end(), change, changes.end());
+
+  Header header = {};
+  header.magic_number = kSimpleIndexTableMagicNumber;
+  header.version = kVersion;
+  header.reason = static_cast<uint32_t>(reason);
+  header.entry_count = records.size();
+  for (const Record& record : records)
+    header.cache_size += record.packed_entry_info & 0xFFFFFF00;
+  header.cache_last_modified = cache_last_modified.ToInternalValue();
+  header.crc = simple_util::Crc32(reinterpret_cast<const char*>(&header),
+                                  offsetof(Header, crc));
+
+  base::File file(file_name, base::File::FLAG_CREATE_ALWAYS |
+                                 base::File::FLAG_WRITE |
+                                 base::File::FLAG_SHARE_DELETE);
+  if (!file.IsValid())
+    return false;
+  const int records_size =
+      base::checked_cast<int>(records.size() * sizeof(Record));
+  if (file.Write(0, reinterpret_cast<const char*>(&header), sizeof(header)) !=
+          static_cast<int>(sizeof(header)) ||
+      (records_size &&
+       file.Write(sizeof(header), reinterpret_cast<const char*>(&records[0]),
+                  records_size) != records_size)) {
+    file.Close();
+    simple_util::SimpleCacheDeleteFile(file_name);
+    return false;
+  }
+  return true;
+}
+
+bool SimpleIndexTable::Find(uint64_t entry_hash,
+                            EntryMetadata* out_metadata) const {
+  const Record* begin = records();
+  const Record* end = begin + entry_count_;
+  const Record* record = std::lower_bound(
+      begin, end, entry_hash,
+      [](const Record& a, uint64_t hash) { return a.hash < hash; });
+  if (record == end || record->hash != entry_hash)
+    return false;
+  *out_metadata = GetMetadataAt(record - begin);
+  return true;
+}
+
+uint64_t SimpleIndexTable::GetHashAt(size_t index) const {
+  DCHECK_LT(index, entry_count_);
+  return records()[index].hash;
+}
+
+EntryMetadata SimpleIndexTable::GetMetadataAt(size_t index) const {
+  DCHECK_LT(index, entry_count_);
+  const Record& record = records()[index];
+  EntryMetadata metadata;
+  metadata.last_used_time_seconds_since_epoch_ =
+      record.last_used_time_seconds_since_epoch;
+  metadata.entry_size_256b_chunks_ = record.packed_entry_info >> 8;
+  metadata.in_memory_data_ = record.packed_entry_info & 0xFF;
+  return metadata;
+}
+
+void SimpleIndexTable::CopyEntriesTo(SimpleIndex::EntrySet* entries) const {
+  entries->reserve(entries->size() + entry_count_);
+  for (size_t i = 0; i < entry_count_; ++i)
+    SimpleIndex::InsertInEntrySet(GetHashAt(i), GetMetadataAt(i), entries);
+}
+
+SimpleIndexTable::SimpleIndexTable()
+    : entry_count_(0),
+      reason_(SimpleIndex::INDEX_WRITE_REASON_MAX),
+      cache_size_(0) {
+  static_assert(sizeof(Header) == 48, "incorrect header size");
+  static_assert(sizeof(Record) == 16, "incorrect record size");
+}
+
+SimpleIndexTable::~SimpleIndexTable() = default;
+
+// static
+void SimpleIndexTable::FillRecord(uint64_t entry_hash,
+                                  const EntryMetadata& metadata,
+                                  Record* record) {
+  record->hash = entry_hash;
+  record->last_used_time_seconds_since_epoch =
+      metadata.last_used_time_seconds_since_epoch_;
+  record->packed_entry_info =
+      (metadata.entry_size_256b_chunks_ << 8) | metadata.in_memory_data_;
+}
+
+const SimpleIndexTable::Record* SimpleIndexTable::records() const {
+  return records_.get();
+}
+
+}  // namespace disk_cache
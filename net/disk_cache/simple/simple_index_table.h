@@ -0,0 +1,115 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_TABLE_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <unordered_set>
+
+#include "base/feature_list.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/simple/simple_index.h"
+
+namespace base {
+class File;
+class FilePath;
+}
+
+namespace disk_cache {
+
+// When enabled, the index is written as a SimpleIndexTable, and index files in
+// that format are searched in place instead of being read into an EntrySet.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheIndexTable;
+
+const uint64_t kSimpleIndexTableMagicNumber = UINT64_C(0x656c626174786469);
+
+// A SimpleIndexTable is an index file laid out as a header followed by fixed
+// width records (hash, last used time, size and in-memory data) sorted by
+// entry hash. Its records are read in a single block on the thread that
+// loads the index and searched in place, so loading it doesn't build a hash
+// table of the entries. Lookups happen on the IO thread, so the records are
+// read into memory rather than mapped: a mapped file could fault in pages from
+// disk there. The table itself is immutable: SimpleIndex keeps the changes to
+// it in memory, and SimpleIndexFile merges them into a new table when the
+// index is written.
+//
+// Only the header is checksummed, since checking the records would read the
+// whole file. A corrupt record only misleads the cache about an entry, which
+// is then fixed up when the entry's files are opened, as with stale indexes.
+class NET_EXPORT_PRIVATE SimpleIndexTable
+    : public base::RefCountedThreadSafe<SimpleIndexTable> {
+ public:
+  static const uint32_t kVersion = 1;
+
+  // Returns whether the index should use tables.
+  static bool IsEnabled();
+
+  // Returns whether |file| starts with the magic number of a table.
+  static bool IsTableFile(base::File* file);
+
+  // Reads the table in |file|, or returns null if it isn't a valid table.
+  // This blocks on disk I/O.
+  static scoped_refptr<SimpleIndexTable> Open(base::File file);
+
+  // Writes to |file_name| a table holding the entries of |base|, which may be
+  // null, except those in |removed_hashes|, followed by |entries| (so with
+  // the same hash, the entry in |entries| wins). Returns false on failure, in
+  // which case the file is deleted.
+  static bool Write(const base::FilePath& file_name,
+                    SimpleIndex::IndexWriteToDiskReason reason,
+                    base::Time cache_last_modified,
+                    const SimpleIndexTable* base,
+                    const std::unordered_set<uint64_t>& removed_hashes,
+                    const SimpleIndex::EntrySet& entries);
+
+  // Looks up the entry with |entry_hash|, which takes O(log(size())).
+  bool Find(uint64_t entry_hash, EntryMetadata* out_metadata) const;
+
+  size_t size() const { return entry_count_; }
+  uint64_t GetHashAt(size_t index) const;
+  EntryMetadata GetMetadataAt(size_t index) const;
+
+  // Adds all the entries to |entries|.
+  void CopyEntriesTo(SimpleIndex::EntrySet* entries) const;
+
+  SimpleIndex::IndexWriteToDiskReason reason() const { return reason_; }
+  // The total size of the entries of the table.
+  uint64_t cache_size() const { return cache_size_; }
+  // The modification time of the cache directory when the table was written.
+  base::Time cache_last_modified() const { return cache_last_modified_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<SimpleIndexTable>;
+
+  struct Header;
+  struct Record;
+
+  SimpleIndexTable();
+  ~SimpleIndexTable();
+
+  static void FillRecord(uint64_t entry_hash,
+                         const EntryMetadata& metadata,
+                         Record* record);
+
+  const Record* records() const;
+
+  std::unique_ptr<Record[]> records_;
+  size_t entry_count_;
+  SimpleIndex::IndexWriteToDiskReason reason_;
+  uint64_t cache_size_;
+  base::Time cache_last_modified_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleIndexTable);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_TABLE_H_
@@ -7,8 +7,10 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 
+#include "base/files/file.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/hash.h"
 #include "base/logging.h"
@@ -26,6 +28,7 @@
 #include "net/disk_cache/backend_cleanup_tracker.h"
 #include "net/disk_cache/simple/simple_index_delegate.h"
 #include "net/disk_cache/simple/simple_index_file.h"
+#include "net/disk_cache/simple/simple_index_table.h"
 #include "net/disk_cache/simple/simple_test_util.h"
 #include "net/disk_cache/simple/simple_util.h"
 #include "net/test/test_with_scoped_task_environment.h"
@@ -90,6 +93,19 @@ class MockSimpleIndexFile : public SimpleIndexFile,
     disk_write_entry_set_ = entry_set;
   }
 
+  void WriteTableToDisk(SimpleIndex::IndexWriteToDiskReason reason,
+                        scoped_refptr<SimpleIndexTable> table,
+                        const std::unordered_set<uint64_t>& removed_hashes,
+                        const SimpleIndex::EntrySet& entries,
+                        const base::TimeTicks& start,
+                        bool app_on_background,
+                        const base::Closure& callback) override {
+    disk_writes_++;
+    disk_write_table_ = table;
+    disk_write_removed_hashes_ = removed_hashes;
+    disk_write_entry_set_ = entries;
+  }
+
   void GetAndResetDiskWriteEntrySet(SimpleIndex::EntrySet* entry_set) {
     entry_set->swap(disk_write_entry_set_);
   }
@@ -98,6 +114,12 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   SimpleIndexLoadResult* load_result() const { return load_result_; }
   int load_index_entries_calls() const { return load_index_entries_calls_; }
   int disk_writes() const { return disk_writes_; }
+  const SimpleIndexTable* disk_write_table() const {
+    return disk_write_table_.get();
+  }
+  const std::unordered_set<uint64_t>& disk_write_removed_hashes() const {
+    return disk_write_removed_hashes_;
+  }
 
  private:
   base::Closure load_callback_;
@@ -105,6 +127,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   int load_index_entries_calls_;
   int disk_writes_;
   SimpleIndex::EntrySet disk_write_entry_set_;
+  scoped_refptr<SimpleIndexTable> disk_write_table_;
+  std::unordered_set<uint64_t> disk_write_removed_hashes_;
 };
 
 class SimpleIndexTest : public net::TestWithScopedTaskEnvironment,
@@ -279,6 +303,61 @@ TEST_F(SimpleIndexTest, IndexSizeCorrectOnMerge) {
   EXPECT_EQ((2u + 3u + 4u + 11u) * kSizeResolution, index()->cache_size_);
 }
 
+// An index loaded from a table only keeps the changes to it in memory, and
+// writes them out along with the table.
+TEST_F(SimpleIndexTest, TableOverlay) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath table_path = temp_dir.GetPath().AppendASCII("index");
+  SimpleIndex::EntrySet table_entries;
+  SimpleIndex::InsertInEntrySet(
+      hashes_.at<1>(), EntryMetadata(kTestLastUsedTime, 1000u), &table_entries);
+  SimpleIndex::InsertInEntrySet(
+      hashes_.at<2>(), EntryMetadata(kTestLastUsedTime, 2000u), &table_entries);
+  SimpleIndex::InsertInEntrySet(
+      hashes_.at<3>(), EntryMetadata(kTestLastUsedTime, 3000u), &table_entries);
+  ASSERT_TRUE(SimpleIndexTable::Write(
+      table_path, SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, base::Time(),
+      nullptr, std::unordered_set<uint64_t>(), table_entries));
+  scoped_refptr<SimpleIndexTable> table = SimpleIndexTable::Open(
+      base::File(table_path, base::File::FLAG_OPEN | base::File::FLAG_READ));
+  ASSERT_TRUE(table);
+
+  index()->Remove(hashes_.at<2>());
+  index()->Insert(hashes_.at<4>());
+  index_file_->load_result()->table = table;
+  ReturnIndexFile();
+
+  EXPECT_EQ(3, index()->GetEntryCount());
+  EXPECT_TRUE(index()->Has(hashes_.at<1>()));
+  EXPECT_FALSE(index()->Has(hashes_.at<2>()));
+  EXPECT_TRUE(index()->Has(hashes_.at<3>()));
+  EXPECT_TRUE(index()->Has(hashes_.at<4>()));
+  EXPECT_EQ(RoundSize(1000u) + RoundSize(3000u), index()->GetCacheSize());
+
+  EntryMetadata metadata;
+  EXPECT_FALSE(GetEntryForTesting(hashes_.at<1>(), &metadata));
+  EXPECT_TRUE(index()->UpdateEntrySize(hashes_.at<1>(), 500u));
+  ASSERT_TRUE(GetEntryForTesting(hashes_.at<1>(), &metadata));
+  EXPECT_EQ(RoundSize(500u), metadata.GetEntrySize());
+  EXPECT_EQ(RoundSize(500u) + RoundSize(3000u), index()->GetCacheSize());
+
+  index()->Remove(hashes_.at<3>());
+  EXPECT_EQ(2, index()->GetEntryCount());
+  EXPECT_EQ(2u, index()->GetAllHashes()->size());
+  EXPECT_EQ(RoundSize(500u), index()->GetCacheSize());
+
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN);
+  EXPECT_EQ(1, index_file()->disk_writes());
+  EXPECT_EQ(table.get(), index_file()->disk_write_table());
+  EXPECT_EQ(3u, index_file()->disk_write_removed_hashes().size());
+  SimpleIndex::EntrySet written_entries;
+  index_file_->GetAndResetDiskWriteEntrySet(&written_entries);
+  EXPECT_EQ(2u, written_entries.size());
+  EXPECT_EQ(1u, written_entries.count(hashes_.at<1>()));
+  EXPECT_EQ(1u, written_entries.count(hashes_.at<4>()));
+}
+
 // State of index changes as expected with an insert and a remove.
 TEST_F(SimpleIndexTest, BasicInsertRemove) {
   // Confirm blank state.
@@ -778,7 +778,7 @@ int SimpleSynchronousEntry::CheckEOFRecord(base::File* file,
   SimpleFileEOF eof_record;
   int file_offset = entry_stat.GetEOFOffsetInFile(key_.size(), stream_index);
   int file_index = GetFileIndexFromStreamIndex(stream_index);
-  int rv = GetEOFRecordData(file, base::StringPiece(), file_index, file_offset,
+  int rv = GetEOFRecordData(file, PrefetchedRange(), file_index, file_offset,
                             &eof_record);
 
   if (rv != net::OK) {
@@ -798,7 +798,7 @@ int SimpleSynchronousEntry::CheckEOFRecord(base::File* file,
 
 int SimpleSynchronousEntry::PreReadStreamPayload(
     base::File* file,
-    base::StringPiece file_0_prefetch,
+    const PrefetchedRange& file_0_prefetch,
     int stream_index,
     int extra_size,
     const SimpleEntryStat& entry_stat,
@@ -850,33 +850,13 @@ void SimpleSynchronousEntry::Close(
       break;
     }
 
-    if (stream_index == 0) {
-      // Write stream 0 data.
-      int stream_0_offset = entry_stat.GetOffsetInFile(key_.size(), 0, 0);
-      if (file->Write(stream_0_offset, stream_0_data->data(),
-                      entry_stat.data_size(0)) != entry_stat.data_size(0)) {
-        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-        DVLOG(1) << "Could not write stream 0 data.";
-        Doom();
-      }
-      net::SHA256HashValue hash_value;
-      CalculateSHA256OfKey(key_, &hash_value);
-      if (file->Write(stream_0_offset + entry_stat.data_size(0),
-                      reinterpret_cast<char*>(hash_value.data),
-                      sizeof(hash_value)) != sizeof(hash_value)) {
-        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-        DVLOG(1) << "Could not write stream 0 data.";
-        Doom();
-      }
-
-      // Re-compute stream 0 CRC if the data got changed (we may be here even
-      // if it didn't change if stream 0's position on disk got changed due to
-      // stream 1 write).
-      if (!it->has_crc32) {
-        it->data_crc32 =
-            simple_util::Crc32(stream_0_data->data(), entry_stat.data_size(0));
-        it->has_crc32 = true;
-      }
+    // Re-compute stream 0 CRC if the data got changed (we may be here even if
+    // it didn't change if stream 0's position on disk got changed due to
+    // stream 1 write).
+    if (stream_index == 0 && !it->has_crc32) {
+      it->data_crc32 =
+          simple_util::Crc32(stream_0_data->data(), entry_stat.data_size(0));
+      it->has_crc32 = true;
     }
 
     SimpleFileEOF eof_record;
@@ -898,6 +878,30 @@ void SimpleSynchronousEntry::Close(
       Doom();
       break;
     }
+
+    if (stream_index == 0) {
+      // Stream 0 data, the key SHA256 and the EOF record are contiguous at the
+      // end of the file, so they are written together.
+      int stream_0_offset = entry_stat.GetOffsetInFile(key_.size(), 0, 0);
+      net::SHA256HashValue hash_value;
+      CalculateSHA256OfKey(key_, &hash_value);
+      DCHECK_EQ(eof_offset, stream_0_offset + entry_stat.data_size(0) +
+                                static_cast<int>(sizeof(hash_value)));
+      const base::StringPiece buffers[] = {
+          base::StringPiece(stream_0_data->data(), entry_stat.data_size(0)),
+          base::StringPiece(reinterpret_cast<const char*>(hash_value.data),
+                            sizeof(hash_value)),
+          base::StringPiece(reinterpret_cast<const char*>(&eof_record),
+                            sizeof(eof_record))};
+      if (!simple_util::WriteGathered(file.get(), stream_0_offset, buffers,
+                                      arraysize(buffers))) {
+        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
+        DVLOG(1) << "Could not write stream 0 data.";
+        Doom();
+        break;
+      }
+      continue;
+    }
     if (file->Write(eof_offset, reinterpret_cast<const char*>(&eof_record),
                     sizeof(eof_record)) != sizeof(eof_record)) {
       RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
@@ -1386,18 +1390,28 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
 
   // If the file is sufficiently small, we will prefetch everything --
   // in which case |prefetch_buf| will be non-null, and we should look at it
-  // rather than call ::Read for the bits.
+  // rather than call ::Read for the bits. Otherwise its end is read in one
+  // go, which saves a read when stream 0 is small.
   std::unique_ptr<char[]> prefetch_buf;
-  base::StringPiece file_0_prefetch;
+  std::unique_ptr<char[]> tail_buf;
+  PrefetchedRange file_0_prefetch;
 
   if (file_size > GetSimpleCachePrefetchSize()) {
     RecordWhetherOpenDidPrefetch(cache_type_, false);
+    const int tail_size = std::min(file_size, kTailPrefetchSize);
+    tail_buf = std::make_unique<char[]>(tail_size);
+    if (file->Read(file_size - tail_size, tail_buf.get(), tail_size) !=
+        tail_size) {
+      return net::ERR_FAILED;
+    }
+    file_0_prefetch.offset = file_size - tail_size;
+    file_0_prefetch.data.set(tail_buf.get(), tail_size);
   } else {
     RecordWhetherOpenDidPrefetch(cache_type_, true);
     prefetch_buf = std::make_unique<char[]>(file_size);
     if (file->Read(0, prefetch_buf.get(), file_size) != file_size)
       return net::ERR_FAILED;
-    file_0_prefetch.set(prefetch_buf.get(), file_size);
+    file_0_prefetch.data.set(prefetch_buf.get(), file_size);
   }
 
   // Read stream 0 footer first --- it has size/feature info required to figure
@@ -1485,41 +1499,42 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
 
 bool SimpleSynchronousEntry::ReadFromFileOrPrefetched(
     base::File* file,
-    base::StringPiece file_0_prefetch,
+    const PrefetchedRange& file_0_prefetch,
     int file_index,
     int offset,
     int size,
     char* dest) {
-  if (file_0_prefetch.empty() || file_index != 0) {
+  if (offset < 0 || size < 0)
+    return false;
+  if (size == 0)
+    return true;
+  if (file_0_prefetch.data.empty() || file_index != 0)
     return file->Read(offset, dest, size) == size;
-  } else {
-    if (offset < 0 || size < 0)
-      return false;
-    if (size == 0)
-      return true;
 
-    base::CheckedNumeric<size_t> start(offset);
-    size_t start_numeric;
-    if (!start.AssignIfValid(&start_numeric) ||
-        start_numeric >= file_0_prefetch.size())
-      return false;
-
-    base::CheckedNumeric<size_t> end = start + size - 1;
-    size_t end_numeric;
-    if (!end.AssignIfValid(&end_numeric) ||
-        end_numeric >= file_0_prefetch.size())
-      return false;
-
-    memcpy(dest, file_0_prefetch.data() + offset, size);
-    return true;
+  // Reads outside of the prefetched range go to the file, where they fail if
+  // they are beyond its end.
+  base::CheckedNumeric<int> start_in_prefetch(offset);
+  start_in_prefetch -= file_0_prefetch.offset;
+  base::CheckedNumeric<size_t> end_in_prefetch = start_in_prefetch;
+  end_in_prefetch += size;
+  int start_numeric;
+  size_t end_numeric;
+  if (!start_in_prefetch.AssignIfValid(&start_numeric) || start_numeric < 0 ||
+      !end_in_prefetch.AssignIfValid(&end_numeric) ||
+      end_numeric > file_0_prefetch.data.size()) {
+    return file->Read(offset, dest, size) == size;
   }
+
+  memcpy(dest, file_0_prefetch.data.data() + start_numeric, size);
+  return true;
 }
 
-int SimpleSynchronousEntry::GetEOFRecordData(base::File* file,
-                                             base::StringPiece file_0_prefetch,
-                                             int file_index,
-                                             int file_offset,
-                                             SimpleFileEOF* eof_record) {
+int SimpleSynchronousEntry::GetEOFRecordData(
+    base::File* file,
+    const PrefetchedRange& file_0_prefetch,
+    int file_index,
+    int file_offset,
+    SimpleFileEOF* eof_record) {
   if (!ReadFromFileOrPrefetched(file, file_0_prefetch, file_index, file_offset,
                                 sizeof(SimpleFileEOF),
                                 reinterpret_cast<char*>(eof_record))) {
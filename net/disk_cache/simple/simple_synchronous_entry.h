@@ -299,11 +299,22 @@ class SimpleSynchronousEntry {
     }
   };
 
+  // Contents of file 0 read ahead of time, starting at |offset| in the file.
+  struct PrefetchedRange {
+    int offset = 0;
+    base::StringPiece data;
+  };
+
   // When opening an entry without knowing the key, the header must be read
   // without knowing the size of the key. This is how much to read initially, to
   // make it likely the entire key is read.
   static const size_t kInitialHeaderRead = 64 * 1024;
 
+  // When file 0 isn't prefetched entirely, this much of its end is read at
+  // once on open, which usually covers stream 0 with its key SHA256 and EOF
+  // record.
+  static const int kTailPrefetchSize = 4 * 1024;
+
   NET_EXPORT_PRIVATE SimpleSynchronousEntry(
       net::CacheType cache_type,
       const base::FilePath& path,
@@ -364,15 +375,15 @@ class SimpleSynchronousEntry {
   // Puts the result into |*eof_record| and sanity-checks it.
   // Returns net status, and records any failures to UMA.
   int GetEOFRecordData(base::File* file,
-                       base::StringPiece file_0_prefetch,
+                       const PrefetchedRange& file_0_prefetch,
                        int file_index,
                        int file_offset,
                        SimpleFileEOF* eof_record);
 
-  // Reads either from |file_0_prefetch| or |file|.
-  // Range-checks all the in-memory reads.
+  // Reads from |file_0_prefetch| if it has the whole range, or else from
+  // |file|.
   bool ReadFromFileOrPrefetched(base::File* file,
-                                base::StringPiece file_0_prefetch,
+                                const PrefetchedRange& file_0_prefetch,
                                 int file_index,
                                 int offset,
                                 int size,
@@ -387,7 +398,7 @@ class SimpleSynchronousEntry {
   // and |*out_crc32| will get the checksum, which will be verified against
   // |eof_record|.
   int PreReadStreamPayload(base::File* file,
-                           base::StringPiece file_0_prefetch,
+                           const PrefetchedRange& file_0_prefetch,
                            int stream_index,
                            int extra_size,
                            const SimpleEntryStat& entry_stat,
@@ -14,6 +14,7 @@
 #include "net/disk_cache/simple/simple_file_tracker.h"
 
 namespace base {
+class File;
 class FilePath;
 class Time;
 }
@@ -85,6 +86,14 @@ NET_EXPORT_PRIVATE bool GetMTime(const base::FilePath& path,
 // is possible to immediately create a new file with the same name.
 NET_EXPORT_PRIVATE bool SimpleCacheDeleteFile(const base::FilePath& path);
 
+// Writes the |buffer_count| |buffers| one after the other at |offset| in
+// |file|, with a single vectored write where the platform has one. Returns
+// whether everything was written.
+NET_EXPORT_PRIVATE bool WriteGathered(base::File* file,
+                                      int64_t offset,
+                                      const base::StringPiece* buffers,
+                                      size_t buffer_count);
+
 uint32_t Crc32(const char* data, int length);
 
 uint32_t IncrementalCrc32(uint32_t previous_crc, const char* data, int length);
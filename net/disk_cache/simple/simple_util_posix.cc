@@ -4,7 +4,15 @@
 
 #include "net/disk_cache/simple/simple_util.h"
 
+#include <sys/uio.h>
+
+#include <vector>
+
+#include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/threading/thread_restrictions.h"
+#include "build/build_config.h"
 
 namespace disk_cache {
 namespace simple_util {
@@ -13,5 +21,56 @@ bool SimpleCacheDeleteFile(const base::FilePath& path) {
   return base::DeleteFile(path, false);
 }
 
+bool WriteGathered(base::File* file,
+                   int64_t offset,
+                   const base::StringPiece* buffers,
+                   size_t buffer_count) {
+#if defined(OS_LINUX)
+  base::AssertBlockingAllowed();
+  std::vector<struct iovec> iovecs;
+  for (size_t i = 0; i < buffer_count; ++i) {
+    if (buffers[i].empty())
+      continue;
+    struct iovec iov;
+    iov.iov_base = const_cast<char*>(buffers[i].data());
+    iov.iov_len = buffers[i].size();
+    iovecs.push_back(iov);
+  }
+
+  // pwritev() may write less than asked, the rest is then written by further
+  // calls.
+  size_t first_iovec = 0;
+  while (first_iovec < iovecs.size()) {
+    ssize_t bytes_written = HANDLE_EINTR(
+        pwritev(file->GetPlatformFile(), &iovecs[first_iovec],
+                iovecs.size() - first_iovec, offset));
+    if (bytes_written <= 0)
+      return false;
+    offset += bytes_written;
+    size_t remaining = static_cast<size_t>(bytes_written);
+    while (first_iovec < iovecs.size() &&
+           remaining >= iovecs[first_iovec].iov_len) {
+      remaining -= iovecs[first_iovec].iov_len;
+      ++first_iovec;
+    }
+    if (remaining) {
+      iovecs[first_iovec].iov_base =
+          static_cast<char*>(iovecs[first_iovec].iov_base) + remaining;
+      iovecs[first_iovec].iov_len -= remaining;
+    }
+  }
+  return true;
+#else
+  // pwritev() isn't available on all the supported Mac and Android versions.
+  for (size_t i = 0; i < buffer_count; ++i) {
+    const int size = static_cast<int>(buffers[i].size());
+    if (file->Write(offset, buffers[i].data(), size) != size)
+      return false;
+    offset += size;
+  }
+  return true;
+#endif
+}
+
 }  // namespace simple_util
 }  // namespace disk_cache
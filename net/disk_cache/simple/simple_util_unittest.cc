@@ -5,7 +5,11 @@
 #include <stdint.h>
 #include <string>
 
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/logging.h"
+#include "base/macros.h"
 #include "net/disk_cache/simple/simple_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -15,6 +19,7 @@ using disk_cache::simple_util::GetEntryHashKeyFromHexString;
 using disk_cache::simple_util::GetEntryHashKey;
 using disk_cache::simple_util::GetFileSizeFromDataSize;
 using disk_cache::simple_util::GetDataSizeFromFileSize;
+using disk_cache::simple_util::WriteGathered;
 
 class SimpleUtilTest : public testing::Test {};
 
@@ -76,3 +81,22 @@ TEST_F(SimpleUtilTest, SizesAndOffsets) {
   const int file_size = GetFileSizeFromDataSize(key.size(), data_size);
   EXPECT_EQ(data_size, GetDataSizeFromFileSize(key.size(), file_size));
 }
+
+TEST_F(SimpleUtilTest, WriteGathered) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("file");
+  base::File file(path, base::File::FLAG_CREATE | base::File::FLAG_READ |
+                            base::File::FLAG_WRITE);
+  ASSERT_TRUE(file.IsValid());
+  ASSERT_EQ(3, file.Write(0, "abc", 3));
+
+  const std::string large(100000, 'x');
+  const base::StringPiece buffers[] = {"12", "", large, "345"};
+  EXPECT_TRUE(WriteGathered(&file, 2, buffers, arraysize(buffers)));
+  file.Close();
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  EXPECT_EQ("ab12" + large + "345", contents);
+}
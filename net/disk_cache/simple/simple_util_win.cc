@@ -6,6 +6,7 @@
 
 #include <windows.h>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/format_macros.h"
 #include "base/rand_util.h"
@@ -40,5 +41,18 @@ bool SimpleCacheDeleteFile(const base::FilePath& path) {
   return DeleteCacheFile(path);
 }
 
+bool WriteGathered(base::File* file,
+                   int64_t offset,
+                   const base::StringPiece* buffers,
+                   size_t buffer_count) {
+  for (size_t i = 0; i < buffer_count; ++i) {
+    const int size = static_cast<int>(buffers[i].size());
+    if (file->Write(offset, buffers[i].data(), size) != size)
+      return false;
+    offset += size;
+  }
+  return true;
+}
+
 }  // namespace simple_util
 }  // namespace disk_cache
@@ -94,6 +94,7 @@ class TestUDPClientSocket : public DatagramClientSocket {
   bool WriteAsyncEnabled() override { return false; }
   void SetWriteMultiCoreEnabled(bool enabled) override {}
   void SetSendmmsgEnabled(bool enabled) override {}
+  void SetGsoEnabled(bool enabled) override {}
   void SetWriteBatchingActive(bool active) override {}
 
   int ConnectUsingNetwork(NetworkChangeNotifier::NetworkHandle network,
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "base/hash.h"
 #include "base/logging.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram_macros.h"
@@ -83,6 +84,15 @@ enum HostCache::EraseReason : int {
   MAX_ERASE_REASON
 };
 
+size_t HostCache::KeyHash::operator()(const Key& key) const {
+  const size_t hostname_hash = std::hash<std::string>()(key.hostname);
+  const int family_and_source = (static_cast<int>(key.address_family) << 8) |
+                                static_cast<int>(key.host_resolver_source);
+  return base::HashInts(
+      base::HashInts(hostname_hash, key.host_resolver_flags),
+      family_and_source);
+}
+
 HostCache::Entry::Entry(int error,
                         const AddressList& addresses,
                         Source source,
@@ -153,6 +163,7 @@ void HostCache::Entry::GetStaleness(base::TimeTicks now,
 
 HostCache::HostCache(size_t max_entries)
     : max_entries_(max_entries),
+      use_counter_(0),
       network_changes_(0),
       restore_size_(0),
       delegate_(nullptr),
@@ -207,9 +218,42 @@ const HostCache::Entry* HostCache::LookupStale(
   return entry;
 }
 
+const HostCache::Entry* HostCache::LookupStaleWhileRevalidate(
+    const Key& key,
+    base::TimeTicks now,
+    base::TimeDelta max_expired_by,
+    HostCache::EntryStaleness* stale_out) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK(stale_out);
+  if (caching_is_disabled())
+    return nullptr;
+
+  HostCache::Entry* entry = LookupInternal(key);
+  if (!entry) {
+    RecordLookup(LOOKUP_MISS_ABSENT, now, nullptr);
+    return nullptr;
+  }
+
+  if (entry->network_changes() != network_changes_ ||
+      now - entry->expires() > max_expired_by) {
+    RecordLookup(LOOKUP_MISS_STALE, now, entry);
+    return nullptr;
+  }
+
+  bool is_stale = entry->IsStale(now, network_changes_);
+  entry->CountHit(/* hit_is_stale= */ is_stale);
+  RecordLookup(is_stale ? LOOKUP_HIT_STALE : LOOKUP_HIT_VALID, now, entry);
+
+  entry->GetStaleness(now, network_changes_, stale_out);
+  return entry;
+}
+
 HostCache::Entry* HostCache::LookupInternal(const Key& key) {
   auto it = entries_.find(key);
-  return (it != entries_.end()) ? &it->second : nullptr;
+  if (it == entries_.end())
+    return nullptr;
+  it->second.last_use_ = ++use_counter_;
+  return &it->second;
 }
 
 void HostCache::Set(const Key& key,
@@ -250,8 +294,9 @@ void HostCache::Set(const Key& key,
 
 void HostCache::AddEntry(const Key& key, Entry&& entry) {
   DCHECK_GT(max_entries_, size());
-  DCHECK_EQ(0u, entries_.count(key));
-  entries_.emplace(key, std::move(entry));
+  entry.last_use_ = ++use_counter_;
+  bool inserted = entries_.emplace(key, std::move(entry)).second;
+  DCHECK(inserted);
   DCHECK_GE(max_entries_, size());
 }
 
@@ -291,15 +336,13 @@ void HostCache::ClearForHosts(
   bool changed = false;
   base::TimeTicks now = tick_clock_->NowTicks();
   for (EntryMap::iterator it = entries_.begin(); it != entries_.end();) {
-    EntryMap::iterator next_it = std::next(it);
-
     if (host_filter.Run(it->first.hostname)) {
       RecordErase(ERASE_CLEAR, now, it->second);
-      entries_.erase(it);
+      it = entries_.erase(it);
       changed = true;
+    } else {
+      ++it;
     }
-
-    it = next_it;
   }
 
   if (delegate_ && changed)
@@ -436,13 +479,9 @@ void HostCache::EvictOneEntry(base::TimeTicks now) {
 
   auto oldest_it = entries_.begin();
   for (auto it = entries_.begin(); it != entries_.end(); ++it) {
-    if ((it->second.expires() < oldest_it->second.expires()) &&
-        (it->second.IsStale(now, network_changes_) ||
-         !oldest_it->second.IsStale(now, network_changes_))) {
+    if (it->second.last_use_ < oldest_it->second.last_use_)
       oldest_it = it;
-    }
   }
-
   RecordErase(ERASE_EVICT, now, oldest_it->second);
   entries_.erase(oldest_it);
 }
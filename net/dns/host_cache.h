@@ -6,13 +6,14 @@
 #define NET_DNS_HOST_CACHE_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <functional>
-#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
 
+#include "base/containers/flat_hash_map.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/threading/thread_checker.h"
@@ -60,12 +61,23 @@ class NET_EXPORT HostCache {
                       other.hostname, other.host_resolver_source);
     }
 
+    bool operator==(const Key& other) const {
+      return std::tie(address_family, host_resolver_flags, hostname,
+                      host_resolver_source) ==
+             std::tie(other.address_family, other.host_resolver_flags,
+                      other.hostname, other.host_resolver_source);
+    }
+
     std::string hostname;
     AddressFamily address_family;
     HostResolverFlags host_resolver_flags;
     HostResolverSource host_resolver_source;
   };
 
+  struct NET_EXPORT KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
   struct NET_EXPORT EntryStaleness {
     // Time since the entry's TTL has expired. Negative if not expired.
     base::TimeDelta expired_by;
@@ -112,6 +124,9 @@ class NET_EXPORT HostCache {
 
     // Public for the net-internals UI.
     int network_changes() const { return network_changes_; }
+    // Public for HostResolverImpl, which refreshes the entries that get the
+    // most hits before they expire.
+    int total_hits() const { return total_hits_; }
 
    private:
     friend class HostCache;
@@ -127,7 +142,6 @@ class NET_EXPORT HostCache {
           base::TimeTicks expires,
           int network_changes);
 
-    int total_hits() const { return total_hits_; }
     int stale_hits() const { return stale_hits_; }
 
     bool IsStale(base::TimeTicks now, int network_changes) const;
@@ -151,6 +165,9 @@ class NET_EXPORT HostCache {
     int network_changes_;
     int total_hits_;
     int stale_hits_;
+    // Value of the cache's use counter when the entry was last set or looked
+    // up. The entry with the lowest one is evicted first.
+    uint64_t last_use_ = 0;
   };
 
   // Interface for interacting with persistent storage, to be provided by the
@@ -162,7 +179,9 @@ class NET_EXPORT HostCache {
     virtual void ScheduleWrite() = 0;
   };
 
-  using EntryMap = std::map<Key, Entry>;
+  // Lookups happen for every resolution, so entries are kept in a hash table.
+  // Iteration order is unspecified.
+  using EntryMap = base::flat_hash_map<Key, Entry, KeyHash>;
 
   // Constructs a HostCache that stores up to |max_entries|.
   explicit HostCache(size_t max_entries);
@@ -180,6 +199,16 @@ class NET_EXPORT HostCache {
                            base::TimeTicks now,
                            EntryStaleness* stale_out);
 
+  // Returns a pointer to the entry for |key| if it is valid at time |now|, or
+  // if it expired at most |max_expired_by| ago and there was no network change
+  // since it was set, so that it can be used while it is being refreshed.
+  // Fills in |stale_out| with information about how stale it is. Otherwise
+  // returns NULL.
+  const Entry* LookupStaleWhileRevalidate(const Key& key,
+                                          base::TimeTicks now,
+                                          base::TimeDelta max_expired_by,
+                                          EntryStaleness* stale_out);
+
   // Overwrites or creates an entry for |key|.
   // |entry| is the value to set, |now| is the current time
   // |ttl| is the "time to live".
@@ -245,6 +274,7 @@ class NET_EXPORT HostCache {
   enum LookupOutcome : int;
   enum EraseReason : int;
 
+  // Returns the entry for |key|, marking it as the most recently used one.
   Entry* LookupInternal(const Key& key);
 
   void RecordSet(SetOutcome outcome,
@@ -263,6 +293,8 @@ class NET_EXPORT HostCache {
   // Returns true if this HostCache can contain no entries.
   bool caching_is_disabled() const { return max_entries_ == 0; }
 
+  // Evicts the least recently used entry. Only happens when inserting into a
+  // full cache, so a scan of the entries is fine.
   void EvictOneEntry(base::TimeTicks now);
   // Helper to insert an Entry into the cache.
   void AddEntry(const Key& key, Entry&& entry);
@@ -271,6 +303,8 @@ class NET_EXPORT HostCache {
   // a resolved result entry.
   EntryMap entries_;
   size_t max_entries_;
+  // Incremented on every lookup hit and insertion, to order entries by use.
+  uint64_t use_counter_;
   int network_changes_;
   // Number of cache entries that were restored in the last call to
   // RestoreFromListValue(). Used in histograms.
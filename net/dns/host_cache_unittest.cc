@@ -358,8 +358,8 @@ TEST(HostCacheTest, ClearForHosts) {
   EXPECT_EQ(0u, cache.size());
 }
 
-// Try to add too many entries to cache; it should evict the one with the oldest
-// expiration time.
+// Try to add too many entries to cache; it should evict the least recently
+// used one.
 TEST(HostCacheTest, Evict) {
   HostCache cache(2);
 
@@ -376,15 +376,15 @@ TEST(HostCacheTest, Evict) {
   EXPECT_FALSE(cache.Lookup(key2, now));
   EXPECT_FALSE(cache.Lookup(key3, now));
 
-  // |key1| expires in 10 seconds, but |key2| in just 5.
-  cache.Set(key1, entry, now, base::TimeDelta::FromSeconds(10));
-  cache.Set(key2, entry, now, base::TimeDelta::FromSeconds(5));
+  // |key1| expires in 5 seconds, but |key2| in 10.
+  cache.Set(key1, entry, now, base::TimeDelta::FromSeconds(5));
+  cache.Set(key2, entry, now, base::TimeDelta::FromSeconds(10));
   EXPECT_EQ(2u, cache.size());
-  EXPECT_TRUE(cache.Lookup(key1, now));
   EXPECT_TRUE(cache.Lookup(key2, now));
+  EXPECT_TRUE(cache.Lookup(key1, now));
   EXPECT_FALSE(cache.Lookup(key3, now));
 
-  // |key2| should be chosen for eviction, since it expires sooner.
+  // |key2| should be chosen for eviction, since it was used least recently.
   cache.Set(key3, entry, now, base::TimeDelta::FromSeconds(10));
   EXPECT_EQ(2u, cache.size());
   EXPECT_TRUE(cache.Lookup(key1, now));
@@ -459,7 +459,9 @@ TEST(HostCacheTest, Stale) {
   EXPECT_EQ(3, stale.stale_hits);
 }
 
-TEST(HostCacheTest, EvictStale) {
+// Updating an entry, or looking it up while it is stale, makes it the most
+// recently used one.
+TEST(HostCacheTest, EvictAfterUpdate) {
   HostCache cache(2);
 
   base::TimeTicks now;
@@ -471,56 +473,73 @@ TEST(HostCacheTest, EvictStale) {
   HostCache::Entry entry =
       HostCache::Entry(OK, AddressList(), HostCache::Entry::SOURCE_UNKNOWN);
 
-  EXPECT_EQ(0u, cache.size());
-  EXPECT_FALSE(cache.Lookup(key1, now));
-  EXPECT_FALSE(cache.Lookup(key2, now));
-  EXPECT_FALSE(cache.Lookup(key3, now));
-
-  // |key1| expires in 10 seconds.
   cache.Set(key1, entry, now, base::TimeDelta::FromSeconds(10));
-  EXPECT_EQ(1u, cache.size());
-  EXPECT_TRUE(cache.Lookup(key1, now));
-  EXPECT_FALSE(cache.Lookup(key2, now));
-  EXPECT_FALSE(cache.Lookup(key3, now));
+  cache.Set(key2, entry, now, base::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(2u, cache.size());
 
-  // Simulate network change, expiring the cache.
-  cache.OnNetworkChange();
+  // Update |key1|, so that |key2| is evicted.
+  cache.Set(key1, entry, now, base::TimeDelta::FromSeconds(10));
+  cache.Set(key3, entry, now, base::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_FALSE(cache.LookupStale(key2, now, &stale));
 
-  EXPECT_EQ(1u, cache.size());
-  EXPECT_FALSE(cache.Lookup(key1, now));
+  // Advance to t=20, expiring both entries, and look up |key1| again, so that
+  // |key3| is evicted.
+  now += base::TimeDelta::FromSeconds(20);
   EXPECT_TRUE(cache.LookupStale(key1, now, &stale));
-  EXPECT_EQ(1, stale.network_changes);
-
-  // Advance to t=1.
-  now += base::TimeDelta::FromSeconds(1);
-
-  // |key2| expires before |key1| would originally have expired.
-  cache.Set(key2, entry, now, base::TimeDelta::FromSeconds(5));
+  EXPECT_TRUE(stale.is_stale());
+  cache.Set(key2, entry, now, base::TimeDelta::FromSeconds(10));
   EXPECT_EQ(2u, cache.size());
-  EXPECT_FALSE(cache.Lookup(key1, now));
   EXPECT_TRUE(cache.LookupStale(key1, now, &stale));
   EXPECT_TRUE(cache.Lookup(key2, now));
-  EXPECT_FALSE(cache.Lookup(key3, now));
+  EXPECT_FALSE(cache.LookupStale(key3, now, &stale));
+}
 
-  // |key1| should be chosen for eviction, since it is stale.
-  cache.Set(key3, entry, now, base::TimeDelta::FromSeconds(1));
-  EXPECT_EQ(2u, cache.size());
-  EXPECT_FALSE(cache.Lookup(key1, now));
-  EXPECT_FALSE(cache.LookupStale(key1, now, &stale));
-  EXPECT_TRUE(cache.Lookup(key2, now));
-  EXPECT_TRUE(cache.Lookup(key3, now));
+// Stale entries can be revalidated for a while after they expire, but not
+// after a network change.
+TEST(HostCacheTest, LookupStaleWhileRevalidate) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  const base::TimeDelta kMaxExpiredBy = base::TimeDelta::FromSeconds(5);
 
-  // Advance to t=6.
-  now += base::TimeDelta::FromSeconds(5);
+  HostCache cache(kMaxCacheEntries);
 
-  // Insert |key1| again. |key3| should be evicted.
-  cache.Set(key1, entry, now, base::TimeDelta::FromSeconds(10));
-  EXPECT_EQ(2u, cache.size());
-  EXPECT_TRUE(cache.Lookup(key1, now));
-  EXPECT_FALSE(cache.Lookup(key2, now));
-  EXPECT_TRUE(cache.LookupStale(key2, now, &stale));
-  EXPECT_FALSE(cache.Lookup(key3, now));
-  EXPECT_FALSE(cache.LookupStale(key3, now, &stale));
+  base::TimeTicks now;
+  HostCache::EntryStaleness stale;
+
+  HostCache::Key key = Key("foobar.com");
+  HostCache::Entry entry =
+      HostCache::Entry(OK, AddressList(), HostCache::Entry::SOURCE_UNKNOWN);
+
+  EXPECT_FALSE(
+      cache.LookupStaleWhileRevalidate(key, now, kMaxExpiredBy, &stale));
+  cache.Set(key, entry, now, kTTL);
+
+  // Valid entries are returned.
+  EXPECT_TRUE(
+      cache.LookupStaleWhileRevalidate(key, now, kMaxExpiredBy, &stale));
+  EXPECT_FALSE(stale.is_stale());
+
+  // Advance to t=13, past the TTL but within |kMaxExpiredBy|.
+  now += base::TimeDelta::FromSeconds(13);
+  EXPECT_FALSE(cache.Lookup(key, now));
+  EXPECT_TRUE(
+      cache.LookupStaleWhileRevalidate(key, now, kMaxExpiredBy, &stale));
+  EXPECT_TRUE(stale.is_stale());
+  EXPECT_EQ(base::TimeDelta::FromSeconds(3), stale.expired_by);
+  EXPECT_EQ(1, stale.stale_hits);
+
+  // Advance to t=16, past |kMaxExpiredBy|.
+  now += base::TimeDelta::FromSeconds(3);
+  EXPECT_FALSE(
+      cache.LookupStaleWhileRevalidate(key, now, kMaxExpiredBy, &stale));
+  EXPECT_TRUE(cache.LookupStale(key, now, &stale));
+
+  // An entry from before a network change is never returned.
+  cache.Set(key, entry, now, kTTL);
+  cache.OnNetworkChange();
+  EXPECT_FALSE(
+      cache.LookupStaleWhileRevalidate(key, now, kMaxExpiredBy, &stale));
+  EXPECT_TRUE(cache.LookupStale(key, now, &stale));
 }
 
 // Tests the less than and equal operators for HostCache::Key work.
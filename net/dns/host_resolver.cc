@@ -26,6 +26,10 @@ namespace {
 // that limit this to 6, so we're temporarily holding it at that level.
 const size_t kDefaultMaxProcTasks = 6u;
 
+// Background refreshes only take the lowest priority, but they shouldn't delay
+// other IDLE requests too much.
+const size_t kDefaultMaxBackgroundRefreshes = 4u;
+
 }  // namespace
 
 PrioritizedDispatcher::Limits HostResolver::Options::GetDispatcherLimits()
@@ -87,7 +91,8 @@ PrioritizedDispatcher::Limits HostResolver::Options::GetDispatcherLimits()
 HostResolver::Options::Options()
     : max_concurrent_resolves(kDefaultParallelism),
       max_retry_attempts(kDefaultRetryAttempts),
-      enable_caching(true) {
+      enable_caching(true),
+      max_background_refreshes(kDefaultMaxBackgroundRefreshes) {
 }
 
 HostResolver::RequestInfo::RequestInfo(const HostPortPair& host_port_pair)
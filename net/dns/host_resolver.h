@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "base/optional.h"
+#include "base/time/time.h"
 #include "net/base/address_family.h"
 #include "net/base/completion_once_callback.h"
 #include "net/base/host_port_pair.h"
@@ -103,6 +104,12 @@ class NET_EXPORT HostResolver {
   // resolution. Pass HostResolver::kDefaultRetryAttempts to choose a default
   // value.
   // |enable_caching| controls whether a HostCache is used.
+  // |stale_while_revalidate|, if positive, is how long after they expire cache
+  // entries are still returned, while they are refreshed in the background.
+  // |refresh_before_expiry|, if positive, is how long before they expire the
+  // cache entries that got many hits are refreshed in the background.
+  // |max_background_refreshes| is how many of these refreshes can be in
+  // flight at once.
   struct NET_EXPORT Options {
     Options();
 
@@ -111,6 +118,9 @@ class NET_EXPORT HostResolver {
     size_t max_concurrent_resolves;
     size_t max_retry_attempts;
     bool enable_caching;
+    base::TimeDelta stale_while_revalidate;
+    base::TimeDelta refresh_before_expiry;
+    size_t max_background_refreshes;
   };
 
   // The parameters for doing a Resolve(). A hostname and port are
@@ -106,6 +106,9 @@ const unsigned kNegativeCacheEntryTTLSeconds = 0;
 // Minimum TTL for successful resolutions with DnsTask.
 const unsigned kMinimumTTLSeconds = kCacheEntryTTLSeconds;
 
+// Minimum number of hits for a cache entry to be refreshed before it expires.
+const int kMinHitsForRefreshBeforeExpiry = 3;
+
 // Time between IPv6 probes, i.e. for how long results of each IPv6 probe are
 // cached.
 const int kIPv6ProbePeriodMs = 1000;
@@ -1354,6 +1357,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
         priority_tracker_(priority),
         proc_task_runner_(std::move(proc_task_runner)),
         had_non_speculative_request_(false),
+        is_background_refresh_(false),
         num_occupied_job_slots_(0),
         dns_task_error_(OK),
         tick_clock_(tick_clock),
@@ -1438,6 +1442,14 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     UpdatePriority();
   }
 
+  // Makes this Job refresh the cache entry for its key: it keeps running, and
+  // caches its result, even if it has no active request.
+  void MarkAsBackgroundRefresh() {
+    DCHECK(!is_background_refresh_);
+    is_background_refresh_ = true;
+    ++resolver_->num_background_refreshes_;
+  }
+
   void ChangeRequestPriority(RequestImpl* req, RequestPriority priority) {
     DCHECK_EQ(key_.hostname, req->request_host().host());
 
@@ -1461,7 +1473,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
         base::Bind(&NetLogJobAttachCallback, request->source_net_log().source(),
                    priority()));
 
-    if (num_active_requests() > 0) {
+    if (num_active_requests() > 0 || is_background_refresh_) {
       UpdatePriority();
       request->RemoveFromList();
     } else {
@@ -1505,11 +1517,12 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Attempts to serve the job from HOSTS. Returns true if succeeded and
   // this Job was destroyed.
   bool ServeFromHosts() {
-    DCHECK_GT(num_active_requests(), 0u);
+    DCHECK(num_active_requests() > 0 || is_background_refresh_);
+    uint16_t port = 0;
+    if (!requests_.empty())
+      port = requests_.head()->value()->request_host().port();
     AddressList addr_list;
-    if (resolver_->ServeFromHosts(
-            key(), requests_.head()->value()->request_host().port(),
-            &addr_list)) {
+    if (resolver_->ServeFromHosts(key(), port, &addr_list)) {
       // This will destroy the Job.
       CompleteRequests(
           MakeCacheEntry(OK, addr_list, HostCache::Entry::SOURCE_HOSTS),
@@ -1890,6 +1903,8 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     // to spawn one. Consequently, if the job was owned by |jobs_|, the job
     // deletes itself when CompleteRequests is done.
     std::unique_ptr<Job> self_deleter = resolver_->RemoveJob(this);
+    if (is_background_refresh_)
+      --resolver_->num_background_refreshes_;
 
     if (is_running()) {
       proc_task_ = nullptr;
@@ -1902,7 +1917,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
       handle_.Reset();
     }
 
-    if (num_active_requests() == 0) {
+    if (num_active_requests() == 0 && !is_background_refresh_) {
       net_log_.AddEvent(NetLogEventType::CANCELLED);
       net_log_.EndEventWithNetErrorCode(NetLogEventType::HOST_RESOLVER_IMPL_JOB,
                                         OK);
@@ -1912,8 +1927,6 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     net_log_.EndEventWithNetErrorCode(NetLogEventType::HOST_RESOLVER_IMPL_JOB,
                                       entry.error());
 
-    DCHECK(!requests_.empty());
-
     if (entry.error() == OK || entry.error() == ERR_ICANN_NAME_COLLISION) {
       // Record this histogram here, when we know the system has a valid DNS
       // configuration.
@@ -1923,7 +1936,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
 
     bool did_complete = (entry.error() != ERR_NETWORK_CHANGED) &&
                         (entry.error() != ERR_HOST_RESOLVER_QUEUE_TOO_LARGE);
-    if (did_complete)
+    // Nobody is waiting for a failed background refresh, so keep serving the
+    // stale entry rather than the error until it is too old.
+    if (did_complete && (entry.error() == OK || !requests_.empty()))
       resolver_->CacheResult(key_, entry, ttl);
 
     RecordJobHistograms(entry.error());
@@ -1987,6 +2002,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
 
   bool had_non_speculative_request_;
 
+  // Whether this Job was started to refresh the cache entry for |key_|.
+  bool is_background_refresh_;
+
   // Number of slots occupied by this Job in resolver's PrioritizedDispatcher.
   unsigned num_occupied_job_slots_;
 
@@ -2045,6 +2063,10 @@ HostResolverImpl::HostResolverImpl(const Options& options, NetLog* net_log)
       last_ipv6_probe_result_(true),
       additional_resolver_flags_(0),
       fallback_to_proctask_(true),
+      stale_while_revalidate_(options.stale_while_revalidate),
+      refresh_before_expiry_(options.refresh_before_expiry),
+      max_background_refreshes_(options.max_background_refreshes),
+      num_background_refreshes_(0),
       url_request_context_(nullptr),
       tick_clock_(base::DefaultTickClock::GetInstance()),
       weak_ptr_factory_(this),
@@ -2400,7 +2422,7 @@ int HostResolverImpl::ResolveLocally(const HostPortPair& host,
   }
 
   if (allow_cache && ServeFromCache(*key, host.port(), &net_error, addresses,
-                                    allow_stale, stale_info)) {
+                                    allow_stale, stale_info, source_net_log)) {
     source_net_log.AddEvent(NetLogEventType::HOST_RESOLVER_IMPL_CACHE_HIT,
                             addresses->CreateNetLogCallback());
     // |ServeFromCache()| will set |*stale_info| as needed.
@@ -2479,21 +2501,38 @@ bool HostResolverImpl::ServeFromCache(const Key& key,
                                       int* net_error,
                                       AddressList* addresses,
                                       bool allow_stale,
-                                      HostCache::EntryStaleness* stale_info) {
+                                      HostCache::EntryStaleness* stale_info,
+                                      const NetLogWithSource& source_net_log) {
   DCHECK(addresses);
   DCHECK(net_error);
   DCHECK(allow_stale == !!stale_info);
   if (!cache_.get())
     return false;
 
+  base::TimeTicks now = tick_clock_->NowTicks();
   const HostCache::Entry* cache_entry;
-  if (allow_stale)
-    cache_entry = cache_->LookupStale(key, tick_clock_->NowTicks(), stale_info);
-  else
-    cache_entry = cache_->Lookup(key, tick_clock_->NowTicks());
+  if (allow_stale) {
+    cache_entry = cache_->LookupStale(key, now, stale_info);
+  } else if (stale_while_revalidate_ > base::TimeDelta()) {
+    HostCache::EntryStaleness stale;
+    cache_entry = cache_->LookupStaleWhileRevalidate(
+        key, now, stale_while_revalidate_, &stale);
+  } else {
+    cache_entry = cache_->Lookup(key, now);
+  }
   if (!cache_entry)
     return false;
 
+  // Refresh the entries that are served while stale, and those that get many
+  // hits shortly before they expire, so that they don't miss later on.
+  if (!allow_stale &&
+      (cache_entry->expires() <= now ||
+       (refresh_before_expiry_ > base::TimeDelta() &&
+        cache_entry->expires() - now <= refresh_before_expiry_ &&
+        cache_entry->total_hits() >= kMinHitsForRefreshBeforeExpiry))) {
+    StartBackgroundRefresh(key, source_net_log);
+  }
+
   *net_error = cache_entry->error();
   if (*net_error == OK) {
     if (cache_entry->has_ttl())
@@ -2588,6 +2627,26 @@ void HostResolverImpl::CacheResult(const Key& key,
     cache_->Set(key, entry, tick_clock_->NowTicks(), ttl);
 }
 
+void HostResolverImpl::StartBackgroundRefresh(
+    const Key& key,
+    const NetLogWithSource& source_net_log) {
+  // Don't refresh an entry twice, and don't make room for refreshes by
+  // evicting queued jobs.
+  if (num_background_refreshes_ >= max_background_refreshes_ ||
+      jobs_.find(key) != jobs_.end() ||
+      dispatcher_->num_queued_jobs() >= max_queued_jobs_) {
+    return;
+  }
+
+  auto job = std::make_unique<Job>(weak_ptr_factory_.GetWeakPtr(), key, IDLE,
+                                   proc_task_runner_, source_net_log,
+                                   tick_clock_);
+  job->MarkAsBackgroundRefresh();
+  Job* job_ptr = job.get();
+  jobs_[key] = std::move(job);
+  job_ptr->Schedule(false);
+}
+
 std::unique_ptr<HostResolverImpl::Job> HostResolverImpl::RemoveJob(Job* job) {
   DCHECK(job);
   std::unique_ptr<Job> retval;
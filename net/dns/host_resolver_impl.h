@@ -262,13 +262,17 @@ class NET_EXPORT HostResolverImpl
   // entry's staleness (if an entry is returned).
   //
   // If |allow_stale| is false, then stale cache entries will not be returned,
-  // and |stale_info| must be null.
+  // and |stale_info| must be null, except for those that can be used while they
+  // are refreshed if |stale_while_revalidate_| is positive. A background
+  // refresh is then started for them, and for entries that are close to
+  // expiring, with |source_net_log|.
   bool ServeFromCache(const Key& key,
                       uint16_t host_port,
                       int* net_error,
                       AddressList* addresses,
                       bool allow_stale,
-                      HostCache::EntryStaleness* stale_info);
+                      HostCache::EntryStaleness* stale_info,
+                      const NetLogWithSource& source_net_log);
 
   // If we have a DnsClient with a valid DnsConfig, and |key| is found in the
   // HOSTS file, returns true and fills |addresses|. Otherwise returns false.
@@ -309,6 +313,11 @@ class NET_EXPORT HostResolverImpl
                    const HostCache::Entry& entry,
                    base::TimeDelta ttl);
 
+  // Starts a Job without request to refresh the cache entry for |key|, unless
+  // there already is a Job for it or too many refreshes are in flight.
+  void StartBackgroundRefresh(const Key& key,
+                              const NetLogWithSource& source_net_log);
+
   // Removes |job| from |jobs_| and return, only if it exists.
   std::unique_ptr<Job> RemoveJob(Job* job);
 
@@ -396,6 +405,14 @@ class NET_EXPORT HostResolverImpl
   // Allow fallback to ProcTask if DnsTask fails.
   bool fallback_to_proctask_;
 
+  // See HostResolver::Options.
+  const base::TimeDelta stale_while_revalidate_;
+  const base::TimeDelta refresh_before_expiry_;
+  const size_t max_background_refreshes_;
+
+  // Number of Jobs refreshing cache entries.
+  size_t num_background_refreshes_;
+
   // Task runner used for DNS lookups using the system resolver. Normally a
   // TaskScheduler task runner, but can be overridden for tests.
   scoped_refptr<base::TaskRunner> proc_task_runner_;
@@ -23,6 +23,7 @@
 #include "base/synchronization/condition_variable.h"
 #include "base/synchronization/lock.h"
 #include "base/test/bind_test_util.h"
+#include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_mock_time_task_runner.h"
 #include "base/test/test_timeouts.h"
 #include "base/threading/thread_restrictions.h"
@@ -2603,6 +2604,84 @@ TEST_F(HostResolverImplTest, ResolveStaleFromCacheError) {
 // TODO(mgersh): add a test case for errors with positive TTL after
 // https://crbug.com/115051 is fixed.
 
+// Entries that expired recently are served, and refreshed in the background.
+TEST_F(HostResolverImplTest, StaleWhileRevalidate) {
+  HostResolver::Options options = DefaultOptions();
+  options.stale_while_revalidate = base::TimeDelta::FromSeconds(30);
+  resolver_.reset(new TestHostResolverImpl(options, nullptr));
+  resolver_->set_proc_params_for_test(DefaultParams(proc_.get()));
+  base::SimpleTestTickClock clock;
+  resolver_->SetTickClockForTesting(&clock);
+
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(3u);
+
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(),
+              IsError(ERR_IO_PENDING));
+  EXPECT_THAT(requests_[0]->WaitForResult(), IsOk());
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+
+  // Results of the system resolver are cached for 60 seconds.
+  clock.Advance(base::TimeDelta::FromSeconds(70));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(), IsOk());
+  EXPECT_TRUE(requests_[1]->HasOneAddress("192.168.1.42", 80));
+
+  // The refreshed entry is served.
+  RunUntilIdle();
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(), IsOk());
+  EXPECT_TRUE(requests_[2]->HasOneAddress("192.168.1.43", 80));
+
+  // Entries that expired too long ago aren't served.
+  clock.Advance(base::TimeDelta::FromSeconds(100));
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(),
+              IsError(ERR_IO_PENDING));
+  EXPECT_THAT(requests_[3]->WaitForResult(), IsOk());
+  EXPECT_EQ(3u, proc_->GetCaptureList().size());
+
+  // Nor are entries from before a network change.
+  MakeCacheStale();
+  EXPECT_EQ(ERR_DNS_CACHE_MISS,
+            CreateRequest("just.testing", 80)->ResolveFromCache());
+}
+
+// Entries that get many hits are refreshed before they expire.
+TEST_F(HostResolverImplTest, RefreshBeforeExpiry) {
+  HostResolver::Options options = DefaultOptions();
+  options.refresh_before_expiry = base::TimeDelta::FromSeconds(10);
+  resolver_.reset(new TestHostResolverImpl(options, nullptr));
+  resolver_->set_proc_params_for_test(DefaultParams(proc_.get()));
+  base::SimpleTestTickClock clock;
+  resolver_->SetTickClockForTesting(&clock);
+
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(2u);
+
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(),
+              IsError(ERR_IO_PENDING));
+  EXPECT_THAT(requests_[0]->WaitForResult(), IsOk());
+
+  // Hits long before the entry expires don't refresh it.
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(), IsOk());
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(), IsOk());
+  RunUntilIdle();
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+
+  // Close to expiring, the third hit refreshes the entry.
+  clock.Advance(base::TimeDelta::FromSeconds(55));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(), IsOk());
+  EXPECT_TRUE(requests_[3]->HasOneAddress("192.168.1.42", 80));
+  RunUntilIdle();
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+
+  // So it doesn't expire when it would have.
+  clock.Advance(base::TimeDelta::FromSeconds(10));
+  EXPECT_THAT(CreateRequest("just.testing", 80)->Resolve(), IsOk());
+  EXPECT_TRUE(requests_[4]->HasOneAddress("192.168.1.43", 80));
+}
+
 // Test the retry attempts simulating host resolver proc that takes too long.
 TEST_F(HostResolverImplTest, MultipleAttempts) {
   // Total number of attempts would be 3 and we want the 3rd attempt to resolve
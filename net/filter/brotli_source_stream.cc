@@ -37,11 +37,11 @@ class BrotliSourceStream : public FilterSourceStream {
   }
 
   ~BrotliSourceStream() override {
-    BrotliDecoderErrorCode error_code =
-        BrotliDecoderGetErrorCode(brotli_state_);
-    BrotliDecoderDestroyInstance(brotli_state_);
-    brotli_state_ = nullptr;
-    DCHECK_EQ(0u, used_memory_);
+    BrotliDecoderErrorCode error_code = BROTLI_DECODER_SUCCESS;
+    if (brotli_state_) {
+      error_code = BrotliDecoderGetErrorCode(brotli_state_);
+      DestroyDecoder();
+    }
 
     // Don't report that gzip header was detected in case of lack of input.
     gzip_header_detected_ &= (consumed_bytes_ >= sizeof(kGzipHeader));
@@ -133,6 +133,9 @@ class BrotliSourceStream : public FilterSourceStream {
         return bytes_written;
       case BROTLI_DECODER_RESULT_SUCCESS:
         decoding_status_ = DecodingStatus::DECODING_DONE;
+        // The ring buffer can be as large as the window, up to 16MiB, so free
+        // it now rather than when the consumer is done with the stream.
+        DestroyDecoder();
         // Consume remaining bytes to avoid DCHECK in FilterSourceStream.
         // See crbug.com/659311.
         *consumed_bytes = input_buffer_size;
@@ -149,6 +152,12 @@ class BrotliSourceStream : public FilterSourceStream {
     }
   }
 
+  void DestroyDecoder() {
+    BrotliDecoderDestroyInstance(brotli_state_);
+    brotli_state_ = nullptr;
+    DCHECK_EQ(0u, used_memory_);
+  }
+
   static void* AllocateMemory(void* opaque, size_t size) {
     BrotliSourceStream* filter = reinterpret_cast<BrotliSourceStream*>(opaque);
     return filter->AllocateMemoryInternal(size);
@@ -178,6 +187,7 @@ class BrotliSourceStream : public FilterSourceStream {
     free(&array[-1]);
   }
 
+  // Null once decoding is done.
   BrotliDecoderState* brotli_state_;
 
   DecodingStatus decoding_status_;
@@ -161,6 +161,7 @@ int GzipSourceStream::FilterData(IOBuffer* output_buffer,
             ret == Z_STREAM_END) {
           replay_data_.clear();
           if (ret == Z_STREAM_END) {
+            EndInflate();
             input_state_ = STATE_GZIP_FOOTER;
           } else {
             input_state_ = STATE_COMPRESSED_BODY;
@@ -222,8 +223,10 @@ int GzipSourceStream::FilterData(IOBuffer* output_buffer,
         bytes_out = output_buffer_size - zlib_stream_.get()->avail_out;
         input_data_size -= bytes_used;
         input_data += bytes_used;
-        if (ret == Z_STREAM_END)
+        if (ret == Z_STREAM_END) {
+          EndInflate();
           input_state_ = STATE_GZIP_FOOTER;
+        }
         // zlib has written as much data to |output_buffer| as it could.
         // There might still be some unconsumed data in |input_buffer| if there
         // is no space in |output_buffer|.
@@ -249,6 +252,11 @@ int GzipSourceStream::FilterData(IOBuffer* output_buffer,
   return bytes_out;
 }
 
+void GzipSourceStream::EndInflate() {
+  inflateEnd(zlib_stream_.get());
+  zlib_stream_.reset();
+}
+
 bool GzipSourceStream::InsertZlibHeader() {
   char dummy_header[] = {0x78, 0x01};
   char dummy_output[4];
@@ -85,9 +85,16 @@ class NET_EXPORT_PRIVATE GzipSourceStream : public FilterSourceStream {
   // success.
   bool InsertZlibHeader();
 
+  // Frees the zlib state, including its window, once the compressed body has
+  // been fully decoded. Only the footer and extra bytes remain to be ignored,
+  // and the stream may outlive the decoding for as long as the consumer keeps
+  // it around.
+  void EndInflate();
+
   // The control block of zlib which actually does the decoding.
   // This data structure is initialized by Init and updated only by
   // FilterData(), with InsertZlibHeader() being the exception as a workaround.
+  // Null once the compressed body has been decoded.
   std::unique_ptr<z_stream> zlib_stream_;
 
   // While in STATE_SNIFFING_DEFLATE_HEADER, it may be determined that a zlib
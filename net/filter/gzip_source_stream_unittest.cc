@@ -241,6 +241,22 @@ TEST_P(GzipSourceStreamTest, IgnoreDataAfterEof) {
   EXPECT_EQ("DEFLATE", stream()->Description());
 }
 
+// Same as above, with the gzip footer to skip before the extra bytes.
+TEST_P(GzipSourceStreamTest, GzipIgnoreDataAfterEof) {
+  Init(SourceStream::TYPE_GZIP);
+  const char kExtraData[] = "Hello, World!";
+  source()->AddReadResult(encoded_data(), encoded_data_len(), OK,
+                          GetParam().mode);
+  source()->AddReadResult(kExtraData, sizeof(kExtraData), OK, GetParam().mode);
+  source()->AddReadResult(nullptr, 0, OK, GetParam().mode);
+  std::string actual_output;
+  int rv = ReadStream(&actual_output);
+  std::string expected_output(source_data(), source_data_len());
+  EXPECT_EQ(static_cast<int>(expected_output.size()), rv);
+  EXPECT_EQ(expected_output, actual_output);
+  EXPECT_EQ("GZIP", stream()->Description());
+}
+
 TEST_P(GzipSourceStreamTest, MissingZlibHeader) {
   Init(SourceStream::TYPE_DEFLATE);
   const size_t kZlibHeaderLen = 2;
@@ -118,6 +118,20 @@ bool HttpCache::ActiveEntry::TransactionInReaders(
 
 //-----------------------------------------------------------------------------
 
+HttpCache::HotEntry::HotEntry() = default;
+
+HttpCache::HotEntry::HotEntry(const HotEntry& other) = default;
+
+HttpCache::HotEntry::HotEntry(HotEntry&& other) = default;
+
+HttpCache::HotEntry::~HotEntry() = default;
+
+size_t HttpCache::HotEntry::GetSize() const {
+  return response_info.size() + data->size();
+}
+
+//-----------------------------------------------------------------------------
+
 // This structure keeps track of work items that are attempting to create or
 // open cache entries or the backend itself.
 struct HttpCache::PendingOp {
@@ -320,6 +334,10 @@ HttpCache::HttpCache(std::unique_ptr<HttpTransactionFactory> network_layer,
       fail_conditionalization_for_test_(false),
       mode_(NORMAL),
       network_layer_(std::move(network_layer)),
+      max_hot_entries_size_(0),
+      hot_entries_size_(0),
+      hot_entries_(HotEntriesMap::NO_AUTO_EVICT),
+      hot_entries_generation_(0),
       clock_(base::DefaultClock::GetInstance()),
       weak_factory_(this) {
   HttpNetworkSession* session = network_layer_->GetSession();
@@ -387,6 +405,8 @@ int HttpCache::GetBackend(disk_cache::Backend** backend,
                           CompletionOnceCallback callback) {
   DCHECK(!callback.is_null());
 
+  ClearHotEntries();
+
   if (disk_cache_.get()) {
     *backend = disk_cache_.get();
     return OK;
@@ -429,6 +449,18 @@ void HttpCache::WriteMetadata(const GURL& url,
   writer->Write(url, expected_response_time, buf, buf_len);
 }
 
+void HttpCache::SetMaxHotEntriesSize(size_t max_bytes) {
+  max_hot_entries_size_ = max_bytes;
+  if (!max_bytes)
+    ClearHotEntries();
+}
+
+void HttpCache::ClearHotEntries() {
+  hot_entries_.Clear();
+  hot_entries_size_ = 0;
+  ++hot_entries_generation_;
+}
+
 void HttpCache::CloseAllConnections() {
   HttpNetworkSession* session = GetSession();
   if (session)
@@ -500,7 +532,8 @@ void HttpCache::DumpMemoryStats(base::trace_event::ProcessMemoryDump* pmd,
   size_t size = base::trace_event::EstimateMemoryUsage(active_entries_) +
                 base::trace_event::EstimateMemoryUsage(doomed_entries_) +
                 base::trace_event::EstimateMemoryUsage(playback_cache_map_) +
-                base::trace_event::EstimateMemoryUsage(pending_ops_);
+                base::trace_event::EstimateMemoryUsage(pending_ops_) +
+                hot_entries_size_;
   if (disk_cache_)
     size += disk_cache_->DumpMemoryStats(pmd, name);
 
@@ -592,6 +625,8 @@ void HttpCache::DoomActiveEntry(const std::string& key) {
 }
 
 int HttpCache::DoomEntry(const std::string& key, Transaction* trans) {
+  RemoveHotEntry(key);
+
   // Need to abandon the ActiveEntry, but any transaction attached to the entry
   // should not be impacted.  Dooming an entry only means that it will no
   // longer be returned by FindActiveEntry (and it will also be destroyed once
@@ -619,6 +654,8 @@ int HttpCache::DoomEntry(const std::string& key, Transaction* trans) {
 }
 
 int HttpCache::AsyncDoomEntry(const std::string& key, Transaction* trans) {
+  RemoveHotEntry(key);
+
   std::unique_ptr<WorkItem> item =
       std::make_unique<WorkItem>(WI_DOOM_ENTRY, trans, nullptr);
   PendingOp* pending_op = GetPendingOp(key);
@@ -723,6 +760,41 @@ HttpCache::PendingOp* HttpCache::GetPendingOp(const std::string& key) {
   return operation;
 }
 
+const HttpCache::HotEntry* HttpCache::GetHotEntry(const std::string& key) {
+  auto it = hot_entries_.Get(key);
+  return it != hot_entries_.end() ? &it->second : nullptr;
+}
+
+void HttpCache::AddHotEntry(const std::string& key, HotEntry hot_entry) {
+  size_t size = key.size() + hot_entry.GetSize();
+  if (size > max_hot_entries_size_)
+    return;
+
+  RemoveHotEntry(key);
+  while (hot_entries_size_ + size > max_hot_entries_size_) {
+    auto oldest = hot_entries_.rbegin();
+    DCHECK(oldest != hot_entries_.rend());
+    hot_entries_size_ -= oldest->first.size() + oldest->second.GetSize();
+    hot_entries_.Erase(oldest);
+  }
+  hot_entries_.Put(key, std::move(hot_entry));
+  hot_entries_size_ += size;
+}
+
+void HttpCache::RemoveHotEntry(const std::string& key) {
+  auto it = hot_entries_.Peek(key);
+  if (it == hot_entries_.end())
+    return;
+  hot_entries_size_ -= key.size() + it->second.GetSize();
+  hot_entries_.Erase(it);
+}
+
+void HttpCache::OnActiveEntryChanged(ActiveEntry* entry) {
+  ++entry->change_count;
+  if (!hot_entries_.empty())
+    RemoveHotEntry(entry->disk_entry->GetKey());
+}
+
 void HttpCache::DeletePendingOp(PendingOp* pending_op) {
   std::string key;
   if (pending_op->disk_entry)
@@ -781,6 +853,8 @@ int HttpCache::CreateEntry(const std::string& key, ActiveEntry** entry,
     return ERR_CACHE_RACE;
   }
 
+  RemoveHotEntry(key);
+
   std::unique_ptr<WorkItem> item =
       std::make_unique<WorkItem>(WI_CREATE_ENTRY, trans, entry);
   PendingOp* pending_op = GetPendingOp(key);
@@ -961,6 +1035,7 @@ void HttpCache::DoomEntryValidationNoMatch(ActiveEntry* entry) {
 
   entry->headers_transaction = nullptr;
   if (entry->SafeToDestroy()) {
+    RemoveHotEntry(entry->disk_entry->GetKey());
     entry->disk_entry->Doom();
     DestroyEntry(entry);
     return;
@@ -1006,6 +1081,7 @@ void HttpCache::ProcessEntryFailure(ActiveEntry* entry) {
   RemoveAllQueuedTransactions(entry, &list);
 
   if (entry->SafeToDestroy()) {
+    RemoveHotEntry(entry->disk_entry->GetKey());
     entry->disk_entry->Doom();
     DestroyEntry(entry);
   } else {
@@ -20,8 +20,10 @@
 #include <string>
 #include <unordered_map>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/threading/thread_checker.h"
 #include "base/time/clock.h"
@@ -52,6 +54,7 @@ namespace net {
 class HttpNetworkSession;
 class HttpResponseInfo;
 class IOBuffer;
+class IOBufferWithSize;
 class NetLog;
 class ViewCacheHelper;
 struct HttpRequestInfo;
@@ -143,6 +146,13 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   // again without validation.
   static const int kPrefetchReuseMins = 5;
 
+  // The largest response body held in memory by the tier of hot entries.
+  static const int kMaxHotEntryDataSize = 32 * 1024;
+
+  // The default size of the tier of hot entries of disk caches created by
+  // URLRequestContextBuilder.
+  static const size_t kDefaultMaxHotEntriesSize = 1024 * 1024;
+
   // The disk cache is initialized lazily (by CreateTransaction) in this case.
   // Provide an existing HttpNetworkSession, the cache can construct a
   // network layer with a shared HttpNetworkSession in order for multiple
@@ -173,6 +183,8 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   // a network error code, and it could be ERR_IO_PENDING, in which case the
   // |callback| will be notified when the operation completes. The pointer that
   // receives the |backend| must remain valid until the operation completes.
+  // Since the caller may doom entries through the backend, this clears the
+  // tier of hot entries.
   int GetBackend(disk_cache::Backend** backend,
                  CompletionOnceCallback callback);
 
@@ -199,6 +211,17 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   void set_mode(Mode value) { mode_ = value; }
   Mode mode() { return mode_; }
 
+  // Keeps up to |max_bytes| of small responses in memory, so that hits on them
+  // are answered without going to the backend. Zero, the default, disables
+  // this tier of hot entries.
+  void SetMaxHotEntriesSize(size_t max_bytes);
+
+  // Drops the responses held in memory by the tier of hot entries, including
+  // the ones being copied. Entries doomed directly through the backend are not
+  // noticed otherwise, so this must be called once such a doom completes, as
+  // responses may have been copied again since GetBackend().
+  void ClearHotEntries();
+
   // Get/Set the cache's clock. These are public only for testing.
   void SetClockForTesting(base::Clock* clock) { clock_ = clock; }
   base::Clock* clock() const { return clock_; }
@@ -348,6 +371,29 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
 
     // True if entry is doomed.
     bool doomed = false;
+
+    // Incremented whenever the response stored in the entry is written, so that
+    // a reader can tell whether what it read is still current.
+    int change_count = 0;
+  };
+
+  // A copy of a cache entry held in memory. Only complete 200 responses without
+  // metadata are held, and only after they were read from the cache without
+  // validation. Hits still go through the usual validation and Vary checks.
+  struct NET_EXPORT_PRIVATE HotEntry {
+    HotEntry();
+    HotEntry(const HotEntry& other);
+    HotEntry(HotEntry&& other);
+    ~HotEntry();
+
+    // Returns the memory taken by the entry.
+    size_t GetSize() const;
+
+    // The pickled HttpResponseInfo, as stored in the entry.
+    std::string response_info;
+
+    // The response body.
+    scoped_refptr<IOBufferWithSize> data;
   };
 
   using ActiveEntriesMap =
@@ -355,6 +401,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   using PendingOpsMap = std::unordered_map<std::string, PendingOp*>;
   using ActiveEntriesSet = std::map<ActiveEntry*, std::unique_ptr<ActiveEntry>>;
   using PlaybackCacheMap = std::unordered_map<std::string, int>;
+  using HotEntriesMap = base::MRUCache<std::string, HotEntry>;
 
   // Methods ------------------------------------------------------------------
 
@@ -415,6 +462,20 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   // Deletes a PendingOp.
   void DeletePendingOp(PendingOp* pending_op);
 
+  // Returns the hot entry for |key|, or null if there is none.
+  const HotEntry* GetHotEntry(const std::string& key);
+
+  // Adds |hot_entry| as the copy of the entry for |key|, if the tier of hot
+  // entries is enabled and has room for it.
+  void AddHotEntry(const std::string& key, HotEntry hot_entry);
+
+  // Removes the hot entry for |key|, if any. This must be done whenever the
+  // entry for |key| is doomed or written to.
+  void RemoveHotEntry(const std::string& key);
+
+  // Called before the response stored in |entry| is written to.
+  void OnActiveEntryChanged(ActiveEntry* entry);
+
   // Opens the disk cache entry associated with |key|, returning an ActiveEntry
   // in |*entry|. |trans| will be notified via its IO callback if this method
   // returns ERR_IO_PENDING. This should not be called if there already is
@@ -594,6 +655,14 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
 
   std::unique_ptr<PlaybackCacheMap> playback_cache_map_;
 
+  // The tier of hot entries, indexed by cache key, and the size they take.
+  size_t max_hot_entries_size_;
+  size_t hot_entries_size_;
+  HotEntriesMap hot_entries_;
+  // Incremented by ClearHotEntries(), so that copies started before it are
+  // not added.
+  int hot_entries_generation_;
+
   // A clock that can be swapped out for testing.
   base::Clock* clock_;
 
@@ -24,6 +24,7 @@
 #include "base/macros.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/pickle.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"  // For HexEncode.
 #include "base/strings/string_piece.h"
@@ -190,6 +191,8 @@ HttpCache::Transaction::Transaction(RequestPriority priority, HttpCache* cache)
       read_offset_(0),
       effective_load_flags_(0),
       shared_writing_error_(OK),
+      hot_entry_change_count_(0),
+      hot_entry_generation_(0),
       cache_entry_status_(CacheEntryStatus::ENTRY_UNDEFINED),
       validation_cause_(VALIDATION_CAUSE_UNDEFINED),
       cant_conditionalize_zero_freshness_from_memhint_(false),
@@ -240,6 +243,7 @@ int HttpCache::Transaction::WriteMetadata(IOBuffer* buf,
   // It could be possible to check if there is something already written and
   // avoid writing again (it should be the same, right?), but let's allow the
   // caller to "update" the contents with something new.
+  cache_->OnActiveEntryChanged(entry_);
   return entry_->disk_entry->WriteData(kMetadataIndex, 0, buf, buf_len,
                                        std::move(callback), true);
 }
@@ -248,7 +252,7 @@ LoadState HttpCache::Transaction::GetWriterLoadState() const {
   const HttpTransaction* transaction = network_transaction();
   if (transaction)
     return transaction->GetLoadState();
-  if (entry_ || !request_)
+  if (entry_ || hot_entry_data_ || !request_)
     return LOAD_STATE_IDLE;
   return LOAD_STATE_WAITING_FOR_CACHE;
 }
@@ -395,6 +399,11 @@ int HttpCache::Transaction::Read(IOBuffer* buf,
 }
 
 int HttpCache::Transaction::TransitionToReadingState() {
+  if (hot_entry_data_) {
+    next_state_ = STATE_NONE;
+    return ReadFromHotEntry();
+  }
+
   if (!entry_) {
     if (network_trans_) {
       // This can happen when the request should be handled exclusively by
@@ -503,6 +512,7 @@ int64_t HttpCache::Transaction::GetTotalSentBytes() const {
 void HttpCache::Transaction::DoneReading() {
   if (cache_.get() && entry_) {
     DCHECK_NE(mode_, UPDATE);
+    ContinueHotEntryCopy(0);
     DoneWithEntry(true);
   }
 }
@@ -1150,11 +1160,19 @@ int HttpCache::Transaction::DoOpenEntry() {
   if (new_entry_)
     return OK;
 
+  if (ServeFromHotEntry()) {
+    net_log_.EndEvent(NetLogEventType::HTTP_CACHE_OPEN_ENTRY);
+    cache_pending_ = false;
+    TransitionToState(STATE_FINISH_HEADERS);
+    return OK;
+  }
+
   // See if we could potentially quick-reject the entry based on hints the
   // backend keeps in memory.
   uint8_t in_memory_info =
       cache_->GetCurrentBackend()->GetEntryInMemoryData(cache_key_);
   if (MaybeRejectBasedOnEntryInMemoryData(in_memory_info)) {
+    cache_->RemoveHotEntry(cache_key_);
     cache_->GetCurrentBackend()->DoomEntry(cache_key_, priority_,
                                            base::DoNothing());
     return net::ERR_CACHE_ENTRY_NOT_SUITABLE;
@@ -2288,6 +2306,7 @@ int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
     return DoPartialCacheReadCompleted(result);
   }
 
+  ContinueHotEntryCopy(result);
   if (result > 0) {
     read_offset_ += result;
   } else if (result == 0) {  // End of file.
@@ -2463,10 +2482,12 @@ int HttpCache::Transaction::BeginCacheRead() {
   if (method_ == "HEAD")
     FixHeadersForHead();
 
-  if (entry_->disk_entry->GetDataSize(kMetadataIndex))
+  if (entry_->disk_entry->GetDataSize(kMetadataIndex)) {
     TransitionToState(STATE_CACHE_READ_METADATA);
-  else
+  } else {
+    MaybeStartHotEntryCopy();
     TransitionToState(STATE_FINISH_HEADERS);
+  }
 
   return OK;
 }
@@ -3019,10 +3040,12 @@ int HttpCache::Transaction::DoSetupEntryForRead() {
   if (method_ == "HEAD")
     FixHeadersForHead();
 
-  if (entry_->disk_entry->GetDataSize(kMetadataIndex))
+  if (entry_->disk_entry->GetDataSize(kMetadataIndex)) {
     TransitionToState(STATE_CACHE_READ_METADATA);
-  else
+  } else {
+    MaybeStartHotEntryCopy();
     TransitionToState(STATE_FINISH_HEADERS);
+  }
   return OK;
 }
 
@@ -3034,6 +3057,7 @@ int HttpCache::Transaction::WriteToEntry(int index,
   if (!entry_)
     return data_len;
 
+  cache_->OnActiveEntryChanged(entry_);
   int rv = 0;
   if (!partial_ || !data_len) {
     rv = entry_->disk_entry->WriteData(index, offset, data, data_len,
@@ -3080,6 +3104,7 @@ int HttpCache::Transaction::WriteResponseInfoToEntry(bool truncated) {
   data->Done();
 
   io_buf_len_ = data->pickle()->size();
+  cache_->OnActiveEntryChanged(entry_);
 
   // Summarize some info on cacheability in memory. Don't do it if doomed
   // since then |entry_| isn't definitive for |cache_key_|.
@@ -3137,6 +3162,95 @@ void HttpCache::Transaction::DoneWithEntry(bool entry_is_complete) {
   mode_ = NONE;  // switch to 'pass through' mode
 }
 
+bool HttpCache::Transaction::ServeFromHotEntry() {
+  if (method_ != "GET" || partial_ || (mode_ != READ && mode_ != READ_WRITE) ||
+      (effective_load_flags_ & LOAD_PREFETCH)) {
+    return false;
+  }
+
+  const HotEntry* hot_entry = cache_->GetHotEntry(cache_key_);
+  if (!hot_entry)
+    return false;
+
+  bool truncated = false;
+  if (!HttpCache::ParseResponseInfo(hot_entry->response_info.data(),
+                                    hot_entry->response_info.size(),
+                                    &response_, &truncated)) {
+    NOTREACHED();
+    response_ = HttpResponseInfo();
+    return false;
+  }
+  DCHECK(!truncated);
+
+  // Anything other than a fresh match goes through the entry, as usual.
+  if (RequiresValidation() != VALIDATION_NONE) {
+    response_ = HttpResponseInfo();
+    vary_mismatch_ = false;
+    validation_cause_ = VALIDATION_CAUSE_UNDEFINED;
+    return false;
+  }
+
+  hot_entry_data_ = hot_entry->data;
+  mode_ = READ;
+  UpdateCacheEntryStatus(CacheEntryStatus::ENTRY_USED);
+  return true;
+}
+
+int HttpCache::Transaction::ReadFromHotEntry() {
+  int num_bytes = std::min(io_buf_len_, hot_entry_data_->size() - read_offset_);
+  memcpy(read_buf_->data(), hot_entry_data_->data() + read_offset_, num_bytes);
+  read_offset_ += num_bytes;
+  return num_bytes;
+}
+
+void HttpCache::Transaction::MaybeStartHotEntryCopy() {
+  DCHECK(!hot_entry_copy_);
+  if (!cache_->max_hot_entries_size_ || method_ != "GET" || partial_ ||
+      truncated_ || mode_ != READ ||
+      cache_entry_status_ != CacheEntryStatus::ENTRY_USED ||
+      response_.headers->response_code() == 206 ||
+      response_.async_revalidation_requested ||
+      response_.unused_since_prefetch ||
+      (effective_load_flags_ & LOAD_PREFETCH) ||
+      cache_->IsWritingInProgress(entry_)) {
+    return;
+  }
+
+  int data_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
+  if (data_size > kMaxHotEntryDataSize)
+    return;
+
+  base::Pickle pickle;
+  response_.Persist(&pickle, true /* skip_transient_headers */,
+                    false /* response_truncated */);
+  hot_entry_copy_ = std::make_unique<HotEntry>();
+  hot_entry_copy_->response_info.assign(
+      static_cast<const char*>(pickle.data()), pickle.size());
+  hot_entry_copy_->data = base::MakeRefCounted<IOBufferWithSize>(data_size);
+  hot_entry_change_count_ = entry_->change_count;
+  hot_entry_generation_ = cache_->hot_entries_generation_;
+}
+
+void HttpCache::Transaction::ContinueHotEntryCopy(int result) {
+  if (!hot_entry_copy_)
+    return;
+
+  IOBufferWithSize* data = hot_entry_copy_->data.get();
+  if (result > 0 && read_offset_ + result <= data->size()) {
+    memcpy(data->data() + read_offset_, read_buf_->data(), result);
+    return;
+  }
+
+  // The copy is only kept if the whole body was read, and neither the entry
+  // nor the tier of hot entries were changed in the meantime.
+  if (result == 0 && read_offset_ == data->size() && !entry_->doomed &&
+      entry_->change_count == hot_entry_change_count_ &&
+      cache_->hot_entries_generation_ == hot_entry_generation_) {
+    cache_->AddHotEntry(cache_key_, std::move(*hot_entry_copy_));
+  }
+  hot_entry_copy_.reset();
+}
+
 int HttpCache::Transaction::OnCacheReadError(int result, bool restart) {
   DLOG(ERROR) << "ReadData failed: " << result;
   const int result_for_histogram = std::max(0, -result);
@@ -450,6 +450,24 @@ class NET_EXPORT_PRIVATE HttpCache::Transaction : public HttpTransaction {
   // Fixes the response headers to match expectations for a HEAD request.
   void FixHeadersForHead();
 
+  // Sets up the transaction to be answered from the hot entry for
+  // |cache_key_|, if there is one that can be used without validation.
+  // Returns true if it did.
+  bool ServeFromHotEntry();
+
+  // Copies the body of the response served from a hot entry to |read_buf_|,
+  // and returns the number of bytes copied.
+  int ReadFromHotEntry();
+
+  // Starts copying the entry that is about to be read, so that it can be made a
+  // hot entry once it is read completely, if it is small enough.
+  void MaybeStartHotEntryCopy();
+
+  // Adds the |result| bytes just read from the entry to the copy started by
+  // MaybeStartHotEntryCopy(), and finishes the copy at the end of the body or
+  // on errors.
+  void ContinueHotEntryCopy(int result);
+
   // Called to write data to the cache entry.  If the write fails, then the
   // cache entry is destroyed.  Future calls to this function will just do
   // nothing without side-effect.  Returns a network error code.
@@ -623,6 +641,16 @@ class NET_EXPORT_PRIVATE HttpCache::Transaction : public HttpTransaction {
   // failed in a separate transaction.
   int shared_writing_error_;
 
+  // The response body, when the transaction is answered from a hot entry.
+  scoped_refptr<IOBufferWithSize> hot_entry_data_;
+
+  // The copy of the entry being read, to be made a hot entry, and the
+  // ActiveEntry::change_count of the entry and the cache's generation of hot
+  // entries when the copy was started.
+  std::unique_ptr<HotEntry> hot_entry_copy_;
+  int hot_entry_change_count_;
+  int hot_entry_generation_;
+
   // Members used to track data for histograms.
   // This cache_entry_status_ takes precedence over
   // response_.cache_entry_status. In fact, response_.cache_entry_status must be
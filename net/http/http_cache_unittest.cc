@@ -10806,4 +10806,144 @@ TEST_P(HttpCacheMemoryDumpTest, DumpMemoryStats) {
                   Field(&Entry::value_uint64, Gt(0UL)))));
 }
 
+// Tests that small responses read from the cache are then answered from memory.
+TEST_F(HttpCacheTest, HotEntries_SimpleGET) {
+  MockHttpCache cache;
+  cache.http_cache()->SetMaxHotEntriesSize(1024 * 1024);
+
+  // Write to the cache, then read the entry back, which copies it in memory.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  HttpResponseInfo response_info;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), kSimpleGET_Transaction,
+                                     &response_info);
+  EXPECT_TRUE(response_info.was_cached);
+  EXPECT_FALSE(response_info.network_accessed);
+  EXPECT_EQ(CacheEntryStatus::ENTRY_USED, response_info.cache_entry_status);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  // Disabling the tier drops the entries.
+  cache.http_cache()->SetMaxHotEntriesSize(0);
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+}
+
+// Tests that hot entries are not used for requests they don't match.
+TEST_F(HttpCacheTest, HotEntries_VaryMismatch) {
+  MockHttpCache cache;
+  cache.http_cache()->SetMaxHotEntriesSize(1024 * 1024);
+
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.request_headers = "Foo: bar\r\n";
+  transaction.response_headers =
+      "Cache-Control: max-age=10000\n"
+      "Vary: Foo\n";
+  AddMockTransaction(&transaction);
+  RunTransactionTest(cache.http_cache(), transaction);
+  RunTransactionTest(cache.http_cache(), transaction);
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+
+  // A different Foo goes through the entry, and to the network.
+  transaction.request_headers = "Foo: none\r\n";
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+  RemoveMockTransaction(&transaction);
+}
+
+// Tests that hot entries which need validation go through the entry.
+TEST_F(HttpCacheTest, HotEntries_Validation) {
+  MockHttpCache cache;
+  cache.http_cache()->SetMaxHotEntriesSize(1024 * 1024);
+
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.load_flags |= LOAD_VALIDATE_CACHE;
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+}
+
+// Tests that writing an entry drops its copy in memory.
+TEST_F(HttpCacheTest, HotEntries_DroppedOnWrite) {
+  MockHttpCache cache;
+  cache.http_cache()->SetMaxHotEntriesSize(1024 * 1024);
+
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+
+  // Overwrite the entry from the network.
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.load_flags |= LOAD_BYPASS_CACHE;
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->create_count());
+
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+}
+
+// Tests that handing out the backend, through which entries may be doomed,
+// drops the copies in memory.
+TEST_F(HttpCacheTest, HotEntries_ClearedByGetBackend) {
+  MockHttpCache cache;
+  cache.http_cache()->SetMaxHotEntriesSize(1024 * 1024);
+
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+
+  ASSERT_TRUE(cache.backend());
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+
+  // The entry was copied in memory again, and ClearHotEntries() drops it too.
+  cache.http_cache()->ClearHotEntries();
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(3, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+}
+
+// Tests that the tier of hot entries stays within its size.
+TEST_F(HttpCacheTest, HotEntries_Eviction) {
+  MockHttpCache cache;
+  // Room for one of the entries below only.
+  cache.http_cache()->SetMaxHotEntriesSize(1024);
+
+  const std::string body(600, 'a');
+  MockTransaction first(kSimpleGET_Transaction);
+  first.data = body.c_str();
+  MockTransaction second(first);
+  second.url = "http://www.google.com/other";
+  AddMockTransaction(&first);
+  AddMockTransaction(&second);
+
+  RunTransactionTest(cache.http_cache(), first);
+  RunTransactionTest(cache.http_cache(), second);
+  RunTransactionTest(cache.http_cache(), first);
+  RunTransactionTest(cache.http_cache(), second);
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+
+  // Only the last one read is still in memory.
+  RunTransactionTest(cache.http_cache(), second);
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+  RunTransactionTest(cache.http_cache(), first);
+  EXPECT_EQ(3, cache.disk_cache()->open_count());
+  RemoveMockTransaction(&second);
+  RemoveMockTransaction(&first);
+}
+
 }  // namespace net
@@ -21,6 +21,7 @@
 #include "base/trace_event/process_memory_dump.h"
 #include "base/values.h"
 #include "net/http/http_auth_handler_factory.h"
+#include "net/http/http_preconnect_predictor.h"
 #include "net/http/http_response_body_drainer.h"
 #include "net/http/http_stream_factory.h"
 #include "net/http/url_security_manager.h"
@@ -146,7 +147,8 @@ HttpNetworkSession::Params::Params()
       enable_token_binding(false),
       enable_channel_id(false),
       http_09_on_non_default_ports_enabled(false),
-      disable_idle_sockets_close_on_memory_pressure(false) {
+      disable_idle_sockets_close_on_memory_pressure(false),
+      enable_http_preconnect_predictor(false) {
   quic_supported_versions.push_back(quic::QUIC_VERSION_43);
 }
 
@@ -265,6 +267,9 @@ HttpNetworkSession::HttpNetworkSession(const Params& params,
     next_protos_.push_back(kProtoHTTP2);
   }
 
+  if (params_.enable_http_preconnect_predictor)
+    preconnect_predictor_ = std::make_unique<HttpPreconnectPredictor>(this);
+
   next_protos_.push_back(kProtoHTTP11);
 
   http_server_properties_->SetMaxServerConfigsStoredInProperties(
@@ -52,6 +52,7 @@ class CTVerifier;
 class HostResolver;
 class HttpAuthHandlerFactory;
 class HttpNetworkSessionPeer;
+class HttpPreconnectPredictor;
 class HttpProxyClientSocketPool;
 class HttpResponseBodyDrainer;
 class HttpServerProperties;
@@ -224,6 +225,10 @@ class NET_EXPORT HttpNetworkSession : public base::MemoryCoordinatorClient {
 
     // If true, idle sockets won't be closed when memory pressure happens.
     bool disable_idle_sockets_close_on_memory_pressure;
+
+    // If true, sockets are preconnected to the origins that earlier main frame
+    // requests to the same origin were followed by requests to.
+    bool enable_http_preconnect_predictor;
   };
 
   // Structure with pointers to the dependencies of the HttpNetworkSession.
@@ -308,6 +313,10 @@ class NET_EXPORT HttpNetworkSession : public base::MemoryCoordinatorClient {
   HttpStreamFactory* http_stream_factory() {
     return http_stream_factory_.get();
   }
+  // Null unless Params::enable_http_preconnect_predictor is set.
+  HttpPreconnectPredictor* preconnect_predictor() {
+    return preconnect_predictor_.get();
+  }
   NetLog* net_log() {
     return net_log_;
   }
@@ -384,6 +393,7 @@ class NET_EXPORT HttpNetworkSession : public base::MemoryCoordinatorClient {
   QuicStreamFactory quic_stream_factory_;
   SpdySessionPool spdy_session_pool_;
   std::unique_ptr<HttpStreamFactory> http_stream_factory_;
+  std::unique_ptr<HttpPreconnectPredictor> preconnect_predictor_;
   std::map<HttpResponseBodyDrainer*, std::unique_ptr<HttpResponseBodyDrainer>>
       response_drainers_;
   NextProtoVector next_protos_;
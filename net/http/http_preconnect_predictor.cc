@@ -0,0 +1,230 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_preconnect_predictor.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "net/base/load_timing_info.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_stream_factory.h"
+#include "net/log/net_log_source.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+constexpr NetworkTrafficAnnotationTag kTrafficAnnotation =
+    DefineNetworkTrafficAnnotation("http_preconnect_predictor", R"(
+        semantics {
+          sender: "HTTP Preconnect Predictor"
+          description:
+            "Opens connections to the servers that previous navigations to a "
+            "site connected to, so that they are ready when the page requests "
+            "its subresources."
+          trigger:
+            "Starting a navigation to a site whose previous loads connected "
+            "to other servers."
+          data: "None, only the connection is established."
+          destination: WEBSITE
+        }
+        policy {
+          cookies_allowed: NO
+          setting: "This feature cannot be disabled by settings."
+          policy_exception_justification: "Not implemented."
+        })");
+
+bool IsLearnable(const GURL& url) {
+  return url.is_valid() && url.SchemeIsHTTPOrHTTPS();
+}
+
+}  // namespace
+
+const size_t HttpPreconnectPredictor::kMaxMainFrameOrigins;
+const size_t HttpPreconnectPredictor::kMaxOriginsPerMainFrame;
+const size_t HttpPreconnectPredictor::kMaxPreconnectOrigins;
+const int HttpPreconnectPredictor::kMaxPreconnectSockets;
+const int HttpPreconnectPredictor::kMaxSocketsPerOrigin;
+const int HttpPreconnectPredictor::kMaxNavigationCount;
+
+HttpPreconnectPredictor::OriginStats::OriginStats(
+    const url::SchemeHostPort& origin)
+    : origin(origin),
+      privacy_mode(PRIVACY_MODE_DISABLED),
+      hit_count(0),
+      connection_count(0),
+      last_navigation_id(0) {}
+
+HttpPreconnectPredictor::MainFrameStats::MainFrameStats()
+    : navigation_count(0), navigation_id(0) {}
+
+HttpPreconnectPredictor::MainFrameStats::MainFrameStats(
+    const MainFrameStats& other) = default;
+
+HttpPreconnectPredictor::MainFrameStats::~MainFrameStats() = default;
+
+HttpPreconnectPredictor::HttpPreconnectPredictor(HttpNetworkSession* session)
+    : session_(session), main_frames_(kMaxMainFrameOrigins) {}
+
+HttpPreconnectPredictor::~HttpPreconnectPredictor() = default;
+
+void HttpPreconnectPredictor::OnNavigationStarted(const GURL& main_frame_url) {
+  if (!IsLearnable(main_frame_url))
+    return;
+
+  for (const auto& prediction : PredictOrigins(main_frame_url)) {
+    Preconnect(prediction.first->origin, prediction.first->privacy_mode,
+               prediction.second);
+  }
+
+  url::SchemeHostPort main_frame_origin(main_frame_url);
+  auto it = main_frames_.Get(main_frame_origin);
+  if (it == main_frames_.end())
+    it = main_frames_.Put(main_frame_origin, MainFrameStats());
+  MainFrameStats& stats = it->second;
+
+  if (stats.navigation_count == kMaxNavigationCount) {
+    stats.navigation_count /= 2;
+    for (OriginStats& origin_stats : stats.origins) {
+      origin_stats.hit_count /= 2;
+      origin_stats.connection_count /= 2;
+    }
+    stats.origins.erase(
+        std::remove_if(
+            stats.origins.begin(), stats.origins.end(),
+            [](const OriginStats& origin_stats) {
+              return origin_stats.hit_count == 0;
+            }),
+        stats.origins.end());
+  }
+  ++stats.navigation_count;
+  ++stats.navigation_id;
+}
+
+void HttpPreconnectPredictor::OnRequestCompleted(
+    const GURL& main_frame_url,
+    const GURL& url,
+    PrivacyMode privacy_mode,
+    const LoadTimingInfo& load_timing_info) {
+  // Sockets handed out from a preconnect have no connect times, so only the
+  // lack of a socket tells requests that didn't connect anywhere apart.
+  if (load_timing_info.socket_log_id == NetLogSource::kInvalidId ||
+      !IsLearnable(main_frame_url) || !IsLearnable(url)) {
+    return;
+  }
+
+  url::SchemeHostPort main_frame_origin(main_frame_url);
+  url::SchemeHostPort origin(url);
+  // The main frame request itself is made as early as a preconnect would be.
+  if (origin.Equals(main_frame_origin))
+    return;
+
+  auto it = main_frames_.Peek(main_frame_origin);
+  if (it == main_frames_.end())
+    return;
+  MainFrameStats& stats = it->second;
+
+  auto origin_it = std::find_if(stats.origins.begin(), stats.origins.end(),
+                                [&origin](const OriginStats& origin_stats) {
+                                  return origin_stats.origin.Equals(origin);
+                                });
+  if (origin_it == stats.origins.end()) {
+    if (stats.origins.size() == kMaxOriginsPerMainFrame) {
+      // Replace the origin which least deserves a preconnect.
+      origin_it = std::min_element(
+          stats.origins.begin(), stats.origins.end(),
+          [](const OriginStats& a, const OriginStats& b) {
+            return a.hit_count < b.hit_count ||
+                   (a.hit_count == b.hit_count &&
+                    a.last_navigation_id < b.last_navigation_id);
+          });
+      *origin_it = OriginStats(origin);
+    } else {
+      stats.origins.push_back(OriginStats(origin));
+      origin_it = stats.origins.end() - 1;
+    }
+  }
+
+  origin_it->privacy_mode = privacy_mode;
+  if (origin_it->last_navigation_id != stats.navigation_id) {
+    origin_it->last_navigation_id = stats.navigation_id;
+    ++origin_it->hit_count;
+  }
+  // Reused sockets still make a hit, as the origin is needed. Preconnecting to
+  // it then costs nothing if the sockets are still idle, since only missing
+  // sockets are opened.
+  if (!load_timing_info.socket_reused)
+    ++origin_it->connection_count;
+}
+
+std::vector<std::pair<url::SchemeHostPort, int>>
+HttpPreconnectPredictor::Predict(const GURL& main_frame_url) const {
+  std::vector<std::pair<url::SchemeHostPort, int>> predictions;
+  for (const auto& prediction : PredictOrigins(main_frame_url)) {
+    predictions.push_back(
+        std::make_pair(prediction.first->origin, prediction.second));
+  }
+  return predictions;
+}
+
+void HttpPreconnectPredictor::Clear() {
+  main_frames_.Clear();
+}
+
+void HttpPreconnectPredictor::Preconnect(const url::SchemeHostPort& origin,
+                                         PrivacyMode privacy_mode,
+                                         int num_sockets) {
+  HttpRequestInfo request_info;
+  request_info.url = origin.GetURL();
+  request_info.method = "GET";
+  request_info.load_flags = 0;
+  request_info.privacy_mode = privacy_mode;
+  request_info.traffic_annotation =
+      MutableNetworkTrafficAnnotationTag(kTrafficAnnotation);
+  session_->http_stream_factory()->PreconnectStreams(num_sockets,
+                                                     request_info);
+}
+
+std::vector<std::pair<const HttpPreconnectPredictor::OriginStats*, int>>
+HttpPreconnectPredictor::PredictOrigins(const GURL& main_frame_url) const {
+  std::vector<std::pair<const OriginStats*, int>> predictions;
+  if (!IsLearnable(main_frame_url))
+    return predictions;
+  auto it = main_frames_.Peek(url::SchemeHostPort(main_frame_url));
+  if (it == main_frames_.end())
+    return predictions;
+  const MainFrameStats& stats = it->second;
+
+  // Only the origins used on at least half of the navigations are predicted.
+  std::vector<const OriginStats*> candidates;
+  for (const OriginStats& origin_stats : stats.origins) {
+    if (origin_stats.hit_count * 2 >= stats.navigation_count)
+      candidates.push_back(&origin_stats);
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const OriginStats* a, const OriginStats* b) {
+                     return a->hit_count > b->hit_count;
+                   });
+
+  int sockets_left = kMaxPreconnectSockets;
+  for (const OriginStats* origin_stats : candidates) {
+    if (predictions.size() == kMaxPreconnectOrigins || sockets_left == 0)
+      break;
+    // Round the average number of connections per navigation.
+    int num_sockets =
+        (origin_stats->connection_count + origin_stats->hit_count / 2) /
+        origin_stats->hit_count;
+    num_sockets = std::max(1, std::min(num_sockets, kMaxSocketsPerOrigin));
+    num_sockets = std::min(num_sockets, sockets_left);
+    sockets_left -= num_sockets;
+    predictions.push_back(std::make_pair(origin_stats, num_sockets));
+  }
+  return predictions;
+}
+
+}  // namespace net
@@ -0,0 +1,138 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_HTTP_HTTP_PRECONNECT_PREDICTOR_H_
+#define NET_HTTP_HTTP_PRECONNECT_PREDICTOR_H_
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "net/base/net_export.h"
+#include "net/base/privacy_mode.h"
+#include "url/scheme_host_port.h"
+
+class GURL;
+
+namespace net {
+
+class HttpNetworkSession;
+struct LoadTimingInfo;
+
+// HttpPreconnectPredictor learns which origins the navigations to a given
+// main frame origin connect to, and preconnects to them when a navigation to
+// that main frame origin starts again, to take the connection setup off the
+// critical path of the subresource requests.
+//
+// Sockets are requested through HttpStreamFactory::PreconnectStreams(), so
+// they go to the socket pools that the actual requests would use, through the
+// same proxies and with the same privacy mode. Each navigation is given a
+// bounded budget of preconnects, and only origins used on most recent
+// navigations are preconnected to, so that mispredictions don't waste many
+// sockets.
+//
+// The HttpNetworkSession owns the predictor when
+// HttpNetworkSession::Params::enable_http_preconnect_predictor is set, and
+// URLRequestHttpJob tells it about main frame requests and about the requests
+// made on their behalf.
+class NET_EXPORT HttpPreconnectPredictor {
+ public:
+  // The maximum number of main frame origins to learn about.
+  static const size_t kMaxMainFrameOrigins = 100;
+  // The maximum number of origins learned for each main frame origin.
+  static const size_t kMaxOriginsPerMainFrame = 16;
+  // The maximum number of origins and of sockets preconnected for a single
+  // navigation.
+  static const size_t kMaxPreconnectOrigins = 4;
+  static const int kMaxPreconnectSockets = 6;
+  // The maximum number of sockets preconnected for a single origin.
+  static const int kMaxSocketsPerOrigin = 2;
+  // After this many navigations to a main frame origin, the counts of its
+  // origins are halved, so that the predictions follow changes to the site.
+  static const int kMaxNavigationCount = 16;
+
+  // |session| must outlive the predictor.
+  explicit HttpPreconnectPredictor(HttpNetworkSession* session);
+  virtual ~HttpPreconnectPredictor();
+
+  // Called when a navigation to |main_frame_url| starts. Preconnects to the
+  // origins predicted for it, and starts learning the origins that the
+  // navigation connects to.
+  void OnNavigationStarted(const GURL& main_frame_url);
+
+  // Called when a request to |url| made on behalf of the navigation to
+  // |main_frame_url| with |privacy_mode| received its response headers.
+  // Requests which used a socket, as told by |load_timing_info|, are learned
+  // from, whether the socket was new, preconnected or reused. Requests without
+  // a socket, like cache hits, are not.
+  void OnRequestCompleted(const GURL& main_frame_url,
+                          const GURL& url,
+                          PrivacyMode privacy_mode,
+                          const LoadTimingInfo& load_timing_info);
+
+  // Returns the origins to preconnect to for a navigation to an origin of
+  // |main_frame_url|, with the number of sockets for each, most confident
+  // first.
+  std::vector<std::pair<url::SchemeHostPort, int>> Predict(
+      const GURL& main_frame_url) const;
+
+  // Forgets everything that was learned.
+  void Clear();
+
+ protected:
+  // Preconnects |num_sockets| sockets to |origin| with |privacy_mode|.
+  // Virtual for testing.
+  virtual void Preconnect(const url::SchemeHostPort& origin,
+                          PrivacyMode privacy_mode,
+                          int num_sockets);
+
+ private:
+  struct OriginStats {
+    explicit OriginStats(const url::SchemeHostPort& origin);
+
+    url::SchemeHostPort origin;
+    // The privacy mode of the latest request to |origin|.
+    PrivacyMode privacy_mode;
+    // The number of navigations that used sockets to |origin|.
+    int hit_count;
+    // The number of sockets to |origin| which were not reused from earlier
+    // requests on those navigations. Preconnected sockets count, so that the
+    // predictions hold once they are in use.
+    int connection_count;
+    // The id of the last navigation which used a socket to |origin|.
+    int last_navigation_id;
+  };
+
+  struct MainFrameStats {
+    MainFrameStats();
+    MainFrameStats(const MainFrameStats& other);
+    ~MainFrameStats();
+
+    // The number of navigations to the main frame origin, halved along with
+    // the counts of |origins| every kMaxNavigationCount navigations.
+    int navigation_count;
+    // Identifies the latest navigation to the main frame origin.
+    int navigation_id;
+    std::vector<OriginStats> origins;
+  };
+
+  using MainFrameMap = base::MRUCache<url::SchemeHostPort, MainFrameStats>;
+
+  // Returns the stats of the origins to preconnect to for a navigation to an
+  // origin of |main_frame_url|, with the number of sockets for each.
+  std::vector<std::pair<const OriginStats*, int>> PredictOrigins(
+      const GURL& main_frame_url) const;
+
+  HttpNetworkSession* const session_;
+  MainFrameMap main_frames_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpPreconnectPredictor);
+};
+
+}  // namespace net
+
+#endif  // NET_HTTP_HTTP_PRECONNECT_PREDICTOR_H_
@@ -0,0 +1,241 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_preconnect_predictor.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/time/time.h"
+#include "net/base/load_timing_info.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const char kMainFrameUrl[] = "https://www.example.com/index.html";
+
+class TestPreconnectPredictor : public HttpPreconnectPredictor {
+ public:
+  TestPreconnectPredictor() : HttpPreconnectPredictor(nullptr) {}
+
+  // The origins preconnected to, serialized, with their number of sockets.
+  std::vector<std::pair<std::string, int>> preconnects() const {
+    std::vector<std::pair<std::string, int>> preconnects;
+    for (const auto& preconnect : preconnects_)
+      preconnects.push_back({preconnect.first.Serialize(), preconnect.second});
+    return preconnects;
+  }
+
+  // The privacy modes of the preconnects.
+  const std::vector<PrivacyMode>& privacy_modes() const {
+    return privacy_modes_;
+  }
+
+  void clear_preconnects() {
+    preconnects_.clear();
+    privacy_modes_.clear();
+  }
+
+ private:
+  void Preconnect(const url::SchemeHostPort& origin,
+                  PrivacyMode privacy_mode,
+                  int num_sockets) override {
+    preconnects_.push_back(std::make_pair(origin, num_sockets));
+    privacy_modes_.push_back(privacy_mode);
+  }
+
+  std::vector<std::pair<url::SchemeHostPort, int>> preconnects_;
+  std::vector<PrivacyMode> privacy_modes_;
+};
+
+LoadTimingInfo NewConnectionTiming() {
+  LoadTimingInfo load_timing_info;
+  load_timing_info.socket_log_id = 1;
+  load_timing_info.socket_reused = false;
+  load_timing_info.connect_timing.connect_start = base::TimeTicks::Now();
+  load_timing_info.connect_timing.connect_end = base::TimeTicks::Now();
+  return load_timing_info;
+}
+
+// Sockets handed out from a preconnect have no connect times.
+LoadTimingInfo PreconnectedSocketTiming() {
+  LoadTimingInfo load_timing_info;
+  load_timing_info.socket_log_id = 1;
+  load_timing_info.socket_reused = false;
+  return load_timing_info;
+}
+
+LoadTimingInfo ReusedSocketTiming() {
+  LoadTimingInfo load_timing_info;
+  load_timing_info.socket_log_id = 1;
+  load_timing_info.socket_reused = true;
+  return load_timing_info;
+}
+
+std::vector<std::pair<std::string, int>> Serialize(
+    const std::vector<std::pair<url::SchemeHostPort, int>>& predictions) {
+  std::vector<std::pair<std::string, int>> serialized;
+  for (const auto& prediction : predictions)
+    serialized.push_back({prediction.first.Serialize(), prediction.second});
+  return serialized;
+}
+
+}  // namespace
+
+class HttpPreconnectPredictorTest : public testing::Test {
+ protected:
+  // Simulates a navigation to kMainFrameUrl which opens |num_connections|
+  // new connections to each of |urls|.
+  void Navigate(const std::vector<std::string>& urls, int num_connections) {
+    predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+    predictor_.OnRequestCompleted(GURL(kMainFrameUrl), GURL(kMainFrameUrl),
+                                  PRIVACY_MODE_DISABLED, NewConnectionTiming());
+    for (const std::string& url : urls) {
+      for (int i = 0; i < num_connections; ++i) {
+        predictor_.OnRequestCompleted(GURL(kMainFrameUrl), GURL(url),
+                                      PRIVACY_MODE_DISABLED,
+                                      NewConnectionTiming());
+      }
+      predictor_.OnRequestCompleted(GURL(kMainFrameUrl), GURL(url),
+                                    PRIVACY_MODE_DISABLED,
+                                    ReusedSocketTiming());
+    }
+  }
+
+  TestPreconnectPredictor predictor_;
+};
+
+TEST_F(HttpPreconnectPredictorTest, NothingLearned) {
+  predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+  EXPECT_TRUE(predictor_.preconnects().empty());
+}
+
+TEST_F(HttpPreconnectPredictorTest, PreconnectsLearnedOrigins) {
+  Navigate({"https://cdn.example.com/app.js", "https://fonts.example.net/a"},
+           1);
+  predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+  std::vector<std::pair<std::string, int>> expected = {
+      {"https://cdn.example.com", 1},
+      {"https://fonts.example.net", 1}};
+  EXPECT_EQ(expected, predictor_.preconnects());
+
+  // Other main frame origins aren't affected.
+  predictor_.clear_preconnects();
+  predictor_.OnNavigationStarted(GURL("https://other.example.com/"));
+  EXPECT_TRUE(predictor_.preconnects().empty());
+}
+
+TEST_F(HttpPreconnectPredictorTest, IgnoresRequestsWithoutSocketAndMainFrame) {
+  predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+  predictor_.OnRequestCompleted(GURL(kMainFrameUrl),
+                                GURL("https://www.example.com/style.css"),
+                                PRIVACY_MODE_DISABLED, NewConnectionTiming());
+  // Requests answered from the cache have no socket.
+  predictor_.OnRequestCompleted(GURL(kMainFrameUrl),
+                                GURL("https://cdn.example.com/app.js"),
+                                PRIVACY_MODE_DISABLED, LoadTimingInfo());
+  EXPECT_TRUE(predictor_.Predict(GURL(kMainFrameUrl)).empty());
+}
+
+// Preconnected sockets are hits, so that the predictions don't fade out once
+// they are used.
+TEST_F(HttpPreconnectPredictorTest, LearnsFromPreconnectedSockets) {
+  Navigate({"https://cdn.example.com/app.js"}, 2);
+  for (int i = 0; i < HttpPreconnectPredictor::kMaxNavigationCount * 2; ++i) {
+    predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+    for (int j = 0; j < 2; ++j) {
+      predictor_.OnRequestCompleted(GURL(kMainFrameUrl),
+                                    GURL("https://cdn.example.com/app.js"),
+                                    PRIVACY_MODE_DISABLED,
+                                    PreconnectedSocketTiming());
+    }
+  }
+  std::vector<std::pair<std::string, int>> expected = {
+      {"https://cdn.example.com", 2}};
+  EXPECT_EQ(expected, Serialize(predictor_.Predict(GURL(kMainFrameUrl))));
+}
+
+// Origins reached over reused sockets only are still predicted, with a single
+// socket.
+TEST_F(HttpPreconnectPredictorTest, LearnsFromReusedSockets) {
+  predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+  predictor_.OnRequestCompleted(GURL(kMainFrameUrl),
+                                GURL("https://cdn.example.com/app.js"),
+                                PRIVACY_MODE_DISABLED, ReusedSocketTiming());
+  std::vector<std::pair<std::string, int>> expected = {
+      {"https://cdn.example.com", 1}};
+  EXPECT_EQ(expected, Serialize(predictor_.Predict(GURL(kMainFrameUrl))));
+}
+
+TEST_F(HttpPreconnectPredictorTest, PreconnectsWithPrivacyMode) {
+  predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+  predictor_.OnRequestCompleted(GURL(kMainFrameUrl),
+                                GURL("https://cdn.example.com/app.js"),
+                                PRIVACY_MODE_ENABLED, NewConnectionTiming());
+  predictor_.OnNavigationStarted(GURL(kMainFrameUrl));
+  ASSERT_EQ(1u, predictor_.privacy_modes().size());
+  EXPECT_EQ(PRIVACY_MODE_ENABLED, predictor_.privacy_modes()[0]);
+}
+
+TEST_F(HttpPreconnectPredictorTest, IgnoresRequestsWithoutNavigation) {
+  predictor_.OnRequestCompleted(GURL(kMainFrameUrl),
+                                GURL("https://cdn.example.com/app.js"),
+                                PRIVACY_MODE_DISABLED, NewConnectionTiming());
+  EXPECT_TRUE(predictor_.Predict(GURL(kMainFrameUrl)).empty());
+}
+
+TEST_F(HttpPreconnectPredictorTest, NumSockets) {
+  Navigate({"https://cdn.example.com/app.js"}, 2);
+  Navigate({"https://cdn.example.com/app.js"}, 3);
+  std::vector<std::pair<std::string, int>> expected = {
+      {"https://cdn.example.com", 2}};
+  EXPECT_EQ(expected, Serialize(predictor_.Predict(GURL(kMainFrameUrl))));
+}
+
+TEST_F(HttpPreconnectPredictorTest, OnlyConfidentOrigins) {
+  Navigate({"https://cdn.example.com/app.js", "https://ads.example.net/a"}, 1);
+  Navigate({"https://cdn.example.com/app.js"}, 1);
+  Navigate({"https://cdn.example.com/app.js"}, 1);
+  std::vector<std::pair<std::string, int>> expected = {
+      {"https://cdn.example.com", 1}};
+  EXPECT_EQ(expected, Serialize(predictor_.Predict(GURL(kMainFrameUrl))));
+}
+
+TEST_F(HttpPreconnectPredictorTest, Budget) {
+  std::vector<std::string> urls;
+  for (int i = 0; i < 10; ++i)
+    urls.push_back("https://cdn" + std::to_string(i) + ".example.com/");
+  Navigate(urls, HttpPreconnectPredictor::kMaxSocketsPerOrigin);
+
+  std::vector<std::pair<url::SchemeHostPort, int>> predictions =
+      predictor_.Predict(GURL(kMainFrameUrl));
+  EXPECT_GE(HttpPreconnectPredictor::kMaxPreconnectOrigins,
+            predictions.size());
+  int num_sockets = 0;
+  for (const auto& prediction : predictions)
+    num_sockets += prediction.second;
+  EXPECT_EQ(HttpPreconnectPredictor::kMaxPreconnectSockets, num_sockets);
+}
+
+TEST_F(HttpPreconnectPredictorTest, ForgetsStaleOrigins) {
+  Navigate({"https://old.example.com/"}, 1);
+  for (int i = 0; i < HttpPreconnectPredictor::kMaxNavigationCount * 2; ++i)
+    Navigate({"https://new.example.com/"}, 1);
+  std::vector<std::pair<std::string, int>> expected = {
+      {"https://new.example.com", 1}};
+  EXPECT_EQ(expected, Serialize(predictor_.Predict(GURL(kMainFrameUrl))));
+}
+
+TEST_F(HttpPreconnectPredictorTest, Clear) {
+  Navigate({"https://cdn.example.com/app.js"}, 1);
+  EXPECT_FALSE(predictor_.Predict(GURL(kMainFrameUrl)).empty());
+  predictor_.Clear();
+  EXPECT_TRUE(predictor_.Predict(GURL(kMainFrameUrl)).empty());
+}
+
+}  // namespace net
@@ -647,7 +647,11 @@ disk_cache::Backend* MockHttpCache::backend() {
 }
 
 MockDiskCache* MockHttpCache::disk_cache() {
-  return static_cast<MockDiskCache*>(backend());
+  // Don't go through GetBackend() once the backend exists, since that clears
+  // the tier of hot entries.
+  disk_cache::Backend* current_backend = http_cache_.GetCurrentBackend();
+  return static_cast<MockDiskCache*>(current_backend ? current_backend
+                                                     : backend());
 }
 
 int MockHttpCache::CreateTransaction(std::unique_ptr<HttpTransaction>* trans) {
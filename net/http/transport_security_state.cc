@@ -10,6 +10,7 @@
 
 #include "base/base64.h"
 #include "base/build_time.h"
+#include "base/containers/mru_cache.h"
 #include "base/containers/span.h"
 #include "base/json/json_writer.h"
 #include "base/logging.h"
@@ -23,6 +24,9 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
 #include "base/time/time_to_iso8601.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "base/values.h"
 #include "build/build_config.h"
 #include "crypto/sha2.h"
@@ -54,6 +58,9 @@ const TransportSecurityStateSource* const kDefaultHSTSSource = nullptr;
 
 const TransportSecurityStateSource* g_hsts_source = kDefaultHSTSSource;
 
+// The number of hosts whose preload list lookups are cached.
+const size_t kMaxPreloadCacheEntries = 256;
+
 // Parameters for remembering sent HPKP and Expect-CT reports.
 const size_t kMaxReportCacheEntries = 50;
 const int kTimeToRememberReportsMins = 60;
@@ -393,6 +400,50 @@ bool DecodeHSTSPreload(const std::string& search_hostname, PreloadResult* out) {
 
 }  // namespace
 
+// Caches the results of DecodeHSTSPreload() for recently looked up hosts.
+// Decoding walks the Huffman coded trie bit by bit, and is repeated for the
+// static STS, PKP and Expect-CT state of a host on each of its connections.
+class TransportSecurityState::PreloadCache {
+ public:
+  PreloadCache() : source_(g_hsts_source), entries_(kMaxPreloadCacheEntries) {}
+
+  // Same as DecodeHSTSPreload().
+  bool Decode(const std::string& host, PreloadResult* out) {
+    // Tests can change the source.
+    if (source_ != g_hsts_source) {
+      entries_.Clear();
+      source_ = g_hsts_source;
+    }
+
+    auto it = entries_.Get(host);
+    if (it == entries_.end()) {
+      Entry entry;
+      entry.found = DecodeHSTSPreload(host, &entry.result);
+      it = entries_.Put(host, entry);
+    }
+    if (it->second.found)
+      *out = it->second.result;
+    return it->second.found;
+  }
+
+  size_t size() const { return entries_.size(); }
+
+  size_t EstimateMemoryUsage() const {
+    return base::trace_event::EstimateMemoryUsage(entries_);
+  }
+
+ private:
+  struct Entry {
+    bool found = false;
+    PreloadResult result;
+  };
+
+  const TransportSecurityStateSource* source_;
+  base::MRUCache<std::string, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreloadCache);
+};
+
 // static
 const base::Feature TransportSecurityState::kDynamicExpectCTFeature{
     "DynamicExpectCT", base::FEATURE_ENABLED_BY_DEFAULT};
@@ -407,7 +458,8 @@ TransportSecurityState::TransportSecurityState()
       enable_static_expect_ct_(true),
       enable_pkp_bypass_for_local_trust_anchors_(true),
       sent_hpkp_reports_cache_(kMaxReportCacheEntries),
-      sent_expect_ct_reports_cache_(kMaxReportCacheEntries) {
+      sent_expect_ct_reports_cache_(kMaxReportCacheEntries),
+      preload_cache_(std::make_unique<PreloadCache>()) {
 // Static pinning is only enabled for official builds to make sure that
 // others don't end up with pins that cannot be easily updated.
 #if !defined(GOOGLE_CHROME_BUILD) || defined(OS_ANDROID) || defined(OS_IOS)
@@ -818,7 +870,7 @@ bool TransportSecurityState::GetStaticExpectCTState(
     return false;
 
   PreloadResult result;
-  if (!DecodeHSTSPreload(host, &result))
+  if (!preload_cache_->Decode(host, &result))
     return false;
 
   if (!enable_static_expect_ct_ || !result.expect_ct)
@@ -1153,6 +1205,19 @@ void TransportSecurityState::ClearReportCachesForTesting() {
   sent_expect_ct_reports_cache_.Clear();
 }
 
+void TransportSecurityState::DumpMemoryStats(
+    base::trace_event::ProcessMemoryDump* pmd,
+    const std::string& parent_absolute_name) const {
+  base::trace_event::MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(
+      parent_absolute_name + "/transport_security_state/preload_cache");
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  preload_cache_->EstimateMemoryUsage());
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  preload_cache_->size());
+}
+
 // static
 bool TransportSecurityState::IsBuildTimely() {
   const base::Time build_time = base::GetBuildTime();
@@ -1190,7 +1255,7 @@ bool TransportSecurityState::GetStaticDomainState(const std::string& host,
     return false;
 
   PreloadResult result;
-  if (!DecodeHSTSPreload(host, &result))
+  if (!preload_cache_->Decode(host, &result))
     return false;
 
   if (result.force_https) {
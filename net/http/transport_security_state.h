@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "base/callback.h"
@@ -24,6 +25,12 @@
 #include "net/http/transport_security_state_source.h"
 #include "url/gurl.h"
 
+namespace base {
+namespace trace_event {
+class ProcessMemoryDump;
+}
+}  // namespace base
+
 namespace net {
 
 namespace ct {
@@ -561,7 +568,14 @@ class NET_EXPORT TransportSecurityState {
   // Expect-CT reports.
   void ClearReportCachesForTesting();
 
+  // Dumps memory allocation stats. |parent_absolute_name| is the name of the
+  // parent MemoryAllocatorDump in the memory dump hierarchy.
+  void DumpMemoryStats(base::trace_event::ProcessMemoryDump* pmd,
+                       const std::string& parent_absolute_name) const;
+
  private:
+  class PreloadCache;
+
   friend class TransportSecurityStateTest;
   friend class TransportSecurityStateStaticFuzzer;
   FRIEND_TEST_ALL_PREFIXES(HttpSecurityHeadersTest, UpdateDynamicPKPOnly);
@@ -688,6 +702,10 @@ class NET_EXPORT TransportSecurityState {
   ReportCache sent_hpkp_reports_cache_;
   ReportCache sent_expect_ct_reports_cache_;
 
+  // Caches the preload list lookups of recent hosts. Mutable since it's
+  // filled by the const getters of the static state.
+  mutable std::unique_ptr<PreloadCache> preload_cache_;
+
   THREAD_CHECKER(thread_checker_);
 
   DISALLOW_COPY_AND_ASSIGN(TransportSecurityState);
@@ -1261,6 +1261,37 @@ TEST_F(TransportSecurityStateTest, DecodePreloadedSingle) {
   EXPECT_FALSE(GetExpectCTState(&state, "hsts.example.com", &ct_state));
 }
 
+// Tests that the cached lookups of the preload list give the same results
+// as the first ones, and follow changes of the source.
+TEST_F(TransportSecurityStateTest, DecodePreloadedCached) {
+  SetTransportSecurityStateSourceForTesting(&test1::kHSTSSource);
+
+  TransportSecurityState state;
+  TransportSecurityStateTest::EnableStaticPins(&state);
+
+  for (int i = 0; i < 2; ++i) {
+    TransportSecurityState::STSState sts_state;
+    TransportSecurityState::PKPState pkp_state;
+    EXPECT_TRUE(GetStaticDomainState(&state, "sub.hsts.example.com",
+                                     &sts_state, &pkp_state));
+    EXPECT_EQ("hsts.example.com", sts_state.domain);
+    EXPECT_EQ(TransportSecurityState::STSState::MODE_FORCE_HTTPS,
+              sts_state.upgrade_mode);
+    EXPECT_EQ(1u, pkp_state.spki_hashes.size());
+    EXPECT_FALSE(
+        GetStaticDomainState(&state, "example.org", &sts_state, &pkp_state));
+  }
+
+  SetTransportSecurityStateSourceForTesting(&test3::kHSTSSource);
+  TransportSecurityState::STSState sts_state;
+  TransportSecurityState::PKPState pkp_state;
+  EXPECT_TRUE(
+      GetStaticDomainState(&state, "example.org", &sts_state, &pkp_state));
+  EXPECT_TRUE(GetStaticDomainState(&state, "sub.hsts.example.com", &sts_state,
+                                   &pkp_state));
+  EXPECT_EQ("example.com", sts_state.domain);
+}
+
 // More advanced test for the HSTS preload process where the trie (generated
 // from transport_security_state_static_unittest2.json) contains multiple
 // entries with a common prefix. Test that the lookup methods can find all
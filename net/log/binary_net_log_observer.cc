@@ -0,0 +1,676 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/log/binary_net_log_observer.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bit_cast.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
+#include "base/values.h"
+#include "net/log/net_log_capture_mode.h"
+#include "net/log/net_log_entry.h"
+#include "net/log/net_log_util.h"
+
+namespace net {
+
+namespace {
+
+// Identifies event files, and the version of their format.
+const uint32_t kEventFileMagic = 0x4e4c4231;
+const uint32_t kEventFileVersion = 1;
+// The magic number, the version and the file number.
+const size_t kEventFileHeaderSize = 16;
+
+// Records are handed over to the file task runner in chunks of this size.
+const size_t kChunkSize = 64 * 1024;
+
+// Each record is prefixed with its size, as a 32 bit integer.
+const size_t kRecordSizeSize = 4;
+
+// Protects the converter from corrupt deeply nested parameters.
+const int kMaxValueDepth = 64;
+
+const char kConstantsFileName[] = "constants.json";
+const char kClosingFileName[] = "end_netlog.json";
+
+// Tags of the serialized base::Values.
+enum ValueTag : uint8_t {
+  VALUE_NONE,
+  VALUE_FALSE,
+  VALUE_TRUE,
+  VALUE_INT,
+  VALUE_DOUBLE,
+  VALUE_STRING,
+  VALUE_BINARY,
+  VALUE_DICTIONARY,
+  VALUE_LIST,
+};
+
+base::FilePath GetEventFilePath(const base::FilePath& log_dir, size_t index) {
+  return log_dir.AppendASCII("events_" + base::NumberToString(index) + ".bin");
+}
+
+// Appends |value| in little-endian order.
+void AppendFixed32(uint32_t value, std::string* out) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+
+void AppendFixed64(uint64_t value, std::string* out) {
+  AppendFixed32(static_cast<uint32_t>(value), out);
+  AppendFixed32(static_cast<uint32_t>(value >> 32), out);
+}
+
+// Appends |value| as a LEB128 varint.
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Appends |value| as a zigzag encoded varint, so that small negative values
+// stay small.
+void AppendSignedVarint(int64_t value, std::string* out) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               out);
+}
+
+void AppendBytes(base::StringPiece bytes, std::string* out) {
+  AppendVarint(bytes.size(), out);
+  out->append(bytes.data(), bytes.size());
+}
+
+void AppendValue(const base::Value& value, std::string* out) {
+  switch (value.type()) {
+    case base::Value::Type::NONE:
+      out->push_back(VALUE_NONE);
+      break;
+    case base::Value::Type::BOOLEAN:
+      out->push_back(value.GetBool() ? VALUE_TRUE : VALUE_FALSE);
+      break;
+    case base::Value::Type::INTEGER:
+      out->push_back(VALUE_INT);
+      AppendSignedVarint(value.GetInt(), out);
+      break;
+    case base::Value::Type::DOUBLE:
+      out->push_back(VALUE_DOUBLE);
+      AppendFixed64(bit_cast<uint64_t>(value.GetDouble()), out);
+      break;
+    case base::Value::Type::STRING:
+      out->push_back(VALUE_STRING);
+      AppendBytes(value.GetString(), out);
+      break;
+    case base::Value::Type::BINARY: {
+      const base::Value::BlobStorage& blob = value.GetBlob();
+      out->push_back(VALUE_BINARY);
+      AppendBytes(base::StringPiece(reinterpret_cast<const char*>(blob.data()),
+                                    blob.size()),
+                  out);
+      break;
+    }
+    case base::Value::Type::DICTIONARY: {
+      size_t size = 0;
+      for (const auto& item : value.DictItems()) {
+        ALLOW_UNUSED_LOCAL(item);
+        ++size;
+      }
+      out->push_back(VALUE_DICTIONARY);
+      AppendVarint(size, out);
+      for (const auto& item : value.DictItems()) {
+        AppendBytes(item.first, out);
+        AppendValue(item.second, out);
+      }
+      break;
+    }
+    case base::Value::Type::LIST:
+      out->push_back(VALUE_LIST);
+      AppendVarint(value.GetList().size(), out);
+      for (const base::Value& item : value.GetList())
+        AppendValue(item, out);
+      break;
+  }
+}
+
+// Reads the values appended by the functions above. Any read past the end of
+// the data fails.
+class RecordReader {
+ public:
+  explicit RecordReader(base::StringPiece data) : data_(data) {}
+
+  bool empty() const { return data_.empty(); }
+
+  bool ReadByte(uint8_t* value) {
+    if (data_.empty())
+      return false;
+    *value = static_cast<uint8_t>(data_[0]);
+    data_.remove_prefix(1);
+    return true;
+  }
+
+  bool ReadFixed32(uint32_t* value) {
+    if (data_.size() < 4)
+      return false;
+    *value = 0;
+    for (int i = 3; i >= 0; --i)
+      *value = (*value << 8) | static_cast<uint8_t>(data_[i]);
+    data_.remove_prefix(4);
+    return true;
+  }
+
+  bool ReadFixed64(uint64_t* value) {
+    uint32_t low, high;
+    if (!ReadFixed32(&low) || !ReadFixed32(&high))
+      return false;
+    *value = (static_cast<uint64_t>(high) << 32) | low;
+    return true;
+  }
+
+  bool ReadVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadSignedVarint(int64_t* value) {
+    uint64_t encoded;
+    if (!ReadVarint(&encoded))
+      return false;
+    *value = static_cast<int64_t>(encoded >> 1) ^
+             -static_cast<int64_t>(encoded & 1);
+    return true;
+  }
+
+  bool ReadBytes(base::StringPiece* bytes) {
+    uint64_t size;
+    if (!ReadVarint(&size) || size > data_.size())
+      return false;
+    *bytes = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return true;
+  }
+
+  // Reads |size| bytes, without a size prefix.
+  bool ReadRaw(size_t size, base::StringPiece* bytes) {
+    if (size > data_.size())
+      return false;
+    *bytes = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return true;
+  }
+
+  std::unique_ptr<base::Value> ReadValue(int depth) {
+    uint8_t tag;
+    if (depth > kMaxValueDepth || !ReadByte(&tag))
+      return nullptr;
+    switch (tag) {
+      case VALUE_NONE:
+        return std::make_unique<base::Value>();
+      case VALUE_FALSE:
+      case VALUE_TRUE:
+        return std::make_unique<base::Value>(tag == VALUE_TRUE);
+      case VALUE_INT: {
+        int64_t value;
+        if (!ReadSignedVarint(&value))
+          return nullptr;
+        return std::make_unique<base::Value>(static_cast<int>(value));
+      }
+      case VALUE_DOUBLE: {
+        uint64_t value;
+        if (!ReadFixed64(&value))
+          return nullptr;
+        return std::make_unique<base::Value>(bit_cast<double>(value));
+      }
+      case VALUE_STRING: {
+        base::StringPiece value;
+        if (!ReadBytes(&value))
+          return nullptr;
+        return std::make_unique<base::Value>(value);
+      }
+      case VALUE_BINARY: {
+        base::StringPiece value;
+        if (!ReadBytes(&value))
+          return nullptr;
+        return std::make_unique<base::Value>(
+            std::vector<char>(value.begin(), value.end()));
+      }
+      case VALUE_DICTIONARY: {
+        uint64_t size;
+        if (!ReadVarint(&size))
+          return nullptr;
+        auto dict = std::make_unique<base::DictionaryValue>();
+        for (uint64_t i = 0; i < size; ++i) {
+          base::StringPiece key;
+          if (!ReadBytes(&key))
+            return nullptr;
+          std::unique_ptr<base::Value> item = ReadValue(depth + 1);
+          if (!item)
+            return nullptr;
+          dict->SetKey(key, std::move(*item));
+        }
+        return std::move(dict);
+      }
+      case VALUE_LIST: {
+        uint64_t size;
+        if (!ReadVarint(&size))
+          return nullptr;
+        auto list = std::make_unique<base::ListValue>();
+        for (uint64_t i = 0; i < size; ++i) {
+          std::unique_ptr<base::Value> item = ReadValue(depth + 1);
+          if (!item)
+            return nullptr;
+          list->GetList().push_back(std::move(*item));
+        }
+        return std::move(list);
+      }
+      default:
+        return nullptr;
+    }
+  }
+
+ private:
+  base::StringPiece data_;
+};
+
+// Decodes the record in |data| into the value NetLogEntry::ToValue() would
+// have returned for the event, or returns null if it's corrupt.
+std::unique_ptr<base::Value> RecordToValue(base::StringPiece data) {
+  RecordReader reader(data);
+  uint64_t type, source_id, source_type, phase;
+  int64_t time_us;
+  uint8_t has_params;
+  if (!reader.ReadVarint(&type) || !reader.ReadVarint(&source_id) ||
+      !reader.ReadVarint(&source_type) || !reader.ReadVarint(&phase) ||
+      !reader.ReadSignedVarint(&time_us) || !reader.ReadByte(&has_params)) {
+    return nullptr;
+  }
+
+  auto entry_dict = std::make_unique<base::DictionaryValue>();
+  base::TimeTicks time =
+      base::TimeTicks() + base::TimeDelta::FromMicroseconds(time_us);
+  entry_dict->SetString("time", NetLog::TickCountToString(time));
+  auto source_dict = std::make_unique<base::DictionaryValue>();
+  source_dict->SetInteger("id", static_cast<int>(source_id));
+  source_dict->SetInteger("type", static_cast<int>(source_type));
+  entry_dict->Set("source", std::move(source_dict));
+  entry_dict->SetInteger("type", static_cast<int>(type));
+  entry_dict->SetInteger("phase", static_cast<int>(phase));
+  if (has_params) {
+    std::unique_ptr<base::Value> params = reader.ReadValue(0);
+    if (!params)
+      return nullptr;
+    entry_dict->Set("params", std::move(params));
+  }
+  return std::move(entry_dict);
+}
+
+}  // namespace
+
+// EventBuffer accumulates the records of the events logged on any thread,
+// until they are handed over to the file task runner in chunks. It also keeps
+// track of how much data is waiting to be written, to drop events instead of
+// using unbounded memory when the file task runner falls behind.
+class BinaryNetLogObserver::EventBuffer
+    : public base::RefCountedThreadSafe<EventBuffer> {
+ public:
+  explicit EventBuffer(uint64_t max_pending_size)
+      : pending_size_(0),
+        max_pending_size_(max_pending_size),
+        dropped_event_count_(0) {}
+
+  // Appends the record of |entry|. Returns a chunk of records to write if
+  // enough have built up, or null.
+  std::unique_ptr<std::string> AddEntry(const NetLogEntry& entry) {
+    // Build the parameters before taking the lock, since it's not needed for
+    // that, and it's the slowest part.
+    std::unique_ptr<base::Value> params = entry.ParametersToValue();
+
+    base::AutoLock lock(lock_);
+    if (pending_size_ + records_.size() >= max_pending_size_) {
+      ++dropped_event_count_;
+      return nullptr;
+    }
+
+    size_t start = records_.size();
+    AppendFixed32(0, &records_);
+    AppendVarint(static_cast<uint64_t>(entry.type()), &records_);
+    AppendVarint(entry.source().id, &records_);
+    AppendVarint(static_cast<uint64_t>(entry.source().type), &records_);
+    AppendVarint(static_cast<uint64_t>(entry.phase()), &records_);
+    AppendSignedVarint((entry.time() - base::TimeTicks()).InMicroseconds(),
+                       &records_);
+    records_.push_back(params ? 1 : 0);
+    if (params)
+      AppendValue(*params, &records_);
+
+    // Now that its size is known, fill in the prefix of the record.
+    uint32_t size =
+        static_cast<uint32_t>(records_.size() - start - kRecordSizeSize);
+    for (size_t i = 0; i < kRecordSizeSize; ++i) {
+      records_[start + i] = static_cast<char>(size & 0xFF);
+      size >>= 8;
+    }
+
+    if (records_.size() < kChunkSize)
+      return nullptr;
+    return TakeRecordsLocked();
+  }
+
+  // Returns all the records that haven't been handed over yet.
+  std::unique_ptr<std::string> TakeRecords() {
+    base::AutoLock lock(lock_);
+    return TakeRecordsLocked();
+  }
+
+  // Called on the file task runner once a chunk of |size| bytes has been
+  // written.
+  void OnRecordsWritten(size_t size) {
+    base::AutoLock lock(lock_);
+    DCHECK_GE(pending_size_, size);
+    pending_size_ -= size;
+  }
+
+  size_t dropped_event_count() {
+    base::AutoLock lock(lock_);
+    return dropped_event_count_;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<EventBuffer>;
+
+  ~EventBuffer() = default;
+
+  std::unique_ptr<std::string> TakeRecordsLocked() {
+    lock_.AssertAcquired();
+    auto records = std::make_unique<std::string>();
+    records->reserve(kChunkSize + kChunkSize / 8);
+    records->swap(records_);
+    pending_size_ += records->size();
+    return records;
+  }
+
+  base::Lock lock_;
+  std::string records_;
+  uint64_t pending_size_;
+  const uint64_t max_pending_size_;
+  size_t dropped_event_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventBuffer);
+};
+
+// FileWriter writes the chunks of records to the ring of event files. It can
+// be constructed on any thread, and afterwards is only used on the file task
+// runner.
+class BinaryNetLogObserver::FileWriter {
+ public:
+  FileWriter(const base::FilePath& log_dir,
+             uint64_t max_event_file_size,
+             size_t num_event_files)
+      : log_dir_(log_dir),
+        max_event_file_size_(max_event_file_size),
+        num_event_files_(num_event_files),
+        current_file_number_(0),
+        current_file_size_(0) {}
+
+  ~FileWriter() = default;
+
+  // Creates |log_dir_|, deleting any previous log, and writes
+  // |constants_value| to it.
+  void Initialize(std::unique_ptr<base::Value> constants_value) {
+    base::DeleteFile(log_dir_, true);
+    if (!base::CreateDirectory(log_dir_)) {
+      LOG(ERROR) << "Failed creating: " << log_dir_.value();
+      return;
+    }
+    std::string json;
+    base::JSONWriter::Write(*constants_value, &json);
+    base::WriteFile(log_dir_.AppendASCII(kConstantsFileName), json.data(),
+                    json.size());
+  }
+
+  void Write(scoped_refptr<EventBuffer> event_buffer,
+             std::unique_ptr<std::string> records) {
+    if (!records->empty()) {
+      if (current_file_number_ == 0 ||
+          current_file_size_ >= max_event_file_size_) {
+        OpenNextEventFile();
+      }
+      if (current_file_.IsValid() &&
+          current_file_.WriteAtCurrentPos(records->data(), records->size()) ==
+              static_cast<int>(records->size())) {
+        current_file_size_ += records->size();
+      }
+    }
+    event_buffer->OnRecordsWritten(records->size());
+  }
+
+  void Stop(scoped_refptr<EventBuffer> event_buffer,
+            std::unique_ptr<std::string> records,
+            std::unique_ptr<base::Value> polled_data) {
+    Write(std::move(event_buffer), std::move(records));
+    current_file_.Close();
+    if (polled_data) {
+      std::string json;
+      base::JSONWriter::Write(*polled_data, &json);
+      base::WriteFile(log_dir_.AppendASCII(kClosingFileName), json.data(),
+                      json.size());
+    }
+  }
+
+  void DeleteAllFiles() {
+    current_file_.Close();
+    base::DeleteFile(log_dir_, true);
+  }
+
+ private:
+  void OpenNextEventFile() {
+    ++current_file_number_;
+    size_t index = (current_file_number_ - 1) % num_event_files_;
+    current_file_.Initialize(
+        GetEventFilePath(log_dir_, index),
+        base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    current_file_size_ = 0;
+    if (!current_file_.IsValid())
+      return;
+
+    std::string header;
+    AppendFixed32(kEventFileMagic, &header);
+    AppendFixed32(kEventFileVersion, &header);
+    AppendFixed64(current_file_number_, &header);
+    DCHECK_EQ(kEventFileHeaderSize, header.size());
+    current_file_.WriteAtCurrentPos(header.data(), header.size());
+  }
+
+  const base::FilePath log_dir_;
+  const uint64_t max_event_file_size_;
+  const size_t num_event_files_;
+
+  // Starts at 1 for the first file, and keeps increasing when the files are
+  // reused, so that the converter can put them back in order.
+  uint64_t current_file_number_;
+  base::File current_file_;
+  uint64_t current_file_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileWriter);
+};
+
+// static
+std::unique_ptr<BinaryNetLogObserver> BinaryNetLogObserver::Create(
+    const base::FilePath& log_dir,
+    uint64_t max_total_size,
+    size_t num_event_files,
+    std::unique_ptr<base::Value> constants) {
+  DCHECK_GT(num_event_files, 0u);
+
+  // As for FileNetLogObserver, these tasks block shutdown so that the log is
+  // complete.
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner =
+      base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
+
+  auto file_writer = std::make_unique<FileWriter>(
+      log_dir, max_total_size / num_event_files, num_event_files);
+  // Let a few chunks be in flight even with a small limit.
+  auto event_buffer = base::MakeRefCounted<EventBuffer>(
+      std::max<uint64_t>(max_total_size, 4 * kChunkSize));
+
+  return base::WrapUnique(new BinaryNetLogObserver(
+      std::move(file_task_runner), std::move(file_writer),
+      std::move(event_buffer), std::move(constants)));
+}
+
+BinaryNetLogObserver::~BinaryNetLogObserver() {
+  if (net_log()) {
+    // StopObserving was not called.
+    net_log()->RemoveObserver(this);
+    file_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&FileWriter::DeleteAllFiles,
+                                  base::Unretained(file_writer_.get())));
+  }
+  file_task_runner_->DeleteSoon(FROM_HERE, file_writer_.release());
+}
+
+void BinaryNetLogObserver::StartObserving(NetLog* net_log,
+                                          NetLogCaptureMode capture_mode) {
+  net_log->AddObserver(this, capture_mode);
+}
+
+void BinaryNetLogObserver::StopObserving(
+    std::unique_ptr<base::Value> polled_data,
+    base::OnceClosure optional_callback) {
+  net_log()->RemoveObserver(this);
+
+  base::OnceClosure stop = base::BindOnce(
+      &FileWriter::Stop, base::Unretained(file_writer_.get()), event_buffer_,
+      event_buffer_->TakeRecords(), std::move(polled_data));
+  if (!optional_callback.is_null()) {
+    file_task_runner_->PostTaskAndReply(FROM_HERE, std::move(stop),
+                                        std::move(optional_callback));
+  } else {
+    file_task_runner_->PostTask(FROM_HERE, std::move(stop));
+  }
+}
+
+void BinaryNetLogObserver::OnAddEntry(const NetLogEntry& entry) {
+  std::unique_ptr<std::string> records = event_buffer_->AddEntry(entry);
+  if (!records)
+    return;
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&FileWriter::Write, base::Unretained(file_writer_.get()),
+                     event_buffer_, std::move(records)));
+}
+
+size_t BinaryNetLogObserver::GetDroppedEventCountForTesting() {
+  return event_buffer_->dropped_event_count();
+}
+
+BinaryNetLogObserver::BinaryNetLogObserver(
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    std::unique_ptr<FileWriter> file_writer,
+    scoped_refptr<EventBuffer> event_buffer,
+    std::unique_ptr<base::Value> constants)
+    : file_task_runner_(std::move(file_task_runner)),
+      event_buffer_(std::move(event_buffer)),
+      file_writer_(std::move(file_writer)) {
+  if (!constants)
+    constants = GetNetConstants();
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&FileWriter::Initialize,
+                     base::Unretained(file_writer_.get()),
+                     std::move(constants)));
+}
+
+bool ConvertBinaryNetLogToJson(const base::FilePath& log_dir,
+                               std::string* json) {
+  std::string constants;
+  if (!base::ReadFileToString(log_dir.AppendASCII(kConstantsFileName),
+                              &constants)) {
+    return false;
+  }
+
+  // Put the event files back in the order they were written in.
+  std::vector<std::pair<uint64_t, std::string>> event_files;
+  for (size_t index = 0;; ++index) {
+    std::string contents;
+    if (!base::ReadFileToString(GetEventFilePath(log_dir, index), &contents))
+      break;
+    RecordReader reader(contents);
+    uint32_t magic, version;
+    uint64_t file_number;
+    if (!reader.ReadFixed32(&magic) || !reader.ReadFixed32(&version) ||
+        !reader.ReadFixed64(&file_number) || magic != kEventFileMagic ||
+        version != kEventFileVersion) {
+      continue;
+    }
+    event_files.emplace_back(file_number, std::move(contents));
+  }
+  std::sort(event_files.begin(), event_files.end(),
+            [](const std::pair<uint64_t, std::string>& a,
+               const std::pair<uint64_t, std::string>& b) {
+              return a.first < b.first;
+            });
+
+  *json = "{\"constants\":" + constants + ",\n\"events\": [\n";
+  bool wrote_event = false;
+  for (const auto& event_file : event_files) {
+    RecordReader reader(
+        base::StringPiece(event_file.second).substr(kEventFileHeaderSize));
+    while (!reader.empty()) {
+      uint32_t size;
+      base::StringPiece record;
+      if (!reader.ReadFixed32(&size) || !reader.ReadRaw(size, &record))
+        break;
+      std::unique_ptr<base::Value> event = RecordToValue(record);
+      std::string event_json;
+      if (!event || !base::JSONWriter::Write(*event, &event_json))
+        continue;
+      if (wrote_event)
+        json->append(",\n");
+      json->append(event_json);
+      wrote_event = true;
+    }
+  }
+  json->append("]");
+
+  std::string polled_data;
+  if (base::ReadFileToString(log_dir.AppendASCII(kClosingFileName),
+                             &polled_data) &&
+      !polled_data.empty()) {
+    json->append(",\n\"polledData\": " + polled_data + "\n");
+  }
+  json->append("}\n");
+  return true;
+}
+
+}  // namespace net
@@ -0,0 +1,107 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_LOG_BINARY_NET_LOG_OBSERVER_H_
+#define NET_LOG_BINARY_NET_LOG_OBSERVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/callback_forward.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "net/base/net_export.h"
+#include "net/log/net_log.h"
+
+namespace base {
+class SequencedTaskRunner;
+class Value;
+}  // namespace base
+
+namespace net {
+
+class NetLogCaptureMode;
+
+// BinaryNetLogObserver is a lower overhead alternative to FileNetLogObserver,
+// for capturing NetLogs under load. Rather than converting each event to JSON
+// on the thread that logged it, it appends a compact binary record of the
+// event (type, source, phase, time and parameters) to an in-memory buffer,
+// which is written to disk on a background sequence.
+//
+// The records are written to a ring of event files in |log_dir|: once the
+// last one is full, the oldest one is overwritten, so that the log holds the
+// most recent events within a size limit. ConvertBinaryNetLogToJson(), which
+// the net/tools/binary_net_log_converter tool wraps, turns the directory into
+// the JSON format written by FileNetLogObserver.
+//
+// Events that are logged while too much data is waiting to be written are
+// dropped, rather than slowing down the logging threads.
+//
+// As with FileNetLogObserver, StartObserving() and StopObserving() must each
+// be called exactly once. If the observer is destroyed without having been
+// stopped, the log directory is deleted.
+class NET_EXPORT BinaryNetLogObserver : public NetLog::ThreadSafeObserver {
+ public:
+  // Creates an observer that writes to a ring of |num_event_files| files
+  // holding at most |max_total_size| bytes of events, in |log_dir|, which is
+  // created if needed. |constants| is the legend written along with the
+  // events; if null, the output of GetNetConstants() is used.
+  static std::unique_ptr<BinaryNetLogObserver> Create(
+      const base::FilePath& log_dir,
+      uint64_t max_total_size,
+      size_t num_event_files,
+      std::unique_ptr<base::Value> constants);
+
+  ~BinaryNetLogObserver() override;
+
+  // Attaches this observer to |net_log| and begins observing events.
+  void StartObserving(NetLog* net_log, NetLogCaptureMode capture_mode);
+
+  // Stops observing, writes the buffered events and |polled_data|, if not
+  // null, and closes the files. |optional_callback|, if not null, is run on
+  // the calling sequence once everything has been written.
+  void StopObserving(std::unique_ptr<base::Value> polled_data,
+                     base::OnceClosure optional_callback);
+
+  // NetLog::ThreadSafeObserver
+  void OnAddEntry(const NetLogEntry& entry) override;
+
+  // Returns the number of events that have been dropped so far.
+  size_t GetDroppedEventCountForTesting();
+
+ private:
+  class EventBuffer;
+  class FileWriter;
+
+  BinaryNetLogObserver(
+      scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+      std::unique_ptr<FileWriter> file_writer,
+      scoped_refptr<EventBuffer> event_buffer,
+      std::unique_ptr<base::Value> constants);
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+
+  // Shared by the threads that log events and by |file_task_runner_|.
+  scoped_refptr<EventBuffer> event_buffer_;
+
+  // Only used on |file_task_runner_|, which deletes it.
+  std::unique_ptr<FileWriter> file_writer_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryNetLogObserver);
+};
+
+// Converts the log written by a BinaryNetLogObserver to |log_dir| into the
+// JSON format of FileNetLogObserver, stored in |json|. Truncated records,
+// e.g. from a crash, are skipped. Returns false if |log_dir| doesn't hold a
+// binary log.
+NET_EXPORT bool ConvertBinaryNetLogToJson(const base::FilePath& log_dir,
+                                          std::string* json);
+
+}  // namespace net
+
+#endif  // NET_LOG_BINARY_NET_LOG_OBSERVER_H_
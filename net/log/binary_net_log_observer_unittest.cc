@@ -0,0 +1,261 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/log/binary_net_log_observer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/task/task_scheduler/task_scheduler.h"
+#include "base/values.h"
+#include "net/base/test_completion_callback.h"
+#include "net/log/net_log_capture_mode.h"
+#include "net/log/net_log_entry.h"
+#include "net/log/net_log_event_type.h"
+#include "net/log/net_log_parameters_callback.h"
+#include "net/log/net_log_source.h"
+#include "net/log/net_log_source_type.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const uint64_t kLargeFileSize = 100000000;
+const size_t kTotalNumFiles = 4;
+
+std::unique_ptr<base::Value> TestConstants() {
+  auto constants = std::make_unique<base::DictionaryValue>();
+  constants->SetInteger("logFormatVersion", 1);
+  return std::move(constants);
+}
+
+// Adds an event with source id |id| to |observer|, with |params| as its
+// parameters if not null.
+void AddEntry(BinaryNetLogObserver* observer,
+              uint32_t id,
+              const base::Value* params) {
+  NetLogParametersCallback callback = base::BindRepeating(
+      [](const base::Value* params, NetLogCaptureMode capture_mode) {
+        return params->CreateDeepCopy();
+      },
+      params);
+  NetLogSource source(NetLogSourceType::HTTP2_SESSION, id);
+  NetLogEntryData entry_data(NetLogEventType::PAC_JAVASCRIPT_ERROR, source,
+                             NetLogEventPhase::BEGIN, base::TimeTicks::Now(),
+                             params ? &callback : nullptr);
+  NetLogEntry entry(&entry_data, NetLogCaptureMode::IncludeSocketBytes());
+  observer->OnAddEntry(entry);
+}
+
+class BinaryNetLogObserverTest : public ::testing::Test,
+                                 public WithScopedTaskEnvironment {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    log_dir_ = temp_dir_.GetPath().AppendASCII("net-log");
+  }
+
+  void TearDown() override {
+    observer_.reset();
+    // The destructor posts to the file task runner.
+    RunUntilIdle();
+  }
+
+  void CreateAndStartObserving(uint64_t max_total_size, size_t num_files) {
+    observer_ = BinaryNetLogObserver::Create(log_dir_, max_total_size,
+                                             num_files, TestConstants());
+    observer_->StartObserving(&net_log_, NetLogCaptureMode::Default());
+  }
+
+  void StopObserving(std::unique_ptr<base::Value> polled_data) {
+    TestClosure closure;
+    observer_->StopObserving(std::move(polled_data), closure.closure());
+    closure.WaitForResult();
+  }
+
+  // Converts the log to JSON, and returns it parsed.
+  std::unique_ptr<base::DictionaryValue> ReadLog() {
+    std::string json;
+    if (!ConvertBinaryNetLogToJson(log_dir_, &json)) {
+      ADD_FAILURE() << "Failed converting: " << log_dir_.value();
+      return nullptr;
+    }
+    return base::DictionaryValue::From(base::JSONReader::Read(json));
+  }
+
+ protected:
+  NetLog net_log_;
+  std::unique_ptr<BinaryNetLogObserver> observer_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath log_dir_;
+};
+
+TEST_F(BinaryNetLogObserverTest, NoEvents) {
+  CreateAndStartObserving(kLargeFileSize, kTotalNumFiles);
+  StopObserving(nullptr);
+
+  std::unique_ptr<base::DictionaryValue> log = ReadLog();
+  ASSERT_TRUE(log);
+  const base::ListValue* events;
+  ASSERT_TRUE(log->GetList("events", &events));
+  EXPECT_EQ(0u, events->GetSize());
+  const base::Value* constants = log->FindKey("constants");
+  ASSERT_TRUE(constants);
+  EXPECT_EQ(*TestConstants(), *constants);
+  EXPECT_FALSE(log->FindKey("polledData"));
+}
+
+TEST_F(BinaryNetLogObserverTest, EventsAndParams) {
+  base::DictionaryValue params;
+  params.SetInteger("int", -1234567);
+  params.SetBoolean("bool", true);
+  params.SetDouble("double", 0.25);
+  params.SetString("string", "some string");
+  params.SetKey("none", base::Value());
+  auto list = std::make_unique<base::ListValue>();
+  list->AppendInteger(1);
+  list->AppendString("two");
+  list->Append(std::make_unique<base::DictionaryValue>());
+  params.Set("list", std::move(list));
+  params.SetInteger("dict.nested", 7);
+
+  CreateAndStartObserving(kLargeFileSize, kTotalNumFiles);
+  AddEntry(observer_.get(), 1, nullptr);
+  AddEntry(observer_.get(), 2, &params);
+  StopObserving(nullptr);
+
+  std::unique_ptr<base::DictionaryValue> log = ReadLog();
+  ASSERT_TRUE(log);
+  const base::ListValue* events;
+  ASSERT_TRUE(log->GetList("events", &events));
+  ASSERT_EQ(2u, events->GetSize());
+
+  const base::DictionaryValue* event;
+  ASSERT_TRUE(events->GetDictionary(0, &event));
+  int value;
+  EXPECT_TRUE(event->GetInteger("source.id", &value));
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(event->GetInteger("source.type", &value));
+  EXPECT_EQ(static_cast<int>(NetLogSourceType::HTTP2_SESSION), value);
+  EXPECT_TRUE(event->GetInteger("type", &value));
+  EXPECT_EQ(static_cast<int>(NetLogEventType::PAC_JAVASCRIPT_ERROR), value);
+  EXPECT_TRUE(event->GetInteger("phase", &value));
+  EXPECT_EQ(static_cast<int>(NetLogEventPhase::BEGIN), value);
+  std::string time;
+  EXPECT_TRUE(event->GetString("time", &time));
+  EXPECT_FALSE(event->FindKey("params"));
+
+  ASSERT_TRUE(events->GetDictionary(1, &event));
+  EXPECT_TRUE(event->GetInteger("source.id", &value));
+  EXPECT_EQ(2, value);
+  const base::Value* logged_params = event->FindKey("params");
+  ASSERT_TRUE(logged_params);
+  EXPECT_EQ(params, *logged_params);
+}
+
+TEST_F(BinaryNetLogObserverTest, PolledData) {
+  CreateAndStartObserving(kLargeFileSize, kTotalNumFiles);
+  auto polled_data = std::make_unique<base::DictionaryValue>();
+  polled_data->SetString("some_data", "some_value");
+  std::unique_ptr<base::Value> expected = polled_data->CreateDeepCopy();
+  StopObserving(std::move(polled_data));
+
+  std::unique_ptr<base::DictionaryValue> log = ReadLog();
+  ASSERT_TRUE(log);
+  const base::Value* logged_polled_data = log->FindKey("polledData");
+  ASSERT_TRUE(logged_polled_data);
+  EXPECT_EQ(*expected, *logged_polled_data);
+}
+
+// Checks that the oldest events are overwritten once all the files are full,
+// and that the remaining ones are converted in order.
+TEST_F(BinaryNetLogObserverTest, OverwritesOldestEvents) {
+  const size_t kNumFiles = 3;
+  const uint64_t kMaxTotalSize = 3 * 128 * 1024;
+  const int kNumEvents = 4000;
+  const int kEventsPerBatch = 100;
+
+  base::DictionaryValue params;
+  params.SetString("message", std::string(500, 'x'));
+
+  CreateAndStartObserving(kMaxTotalSize, kNumFiles);
+  for (int i = 0; i < kNumEvents; ++i) {
+    AddEntry(observer_.get(), i, &params);
+    // Let the files catch up, so that no event is dropped.
+    if (i % kEventsPerBatch == 0)
+      base::TaskScheduler::GetInstance()->FlushForTesting();
+  }
+  StopObserving(nullptr);
+  EXPECT_EQ(0u, observer_->GetDroppedEventCountForTesting());
+
+  std::unique_ptr<base::DictionaryValue> log = ReadLog();
+  ASSERT_TRUE(log);
+  const base::ListValue* events;
+  ASSERT_TRUE(log->GetList("events", &events));
+  ASSERT_GT(events->GetSize(), 0u);
+  ASSERT_LT(events->GetSize(), static_cast<size_t>(kNumEvents));
+
+  // The events left are the most recent ones, in order.
+  int first_id = kNumEvents - static_cast<int>(events->GetSize());
+  for (size_t i = 0; i < events->GetSize(); ++i) {
+    const base::DictionaryValue* event;
+    ASSERT_TRUE(events->GetDictionary(i, &event));
+    int id;
+    ASSERT_TRUE(event->GetInteger("source.id", &id));
+    EXPECT_EQ(first_id + static_cast<int>(i), id);
+  }
+}
+
+TEST_F(BinaryNetLogObserverTest, SkipsTruncatedRecord) {
+  base::DictionaryValue params;
+  params.SetString("message", "hello");
+
+  CreateAndStartObserving(kLargeFileSize, kTotalNumFiles);
+  AddEntry(observer_.get(), 1, &params);
+  AddEntry(observer_.get(), 2, &params);
+  StopObserving(nullptr);
+
+  // Cut the last record short, as a crash could.
+  base::FilePath event_file = log_dir_.AppendASCII("events_0.bin");
+  int64_t size;
+  ASSERT_TRUE(base::GetFileSize(event_file, &size));
+  base::File file(event_file, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+  ASSERT_TRUE(file.SetLength(size - 3));
+  file.Close();
+
+  std::unique_ptr<base::DictionaryValue> log = ReadLog();
+  ASSERT_TRUE(log);
+  const base::ListValue* events;
+  ASSERT_TRUE(log->GetList("events", &events));
+  EXPECT_EQ(1u, events->GetSize());
+}
+
+TEST_F(BinaryNetLogObserverTest, DeletesLogIfNotStopped) {
+  CreateAndStartObserving(kLargeFileSize, kTotalNumFiles);
+  AddEntry(observer_.get(), 1, nullptr);
+  base::TaskScheduler::GetInstance()->FlushForTesting();
+  EXPECT_TRUE(base::PathExists(log_dir_));
+
+  observer_.reset();
+  base::TaskScheduler::GetInstance()->FlushForTesting();
+  EXPECT_FALSE(base::PathExists(log_dir_));
+}
+
+TEST_F(BinaryNetLogObserverTest, ConvertFailsWithoutLog) {
+  std::string json;
+  EXPECT_FALSE(ConvertBinaryNetLogToJson(log_dir_, &json));
+}
+
+}  // namespace
+
+}  // namespace net
@@ -13,6 +13,7 @@
 #include "base/sequenced_task_runner.h"
 #include "base/threading/thread_checker.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "net/nqe/network_quality.h"
 #include "net/nqe/network_quality_estimator.h"
 
 namespace net {
@@ -26,9 +27,88 @@ namespace {
 //       long.
 // (ii)  Connection type of the network as reported by network
 //       change notifier (an enum).
-// (iii) Effective connection type of the network (an enum).
+// (iii) Quality of the network: its effective connection type (an enum),
+//       and the RTT and throughput estimates it was computed from, if known.
 constexpr size_t kMaxCacheSize = 20u;
 
+// Keys of the dictionary that holds the quality of a network. Older versions
+// stored only the name of the effective connection type, as a string.
+const char kEffectiveConnectionTypeKey[] = "ect";
+const char kHttpRttKey[] = "http_rtt_ms";
+const char kTransportRttKey[] = "transport_rtt_ms";
+const char kDownstreamThroughputKey[] = "downstream_kbps";
+
+// Returns the value at |key| in |value|, or INVALID_RTT_THROUGHPUT if it is
+// missing or negative.
+int32_t GetEstimate(const base::Value& value, const char* key) {
+  const base::Value* estimate =
+      value.FindKeyOfType(key, base::Value::Type::INTEGER);
+  if (!estimate || estimate->GetInt() < 0)
+    return nqe::internal::INVALID_RTT_THROUGHPUT;
+  return estimate->GetInt();
+}
+
+// Parses the quality of a network stored in the prefs as |value|.
+nqe::internal::CachedNetworkQuality ConvertValueToCachedNetworkQuality(
+    const base::Value& value) {
+  std::string effective_connection_type_string;
+  if (value.is_string()) {
+    effective_connection_type_string = value.GetString();
+  } else if (value.is_dict()) {
+    const base::Value* ect = value.FindKeyOfType(kEffectiveConnectionTypeKey,
+                                                 base::Value::Type::STRING);
+    if (ect)
+      effective_connection_type_string = ect->GetString();
+  }
+
+  base::Optional<EffectiveConnectionType> effective_connection_type =
+      GetEffectiveConnectionTypeForName(effective_connection_type_string);
+  DCHECK(effective_connection_type.has_value());
+
+  if (!value.is_dict()) {
+    return nqe::internal::CachedNetworkQuality(
+        effective_connection_type.value_or(EFFECTIVE_CONNECTION_TYPE_UNKNOWN));
+  }
+
+  int32_t http_rtt_ms = GetEstimate(value, kHttpRttKey);
+  int32_t transport_rtt_ms = GetEstimate(value, kTransportRttKey);
+  nqe::internal::NetworkQuality network_quality(
+      base::TimeDelta::FromMilliseconds(http_rtt_ms),
+      base::TimeDelta::FromMilliseconds(transport_rtt_ms),
+      GetEstimate(value, kDownstreamThroughputKey));
+  return nqe::internal::CachedNetworkQuality(
+      base::TimeTicks(), network_quality,
+      effective_connection_type.value_or(EFFECTIVE_CONNECTION_TYPE_UNKNOWN));
+}
+
+// Returns the value that stores |cached_network_quality| in the prefs.
+base::Value ConvertCachedNetworkQualityToValue(
+    const nqe::internal::CachedNetworkQuality& cached_network_quality) {
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey(kEffectiveConnectionTypeKey,
+               base::Value(GetNameForEffectiveConnectionType(
+                   cached_network_quality.effective_connection_type())));
+
+  const nqe::internal::NetworkQuality& network_quality =
+      cached_network_quality.network_quality();
+  if (network_quality.http_rtt() != nqe::internal::InvalidRTT()) {
+    value.SetKey(kHttpRttKey,
+                 base::Value(static_cast<int>(
+                     network_quality.http_rtt().InMilliseconds())));
+  }
+  if (network_quality.transport_rtt() != nqe::internal::InvalidRTT()) {
+    value.SetKey(kTransportRttKey,
+                 base::Value(static_cast<int>(
+                     network_quality.transport_rtt().InMilliseconds())));
+  }
+  if (network_quality.downstream_throughput_kbps() !=
+      nqe::internal::INVALID_RTT_THROUGHPUT) {
+    value.SetKey(kDownstreamThroughputKey,
+                 base::Value(network_quality.downstream_throughput_kbps()));
+  }
+  return value;
+}
+
 // Parses |value| into a map of NetworkIDs and CachedNetworkQualities,
 // and returns the map.
 ParsedPrefs ConvertDictionaryValueToMap(const base::DictionaryValue* value) {
@@ -38,19 +118,7 @@ ParsedPrefs ConvertDictionaryValueToMap(const base::DictionaryValue* value) {
   for (const auto& it : value->DictItems()) {
     nqe::internal::NetworkID network_id =
         nqe::internal::NetworkID::FromString(it.first);
-
-    std::string effective_connection_type_string;
-    const bool effective_connection_type_available =
-        it.second.GetAsString(&effective_connection_type_string);
-    DCHECK(effective_connection_type_available);
-
-    base::Optional<EffectiveConnectionType> effective_connection_type =
-        GetEffectiveConnectionTypeForName(effective_connection_type_string);
-    DCHECK(effective_connection_type.has_value());
-
-    nqe::internal::CachedNetworkQuality cached_network_quality(
-        effective_connection_type.value_or(EFFECTIVE_CONNECTION_TYPE_UNKNOWN));
-    read_prefs[network_id] = cached_network_quality;
+    read_prefs[network_id] = ConvertValueToCachedNetworkQuality(it.second);
   }
   return read_prefs;
 }
@@ -133,9 +201,8 @@ void NetworkQualitiesPrefsManager::OnChangeInCachedNetworkQualityOnPrefSequence(
   if (network_id_string.find('.') != std::string::npos)
     return;
 
-  prefs_->SetString(network_id_string,
-                    GetNameForEffectiveConnectionType(
-                        cached_network_quality.effective_connection_type()));
+  prefs_->SetKey(network_id_string,
+                 ConvertCachedNetworkQualityToValue(cached_network_quality));
 
   if (prefs_->size() > kMaxCacheSize) {
     // Delete one randomly selected value that has a key that is different from
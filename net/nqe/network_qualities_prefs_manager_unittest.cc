@@ -17,6 +17,7 @@
 #include "net/base/network_change_notifier.h"
 #include "net/nqe/effective_connection_type.h"
 #include "net/nqe/network_id.h"
+#include "net/nqe/network_quality.h"
 #include "net/nqe/network_quality_estimator_test_util.h"
 #include "net/nqe/network_quality_store.h"
 #include "net/test/test_with_scoped_task_environment.h"
@@ -305,6 +306,74 @@ TEST_F(NetworkQualitiesPrefManager, ClearPrefs) {
   manager.ShutdownOnPrefSequence();
 }
 
+// Verifies that the RTT and throughput estimates of a network are written to
+// the prefs along with its effective connection type, and read back.
+TEST_F(NetworkQualitiesPrefManager, WriteAndReadEstimates) {
+  TestNetworkQualityEstimator estimator;
+
+  NetworkQualitiesPrefsManager manager(std::make_unique<TestPrefDelegate>());
+  manager.InitializeOnNetworkThread(&estimator);
+  base::RunLoop().RunUntilIdle();
+
+  // Notify |manager| as the network quality store would.
+  nqe::internal::NetworkQualityStore::NetworkQualitiesCacheObserver* observer =
+      &manager;
+  nqe::internal::NetworkID network_id(
+      NetworkChangeNotifier::ConnectionType::CONNECTION_WIFI, "test", 0);
+  observer->OnChangeInCachedNetworkQuality(
+      network_id, nqe::internal::CachedNetworkQuality(
+                      base::TimeTicks::Now(),
+                      nqe::internal::NetworkQuality(
+                          base::TimeDelta::FromMilliseconds(400),
+                          base::TimeDelta::FromMilliseconds(300), 1500),
+                      EFFECTIVE_CONNECTION_TYPE_3G));
+  base::RunLoop().RunUntilIdle();
+
+  ParsedPrefs read_prefs = manager.ForceReadPrefsForTesting();
+  ASSERT_EQ(1u, read_prefs.count(network_id));
+  const nqe::internal::CachedNetworkQuality& cached_network_quality =
+      read_prefs.find(network_id)->second;
+  EXPECT_EQ(EFFECTIVE_CONNECTION_TYPE_3G,
+            cached_network_quality.effective_connection_type());
+  nqe::internal::NetworkQuality network_quality =
+      cached_network_quality.network_quality();
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(400), network_quality.http_rtt());
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(300),
+            network_quality.transport_rtt());
+  EXPECT_EQ(1500, network_quality.downstream_throughput_kbps());
+
+  manager.ShutdownOnPrefSequence();
+}
+
+// Verifies that prefs which only hold the effective connection type of each
+// network, as written by older versions, are still read.
+TEST_F(NetworkQualitiesPrefManager, ReadEffectiveConnectionTypeOnly) {
+  nqe::internal::NetworkID network_id(
+      NetworkChangeNotifier::ConnectionType::CONNECTION_2G, "test", 0);
+  base::DictionaryValue prefs;
+  prefs.SetString(network_id.ToString(),
+                  GetNameForEffectiveConnectionType(
+                      EFFECTIVE_CONNECTION_TYPE_SLOW_2G));
+  auto prefs_delegate = std::make_unique<TestPrefDelegate>();
+  prefs_delegate->SetDictionaryValue(prefs);
+
+  NetworkQualitiesPrefsManager manager(std::move(prefs_delegate));
+  ParsedPrefs read_prefs = manager.ForceReadPrefsForTesting();
+  ASSERT_EQ(1u, read_prefs.count(network_id));
+  const nqe::internal::CachedNetworkQuality& cached_network_quality =
+      read_prefs.find(network_id)->second;
+  EXPECT_EQ(EFFECTIVE_CONNECTION_TYPE_SLOW_2G,
+            cached_network_quality.effective_connection_type());
+  nqe::internal::NetworkQuality network_quality =
+      cached_network_quality.network_quality();
+  EXPECT_EQ(nqe::internal::InvalidRTT(), network_quality.http_rtt());
+  EXPECT_EQ(nqe::internal::InvalidRTT(), network_quality.transport_rtt());
+  EXPECT_EQ(nqe::internal::INVALID_RTT_THROUGHPUT,
+            network_quality.downstream_throughput_kbps());
+
+  manager.ShutdownOnPrefSequence();
+}
+
 }  // namespace
 
 }  // namespace net
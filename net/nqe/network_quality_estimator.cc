@@ -1718,18 +1718,27 @@ void NetworkQualityEstimator::OnPrefsRead(
       continue;
     }
 
-    // RTT and throughput values are not set in the prefs.
-    DCHECK_EQ(nqe::internal::InvalidRTT(),
-              it.second.network_quality().http_rtt());
-    DCHECK_EQ(nqe::internal::InvalidRTT(),
-              it.second.network_quality().transport_rtt());
-    DCHECK_EQ(nqe::internal::INVALID_RTT_THROUGHPUT,
-              it.second.network_quality().downstream_throughput_kbps());
+    // Use the RTT and throughput estimates stored in the prefs, if any, so
+    // that the estimates right after startup reflect this network rather
+    // than a typical network of its effective connection type.
+    const nqe::internal::NetworkQuality& typical_network_quality =
+        params_->TypicalNetworkQuality(effective_connection_type);
+    nqe::internal::NetworkQuality network_quality =
+        it.second.network_quality();
+    if (network_quality.http_rtt() == nqe::internal::InvalidRTT())
+      network_quality.set_http_rtt(typical_network_quality.http_rtt());
+    if (network_quality.transport_rtt() == nqe::internal::InvalidRTT()) {
+      network_quality.set_transport_rtt(
+          typical_network_quality.transport_rtt());
+    }
+    if (network_quality.downstream_throughput_kbps() ==
+        nqe::internal::INVALID_RTT_THROUGHPUT) {
+      network_quality.set_downstream_throughput_kbps(
+          typical_network_quality.downstream_throughput_kbps());
+    }
 
     nqe::internal::CachedNetworkQuality cached_network_quality(
-        tick_clock_->NowTicks(),
-        params_->TypicalNetworkQuality(effective_connection_type),
-        effective_connection_type);
+        tick_clock_->NowTicks(), network_quality, effective_connection_type);
 
     network_quality_store_->Add(it.first, cached_network_quality);
   }
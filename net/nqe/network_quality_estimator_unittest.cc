@@ -2571,6 +2571,42 @@ TEST_F(NetworkQualityEstimatorTest, OnPrefsRead) {
       &effective_connection_type_observer);
 }
 
+// Verify that the RTT and throughput estimates stored in the prefs are used
+// instead of the typical values for their effective connection type.
+TEST_F(NetworkQualityEstimatorTest, OnPrefsReadWithEstimates) {
+  std::map<nqe::internal::NetworkID, nqe::internal::CachedNetworkQuality>
+      read_prefs;
+  read_prefs[nqe::internal::NetworkID(NetworkChangeNotifier::CONNECTION_WIFI,
+                                      "test_ect_3g", INT32_MIN)] =
+      nqe::internal::CachedNetworkQuality(
+          base::TimeTicks(),
+          nqe::internal::NetworkQuality(
+              base::TimeDelta::FromMilliseconds(700),
+              base::TimeDelta::FromMilliseconds(600), 900),
+          EFFECTIVE_CONNECTION_TYPE_3G);
+
+  std::map<std::string, std::string> variation_params;
+  variation_params["persistent_cache_reading_enabled"] = "true";
+  variation_params["add_default_platform_observations"] = "false";
+  TestNetworkQualityEstimator estimator(variation_params, true, true,
+                                        std::make_unique<BoundTestNetLog>());
+
+  TestRTTAndThroughputEstimatesObserver rtt_throughput_observer;
+  estimator.AddRTTAndThroughputEstimatesObserver(&rtt_throughput_observer);
+
+  estimator.SimulateNetworkChange(
+      NetworkChangeNotifier::ConnectionType::CONNECTION_WIFI, "test_ect_3g");
+  estimator.OnPrefsRead(read_prefs);
+
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(700),
+            rtt_throughput_observer.http_rtt());
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(600),
+            rtt_throughput_observer.transport_rtt());
+  EXPECT_EQ(900, rtt_throughput_observer.downstream_throughput_kbps());
+
+  estimator.RemoveRTTAndThroughputEstimatesObserver(&rtt_throughput_observer);
+}
+
 // Verify that the cached network qualities from the prefs are not used if the
 // reading of the network quality prefs is not enabled..
 TEST_F(NetworkQualityEstimatorTest, OnPrefsReadWithReadingDisabled) {
@@ -180,16 +180,24 @@ void ObservationBuffer::ComputeWeightedObservations(
   DCHECK_GE(Capacity(), Size());
 
   weighted_observations->clear();
+  weighted_observations->reserve(observations_.size());
   double total_weight_observations = 0.0;
   base::TimeTicks now = tick_clock_->NowTicks();
 
+  // The observations are sorted by time, so that consecutive observations are
+  // usually the same number of seconds old and share their time weight.
+  int64_t time_weight_seconds = -1;
+  double time_weight = 1.0;
+
   for (const auto& observation : observations_) {
     if (observation.timestamp() < begin_timestamp)
       continue;
 
     base::TimeDelta time_since_sample_taken = now - observation.timestamp();
-    double time_weight =
-        pow(weight_multiplier_per_second_, time_since_sample_taken.InSeconds());
+    if (time_since_sample_taken.InSeconds() != time_weight_seconds) {
+      time_weight_seconds = time_since_sample_taken.InSeconds();
+      time_weight = pow(weight_multiplier_per_second_, time_weight_seconds);
+    }
 
     double signal_strength_weight = 1.0;
     if (current_signal_strength && observation.signal_strength()) {
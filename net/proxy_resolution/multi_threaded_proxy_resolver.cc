@@ -4,6 +4,9 @@
 
 #include "net/proxy_resolution/multi_threaded_proxy_resolver.h"
 
+#include <algorithm>
+#include <map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -11,9 +14,12 @@
 #include "base/bind_helpers.h"
 #include "base/callback_helpers.h"
 #include "base/containers/circular_deque.h"
+#include "base/containers/mru_cache.h"
 #include "base/location.h"
+#include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/threading/thread.h"
@@ -24,6 +30,7 @@
 #include "net/log/net_log.h"
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_with_source.h"
+#include "net/proxy_resolution/pac_file_data.h"
 #include "net/proxy_resolution/proxy_info.h"
 #include "net/proxy_resolution/proxy_resolver.h"
 
@@ -31,6 +38,46 @@ namespace net {
 namespace {
 class Job;
 
+// The maximum number of (scheme, host) results kept by a resolver which
+// caches them.
+const size_t kMaxCachedResults = 256;
+
+// Identifiers which make it unsafe to cache the results of a script: they
+// give access to the date and time, to the arguments of a function other than
+// by name, or to code which can't be checked statically.
+const char* const kUncacheableIdentifiers[] = {
+    "arguments", "Date",       "dateRange",    "eval",
+    "Function",  "timeRange",  "weekdayRange", "FindProxyForURLEx",
+};
+
+bool IsIdentifierChar(base::char16 c) {
+  // Non-ASCII characters are all taken as part of identifiers, which is
+  // enough for PacScriptDependsOnlyOnHost() to remain conservative.
+  return base::IsAsciiAlpha(c) || base::IsAsciiDigit(c) || c == '_' ||
+         c == '$' || c >= 0x80;
+}
+
+// Splits |script| into identifiers, numbers and single punctuation
+// characters. Strings and comments aren't treated specially, which can only
+// make PacScriptDependsOnlyOnHost() reject more scripts.
+std::vector<base::StringPiece16> TokenizeScript(const base::string16& script) {
+  std::vector<base::StringPiece16> tokens;
+  size_t i = 0;
+  while (i < script.size()) {
+    if (base::IsAsciiWhitespace(script[i])) {
+      ++i;
+      continue;
+    }
+    size_t begin = i++;
+    if (IsIdentifierChar(script[begin])) {
+      while (i < script.size() && IsIdentifierChar(script[i]))
+        ++i;
+    }
+    tokens.push_back(base::StringPiece16(script.data() + begin, i - begin));
+  }
+  return tokens;
+}
+
 // An "executor" is a job-runner for PAC requests. It encapsulates a worker
 // thread and a synchronous ProxyResolver (which will be operated on said
 // thread.)
@@ -107,11 +154,15 @@ class MultiThreadedProxyResolver : public ProxyResolver,
   // For each thread that is created, an accompanying synchronous ProxyResolver
   // will be provisioned using |resolver_factory|. All methods on these
   // ProxyResolvers will be called on the one thread.
+  //
+  // If |cache_results| is true, results are cached by (scheme, host), and
+  // concurrent requests for the same scheme and host share a single job.
   MultiThreadedProxyResolver(
       std::unique_ptr<ProxyResolverFactory> resolver_factory,
       size_t max_num_threads,
       const scoped_refptr<PacFileData>& script_data,
-      scoped_refptr<Executor> executor);
+      scoped_refptr<Executor> executor,
+      bool cache_results);
 
   ~MultiThreadedProxyResolver() override;
 
@@ -129,6 +180,10 @@ class MultiThreadedProxyResolver : public ProxyResolver,
   // TODO(eroman): Make this priority queue.
   using PendingJobsQueue = base::circular_deque<scoped_refptr<Job>>;
   using ExecutorList = std::vector<scoped_refptr<Executor>>;
+  // The scheme and host of a URL.
+  using ResultCacheKey = std::pair<std::string, std::string>;
+  using InFlightJobMap =
+      std::map<ResultCacheKey, scoped_refptr<GetProxyForURLJob>>;
 
   // Returns an idle worker thread which is ready to receive GetProxyForURL()
   // requests. If all threads are occupied, returns NULL.
@@ -140,13 +195,29 @@ class MultiThreadedProxyResolver : public ProxyResolver,
   // Starts the next job from |pending_jobs_| if possible.
   void OnExecutorReady(Executor* executor) override;
 
+  // Called when |job|, which is the one resolving |key|, has completed or was
+  // dropped.
+  void OnJobFinished(const ResultCacheKey& key,
+                     GetProxyForURLJob* job,
+                     int result_code,
+                     const ProxyInfo& results);
+
   const std::unique_ptr<ProxyResolverFactory> resolver_factory_;
   const size_t max_num_threads_;
   PendingJobsQueue pending_jobs_;
   ExecutorList executors_;
   scoped_refptr<PacFileData> script_data_;
 
+  // Null unless results are cached.
+  std::unique_ptr<base::MRUCache<ResultCacheKey, ProxyInfo>> result_cache_;
+
+  // The jobs which other requests for the same key can wait for, when results
+  // are cached.
+  InFlightJobMap in_flight_jobs_;
+
   THREAD_CHECKER(thread_checker_);
+
+  base::WeakPtrFactory<MultiThreadedProxyResolver> weak_ptr_factory_;
 };
 
 // Job ---------------------------------------------
@@ -174,6 +245,13 @@ class Job : public base::RefCountedThreadSafe<Job> {
   // Returns true if Cancel() has been called.
   bool was_cancelled() const { return was_cancelled_; }
 
+  // Returns false if nothing is waiting for the job's result anymore, in
+  // which case it is dropped rather than run.
+  virtual bool ShouldRun() const { return !was_cancelled(); }
+
+  // This method is called instead of Run() when the job is dropped.
+  virtual void Abandon() {}
+
   // This method is called when the job is inserted into a wait queue
   // because no executors were ready to accept it.
   virtual void WaitingForThread() {}
@@ -276,6 +354,36 @@ class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
 
   NetLogWithSource* net_log() { return &net_log_; }
 
+  // Makes the job report its result to |resolver|, which caches it under
+  // |cache_key|.
+  void set_resolver(base::WeakPtr<MultiThreadedProxyResolver> resolver,
+                    const ResultCacheKey& cache_key) {
+    resolver_ = std::move(resolver);
+    cache_key_ = cache_key;
+  }
+
+  // Makes |follower|, a job for the same scheme and host which is never run,
+  // complete with the result of this job.
+  void AddFollower(scoped_refptr<GetProxyForURLJob> follower) {
+    DCHECK(resolver_);
+    followers_.push_back(std::move(follower));
+  }
+
+  bool ShouldRun() const override {
+    if (!was_cancelled())
+      return true;
+    for (const auto& follower : followers_) {
+      if (!follower->was_cancelled())
+        return true;
+    }
+    return false;
+  }
+
+  void Abandon() override {
+    if (resolver_)
+      resolver_->OnJobFinished(cache_key_, this, ERR_ABORTED, results_buf_);
+  }
+
   void WaitingForThread() override {
     was_waiting_for_thread_ = true;
     net_log_.BeginEvent(NetLogEventType::WAITING_FOR_PROXY_RESOLVER_THREAD);
@@ -311,18 +419,42 @@ class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
  private:
   // Runs the completion callback on the origin thread.
   void QueryComplete(int result_code) {
-    // The Job may have been cancelled after it was started.
-    if (!was_cancelled()) {
-      if (result_code >= OK) {  // Note: unit-tests use values > 0.
-        results_->Use(results_buf_);
-      }
-      std::move(callback_).Run(result_code);
+    // Caches the result first, so that requests made from the callbacks below
+    // can use it.
+    if (resolver_)
+      resolver_->OnJobFinished(cache_key_, this, result_code, results_buf_);
+    Complete(result_code, results_buf_);
+    // Like the queued jobs, the followers are dropped if a callback destroys
+    // the resolver.
+    for (const auto& follower : followers_) {
+      if (!resolver_)
+        break;
+      follower->Complete(result_code, results_buf_);
     }
+    followers_.clear();
     OnJobCompleted();
   }
 
+  void Complete(int result_code, const ProxyInfo& results) {
+    // The Job may have been cancelled after it was started.
+    if (was_cancelled())
+      return;
+    if (result_code >= OK) {  // Note: unit-tests use values > 0.
+      results_->Use(results);
+    }
+    std::move(callback_).Run(result_code);
+  }
+
   CompletionOnceCallback callback_;
 
+  // Only set when results are cached. Must only be used on the "origin"
+  // thread.
+  base::WeakPtr<MultiThreadedProxyResolver> resolver_;
+  ResultCacheKey cache_key_;
+
+  // Requests for the same scheme and host, waiting for this job.
+  std::vector<scoped_refptr<GetProxyForURLJob>> followers_;
+
   // Must only be used on the "origin" thread.
   ProxyInfo* results_;
 
@@ -408,19 +540,27 @@ MultiThreadedProxyResolver::MultiThreadedProxyResolver(
     std::unique_ptr<ProxyResolverFactory> resolver_factory,
     size_t max_num_threads,
     const scoped_refptr<PacFileData>& script_data,
-    scoped_refptr<Executor> executor)
+    scoped_refptr<Executor> executor,
+    bool cache_results)
     : resolver_factory_(std::move(resolver_factory)),
       max_num_threads_(max_num_threads),
-      script_data_(script_data) {
+      script_data_(script_data),
+      weak_ptr_factory_(this) {
   DCHECK(script_data_);
   executor->set_coordinator(this);
   executors_.push_back(executor);
+  if (cache_results) {
+    result_cache_ =
+        std::make_unique<base::MRUCache<ResultCacheKey, ProxyInfo>>(
+            kMaxCachedResults);
+  }
 }
 
 MultiThreadedProxyResolver::~MultiThreadedProxyResolver() {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   // We will cancel all outstanding requests.
   pending_jobs_.clear();
+  in_flight_jobs_.clear();
 
   for (auto& executor : executors_) {
     executor->Destroy();
@@ -436,6 +576,16 @@ int MultiThreadedProxyResolver::GetProxyForURL(
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   DCHECK(!callback.is_null());
 
+  ResultCacheKey cache_key;
+  if (result_cache_) {
+    cache_key = ResultCacheKey(url.scheme(), url.host());
+    auto it = result_cache_->Get(cache_key);
+    if (it != result_cache_->end()) {
+      results->Use(it->second);
+      return OK;
+    }
+  }
+
   scoped_refptr<GetProxyForURLJob> job(
       new GetProxyForURLJob(url, results, std::move(callback), net_log));
 
@@ -444,6 +594,18 @@ int MultiThreadedProxyResolver::GetProxyForURL(
   if (request)
     request->reset(new RequestImpl(job));
 
+  if (result_cache_) {
+    // Wait for the job already resolving the same scheme and host, unless
+    // it's about to be dropped.
+    auto it = in_flight_jobs_.find(cache_key);
+    if (it != in_flight_jobs_.end() && it->second->ShouldRun()) {
+      it->second->AddFollower(job);
+      return ERR_IO_PENDING;
+    }
+    job->set_resolver(weak_ptr_factory_.GetWeakPtr(), cache_key);
+    in_flight_jobs_[cache_key] = job;
+  }
+
   // If there is an executor that is ready to run this request, submit it!
   Executor* executor = FindIdleExecutor();
   if (executor) {
@@ -492,13 +654,28 @@ void MultiThreadedProxyResolver::OnExecutorReady(Executor* executor) {
   while (!pending_jobs_.empty()) {
     scoped_refptr<Job> job = pending_jobs_.front();
     pending_jobs_.pop_front();
-    if (!job->was_cancelled()) {
+    if (job->ShouldRun()) {
       executor->StartJob(job.get());
       return;
     }
+    job->Abandon();
   }
 }
 
+void MultiThreadedProxyResolver::OnJobFinished(const ResultCacheKey& key,
+                                               GetProxyForURLJob* job,
+                                               int result_code,
+                                               const ProxyInfo& results) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK(result_cache_);
+  // |job| may have been replaced by a newer one, if it had been cancelled.
+  auto it = in_flight_jobs_.find(key);
+  if (it != in_flight_jobs_.end() && it->second.get() == job)
+    in_flight_jobs_.erase(it);
+  if (result_code >= OK)
+    result_cache_->Put(key, results);
+}
+
 }  // namespace
 
 class MultiThreadedProxyResolverFactory::Job
@@ -510,11 +687,13 @@ class MultiThreadedProxyResolverFactory::Job
       std::unique_ptr<ProxyResolver>* resolver,
       std::unique_ptr<ProxyResolverFactory> resolver_factory,
       size_t max_num_threads,
+      ResultCacheMode result_cache_mode,
       CompletionOnceCallback callback)
       : factory_(factory),
         resolver_out_(resolver),
         resolver_factory_(std::move(resolver_factory)),
         max_num_threads_(max_num_threads),
+        result_cache_mode_(result_cache_mode),
         script_data_(script_data),
         executor_(new Executor(this, 0)),
         callback_(std::move(callback)) {
@@ -539,9 +718,13 @@ class MultiThreadedProxyResolverFactory::Job
   void OnExecutorReady(Executor* executor) override {
     int error = OK;
     if (executor->resolver()) {
+      bool cache_results =
+          result_cache_mode_ == ResultCacheMode::ALWAYS ||
+          (result_cache_mode_ == ResultCacheMode::HOST_ONLY_SCRIPTS &&
+           PacScriptDependsOnlyOnHost(*script_data_));
       resolver_out_->reset(new MultiThreadedProxyResolver(
           std::move(resolver_factory_), max_num_threads_,
-          std::move(script_data_), executor_));
+          std::move(script_data_), executor_, cache_results));
     } else {
       error = ERR_PAC_SCRIPT_FAILED;
       executor_->Destroy();
@@ -555,6 +738,7 @@ class MultiThreadedProxyResolverFactory::Job
   std::unique_ptr<ProxyResolver>* const resolver_out_;
   std::unique_ptr<ProxyResolverFactory> resolver_factory_;
   const size_t max_num_threads_;
+  const ResultCacheMode result_cache_mode_;
   scoped_refptr<PacFileData> script_data_;
   scoped_refptr<Executor> executor_;
   CompletionOnceCallback callback_;
@@ -564,7 +748,8 @@ MultiThreadedProxyResolverFactory::MultiThreadedProxyResolverFactory(
     size_t max_num_threads,
     bool factory_expects_bytes)
     : ProxyResolverFactory(factory_expects_bytes),
-      max_num_threads_(max_num_threads) {
+      max_num_threads_(max_num_threads),
+      result_cache_mode_(ResultCacheMode::HOST_ONLY_SCRIPTS) {
   DCHECK_GE(max_num_threads, 1u);
 }
 
@@ -581,7 +766,8 @@ int MultiThreadedProxyResolverFactory::CreateProxyResolver(
     std::unique_ptr<Request>* request) {
   std::unique_ptr<Job> job(new Job(this, pac_script, resolver,
                                    CreateProxyResolverFactory(),
-                                   max_num_threads_, std::move(callback)));
+                                   max_num_threads_, result_cache_mode_,
+                                   std::move(callback)));
   jobs_.insert(job.get());
   *request = std::move(job);
   return ERR_IO_PENDING;
@@ -593,4 +779,39 @@ void MultiThreadedProxyResolverFactory::RemoveJob(
   DCHECK_EQ(1u, erased);
 }
 
+bool PacScriptDependsOnlyOnHost(const PacFileData& script) {
+  if (script.type() != PacFileData::TYPE_SCRIPT_CONTENTS)
+    return false;
+
+  std::vector<base::StringPiece16> tokens = TokenizeScript(script.utf16());
+  base::StringPiece16 url_param;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    for (const char* identifier : kUncacheableIdentifiers) {
+      if (base::EqualsASCII(tokens[i], identifier))
+        return false;
+    }
+    if (!base::EqualsASCII(tokens[i], "FindProxyForURL"))
+      continue;
+    // The only mention of FindProxyForURL must be its declaration, as
+    // "function FindProxyForURL(url, host)", since it could otherwise be
+    // replaced.
+    if (!url_param.empty() || i == 0 || i + 5 >= tokens.size() ||
+        !base::EqualsASCII(tokens[i - 1], "function") ||
+        !base::EqualsASCII(tokens[i + 1], "(") ||
+        !IsIdentifierChar(tokens[i + 2][0]) ||
+        base::IsAsciiDigit(tokens[i + 2][0]) ||
+        !base::EqualsASCII(tokens[i + 3], ",") ||
+        !IsIdentifierChar(tokens[i + 4][0]) ||
+        !base::EqualsASCII(tokens[i + 5], ")")) {
+      return false;
+    }
+    url_param = tokens[i + 2];
+  }
+  if (url_param.empty())
+    return false;
+
+  // The parameter must not be used anywhere, even by another function.
+  return std::count(tokens.begin(), tokens.end(), url_param) == 1;
+}
+
 }  // namespace net
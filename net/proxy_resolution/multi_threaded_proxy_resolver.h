@@ -16,6 +16,7 @@
 #include "net/proxy_resolution/proxy_resolver_factory.h"
 
 namespace net {
+class PacFileData;
 class ProxyResolver;
 
 // MultiThreadedProxyResolverFactory creates instances of a ProxyResolver
@@ -49,13 +50,36 @@ class ProxyResolver;
 //     a global counter and using that to make a decision. In the
 //     multi-threaded model, each thread may have a different value for this
 //     counter, so it won't globally be seen as monotonically increasing!
+//
+// The resolvers can also cache results by (scheme, host), for scripts whose
+// result only depends on those; see ResultCacheMode. Since a resolver is only
+// used for a single script, the cache goes away with it whenever the script
+// is reloaded, or the network changes.
 class NET_EXPORT_PRIVATE MultiThreadedProxyResolverFactory
     : public ProxyResolverFactory {
  public:
+  // Selects the created resolvers that cache their results.
+  enum class ResultCacheMode {
+    // Every request is run through the script.
+    DISABLED,
+    // Results are cached for the scripts that PacScriptDependsOnlyOnHost()
+    // accepts.
+    HOST_ONLY_SCRIPTS,
+    // Results are always cached, e.g. because a policy says that the script
+    // only depends on the host.
+    ALWAYS,
+  };
+
   MultiThreadedProxyResolverFactory(size_t max_num_threads,
                                     bool factory_expects_bytes);
   ~MultiThreadedProxyResolverFactory() override;
 
+  // Applies to the resolvers created after the call. Defaults to
+  // HOST_ONLY_SCRIPTS.
+  void set_result_cache_mode(ResultCacheMode mode) {
+    result_cache_mode_ = mode;
+  }
+
   int CreateProxyResolver(const scoped_refptr<PacFileData>& pac_script,
                           std::unique_ptr<ProxyResolver>* resolver,
                           CompletionOnceCallback callback,
@@ -72,10 +96,18 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolverFactory
   void RemoveJob(Job* job);
 
   const size_t max_num_threads_;
+  ResultCacheMode result_cache_mode_;
 
   std::set<Job*> jobs_;
 };
 
+// Returns true if |script| is the text of a PAC script whose FindProxyForURL()
+// never looks at its |url| argument, so that its result only depends on the
+// host (and the scheme, which is part of the URL passed in). The check is
+// conservative: it fails for scripts reading the date or time, or which could
+// reach the URL indirectly, through |arguments| or eval().
+NET_EXPORT_PRIVATE bool PacScriptDependsOnlyOnHost(const PacFileData& script);
+
 }  // namespace net
 
 #endif  // NET_PROXY_RESOLUTION_MULTI_THREADED_PROXY_RESOLVER_H_
@@ -212,24 +212,32 @@ class SingleShotMultiThreadedProxyResolverFactory
 
 class MultiThreadedProxyResolverTest : public TestWithScopedTaskEnvironment {
  public:
+  using ResultCacheMode = MultiThreadedProxyResolverFactory::ResultCacheMode;
+
   void Init(size_t num_threads) {
+    Init(num_threads, "pac script bytes", ResultCacheMode::DISABLED);
+  }
+
+  void Init(size_t num_threads,
+            const std::string& script,
+            ResultCacheMode result_cache_mode) {
     std::unique_ptr<BlockableProxyResolverFactory> factory_owner(
         new BlockableProxyResolverFactory);
     factory_ = factory_owner.get();
     resolver_factory_.reset(new SingleShotMultiThreadedProxyResolverFactory(
         num_threads, std::move(factory_owner)));
+    resolver_factory_->set_result_cache_mode(result_cache_mode);
     TestCompletionCallback ready_callback;
     std::unique_ptr<ProxyResolverFactory::Request> request;
-    resolver_factory_->CreateProxyResolver(
-        PacFileData::FromUTF8("pac script bytes"), &resolver_,
-        ready_callback.callback(), &request);
+    resolver_factory_->CreateProxyResolver(PacFileData::FromUTF8(script),
+                                           &resolver_,
+                                           ready_callback.callback(), &request);
     EXPECT_TRUE(request);
     ASSERT_THAT(ready_callback.WaitForResult(), IsOk());
 
     // Verify that the script data reaches the synchronous resolver factory.
     ASSERT_EQ(1u, factory_->script_data().size());
-    EXPECT_EQ(ASCIIToUTF16("pac script bytes"),
-              factory_->script_data()[0]->utf16());
+    EXPECT_EQ(ASCIIToUTF16(script), factory_->script_data()[0]->utf16());
   }
 
   void ClearResolver() { resolver_.reset(); }
@@ -776,6 +784,191 @@ TEST_F(MultiThreadedProxyResolverTest, DeleteRequestInFactoryCallback) {
   EXPECT_THAT(callback.WaitForResult(), IsOk());
 }
 
+const char kHostOnlyScript[] =
+    "function FindProxyForURL(url, host) {\n"
+    "  if (dnsDomainIs(host, \".example.com\"))\n"
+    "    return \"PROXY proxy.example.com:8080\";\n"
+    "  return \"DIRECT\";\n"
+    "}\n";
+
+TEST_F(MultiThreadedProxyResolverTest, PacScriptDependsOnlyOnHost) {
+  EXPECT_TRUE(PacScriptDependsOnlyOnHost(
+      *PacFileData::FromUTF8(kHostOnlyScript)));
+  EXPECT_TRUE(PacScriptDependsOnlyOnHost(*PacFileData::FromUTF8(
+      "function helper(h) { return isPlainHostName(h); }\n"
+      "function FindProxyForURL ( u , h ) {\n"
+      "  return helper(h) ? \"DIRECT\" : \"PROXY p:80\"; }")));
+
+  const char* const kUncacheableScripts[] = {
+      // Uses the URL.
+      "function FindProxyForURL(url, host) {\n"
+      "  return shExpMatch(url, \"*.pdf\") ? \"DIRECT\" : \"PROXY p:80\";"
+      "}",
+      // Uses the URL through another name.
+      "function FindProxyForURL(url, host) { return arguments[0]; }",
+      "function FindProxyForURL(url, host) { return eval(\"url\"); }",
+      // Depends on the time.
+      "function FindProxyForURL(url, host) {\n"
+      "  return timeRange(9, 17) ? \"PROXY p:80\" : \"DIRECT\"; }",
+      // Replaced after its declaration.
+      "function FindProxyForURL(url, host) { return \"DIRECT\"; }\n"
+      "FindProxyForURL = function(u, h) { return u; };",
+      // Doesn't declare FindProxyForURL().
+      "var FindProxyForURL = function(url, host) { return \"DIRECT\"; };",
+      "",
+      // Has FindProxyForURLEx(), which is called instead.
+      "function FindProxyForURLEx(url, host) { return url; }\n"
+      "function FindProxyForURL(url, host) { return \"DIRECT\"; }",
+  };
+  for (const char* script : kUncacheableScripts) {
+    EXPECT_FALSE(PacScriptDependsOnlyOnHost(*PacFileData::FromUTF8(script)))
+        << script;
+  }
+  EXPECT_FALSE(PacScriptDependsOnlyOnHost(
+      *PacFileData::FromURL(GURL("http://wpad/wpad.dat"))));
+}
+
+// Tests that results are cached by scheme and host.
+TEST_F(MultiThreadedProxyResolverTest, ResultCache_CachesByHost) {
+  ASSERT_NO_FATAL_FAILURE(
+      Init(1u, kHostOnlyScript, ResultCacheMode::HOST_ONLY_SCRIPTS));
+
+  TestCompletionCallback callback0;
+  ProxyInfo results0;
+  int rv = resolver().GetProxyForURL(GURL("http://host/a"), &results0,
+                                     callback0.callback(), nullptr,
+                                     NetLogWithSource());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+  EXPECT_EQ(0, callback0.WaitForResult());
+  EXPECT_EQ("PROXY host:80", results0.ToPacString());
+
+  // The same scheme and host complete synchronously.
+  TestCompletionCallback callback1;
+  ProxyInfo results1;
+  rv = resolver().GetProxyForURL(GURL("http://host:8000/b?c"), &results1,
+                                 callback1.callback(), nullptr,
+                                 NetLogWithSource());
+  EXPECT_THAT(rv, IsOk());
+  EXPECT_EQ("PROXY host:80", results1.ToPacString());
+
+  // Another scheme goes through the script.
+  TestCompletionCallback callback2;
+  ProxyInfo results2;
+  rv = resolver().GetProxyForURL(GURL("https://host/"), &results2,
+                                 callback2.callback(), nullptr,
+                                 NetLogWithSource());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+  EXPECT_EQ(1, callback2.WaitForResult());
+
+  ASSERT_EQ(1u, factory().resolvers().size());
+  EXPECT_EQ(2, factory().resolvers()[0]->request_count());
+}
+
+// Tests that host-only scripts are cached when the mode isn't set.
+TEST_F(MultiThreadedProxyResolverTest, ResultCache_HostOnlyScriptsByDefault) {
+  std::unique_ptr<BlockableProxyResolverFactory> factory_owner(
+      new BlockableProxyResolverFactory);
+  BlockableProxyResolverFactory* factory = factory_owner.get();
+  SingleShotMultiThreadedProxyResolverFactory resolver_factory(
+      1u, std::move(factory_owner));
+  std::unique_ptr<ProxyResolver> resolver;
+  TestCompletionCallback ready_callback;
+  std::unique_ptr<ProxyResolverFactory::Request> request;
+  resolver_factory.CreateProxyResolver(PacFileData::FromUTF8(kHostOnlyScript),
+                                       &resolver, ready_callback.callback(),
+                                       &request);
+  ASSERT_THAT(ready_callback.WaitForResult(), IsOk());
+
+  for (int i = 0; i < 2; ++i) {
+    TestCompletionCallback callback;
+    ProxyInfo results;
+    int rv = resolver->GetProxyForURL(GURL("http://host/"), &results,
+                                      callback.callback(), nullptr,
+                                      NetLogWithSource());
+    EXPECT_THAT(callback.GetResult(rv), IsOk());
+  }
+  ASSERT_EQ(1u, factory->resolvers().size());
+  EXPECT_EQ(1, factory->resolvers()[0]->request_count());
+}
+
+// Tests that nothing is cached for scripts which may depend on the URL, unless
+// the cache is forced on.
+TEST_F(MultiThreadedProxyResolverTest, ResultCache_UrlDependentScript) {
+  ASSERT_NO_FATAL_FAILURE(
+      Init(1u, "pac script bytes", ResultCacheMode::HOST_ONLY_SCRIPTS));
+
+  for (int i = 0; i < 2; ++i) {
+    TestCompletionCallback callback;
+    ProxyInfo results;
+    int rv = resolver().GetProxyForURL(GURL("http://host/"), &results,
+                                       callback.callback(), nullptr,
+                                       NetLogWithSource());
+    EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+    EXPECT_EQ(i, callback.WaitForResult());
+  }
+}
+
+TEST_F(MultiThreadedProxyResolverTest, ResultCache_Always) {
+  ASSERT_NO_FATAL_FAILURE(
+      Init(1u, "pac script bytes", ResultCacheMode::ALWAYS));
+
+  TestCompletionCallback callback0;
+  ProxyInfo results0;
+  int rv = resolver().GetProxyForURL(GURL("http://host/"), &results0,
+                                     callback0.callback(), nullptr,
+                                     NetLogWithSource());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+  EXPECT_EQ(0, callback0.WaitForResult());
+
+  TestCompletionCallback callback1;
+  ProxyInfo results1;
+  rv = resolver().GetProxyForURL(GURL("http://host/"), &results1,
+                                 callback1.callback(), nullptr,
+                                 NetLogWithSource());
+  EXPECT_THAT(rv, IsOk());
+  EXPECT_EQ("PROXY host:80", results1.ToPacString());
+}
+
+// Tests that concurrent requests for the same host share a single job, even
+// when the request that started it is cancelled.
+TEST_F(MultiThreadedProxyResolverTest, ResultCache_BatchesInFlightRequests) {
+  ASSERT_NO_FATAL_FAILURE(
+      Init(1u, "pac script bytes", ResultCacheMode::ALWAYS));
+
+  const int kNumRequests = 4;
+  TestCompletionCallback callback[kNumRequests];
+  ProxyInfo results[kNumRequests];
+  std::unique_ptr<ProxyResolver::Request> request[kNumRequests];
+
+  // Keep the thread busy, so that the other requests are queued.
+  factory().resolvers()[0]->Block();
+  int rv = resolver().GetProxyForURL(GURL("http://blocked/"), &results[0],
+                                     callback[0].callback(), &request[0],
+                                     NetLogWithSource());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+  factory().resolvers()[0]->WaitUntilBlocked();
+
+  for (int i = 1; i < kNumRequests; ++i) {
+    rv = resolver().GetProxyForURL(
+        GURL(base::StringPrintf("http://host/%d", i)), &results[i],
+        callback[i].callback(), &request[i], NetLogWithSource());
+    EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+  }
+  // Cancel the request whose job the others wait for, and one of those.
+  request[1].reset();
+  request[2].reset();
+
+  factory().resolvers()[0]->Unblock();
+  EXPECT_EQ(0, callback[0].WaitForResult());
+  EXPECT_EQ(1, callback[3].WaitForResult());
+  EXPECT_EQ("PROXY host:80", results[3].ToPacString());
+  EXPECT_FALSE(callback[1].have_result());
+  EXPECT_FALSE(callback[2].have_result());
+
+  // The script only ran once for "host".
+  EXPECT_EQ(2, factory().resolvers()[0]->request_count());
+}
+
 // Test that deleting the factory with a request in-progress works correctly.
 TEST_F(MultiThreadedProxyResolverTest, DestroyFactoryWithRequestsInProgress) {
   const size_t kNumThreads = 1u;
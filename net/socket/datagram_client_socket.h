@@ -121,6 +121,12 @@ class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
   // connection option.
   virtual void SetSendmmsgEnabled(bool enabled) = 0;
 
+  // In |WriteAsync()|, send batches of datagrams of the same size as a single
+  // UDP GSO (generic segmentation offload) datagram, which the kernel or the
+  // network card splits, on platforms that support it. Must be called right
+  // after construction and before other calls.
+  virtual void SetGsoEnabled(bool enabled) = 0;
+
   // This is to (de-)activate batching in |WriteAsync|, e.g. in
   // |QuicChromiumClientSession| based on whether there are large
   // upload stream(s) active.
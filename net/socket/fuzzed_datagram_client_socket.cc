@@ -118,6 +118,7 @@ bool FuzzedDatagramClientSocket::WriteAsyncEnabled() {
 void FuzzedDatagramClientSocket::SetMaxPacketSize(size_t max_packet_size) {}
 void FuzzedDatagramClientSocket::SetWriteMultiCoreEnabled(bool enabled) {}
 void FuzzedDatagramClientSocket::SetSendmmsgEnabled(bool enabled) {}
+void FuzzedDatagramClientSocket::SetGsoEnabled(bool enabled) {}
 void FuzzedDatagramClientSocket::SetWriteBatchingActive(bool active) {}
 
 const NetLogWithSource& FuzzedDatagramClientSocket::NetLog() const {
@@ -61,6 +61,7 @@ class FuzzedDatagramClientSocket : public DatagramClientSocket {
   bool WriteAsyncEnabled() override;
   void SetWriteMultiCoreEnabled(bool enabled) override;
   void SetSendmmsgEnabled(bool enabled) override;
+  void SetGsoEnabled(bool enabled) override;
   void SetWriteBatchingActive(bool active) override;
 
   const NetLogWithSource& NetLog() const override;
@@ -1778,6 +1778,7 @@ bool MockUDPClientSocket::WriteAsyncEnabled() {
 void MockUDPClientSocket::SetMaxPacketSize(size_t max_packet_size) {}
 void MockUDPClientSocket::SetWriteMultiCoreEnabled(bool enabled) {}
 void MockUDPClientSocket::SetSendmmsgEnabled(bool enabled) {}
+void MockUDPClientSocket::SetGsoEnabled(bool enabled) {}
 void MockUDPClientSocket::SetWriteBatchingActive(bool active) {}
 
 const NetLogWithSource& MockUDPClientSocket::NetLog() const {
@@ -930,6 +930,7 @@ class MockUDPClientSocket : public DatagramClientSocket, public AsyncSocket {
   bool WriteAsyncEnabled() override;
   void SetWriteMultiCoreEnabled(bool enabled) override;
   void SetSendmmsgEnabled(bool enabled) override;
+  void SetGsoEnabled(bool enabled) override;
   void SetWriteBatchingActive(bool active) override;
   const NetLogWithSource& NetLog() const override;
 
@@ -175,6 +175,10 @@ void UDPClientSocket::SetSendmmsgEnabled(bool enabled) {
   socket_.SetSendmmsgEnabled(enabled);
 }
 
+void UDPClientSocket::SetGsoEnabled(bool enabled) {
+  socket_.SetGsoEnabled(enabled);
+}
+
 void UDPClientSocket::SetWriteBatchingActive(bool active) {
   socket_.SetWriteBatchingActive(active);
 }
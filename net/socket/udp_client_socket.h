@@ -71,6 +71,7 @@ class NET_EXPORT_PRIVATE UDPClientSocket : public DatagramClientSocket {
   void SetMaxPacketSize(size_t max_packet_size) override;
   void SetWriteMultiCoreEnabled(bool enabled) override;
   void SetSendmmsgEnabled(bool enabled) override;
+  void SetGsoEnabled(bool enabled) override;
   void SetWriteBatchingActive(bool active) override;
 
  private:
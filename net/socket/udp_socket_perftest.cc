@@ -7,6 +7,8 @@
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
 #include "base/test/perf_time_logger.h"
+#include "build/build_config.h"
+#include "net/base/datagram_buffer.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -45,10 +47,26 @@ class UDPSocketPerfTest : public PlatformTest {
                             int num_of_packets,
                             base::Closure done_callback);
 
+  void DoneWriteAsyncPacketsToSocket(UDPClientSocket* socket,
+                                     int num_of_packets,
+                                     base::Closure done_callback,
+                                     int error) {
+    WriteAsyncPacketsToSocket(socket, num_of_packets, done_callback);
+  }
+
+  // Same as WritePacketsToSocket(), with WriteAsync().
+  void WriteAsyncPacketsToSocket(UDPClientSocket* socket,
+                                 int num_of_packets,
+                                 base::Closure done_callback);
+
   // Use non-blocking IO if |use_nonblocking_io| is true. This variable only
   // has effect on Windows.
   void WriteBenchmark(bool use_nonblocking_io);
 
+  // Writes batches of datagrams with WriteAsync(), with sendmmsg() if
+  // |use_sendmmsg| and with UDP GSO if |use_gso|, where supported.
+  void WriteAsyncBenchmark(bool use_sendmmsg, bool use_gso);
+
  protected:
   static const int kPacketSize = 1024;
   scoped_refptr<IOBufferWithSize> buffer_;
@@ -91,6 +109,30 @@ void UDPSocketPerfTest::WritePacketsToSocket(UDPClientSocket* socket,
   }
 }
 
+void UDPSocketPerfTest::WriteAsyncPacketsToSocket(
+    UDPClientSocket* socket,
+    int num_of_packets,
+    base::Closure done_callback) {
+  char data[kPacketSize];
+  memset(data, 'G', kPacketSize);
+
+  while (num_of_packets) {
+    int rv = socket->WriteAsync(
+        data, kPacketSize,
+        base::Bind(&UDPSocketPerfTest::DoneWriteAsyncPacketsToSocket,
+                   weak_factory_.GetWeakPtr(), socket, num_of_packets - 1,
+                   done_callback),
+        TRAFFIC_ANNOTATION_FOR_TESTS);
+    if (rv == ERR_IO_PENDING)
+      break;
+    --num_of_packets;
+  }
+  if (!num_of_packets) {
+    done_callback.Run();
+    return;
+  }
+}
+
 void UDPSocketPerfTest::WriteBenchmark(bool use_nonblocking_io) {
   base::MessageLoopForIO message_loop;
   const uint16_t kPort = 9999;
@@ -126,6 +168,45 @@ void UDPSocketPerfTest::WriteBenchmark(bool use_nonblocking_io) {
   LOG(INFO) << "Write speed: " << packets / 1024 / elapsed << " MB/s";
 }
 
+void UDPSocketPerfTest::WriteAsyncBenchmark(bool use_sendmmsg, bool use_gso) {
+  base::MessageLoopForIO message_loop;
+  const uint16_t kPort = 9999;
+
+  // Setup the server to listen.
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", kPort, &bind_address);
+  std::unique_ptr<UDPServerSocket> server(
+      new UDPServerSocket(nullptr, NetLogSource()));
+  int rv = server->Listen(bind_address);
+  ASSERT_THAT(rv, IsOk());
+
+  // Setup the client.
+  IPEndPoint server_address;
+  CreateUDPAddress("127.0.0.1", kPort, &server_address);
+  std::unique_ptr<UDPClientSocket> client(new UDPClientSocket(
+      DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource()));
+  client->SetWriteAsyncEnabled(true);
+  client->SetMaxPacketSize(kPacketSize);
+  client->SetSendmmsgEnabled(use_sendmmsg);
+  client->SetGsoEnabled(use_gso);
+  rv = client->Connect(server_address);
+  EXPECT_THAT(rv, IsOk());
+  if (!client->WriteAsyncEnabled()) {
+    LOG(INFO) << "WriteAsync() is not supported";
+    return;
+  }
+  client->SetWriteBatchingActive(true);
+
+  base::RunLoop run_loop;
+  base::TimeTicks start_ticks = base::TimeTicks::Now();
+  int packets = 100000;
+  WriteAsyncPacketsToSocket(client.get(), packets, run_loop.QuitClosure());
+  run_loop.Run();
+
+  double elapsed = (base::TimeTicks::Now() - start_ticks).InSecondsF();
+  LOG(INFO) << "Write speed: " << packets / elapsed << " packets/s";
+}
+
 TEST_F(UDPSocketPerfTest, Write) {
   base::PerfTimeLogger timer("UDP_socket_write");
   WriteBenchmark(false);
@@ -136,6 +217,81 @@ TEST_F(UDPSocketPerfTest, WriteNonBlocking) {
   WriteBenchmark(true);
 }
 
+TEST_F(UDPSocketPerfTest, WriteAsync) {
+  base::PerfTimeLogger timer("UDP_socket_write_async");
+  WriteAsyncBenchmark(false, false);
+}
+
+TEST_F(UDPSocketPerfTest, WriteAsyncSendmmsg) {
+  base::PerfTimeLogger timer("UDP_socket_write_async_sendmmsg");
+  WriteAsyncBenchmark(true, false);
+}
+
+TEST_F(UDPSocketPerfTest, WriteAsyncGso) {
+  base::PerfTimeLogger timer("UDP_socket_write_async_gso");
+  WriteAsyncBenchmark(true, true);
+}
+
+#if defined(OS_POSIX)
+// Reads |kNumPackets| datagrams, in rounds of kReadMultipleMaxBuffers sent
+// before they are read, with Read() or with ReadMultiple().
+void ReadBenchmark(bool use_read_multiple) {
+  base::MessageLoopForIO message_loop;
+  const int kNumPackets = 100000;
+  const int kPacketSize = 1024;
+
+  UDPSocket server(DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource());
+  ASSERT_THAT(server.Open(ADDRESS_FAMILY_IPV4), IsOk());
+  ASSERT_THAT(server.Bind(IPEndPoint(IPAddress::IPv4Localhost(), 0)), IsOk());
+  IPEndPoint server_address;
+  ASSERT_THAT(server.GetLocalAddress(&server_address), IsOk());
+
+  UDPSocket client(DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource());
+  ASSERT_THAT(client.Open(ADDRESS_FAMILY_IPV4), IsOk());
+  ASSERT_THAT(client.Connect(server_address), IsOk());
+  client.SetMaxPacketSize(kPacketSize);
+  IPEndPoint client_address;
+  ASSERT_THAT(client.GetLocalAddress(&client_address), IsOk());
+
+  auto write_buffer = base::MakeRefCounted<IOBufferWithSize>(kPacketSize);
+  memset(write_buffer->data(), 'G', kPacketSize);
+  auto read_buffer = base::MakeRefCounted<IOBufferWithSize>(kPacketSize);
+  DatagramBuffers buffers;
+  TestCompletionCallback callback;
+
+  base::TimeDelta elapsed;
+  for (int packets = 0; packets < kNumPackets;
+       packets += kReadMultipleMaxBuffers) {
+    for (int i = 0; i < kReadMultipleMaxBuffers; ++i) {
+      ASSERT_EQ(kPacketSize,
+                server.SendTo(write_buffer.get(), kPacketSize, client_address,
+                              callback.callback()));
+    }
+    base::TimeTicks start_ticks = base::TimeTicks::Now();
+    if (use_read_multiple) {
+      ASSERT_EQ(kReadMultipleMaxBuffers,
+                client.ReadMultiple(&buffers, callback.callback()));
+    } else {
+      for (int i = 0; i < kReadMultipleMaxBuffers; ++i) {
+        ASSERT_EQ(kPacketSize, client.Read(read_buffer.get(), kPacketSize,
+                                           callback.callback()));
+      }
+    }
+    elapsed += base::TimeTicks::Now() - start_ticks;
+  }
+  LOG(INFO) << "Read speed: " << kNumPackets / elapsed.InSecondsF()
+            << " packets/s";
+}
+
+TEST_F(UDPSocketPerfTest, Read) {
+  ReadBenchmark(false);
+}
+
+TEST_F(UDPSocketPerfTest, ReadMultiple) {
+  ReadBenchmark(true);
+}
+#endif  // defined(OS_POSIX)
+
 }  // namespace
 
 }  // namespace net
@@ -11,6 +11,8 @@
 #include <netinet/in.h>
 #include <sys/ioctl.h>
 
+#include <iterator>
+
 #include "base/callback.h"
 #include "base/callback_helpers.h"
 #include "base/containers/stack_container.h"
@@ -49,6 +51,18 @@
 #include "base/strings/utf_string_conversions.h"
 #endif  // defined(OS_ANDROID)
 
+#if HAVE_UDP_GSO
+#include <netinet/udp.h>
+
+// Older headers don't define these.
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif  // HAVE_UDP_GSO
+
 #if defined(OS_MACOSX) && !defined(OS_IOS)
 // This was needed to debug crbug.com/640281.
 // TODO(zhongyi): Remove once the bug is resolved.
@@ -68,6 +82,13 @@ const int kActivityMonitorMinimumSamplesForThroughputEstimate = 2;
 const base::TimeDelta kActivityMonitorMsThreshold =
     base::TimeDelta::FromMilliseconds(100);
 
+#if HAVE_UDP_GSO
+// The kernel limits GSO datagrams to this many segments (UDP_MAX_SEGMENTS),
+// and their payload must fit in a single IP packet.
+const size_t kMaxGsoSegments = 64;
+const size_t kMaxGsoPayloadSize = 65000;
+#endif
+
 #if defined(OS_MACOSX)
 // When enabling multicast using setsockopt(IP_MULTICAST_IF) MacOS
 // requires passing IPv4 address instead of interface index. This function
@@ -191,6 +212,7 @@ UDPSocketPosix::UDPSocketPosix(DatagramSocket::BindType bind_type,
       write_async_outstanding_(0),
       read_buf_len_(0),
       recv_from_address_(NULL),
+      read_multiple_buffers_(nullptr),
       write_buf_len_(0),
       net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::UDP_SOCKET)),
       bound_network_(NetworkChangeNotifier::kInvalidNetworkHandle),
@@ -294,6 +316,7 @@ void UDPSocketPosix::Close() {
   read_buf_len_ = 0;
   read_callback_.Reset();
   recv_from_address_ = NULL;
+  read_multiple_buffers_ = nullptr;
   write_buf_ = NULL;
   write_buf_len_ = 0;
   write_callback_.Reset();
@@ -377,6 +400,7 @@ int UDPSocketPosix::RecvFrom(IOBuffer* buf,
   DCHECK_NE(kInvalidSocket, socket_);
   CHECK(read_callback_.is_null());
   DCHECK(!recv_from_address_);
+  DCHECK(!read_multiple_buffers_);
   DCHECK(!callback.is_null());  // Synchronous operation not supported
   DCHECK_GT(buf_len, 0);
 
@@ -400,6 +424,35 @@ int UDPSocketPosix::RecvFrom(IOBuffer* buf,
   return ERR_IO_PENDING;
 }
 
+int UDPSocketPosix::ReadMultiple(DatagramBuffers* buffers,
+                                 CompletionOnceCallback callback) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_NE(kInvalidSocket, socket_);
+  DCHECK(is_connected_);
+  DCHECK(datagram_buffer_pool_);
+  CHECK(read_callback_.is_null());
+  DCHECK(!read_multiple_buffers_);
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+
+  datagram_buffer_pool_->Dequeue(buffers);
+  int result = InternalReadMultiple(buffers);
+  if (result != ERR_IO_PENDING)
+    return result;
+
+  if (!base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
+          socket_, true, base::MessagePumpForIO::WATCH_READ,
+          &read_socket_watcher_, &read_watcher_)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on read";
+    result = MapSystemError(errno);
+    LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  read_multiple_buffers_ = buffers;
+  read_callback_ = std::move(callback);
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketPosix::Write(
     IOBuffer* buf,
     int buf_len,
@@ -701,11 +754,15 @@ void UDPSocketPosix::DoWriteCallback(int rv) {
 
 void UDPSocketPosix::DidCompleteRead() {
   int result =
-      InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
+      read_multiple_buffers_
+          ? InternalReadMultiple(read_multiple_buffers_)
+          : InternalRecvFrom(read_buf_.get(), read_buf_len_,
+                             recv_from_address_);
   if (result != ERR_IO_PENDING) {
     read_buf_ = NULL;
     read_buf_len_ = 0;
     recv_from_address_ = NULL;
+    read_multiple_buffers_ = nullptr;
     bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
     DCHECK(ok);
     DoReadCallback(result);
@@ -843,6 +900,87 @@ int UDPSocketPosix::InternalRecvFromNonConnectedSocket(IOBuffer* buf,
   return result;
 }
 
+int UDPSocketPosix::InternalReadMultiple(DatagramBuffers* buffers) {
+  DCHECK(buffers->empty());
+  DCHECK(remote_address_);
+  datagram_buffer_pool_->EnqueueUninitialized(kReadMultipleMaxBuffers,
+                                              buffers);
+
+  // The lengths of the datagrams read, or -1 for those that were truncated.
+  base::StackVector<int, kReadMultipleMaxBuffers> lengths;
+  int result = OK;
+#if HAVE_RECVMMSG
+  base::StackVector<struct iovec, kReadMultipleMaxBuffers> msg_iov;
+  base::StackVector<struct mmsghdr, kReadMultipleMaxBuffers> msgvec;
+  for (const auto& buffer : *buffers) {
+    struct iovec iov = {buffer->data(), buffer->length()};
+    msg_iov->push_back(iov);
+  }
+  for (struct iovec& iov : msg_iov.container()) {
+    struct mmsghdr hdr = {};
+    hdr.msg_hdr.msg_iov = &iov;
+    hdr.msg_hdr.msg_iovlen = 1;
+    msgvec->push_back(hdr);
+  }
+  int count = HANDLE_EINTR(
+      recvmmsg(socket_, &msgvec[0], msgvec->size(), 0, nullptr));
+  if (count < 0)
+    result = MapSystemError(errno);
+  for (int i = 0; i < count; ++i) {
+    const struct mmsghdr& hdr = msgvec[i];
+    lengths->push_back((hdr.msg_hdr.msg_flags & MSG_TRUNC)
+                           ? -1
+                           : static_cast<int>(hdr.msg_len));
+  }
+#else
+  for (const auto& buffer : *buffers) {
+    struct iovec iov = {buffer->data(), buffer->length()};
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    int bytes_transferred = HANDLE_EINTR(recvmsg(socket_, &msg, 0));
+    if (bytes_transferred < 0) {
+      // Once some datagrams are read, the error is left for the next read.
+      if (lengths->empty())
+        result = MapSystemError(errno);
+      break;
+    }
+    lengths->push_back((msg.msg_flags & MSG_TRUNC) ? -1 : bytes_transferred);
+  }
+#endif
+
+  SockaddrStorage sock_addr;
+  bool success =
+      remote_address_->ToSockAddr(sock_addr.addr, &sock_addr.addr_len);
+  DCHECK(success);
+
+  // Keep the buffers of the datagrams read, and return the others.
+  DatagramBuffers unused_buffers;
+  auto it = buffers->begin();
+  int datagram_count = 0;
+  for (int length : lengths.container()) {
+    auto next = std::next(it);
+    if (length < 0) {
+      LogRead(ERR_MSG_TOO_BIG, NULL, 0, NULL);
+      unused_buffers.splice(unused_buffers.cend(), *buffers, it);
+    } else {
+      (*it)->SetLength(length);
+      LogRead(length, (*it)->data(), sock_addr.addr_len, sock_addr.addr);
+      ++datagram_count;
+    }
+    it = next;
+  }
+  unused_buffers.splice(unused_buffers.cend(), *buffers, it, buffers->end());
+  datagram_buffer_pool_->Dequeue(&unused_buffers);
+
+  if (result != OK) {
+    if (result != ERR_IO_PENDING)
+      LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+  return datagram_count > 0 ? datagram_count : ERR_MSG_TOO_BIG;
+}
+
 int UDPSocketPosix::InternalSendTo(IOBuffer* buf,
                                    int buf_len,
                                    const IPEndPoint* address) {
@@ -1121,7 +1259,8 @@ void UDPSocketPosix::ApplySocketTag(const SocketTag& tag) {
   tag_ = tag;
 }
 
-UDPSocketPosixSender::UDPSocketPosixSender() : sendmmsg_enabled_(false) {}
+UDPSocketPosixSender::UDPSocketPosixSender()
+    : sendmmsg_enabled_(false), gso_enabled_(false) {}
 UDPSocketPosixSender::~UDPSocketPosixSender() {}
 
 SendResult::SendResult() : rv(0), write_count(0) {}
@@ -1174,7 +1313,76 @@ SendResult UDPSocketPosixSender::InternalSendmmsgBuffers(
 }
 #endif
 
+#if HAVE_UDP_GSO
+// static
+bool UDPSocketPosixSender::CanSendGsoBuffers(const DatagramBuffers& buffers) {
+  if (buffers.size() < 2 || buffers.size() > kMaxGsoSegments)
+    return false;
+  const size_t segment_size = buffers.front()->length();
+  size_t payload_size = 0;
+  for (auto it = buffers.cbegin(); it != buffers.cend(); ++it) {
+    const size_t length = (*it)->length();
+    if (length == 0 || length > segment_size ||
+        (length < segment_size && std::next(it) != buffers.cend())) {
+      return false;
+    }
+    payload_size += length;
+  }
+  return payload_size <= kMaxGsoPayloadSize;
+}
+
+SendResult UDPSocketPosixSender::InternalSendGsoBuffers(
+    int fd,
+    DatagramBuffers buffers) const {
+  base::StackVector<struct iovec, kWriteAsyncMaxBuffersThreshold + 1> msg_iov;
+  for (auto& buffer : buffers) {
+    struct iovec iov = {buffer->data(), buffer->length()};
+    msg_iov->push_back(iov);
+  }
+
+  // The segment size, which the last segment may be shorter than.
+  const uint16_t segment_size =
+      static_cast<uint16_t>(buffers.front()->length());
+  char control[CMSG_SPACE(sizeof(segment_size))] = {};
+  struct msghdr msg = {};
+  msg.msg_iov = &msg_iov[0];
+  msg.msg_iovlen = msg_iov->size();
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(segment_size));
+  std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+  int result = HANDLE_EINTR(Sendmsg(fd, &msg, 0));
+  SendResult send_result(0, 0, std::move(buffers));
+  if (result >= 0) {
+    // The datagrams are sent all together, or not at all.
+    send_result.write_count = send_result.buffers.size();
+  } else if (errno == EINVAL || errno == EIO || errno == ENOPROTOOPT) {
+    // Kernels without UDP_SEGMENT reject the control message, and devices
+    // without checksum offloading reject GSO datagrams.
+    send_result.rv = ERR_NOT_IMPLEMENTED;
+  } else {
+    send_result.rv = MapSystemError(errno);
+  }
+  return send_result;
+}
+#endif  // HAVE_UDP_GSO
+
 SendResult UDPSocketPosixSender::SendBuffers(int fd, DatagramBuffers buffers) {
+#if HAVE_UDP_GSO
+  if (gso_enabled_ && CanSendGsoBuffers(buffers)) {
+    auto result = InternalSendGsoBuffers(fd, std::move(buffers));
+    if (LIKELY(result.rv != ERR_NOT_IMPLEMENTED)) {
+      return result;
+    }
+    DLOG(WARNING) << "UDP GSO not supported, falling back to sendmmsg()";
+    gso_enabled_ = false;
+    buffers = std::move(result.buffers);
+  }
+#endif
 #if HAVE_SENDMMSG
   if (sendmmsg_enabled_) {
     auto result = InternalSendmmsgBuffers(fd, std::move(buffers));
@@ -1205,6 +1413,14 @@ int UDPSocketPosixSender::Sendmmsg(int sockfd,
 }
 #endif
 
+#if HAVE_UDP_GSO
+ssize_t UDPSocketPosixSender::Sendmsg(int sockfd,
+                                      const struct msghdr* msg,
+                                      int flags) const {
+  return sendmsg(sockfd, msg, flags);
+}
+#endif
+
 int UDPSocketPosix::WriteAsync(
     const char* buffer,
     size_t buf_len,
@@ -39,6 +39,17 @@
 #define HAVE_SENDMMSG 0
 #endif
 
+// recvmmsg() is available wherever sendmmsg() is.
+#define HAVE_RECVMMSG HAVE_SENDMMSG
+
+// UDP_SEGMENT (Linux 4.18) lets a single send carry several datagrams of the
+// same size, which are split by the kernel or the network card.
+#if defined(OS_LINUX)
+#define HAVE_UDP_GSO 1
+#else
+#define HAVE_UDP_GSO 0
+#endif
+
 namespace net {
 
 class IPAddress;
@@ -74,6 +85,8 @@ const int kWriteAsyncMaxBuffersThreshold = 16;
 const int kWriteAsyncPostBuffersThreshold = kWriteAsyncMaxBuffersThreshold / 2;
 // Don't unblock writer unless pending async writes are less than this.
 const int kWriteAsyncCallbackBuffersThreshold = kWriteAsyncMaxBuffersThreshold;
+// Don't read more datagrams than this with a single |ReadMultiple|.
+const int kReadMultipleMaxBuffers = 16;
 
 // To allow mock |Send|/|Sendmsg| in testing.  This has to be
 // reference counted thread safe because |SendBuffers| and
@@ -91,6 +104,12 @@ class NET_EXPORT UDPSocketPosixSender
 #endif
   }
 
+  void SetGsoEnabled(bool enabled) {
+#if HAVE_UDP_GSO
+    gso_enabled_ = enabled;
+#endif
+  }
+
  protected:
   friend class base::RefCountedThreadSafe<UDPSocketPosixSender>;
 
@@ -105,16 +124,30 @@ class NET_EXPORT UDPSocketPosixSender
                        unsigned int vlen,
                        unsigned int flags) const;
 #endif
+#if HAVE_UDP_GSO
+  virtual ssize_t Sendmsg(int sockfd,
+                          const struct msghdr* msg,
+                          int flags) const;
+#endif
 
   SendResult InternalSendBuffers(int fd, DatagramBuffers buffers) const;
 #if HAVE_SENDMMSG
   SendResult InternalSendmmsgBuffers(int fd, DatagramBuffers buffers) const;
 #endif
+#if HAVE_UDP_GSO
+  // Whether |buffers| can be sent as one GSO datagram: there are at least
+  // two, all of the same size except the last one, which may be smaller.
+  static bool CanSendGsoBuffers(const DatagramBuffers& buffers);
+  // Sends |buffers| as one GSO datagram. Returns ERR_NOT_IMPLEMENTED if the
+  // kernel or the network device doesn't support GSO.
+  SendResult InternalSendGsoBuffers(int fd, DatagramBuffers buffers) const;
+#endif
 
  private:
   UDPSocketPosixSender(const UDPSocketPosixSender&) = delete;
   UDPSocketPosixSender& operator=(const UDPSocketPosixSender&) = delete;
   bool sendmmsg_enabled_;
+  bool gso_enabled_;
 };
 
 class NET_EXPORT UDPSocketPosix {
@@ -207,6 +240,19 @@ class NET_EXPORT UDPSocketPosix {
   // has been connected.
   int Read(IOBuffer* buf, int buf_len, CompletionOnceCallback callback);
 
+  // Reads up to |kReadMultipleMaxBuffers| datagrams at once, with recvmmsg()
+  // where available, into |*buffers|, which come from the pool created by
+  // SetMaxPacketSize(). The buffers already in |*buffers|, typically those of
+  // the previous call once they have been processed, are returned to the pool
+  // first. Datagrams larger than the maximum packet size are dropped.
+  // Returns the number of datagrams read, or a net error code (in particular
+  // ERR_MSG_TOO_BIG if all the datagrams were dropped). If ERR_IO_PENDING is
+  // returned, the caller must keep |buffers| alive until |callback| is called
+  // with the result.
+  // Only usable from the client-side of a UDP socket, after the socket
+  // has been connected.
+  int ReadMultiple(DatagramBuffers* buffers, CompletionOnceCallback callback);
+
   // Writes to the socket.
   // Only usable from the client-side of a UDP socket, after the socket
   // has been connected.
@@ -357,6 +403,11 @@ class NET_EXPORT UDPSocketPosix {
     sender_->SetSendmmsgEnabled(enabled);
   }
 
+  void SetGsoEnabled(bool enabled) {
+    DCHECK(sender_ != nullptr);
+    sender_->SetGsoEnabled(enabled);
+  }
+
   void SetWriteBatchingActive(bool active) { write_batching_active_ = active; }
 
   void SetWriteAsyncMaxBuffers(int value) {
@@ -506,6 +557,10 @@ class NET_EXPORT UDPSocketPosix {
   int InternalRecvFromNonConnectedSocket(IOBuffer* buf,
                                          int buf_len,
                                          IPEndPoint* address);
+
+  // Reads datagrams for ReadMultiple() into new buffers added to the empty
+  // |buffers|.
+  int InternalReadMultiple(DatagramBuffers* buffers);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
   // Applies |socket_options_| to |socket_|. Should be called before
@@ -579,6 +634,9 @@ class NET_EXPORT UDPSocketPosix {
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
 
+  // The buffers of a pending ReadMultiple(). When set, |read_buf_| is null.
+  DatagramBuffers* read_multiple_buffers_;
+
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
@@ -5,11 +5,15 @@
 #include "net/socket/udp_socket_posix.h"
 
 #include "net/base/completion_repeating_callback.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
 #include "net/log/test_net_log.h"
 #include "net/log/test_net_log_entry.h"
 #include "net/log/test_net_log_util.h"
 #include "net/socket/datagram_socket.h"
+#include "net/test/gtest_util.h"
 #include "net/test/test_with_scoped_task_environment.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -45,6 +49,13 @@ int SetNotImplemented() {
 }
 #endif
 
+#if HAVE_UDP_GSO
+int SetInvalidArgument() {
+  errno = EINVAL;
+  return -1;
+}
+#endif
+
 bool WatcherSetInvalidHandle() {
   errno = EBADF;
   return false;
@@ -67,6 +78,10 @@ class MockUDPSocketPosixSender : public UDPSocketPosixSender {
                          struct mmsghdr* msgvec,
                          unsigned int vlen,
                          unsigned int flags));
+#if HAVE_UDP_GSO
+  MOCK_CONST_METHOD3(Sendmsg,
+                     ssize_t(int sockfd, const struct msghdr* msg, int flags));
+#endif
 
  public:
   SendResult InternalSendBuffers(int fd, DatagramBuffers buffers) const {
@@ -78,6 +93,12 @@ class MockUDPSocketPosixSender : public UDPSocketPosixSender {
                                                          std::move(buffers));
   }
 #endif
+#if HAVE_UDP_GSO
+  using UDPSocketPosixSender::CanSendGsoBuffers;
+  SendResult InternalSendGsoBuffers(int fd, DatagramBuffers buffers) const {
+    return UDPSocketPosixSender::InternalSendGsoBuffers(fd, std::move(buffers));
+  }
+#endif
 
  private:
   ~MockUDPSocketPosixSender() override{};
@@ -337,6 +358,129 @@ TEST_F(UDPSocketPosixTest, SendInternalSendmmsgFallback) {
 
 #endif  // HAVE_SENDMMSG
 
+#if HAVE_UDP_GSO
+
+TEST_F(UDPSocketPosixTest, CanSendGsoBuffers) {
+  AddBuffer(kHelloMsg);
+  EXPECT_FALSE(MockUDPSocketPosixSender::CanSendGsoBuffers(buffers_));
+  AddBuffer(kHelloMsg);
+  EXPECT_TRUE(MockUDPSocketPosixSender::CanSendGsoBuffers(buffers_));
+  // Only the last segment may be shorter.
+  AddBuffer(kHelloMsg.substr(1));
+  EXPECT_TRUE(MockUDPSocketPosixSender::CanSendGsoBuffers(buffers_));
+  AddBuffer(kHelloMsg);
+  EXPECT_FALSE(MockUDPSocketPosixSender::CanSendGsoBuffers(buffers_));
+  buffers_.clear();
+
+  // kSecondMsg is longer than kHelloMsg.
+  AddBuffers();
+  EXPECT_FALSE(MockUDPSocketPosixSender::CanSendGsoBuffers(buffers_));
+}
+
+TEST_F(UDPSocketPosixTest, InternalSendGsoBuffers) {
+  for (size_t i = 0; i < kNumMsgs; i++)
+    AddBuffer(kHelloMsg);
+  EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+      .WillOnce(Invoke([](int sockfd, const struct msghdr* msg, int flags) {
+        EXPECT_EQ(kNumMsgs, msg->msg_iovlen);
+        const struct cmsghdr* cmsg =
+            CMSG_FIRSTHDR(const_cast<struct msghdr*>(msg));
+        EXPECT_EQ(IPPROTO_UDP, cmsg->cmsg_level);
+        uint16_t segment_size;
+        memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+        EXPECT_EQ(kHelloMsg.length(), segment_size);
+        return static_cast<ssize_t>(kNumMsgs * kHelloMsg.length());
+      }));
+  SendResult result =
+      socket_.sender()->InternalSendGsoBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(3, result.write_count);
+  EXPECT_EQ(kNumMsgs, result.buffers.size());
+}
+
+TEST_F(UDPSocketPosixTest, InternalSendGsoBuffersWriteError) {
+  for (size_t i = 0; i < kNumMsgs; i++)
+    AddBuffer(kHelloMsg);
+  EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+      .WillOnce(InvokeWithoutArgs(SetWouldBlock));
+  SendResult result =
+      socket_.sender()->InternalSendGsoBuffers(1, std::move(buffers_));
+  EXPECT_EQ(ERR_IO_PENDING, result.rv);
+  EXPECT_EQ(0, result.write_count);
+  EXPECT_EQ(kNumMsgs, result.buffers.size());
+}
+
+TEST_F(UDPSocketPosixTest, SendInternalGsoFallback) {
+  socket_.sender()->SetGsoEnabled(true);
+  for (size_t i = 0; i < kNumMsgs; i++)
+    AddBuffer(kHelloMsg);
+  {
+    InSequence dummy;
+    EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+        .WillOnce(InvokeWithoutArgs(SetInvalidArgument));
+    EXPECT_CALL(*socket_.sender(), Send(_, _, kHelloMsg.length(), _))
+        .Times(2 * kNumMsgs)
+        .WillRepeatedly(Return(kHelloMsg.length()));
+  }
+  SendResult result = socket_.sender()->SendBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(3, result.write_count);
+
+  // GSO stays disabled after it failed once.
+  buffers_ = std::move(result.buffers);
+  result = socket_.sender()->SendBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(3, result.write_count);
+}
+
+TEST_F(UDPSocketPosixTest, SendInternalGsoSkipsMixedSizes) {
+  socket_.sender()->SetGsoEnabled(true);
+  AddBuffers();
+  EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _)).Times(0);
+  ExpectSends();
+  SendResult result = socket_.sender()->SendBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(3, result.write_count);
+}
+
+#endif  // HAVE_UDP_GSO
+
+TEST_F(UDPSocketPosixTest, ReadMultiple) {
+  UDPSocketPosix server(DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource());
+  ASSERT_THAT(server.Open(ADDRESS_FAMILY_IPV4), IsOk());
+  ASSERT_THAT(server.Bind(IPEndPoint(IPAddress::IPv4Localhost(), 0)), IsOk());
+  IPEndPoint server_address;
+  ASSERT_THAT(server.GetLocalAddress(&server_address), IsOk());
+
+  UDPSocketPosix client(DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource());
+  ASSERT_THAT(client.Open(ADDRESS_FAMILY_IPV4), IsOk());
+  ASSERT_THAT(client.Connect(server_address), IsOk());
+  client.SetMaxPacketSize(kMaxPacketSize);
+  IPEndPoint client_address;
+  ASSERT_THAT(client.GetLocalAddress(&client_address), IsOk());
+
+  // Send the datagrams before reading, so that they are all read at once.
+  // Too long datagrams are dropped.
+  TestCompletionCallback callback;
+  std::string too_long_msg(kMaxPacketSize + 1, 'A');
+  for (const std::string& msg : {msgs_[0], too_long_msg, msgs_[1], msgs_[2]}) {
+    auto io_buffer = base::MakeRefCounted<StringIOBuffer>(msg);
+    EXPECT_EQ(static_cast<int>(msg.length()),
+              server.SendTo(io_buffer.get(), msg.length(), client_address,
+                            callback.callback()));
+  }
+
+  DatagramBuffers buffers;
+  EXPECT_EQ(static_cast<int>(kNumMsgs),
+            client.ReadMultiple(&buffers, callback.callback()));
+  ASSERT_EQ(kNumMsgs, buffers.size());
+  size_t i = 0;
+  for (const auto& buffer : buffers) {
+    EXPECT_EQ(msgs_[i], std::string(buffer->data(), buffer->length()));
+    i++;
+  }
+}
+
 TEST_F(UDPSocketPosixTest, DidSendBuffers) {
   AddBuffers();
   SaveBufferPtrs();
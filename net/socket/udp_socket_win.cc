@@ -1226,6 +1226,7 @@ bool UDPSocketWin::WriteAsyncEnabled() {
 void UDPSocketWin::SetMaxPacketSize(size_t max_packet_size) {}
 void UDPSocketWin::SetWriteMultiCoreEnabled(bool enabled) {}
 void UDPSocketWin::SetSendmmsgEnabled(bool enabled) {}
+void UDPSocketWin::SetGsoEnabled(bool enabled) {}
 void UDPSocketWin::SetWriteBatchingActive(bool active) {}
 
 int UDPSocketWin::WriteAsync(
@@ -212,6 +212,7 @@ class NET_EXPORT UDPSocketWin : public base::win::ObjectWatcher::Delegate {
   void SetMaxPacketSize(size_t max_packet_size);
   void SetWriteMultiCoreEnabled(bool enabled);
   void SetSendmmsgEnabled(bool enabled);
+  void SetGsoEnabled(bool enabled);
   void SetWriteBatchingActive(bool active);
 
   int WriteAsync(DatagramBuffers buffers,
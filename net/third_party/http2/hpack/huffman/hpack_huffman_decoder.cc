@@ -345,6 +345,51 @@ struct ShortCodeInfo {
     {0x7a, 7},  // Match: 0b1111011, Symbol: z
 };
 
+// The multi-symbol table is indexed by the next kMultiSymbolBitCount bits of
+// the encoded string, and holds the (up to 2) whole codes that these bits
+// start with. Most characters of header values have codes of 5 to 7 bits, so
+// a lookup usually decodes 2 symbols, instead of 1 for kShortCodeTable.
+constexpr HuffmanAccumulatorBitCount kMultiSymbolBitCount = 12;
+constexpr size_t kMultiSymbolTableSize = 1 << kMultiSymbolBitCount;
+constexpr size_t kMaxSymbolsPerLookup = 2;
+
+struct MultiSymbolInfo {
+  uint8_t symbols[kMaxSymbolsPerLookup];
+  // 0 if the leading code is longer than kMultiSymbolBitCount bits.
+  uint8_t symbol_count;
+  // The total length of the codes of |symbols|.
+  uint8_t length;
+};
+
+// Builds the multi-symbol table from PrefixToInfo() and kCanonicalToSymbol,
+// so that it can't disagree with the decoding of longer codes. The bits past
+// the end of the index are taken to be 0, which doesn't change the code found
+// as long as it fits in the index: code groups of a length L are aligned on
+// multiples of 2^(32 - L).
+const MultiSymbolInfo* GetMultiSymbolTable() {
+  static const MultiSymbolInfo* const table = [] {
+    MultiSymbolInfo* entries = new MultiSymbolInfo[kMultiSymbolTableSize]();
+    for (size_t index = 0; index < kMultiSymbolTableSize; ++index) {
+      MultiSymbolInfo& info = entries[index];
+      HuffmanCode bits = static_cast<HuffmanCode>(index)
+                         << (kHuffmanCodeBitCount - kMultiSymbolBitCount);
+      while (info.symbol_count < kMaxSymbolsPerLookup) {
+        PrefixInfo prefix_info = PrefixToInfo(bits);
+        if (info.length + prefix_info.code_length > kMultiSymbolBitCount)
+          break;
+        // The EOS code is 30 bits long, so it never fits.
+        uint32_t canonical = prefix_info.DecodeToCanonical(bits);
+        DCHECK_LT(canonical, 256u);
+        info.symbols[info.symbol_count++] = kCanonicalToSymbol[canonical];
+        info.length += prefix_info.code_length;
+        bits <<= prefix_info.code_length;
+      }
+    }
+    return entries;
+  }();
+  return table;
+}
+
 }  // namespace
 
 HuffmanBitBuffer::HuffmanBitBuffer() {
@@ -417,33 +462,64 @@ HpackHuffmanDecoder::~HpackHuffmanDecoder() = default;
 bool HpackHuffmanDecoder::Decode(Http2StringPiece input, Http2String* output) {
   DVLOG(1) << "HpackHuffmanDecoder::Decode";
 
+  const MultiSymbolInfo* const multi_symbol_table = GetMultiSymbolTable();
+
   // Fill bit_buffer_ from input.
   input.remove_prefix(bit_buffer_.AppendBytes(input));
 
   while (true) {
     DVLOG(3) << "Enter Decode Loop, bit_buffer_: " << bit_buffer_;
-    if (bit_buffer_.count() >= 7) {
-      // Get high 7 bits of the bit buffer, see if that contains a complete
-      // code of 5, 6 or 7 bits.
-      uint8_t short_code =
-          bit_buffer_.value() >> (kHuffmanAccumulatorBitCount - 7);
-      DCHECK_LT(short_code, 128);
-      if (short_code < kShortCodeTableSize) {
-        ShortCodeInfo info = kShortCodeTable[short_code];
-        bit_buffer_.ConsumeBits(info.length);
-        output->push_back(static_cast<char>(info.symbol));
+    if (bit_buffer_.count() >= kMultiSymbolBitCount) {
+      // Look up the high 12 bits of the bit buffer, to decode the one or two
+      // complete codes they start with, as long as there are 12 bits. The
+      // bits are kept in locals meanwhile: as far as the compiler knows,
+      // appending to |output| could modify bit_buffer_.
+      HuffmanAccumulator bits = bit_buffer_.value();
+      const HuffmanAccumulatorBitCount available = bit_buffer_.count();
+      HuffmanAccumulatorBitCount remaining = available;
+      do {
+        const MultiSymbolInfo& info =
+            multi_symbol_table[bits >> (kHuffmanAccumulatorBitCount -
+                                        kMultiSymbolBitCount)];
+        if (info.symbol_count == 0)
+          break;
+        output->push_back(static_cast<char>(info.symbols[0]));
+        if (info.symbol_count > 1)
+          output->push_back(static_cast<char>(info.symbols[1]));
+        bits <<= info.length;
+        remaining -= info.length;
+      } while (remaining >= kMultiSymbolBitCount);
+      if (remaining < available) {
+        // Shifting out all 64 bits at once would be undefined.
+        if (remaining == 0)
+          bit_buffer_.Reset();
+        else
+          bit_buffer_.ConsumeBits(available - remaining);
         continue;
       }
-      // The code is more than 7 bits long. Use PrefixToInfo, etc. to decode
+      // The code is more than 12 bits long. Use PrefixToInfo, etc. to decode
       // longer codes.
     } else {
       // We may have (mostly) drained bit_buffer_. If we can top it up, try
-      // using the table decoder above.
+      // using the table decoders above.
       size_t byte_count = bit_buffer_.AppendBytes(input);
       if (byte_count > 0) {
         input.remove_prefix(byte_count);
         continue;
       }
+      if (bit_buffer_.count() >= 7) {
+        // Near the end of the input, get high 7 bits of the bit buffer, see if
+        // that contains a complete code of 5, 6 or 7 bits.
+        uint8_t short_code =
+            bit_buffer_.value() >> (kHuffmanAccumulatorBitCount - 7);
+        DCHECK_LT(short_code, 128);
+        if (short_code < kShortCodeTableSize) {
+          ShortCodeInfo info = kShortCodeTable[short_code];
+          bit_buffer_.ConsumeBits(info.length);
+          output->push_back(static_cast<char>(info.symbol));
+          continue;
+        }
+      }
     }
 
     HuffmanCode code_prefix = bit_buffer_.value() >> kExtraAccumulatorBitCount;
@@ -239,6 +239,56 @@ TEST_F(HpackHuffmanDecoderTest, SpecResponseExamples) {
   }
 }
 
+// Decoding one byte at a time mostly leaves too few bits in the accumulator
+// for the multi-symbol table, so this compares the other decoding paths with
+// decoding the whole string at once.
+TEST_F(HpackHuffmanDecoderTest, DecodeOneByteAtATime) {
+  HpackHuffmanDecoder decoder;
+  // clang-format off
+  Http2String test_table[] = {
+    Http2HexDecode("f1e3c2e5f23a6ba0ab90f4ff"),
+    "www.example.com",
+    Http2HexDecode("d07abe941054d444a8200595040b8166"
+            "e082a62d1bff"),
+    "Mon, 21 Oct 2013 20:13:21 GMT",
+    Http2HexDecode("94e7821dd7f2e6c7b335dfdfcd5b3960"
+            "d5af27087f3672c1ab270fb5291f9587"
+            "316065c003ed4ee5b1063d5007"),
+    "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1",
+  };
+  // clang-format on
+  for (size_t i = 0; i != arraysize(test_table); i += 2) {
+    const Http2String& huffman_encoded(test_table[i]);
+    const Http2String& plain_string(test_table[i + 1]);
+    Http2String buffer;
+    decoder.Reset();
+    for (size_t j = 0; j != huffman_encoded.size(); ++j) {
+      EXPECT_TRUE(decoder.Decode(Http2StringPiece(&huffman_encoded[j], 1),
+                                 &buffer))
+          << decoder;
+    }
+    EXPECT_TRUE(decoder.InputProperlyTerminated()) << decoder;
+    EXPECT_EQ(buffer, plain_string);
+  }
+}
+
+// Codes longer than the multi-symbol table index are still decoded, and EOS
+// is still rejected.
+TEST_F(HpackHuffmanDecoderTest, LongCodes) {
+  HpackHuffmanDecoder decoder;
+  Http2String buffer;
+  // 0x00 (13 bits), '\\' (19 bits) and 0xff (26 bits), padded with 6 bits.
+  EXPECT_TRUE(
+      decoder.Decode(Http2HexDecode("ffc7fff0fffffbbf"), &buffer)) << decoder;
+  EXPECT_TRUE(decoder.InputProperlyTerminated()) << decoder;
+  EXPECT_EQ(Http2String("\0\\\xff", 3), buffer);
+
+  // EOS (30 bits), padded with 2 bits.
+  decoder.Reset();
+  buffer.clear();
+  EXPECT_FALSE(decoder.Decode(Http2HexDecode("ffffffff"), &buffer));
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace http2
@@ -88,13 +88,7 @@ void PacingSender::OnPacketSent(
   if (!pacing_limited_ || lumpy_tokens_ == 0) {
     // Reset lumpy_tokens_ if either application or cwnd throttles sending or
     // token runs out.
-    lumpy_tokens_ = std::max(
-        1u, std::min(static_cast<uint32_t>(
-                         GetQuicFlag(FLAGS_quic_lumpy_pacing_size)),
-                     static_cast<uint32_t>(
-                         (sender_->GetCongestionWindow() *
-                          GetQuicFlag(FLAGS_quic_lumpy_pacing_cwnd_fraction)) /
-                         kDefaultTCPMSS)));
+    lumpy_tokens_ = GetLumpyPacingSize();
   }
   --lumpy_tokens_;
   if (pacing_limited_) {
@@ -139,6 +133,71 @@ QuicTime::Delta PacingSender::TimeUntilSend(
   return QuicTime::Delta::Zero();
 }
 
+QuicPacketCount PacingSender::GetBatchQuota(
+    QuicTime now,
+    QuicByteCount bytes_in_flight,
+    QuicByteCount packet_size,
+    QuicPacketCount max_packets) const {
+  DCHECK(sender_ != nullptr);
+
+  // Replays TimeUntilSend() and OnPacketSent() on copies of the pacing state,
+  // as if the packets were sent one by one at |now|.
+  uint32_t burst_tokens = burst_tokens_;
+  uint32_t lumpy_tokens = lumpy_tokens_;
+  QuicTime ideal_next_packet_send_time = ideal_next_packet_send_time_;
+  bool pacing_limited = pacing_limited_;
+  QuicPacketCount quota = 0;
+  while (quota < max_packets) {
+    if (!sender_->CanSend(bytes_in_flight))
+      break;
+    if (burst_tokens == 0 && bytes_in_flight != 0 && lumpy_tokens == 0 &&
+        ideal_next_packet_send_time > now + alarm_granularity_) {
+      break;
+    }
+    ++quota;
+
+    if (bytes_in_flight == 0 && !sender_->InRecovery()) {
+      burst_tokens = std::min(
+          initial_burst_size_,
+          static_cast<uint32_t>(sender_->GetCongestionWindow() /
+                                kDefaultTCPMSS));
+    }
+    if (burst_tokens > 0) {
+      --burst_tokens;
+      if (!GetQuicReloadableFlag(
+              quic_donot_reset_ideal_next_packet_send_time)) {
+        ideal_next_packet_send_time = QuicTime::Zero();
+      }
+      pacing_limited = false;
+    } else {
+      QuicTime::Delta delay =
+          PacingRate(bytes_in_flight + packet_size).TransferTime(packet_size);
+      if (!pacing_limited || lumpy_tokens == 0)
+        lumpy_tokens = GetLumpyPacingSize();
+      --lumpy_tokens;
+      if (pacing_limited) {
+        ideal_next_packet_send_time = ideal_next_packet_send_time + delay;
+      } else {
+        ideal_next_packet_send_time =
+            std::max(ideal_next_packet_send_time + delay, now + delay);
+      }
+      pacing_limited = sender_->CanSend(bytes_in_flight + packet_size);
+    }
+    bytes_in_flight += packet_size;
+  }
+  return quota;
+}
+
+uint32_t PacingSender::GetLumpyPacingSize() const {
+  return std::max(
+      1u, std::min(static_cast<uint32_t>(
+                       GetQuicFlag(FLAGS_quic_lumpy_pacing_size)),
+                   static_cast<uint32_t>(
+                       (sender_->GetCongestionWindow() *
+                        GetQuicFlag(FLAGS_quic_lumpy_pacing_cwnd_fraction)) /
+                       kDefaultTCPMSS)));
+}
+
 QuicBandwidth PacingSender::PacingRate(QuicByteCount bytes_in_flight) const {
   DCHECK(sender_ != nullptr);
   if (!max_pacing_rate_.IsZero()) {
@@ -72,6 +72,16 @@ class QUIC_EXPORT_PRIVATE PacingSender {
 
   QuicBandwidth PacingRate(QuicByteCount bytes_in_flight) const;
 
+  // Returns how many retransmittable packets of |packet_size| bytes, up to
+  // |max_packets|, can be sent back to back at |now| without any of them being
+  // delayed by TimeUntilSend(), so that a writer which batches packets can
+  // write them at once. Each packet must still be reported with
+  // OnPacketSent().
+  QuicPacketCount GetBatchQuota(QuicTime now,
+                                QuicByteCount bytes_in_flight,
+                                QuicByteCount packet_size,
+                                QuicPacketCount max_packets) const;
+
   QuicTime ideal_next_packet_send_time() const {
     return ideal_next_packet_send_time_;
   }
@@ -79,6 +89,9 @@ class QUIC_EXPORT_PRIVATE PacingSender {
  private:
   friend class test::QuicSentPacketManagerPeer;
 
+  // Returns the number of lumpy tokens to use once they run out.
+  uint32_t GetLumpyPacingSize() const;
+
   // Underlying sender. Not owned.
   SendAlgorithmInterface* sender_;
   // If not QuicBandidth::Zero, the maximum rate the PacingSender will use.
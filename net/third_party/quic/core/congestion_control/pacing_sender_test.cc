@@ -428,5 +428,47 @@ TEST_F(PacingSenderTest, LumpyPacingWithInitialBurstToken) {
   CheckPacketIsDelayed(QuicTime::Delta::FromMilliseconds(2));
 }
 
+TEST_F(PacingSenderTest, BatchQuota) {
+  // Configure pacing rate of 1 packet per 1 ms.
+  InitPacingRate(10, QuicBandwidth::FromBytesAndTimeDelta(
+                         kMaxPacketSize, QuicTime::Delta::FromMilliseconds(1)));
+  UpdateRtt();
+
+  EXPECT_CALL(*mock_sender_, CanSend(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock_sender_, GetCongestionWindow())
+      .WillRepeatedly(Return(10 * kDefaultTCPMSS));
+  // The 10 burst packets, then the "make up" packet and one "into the future"
+  // one, as in InitialBurst.
+  EXPECT_EQ(12u, pacing_sender_->GetBatchQuota(clock_.Now(), kBytesInFlight,
+                                               kMaxPacketSize, 32));
+  EXPECT_EQ(5u, pacing_sender_->GetBatchQuota(clock_.Now(), kBytesInFlight,
+                                              kMaxPacketSize, 5));
+
+  // The quota matches the packets which TimeUntilSend() lets through.
+  for (int i = 0; i < 12; ++i)
+    CheckPacketIsSentImmediately();
+  EXPECT_CALL(*mock_sender_, CanSend(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock_sender_, GetCongestionWindow())
+      .WillRepeatedly(Return(10 * kDefaultTCPMSS));
+  EXPECT_EQ(0u, pacing_sender_->GetBatchQuota(clock_.Now(), kBytesInFlight,
+                                              kMaxPacketSize, 32));
+  clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(2));
+  EXPECT_EQ(2u, pacing_sender_->GetBatchQuota(clock_.Now(), kBytesInFlight,
+                                              kMaxPacketSize, 32));
+}
+
+TEST_F(PacingSenderTest, BatchQuotaCwndLimited) {
+  InitPacingRate(10, QuicBandwidth::FromBytesAndTimeDelta(
+                         kMaxPacketSize, QuicTime::Delta::FromMilliseconds(1)));
+
+  EXPECT_CALL(*mock_sender_, CanSend(kBytesInFlight)).WillOnce(Return(true));
+  EXPECT_CALL(*mock_sender_, CanSend(kBytesInFlight + kMaxPacketSize))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*mock_sender_, CanSend(kBytesInFlight + 2 * kMaxPacketSize))
+      .WillOnce(Return(false));
+  EXPECT_EQ(2u, pacing_sender_->GetBatchQuota(clock_.Now(), kBytesInFlight,
+                                              kMaxPacketSize, 32));
+}
+
 }  // namespace test
 }  // namespace quic
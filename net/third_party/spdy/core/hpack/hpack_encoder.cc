@@ -8,6 +8,7 @@
 #include <limits>
 
 #include "base/logging.h"
+#include "base/strings/string_piece.h"
 #include "net/third_party/spdy/core/hpack/hpack_constants.h"
 #include "net/third_party/spdy/core/hpack/hpack_header_table.h"
 #include "net/third_party/spdy/core/hpack/hpack_huffman_table.h"
@@ -74,6 +75,9 @@ bool DefaultPolicy(SpdyStringPiece name, SpdyStringPiece /* value */) {
 
 }  // namespace
 
+const size_t HpackEncoder::kMaxCachedStringSize;
+const size_t HpackEncoder::kStringCacheSize;
+
 HpackEncoder::HpackEncoder(const HpackHuffmanTable& table)
     : output_stream_(),
       huffman_table_(table),
@@ -126,8 +130,13 @@ void HpackEncoder::ApplyHeaderTableSizeSetting(size_t size_setting) {
 
 size_t HpackEncoder::EstimateMemoryUsage() const {
   // |huffman_table_| is a singleton. It's accounted for in spdy_session_pool.cc
-  return SpdyEstimateMemoryUsage(header_table_) +
-         SpdyEstimateMemoryUsage(output_stream_);
+  size_t size = SpdyEstimateMemoryUsage(header_table_) +
+                SpdyEstimateMemoryUsage(output_stream_);
+  for (const CachedString& cached : string_cache_) {
+    size += SpdyEstimateMemoryUsage(cached.str) +
+            SpdyEstimateMemoryUsage(cached.encoded);
+  }
+  return size;
 }
 
 void HpackEncoder::EncodeRepresentations(RepresentationIterator* iter,
@@ -189,18 +198,38 @@ void HpackEncoder::EmitLiteral(const Representation& representation) {
 }
 
 void HpackEncoder::EmitString(SpdyStringPiece str) {
+  if (!enable_compression_ || str.empty() ||
+      str.size() > kMaxCachedStringSize) {
+    EncodeString(str, &output_stream_);
+    return;
+  }
+
+  CachedString& cached =
+      string_cache_[base::StringPieceHash()(str) % kStringCacheSize];
+  if (cached.str != str) {
+    HpackOutputStream stream;
+    EncodeString(str, &stream);
+    str.CopyToString(&cached.str);
+    stream.TakeString(&cached.encoded);
+  }
+  // String literals start and end on a byte boundary.
+  output_stream_.AppendBytes(cached.encoded);
+}
+
+void HpackEncoder::EncodeString(SpdyStringPiece str,
+                                HpackOutputStream* out) const {
   size_t encoded_size =
       enable_compression_ ? huffman_table_.EncodedSize(str) : str.size();
   if (encoded_size < str.size()) {
     DVLOG(2) << "Emitted Huffman-encoded string of length " << encoded_size;
-    output_stream_.AppendPrefix(kStringLiteralHuffmanEncoded);
-    output_stream_.AppendUint32(encoded_size);
-    huffman_table_.EncodeString(str, &output_stream_);
+    out->AppendPrefix(kStringLiteralHuffmanEncoded);
+    out->AppendUint32(encoded_size);
+    huffman_table_.EncodeString(str, out);
   } else {
     DVLOG(2) << "Emitted literal string of length " << str.size();
-    output_stream_.AppendPrefix(kStringLiteralIdentityEncoded);
-    output_stream_.AppendUint32(str.size());
-    output_stream_.AppendBytes(str);
+    out->AppendPrefix(kStringLiteralIdentityEncoded);
+    out->AppendUint32(str.size());
+    out->AppendBytes(str);
   }
 }
 
@@ -106,6 +106,16 @@ class SPDY_EXPORT_PRIVATE HpackEncoder {
   class RepresentationIterator;
   class Encoderator;
 
+  // Strings of at most this size are kept in |string_cache_|.
+  static const size_t kMaxCachedStringSize = 256;
+  static const size_t kStringCacheSize = 32;
+
+  // A recently emitted string, and the string literal emitted for it.
+  struct CachedString {
+    SpdyString str;
+    SpdyString encoded;
+  };
+
   // Encodes a sequence of header name-value pairs as a single header block.
   void EncodeRepresentations(RepresentationIterator* iter, SpdyString* output);
 
@@ -120,6 +130,9 @@ class SPDY_EXPORT_PRIVATE HpackEncoder {
   // Emits a Huffman or identity string (whichever is smaller).
   void EmitString(SpdyStringPiece str);
 
+  // Appends the string literal EmitString() emits for |str| to |out|.
+  void EncodeString(SpdyStringPiece str, HpackOutputStream* out) const;
+
   // Emits the current dynamic table size if the table size was recently
   // updated and we have not yet emitted it (Section 6.3).
   void MaybeEmitTableSize();
@@ -139,6 +152,12 @@ class SPDY_EXPORT_PRIVATE HpackEncoder {
   HpackHeaderTable header_table_;
   HpackOutputStream output_stream_;
 
+  // Header values that aren't indexed, like user agents or cookie crumbs,
+  // still repeat on most requests of a connection, so their literals are
+  // cached rather than Huffman encoded every time. This is a direct-mapped
+  // cache, indexed by the hash of the string.
+  CachedString string_cache_[kStringCacheSize];
+
   const HpackHuffmanTable& huffman_table_;
   size_t min_table_size_setting_received_;
   HeaderListener listener_;
@@ -5,10 +5,12 @@
 #include "net/third_party/spdy/core/hpack/hpack_encoder.h"
 
 #include <map>
+#include <vector>
 
 #include "base/rand_util.h"
 #include "net/base/arena.h"
 #include "net/third_party/spdy/core/hpack/hpack_huffman_table.h"
+#include "net/third_party/spdy/platform/api/spdy_str_cat.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -323,6 +325,30 @@ TEST_P(HpackEncoderTest, StringsDynamicallySelectHuffmanCoding) {
   EXPECT_EQ(expected_out, actual_out);
 }
 
+TEST_P(HpackEncoderTest, RepeatedStringsAreCached) {
+  // More distinct strings than cache slots, so some of them collide, with a
+  // string too long to be cached and a few repetitions.
+  std::vector<SpdyString> strings;
+  for (int i = 0; i < 100; ++i)
+    strings.push_back(SpdyStrCat("value-", i));
+  strings.push_back(SpdyString(1000, 'x'));
+  strings.push_back("feedbeef");
+  strings.push_back(strings[0]);
+  strings.push_back(strings.back());
+  strings.push_back("@@@@@@");
+  for (int round = 0; round < 2; ++round) {
+    for (const SpdyString& str : strings) {
+      peer_.EmitString(str);
+      ExpectString(&expected_, str);
+    }
+  }
+
+  SpdyString expected_out, actual_out;
+  expected_.TakeString(&expected_out);
+  peer_.TakeString(&actual_out);
+  EXPECT_EQ(expected_out, actual_out);
+}
+
 TEST_P(HpackEncoderTest, EncodingWithoutCompression) {
   encoder_.SetHeaderListener(
       [this](SpdyStringPiece name, SpdyStringPiece value) {
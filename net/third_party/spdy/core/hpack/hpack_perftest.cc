@@ -0,0 +1,125 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/test/perf_time_logger.h"
+#include "net/third_party/spdy/core/hpack/hpack_constants.h"
+#include "net/third_party/spdy/core/hpack/hpack_decoder_adapter.h"
+#include "net/third_party/spdy/core/hpack/hpack_encoder.h"
+#include "net/third_party/spdy/core/spdy_header_block.h"
+#include "net/third_party/spdy/platform/api/spdy_string.h"
+#include "net/third_party/spdy/platform/api/spdy_string_piece.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace spdy {
+
+namespace {
+
+const int kIterations = 100000;
+
+// A typical request of a browser.
+SpdyHeaderBlock MakeRequestHeaders() {
+  SpdyHeaderBlock headers;
+  headers[":method"] = "GET";
+  headers[":authority"] = "www.example.com";
+  headers[":scheme"] = "https";
+  headers[":path"] = "/images/branding/product/2x/logo_color_272x92dp.png";
+  headers["user-agent"] =
+      "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like "
+      "Gecko) Chrome/66.0.3359.139 Safari/537.36";
+  headers["accept"] = "image/webp,image/apng,image/*,*/*;q=0.8";
+  headers["referer"] = "https://www.example.com/search?q=hpack";
+  headers["accept-encoding"] = "gzip, deflate, br";
+  headers["accept-language"] = "en-US,en;q=0.9,fr;q=0.8";
+  headers["cookie"] =
+      "SID=ZAbDEjTeGXqJ8tBVKHCaW7aSfLmvqgnVZa5n; HSID=AnXsnQm3W1cf2DfQb; "
+      "APISID=Y4sCaNyXsMEAX5dJ/AnM1QuVSxGk3hA6ab";
+  return headers;
+}
+
+// A typical response, with a repeated header.
+SpdyHeaderBlock MakeResponseHeaders() {
+  SpdyHeaderBlock headers;
+  headers[":status"] = "200";
+  headers["date"] = "Mon, 14 May 2018 16:30:42 GMT";
+  headers["content-type"] = "text/html; charset=UTF-8";
+  headers["cache-control"] = "private, max-age=0";
+  headers["expires"] = "-1";
+  headers["content-encoding"] = "br";
+  headers["server"] = "example";
+  headers["x-xss-protection"] = "1; mode=block";
+  headers["x-frame-options"] = "SAMEORIGIN";
+  headers["alt-svc"] = "quic=\":443\"; ma=2592000; v=\"43,42,41,39,35\"";
+  headers.AppendValueOrAddHeader("set-cookie",
+                                 "NID=130=qW3rT; expires=Tue, 13-Nov-2018 "
+                                 "16:30:42 GMT; path=/; domain=.example.com");
+  headers.AppendValueOrAddHeader("set-cookie",
+                                 "1P_JAR=2018-05-14-16; expires=Wed, "
+                                 "13-Jun-2018 16:30:42 GMT; path=/");
+  return headers;
+}
+
+// Nothing is inserted in the dynamic table, so that every header field is a
+// string literal, as it is for the first request of a connection.
+bool NeverIndex(SpdyStringPiece /*name*/, SpdyStringPiece /*value*/) {
+  return false;
+}
+
+}  // namespace
+
+TEST(HpackPerfTest, EncodeRequestHeaders) {
+  const SpdyHeaderBlock headers = MakeRequestHeaders();
+  HpackEncoder encoder(ObtainHpackHuffmanTable());
+  encoder.SetIndexingPolicy(NeverIndex);
+  SpdyString encoded;
+  base::PerfTimeLogger timer("Hpack_encode_request_headers");
+  for (int i = 0; i < kIterations; ++i) {
+    encoded.clear();
+    EXPECT_TRUE(encoder.EncodeHeaderSet(headers, &encoded));
+  }
+  timer.Done();
+}
+
+TEST(HpackPerfTest, DecodeRequestHeaders) {
+  const SpdyHeaderBlock headers = MakeRequestHeaders();
+  HpackEncoder encoder(ObtainHpackHuffmanTable());
+  encoder.SetIndexingPolicy(NeverIndex);
+  SpdyString encoded;
+  ASSERT_TRUE(encoder.EncodeHeaderSet(headers, &encoded));
+
+  base::PerfTimeLogger timer("Hpack_decode_request_headers");
+  for (int i = 0; i < kIterations; ++i) {
+    HpackDecoderAdapter decoder;
+    EXPECT_TRUE(
+        decoder.HandleControlFrameHeadersData(encoded.data(), encoded.size()));
+    size_t compressed_len = 0;
+    EXPECT_TRUE(decoder.HandleControlFrameHeadersComplete(&compressed_len));
+    EXPECT_EQ(encoded.size(), compressed_len);
+  }
+  timer.Done();
+}
+
+// Decodes a response into a SpdyHeaderBlock, and reads all its values as a
+// consumer converting them to HttpResponseHeaders would.
+TEST(HpackPerfTest, DecodeResponseHeaders) {
+  const SpdyHeaderBlock headers = MakeResponseHeaders();
+  HpackEncoder encoder(ObtainHpackHuffmanTable());
+  encoder.SetIndexingPolicy(NeverIndex);
+  SpdyString encoded;
+  ASSERT_TRUE(encoder.EncodeHeaderSet(headers, &encoded));
+
+  base::PerfTimeLogger timer("Hpack_decode_response_headers");
+  for (int i = 0; i < kIterations; ++i) {
+    HpackDecoderAdapter decoder;
+    EXPECT_TRUE(
+        decoder.HandleControlFrameHeadersData(encoded.data(), encoded.size()));
+    EXPECT_TRUE(decoder.HandleControlFrameHeadersComplete(nullptr));
+    size_t total_size = 0;
+    for (const auto& header : decoder.decoded_block())
+      total_size += header.first.size() + header.second.size();
+    EXPECT_EQ(headers.TotalBytesUsed(), total_size);
+  }
+  timer.Done();
+}
+
+}  // namespace spdy
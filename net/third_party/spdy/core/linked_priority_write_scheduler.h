@@ -0,0 +1,336 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_THIRD_PARTY_SPDY_CORE_LINKED_PRIORITY_WRITE_SCHEDULER_H_
+#define NET_THIRD_PARTY_SPDY_CORE_LINKED_PRIORITY_WRITE_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "net/third_party/spdy/core/spdy_bug_tracker.h"
+#include "net/third_party/spdy/core/spdy_protocol.h"
+#include "net/third_party/spdy/core/write_scheduler.h"
+
+namespace spdy {
+
+namespace test {
+template <typename StreamIdType>
+class LinkedPriorityWriteSchedulerPeer;
+}
+
+// WriteScheduler implementation with the same SPDY priority scheme as
+// PriorityWriteScheduler, for connections with many concurrent streams.
+//
+// Each priority level keeps its ready streams in an intrusive doubly-linked
+// list threaded through their StreamInfo, so that marking a stream ready or
+// not ready, unregistering it or changing its priority doesn't scan the other
+// ready streams. A bitmap of the levels with ready streams lets
+// PopNextReadyStream() and ShouldYield() find the highest ready priority
+// without looking at the empty levels.
+template <typename StreamIdType>
+class LinkedPriorityWriteScheduler : public WriteScheduler<StreamIdType> {
+ public:
+  using typename WriteScheduler<StreamIdType>::StreamPrecedenceType;
+
+  // Creates scheduler with no streams.
+  LinkedPriorityWriteScheduler() = default;
+
+  void RegisterStream(StreamIdType stream_id,
+                      const StreamPrecedenceType& precedence) override {
+    SPDY_BUG_IF(!precedence.is_spdy3_priority()) << "Expected SPDY priority";
+
+    // parent_id not used here, but may as well validate it.  However,
+    // parent_id may legitimately not be registered yet--see b/15676312.
+    StreamIdType parent_id = precedence.parent_id();
+    DVLOG_IF(1, parent_id != kHttp2RootStreamId && !StreamRegistered(parent_id))
+        << "Parent stream " << parent_id << " not registered";
+
+    if (stream_id == kHttp2RootStreamId) {
+      SPDY_BUG << "Stream " << kHttp2RootStreamId << " already registered";
+      return;
+    }
+    StreamInfo stream_info;
+    stream_info.priority = precedence.spdy3_priority();
+    stream_info.stream_id = stream_id;
+    bool inserted =
+        stream_infos_.insert(std::make_pair(stream_id, stream_info)).second;
+    SPDY_BUG_IF(!inserted) << "Stream " << stream_id << " already registered";
+  }
+
+  void UnregisterStream(StreamIdType stream_id) override {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      SPDY_BUG << "Stream " << stream_id << " not registered";
+      return;
+    }
+    if (it->second.ready) {
+      Unlink(&it->second);
+    }
+    stream_infos_.erase(it);
+  }
+
+  bool StreamRegistered(StreamIdType stream_id) const override {
+    return stream_infos_.find(stream_id) != stream_infos_.end();
+  }
+
+  StreamPrecedenceType GetStreamPrecedence(
+      StreamIdType stream_id) const override {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      DVLOG(1) << "Stream " << stream_id << " not registered";
+      return StreamPrecedenceType(kV3LowestPriority);
+    }
+    return StreamPrecedenceType(it->second.priority);
+  }
+
+  void UpdateStreamPrecedence(StreamIdType stream_id,
+                              const StreamPrecedenceType& precedence) override {
+    SPDY_BUG_IF(!precedence.is_spdy3_priority()) << "Expected SPDY priority";
+
+    // parent_id not used here, but may as well validate it.  However,
+    // parent_id may legitimately not be registered yet--see b/15676312.
+    StreamIdType parent_id = precedence.parent_id();
+    DVLOG_IF(1, parent_id != kHttp2RootStreamId && !StreamRegistered(parent_id))
+        << "Parent stream " << parent_id << " not registered";
+
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      DVLOG(1) << "Stream " << stream_id << " not registered";
+      return;
+    }
+    StreamInfo& stream_info = it->second;
+    SpdyPriority new_priority = precedence.spdy3_priority();
+    if (stream_info.priority == new_priority) {
+      return;
+    }
+    if (stream_info.ready) {
+      Unlink(&stream_info);
+      stream_info.priority = new_priority;
+      LinkAtBack(&stream_info);
+    } else {
+      stream_info.priority = new_priority;
+    }
+  }
+
+  std::vector<StreamIdType> GetStreamChildren(
+      StreamIdType stream_id) const override {
+    return std::vector<StreamIdType>();
+  }
+
+  void RecordStreamEventTime(StreamIdType stream_id,
+                             int64_t now_in_usec) override {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      SPDY_BUG << "Stream " << stream_id << " not registered";
+      return;
+    }
+    PriorityInfo& priority_info = priority_infos_[it->second.priority];
+    priority_info.last_event_time_usec =
+        std::max(priority_info.last_event_time_usec, now_in_usec);
+  }
+
+  int64_t GetLatestEventWithPrecedence(StreamIdType stream_id) const override {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      SPDY_BUG << "Stream " << stream_id << " not registered";
+      return 0;
+    }
+    int64_t last_event_time_usec = 0;
+    const StreamInfo& stream_info = it->second;
+    for (SpdyPriority p = kV3HighestPriority; p < stream_info.priority; ++p) {
+      last_event_time_usec = std::max(last_event_time_usec,
+                                      priority_infos_[p].last_event_time_usec);
+    }
+    return last_event_time_usec;
+  }
+
+  StreamIdType PopNextReadyStream() override {
+    return std::get<0>(PopNextReadyStreamAndPrecedence());
+  }
+
+  // Returns the next ready stream and its precedence.
+  std::tuple<StreamIdType, StreamPrecedenceType>
+  PopNextReadyStreamAndPrecedence() override {
+    if (ready_priorities_ == 0) {
+      SPDY_BUG << "No ready streams available";
+      return std::make_tuple(0, StreamPrecedenceType(kV3LowestPriority));
+    }
+    SpdyPriority p = base::bits::CountTrailingZeroBits(ready_priorities_);
+    StreamInfo* info = priority_infos_[p].head;
+    DCHECK(info);
+    DCHECK(stream_infos_.find(info->stream_id) != stream_infos_.end());
+    Unlink(info);
+    return std::make_tuple(info->stream_id,
+                           StreamPrecedenceType(info->priority));
+  }
+
+  bool ShouldYield(StreamIdType stream_id) const override {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      SPDY_BUG << "Stream " << stream_id << " not registered";
+      return false;
+    }
+
+    // If there's a higher priority stream, this stream should yield.
+    const StreamInfo& stream_info = it->second;
+    if (ready_priorities_ & ((1u << stream_info.priority) - 1)) {
+      return true;
+    }
+
+    // If this priority level is empty, or this stream is the next up, there's
+    // no need to yield.
+    const StreamInfo* head = priority_infos_[stream_info.priority].head;
+    return head != nullptr && head != &stream_info;
+  }
+
+  void MarkStreamReady(StreamIdType stream_id, bool add_to_front) override {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      SPDY_BUG << "Stream " << stream_id << " not registered";
+      return;
+    }
+    StreamInfo& stream_info = it->second;
+    if (stream_info.ready) {
+      return;
+    }
+    if (add_to_front) {
+      LinkAtFront(&stream_info);
+    } else {
+      LinkAtBack(&stream_info);
+    }
+  }
+
+  void MarkStreamNotReady(StreamIdType stream_id) override {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      SPDY_BUG << "Stream " << stream_id << " not registered";
+      return;
+    }
+    StreamInfo& stream_info = it->second;
+    if (!stream_info.ready) {
+      return;
+    }
+    Unlink(&stream_info);
+  }
+
+  // Returns true iff the number of ready streams is non-zero.
+  bool HasReadyStreams() const override { return num_ready_streams_ > 0; }
+
+  // Returns the number of ready streams.
+  size_t NumReadyStreams() const override { return num_ready_streams_; }
+
+  // Returns true if a stream is ready.
+  bool IsStreamReady(StreamIdType stream_id) const {
+    auto it = stream_infos_.find(stream_id);
+    if (it == stream_infos_.end()) {
+      DLOG(INFO) << "Stream " << stream_id << " not registered";
+      return false;
+    }
+    return it->second.ready;
+  }
+
+ private:
+  friend class test::LinkedPriorityWriteSchedulerPeer<StreamIdType>;
+
+  // State kept for all registered streams. All ready streams have ready = true
+  // and are linked into priority_infos_[priority]'s list through |prev| and
+  // |next|, which are null otherwise.
+  struct StreamInfo {
+    SpdyPriority priority = kV3LowestPriority;
+    StreamIdType stream_id = 0;
+    bool ready = false;
+    StreamInfo* prev = nullptr;
+    StreamInfo* next = nullptr;
+  };
+
+  // State kept for each priority level.
+  struct PriorityInfo {
+    // First and last streams ready to write, or null if there are none.
+    StreamInfo* head = nullptr;
+    StreamInfo* tail = nullptr;
+    // Time of latest write event for stream of this priority, in microseconds.
+    int64_t last_event_time_usec = 0;
+  };
+
+  // std::unordered_map never moves its elements, so that the list pointers
+  // remain valid while other streams are registered and unregistered.
+  typedef std::unordered_map<StreamIdType, StreamInfo> StreamInfoMap;
+
+  // Adds the not ready |info| to the front or back of its priority's list.
+  void LinkAtFront(StreamInfo* info) {
+    DCHECK(!info->ready);
+    PriorityInfo& priority_info = priority_infos_[info->priority];
+    info->next = priority_info.head;
+    if (priority_info.head) {
+      priority_info.head->prev = info;
+    } else {
+      priority_info.tail = info;
+    }
+    priority_info.head = info;
+    MarkLinked(info);
+  }
+
+  void LinkAtBack(StreamInfo* info) {
+    DCHECK(!info->ready);
+    PriorityInfo& priority_info = priority_infos_[info->priority];
+    info->prev = priority_info.tail;
+    if (priority_info.tail) {
+      priority_info.tail->next = info;
+    } else {
+      priority_info.head = info;
+    }
+    priority_info.tail = info;
+    MarkLinked(info);
+  }
+
+  void MarkLinked(StreamInfo* info) {
+    info->ready = true;
+    ready_priorities_ |= 1u << info->priority;
+    ++num_ready_streams_;
+  }
+
+  // Removes the ready |info| from its priority's list, and marks it not ready.
+  void Unlink(StreamInfo* info) {
+    DCHECK(info->ready);
+    PriorityInfo& priority_info = priority_infos_[info->priority];
+    if (info->prev) {
+      info->prev->next = info->next;
+    } else {
+      priority_info.head = info->next;
+    }
+    if (info->next) {
+      info->next->prev = info->prev;
+    } else {
+      priority_info.tail = info->prev;
+    }
+    info->prev = nullptr;
+    info->next = nullptr;
+    info->ready = false;
+    if (!priority_info.head) {
+      ready_priorities_ &= ~(1u << info->priority);
+    }
+    --num_ready_streams_;
+  }
+
+  // Number of ready streams.
+  size_t num_ready_streams_ = 0;
+  // Bit p is set iff priority p has ready streams.
+  uint32_t ready_priorities_ = 0;
+  // Per-priority state, including ready lists.
+  PriorityInfo priority_infos_[kV3LowestPriority + 1];
+  // StreamInfos for all registered streams.
+  StreamInfoMap stream_infos_;
+};
+
+}  // namespace spdy
+
+#endif  // NET_THIRD_PARTY_SPDY_CORE_LINKED_PRIORITY_WRITE_SCHEDULER_H_
@@ -0,0 +1,248 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/third_party/spdy/core/linked_priority_write_scheduler.h"
+
+#include "net/test/gtest_util.h"
+#include "net/third_party/spdy/core/priority_write_scheduler.h"
+#include "net/third_party/spdy/core/spdy_protocol.h"
+#include "net/third_party/spdy/core/spdy_test_utils.h"
+
+namespace spdy {
+namespace test {
+
+template <typename StreamIdType>
+class LinkedPriorityWriteSchedulerPeer {
+ public:
+  using StreamInfo =
+      typename LinkedPriorityWriteScheduler<StreamIdType>::StreamInfo;
+
+  explicit LinkedPriorityWriteSchedulerPeer(
+      LinkedPriorityWriteScheduler<StreamIdType>* scheduler)
+      : scheduler_(scheduler) {}
+
+  // Walks the ready list of |priority|, checking its links on the way.
+  size_t NumReadyStreams(SpdyPriority priority) const {
+    const auto& priority_info = scheduler_->priority_infos_[priority];
+    size_t num_ready_streams = 0;
+    const StreamInfo* prev = nullptr;
+    for (const StreamInfo* info = priority_info.head; info; info = info->next) {
+      EXPECT_EQ(prev, info->prev);
+      EXPECT_TRUE(info->ready);
+      EXPECT_EQ(priority, info->priority);
+      prev = info;
+      ++num_ready_streams;
+    }
+    EXPECT_EQ(prev, priority_info.tail);
+    EXPECT_EQ(num_ready_streams > 0,
+              (scheduler_->ready_priorities_ & (1u << priority)) != 0);
+    return num_ready_streams;
+  }
+
+ private:
+  LinkedPriorityWriteScheduler<StreamIdType>* scheduler_;
+};
+
+namespace {
+
+class LinkedPriorityWriteSchedulerTest : public ::testing::Test {
+ public:
+  LinkedPriorityWriteSchedulerTest() : peer_(&scheduler_) {}
+
+  LinkedPriorityWriteScheduler<SpdyStreamId> scheduler_;
+  LinkedPriorityWriteSchedulerPeer<SpdyStreamId> peer_;
+};
+
+TEST_F(LinkedPriorityWriteSchedulerTest, RegisterUnregisterStreams) {
+  EXPECT_FALSE(scheduler_.HasReadyStreams());
+  EXPECT_FALSE(scheduler_.StreamRegistered(1));
+  scheduler_.RegisterStream(1, SpdyStreamPrecedence(1));
+  EXPECT_TRUE(scheduler_.StreamRegistered(1));
+
+  // Root stream counts as already registered.
+  EXPECT_SPDY_BUG(
+      scheduler_.RegisterStream(kHttp2RootStreamId, SpdyStreamPrecedence(1)),
+      "Stream 0 already registered");
+  EXPECT_SPDY_BUG(scheduler_.RegisterStream(1, SpdyStreamPrecedence(2)),
+                  "Stream 1 already registered");
+  EXPECT_EQ(1, scheduler_.GetStreamPrecedence(1).spdy3_priority());
+
+  scheduler_.UnregisterStream(1);
+  EXPECT_FALSE(scheduler_.StreamRegistered(1));
+  EXPECT_SPDY_BUG(scheduler_.UnregisterStream(1), "Stream 1 not registered");
+}
+
+TEST_F(LinkedPriorityWriteSchedulerTest, MarkStreamReadyBackAndFront) {
+  scheduler_.RegisterStream(1, SpdyStreamPrecedence(4));
+  scheduler_.RegisterStream(2, SpdyStreamPrecedence(3));
+  scheduler_.RegisterStream(3, SpdyStreamPrecedence(3));
+  scheduler_.RegisterStream(4, SpdyStreamPrecedence(3));
+  scheduler_.RegisterStream(5, SpdyStreamPrecedence(4));
+  scheduler_.RegisterStream(6, SpdyStreamPrecedence(1));
+
+  // Expected order: (P1) 6, (P3) 4, 2, 3, (P4) 1, 5
+  scheduler_.MarkStreamReady(1, true);
+  scheduler_.MarkStreamReady(2, true);
+  scheduler_.MarkStreamReady(3, false);
+  scheduler_.MarkStreamReady(4, true);
+  scheduler_.MarkStreamReady(5, false);
+  scheduler_.MarkStreamReady(6, true);
+  // Redundant marking has no effect.
+  scheduler_.MarkStreamReady(2, false);
+  EXPECT_EQ(6u, scheduler_.NumReadyStreams());
+  EXPECT_EQ(1u, peer_.NumReadyStreams(1));
+  EXPECT_EQ(3u, peer_.NumReadyStreams(3));
+  EXPECT_EQ(2u, peer_.NumReadyStreams(4));
+
+  EXPECT_EQ(6u, scheduler_.PopNextReadyStream());
+  EXPECT_EQ(4u, scheduler_.PopNextReadyStream());
+  EXPECT_EQ(2u, scheduler_.PopNextReadyStream());
+  EXPECT_EQ(3u, scheduler_.PopNextReadyStream());
+  EXPECT_EQ(std::make_tuple(1u, SpdyStreamPrecedence(4)),
+            scheduler_.PopNextReadyStreamAndPrecedence());
+  EXPECT_EQ(5u, scheduler_.PopNextReadyStream());
+  EXPECT_FALSE(scheduler_.HasReadyStreams());
+  for (SpdyPriority p = kV3HighestPriority; p <= kV3LowestPriority; ++p) {
+    EXPECT_EQ(0u, peer_.NumReadyStreams(p));
+  }
+  EXPECT_SPDY_BUG(EXPECT_EQ(0u, scheduler_.PopNextReadyStream()),
+                  "No ready streams available");
+}
+
+TEST_F(LinkedPriorityWriteSchedulerTest, MarkStreamNotReady) {
+  // Take streams out of the head, middle and tail of a list.
+  for (SpdyStreamId id = 1; id <= 5; ++id) {
+    scheduler_.RegisterStream(id, SpdyStreamPrecedence(2));
+    scheduler_.MarkStreamReady(id, false);
+  }
+  scheduler_.MarkStreamNotReady(3);
+  scheduler_.MarkStreamNotReady(1);
+  scheduler_.MarkStreamNotReady(5);
+  EXPECT_EQ(2u, scheduler_.NumReadyStreams());
+  EXPECT_EQ(2u, peer_.NumReadyStreams(2));
+  EXPECT_FALSE(scheduler_.IsStreamReady(3));
+
+  // Tolerate redundant marking of a stream as not ready.
+  scheduler_.MarkStreamNotReady(3);
+  EXPECT_EQ(2u, scheduler_.NumReadyStreams());
+  EXPECT_SPDY_BUG(scheduler_.MarkStreamNotReady(7), "Stream 7 not registered");
+
+  EXPECT_EQ(2u, scheduler_.PopNextReadyStream());
+  EXPECT_EQ(4u, scheduler_.PopNextReadyStream());
+  EXPECT_FALSE(scheduler_.HasReadyStreams());
+}
+
+TEST_F(LinkedPriorityWriteSchedulerTest, UpdateStreamPrecedence) {
+  scheduler_.RegisterStream(3, SpdyStreamPrecedence(2));
+  scheduler_.RegisterStream(4, SpdyStreamPrecedence(1));
+  scheduler_.MarkStreamReady(3, false);
+  scheduler_.MarkStreamReady(4, false);
+
+  // Lowering the priority of ready stream 4 moves it behind stream 3.
+  scheduler_.UpdateStreamPrecedence(4, SpdyStreamPrecedence(3));
+  EXPECT_EQ(3, scheduler_.GetStreamPrecedence(4).spdy3_priority());
+  EXPECT_EQ(0u, peer_.NumReadyStreams(1));
+  EXPECT_EQ(1u, peer_.NumReadyStreams(3));
+  EXPECT_EQ(3u, scheduler_.PopNextReadyStream());
+  EXPECT_EQ(4u, scheduler_.PopNextReadyStream());
+
+  // Updating a stream which isn't ready doesn't make it ready.
+  scheduler_.UpdateStreamPrecedence(3, SpdyStreamPrecedence(5));
+  EXPECT_FALSE(scheduler_.IsStreamReady(3));
+  EXPECT_EQ(0u, scheduler_.NumReadyStreams());
+
+  // Unknown streams are tolerated, but have no effect.
+  scheduler_.UpdateStreamPrecedence(7, SpdyStreamPrecedence(1));
+  EXPECT_FALSE(scheduler_.StreamRegistered(7));
+}
+
+TEST_F(LinkedPriorityWriteSchedulerTest, UnregisterRemovesStream) {
+  scheduler_.RegisterStream(3, SpdyStreamPrecedence(4));
+  scheduler_.RegisterStream(5, SpdyStreamPrecedence(4));
+  scheduler_.MarkStreamReady(3, false);
+  scheduler_.MarkStreamReady(5, false);
+
+  scheduler_.UnregisterStream(3);
+  EXPECT_EQ(1u, scheduler_.NumReadyStreams());
+  EXPECT_EQ(1u, peer_.NumReadyStreams(4));
+  scheduler_.UnregisterStream(5);
+  EXPECT_EQ(0u, scheduler_.NumReadyStreams());
+  EXPECT_EQ(0u, peer_.NumReadyStreams(4));
+}
+
+TEST_F(LinkedPriorityWriteSchedulerTest, ShouldYield) {
+  scheduler_.RegisterStream(1, SpdyStreamPrecedence(1));
+  scheduler_.RegisterStream(4, SpdyStreamPrecedence(4));
+  scheduler_.RegisterStream(5, SpdyStreamPrecedence(4));
+  scheduler_.RegisterStream(7, SpdyStreamPrecedence(7));
+
+  // Make sure we don't yield when the list is empty.
+  EXPECT_FALSE(scheduler_.ShouldYield(1));
+
+  scheduler_.MarkStreamReady(4, false);
+  EXPECT_FALSE(scheduler_.ShouldYield(4));
+  EXPECT_TRUE(scheduler_.ShouldYield(7));
+  EXPECT_TRUE(scheduler_.ShouldYield(5));
+  EXPECT_FALSE(scheduler_.ShouldYield(1));
+
+  scheduler_.MarkStreamReady(5, false);
+  EXPECT_FALSE(scheduler_.ShouldYield(4));
+  EXPECT_TRUE(scheduler_.ShouldYield(5));
+
+  EXPECT_SPDY_BUG(EXPECT_FALSE(scheduler_.ShouldYield(2)),
+                  "Stream 2 not registered");
+}
+
+TEST_F(LinkedPriorityWriteSchedulerTest, GetLatestEventWithPrecedence) {
+  for (int i = 1; i < 5; ++i) {
+    scheduler_.RegisterStream(i, SpdyStreamPrecedence(i));
+  }
+  for (int i = 1; i < 5; ++i) {
+    scheduler_.RecordStreamEventTime(i, i * 100);
+  }
+  for (int i = 1; i < 5; ++i) {
+    EXPECT_EQ((i - 1) * 100, scheduler_.GetLatestEventWithPrecedence(i));
+  }
+}
+
+// Checks that a scripted sequence of operations leaves both schedulers with
+// the same ready streams, in the same order.
+TEST_F(LinkedPriorityWriteSchedulerTest, MatchesPriorityWriteScheduler) {
+  PriorityWriteScheduler<SpdyStreamId> reference;
+  const SpdyStreamId kNumStreams = 64;
+  for (SpdyStreamId id = 1; id <= kNumStreams; ++id) {
+    SpdyStreamPrecedence precedence(id % (kV3LowestPriority + 1));
+    scheduler_.RegisterStream(id, precedence);
+    reference.RegisterStream(id, precedence);
+  }
+  for (SpdyStreamId id = 1; id <= kNumStreams; ++id) {
+    scheduler_.MarkStreamReady(id, id % 3 == 0);
+    reference.MarkStreamReady(id, id % 3 == 0);
+  }
+  for (SpdyStreamId id = 1; id <= kNumStreams; id += 5) {
+    scheduler_.MarkStreamNotReady(id);
+    reference.MarkStreamNotReady(id);
+  }
+  for (SpdyStreamId id = 2; id <= kNumStreams; id += 7) {
+    SpdyStreamPrecedence precedence((id * 3) % (kV3LowestPriority + 1));
+    scheduler_.UpdateStreamPrecedence(id, precedence);
+    reference.UpdateStreamPrecedence(id, precedence);
+  }
+  for (SpdyStreamId id = 4; id <= kNumStreams; id += 9) {
+    scheduler_.UnregisterStream(id);
+    reference.UnregisterStream(id);
+  }
+
+  ASSERT_EQ(reference.NumReadyStreams(), scheduler_.NumReadyStreams());
+  while (reference.HasReadyStreams()) {
+    SpdyStreamId id = reference.PopNextReadyStream();
+    EXPECT_FALSE(scheduler_.ShouldYield(id));
+    EXPECT_EQ(id, scheduler_.PopNextReadyStream());
+  }
+  EXPECT_FALSE(scheduler_.HasReadyStreams());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace spdy
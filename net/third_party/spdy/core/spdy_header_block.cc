@@ -104,8 +104,7 @@ SpdyHeaderBlock::HeaderValue::HeaderValue(Storage* storage,
                                           SpdyStringPiece key,
                                           SpdyStringPiece initial_value)
     : storage_(storage),
-      fragments_({initial_value}),
-      pair_({key, {}}),
+      pair_({key, initial_value}),
       size_(initial_value.size()),
       separator_size_(SeparatorForKey(key).size()) {}
 
@@ -129,18 +128,18 @@ SpdyHeaderBlock::HeaderValue& SpdyHeaderBlock::HeaderValue::operator=(
 SpdyHeaderBlock::HeaderValue::~HeaderValue() = default;
 
 SpdyStringPiece SpdyHeaderBlock::HeaderValue::ConsolidatedValue() const {
-  if (fragments_.empty()) {
-    return SpdyStringPiece();
+  if (!fragments_.empty()) {
+    pair_.second =
+        storage_->WriteFragments(fragments_, SeparatorForKey(pair_.first));
+    fragments_.clear();
   }
-  if (fragments_.size() > 1) {
-    fragments_ = {
-        storage_->WriteFragments(fragments_, SeparatorForKey(pair_.first))};
-  }
-  return fragments_[0];
+  return pair_.second;
 }
 
 void SpdyHeaderBlock::HeaderValue::Append(SpdyStringPiece fragment) {
   size_ += (fragment.size() + separator_size_);
+  if (fragments_.empty())
+    fragments_.push_back(pair_.second);
   fragments_.push_back(fragment);
 }
 
@@ -42,7 +42,8 @@ class SPDY_EXPORT_PRIVATE SpdyHeaderBlock {
   class Storage;
 
   // Stores a list of value fragments that can be joined later with a
-  // key-dependent separator.
+  // key-dependent separator. Most headers have a single value, which is kept
+  // without allocating anything besides its copy in |storage|.
   class SPDY_EXPORT_PRIVATE HeaderValue {
    public:
     HeaderValue(Storage* storage,
@@ -75,6 +76,8 @@ class SPDY_EXPORT_PRIVATE SpdyHeaderBlock {
     SpdyStringPiece ConsolidatedValue() const;
 
     mutable Storage* storage_;
+    // Empty while the value has a single fragment, which is then held by
+    // |pair_|. Otherwise, all the fragments left to consolidate.
     mutable std::vector<SpdyStringPiece> fragments_;
     // The first element is the key; the second is the consolidated value.
     mutable std::pair<SpdyStringPiece, SpdyStringPiece> pair_;
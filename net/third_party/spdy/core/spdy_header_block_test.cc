@@ -179,6 +179,23 @@ TEST(SpdyHeaderBlockTest, AppendHeaders) {
   EXPECT_EQ("singleton", block["h4"]);
 }
 
+// This test verifies that values can still be appended to after having been
+// consolidated, and that single values are not copied again when read.
+TEST(SpdyHeaderBlockTest, AppendAfterConsolidation) {
+  SpdyHeaderBlock block;
+  block["foo"] = "foo";
+  SpdyStringPiece value = block.find("foo")->second;
+  EXPECT_EQ(value.data(), block.find("foo")->second.data());
+
+  block.AppendValueOrAddHeader("foo", "bar");
+  EXPECT_EQ(SpdyString("foo\0bar", 7), block["foo"]);
+  block.AppendValueOrAddHeader("foo", "baz");
+  EXPECT_EQ(SpdyString("foo\0bar\0baz", 11), block["foo"]);
+
+  SpdyHeaderBlock moved(std::move(block));
+  EXPECT_EQ(SpdyString("foo\0bar\0baz", 11), moved["foo"]);
+}
+
 TEST(JoinTest, JoinEmpty) {
   std::vector<SpdyStringPiece> empty;
   SpdyStringPiece separator = ", ";
@@ -20,6 +20,10 @@ namespace spdy {
 //     where (writable) higher-priority streams are always given precedence
 //     over lower-priority streams.
 //
+// LinkedPriorityWriteScheduler: implements the same scheduling as
+//     PriorityWriteScheduler, in constant time per operation regardless of
+//     the number of ready streams.
+//
 // Http2PriorityWriteScheduler: implements SPDY priority-based stream
 //     scheduling coupled with the HTTP/2 stream dependency model. This is only
 //     intended as a transitional step towards Http2WeightedWriteScheduler.
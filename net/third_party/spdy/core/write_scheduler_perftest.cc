@@ -0,0 +1,66 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/perf_time_logger.h"
+#include "net/third_party/spdy/core/linked_priority_write_scheduler.h"
+#include "net/third_party/spdy/core/priority_write_scheduler.h"
+#include "net/third_party/spdy/core/spdy_protocol.h"
+#include "net/third_party/spdy/core/write_scheduler.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace spdy {
+
+namespace {
+
+const int kIterations = 1000000;
+const SpdyStreamId kStreamCounts[] = {10, 100, 1000};
+
+// Keeps |num_streams| streams of mixed priorities ready, as a connection
+// multiplexing that many responses would: the next stream is written and
+// marked ready again, and every few writes a stream is blocked on flow control
+// and unblocked.
+void RunScheduler(const std::string& name,
+                  WriteScheduler<SpdyStreamId>* scheduler,
+                  SpdyStreamId num_streams) {
+  for (SpdyStreamId id = 1; id <= num_streams; ++id) {
+    scheduler->RegisterStream(
+        id, SpdyStreamPrecedence(id % (kV3LowestPriority + 1)));
+    scheduler->MarkStreamReady(id, false);
+  }
+
+  base::PerfTimeLogger timer(
+      (name + "_" + base::UintToString(num_streams) + "_streams").c_str());
+  for (int i = 0; i < kIterations; ++i) {
+    SpdyStreamId id = scheduler->PopNextReadyStream();
+    scheduler->MarkStreamReady(id, false);
+    if (i % 4 == 0) {
+      SpdyStreamId blocked_id = 1 + (i / 4) % num_streams;
+      scheduler->MarkStreamNotReady(blocked_id);
+      scheduler->MarkStreamReady(blocked_id, false);
+    }
+  }
+  timer.Done();
+  EXPECT_EQ(num_streams, scheduler->NumReadyStreams());
+}
+
+}  // namespace
+
+TEST(WriteSchedulerPerfTest, PriorityWriteScheduler) {
+  for (SpdyStreamId num_streams : kStreamCounts) {
+    PriorityWriteScheduler<SpdyStreamId> scheduler;
+    RunScheduler("PriorityWriteScheduler", &scheduler, num_streams);
+  }
+}
+
+TEST(WriteSchedulerPerfTest, LinkedPriorityWriteScheduler) {
+  for (SpdyStreamId num_streams : kStreamCounts) {
+    LinkedPriorityWriteScheduler<SpdyStreamId> scheduler;
+    RunScheduler("LinkedPriorityWriteScheduler", &scheduler, num_streams);
+  }
+}
+
+}  // namespace spdy
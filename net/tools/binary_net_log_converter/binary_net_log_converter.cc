@@ -0,0 +1,48 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <iostream>
+#include <string>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "net/log/binary_net_log_observer.h"
+
+namespace {
+
+// Print the command line help.
+void PrintHelp(const char* command_line_name) {
+  std::cout << command_line_name << " log_dir output_file" << std::endl
+            << std::endl;
+  std::cout << "Converts the log_dir written by a BinaryNetLogObserver into "
+            << "a JSON NetLog, which can be loaded into the NetLog viewer."
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  base::CommandLine::StringVector args = command_line.GetArgs();
+  if (args.size() != 2) {
+    PrintHelp(argv[0]);
+    return 1;
+  }
+
+  std::string json;
+  if (!net::ConvertBinaryNetLogToJson(base::FilePath(args[0]), &json)) {
+    std::cerr << "Failed reading the binary NetLog." << std::endl;
+    return 1;
+  }
+  if (base::WriteFile(base::FilePath(args[1]), json.data(), json.size()) !=
+      static_cast<int>(json.size())) {
+    std::cerr << "Failed writing the JSON NetLog." << std::endl;
+    return 1;
+  }
+  return 0;
+}
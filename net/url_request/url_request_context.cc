@@ -176,6 +176,9 @@ bool URLRequestContext::OnMemoryDump(
   if (cookie_store_) {
     cookie_store_->DumpMemoryStats(pmd, dump->absolute_name());
   }
+  if (transport_security_state_) {
+    transport_security_state_->DumpMemoryStats(pmd, dump->absolute_name());
+  }
   return true;
 }
 
@@ -192,7 +192,8 @@ class ContainerURLRequestContext final : public URLRequestContext {
 
 URLRequestContextBuilder::HttpCacheParams::HttpCacheParams()
     : type(IN_MEMORY),
-      max_size(0) {}
+      max_size(0),
+      max_hot_entries_size(HttpCache::kDefaultMaxHotEntriesSize) {}
 URLRequestContextBuilder::HttpCacheParams::~HttpCacheParams() = default;
 
 URLRequestContextBuilder::URLRequestContextBuilder()
@@ -597,9 +598,12 @@ std::unique_ptr<URLRequestContext> URLRequestContextBuilder::Build() {
           HttpCache::DefaultBackend::InMemory(http_cache_params_.max_size);
     }
 
-    http_transaction_factory.reset(
-        new HttpCache(std::move(http_transaction_factory),
-                      std::move(http_cache_backend), true));
+    auto http_cache =
+        std::make_unique<HttpCache>(std::move(http_transaction_factory),
+                                    std::move(http_cache_backend), true);
+    if (http_cache_params_.type != HttpCacheParams::IN_MEMORY)
+      http_cache->SetMaxHotEntriesSize(http_cache_params_.max_hot_entries_size);
+    http_transaction_factory = std::move(http_cache);
   }
   storage->set_http_transaction_factory(std::move(http_transaction_factory));
 
@@ -14,6 +14,7 @@
 #ifndef NET_URL_REQUEST_URL_REQUEST_CONTEXT_BUILDER_H_
 #define NET_URL_REQUEST_URL_REQUEST_CONTEXT_BUILDER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <map>
@@ -119,6 +120,11 @@ class NET_EXPORT URLRequestContextBuilder {
 
     // The cache path (when type is DISK).
     base::FilePath path;
+
+    // The max size in bytes of the small responses held in memory, so that
+    // hits on them don't go to the disk. Default is
+    // HttpCache::kDefaultMaxHotEntriesSize. Ignored when type is IN_MEMORY.
+    size_t max_hot_entries_size;
   };
 
   URLRequestContextBuilder();
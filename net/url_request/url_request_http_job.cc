@@ -28,6 +28,7 @@
 #include "build/buildflag.h"
 #include "net/base/host_port_pair.h"
 #include "net/base/load_flags.h"
+#include "net/base/load_timing_info.h"
 #include "net/base/net_errors.h"
 #include "net/base/network_delegate.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -44,6 +45,7 @@
 #include "net/filter/source_stream.h"
 #include "net/http/http_content_disposition.h"
 #include "net/http/http_network_session.h"
+#include "net/http/http_preconnect_predictor.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
 #include "net/http/http_response_info.h"
@@ -312,6 +314,15 @@ void LogCookieUMA(const net::CookieList& cookie_list,
   base::UmaHistogramCounts1000(histogram_name, age_in_days);
 }
 
+// Returns the HttpPreconnectPredictor of the HttpNetworkSession that |request|
+// goes through, if it has one.
+net::HttpPreconnectPredictor* GetPreconnectPredictor(
+    const net::URLRequest* request) {
+  net::HttpNetworkSession* session =
+      request->context()->http_transaction_factory()->GetSession();
+  return session ? session->preconnect_predictor() : nullptr;
+}
+
 }  // namespace
 
 namespace net {
@@ -429,6 +440,14 @@ void URLRequestHttpJob::Start() {
   request_info_.privacy_mode = enable_privacy_mode ?
       PRIVACY_MODE_ENABLED : PRIVACY_MODE_DISABLED;
 
+  // Preconnect to the origins that the previous main frame loads of this
+  // origin connected to, while the main frame request is being made.
+  if (request_info_.load_flags & LOAD_MAIN_FRAME_DEPRECATED) {
+    HttpPreconnectPredictor* predictor = GetPreconnectPredictor(request_);
+    if (predictor)
+      predictor->OnNavigationStarted(request_info_.url);
+  }
+
   // Strip Referer from request_info_.extra_headers to prevent, e.g., plugins
   // from overriding headers that are controlled using other means. Otherwise a
   // plugin could set a referrer although sending the referrer is inhibited.
@@ -994,6 +1013,15 @@ void URLRequestHttpJob::OnStartCompleted(int result) {
     if (transaction_ && transaction_->GetResponseInfo()) {
       SetProxyServer(transaction_->GetResponseInfo()->proxy_server);
     }
+
+    HttpPreconnectPredictor* predictor = GetPreconnectPredictor(request_);
+    if (predictor) {
+      LoadTimingInfo load_timing_info;
+      GetLoadTimingInfo(&load_timing_info);
+      predictor->OnRequestCompleted(request_->site_for_cookies(),
+                                    request_->url(), request_info_.privacy_mode,
+                                    load_timing_info);
+    }
     scoped_refptr<HttpResponseHeaders> headers = GetResponseHeaders();
 
     if (network_delegate()) {
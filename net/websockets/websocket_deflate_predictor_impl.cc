@@ -4,20 +4,47 @@
 
 #include "net/websockets/websocket_deflate_predictor_impl.h"
 
+#include "net/websockets/websocket_frame.h"
+
 namespace net {
 
 typedef WebSocketDeflatePredictor::Result Result;
 
+WebSocketDeflatePredictorImpl::WebSocketDeflatePredictorImpl()
+    : deflating_message_(false),
+      message_input_bytes_(0),
+      message_written_bytes_(0),
+      messages_to_skip_(0) {}
+
 Result WebSocketDeflatePredictorImpl::Predict(
     const std::vector<std::unique_ptr<WebSocketFrame>>& frames,
     size_t frame_index) {
+  // All frames of the previous message have been recorded by now.
+  if (deflating_message_ && message_input_bytes_ > 0 &&
+      message_written_bytes_ * 100 >=
+          message_input_bytes_ * kPoorCompressionPercent) {
+    messages_to_skip_ = kMessagesToSkipAfterPoorCompression;
+  }
+  message_input_bytes_ = 0;
+  message_written_bytes_ = 0;
+
+  if (messages_to_skip_ > 0) {
+    --messages_to_skip_;
+    deflating_message_ = false;
+    return DO_NOT_DEFLATE;
+  }
+  deflating_message_ = true;
   return DEFLATE;
 }
 
 void WebSocketDeflatePredictorImpl::RecordInputDataFrame(
-    const WebSocketFrame* frame) {}
+    const WebSocketFrame* frame) {
+  message_input_bytes_ += frame->header.payload_length;
+}
 
 void WebSocketDeflatePredictorImpl::RecordWrittenDataFrame(
-    const WebSocketFrame* frame) {}
+    const WebSocketFrame* frame) {
+  message_written_bytes_ += frame->header.payload_length;
+}
 
 }  // namespace net
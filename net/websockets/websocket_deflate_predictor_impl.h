@@ -6,6 +6,7 @@
 #define NET_WEBSOCKETS_WEBSOCKET_DEFLATE_PREDICTOR_IMPL_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <vector>
@@ -17,15 +18,34 @@ namespace net {
 
 struct WebSocketFrame;
 
+// Deflates every message unless compression is not paying off: after a
+// message that deflate barely shrank (e.g. already-compressed binary data),
+// the following messages are sent uncompressed, and compression is retried
+// after kMessagesToSkipAfterPoorCompression of them.
 class NET_EXPORT_PRIVATE WebSocketDeflatePredictorImpl
     : public WebSocketDeflatePredictor {
  public:
+  // A deflated message whose output is at least this percentage of its input
+  // is considered not worth compressing.
+  static const int kPoorCompressionPercent = 90;
+  static const int kMessagesToSkipAfterPoorCompression = 16;
+
+  WebSocketDeflatePredictorImpl();
   ~WebSocketDeflatePredictorImpl() override {}
 
   Result Predict(const std::vector<std::unique_ptr<WebSocketFrame>>& frames,
                  size_t frame_index) override;
   void RecordInputDataFrame(const WebSocketFrame* frame) override;
   void RecordWrittenDataFrame(const WebSocketFrame* frame) override;
+
+ private:
+  // True if the current message was predicted to be deflated.
+  bool deflating_message_;
+  // Payload bytes recorded for the current message.
+  uint64_t message_input_bytes_;
+  uint64_t message_written_bytes_;
+  // Number of upcoming messages to send without trying to deflate them.
+  int messages_to_skip_;
 };
 
 }  // namespace net
@@ -4,6 +4,8 @@
 
 #include "net/websockets/websocket_deflate_predictor_impl.h"
 
+#include <stdint.h>
+
 #include <vector>
 
 #include "net/websockets/websocket_frame.h"
@@ -25,6 +27,55 @@ TEST(WebSocketDeflatePredictorImpl, Predict) {
   EXPECT_EQ(WebSocketDeflatePredictor::DEFLATE, result);
 }
 
+// Records a single-frame message of |input_length| bytes that was written
+// as |written_length| bytes.
+void RecordMessage(WebSocketDeflatePredictorImpl* predictor,
+                   uint64_t input_length,
+                   uint64_t written_length) {
+  WebSocketFrame input(WebSocketFrameHeader::kOpCodeText);
+  input.header.payload_length = input_length;
+  predictor->RecordInputDataFrame(&input);
+  WebSocketFrame written(WebSocketFrameHeader::kOpCodeText);
+  written.header.payload_length = written_length;
+  predictor->RecordWrittenDataFrame(&written);
+}
+
+TEST(WebSocketDeflatePredictorImpl, KeepsDeflatingCompressibleMessages) {
+  WebSocketDeflatePredictorImpl predictor;
+  std::vector<std::unique_ptr<WebSocketFrame>> frames;
+  frames.push_back(
+      std::make_unique<WebSocketFrame>(WebSocketFrameHeader::kOpCodeText));
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(WebSocketDeflatePredictor::DEFLATE,
+              predictor.Predict(frames, 0));
+    RecordMessage(&predictor, 1000, 300);
+  }
+}
+
+TEST(WebSocketDeflatePredictorImpl, SkipsDeflateAfterPoorCompression) {
+  WebSocketDeflatePredictorImpl predictor;
+  std::vector<std::unique_ptr<WebSocketFrame>> frames;
+  frames.push_back(
+      std::make_unique<WebSocketFrame>(WebSocketFrameHeader::kOpCodeBinary));
+
+  EXPECT_EQ(WebSocketDeflatePredictor::DEFLATE, predictor.Predict(frames, 0));
+  RecordMessage(&predictor, 1000, 1005);
+
+  const int messages_to_skip =
+      WebSocketDeflatePredictorImpl::kMessagesToSkipAfterPoorCompression;
+  for (int i = 0; i < messages_to_skip; ++i) {
+    EXPECT_EQ(WebSocketDeflatePredictor::DO_NOT_DEFLATE,
+              predictor.Predict(frames, 0));
+    RecordMessage(&predictor, 1000, 1000);
+  }
+
+  // Compression is retried, and kept if it pays off again.
+  EXPECT_EQ(WebSocketDeflatePredictor::DEFLATE, predictor.Predict(frames, 0));
+  RecordMessage(&predictor, 1000, 200);
+  EXPECT_EQ(WebSocketDeflatePredictor::DEFLATE, predictor.Predict(frames, 0));
+}
+
 }  // namespace
 
 }  // namespace net
@@ -28,13 +28,19 @@ const uint64_t kMaxPayloadLengthWithoutExtendedLengthField = 125;
 const uint64_t kPayloadLengthWithTwoByteExtendedLengthField = 126;
 const uint64_t kPayloadLengthWithEightByteExtendedLengthField = 127;
 
+// The longest a frame header can be; a partial header carried over between
+// calls to Decode() is always shorter than this.
+const size_t kMaximumFrameHeaderSize =
+    net::WebSocketFrameHeader::kBaseHeaderSize +
+    net::WebSocketFrameHeader::kMaximumExtendedLengthSize +
+    net::WebSocketFrameHeader::kMaskingKeyLength;
+
 }  // namespace.
 
 namespace net {
 
 WebSocketFrameParser::WebSocketFrameParser()
-    : current_read_pos_(0),
-      frame_offset_(0),
+    : frame_offset_(0),
       websocket_error_(kWebSocketNormalClosure) {
   std::fill(masking_key_.key,
             masking_key_.key + WebSocketFrameHeader::kMaskingKeyLength,
@@ -52,13 +58,12 @@ bool WebSocketFrameParser::Decode(
   if (!length)
     return true;
 
-  // TODO(yutak): Remove copy.
-  buffer_.insert(buffer_.end(), data, data + length);
-
-  while (current_read_pos_ < buffer_.size()) {
+  const char* current = data;
+  const char* const end = data + length;
+  while (current < end) {
     bool first_chunk = false;
     if (!current_frame_header_.get()) {
-      DecodeFrameHeader();
+      DecodeFrameHeader(&current, end);
       if (websocket_error_ != kWebSocketNormalClosure)
         return false;
       // If frame header is incomplete, then carry over the remaining
@@ -69,44 +74,72 @@ bool WebSocketFrameParser::Decode(
     }
 
     std::unique_ptr<WebSocketFrameChunk> frame_chunk =
-        DecodeFramePayload(first_chunk);
+        DecodeFramePayload(first_chunk, &current, end);
     DCHECK(frame_chunk.get());
     frame_chunks->push_back(std::move(frame_chunk));
 
     if (current_frame_header_.get()) {
-      DCHECK(current_read_pos_ == buffer_.size());
+      DCHECK(current == end);
       break;
     }
   }
 
-  // Drain unnecessary data. TODO(yutak): Remove copy. (but how?)
-  buffer_.erase(buffer_.begin(), buffer_.begin() + current_read_pos_);
-  current_read_pos_ = 0;
-
   // Sanity check: the size of carried-over data should not exceed
   // the maximum possible length of a frame header.
-  static const size_t kMaximumFrameHeaderSize =
-      WebSocketFrameHeader::kBaseHeaderSize +
-      WebSocketFrameHeader::kMaximumExtendedLengthSize +
-      WebSocketFrameHeader::kMaskingKeyLength;
   DCHECK_LT(buffer_.size(), kMaximumFrameHeaderSize);
 
   return true;
 }
 
-void WebSocketFrameParser::DecodeFrameHeader() {
+void WebSocketFrameParser::DecodeFrameHeader(const char** data,
+                                             const char* end) {
+  DCHECK(!current_frame_header_.get());
+
+  if (buffer_.empty()) {
+    size_t header_size = ParseFrameHeader(*data, end - *data);
+    if (websocket_error_ != kWebSocketNormalClosure)
+      return;
+    if (!header_size) {
+      buffer_.assign(*data, end);
+      *data = end;
+      return;
+    }
+    *data += header_size;
+    return;
+  }
+
+  // The header was split across reads. Only copy as much of the new data as
+  // a header could possibly need; the payload is read from |*data| in place.
+  const size_t carried_over = buffer_.size();
+  const size_t top_up = std::min(kMaximumFrameHeaderSize - carried_over,
+                                 static_cast<size_t>(end - *data));
+  buffer_.insert(buffer_.end(), *data, *data + top_up);
+  size_t header_size = ParseFrameHeader(buffer_.data(), buffer_.size());
+  if (websocket_error_ != kWebSocketNormalClosure) {
+    buffer_.clear();
+    return;
+  }
+  if (!header_size) {
+    *data += top_up;
+    DCHECK(*data == end);
+    return;
+  }
+  DCHECK_GT(header_size, carried_over);
+  *data += header_size - carried_over;
+  buffer_.clear();
+}
+
+size_t WebSocketFrameParser::ParseFrameHeader(const char* data, size_t size) {
   typedef WebSocketFrameHeader::OpCode OpCode;
   static const int kMaskingKeyLength = WebSocketFrameHeader::kMaskingKeyLength;
 
-  DCHECK(!current_frame_header_.get());
-
-  const char* start = &buffer_.front() + current_read_pos_;
+  const char* start = data;
   const char* current = start;
-  const char* end = &buffer_.front() + buffer_.size();
+  const char* end = data + size;
 
   // Header needs 2 bytes at minimum.
   if (end - current < 2)
-    return;
+    return 0;
 
   uint8_t first_byte = *current++;
   uint8_t second_byte = *current++;
@@ -121,7 +154,7 @@ void WebSocketFrameParser::DecodeFrameHeader() {
   uint64_t payload_length = second_byte & kPayloadLengthMask;
   if (payload_length == kPayloadLengthWithTwoByteExtendedLengthField) {
     if (end - current < 2)
-      return;
+      return 0;
     uint16_t payload_length_16;
     base::ReadBigEndian(current, &payload_length_16);
     current += 2;
@@ -130,7 +163,7 @@ void WebSocketFrameParser::DecodeFrameHeader() {
       websocket_error_ = kWebSocketErrorProtocolError;
   } else if (payload_length == kPayloadLengthWithEightByteExtendedLengthField) {
     if (end - current < 8)
-      return;
+      return 0;
     base::ReadBigEndian(current, &payload_length);
     current += 8;
     if (payload_length <= UINT16_MAX ||
@@ -141,16 +174,14 @@ void WebSocketFrameParser::DecodeFrameHeader() {
     }
   }
   if (websocket_error_ != kWebSocketNormalClosure) {
-    buffer_.clear();
-    current_read_pos_ = 0;
     current_frame_header_.reset();
     frame_offset_ = 0;
-    return;
+    return 0;
   }
 
   if (masked) {
     if (end - current < kMaskingKeyLength)
-      return;
+      return 0;
     std::copy(current, current + kMaskingKeyLength, masking_key_.key);
     current += kMaskingKeyLength;
   } else {
@@ -164,16 +195,18 @@ void WebSocketFrameParser::DecodeFrameHeader() {
   current_frame_header_->reserved3 = reserved3;
   current_frame_header_->masked = masked;
   current_frame_header_->payload_length = payload_length;
-  current_read_pos_ += current - start;
   DCHECK_EQ(0u, frame_offset_);
+  return current - start;
 }
 
 std::unique_ptr<WebSocketFrameChunk> WebSocketFrameParser::DecodeFramePayload(
-    bool first_chunk) {
+    bool first_chunk,
+    const char** data,
+    const char* end) {
   // The cast here is safe because |payload_length| is already checked to be
   // less than std::numeric_limits<int>::max() when the header is parsed.
   int next_size = static_cast<int>(
-      std::min(static_cast<uint64_t>(buffer_.size() - current_read_pos_),
+      std::min(static_cast<uint64_t>(end - *data),
                current_frame_header_->payload_length - frame_offset_));
 
   auto frame_chunk = std::make_unique<WebSocketFrameChunk>();
@@ -185,7 +218,7 @@ std::unique_ptr<WebSocketFrameChunk> WebSocketFrameParser::DecodeFramePayload(
     frame_chunk->data =
         base::MakeRefCounted<IOBufferWithSize>(static_cast<int>(next_size));
     char* io_data = frame_chunk->data->data();
-    memcpy(io_data, &buffer_.front() + current_read_pos_, next_size);
+    memcpy(io_data, *data, next_size);
     if (current_frame_header_->masked) {
       // The masking function is its own inverse, so we use the same function to
       // unmask as to mask.
@@ -193,7 +226,7 @@ std::unique_ptr<WebSocketFrameChunk> WebSocketFrameParser::DecodeFramePayload(
           masking_key_, frame_offset_, io_data, next_size);
     }
 
-    current_read_pos_ += next_size;
+    *data += next_size;
     frame_offset_ += next_size;
   }
 
@@ -48,28 +48,34 @@ class NET_EXPORT WebSocketFrameParser {
   WebSocketError websocket_error() const { return websocket_error_; }
 
  private:
-  // Tries to decode a frame header from |current_read_pos_|.
-  // If successful, this function updates |current_read_pos_|,
-  // |current_frame_header_|, and |masking_key_| (if available).
-  // This function may set |failed_| to true if it observes a corrupt frame.
-  // If there is not enough data in the remaining buffer to parse a frame
-  // header, this function returns without doing anything.
-  void DecodeFrameHeader();
-
-  // Decodes frame payload and creates a WebSocketFrameChunk object.
-  // This function updates |current_read_pos_| and |frame_offset_| after
-  // parsing. This function returns a frame object even if no payload data is
-  // available at this moment, so the receiver could make use of frame header
-  // information. If the end of frame is reached, this function clears
-  // |current_frame_header_|, |frame_offset_| and |masking_key_|.
-  std::unique_ptr<WebSocketFrameChunk> DecodeFramePayload(bool first_chunk);
-
-  // Internal buffer to store the data to parse.
+  // Tries to decode a frame header from [|*data|, |end|), after any partial
+  // header carried over in |buffer_|. If successful, this function advances
+  // |*data| past the header and updates |current_frame_header_| and
+  // |masking_key_| (if available). This function may set |websocket_error_|
+  // if it observes a corrupt frame. If there is not enough data to parse a
+  // frame header, the remaining bytes are carried over in |buffer_| and
+  // |*data| is advanced to |end|.
+  void DecodeFrameHeader(const char** data, const char* end);
+
+  // Parses a frame header from the |size| bytes at |data|. Returns the length
+  // of the header, or 0 if it is incomplete or corrupt.
+  size_t ParseFrameHeader(const char* data, size_t size);
+
+  // Decodes frame payload from [|*data|, |end|) and creates a
+  // WebSocketFrameChunk object. This function advances |*data| and updates
+  // |frame_offset_| after parsing. This function returns a frame object even
+  // if no payload data is available at this moment, so the receiver could make
+  // use of frame header information. If the end of frame is reached, this
+  // function clears |current_frame_header_|, |frame_offset_| and
+  // |masking_key_|.
+  std::unique_ptr<WebSocketFrameChunk> DecodeFramePayload(bool first_chunk,
+                                                          const char** data,
+                                                          const char* end);
+
+  // A frame header split across calls to Decode(). Payload data is never
+  // buffered here; it is copied straight from the caller's data.
   std::vector<char> buffer_;
 
-  // Position in |buffer_| where the next round of parsing starts.
-  size_t current_read_pos_;
-
   // Frame header and masking key of the current frame.
   // |masking_key_| is filled with zeros if the current frame is not masked.
   std::unique_ptr<WebSocketFrameHeader> current_frame_header_;
@@ -191,11 +191,14 @@ bool MetafileSkia::FinishDocument() {
       break;
   }
 
-  for (const Page& page : data_->pages) {
+  for (Page& page : data_->pages) {
     cc::SkiaPaintCanvas canvas(
         doc->beginPage(page.size.width(), page.size.height()));
     canvas.drawPicture(page.content, custom_callback);
     doc->endPage();
+    // The page is serialized by endPage(), so its recording is no longer
+    // needed. Only the size is kept, for GetPageBounds().
+    page.content = nullptr;
   }
   doc->close();
 
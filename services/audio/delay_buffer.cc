@@ -13,7 +13,17 @@
 
 namespace audio {
 
-DelayBuffer::DelayBuffer(int history_size) : history_size_(history_size) {}
+namespace {
+
+// The maximum number of buses kept for reuse. Writes and reads normally
+// retire chunks at the same rate they are added, so only a few are needed.
+constexpr size_t kMaxSpareBuses = 4;
+
+}  // namespace
+
+DelayBuffer::DelayBuffer(int history_size) : history_size_(history_size) {
+  spare_buses_.reserve(kMaxSpareBuses);
+}
 
 DelayBuffer::~DelayBuffer() = default;
 
@@ -29,12 +39,12 @@ void DelayBuffer::Write(FrameTicks position,
       position + input_bus.frames() - history_size_;
   while (!chunks_.empty() &&
          chunks_.front().GetEndPosition() <= prune_position) {
-    chunks_.pop_front();
+    PopFrontChunk();
   }
 
   // Make a copy of the AudioBus for later consumption. Apply the volume setting
   // by scaling the audio signal during the copy.
-  auto copy = media::AudioBus::Create(input_bus.channels(), input_bus.frames());
+  auto copy = TakeSpareBus(input_bus.channels(), input_bus.frames());
   for (int ch = 0; ch < input_bus.channels(); ++ch) {
     media::vector_math::FMUL(input_bus.channel(ch), volume, input_bus.frames(),
                              copy->channel(ch));
@@ -51,7 +61,7 @@ void DelayBuffer::Read(FrameTicks from,
   // Remove all of the oldest chunks until the one in front contains the |from|
   // position (or is the first chunk after it).
   while (!chunks_.empty() && chunks_.front().GetEndPosition() <= from) {
-    chunks_.pop_front();
+    PopFrontChunk();
   }
 
   // Loop, transferring data from each InputChunk to the output AudioBus until
@@ -94,7 +104,7 @@ void DelayBuffer::Read(FrameTicks from,
       chunk.bus->CopyPartialFramesTo(source_offset, frames_to_copy_from_chunk,
                                      dest_offset, output_bus);
       frames_remaining -= frames_to_copy_from_chunk;
-      chunks_.pop_front();  // All frames from this chunk have been consumed.
+      PopFrontChunk();  // All frames from this chunk have been consumed.
     } else {
       chunk.bus->CopyPartialFramesTo(source_offset, frames_remaining,
                                      dest_offset, output_bus);
@@ -111,6 +121,26 @@ DelayBuffer::FrameTicks DelayBuffer::GetEndPosition() const {
   return chunks_.empty() ? 0 : chunks_.back().GetEndPosition();
 }
 
+void DelayBuffer::PopFrontChunk() {
+  // Drop the oldest spare first, so the spares follow the current bus size.
+  if (spare_buses_.size() == kMaxSpareBuses)
+    spare_buses_.erase(spare_buses_.begin());
+  spare_buses_.push_back(std::move(chunks_.front().bus));
+  chunks_.pop_front();
+}
+
+std::unique_ptr<media::AudioBus> DelayBuffer::TakeSpareBus(int channels,
+                                                           int frames) {
+  for (auto it = spare_buses_.begin(); it != spare_buses_.end(); ++it) {
+    if ((*it)->channels() == channels && (*it)->frames() == frames) {
+      std::unique_ptr<media::AudioBus> bus = std::move(*it);
+      spare_buses_.erase(it);
+      return bus;
+    }
+  }
+  return media::AudioBus::Create(channels, frames);
+}
+
 DelayBuffer::InputChunk::InputChunk(FrameTicks p,
                                     std::unique_ptr<media::AudioBus> b)
     : position(p), bus(std::move(b)) {}
@@ -6,6 +6,7 @@
 #define SERVICES_AUDIO_DELAY_BUFFER_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/containers/circular_deque.h"
 #include "base/macros.h"
@@ -93,6 +94,13 @@ class DelayBuffer {
     DISALLOW_COPY_AND_ASSIGN(InputChunk);
   };
 
+  // Removes the oldest chunk, keeping its AudioBus for reuse by Write().
+  void PopFrontChunk();
+
+  // Returns a bus from |spare_buses_| with the given layout, or a newly
+  // allocated one if there is none.
+  std::unique_ptr<media::AudioBus> TakeSpareBus(int channels, int frames);
+
   // The minimum number of un-read frames that must be kept.
   const int history_size_;
 
@@ -101,6 +109,11 @@ class DelayBuffer {
   // not overlap.
   base::circular_deque<InputChunk> chunks_;
 
+  // Buses of chunks that have been pruned or read. Write() is usually called
+  // on a real-time audio thread, so reusing these avoids a heap allocation
+  // for every recorded bus.
+  std::vector<std::unique_ptr<media::AudioBus>> spare_buses_;
+
   DISALLOW_COPY_AND_ASSIGN(DelayBuffer);
 };
 
@@ -163,5 +163,33 @@ TEST(DelayBufferTest, ReadsGapsInRecording) {
   EXPECT_BUS_VALUES_EQ(bus, 1, frames_per_bus - 1, 1.0);
 }
 
+TEST(DelayBufferTest, ReadsBackAudioAfterChunksAreReused) {
+  DelayBuffer buffer(kMaxFrames);
+
+  constexpr int frames_per_bus = kMaxFrames / 4;
+  const auto bus = media::AudioBus::Create(kChannels, frames_per_bus);
+
+  // Repeatedly record and then read back a whole buffer's worth, with a
+  // different signal each time, so later writes land in the storage of chunks
+  // that have already been consumed.
+  DelayBuffer::FrameTicks position = 0;
+  for (int round = 1; round <= 3; ++round) {
+    const float value = 0.25f * round;
+    std::fill(bus->channel(0), bus->channel(0) + frames_per_bus, value);
+    DelayBuffer::FrameTicks record_position = position;
+    for (int i = 0; i < 4; ++i) {
+      buffer.Write(record_position, *bus, 1.0);
+      record_position += frames_per_bus;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+      std::fill(bus->channel(0), bus->channel(0) + frames_per_bus, 0.0);
+      buffer.Read(position, frames_per_bus, bus.get());
+      position += frames_per_bus;
+      EXPECT_BUS_VALUES_EQ(bus, 0, frames_per_bus, value);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace audio
@@ -45,7 +45,7 @@ bool PreflightCache::CheckIfRequestCanSkipPreflight(
 
   // The cache entry is either stale or not sufficient. Remove the item from the
   // cache.
-  cache_per_origin->second.erase(url.spec());
+  cache_per_origin->second.erase(cache_entry);
   if (cache_per_origin->second.empty())
     cache_.erase(cache_per_origin);
 
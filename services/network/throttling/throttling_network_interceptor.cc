@@ -152,6 +152,14 @@ void ThrottlingNetworkInterceptor::UpdateSuspended(base::TimeTicks now) {
 
 void ThrottlingNetworkInterceptor::CollectFinished(ThrottleRecords* records,
                                                    ThrottleRecords* finished) {
+  // Most timer ticks finish nothing; avoid rebuilding |records| for them.
+  if (std::none_of(records->begin(), records->end(),
+                   [](const ThrottleRecord& record) {
+                     return record.bytes < 0;
+                   })) {
+    return;
+  }
+
   ThrottleRecords active;
   for (const ThrottleRecord& record : *records) {
     if (record.bytes < 0)
@@ -254,12 +254,16 @@ static_assert(
     "Database::kDefaultPageSize must match the value configured into SQLite");
 
 constexpr int Database::kDefaultPageSize;
+constexpr int64_t Database::kWalSizeLimit;
+constexpr size_t Database::kMaxDynamicStatementCacheSize;
 
 Database::Database()
     : db_(nullptr),
       page_size_(kDefaultPageSize),
       cache_size_(0),
       exclusive_locking_(false),
+      wal_mode_(false),
+      dynamic_statement_cache_(kMaxDynamicStatementCacheSize),
       transaction_nesting_(0),
       needs_rollback_(false),
       in_memory_(false),
@@ -371,6 +375,7 @@ void Database::CloseInternal(bool forced) {
 
   // Release cached statements.
   statement_cache_.clear();
+  dynamic_statement_cache_.Clear();
 
   // With cached statements released, in-use statements will remain.
   // Closing the database while statements are in use is an API
@@ -982,6 +987,19 @@ void Database::TrimMemory(bool aggressively) {
     DLOG(WARNING) << "Could not restore cache size: " << GetErrorMessage();
 }
 
+bool Database::CheckpointDatabase() {
+  AssertIOAllowed();
+
+  if (!db_)
+    return false;
+  if (!wal_mode_)
+    return true;
+
+  int rc = sqlite3_wal_checkpoint_v2(db_, nullptr, SQLITE_CHECKPOINT_PASSIVE,
+                                     nullptr, nullptr);
+  return rc == SQLITE_OK;
+}
+
 // Create an in-memory database with the existing database's page
 // size, then backup that database over the existing database.
 bool Database::Raze() {
@@ -1403,6 +1421,23 @@ scoped_refptr<Database::StatementRef> Database::GetCachedStatement(
   return statement;
 }
 
+scoped_refptr<Database::StatementRef> Database::GetCachedDynamicStatement(
+    const char* sql) {
+  DCHECK(sql);
+  auto it = dynamic_statement_cache_.Get(sql);
+  if (it != dynamic_statement_cache_.end() && it->second->HasOneRef()) {
+    DCHECK(it->second->is_valid());
+    sqlite3_reset(it->second->stmt());
+    return it->second;
+  }
+
+  scoped_refptr<StatementRef> statement = GetUniqueStatement(sql);
+  // Only cache valid statements, and don't replace one that is in use.
+  if (statement->is_valid() && it == dynamic_statement_cache_.end())
+    dynamic_statement_cache_.Put(sql, statement);
+  return statement;
+}
+
 scoped_refptr<Database::StatementRef> Database::GetUniqueStatement(
     const char* sql) {
   return GetStatementImpl(this, sql);
@@ -1689,7 +1724,18 @@ bool Database::OpenInternal(const std::string& file_name,
   // TRUNCATE should be faster than DELETE because it won't need directory
   // changes for each transaction.  PERSIST may break the spirit of using
   // secure_delete.
-  ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
+  // WAL - append to -wal file, which is copied back by checkpoints.  Only
+  // checkpoints need to fsync with synchronous=NORMAL, which is still
+  // corruption-safe in WAL mode.
+  if (wal_mode_) {
+    ignore_result(Execute("PRAGMA journal_mode=WAL"));
+    ignore_result(Execute("PRAGMA synchronous=NORMAL"));
+    const std::string journal_size_limit_sql = base::StringPrintf(
+        "PRAGMA journal_size_limit=%" PRId64, kWalSizeLimit);
+    ignore_result(Execute(journal_size_limit_sql.c_str()));
+  } else {
+    ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
+  }
 
   const base::TimeDelta kBusyTimeout =
       base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
@@ -16,6 +16,7 @@
 #include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -113,6 +114,15 @@ class SQL_EXPORT Database {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to open the database in write-ahead log (WAL) mode instead of the
+  // default rollback journal. Commits append to the -wal file, and with
+  // synchronous=NORMAL only checkpoints fsync, which makes small frequent
+  // transactions much cheaper. The -wal file is truncated back to
+  // kWalSizeLimit after checkpoints, see CheckpointDatabase().
+  //
+  // This must be called before Open() to have an effect.
+  void set_wal_mode() { wal_mode_ = true; }
+
   // Call to use alternative status-tracking for mmap.  Usually this is tracked
   // in the meta table, but some databases have no meta table.
   // TODO(shess): Maybe just have all databases use the alt option?
@@ -257,6 +267,13 @@ class SQL_EXPORT Database {
   // usage by half.
   void TrimMemory(bool aggressively);
 
+  // Copies committed pages from the write-ahead log back into the database
+  // file without blocking readers or writers. SQLite already checkpoints
+  // when the log grows past ~1000 pages, but doing it from idle time keeps
+  // that work off of commits. Returns true if the database is not in WAL
+  // mode.
+  bool CheckpointDatabase();
+
   // Raze the database to the ground.  This approximates creating a
   // fresh database from scratch, within the constraints of SQLite's
   // locking protocol (locks and open handles can make doing this with
@@ -408,6 +425,15 @@ class SQL_EXPORT Database {
   // See GetCachedStatement above for examples and error information.
   scoped_refptr<StatementRef> GetUniqueStatement(const char* sql);
 
+  // Returns a statement for SQL that is built at runtime, so it can't use a
+  // StatementID, but is still run repeatedly. Statements are cached by their
+  // text in an LRU cache of kMaxDynamicStatementCacheSize entries. A cached
+  // statement that is still held by another Statement is not shared; a
+  // fresh one is prepared instead.
+  //
+  // See GetCachedStatement above for examples and error information.
+  scoped_refptr<StatementRef> GetCachedDynamicStatement(const char* sql);
+
   // Info querying -------------------------------------------------------------
 
   // Returns true if the given structure exists.  Instead of test-then-create,
@@ -507,6 +533,14 @@ class SQL_EXPORT Database {
   // Guaranteed to match SQLITE_DEFAULT_PAGE_SIZE.
   static constexpr int kDefaultPageSize = 4096;
 
+  // Number of statements kept by GetCachedDynamicStatement().
+  static constexpr size_t kMaxDynamicStatementCacheSize = 32;
+
+  // Size the write-ahead log of a database opened with set_wal_mode() is
+  // truncated to after a checkpoint. Roughly matches the size at which SQLite
+  // checkpoints automatically with the default page size.
+  static constexpr int64_t kWalSizeLimit = 4 * 1024 * 1024;
+
   // Internal state accessed by other classes in //sql.
   sqlite3* db(InternalApiToken) const { return db_; }
   bool poisoned(InternalApiToken) const { return poisoned_; }
@@ -525,6 +559,7 @@ class SQL_EXPORT Database {
   friend class test::ScopedScalarFunction;
   friend class test::ScopedMockTimeSource;
 
+  FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, CachedDynamicStatement);
   FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, CachedStatement);
   FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, CollectDiagnosticInfo);
   FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, GetAppropriateMmapSize);
@@ -756,6 +791,7 @@ class SQL_EXPORT Database {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
 
   // Holds references to all cached statements so they remain active.
   //
@@ -764,6 +800,11 @@ class SQL_EXPORT Database {
   // throughout a process' lifetime.
   base::flat_map<StatementID, scoped_refptr<StatementRef>> statement_cache_;
 
+  // Statements returned by GetCachedDynamicStatement(), keyed by their SQL.
+  // Unlike |statement_cache_|, the set of keys is unbounded, so this is LRU.
+  base::MRUCache<std::string, scoped_refptr<StatementRef>>
+      dynamic_statement_cache_;
+
   // A list of all StatementRefs we've given out. Each ref must register with
   // us when it's created or destroyed. This allows us to potentially close
   // any open statements when we encounter an error.
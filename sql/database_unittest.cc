@@ -282,6 +282,42 @@ TEST_F(SQLDatabaseTest, CachedStatement) {
   }
 }
 
+TEST_F(SQLDatabaseTest, CachedDynamicStatement) {
+  const std::string kSql = std::string("SELECT b FROM foo WHERE a = ") + "?";
+
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo(a, b) VALUES (12, 13)"));
+
+  sqlite3_stmt* raw_statement;
+  {
+    scoped_refptr<sql::Database::StatementRef> ref =
+        db().GetCachedDynamicStatement(kSql.c_str());
+    raw_statement = ref->stmt();
+
+    sql::Statement statement(std::move(ref));
+    statement.BindInt(0, 12);
+    ASSERT_TRUE(statement.Step());
+    EXPECT_EQ(13, statement.ColumnInt(0));
+  }
+
+  {
+    scoped_refptr<sql::Database::StatementRef> ref =
+        db().GetCachedDynamicStatement(kSql.c_str());
+    EXPECT_EQ(raw_statement, ref->stmt()) << "statement was not cached";
+
+    sql::Statement statement(std::move(ref));
+    statement.BindInt(0, 12);
+    ASSERT_TRUE(statement.Step()) << "cached statement was not reset";
+    EXPECT_EQ(13, statement.ColumnInt(0));
+
+    // The cached statement is in use, so it must not be handed out again.
+    scoped_refptr<sql::Database::StatementRef> other_ref =
+        db().GetCachedDynamicStatement(kSql.c_str());
+    ASSERT_TRUE(other_ref->is_valid());
+    EXPECT_NE(raw_statement, other_ref->stmt());
+  }
+}
+
 TEST_F(SQLDatabaseTest, IsSQLValidTest) {
   ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
   ASSERT_TRUE(db().IsSQLValid("SELECT a FROM foo"));
@@ -884,6 +920,48 @@ TEST_F(SQLDatabaseTest, DeleteNonWal) {
   EXPECT_FALSE(GetPathExists(journal_path));
 }
 
+TEST_F(SQLDatabaseTest, WalMode) {
+  db().Close();
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  EXPECT_EQ("wal", ExecuteWithResult(&db(), "PRAGMA journal_mode"));
+  EXPECT_EQ("1", ExecuteWithResult(&db(), "PRAGMA synchronous"));
+  EXPECT_EQ(base::NumberToString(Database::kWalSizeLimit),
+            ExecuteWithResult(&db(), "PRAGMA journal_size_limit"));
+
+  ASSERT_TRUE(db().Execute("CREATE TABLE x (x)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO x VALUES (1)"));
+  EXPECT_TRUE(GetPathExists(Database::WriteAheadLogPath(db_path())));
+  EXPECT_TRUE(db().CheckpointDatabase());
+  EXPECT_EQ("1", ExecuteWithResult(&db(), "SELECT COUNT(*) FROM x"));
+}
+
+// Table scans are served by the VFS read-ahead buffer.  Changes made through
+// another connection must still be seen afterwards.
+TEST_F(SQLDatabaseTest, SequentialScanSeesOtherConnectionWrites) {
+  ASSERT_TRUE(db().Execute("PRAGMA cache_size=16"));
+  ASSERT_TRUE(db().Execute("CREATE TABLE x (id INTEGER PRIMARY KEY, v, pad)"));
+  ASSERT_TRUE(db().BeginTransaction());
+  for (int i = 0; i < 1000; ++i) {
+    Statement s(db().GetCachedStatement(
+        SQL_FROM_HERE, "INSERT INTO x (id, v, pad) VALUES (?, 1, ?)"));
+    s.BindInt(0, i);
+    s.BindString(1, std::string(500, 'x'));
+    ASSERT_TRUE(s.Run());
+  }
+  ASSERT_TRUE(db().CommitTransaction());
+
+  const char kSumSql[] = "SELECT SUM(v) FROM x";
+  EXPECT_EQ("1000", ExecuteWithResult(&db(), kSumSql));
+
+  Database other_db;
+  ASSERT_TRUE(other_db.Open(db_path()));
+  ASSERT_TRUE(other_db.Execute("UPDATE x SET v = 2"));
+  other_db.Close();
+
+  EXPECT_EQ("2000", ExecuteWithResult(&db(), kSumSql));
+}
+
 #if defined(OS_POSIX)  // This test operates on POSIX file permissions.
 TEST_F(SQLDatabaseTest, PosixFilePermissions) {
   db().Close();
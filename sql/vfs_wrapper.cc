@@ -10,6 +10,7 @@
 
 #include "base/debug/leak_annotations.h"
 #include "base/logging.h"
+#include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_piece.h"
@@ -39,12 +40,83 @@ sqlite3_vfs* GetWrappedVfs(sqlite3_vfs* wrapped_vfs) {
   return static_cast<sqlite3_vfs*>(wrapped_vfs->pAppData);
 }
 
+// Size of a single read-ahead read, and the number of back-to-back reads that
+// need to be seen before read-ahead kicks in.
+constexpr int kReadAheadSize = 64 * 1024;
+constexpr int kSequentialReadsBeforeReadAhead = 4;
+
+// Serves sequential page reads of a main database file from one larger read
+// of the wrapped file.  Table scans otherwise issue a read per page, which is
+// slow on storage with high per-request latency.
+//
+// The buffered data is only trusted while SQLite holds a lock on the file, so
+// it's dropped on Unlock(), as well as on any write or truncation through this
+// file.  In WAL mode other connections can change the database file under a
+// SHARED lock during checkpoints, so read-ahead is turned off once the file is
+// seen using shared memory.
+class ReadAheadBuffer {
+ public:
+  ReadAheadBuffer() = default;
+
+  // Copies [|offset|, |offset| + |amount|) into |buf| if it's buffered.
+  bool Read(void* buf, int amount, sqlite3_int64 offset) {
+    if (!enabled_ || valid_size_ == 0 || offset < buffer_offset_ ||
+        offset + amount > buffer_offset_ + valid_size_) {
+      return false;
+    }
+    memcpy(buf, buffer_.data() + (offset - buffer_offset_), amount);
+    next_offset_ = offset + amount;
+    return true;
+  }
+
+  // Records a read which wasn't served from the buffer.  Returns true if the
+  // access pattern is sequential enough that the caller should refill the
+  // buffer at |offset|.
+  bool ShouldReadAhead(int amount, sqlite3_int64 offset) {
+    if (!enabled_ || amount >= kReadAheadSize)
+      return false;
+    sequential_reads_ = offset == next_offset_ ? sequential_reads_ + 1 : 0;
+    next_offset_ = offset + amount;
+    return sequential_reads_ >= kSequentialReadsBeforeReadAhead;
+  }
+
+  // Returns storage for a read-ahead at |offset|.  Contents are not valid
+  // until Filled() is called.
+  char* BufferForReadAhead(sqlite3_int64 offset) {
+    buffer_.resize(kReadAheadSize);
+    buffer_offset_ = offset;
+    valid_size_ = 0;
+    return buffer_.data();
+  }
+  void Filled() { valid_size_ = kReadAheadSize; }
+
+  void Invalidate() { valid_size_ = 0; }
+
+  void Disable() {
+    enabled_ = false;
+    std::vector<char>().swap(buffer_);
+    valid_size_ = 0;
+  }
+
+ private:
+  bool enabled_ = true;
+  int sequential_reads_ = 0;
+  sqlite3_int64 next_offset_ = -1;
+  std::vector<char> buffer_;
+  sqlite3_int64 buffer_offset_ = 0;
+  int valid_size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadAheadBuffer);
+};
+
 // NOTE(shess): This structure is allocated by SQLite using malloc.  Do not add
 // C++ objects, they will not be correctly constructed and destructed.  Instead,
 // manually manage a pointer to a C++ object in Open() and Close().
 struct VfsFile {
   const sqlite3_io_methods* methods;
   sqlite3_file* wrapped_file;
+  // Only set for main database files.
+  ReadAheadBuffer* read_ahead;
 };
 
 VfsFile* AsVfsFile(sqlite3_file* wrapper_file) {
@@ -61,25 +133,51 @@ int Close(sqlite3_file* sqlite_file)
 
   int r = file->wrapped_file->pMethods->xClose(file->wrapped_file);
   sqlite3_free(file->wrapped_file);
+  delete file->read_ahead;
   memset(file, '\0', sizeof(*file));
   return r;
 }
 
+void InvalidateReadAhead(sqlite3_file* sqlite_file) {
+  ReadAheadBuffer* read_ahead = AsVfsFile(sqlite_file)->read_ahead;
+  if (read_ahead)
+    read_ahead->Invalidate();
+}
+
 int Read(sqlite3_file* sqlite_file, void* buf, int amt, sqlite3_int64 ofs)
 {
   sqlite3_file* wrapped_file = GetWrappedFile(sqlite_file);
+  ReadAheadBuffer* read_ahead = AsVfsFile(sqlite_file)->read_ahead;
+  if (read_ahead) {
+    if (read_ahead->Read(buf, amt, ofs))
+      return SQLITE_OK;
+    if (read_ahead->ShouldReadAhead(amt, ofs)) {
+      int rc = wrapped_file->pMethods->xRead(
+          wrapped_file, read_ahead->BufferForReadAhead(ofs), kReadAheadSize,
+          ofs);
+      // A short read means the end of the file is near, which isn't worth
+      // special-casing.  Fall back to reading just what was asked for.
+      if (rc == SQLITE_OK) {
+        read_ahead->Filled();
+        if (read_ahead->Read(buf, amt, ofs))
+          return SQLITE_OK;
+      }
+    }
+  }
   return wrapped_file->pMethods->xRead(wrapped_file, buf, amt, ofs);
 }
 
 int Write(sqlite3_file* sqlite_file, const void* buf, int amt,
           sqlite3_int64 ofs)
 {
+  InvalidateReadAhead(sqlite_file);
   sqlite3_file* wrapped_file = GetWrappedFile(sqlite_file);
   return wrapped_file->pMethods->xWrite(wrapped_file, buf, amt, ofs);
 }
 
 int Truncate(sqlite3_file* sqlite_file, sqlite3_int64 size)
 {
+  InvalidateReadAhead(sqlite_file);
   sqlite3_file* wrapped_file = GetWrappedFile(sqlite_file);
   return wrapped_file->pMethods->xTruncate(wrapped_file, size);
 }
@@ -104,6 +202,7 @@ int Lock(sqlite3_file* sqlite_file, int file_lock)
 
 int Unlock(sqlite3_file* sqlite_file, int file_lock)
 {
+  InvalidateReadAhead(sqlite_file);
   sqlite3_file* wrapped_file = GetWrappedFile(sqlite_file);
   return wrapped_file->pMethods->xUnlock(wrapped_file, file_lock);
 }
@@ -134,6 +233,9 @@ int DeviceCharacteristics(sqlite3_file* sqlite_file)
 
 int ShmMap(sqlite3_file *sqlite_file, int region, int size,
            int extend, void volatile **pp) {
+  ReadAheadBuffer* read_ahead = AsVfsFile(sqlite_file)->read_ahead;
+  if (read_ahead)
+    read_ahead->Disable();
   sqlite3_file* wrapped_file = GetWrappedFile(sqlite_file);
   return wrapped_file->pMethods->xShmMap(
       wrapped_file, region, size, extend, pp);
@@ -236,6 +338,9 @@ int Open(sqlite3_vfs* vfs, const char* file_name, sqlite3_file* wrapper_file,
   // locking, which returns VFS version 1 files.
   VfsFile* file = AsVfsFile(wrapper_file);
   file->wrapped_file = wrapped_file;
+  file->read_ahead = (desired_flags & SQLITE_OPEN_MAIN_DB)
+                         ? new ReadAheadBuffer
+                         : nullptr;
   if (wrapped_file->pMethods->iVersion == 1) {
     static const sqlite3_io_methods io_methods = {
       1,
@@ -708,10 +708,11 @@ void BlobMemoryController::NotifyMemoryItemsUsed(
         item->state() != ShareableBlobDataItem::POPULATED_WITH_QUOTA) {
       continue;
     }
-    // We don't want to re-add the item if we're currently paging it to disk.
+    // We don't want to re-add the item if we're currently paging it to disk,
+    // but the blob's other items still need their recency refreshed.
     if (items_paging_to_file_.find(item->item_id()) !=
         items_paging_to_file_.end()) {
-      return;
+      continue;
     }
     auto iterator = populated_memory_items_.Get(item->item_id());
     if (iterator == populated_memory_items_.end()) {
@@ -604,6 +604,91 @@ TEST_F(BlobMemoryControllerTest, MultipleFilesPaged) {
   EXPECT_EQ(0u, controller.disk_usage());
 }
 
+TEST_F(BlobMemoryControllerTest, ItemsUsedWhileOthersArePaging) {
+  const size_t kSize1 = kTestBlobStorageMaxFileSizeBytes;
+  char kData1[kSize1];
+  std::memset(kData1, 'e', kSize1);
+
+  const size_t kSize2 = kTestBlobStorageMaxFileSizeBytes;
+  char kData2[kSize2];
+  std::memset(kData2, 'f', kSize2);
+
+  const size_t kSize3 = kTestBlobStorageMaxBlobMemorySize - kSize2;
+
+  BlobMemoryController controller(temp_dir_.GetPath(), file_runner_);
+  SetTestMemoryLimits(&controller);
+  AssertEnoughDiskSpace();
+
+  BlobDataBuilder builder1("id");
+  BlobDataBuilder::FutureData future_data1 = builder1.AppendFutureData(kSize1);
+  BlobDataBuilder builder2("id2");
+  BlobDataBuilder::FutureData future_data2 = builder2.AppendFutureData(kSize2);
+
+  std::vector<scoped_refptr<ShareableBlobDataItem>> items1 =
+      CreateSharedDataItems(builder1);
+  std::vector<scoped_refptr<ShareableBlobDataItem>> items2 =
+      CreateSharedDataItems(builder2);
+
+  memory_quota_result_ = false;
+  controller.ReserveMemoryQuota(items1, GetMemoryRequestCallback());
+  EXPECT_TRUE(memory_quota_result_);
+  memory_quota_result_ = false;
+  controller.ReserveMemoryQuota(items2, GetMemoryRequestCallback());
+  EXPECT_TRUE(memory_quota_result_);
+
+  // Only the first item is reported as used, so it's the only one that can be
+  // paged to disk.
+  future_data1.Populate(base::make_span(kData1, kSize1));
+  items1[0]->set_state(ItemState::POPULATED_WITH_QUOTA);
+  future_data2.Populate(base::make_span(kData2, kSize2));
+  items2[0]->set_state(ItemState::POPULATED_WITH_QUOTA);
+  controller.NotifyMemoryItemsUsed(items1);
+  EXPECT_FALSE(file_runner_->HasPendingTask());
+
+  // Request more memory than we have, which pages the first item to disk.
+  BlobDataBuilder builder3("id3");
+  builder3.AppendFutureData(kSize3);
+  std::vector<scoped_refptr<ShareableBlobDataItem>> items3 =
+      CreateSharedDataItems(builder3);
+  memory_quota_result_ = false;
+  controller.ReserveMemoryQuota(items3, GetMemoryRequestCallback());
+  EXPECT_FALSE(memory_quota_result_);
+  EXPECT_TRUE(file_runner_->HasPendingTask());
+
+  // Using both items while the first is still being paged must still track the
+  // second one.
+  std::vector<scoped_refptr<ShareableBlobDataItem>> both_items = {items1[0],
+                                                                  items2[0]};
+  controller.NotifyMemoryItemsUsed(both_items);
+  both_items.clear();
+
+  // Once the first item is on disk the third request is granted, which leaves
+  // us over the paging limit, so the second item is paged too.
+  RunFileThreadTasks();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(memory_quota_result_);
+  EXPECT_EQ(ItemState::QUOTA_GRANTED, items3[0]->state());
+  EXPECT_EQ(BlobDataItem::Type::kFile, items1[0]->item()->type());
+  EXPECT_TRUE(file_runner_->HasPendingTask());
+
+  RunFileThreadTasks();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(BlobDataItem::Type::kFile, items2[0]->item()->type());
+  EXPECT_EQ(kSize3, controller.memory_usage());
+  EXPECT_EQ(kSize1 + kSize2, controller.disk_usage());
+
+  items1.clear();
+  items2.clear();
+  items3.clear();
+
+  EXPECT_EQ(0u, controller.memory_usage());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(file_runner_->HasPendingTask());
+  RunFileThreadTasks();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, controller.disk_usage());
+}
+
 TEST_F(BlobMemoryControllerTest, FullEviction) {
   BlobMemoryController controller(temp_dir_.GetPath(), file_runner_);
   SetTestMemoryLimits(&controller);
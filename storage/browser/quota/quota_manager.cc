@@ -28,6 +28,7 @@
 #include "base/task_runner_util.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/default_tick_clock.h"
 #include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "net/base/url_util.h"
@@ -48,6 +49,12 @@ const int64_t kMBytes = 1024 * 1024;
 const int kMinutesInMilliSeconds = 60 * 1000;
 const int64_t kReportHistogramInterval = 60 * 60 * 1000;  // 1 hour
 
+// How long a volume info query result is reused for. Every GetUsageAndQuota
+// call needs the disk capacity, and querying it hops to the DB sequence and
+// stats the profile volume, so bursts of quota queries share one result.
+constexpr base::TimeDelta kStorageCapacityCacheLifetime =
+    base::TimeDelta::FromSeconds(1);
+
 }  // namespace
 
 const int64_t QuotaManager::kNoLimit = INT64_MAX;
@@ -828,6 +835,7 @@ QuotaManager::QuotaManager(
       is_getting_eviction_origin_(false),
       special_storage_policy_(special_storage_policy),
       get_volume_info_fn_(&QuotaManager::GetVolumeInfo),
+      tick_clock_(base::DefaultTickClock::GetInstance()),
       storage_monitor_(new StorageMonitor(this)),
       weak_factory_(this) {
   DCHECK_EQ(settings_.refresh_interval, base::TimeDelta::Max());
@@ -1335,6 +1343,9 @@ void QuotaManager::DidOriginDataEvicted(blink::mojom::QuotaStatusCode status) {
   if (status != blink::mojom::QuotaStatusCode::kOk)
     origins_in_error_[eviction_context_.evicted_origin]++;
 
+  // Eviction frees disk space, so don't answer from a stale capacity.
+  storage_capacity_timestamp_ = base::TimeTicks();
+
   std::move(eviction_context_.evict_origin_data_callback).Run(status);
 }
 
@@ -1623,6 +1634,12 @@ void QuotaManager::DidGetSettings(base::TimeTicks start_ticks,
 }
 
 void QuotaManager::GetStorageCapacity(StorageCapacityCallback callback) {
+  if (!is_incognito_ && !storage_capacity_timestamp_.is_null() &&
+      tick_clock_->NowTicks() - storage_capacity_timestamp_ <
+          kStorageCapacityCacheLifetime) {
+    std::move(callback).Run(cached_total_space_, cached_available_space_);
+    return;
+  }
   if (!storage_capacity_callbacks_.Add(std::move(callback)))
     return;
   if (is_incognito_) {
@@ -1635,10 +1652,17 @@ void QuotaManager::GetStorageCapacity(StorageCapacityCallback callback) {
       db_runner_.get(), FROM_HERE,
       base::BindOnce(&QuotaManager::CallGetVolumeInfo, get_volume_info_fn_,
                      profile_path_),
-      base::BindOnce(&QuotaManager::DidGetStorageCapacity,
+      base::BindOnce(&QuotaManager::DidGetVolumeInfo,
                      weak_factory_.GetWeakPtr()));
 }
 
+void QuotaManager::DidGetVolumeInfo(
+    const std::tuple<int64_t, int64_t>& total_and_available) {
+  std::tie(cached_total_space_, cached_available_space_) = total_and_available;
+  storage_capacity_timestamp_ = tick_clock_->NowTicks();
+  DidGetStorageCapacity(total_and_available);
+}
+
 void QuotaManager::ContinueIncognitoGetStorageCapacity(
     const QuotaSettings& settings) {
   int64_t current_usage =
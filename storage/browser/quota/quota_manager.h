@@ -40,6 +40,7 @@ class FilePath;
 class SequencedTaskRunner;
 class SingleThreadTaskRunner;
 class TaskRunner;
+class TickClock;
 }
 
 namespace quota_internals {
@@ -413,6 +414,8 @@ class STORAGE_EXPORT QuotaManager
                       base::Optional<QuotaSettings> settings);
   void GetStorageCapacity(StorageCapacityCallback callback);
   void ContinueIncognitoGetStorageCapacity(const QuotaSettings& settings);
+  void DidGetVolumeInfo(
+      const std::tuple<int64_t, int64_t>& total_and_available);
   void DidGetStorageCapacity(
       const std::tuple<int64_t, int64_t>& total_and_available);
 
@@ -447,6 +450,11 @@ class STORAGE_EXPORT QuotaManager
   base::TimeTicks settings_timestamp_;
   QuotaSettingsCallbackQueue settings_callbacks_;
   StorageCapacityCallbackQueue storage_capacity_callbacks_;
+  // Last volume info result; reused while |storage_capacity_timestamp_| is
+  // recent. Never set in incognito mode.
+  int64_t cached_total_space_ = 0;
+  int64_t cached_available_space_ = 0;
+  base::TimeTicks storage_capacity_timestamp_;
 
   GetOriginCallback lru_origin_callback_;
   std::set<GURL> access_notified_origins_;
@@ -479,6 +487,9 @@ class STORAGE_EXPORT QuotaManager
   // values. The default value points to QuotaManager::GetVolumeInfo.
   GetVolumeInfoFn get_volume_info_fn_;
 
+  // Times the reuse of volume info results. Overwritten by QuotaManagerTest.
+  const base::TickClock* tick_clock_;
+
   std::unique_ptr<StorageMonitor> storage_monitor_;
 
   base::WeakPtrFactory<QuotaManager> weak_factory_;
@@ -23,6 +23,7 @@
 #include "base/sys_info.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_task_environment.h"
+#include "base/test/simple_test_tick_clock.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "storage/browser/quota/quota_database.h"
@@ -72,6 +73,14 @@ std::tuple<int64_t, int64_t> GetVolumeInfoForTests(
   return std::make_tuple(total, available);
 }
 
+int g_volume_info_call_count = 0;
+
+std::tuple<int64_t, int64_t> CountingGetVolumeInfoForTests(
+    const base::FilePath& path) {
+  ++g_volume_info_call_count;
+  return GetVolumeInfoForTests(path);
+}
+
 url::Origin ToOrigin(const std::string& url) {
   return url::Origin::Create(GURL(url));
 }
@@ -445,6 +454,12 @@ class QuotaManagerTest : public testing::Test {
   void set_quota_manager(QuotaManager* quota_manager) {
     quota_manager_ = quota_manager;
   }
+  void set_get_volume_info_fn(QuotaManager::GetVolumeInfoFn fn) {
+    quota_manager_->get_volume_info_fn_ = fn;
+  }
+  void set_tick_clock(const base::TickClock* tick_clock) {
+    quota_manager_->tick_clock_ = tick_clock;
+  }
 
   MockSpecialStoragePolicy* mock_special_storage_policy() const {
     return mock_special_storage_policy_.get();
@@ -1437,6 +1452,34 @@ TEST_F(QuotaManagerTest, GetStorageCapacity) {
   EXPECT_LE(0, available_space());
 }
 
+TEST_F(QuotaManagerTest, GetStorageCapacity_ReusesRecentVolumeInfo) {
+  g_volume_info_call_count = 0;
+  base::SimpleTestTickClock clock;
+  clock.SetNowTicks(base::TimeTicks::Now());
+  set_get_volume_info_fn(&CountingGetVolumeInfoForTests);
+  set_tick_clock(&clock);
+
+  GetStorageCapacity();
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, g_volume_info_call_count);
+  int64_t total = total_space();
+  int64_t available = available_space();
+
+  // A follow-up query answers from the cached volume info.
+  clock.Advance(base::TimeDelta::FromMilliseconds(500));
+  GetStorageCapacity();
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, g_volume_info_call_count);
+  EXPECT_EQ(total, total_space());
+  EXPECT_EQ(available, available_space());
+
+  // Once the cached volume info is a second old it is queried again.
+  clock.Advance(base::TimeDelta::FromMilliseconds(500));
+  GetStorageCapacity();
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_EQ(2, g_volume_info_call_count);
+}
+
 TEST_F(QuotaManagerTest, EvictOriginData) {
   static const MockOriginData kData1[] = {
     { "http://foo.com/",   kTemp,     1 },
@@ -307,9 +307,18 @@ void ScriptStreamer::SuppressStreaming(NotStreamingReason reason) {
 
 namespace {
 
+// Parser blocking scripts hold up the whole page, whereas the others only
+// need to be ready by the time they run.
+base::TaskPriority GetStreamingTaskPriority(ClassicPendingScript* script) {
+  return script->GetSchedulingType() == ScriptSchedulingType::kParserBlocking
+             ? base::TaskPriority::USER_BLOCKING
+             : base::TaskPriority::USER_VISIBLE;
+}
+
 void RunScriptStreamingTask(
     std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> task,
     ScriptStreamer* streamer) {
+  TRACE_EVENT_ASYNC_END0("v8", "v8.parseOnBackgroundWaiting", streamer);
   TRACE_EVENT1(
       "v8,devtools.timeline", "v8.parseOnBackground", "data",
       InspectorParseScriptEvent::Data(streamer->ScriptResourceIdentifier(),
@@ -424,22 +433,38 @@ void ScriptStreamer::NotifyAppendData(ScriptResource* resource) {
     }
 
     if (RuntimeEnabledFeatures::ScheduledScriptStreamingEnabled()) {
-      // Script streaming tasks are high priority, as they can block the parser,
-      // and they can (and probably will) block during their own execution as
-      // they wait for more input.
-      //
-      // Pass through the atomic cancellation token which is set to true by the
-      // task when it is started, or set to true by the streamer if it wants to
-      // cancel the task.
-      //
-      // TODO(leszeks): Decrease the priority of these tasks where possible.
-      BackgroundScheduler::PostOnBackgroundThreadWithTraits(
-          FROM_HERE, {base::TaskPriority::USER_BLOCKING, base::MayBlock()},
-          CrossThreadBind(RunBlockingScriptStreamingTask,
-                          WTF::Passed(std::move(script_streaming_task)),
-                          WrapCrossThreadPersistent(this),
-                          WTF::CrossThreadUnretained(
-                              &blocking_task_started_or_cancelled_)));
+      // Tracks the time between posting the task and the task starting on
+      // one of the background threads.
+      TRACE_EVENT_ASYNC_BEGIN1("v8", "v8.parseOnBackgroundWaiting", this,
+                               "url", script_url_string_.Utf8());
+      base::TaskPriority priority =
+          GetStreamingTaskPriority(pending_script_.Get());
+      if (resource->IsLoaded()) {
+        // The whole script is already buffered (e.g. it came from the HTTP
+        // cache), so there is no blocking task for NotifyFinished() to
+        // replace. The task may still wait for the data passed to |stream_|
+        // below, so it may block.
+        blocking_task_started_or_cancelled_.test_and_set();
+        BackgroundScheduler::PostOnBackgroundThreadWithTraits(
+            FROM_HERE, {priority, base::MayBlock()},
+            CrossThreadBind(RunNonBlockingScriptStreamingTask,
+                            WTF::Passed(std::move(script_streaming_task)),
+                            WrapCrossThreadPersistent(this)));
+      } else {
+        // Script streaming tasks can (and probably will) block during their
+        // own execution as they wait for more input.
+        //
+        // Pass through the atomic cancellation token which is set to true by
+        // the task when it is started, or set to true by the streamer if it
+        // wants to cancel the task.
+        BackgroundScheduler::PostOnBackgroundThreadWithTraits(
+            FROM_HERE, {priority, base::MayBlock()},
+            CrossThreadBind(RunBlockingScriptStreamingTask,
+                            WTF::Passed(std::move(script_streaming_task)),
+                            WrapCrossThreadPersistent(this),
+                            WTF::CrossThreadUnretained(
+                                &blocking_task_started_or_cancelled_)));
+      }
     } else {
       blocking_task_started_or_cancelled_.test_and_set();
       ScriptStreamerThread::Shared()->PostTask(
@@ -483,7 +508,7 @@ void ScriptStreamer::NotifyFinished() {
       // NotifyAppendData.
       CHECK(script_streaming_task);
       BackgroundScheduler::PostOnBackgroundThreadWithTraits(
-          FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+          FROM_HERE, {GetStreamingTaskPriority(pending_script_.Get())},
           CrossThreadBind(RunNonBlockingScriptStreamingTask,
                           WTF::Passed(std::move(script_streaming_task)),
                           WrapCrossThreadPersistent(this)));
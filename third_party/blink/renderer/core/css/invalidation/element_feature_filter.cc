@@ -0,0 +1,46 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/invalidation/element_feature_filter.h"
+
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/dom/space_split_string.h"
+
+namespace blink {
+
+void ElementFeatureFilter::AddElement(const Element& element) {
+  if (element.HasID())
+    AddId(element.IdForStyleResolution());
+  if (element.HasClass())
+    AddClasses(element.ClassNames());
+}
+
+void ElementFeatureFilter::RemoveElement(const Element& element) {
+  if (element.HasID())
+    RemoveId(element.IdForStyleResolution());
+  if (element.HasClass())
+    RemoveClasses(element.ClassNames());
+}
+
+void ElementFeatureFilter::AddClasses(const SpaceSplitString& class_names) {
+  for (size_t i = 0; i < class_names.size(); ++i)
+    filter_.Add(ClassHash(class_names[i]));
+}
+
+void ElementFeatureFilter::RemoveClasses(const SpaceSplitString& class_names) {
+  for (size_t i = 0; i < class_names.size(); ++i)
+    filter_.Remove(ClassHash(class_names[i]));
+}
+
+void ElementFeatureFilter::AddId(const AtomicString& id) {
+  if (!id.IsEmpty())
+    filter_.Add(IdHash(id));
+}
+
+void ElementFeatureFilter::RemoveId(const AtomicString& id) {
+  if (!id.IsEmpty())
+    filter_.Remove(IdHash(id));
+}
+
+}  // namespace blink
@@ -0,0 +1,70 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_CSS_INVALIDATION_ELEMENT_FEATURE_FILTER_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_CSS_INVALIDATION_ELEMENT_FEATURE_FILTER_H_
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/bloom_filter.h"
+#include "third_party/blink/renderer/platform/wtf/text/atomic_string.h"
+
+namespace blink {
+
+class Element;
+class SpaceSplitString;
+
+// A counting Bloom filter of the classes and ids of the connected elements of
+// a document. The StyleInvalidator uses it to skip walking subtrees for
+// descendant invalidation sets looking for classes and ids no element has.
+//
+// Elements are added when they are inserted into the document and removed
+// when they are removed from it, see Element::InsertedInto() and
+// Element::RemovedFrom(). While connected, every change of their class names
+// or id for style resolution has to be reported as well, so that the counts
+// stay balanced.
+class CORE_EXPORT ElementFeatureFilter {
+  DISALLOW_NEW();
+
+ public:
+  ElementFeatureFilter() = default;
+
+  void AddElement(const Element&);
+  void RemoveElement(const Element&);
+
+  void AddClasses(const SpaceSplitString&);
+  void RemoveClasses(const SpaceSplitString&);
+  // Empty ids are ignored.
+  void AddId(const AtomicString&);
+  void RemoveId(const AtomicString&);
+
+  // May give false positives, never false negatives.
+  bool MayContainClass(const AtomicString& class_name) const {
+    return filter_.MayContain(ClassHash(class_name));
+  }
+  bool MayContainId(const AtomicString& id) const {
+    return filter_.MayContain(IdHash(id));
+  }
+
+ private:
+  // As in the SelectorFilter, salt the hashes so that classes and ids with
+  // the same name don't collide.
+  enum { kIdSalt = 17, kClassSalt = 19 };
+  static unsigned ClassHash(const AtomicString& class_name) {
+    return class_name.Impl()->ExistingHash() * kClassSalt;
+  }
+  static unsigned IdHash(const AtomicString& id) {
+    return id.Impl()->ExistingHash() * kIdSalt;
+  }
+
+  // 4kB, the same size as the SelectorFilter's.
+  BloomFilter<12> filter_;
+
+  DISALLOW_COPY_AND_ASSIGN(ElementFeatureFilter);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_CSS_INVALIDATION_ELEMENT_FEATURE_FILTER_H_
@@ -33,6 +33,7 @@
 #include <memory>
 #include <utility>
 
+#include "third_party/blink/renderer/core/css/invalidation/element_feature_filter.h"
 #include "third_party/blink/renderer/core/css/resolver/style_resolver.h"
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/core/inspector/inspector_trace_events.h"
@@ -115,6 +116,32 @@ bool InvalidationSet::InvalidatesElement(Element& element) const {
   return false;
 }
 
+bool InvalidationSet::MayInvalidateElementsIn(
+    const ElementFeatureFilter& filter) const {
+  if (tag_names_ || attributes_ || invalidation_flags_.WholeSubtreeInvalid() ||
+      invalidation_flags_.InvalidateCustomPseudo() ||
+      invalidation_flags_.InsertionPointCrossing() ||
+      invalidation_flags_.InvalidatesSlotted() ||
+      invalidation_flags_.InvalidatesParts())
+    return true;
+
+  if (ids_) {
+    for (const auto& id : *ids_) {
+      if (filter.MayContainId(id))
+        return true;
+    }
+  }
+
+  if (classes_) {
+    for (const auto& class_name : *classes_) {
+      if (filter.MayContainClass(class_name))
+        return true;
+    }
+  }
+
+  return false;
+}
+
 bool InvalidationSet::InvalidatesTagName(Element& element) const {
   if (tag_names_ &&
       tag_names_->Contains(element.LocalNameForSelectorMatching())) {
@@ -47,6 +47,7 @@
 namespace blink {
 
 class Element;
+class ElementFeatureFilter;
 class TracedValue;
 
 enum InvalidationType { kInvalidateDescendants, kInvalidateSiblings };
@@ -110,6 +111,10 @@ class CORE_EXPORT InvalidationSet
   bool InvalidatesElement(Element&) const;
   bool InvalidatesTagName(Element&) const;
 
+  // Returns false if this set only invalidates elements with classes or ids
+  // which |filter| says no element has.
+  bool MayInvalidateElementsIn(const ElementFeatureFilter& filter) const;
+
   void AddClass(const AtomicString& class_name);
   void AddId(const AtomicString& id);
   void AddTagName(const AtomicString& tag_name);
@@ -5,6 +5,8 @@
 #include "third_party/blink/renderer/core/css/invalidation/invalidation_set.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/css/invalidation/element_feature_filter.h"
+#include "third_party/blink/renderer/core/dom/space_split_string.h"
 
 namespace blink {
 
@@ -81,6 +83,35 @@ TEST(InvalidationSetTest, SelfInvalidationSet_Combine) {
   EXPECT_TRUE(set->InvalidatesSelf());
 }
 
+TEST(InvalidationSetTest, MayInvalidateElementsIn) {
+  ElementFeatureFilter filter;
+  filter.AddClasses(SpaceSplitString("a b"));
+  filter.AddId("c");
+
+  scoped_refptr<InvalidationSet> set = DescendantInvalidationSet::Create();
+  set->AddClass("x");
+  set->AddId("a");
+  EXPECT_FALSE(set->MayInvalidateElementsIn(filter));
+
+  set->AddClass("b");
+  EXPECT_TRUE(set->MayInvalidateElementsIn(filter));
+  filter.RemoveClasses(SpaceSplitString("a b"));
+  EXPECT_FALSE(set->MayInvalidateElementsIn(filter));
+
+  set->AddId("c");
+  EXPECT_TRUE(set->MayInvalidateElementsIn(filter));
+  filter.RemoveId("c");
+  EXPECT_FALSE(set->MayInvalidateElementsIn(filter));
+
+  // Sets matching anything other than classes and ids are always kept.
+  set->AddTagName("x");
+  EXPECT_TRUE(set->MayInvalidateElementsIn(filter));
+
+  scoped_refptr<InvalidationSet> part_set = DescendantInvalidationSet::Create();
+  part_set->SetInvalidatesParts();
+  EXPECT_TRUE(part_set->MayInvalidateElementsIn(filter));
+}
+
 #ifndef NDEBUG
 TEST(InvalidationSetTest, ShowDebug) {
   scoped_refptr<InvalidationSet> set = DescendantInvalidationSet::Create();
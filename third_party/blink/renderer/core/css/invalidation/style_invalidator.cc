@@ -4,6 +4,7 @@
 
 #include "third_party/blink/renderer/core/css/invalidation/style_invalidator.h"
 
+#include "third_party/blink/renderer/core/css/invalidation/element_feature_filter.h"
 #include "third_party/blink/renderer/core/css/invalidation/invalidation_set.h"
 #include "third_party/blink/renderer/core/css/style_change_reason.h"
 #include "third_party/blink/renderer/core/dom/document.h"
@@ -40,8 +41,10 @@ void StyleInvalidator::Invalidate(Document& document) {
 }
 
 StyleInvalidator::StyleInvalidator(
-    PendingInvalidationMap& pending_invalidation_map)
-    : pending_invalidation_map_(pending_invalidation_map) {
+    PendingInvalidationMap& pending_invalidation_map,
+    const ElementFeatureFilter& element_feature_filter)
+    : pending_invalidation_map_(pending_invalidation_map),
+      element_feature_filter_(element_feature_filter) {
   g_style_invalidator_tracing_enabled =
       TRACE_EVENT_API_GET_CATEGORY_GROUP_ENABLED(
           TRACE_DISABLED_BY_DEFAULT("devtools.timeline.invalidationTracking"));
@@ -54,6 +57,12 @@ void StyleInvalidator::PushInvalidationSet(
   DCHECK(!invalidation_flags_.WholeSubtreeInvalid());
   DCHECK(!invalidation_set.WholeSubtreeInvalid());
   DCHECK(!invalidation_set.IsEmpty());
+  // A set can't invalidate anything if no element in the document has the
+  // classes or ids it looks for. Not pushing it saves walking the subtree for
+  // it, which for sets scheduled on elements near the root is most of the
+  // document.
+  if (!invalidation_set.MayInvalidateElementsIn(element_feature_filter_))
+    return;
   if (invalidation_set.CustomPseudoInvalid())
     invalidation_flags_.SetInvalidateCustomPseudo(true);
   if (invalidation_set.TreeBoundaryCrossing())
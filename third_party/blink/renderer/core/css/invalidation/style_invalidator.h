@@ -18,6 +18,7 @@ namespace blink {
 class ContainerNode;
 class Document;
 class Element;
+class ElementFeatureFilter;
 class HTMLSlotElement;
 class InvalidationSet;
 
@@ -29,7 +30,7 @@ class CORE_EXPORT StyleInvalidator {
   STACK_ALLOCATED();
 
  public:
-  StyleInvalidator(PendingInvalidationMap&);
+  StyleInvalidator(PendingInvalidationMap&, const ElementFeatureFilter&);
 
   ~StyleInvalidator();
   void Invalidate(Document&);
@@ -77,6 +78,7 @@ class CORE_EXPORT StyleInvalidator {
   }
 
   PendingInvalidationMap& pending_invalidation_map_;
+  const ElementFeatureFilter& element_feature_filter_;
   using DescendantInvalidationSets = Vector<const InvalidationSet*, 16>;
   DescendantInvalidationSets invalidation_sets_;
   InvalidationFlags invalidation_flags_;
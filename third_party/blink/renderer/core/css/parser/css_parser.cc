@@ -12,6 +12,7 @@
 #include "third_party/blink/renderer/core/css/parser/css_property_parser.h"
 #include "third_party/blink/renderer/core/css/parser/css_selector_parser.h"
 #include "third_party/blink/renderer/core/css/parser/css_supports_parser.h"
+#include "third_party/blink/renderer/core/css/parser/css_tokenized_sheet.h"
 #include "third_party/blink/renderer/core/css/parser/css_tokenizer.h"
 #include "third_party/blink/renderer/core/css/parser/css_variable_parser.h"
 #include "third_party/blink/renderer/core/css/style_color.h"
@@ -73,6 +74,15 @@ void CSSParser::ParseSheet(const CSSParserContext* context,
                                         defer_property_parsing);
 }
 
+void CSSParser::ParseTokenizedSheet(
+    const CSSParserContext* context,
+    StyleSheetContents* style_sheet,
+    std::unique_ptr<CSSTokenizedSheet> tokenized_sheet,
+    bool defer_property_parsing) {
+  return CSSParserImpl::ParseTokenizedStyleSheet(
+      std::move(tokenized_sheet), context, style_sheet, defer_property_parsing);
+}
+
 void CSSParser::ParseSheetForInspector(const CSSParserContext* context,
                                        StyleSheetContents* style_sheet,
                                        const String& text,
@@ -16,6 +16,7 @@ namespace blink {
 class Color;
 class CSSParserObserver;
 class CSSSelectorList;
+class CSSTokenizedSheet;
 class Element;
 class ImmutableCSSPropertyValueSet;
 class StyleRuleBase;
@@ -37,6 +38,10 @@ class CORE_EXPORT CSSParser {
                          StyleSheetContents*,
                          const String&,
                          bool defer_property_parsing = false);
+  static void ParseTokenizedSheet(const CSSParserContext*,
+                                  StyleSheetContents*,
+                                  std::unique_ptr<CSSTokenizedSheet>,
+                                  bool defer_property_parsing = false);
   static CSSSelectorList ParseSelector(const CSSParserContext*,
                                        StyleSheetContents*,
                                        const String&);
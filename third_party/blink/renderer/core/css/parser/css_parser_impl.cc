@@ -22,6 +22,7 @@
 #include "third_party/blink/renderer/core/css/parser/css_property_parser.h"
 #include "third_party/blink/renderer/core/css/parser/css_selector_parser.h"
 #include "third_party/blink/renderer/core/css/parser/css_supports_parser.h"
+#include "third_party/blink/renderer/core/css/parser/css_tokenized_sheet.h"
 #include "third_party/blink/renderer/core/css/parser/css_tokenizer.h"
 #include "third_party/blink/renderer/core/css/parser/css_variable_parser.h"
 #include "third_party/blink/renderer/core/css/parser/media_query_parser.h"
@@ -246,13 +247,34 @@ void CSSParserImpl::ParseStyleSheet(const String& string,
                                     const CSSParserContext* context,
                                     StyleSheetContents* style_sheet,
                                     bool defer_property_parsing) {
+  CSSTokenizer tokenizer(string);
+  ParseStyleSheetWithTokenizer(string, tokenizer, context, style_sheet,
+                               defer_property_parsing);
+}
+
+void CSSParserImpl::ParseTokenizedStyleSheet(
+    std::unique_ptr<CSSTokenizedSheet> tokenized_sheet,
+    const CSSParserContext* context,
+    StyleSheetContents* style_sheet,
+    bool defer_property_parsing) {
+  String string = tokenized_sheet->SheetText();
+  CSSTokenizer tokenizer(std::move(tokenized_sheet));
+  ParseStyleSheetWithTokenizer(string, tokenizer, context, style_sheet,
+                               defer_property_parsing);
+}
+
+void CSSParserImpl::ParseStyleSheetWithTokenizer(
+    const String& string,
+    CSSTokenizer& tokenizer,
+    const CSSParserContext* context,
+    StyleSheetContents* style_sheet,
+    bool defer_property_parsing) {
   TRACE_EVENT_BEGIN2("blink,blink_style", "CSSParserImpl::parseStyleSheet",
                      "baseUrl", context->BaseURL().GetString().Utf8(), "mode",
                      context->Mode());
 
   TRACE_EVENT_BEGIN0("blink,blink_style",
                      "CSSParserImpl::parseStyleSheet.parse");
-  CSSTokenizer tokenizer(string);
   CSSParserTokenStream stream(tokenizer);
   CSSParserImpl parser(context, style_sheet);
   if (defer_property_parsing) {
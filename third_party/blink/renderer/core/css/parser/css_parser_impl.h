@@ -23,6 +23,8 @@ class CSSLazyParsingState;
 class CSSParserContext;
 class CSSParserObserver;
 class CSSParserTokenStream;
+class CSSTokenizedSheet;
+class CSSTokenizer;
 class StyleRule;
 class StyleRuleBase;
 class StyleRuleCharset;
@@ -99,6 +101,10 @@ class CSSParserImpl {
                               const CSSParserContext*,
                               StyleSheetContents*,
                               bool defer_property_parsing = false);
+  static void ParseTokenizedStyleSheet(std::unique_ptr<CSSTokenizedSheet>,
+                                       const CSSParserContext*,
+                                       StyleSheetContents*,
+                                       bool defer_property_parsing = false);
   static CSSSelectorList ParsePageSelector(CSSParserTokenRange,
                                            StyleSheetContents*);
 
@@ -122,6 +128,12 @@ class CSSParserImpl {
  private:
   enum RuleListType { kTopLevelRuleList, kRegularRuleList, kKeyframesRuleList };
 
+  static void ParseStyleSheetWithTokenizer(const String&,
+                                           CSSTokenizer&,
+                                           const CSSParserContext*,
+                                           StyleSheetContents*,
+                                           bool defer_property_parsing);
+
   // Returns whether the first encountered rule was valid
   template <typename T>
   bool ConsumeRuleList(CSSParserTokenStream&, RuleListType, T callback);
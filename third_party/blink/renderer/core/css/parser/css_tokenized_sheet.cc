@@ -0,0 +1,29 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/parser/css_tokenized_sheet.h"
+
+#include "third_party/blink/renderer/core/css/parser/css_tokenizer.h"
+
+namespace blink {
+
+void CSSTokenizedSheet::Tokenize() {
+  DCHECK(!IsTokenized());
+  CSSTokenizer tokenizer(sheet_text_);
+  // Most strings we tokenize have about 3.5 to 5 characters per token.
+  tokens_.ReserveInitialCapacity(sheet_text_.length() / 4 + 1);
+  while (true) {
+    const CSSParserToken token = tokenizer.TokenizeSingle();
+    tokens_.push_back(Entry{token,
+                            static_cast<unsigned>(tokenizer.PreviousOffset()),
+                            static_cast<unsigned>(tokenizer.Offset())});
+    if (token.IsEOF())
+      break;
+  }
+  tokens_.ShrinkToFit();
+  string_pool_.swap(tokenizer.string_pool_);
+  token_count_ = tokenizer.TokenCount();
+}
+
+}  // namespace blink
@@ -0,0 +1,61 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_CSS_PARSER_CSS_TOKENIZED_SHEET_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_CSS_PARSER_CSS_TOKENIZED_SHEET_H_
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/css/parser/css_parser_token.h"
+#include "third_party/blink/renderer/platform/wtf/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+// The tokens of a whole stylesheet, tokenized ahead of parsing. Tokenizing
+// only touches the sheet text and the strings allocated for escapes, none of
+// which is garbage collected or atomized, so a CSSTokenizedSheet holding an
+// isolated copy of the text can be handed over to a background thread to be
+// tokenized, and then back to the main thread, where a CSSTokenizer replays it
+// for the parser.
+class CORE_EXPORT CSSTokenizedSheet {
+  USING_FAST_MALLOC(CSSTokenizedSheet);
+
+ public:
+  // |sheet_text| must not be shared with other threads.
+  explicit CSSTokenizedSheet(const String& sheet_text)
+      : sheet_text_(sheet_text) {}
+
+  void Tokenize();
+
+  const String& SheetText() const { return sheet_text_; }
+  bool IsTokenized() const { return !tokens_.IsEmpty(); }
+
+ private:
+  friend class CSSTokenizer;
+
+  // A token, with the offsets CSSParserTokenStream asks its tokenizer for.
+  struct Entry {
+    CSSParserToken token;
+    // The offset of the token, after any comments before it.
+    unsigned start_offset;
+    // The offset just past the token.
+    unsigned end_offset;
+  };
+
+  // The tokens point into these strings.
+  String sheet_text_;
+  Vector<String> string_pool_;
+
+  // Ends with an EOF token once tokenized.
+  Vector<Entry> tokens_;
+  unsigned token_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CSSTokenizedSheet);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_CSS_PARSER_CSS_TOKENIZED_SHEET_H_
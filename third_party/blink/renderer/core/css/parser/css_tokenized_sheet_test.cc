@@ -0,0 +1,86 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/parser/css_tokenized_sheet.h"
+
+#include <memory>
+#include <utility>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/css/css_property_value_set.h"
+#include "third_party/blink/renderer/core/css/parser/css_parser.h"
+#include "third_party/blink/renderer/core/css/parser/css_parser_context.h"
+#include "third_party/blink/renderer/core/css/style_rule.h"
+#include "third_party/blink/renderer/core/css/style_sheet_contents.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+
+namespace blink {
+
+namespace {
+
+void ExpectSameRules(const HeapVector<Member<StyleRuleBase>>& expected,
+                     const HeapVector<Member<StyleRuleBase>>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i]->GetType(), actual[i]->GetType());
+    if (expected[i]->IsStyleRule()) {
+      StyleRule* expected_rule = ToStyleRule(expected[i].Get());
+      StyleRule* actual_rule = ToStyleRule(actual[i].Get());
+      EXPECT_EQ(expected_rule->SelectorList().SelectorsText(),
+                actual_rule->SelectorList().SelectorsText());
+      EXPECT_EQ(expected_rule->Properties().AsText(),
+                actual_rule->Properties().AsText());
+    } else if (expected[i]->IsMediaRule()) {
+      ExpectSameRules(ToStyleRuleMedia(expected[i].Get())->ChildRules(),
+                      ToStyleRuleMedia(actual[i].Get())->ChildRules());
+    }
+  }
+}
+
+}  // namespace
+
+// Parsing a sheet tokenized ahead of time, including lazily parsing its
+// declarations from the recorded offsets, gives the same rules as parsing
+// the text.
+TEST(CSSTokenizedSheetTest, ParsesLikeText) {
+  String sheet_text =
+      "/* header */ body { color: red; margin: 0 auto }\n"
+      ".a\\31, #b > c::before { content: 'x\\'y' /* inline */ }\n"
+      "@media (min-width: 100px) { p { font-size: 1.5em } q { } }\n"
+      "bad { ; color: blue; }\n"
+      "@unknown foo;\n"
+      "tail { background: url(x.png) }";
+
+  for (bool lazy : {false, true}) {
+    CSSParserContext* context = CSSParserContext::Create(
+        kHTMLStandardMode, SecureContextMode::kInsecureContext);
+    StyleSheetContents* expected = StyleSheetContents::Create(context);
+    CSSParser::ParseSheet(context, expected, sheet_text, lazy);
+
+    auto tokenized_sheet = std::make_unique<CSSTokenizedSheet>(sheet_text);
+    tokenized_sheet->Tokenize();
+    EXPECT_TRUE(tokenized_sheet->IsTokenized());
+    StyleSheetContents* actual = StyleSheetContents::Create(context);
+    CSSParser::ParseTokenizedSheet(context, actual, std::move(tokenized_sheet),
+                                   lazy);
+
+    ExpectSameRules(expected->ChildRules(), actual->ChildRules());
+  }
+}
+
+TEST(CSSTokenizedSheetTest, Empty) {
+  auto tokenized_sheet = std::make_unique<CSSTokenizedSheet>(String(""));
+  tokenized_sheet->Tokenize();
+  // There is still the EOF token.
+  EXPECT_TRUE(tokenized_sheet->IsTokenized());
+
+  CSSParserContext* context = CSSParserContext::Create(
+      kHTMLStandardMode, SecureContextMode::kInsecureContext);
+  StyleSheetContents* style_sheet = StyleSheetContents::Create(context);
+  CSSParser::ParseTokenizedSheet(context, style_sheet,
+                                 std::move(tokenized_sheet));
+  EXPECT_EQ(0u, style_sheet->RuleCount());
+}
+
+}  // namespace blink
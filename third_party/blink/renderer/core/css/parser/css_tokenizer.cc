@@ -10,6 +10,7 @@ namespace blink {
 
 #include "third_party/blink/renderer/core/css/parser/css_parser_idioms.h"
 #include "third_party/blink/renderer/core/css/parser/css_parser_token_range.h"
+#include "third_party/blink/renderer/core/css/parser/css_tokenized_sheet.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
 #include "third_party/blink/renderer/platform/wtf/text/character_names.h"
 
@@ -28,7 +29,17 @@ CSSTokenizer::CSSTokenizer(const String& string, size_t offset)
   input_.Advance(offset);
 }
 
+CSSTokenizer::CSSTokenizer(std::unique_ptr<CSSTokenizedSheet> tokenized_sheet)
+    : input_(tokenized_sheet->SheetText()),
+      token_count_(tokenized_sheet->token_count_),
+      tokenized_sheet_(std::move(tokenized_sheet)) {
+  DCHECK(tokenized_sheet_->IsTokenized());
+}
+
+CSSTokenizer::~CSSTokenizer() = default;
+
 Vector<CSSParserToken, 32> CSSTokenizer::TokenizeToEOF() {
+  DCHECK(!tokenized_sheet_);
   // To avoid resizing we err on the side of reserving too much space.
   // Most strings we tokenize have about 3.5 to 5 characters per token.
   Vector<CSSParserToken, 32> tokens;
@@ -49,6 +60,8 @@ Vector<CSSParserToken, 32> CSSTokenizer::TokenizeToEOF() {
 }
 
 CSSParserToken CSSTokenizer::TokenizeSingle() {
+  if (tokenized_sheet_)
+    return NextTokenizedSheetToken();
   while (true) {
     prev_offset_ = input_.Offset();
     const CSSParserToken token = NextToken();
@@ -59,10 +72,24 @@ CSSParserToken CSSTokenizer::TokenizeSingle() {
 }
 
 CSSParserToken CSSTokenizer::TokenizeSingleWithComments() {
+  // Comments aren't kept in tokenized sheets.
+  DCHECK(!tokenized_sheet_);
   prev_offset_ = input_.Offset();
   return NextToken();
 }
 
+CSSParserToken CSSTokenizer::NextTokenizedSheetToken() {
+  const Vector<CSSTokenizedSheet::Entry>& tokens = tokenized_sheet_->tokens_;
+  // Like the input stream, keep returning the EOF token at the end.
+  const CSSTokenizedSheet::Entry& entry = tokens[next_tokenized_sheet_token_];
+  if (next_tokenized_sheet_token_ + 1 < tokens.size())
+    ++next_tokenized_sheet_token_;
+  prev_offset_ = entry.start_offset;
+  DCHECK_GE(entry.end_offset, input_.Offset());
+  input_.Advance(entry.end_offset - input_.Offset());
+  return entry.token;
+}
+
 unsigned CSSTokenizer::TokenCount() {
   return token_count_;
 }
@@ -390,19 +417,16 @@ CSSParserToken CSSTokenizer::ConsumeIdentLikeToken() {
 // https://drafts.csswg.org/css-syntax/#consume-a-string-token
 CSSParserToken CSSTokenizer::ConsumeStringTokenUntil(UChar ending_code_point) {
   // Strings without escapes get handled without allocations
-  for (unsigned size = 0;; size++) {
-    UChar cc = input_.PeekWithoutReplacement(size);
-    if (cc == ending_code_point) {
-      unsigned start_offset = input_.Offset();
-      input_.Advance(size + 1);
-      return CSSParserToken(kStringToken, input_.RangeAt(start_offset, size));
-    }
-    if (IsNewLine(cc)) {
-      input_.Advance(size);
-      return CSSParserToken(kBadStringToken);
-    }
-    if (cc == '\0' || cc == '\\')
-      break;
+  unsigned size = input_.SkipUntilStringBodyEnd(ending_code_point);
+  UChar cc = input_.PeekWithoutReplacement(size);
+  if (cc == ending_code_point) {
+    unsigned start_offset = input_.Offset();
+    input_.Advance(size + 1);
+    return CSSParserToken(kStringToken, input_.RangeAt(start_offset, size));
+  }
+  if (IsNewLine(cc)) {
+    input_.Advance(size);
+    return CSSParserToken(kBadStringToken);
   }
 
   StringBuilder output;
@@ -536,18 +560,7 @@ void CSSTokenizer::ConsumeSingleWhitespaceIfNext() {
 }
 
 void CSSTokenizer::ConsumeUntilCommentEndFound() {
-  UChar c = Consume();
-  while (true) {
-    if (c == kEndOfFileMarker)
-      return;
-    if (c != '*') {
-      c = Consume();
-      continue;
-    }
-    c = Consume();
-    if (c == '/')
-      return;
-  }
+  input_.AdvancePastCommentEnd();
 }
 
 bool CSSTokenizer::ConsumeIfNext(UChar character) {
@@ -565,17 +578,13 @@ bool CSSTokenizer::ConsumeIfNext(UChar character) {
 // http://www.w3.org/TR/css3-syntax/#consume-a-name
 StringView CSSTokenizer::ConsumeName() {
   // Names without escapes get handled without allocations
-  for (unsigned size = 0;; ++size) {
-    UChar cc = input_.PeekWithoutReplacement(size);
-    if (IsNameCodePoint(cc))
-      continue;
-    // peekWithoutReplacement will return NUL when we hit the end of the
-    // input. In that case we want to still use the rangeAt() fast path
-    // below.
-    if (cc == '\0' && input_.Offset() + size < input_.length())
-      break;
-    if (cc == '\\')
-      break;
+  unsigned size = input_.SkipWhilePredicate<IsNameCodePoint<UChar>>(0);
+  UChar cc = input_.PeekWithoutReplacement(size);
+  // PeekWithoutReplacement will return NUL when we hit the end of the
+  // input. In that case we want to still use the RangeAt() fast path
+  // below.
+  bool nul_in_input = cc == '\0' && input_.Offset() + size < input_.length();
+  if (!nul_in_input && cc != '\\') {
     unsigned start_offset = input_.Offset();
     input_.Advance(size);
     return input_.RangeAt(start_offset, size);
@@ -15,9 +15,11 @@
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 
 #include <climits>
+#include <memory>
 
 namespace blink {
 
+class CSSTokenizedSheet;
 class CSSTokenizerInputStream;
 
 class CORE_EXPORT CSSTokenizer {
@@ -25,6 +27,10 @@ class CORE_EXPORT CSSTokenizer {
 
  public:
   CSSTokenizer(const String&, size_t offset = 0);
+  // Replays the tokens of a sheet tokenized ahead of time, which may only be
+  // read through a CSSParserTokenStream.
+  explicit CSSTokenizer(std::unique_ptr<CSSTokenizedSheet>);
+  ~CSSTokenizer();
 
   Vector<CSSParserToken, 32> TokenizeToEOF();
   unsigned TokenCount();
@@ -37,6 +43,7 @@ class CORE_EXPORT CSSTokenizer {
   CSSParserToken TokenizeSingleWithComments();
 
   CSSParserToken NextToken();
+  CSSParserToken NextTokenizedSheetToken();
 
   UChar Consume();
   void Reconsume(UChar);
@@ -108,9 +115,14 @@ class CORE_EXPORT CSSTokenizer {
   Vector<String> string_pool_;
 
   friend class CSSParserTokenStream;
+  friend class CSSTokenizedSheet;
 
   size_t prev_offset_ = 0;
   size_t token_count_ = 0;
+
+  // Set when replaying a sheet tokenized ahead of time.
+  std::unique_ptr<CSSTokenizedSheet> tokenized_sheet_;
+  size_t next_tokenized_sheet_token_ = 0;
   DISALLOW_COPY_AND_ASSIGN(CSSTokenizer);
 };
 
@@ -4,11 +4,53 @@
 
 #include "third_party/blink/renderer/core/css/parser/css_tokenizer_input_stream.h"
 
+#include <string.h>
+
 #include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
+#include "third_party/blink/renderer/platform/wtf/text/ascii_fast_path.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_to_number.h"
 
 namespace blink {
 
+namespace {
+
+using WTF::MachineWord;
+
+// Returns a word with each byte set to |c|.
+constexpr MachineWord RepeatByte(LChar c) {
+  return static_cast<MachineWord>(0x0101010101010101ULL) * c;
+}
+
+// Returns the word starting at |characters|, which may be unaligned.
+MachineWord LoadWord(const LChar* characters) {
+  MachineWord word;
+  memcpy(&word, characters, sizeof(word));
+  return word;
+}
+
+// Returns true if any byte of |word| is zero.
+bool HasZeroByte(MachineWord word) {
+  return (word - RepeatByte(0x01)) & ~word & RepeatByte(0x80);
+}
+
+// Returns true if any byte of |word| is |c|.
+bool HasByte(MachineWord word, LChar c) {
+  return HasZeroByte(word ^ RepeatByte(c));
+}
+
+// Returns true if any byte of |word| is less than |n|, which must be at most
+// 0x80.
+bool HasByteLessThan(MachineWord word, LChar n) {
+  return (word - RepeatByte(n)) & ~word & RepeatByte(0x80);
+}
+
+bool IsStringBodyEnd(UChar c, UChar quote) {
+  return c == quote || c == '\\' || c == '\n' || c == '\r' || c == '\f' ||
+         c == '\0';
+}
+
+}  // namespace
+
 CSSTokenizerInputStream::CSSTokenizerInputStream(const String& input)
     : offset_(0), string_length_(input.length()), string_(input.Impl()) {}
 
@@ -16,6 +58,11 @@ void CSSTokenizerInputStream::AdvanceUntilNonWhitespace() {
   // Using HTML space here rather than CSS space since we don't do preprocessing
   if (string_->Is8Bit()) {
     const LChar* characters = string_->Characters8();
+    // Skip indentation a word at a time.
+    while (offset_ + sizeof(MachineWord) <= string_length_ &&
+           LoadWord(characters + offset_) == RepeatByte(' ')) {
+      offset_ += sizeof(MachineWord);
+    }
     while (offset_ < string_length_ && IsHTMLSpace(characters[offset_]))
       ++offset_;
   } else {
@@ -25,6 +72,65 @@ void CSSTokenizerInputStream::AdvanceUntilNonWhitespace() {
   }
 }
 
+void CSSTokenizerInputStream::AdvancePastCommentEnd() {
+  if (offset_ >= string_length_)
+    return;
+  if (string_->Is8Bit()) {
+    const LChar* characters = string_->Characters8();
+    while (offset_ < string_length_) {
+      const void* star =
+          memchr(characters + offset_, '*', string_length_ - offset_);
+      if (!star)
+        break;
+      offset_ = static_cast<const LChar*>(star) - characters + 1;
+      if (offset_ < string_length_ && characters[offset_] == '/') {
+        ++offset_;
+        return;
+      }
+    }
+  } else {
+    const UChar* characters = string_->Characters16();
+    while (offset_ < string_length_) {
+      if (characters[offset_++] == '*' && offset_ < string_length_ &&
+          characters[offset_] == '/') {
+        ++offset_;
+        return;
+      }
+    }
+  }
+  offset_ = string_length_;
+}
+
+unsigned CSSTokenizerInputStream::SkipUntilStringBodyEnd(UChar quote) const {
+  unsigned offset = Offset();
+  if (string_->Is8Bit()) {
+    const LChar* characters = string_->Characters8();
+    // All the characters that end a string body other than the quote and the
+    // backslash are control characters, so that a word without any of those
+    // can be skipped at once.
+    DCHECK_LT(quote, 0x80);
+    while (offset + sizeof(MachineWord) <= string_length_) {
+      MachineWord word = LoadWord(characters + offset);
+      if (HasByteLessThan(word, 0x20) || HasByte(word, quote) ||
+          HasByte(word, '\\')) {
+        break;
+      }
+      offset += sizeof(MachineWord);
+    }
+    while (offset < string_length_ &&
+           !IsStringBodyEnd(characters[offset], quote)) {
+      ++offset;
+    }
+  } else {
+    const UChar* characters = string_->Characters16();
+    while (offset < string_length_ &&
+           !IsStringBodyEnd(characters[offset], quote)) {
+      ++offset;
+    }
+  }
+  return offset - Offset();
+}
+
 double CSSTokenizerInputStream::GetDouble(unsigned start, unsigned end) const {
   DCHECK(start <= end && ((offset_ + end) <= string_length_));
   bool is_result_ok = false;
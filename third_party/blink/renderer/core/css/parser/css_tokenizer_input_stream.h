@@ -61,8 +61,18 @@ class CSSTokenizerInputStream {
     return offset;
   }
 
+  // The following scan 8-bit input, which most stylesheets are, a machine word
+  // at a time where they can.
   void AdvanceUntilNonWhitespace();
 
+  // Advances past the next "*/", or to the end of the stream if there is none.
+  void AdvancePastCommentEnd();
+
+  // Returns the number of characters from the current position which can't
+  // end the body of a string delimited by |quote|, i.e. before the first
+  // |quote|, escape, newline or NUL.
+  unsigned SkipUntilStringBodyEnd(UChar quote) const;
+
   unsigned length() const { return string_length_; }
   unsigned Offset() const { return std::min(offset_, string_length_); }
 
@@ -0,0 +1,64 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/parser/css_tokenizer.h"
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+
+namespace blink {
+
+namespace {
+
+// Returns a stylesheet of about 400KB in the style of a CSS framework: rules
+// with comments, quoted URLs and fonts, indented declarations and long class
+// names.
+String BuildStylesheet() {
+  const unsigned kRuleCount = 1000;
+  StringBuilder builder;
+  for (unsigned i = 0; i < kRuleCount; ++i) {
+    String index = String::Number(i);
+    builder.Append("/* Component ");
+    builder.Append(index);
+    builder.Append(": styles for the navigation bar and its dropdowns. */\n");
+    builder.Append(".navbar-component-");
+    builder.Append(index);
+    builder.Append(" > .dropdown-menu-item:hover,\n.navbar-component-");
+    builder.Append(index);
+    builder.Append(" > .dropdown-menu-item:focus {\n");
+    builder.Append("    font-family: \"Helvetica Neue\", Helvetica, Arial, ");
+    builder.Append("sans-serif;\n");
+    builder.Append("    background-image: url(\"/images/background-");
+    builder.Append(index);
+    builder.Append(".png\");\n");
+    builder.Append("    content: \"\\201C  a quoted string\";\n");
+    builder.Append("    margin: 0 auto 1.5em;\n");
+    builder.Append("    transition: opacity 0.15s linear, ");
+    builder.Append("transform 0.3s ease-out;\n");
+    builder.Append("}\n\n");
+  }
+  return builder.ToString();
+}
+
+}  // namespace
+
+TEST(CSSTokenizerPerfTest, TokenizeStylesheet) {
+  const unsigned kIterationCount = 20;
+  String stylesheet = BuildStylesheet();
+
+  size_t token_count = 0;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (unsigned count = 0; count < kIterationCount; count++) {
+    CSSTokenizer tokenizer(stylesheet);
+    token_count = tokenizer.TokenizeToEOF().size();
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  EXPECT_GT(token_count, 0u);
+  LOG(ERROR) << "  Time to tokenize " << stylesheet.length() << " characters: "
+             << (elapsed / kIterationCount).InMicroseconds() << "us";
+}
+
+}  // namespace blink
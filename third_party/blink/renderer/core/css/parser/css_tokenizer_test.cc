@@ -8,6 +8,7 @@
 #include "third_party/blink/renderer/core/css/parser/css_parser_token_range.h"
 #include "third_party/blink/renderer/core/css/parser/media_query_block_watcher.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/partitions.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
 namespace blink {
 
@@ -459,6 +460,39 @@ TEST(CSSTokenizerTest, CommentToken) {
   TEST_TOKENS(";/******", Semicolon());
 }
 
+// Strings, comments and whitespace are scanned a word at a time, so check
+// them against input which is longer than a word and ends at every alignment.
+TEST(CSSTokenizerTest, LongTokens) {
+  TEST_TOKENS("'a long string, with some punctuation!'",
+              GetString("a long string, with some punctuation!"));
+  TEST_TOKENS("\"a long string with a 'quote' in it\"",
+              GetString("a long string with a 'quote' in it"));
+  TEST_TOKENS("'a long string with an escape\\'d quote'",
+              GetString("a long string with an escape'd quote"));
+  TEST_TOKENS("'a long string with a new\nline", BadString(), Whitespace(),
+              Ident("line"));
+  TEST_TOKENS(String("'a long string with a \0 in it'", 30u),
+              GetString("a long string with a " + FromUChar32(0xFFFD) +
+                        " in it"));
+  TEST_TOKENS("'a long string ending on eof",
+              GetString("a long string ending on eof"));
+  TEST_TOKENS("/* a long comment with * and / in it */a", Ident("a"));
+  TEST_TOKENS("; /* a long comment ending on eof*", Semicolon(), Whitespace());
+  TEST_TOKENS("a-very-long-identifier-name",
+              Ident("a-very-long-identifier-name"));
+  TEST_TOKENS("                 \t\n  a", Whitespace(), Ident("a"));
+
+  StringBuilder body;
+  StringBuilder spaces;
+  for (unsigned length = 0; length < 20; ++length) {
+    spaces.Append(' ');
+    TEST_TOKENS("'" + body.ToString() + "'", GetString(body.ToString()));
+    TEST_TOKENS("/*" + body.ToString() + "*/ ", Whitespace());
+    TEST_TOKENS(spaces.ToString() + "a", Whitespace(), Ident("a"));
+    body.Append('x');
+  }
+}
+
 typedef struct {
   const char* input;
   const unsigned max_level;
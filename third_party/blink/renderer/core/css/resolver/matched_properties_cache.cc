@@ -60,10 +60,86 @@ const CachedMatchedProperties* MatchedPropertiesCache::Find(
     unsigned hash,
     const StyleResolverState& style_resolver_state,
     const MatchedPropertiesVector& properties) {
+  return FindInCache(cache_, hash, style_resolver_state, properties);
+}
+
+void MatchedPropertiesCache::Add(const ComputedStyle& style,
+                                 const ComputedStyle& parent_style,
+                                 unsigned hash,
+                                 const MatchedPropertiesVector& properties) {
+  AddToCache(cache_, style, parent_style, hash, properties);
+}
+
+const CachedMatchedProperties* MatchedPropertiesCache::FindNonInherited(
+    unsigned hash,
+    const StyleResolverState& style_resolver_state,
+    const MatchedPropertiesVector& non_inherited_properties) {
+  return FindInCache(non_inherited_cache_, hash, style_resolver_state,
+                     non_inherited_properties);
+}
+
+void MatchedPropertiesCache::AddNonInherited(
+    const ComputedStyle& style,
+    const ComputedStyle& parent_style,
+    unsigned hash,
+    const MatchedPropertiesVector& non_inherited_properties) {
+  AddToCache(non_inherited_cache_, style, parent_style, hash,
+             non_inherited_properties);
+}
+
+static bool DeclaresNonInheritedProperty(
+    const CSSPropertyValueSet& properties) {
+  unsigned property_count = properties.PropertyCount();
+  for (unsigned i = 0; i < property_count; ++i) {
+    CSSPropertyValueSet::PropertyReference current = properties.PropertyAt(i);
+    // This matches what StyleResolver::ApplyProperties() skips when applying
+    // inherited properties only. 'all' expands to non-inherited properties.
+    if (!current.IsInherited() || current.Id() == CSSPropertyAll)
+      return true;
+    // The writing mode and direction decide which physical properties the
+    // logical ones set, so they have to match as well.
+    switch (current.Id()) {
+      case CSSPropertyDirection:
+      case CSSPropertyWritingMode:
+      case CSSPropertyWebkitWritingMode:
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+bool MatchedPropertiesCache::CollectNonInheritedProperties(
+    const MatchedPropertiesVector& properties,
+    MatchedPropertiesVector& non_inherited_properties) {
+  DCHECK(non_inherited_properties.IsEmpty());
+  for (const auto& matched_properties : properties) {
+    if (DeclaresNonInheritedProperty(*matched_properties.properties))
+      non_inherited_properties.push_back(matched_properties);
+  }
+  return non_inherited_properties.size() != properties.size();
+}
+
+void MatchedPropertiesCache::Clear() {
+  ClearCache(cache_);
+  ClearCache(non_inherited_cache_);
+}
+
+void MatchedPropertiesCache::ClearViewportDependent() {
+  ClearViewportDependentInCache(cache_);
+  ClearViewportDependentInCache(non_inherited_cache_);
+}
+
+const CachedMatchedProperties* MatchedPropertiesCache::FindInCache(
+    Cache& cache,
+    unsigned hash,
+    const StyleResolverState& style_resolver_state,
+    const MatchedPropertiesVector& properties) {
   DCHECK(hash);
 
-  Cache::iterator it = cache_.find(hash);
-  if (it == cache_.end())
+  Cache::iterator it = cache.find(hash);
+  if (it == cache.end())
     return nullptr;
   CachedMatchedProperties* cache_item = it->value.Get();
   if (!cache_item)
@@ -82,12 +158,14 @@ const CachedMatchedProperties* MatchedPropertiesCache::Find(
   return cache_item;
 }
 
-void MatchedPropertiesCache::Add(const ComputedStyle& style,
-                                 const ComputedStyle& parent_style,
-                                 unsigned hash,
-                                 const MatchedPropertiesVector& properties) {
+void MatchedPropertiesCache::AddToCache(
+    Cache& cache,
+    const ComputedStyle& style,
+    const ComputedStyle& parent_style,
+    unsigned hash,
+    const MatchedPropertiesVector& properties) {
   DCHECK(hash);
-  Cache::AddResult add_result = cache_.insert(hash, nullptr);
+  Cache::AddResult add_result = cache.insert(hash, nullptr);
   if (add_result.is_new_entry || !add_result.stored_value->value)
     add_result.stored_value->value = new CachedMatchedProperties;
 
@@ -98,25 +176,25 @@ void MatchedPropertiesCache::Add(const ComputedStyle& style,
   cache_item->Set(style, parent_style, properties);
 }
 
-void MatchedPropertiesCache::Clear() {
+void MatchedPropertiesCache::ClearCache(Cache& cache) {
   // MatchedPropertiesCache must be cleared promptly because some
   // destructors in the properties (e.g., ~FontFallbackList) expect that
   // the destructors are called promptly without relying on a GC timing.
-  for (auto& cache_entry : cache_) {
+  for (auto& cache_entry : cache) {
     if (cache_entry.value)
       cache_entry.value->Clear();
   }
-  cache_.clear();
+  cache.clear();
 }
 
-void MatchedPropertiesCache::ClearViewportDependent() {
+void MatchedPropertiesCache::ClearViewportDependentInCache(Cache& cache) {
   Vector<unsigned, 16> to_remove;
-  for (const auto& cache_entry : cache_) {
+  for (const auto& cache_entry : cache) {
     CachedMatchedProperties* cache_item = cache_entry.value.Get();
     if (cache_item && cache_item->computed_style->HasViewportUnits())
       to_remove.push_back(cache_entry.key);
   }
-  cache_.RemoveAll(to_remove);
+  cache.RemoveAll(to_remove);
 }
 
 bool MatchedPropertiesCache::IsStyleCacheable(const ComputedStyle& style) {
@@ -154,6 +232,7 @@ bool MatchedPropertiesCache::IsCacheable(const StyleResolverState& state) {
 
 void MatchedPropertiesCache::Trace(blink::Visitor* visitor) {
   visitor->Trace(cache_);
+  visitor->Trace(non_inherited_cache_);
 }
 
 }  // namespace blink
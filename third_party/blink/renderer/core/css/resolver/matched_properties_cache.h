@@ -104,7 +104,10 @@ class CORE_EXPORT MatchedPropertiesCache {
 
  public:
   MatchedPropertiesCache();
-  ~MatchedPropertiesCache() { DCHECK(cache_.IsEmpty()); }
+  ~MatchedPropertiesCache() {
+    DCHECK(cache_.IsEmpty());
+    DCHECK(non_inherited_cache_.IsEmpty());
+  }
 
   const CachedMatchedProperties* Find(unsigned hash,
                                       const StyleResolverState&,
@@ -114,6 +117,29 @@ class CORE_EXPORT MatchedPropertiesCache {
            unsigned hash,
            const MatchedPropertiesVector&);
 
+  // The second level of the cache is keyed on the matched properties which
+  // declare non-inherited properties only, as collected by
+  // CollectNonInheritedProperties(). The non-inherited properties of a style
+  // found there can be reused, but all of the inherited properties have to
+  // be applied, as they may come from declarations left out of the key.
+  const CachedMatchedProperties* FindNonInherited(
+      unsigned hash,
+      const StyleResolverState&,
+      const MatchedPropertiesVector& non_inherited_properties);
+  void AddNonInherited(const ComputedStyle&,
+                       const ComputedStyle& parent_style,
+                       unsigned hash,
+                       const MatchedPropertiesVector& non_inherited_properties);
+
+  // Appends to |non_inherited_properties| those of |properties| which declare
+  // any property that is skipped when applying inherited properties only, or
+  // the writing mode or direction.
+  // Returns false if that is all of them, in which case the second level
+  // can't find anything the first level wouldn't.
+  static bool CollectNonInheritedProperties(
+      const MatchedPropertiesVector& properties,
+      MatchedPropertiesVector& non_inherited_properties);
+
   void Clear();
   void ClearViewportDependent();
 
@@ -128,7 +154,21 @@ class CORE_EXPORT MatchedPropertiesCache {
                             DefaultHash<unsigned>::Hash,
                             HashTraits<unsigned>,
                             CachedMatchedPropertiesHashTraits>;
+  static const CachedMatchedProperties* FindInCache(
+      Cache&,
+      unsigned hash,
+      const StyleResolverState&,
+      const MatchedPropertiesVector&);
+  static void AddToCache(Cache&,
+                         const ComputedStyle&,
+                         const ComputedStyle& parent_style,
+                         unsigned hash,
+                         const MatchedPropertiesVector&);
+  static void ClearCache(Cache&);
+  static void ClearViewportDependentInCache(Cache&);
+
   Cache cache_;
+  Cache non_inherited_cache_;
   DISALLOW_COPY_AND_ASSIGN(MatchedPropertiesCache);
 };
 
@@ -1646,10 +1646,32 @@ StyleResolver::CacheSuccess StyleResolver::ApplyMatchedCache(
                             : 0;
   bool is_inherited_cache_hit = false;
   bool is_non_inherited_cache_hit = false;
+  unsigned non_inherited_cache_hash = 0;
   const CachedMatchedProperties* cached_matched_properties =
       cache_hash ? matched_properties_cache_.Find(
                        cache_hash, state, match_result.GetMatchedProperties())
                  : nullptr;
+  if (cache_hash) {
+    INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
+                                  matched_property_cache_lookup, 1);
+  }
+
+  // Elements often match the same declarations for their non-inherited
+  // properties, and differ only in declarations of inherited ones, e.g. for
+  // the color and font of some text. Fall back to a style built from the same
+  // declarations of non-inherited properties.
+  if (cache_hash && !cached_matched_properties &&
+      MatchedPropertiesCache::IsCacheable(state)) {
+    MatchedPropertiesVector non_inherited_properties;
+    if (MatchedPropertiesCache::CollectNonInheritedProperties(
+            match_result.GetMatchedProperties(), non_inherited_properties)) {
+      non_inherited_cache_hash =
+          ComputeMatchedPropertiesHash(non_inherited_properties.data(),
+                                       non_inherited_properties.size());
+      cached_matched_properties = matched_properties_cache_.FindNonInherited(
+          non_inherited_cache_hash, state, non_inherited_properties);
+    }
+  }
 
   if (cached_matched_properties && MatchedPropertiesCache::IsCacheable(state)) {
     INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
@@ -1661,11 +1683,16 @@ StyleResolver::CacheSuccess StyleResolver::ApplyMatchedCache(
     // reusing the style data structures.
     state.Style()->CopyNonInheritedFromCached(
         *cached_matched_properties->computed_style);
-    if (state.ParentStyle()->InheritedDataShared(
-            *cached_matched_properties->parent_computed_style) &&
-        !IsAtShadowBoundary(element) &&
-        (!state.DistributedToV0InsertionPoint() || element->AssignedSlot() ||
-         state.Style()->UserModify() == EUserModify::kReadOnly)) {
+    if (non_inherited_cache_hash) {
+      INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
+                                    matched_property_cache_non_inherited_hit,
+                                    1);
+    } else if (state.ParentStyle()->InheritedDataShared(
+                   *cached_matched_properties->parent_computed_style) &&
+               !IsAtShadowBoundary(element) &&
+               (!state.DistributedToV0InsertionPoint() ||
+                element->AssignedSlot() ||
+                state.Style()->UserModify() == EUserModify::kReadOnly)) {
       INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
                                     matched_property_cache_inherited_hit, 1);
 
@@ -1687,7 +1714,8 @@ StyleResolver::CacheSuccess StyleResolver::ApplyMatchedCache(
   }
 
   return CacheSuccess(is_inherited_cache_hit, is_non_inherited_cache_hit,
-                      cache_hash, cached_matched_properties);
+                      cache_hash, non_inherited_cache_hash,
+                      cached_matched_properties);
 }
 
 void StyleResolver::ApplyCustomProperties(StyleResolverState& state,
@@ -1869,14 +1897,27 @@ void StyleResolver::ApplyMatchedStandardProperties(
 
   LoadPendingResources(state);
 
+  // A style built on one from the second level of the cache still goes into
+  // the first level, so that elements with the same declarations can reuse
+  // its inherited properties too.
   if (!state.IsAnimatingCustomProperties() &&
-      !cache_success.cached_matched_properties && cache_success.cache_hash &&
-      MatchedPropertiesCache::IsCacheable(state)) {
+      (!cache_success.cached_matched_properties ||
+       cache_success.non_inherited_cache_hash) &&
+      cache_success.cache_hash && MatchedPropertiesCache::IsCacheable(state)) {
     INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
                                   matched_property_cache_added, 1);
     matched_properties_cache_.Add(*state.Style(), *state.ParentStyle(),
                                   cache_success.cache_hash,
                                   match_result.GetMatchedProperties());
+    if (cache_success.non_inherited_cache_hash &&
+        !cache_success.cached_matched_properties) {
+      MatchedPropertiesVector non_inherited_properties;
+      MatchedPropertiesCache::CollectNonInheritedProperties(
+          match_result.GetMatchedProperties(), non_inherited_properties);
+      matched_properties_cache_.AddNonInherited(
+          *state.Style(), *state.ParentStyle(),
+          cache_success.non_inherited_cache_hash, non_inherited_properties);
+    }
   }
 
   DCHECK(!state.GetFontBuilder().FontDirty());
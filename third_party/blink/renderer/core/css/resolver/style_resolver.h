@@ -184,15 +184,20 @@ class CORE_EXPORT StyleResolver final
     bool is_inherited_cache_hit;
     bool is_non_inherited_cache_hit;
     unsigned cache_hash;
+    // Non-zero if the second level of the MatchedPropertiesCache was looked
+    // up, in which case |cached_matched_properties| comes from there.
+    unsigned non_inherited_cache_hash;
     Member<const CachedMatchedProperties> cached_matched_properties;
 
     CacheSuccess(bool is_inherited_cache_hit,
                  bool is_non_inherited_cache_hit,
                  unsigned cache_hash,
+                 unsigned non_inherited_cache_hash,
                  const CachedMatchedProperties* cached_matched_properties)
         : is_inherited_cache_hit(is_inherited_cache_hit),
           is_non_inherited_cache_hit(is_non_inherited_cache_hit),
           cache_hash(cache_hash),
+          non_inherited_cache_hash(non_inherited_cache_hash),
           cached_matched_properties(cached_matched_properties) {}
 
     bool IsFullCacheHit() const {
@@ -36,8 +36,10 @@ namespace blink {
 
 void StyleResolverStats::Reset() {
   matched_property_apply = 0;
+  matched_property_cache_lookup = 0;
   matched_property_cache_hit = 0;
   matched_property_cache_inherited_hit = 0;
+  matched_property_cache_non_inherited_hit = 0;
   matched_property_cache_added = 0;
   rules_fast_rejected = 0;
   rules_rejected = 0;
@@ -50,15 +52,27 @@ void StyleResolverStats::Reset() {
   base_styles_used = 0;
   independent_inherited_styles_propagated = 0;
   custom_properties_applied = 0;
+  independent_subtrees_styled = 0;
+  elements_styled_in_independent_subtrees = 0;
 }
 
 std::unique_ptr<TracedValue> StyleResolverStats::ToTracedValue() const {
   std::unique_ptr<TracedValue> traced_value = TracedValue::Create();
   traced_value->SetInteger("matchedPropertyApply", matched_property_apply);
+  traced_value->SetInteger("matchedPropertyCacheLookup",
+                           matched_property_cache_lookup);
   traced_value->SetInteger("matchedPropertyCacheHit",
                            matched_property_cache_hit);
   traced_value->SetInteger("matchedPropertyCacheInheritedHit",
                            matched_property_cache_inherited_hit);
+  traced_value->SetInteger("matchedPropertyCacheNonInheritedHit",
+                           matched_property_cache_non_inherited_hit);
+  traced_value->SetDouble(
+      "matchedPropertyCacheHitRate",
+      matched_property_cache_lookup
+          ? static_cast<double>(matched_property_cache_hit) /
+                matched_property_cache_lookup
+          : 0);
   traced_value->SetInteger("matchedPropertyCacheAdded",
                            matched_property_cache_added);
   traced_value->SetInteger("rulesRejected", rules_rejected);
@@ -74,6 +88,10 @@ std::unique_ptr<TracedValue> StyleResolverStats::ToTracedValue() const {
                            independent_inherited_styles_propagated);
   traced_value->SetInteger("customPropertiesApplied",
                            custom_properties_applied);
+  traced_value->SetInteger("independentSubtreesStyled",
+                           independent_subtrees_styled);
+  traced_value->SetInteger("elementsStyledInIndependentSubtrees",
+                           elements_styled_in_independent_subtrees);
   return traced_value;
 }
 
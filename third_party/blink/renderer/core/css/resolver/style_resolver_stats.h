@@ -51,8 +51,13 @@ class StyleResolverStats {
   std::unique_ptr<TracedValue> ToTracedValue() const;
 
   unsigned matched_property_apply;
+  // Lookups in the MatchedPropertiesCache, and the hits in either of its
+  // levels. Hits in the second level, keyed on the declarations of
+  // non-inherited properties, are also counted separately.
+  unsigned matched_property_cache_lookup;
   unsigned matched_property_cache_hit;
   unsigned matched_property_cache_inherited_hit;
+  unsigned matched_property_cache_non_inherited_hit;
   unsigned matched_property_cache_added;
   unsigned rules_fast_rejected;
   unsigned rules_rejected;
@@ -65,6 +70,11 @@ class StyleResolverStats {
   unsigned base_styles_used;
   unsigned independent_inherited_styles_propagated;
   unsigned custom_properties_applied;
+  // Children subtrees which could have been styled independently of their
+  // siblings, and the elements styled in them. See
+  // ContainerNode::RecalcDescendantStyles().
+  unsigned independent_subtrees_styled;
+  unsigned elements_styled_in_independent_subtrees;
 
  private:
   StyleResolverStats() { Reset(); }
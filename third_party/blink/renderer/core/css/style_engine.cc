@@ -1056,7 +1056,8 @@ void StyleEngine::ScheduleTypeRuleSetInvalidations(
 
 void StyleEngine::InvalidateStyle() {
   StyleInvalidator style_invalidator(
-      pending_invalidations_.GetPendingInvalidationMap());
+      pending_invalidations_.GetPendingInvalidationMap(),
+      element_feature_filter_);
   style_invalidator.Invalidate(*document_);
 }
 
@@ -38,6 +38,7 @@
 #include "third_party/blink/renderer/core/css/active_style_sheets.h"
 #include "third_party/blink/renderer/core/css/css_global_rule_set.h"
 #include "third_party/blink/renderer/core/css/document_style_sheet_collection.h"
+#include "third_party/blink/renderer/core/css/invalidation/element_feature_filter.h"
 #include "third_party/blink/renderer/core/css/invalidation/pending_invalidations.h"
 #include "third_party/blink/renderer/core/css/invalidation/style_invalidator.h"
 #include "third_party/blink/renderer/core/css/resolver/style_resolver.h"
@@ -220,6 +221,9 @@ class CORE_EXPORT StyleEngine final
   PendingInvalidations& GetPendingNodeInvalidations() {
     return pending_invalidations_;
   }
+  ElementFeatureFilter& GetElementFeatureFilter() {
+    return element_feature_filter_;
+  }
   // Push all pending invalidations on the document.
   void InvalidateStyle();
   bool MediaQueryAffectedByViewportChange();
@@ -451,6 +455,7 @@ class CORE_EXPORT StyleEngine final
   Member<MediaQueryEvaluator> media_query_evaluator_;
   Member<CSSGlobalRuleSet> global_rule_set_;
   PendingInvalidations pending_invalidations_;
+  ElementFeatureFilter element_feature_filter_;
 
   // This is a set of rendered elements which had one or more of its rendered
   // children removed since the last lifecycle update. For such elements we need
@@ -15,6 +15,7 @@
 #include "third_party/blink/renderer/core/css/parser/css_parser_context.h"
 #include "third_party/blink/renderer/core/css/style_sheet_contents.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
 #include "third_party/blink/renderer/core/dom/node_computed_style.h"
 #include "third_party/blink/renderer/core/dom/shadow_root.h"
 #include "third_party/blink/renderer/core/dom/shadow_root_init.h"
@@ -1498,6 +1499,161 @@ TEST_F(StyleEngineTest, RejectSelectorForPseudoElement) {
   EXPECT_EQ(2u, stats->rules_fast_rejected);
 }
 
+TEST_F(StyleEngineTest, CountIndependentSubtrees) {
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <style>
+      .structural:first-child { color: red }
+    </style>
+    <div id=independent><span></span><span><b></b></span></div>
+    <div id=structural>
+      <span class=structural></span><span class=structural></span>
+    </div>
+  )HTML");
+  GetDocument().View()->UpdateAllLifecyclePhases();
+
+  StyleEngine& engine = GetDocument().GetStyleEngine();
+  engine.SetStatsEnabled(true);
+
+  StyleResolverStats* stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  Element* independent = GetDocument().getElementById("independent");
+  Element* structural = GetDocument().getElementById("structural");
+  ASSERT_TRUE(independent);
+  ASSERT_TRUE(structural);
+  for (Element* span = ElementTraversal::FirstChild(*independent); span;
+       span = ElementTraversal::NextSibling(*span)) {
+    span->SetInlineStyleProperty(CSSPropertyColor, "green");
+  }
+  for (Element* span = ElementTraversal::FirstChild(*structural); span;
+       span = ElementTraversal::NextSibling(*span)) {
+    span->SetInlineStyleProperty(CSSPropertyColor, "green");
+  }
+
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kInStyleRecalc);
+  independent->RecalcStyle(kNoChange);
+  structural->RecalcStyle(kNoChange);
+
+  // Only the subtrees of the spans below #independent, whose styles don't
+  // depend on their siblings, count.
+  EXPECT_EQ(2u, stats->independent_subtrees_styled);
+  EXPECT_EQ(stats->elements_styled - 2u,
+            stats->elements_styled_in_independent_subtrees);
+}
+
+TEST_F(StyleEngineTest, MatchedPropertiesCacheNonInheritedHit) {
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <style>
+      .box { width: 100px; margin-inline-start: 10px }
+      .red { color: red }
+      .green { color: green }
+      .rtl { direction: rtl }
+    </style>
+    <div id=container>
+      <span class=box></span><span class=box></span><span class=box></span>
+    </div>
+  )HTML");
+  GetDocument().View()->UpdateAllLifecyclePhases();
+
+  StyleEngine& engine = GetDocument().GetStyleEngine();
+  engine.SetStatsEnabled(true);
+
+  StyleResolverStats* stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  Element* container = GetDocument().getElementById("container");
+  ASSERT_TRUE(container);
+  Element* red = ElementTraversal::FirstChild(*container);
+  Element* green = ElementTraversal::NextSibling(*red);
+  Element* rtl = ElementTraversal::NextSibling(*green);
+  red->setAttribute(HTMLNames::classAttr, "box red");
+  green->setAttribute(HTMLNames::classAttr, "box green");
+  rtl->setAttribute(HTMLNames::classAttr, "box rtl");
+
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kInStyleRecalc);
+  container->RecalcStyle(kNoChange);
+
+  // The second span reuses the non-inherited properties of the first one. The
+  // last one can't, as its direction maps margin-inline-start differently.
+  EXPECT_EQ(3u, stats->matched_property_cache_lookup);
+  EXPECT_EQ(1u, stats->matched_property_cache_hit);
+  EXPECT_EQ(1u, stats->matched_property_cache_non_inherited_hit);
+
+  EXPECT_EQ(Length(100, kFixed), green->GetComputedStyle()->Width());
+  EXPECT_EQ(Length(10, kFixed), green->GetComputedStyle()->MarginLeft());
+  EXPECT_EQ(MakeRGB(0, 128, 0),
+            green->GetComputedStyle()->VisitedDependentColor(
+                GetCSSPropertyColor()));
+  EXPECT_EQ(Length(10, kFixed), rtl->GetComputedStyle()->MarginRight());
+  EXPECT_TRUE(rtl->GetComputedStyle()->MarginLeft().IsZero());
+}
+
+TEST_F(StyleEngineTest, ElementFeatureFilter) {
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <div id=first class="a b"></div><div id=second></div>
+  )HTML");
+
+  const ElementFeatureFilter& filter =
+      GetDocument().GetStyleEngine().GetElementFeatureFilter();
+  EXPECT_TRUE(filter.MayContainId("first"));
+  EXPECT_TRUE(filter.MayContainClass("a"));
+  EXPECT_TRUE(filter.MayContainClass("b"));
+  EXPECT_FALSE(filter.MayContainClass("c"));
+
+  Element* first = GetDocument().getElementById("first");
+  Element* second = GetDocument().getElementById("second");
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  first->setAttribute(HTMLNames::classAttr, "b c");
+  EXPECT_FALSE(filter.MayContainClass("a"));
+  EXPECT_TRUE(filter.MayContainClass("b"));
+  EXPECT_TRUE(filter.MayContainClass("c"));
+
+  first->setAttribute(HTMLNames::idAttr, "renamed");
+  EXPECT_FALSE(filter.MayContainId("first"));
+  EXPECT_TRUE(filter.MayContainId("renamed"));
+
+  second->CloneAttributesFrom(*first);
+  first->remove();
+  EXPECT_TRUE(filter.MayContainId("renamed"));
+  EXPECT_TRUE(filter.MayContainClass("c"));
+  EXPECT_FALSE(filter.MayContainId("second"));
+
+  second->remove();
+  EXPECT_FALSE(filter.MayContainId("renamed"));
+  EXPECT_FALSE(filter.MayContainClass("b"));
+  EXPECT_FALSE(filter.MayContainClass("c"));
+}
+
+TEST_F(StyleEngineTest, CountIndependentSubtreesOnFirstRecalc) {
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <style>
+      .structural:first-child { color: red }
+    </style>
+  )HTML");
+  GetDocument().View()->UpdateAllLifecyclePhases();
+
+  // The structural rule only marks #structural while its children are matched
+  // for the first time.
+  Element* structural = GetDocument().CreateRawElement(HTMLNames::divTag);
+  structural->SetInnerHTMLFromString(
+      "<span class=structural></span><span class=structural></span>");
+  GetDocument().body()->AppendChild(structural);
+
+  StyleEngine& engine = GetDocument().GetStyleEngine();
+  engine.SetStatsEnabled(true);
+
+  StyleResolverStats* stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kInStyleRecalc);
+  structural->RecalcStyle(kNoChange);
+
+  EXPECT_EQ(3u, stats->elements_styled);
+  EXPECT_EQ(0u, stats->independent_subtrees_styled);
+  EXPECT_EQ(0u, stats->elements_styled_in_independent_subtrees);
+}
+
 TEST_F(StyleEngineTest, MarkForWhitespaceReattachment) {
   GetDocument().body()->SetInnerHTMLFromString(R"HTML(
     <div id=d1><span></span></div>
@@ -23,6 +23,7 @@
 #include "third_party/blink/renderer/core/css/css_property_value_set.h"
 #include "third_party/blink/renderer/core/css/css_style_sheet.h"
 #include "third_party/blink/renderer/core/css/parser/css_parser.h"
+#include "third_party/blink/renderer/core/css/parser/css_tokenized_sheet.h"
 #include "third_party/blink/renderer/core/css/style_engine.h"
 #include "third_party/blink/renderer/core/css/style_rule.h"
 #include "third_party/blink/renderer/core/css/style_rule_import.h"
@@ -330,7 +331,7 @@ const AtomicString& StyleSheetContents::NamespaceURIFromPrefix(
 }
 
 void StyleSheetContents::ParseAuthorStyleSheet(
-    const CSSStyleSheetResource* cached_style_sheet,
+    CSSStyleSheetResource* cached_style_sheet,
     const SecurityOrigin* security_origin) {
   TRACE_EVENT1("blink,devtools.timeline", "ParseAuthorStyleSheet", "data",
                InspectorParseAuthorStyleSheetEvent::Data(cached_style_sheet));
@@ -368,8 +369,17 @@ void StyleSheetContents::ParseAuthorStyleSheet(
 
   const CSSParserContext* context =
       CSSParserContext::CreateWithStyleSheetContents(ParserContext(), this);
-  CSSParser::ParseSheet(context, this, sheet_text,
-                        RuntimeEnabledFeatures::LazyParseCSSEnabled());
+  std::unique_ptr<CSSTokenizedSheet> tokenized_sheet;
+  if (!sheet_text.IsEmpty())
+    tokenized_sheet = cached_style_sheet->TakeTokenizedSheet();
+  if (tokenized_sheet) {
+    CSSParser::ParseTokenizedSheet(
+        context, this, std::move(tokenized_sheet),
+        RuntimeEnabledFeatures::LazyParseCSSEnabled());
+  } else {
+    CSSParser::ParseSheet(context, this, sheet_text,
+                          RuntimeEnabledFeatures::LazyParseCSSEnabled());
+  }
 
   DEFINE_STATIC_LOCAL(CustomCountHistogram, parse_histogram,
                       ("Style.AuthorStyleSheet.ParseTime", 0, 10000000, 50));
@@ -70,8 +70,7 @@ class CORE_EXPORT StyleSheetContents
   const AtomicString& DefaultNamespace() const { return default_namespace_; }
   const AtomicString& NamespaceURIFromPrefix(const AtomicString& prefix) const;
 
-  void ParseAuthorStyleSheet(const CSSStyleSheetResource*,
-                             const SecurityOrigin*);
+  void ParseAuthorStyleSheet(CSSStyleSheetResource*, const SecurityOrigin*);
   void ParseString(const String&);
   void ParseStringAtPosition(const String&, const TextPosition&);
 
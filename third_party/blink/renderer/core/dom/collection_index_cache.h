@@ -66,10 +66,19 @@ class CollectionIndexCache {
   void NodeInserted();
   void NodeRemoved();
 
+  // Updates the cache for |count| nodes inserted into, or removed from, the
+  // collection after the cached node, which keeps its index.
+  void NodesInsertedAfterCachedNode(unsigned count);
+  void NodesRemovedAfterCachedNode(unsigned count);
+
+  ALWAYS_INLINE NodeType* CachedNode() const { return current_node_; }
+  ALWAYS_INLINE bool IsCachedNodeCountValid() const {
+    return is_length_cache_valid_;
+  }
+
   virtual void Trace(blink::Visitor* visitor) { visitor->Trace(current_node_); }
 
  protected:
-  ALWAYS_INLINE NodeType* CachedNode() const { return current_node_; }
   ALWAYS_INLINE unsigned CachedNodeIndex() const {
     DCHECK(CachedNode());
     return cached_node_index_;
@@ -80,9 +89,6 @@ class CollectionIndexCache {
     cached_node_index_ = index;
   }
 
-  ALWAYS_INLINE bool IsCachedNodeCountValid() const {
-    return is_length_cache_valid_;
-  }
   ALWAYS_INLINE unsigned CachedNodeCount() const { return cached_node_count_; }
   ALWAYS_INLINE void SetCachedNodeCount(unsigned length) {
     cached_node_count_ = length;
@@ -124,6 +130,23 @@ void CollectionIndexCache<Collection, NodeType>::NodeRemoved() {
   current_node_ = nullptr;
 }
 
+template <typename Collection, typename NodeType>
+void CollectionIndexCache<Collection, NodeType>::NodesInsertedAfterCachedNode(
+    unsigned count) {
+  if (IsCachedNodeCountValid())
+    cached_node_count_ += count;
+}
+
+template <typename Collection, typename NodeType>
+void CollectionIndexCache<Collection, NodeType>::NodesRemovedAfterCachedNode(
+    unsigned count) {
+  if (!IsCachedNodeCountValid())
+    return;
+  DCHECK_GE(cached_node_count_, count);
+  DCHECK(!CachedNode() || CachedNodeIndex() < cached_node_count_ - count);
+  cached_node_count_ -= count;
+}
+
 template <typename Collection, typename NodeType>
 inline unsigned CollectionIndexCache<Collection, NodeType>::NodeCount(
     const Collection& collection) {
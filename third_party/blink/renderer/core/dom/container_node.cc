@@ -23,6 +23,7 @@
 
 #include "third_party/blink/renderer/core/dom/container_node.h"
 
+#include "third_party/blink/renderer/core/css/resolver/style_resolver_stats.h"
 #include "third_party/blink/renderer/core/css/selector_query.h"
 #include "third_party/blink/renderer/core/css/style_change_reason.h"
 #include "third_party/blink/renderer/core/css/style_engine.h"
@@ -38,6 +39,7 @@
 #include "third_party/blink/renderer/core/dom/node_lists_node_data.h"
 #include "third_party/blink/renderer/core/dom/node_rare_data.h"
 #include "third_party/blink/renderer/core/dom/node_traversal.h"
+#include "third_party/blink/renderer/core/dom/nth_index_cache.h"
 #include "third_party/blink/renderer/core/dom/shadow_root.h"
 #include "third_party/blink/renderer/core/dom/slot_assignment_recalc_forbidden_scope.h"
 #include "third_party/blink/renderer/core/dom/static_node_list.h"
@@ -1004,6 +1006,9 @@ void ContainerNode::DetachLayoutTree(const AttachContext& context) {
 void ContainerNode::ChildrenChanged(const ChildrenChange& change) {
   GetDocument().IncDOMTreeVersion();
   GetDocument().NotifyChangeChildren(*this);
+  if (NthIndexCacheStore* nth_index_cache_store =
+          GetDocument().GetNthIndexCacheStore())
+    nth_index_cache_store->ChildrenChanged(*this, change);
   InvalidateNodeListCachesInAncestors(nullptr, nullptr, &change);
   if (!ChildNeedsStyleRecalc() && change.IsChildInsertion() &&
       change.sibling_changed->NeedsStyleRecalc()) {
@@ -1389,15 +1394,46 @@ void ContainerNode::RecalcDescendantStyles(StyleRecalcChange change) {
   DCHECK(change >= kUpdatePseudoElements || ChildNeedsStyleRecalc());
   DCHECK(!NeedsStyleRecalc());
 
+  // When no rule makes the styles of the children depend on their siblings,
+  // each child's subtree could be styled independently of the others. Count
+  // how much of the recalc happens in the outermost such subtrees, to see how
+  // much of it could be spread over threads.
+  StyleResolverStats* stats = GetDocument().GetStyleEngine().Stats();
+  unsigned independent_subtrees_styled = 0;
+  unsigned elements_styled_in_independent_subtrees = 0;
+  if (stats) {
+    independent_subtrees_styled = stats->independent_subtrees_styled;
+    elements_styled_in_independent_subtrees =
+        stats->elements_styled_in_independent_subtrees;
+  }
+  unsigned children_styled = 0;
+  unsigned elements_styled_in_children = 0;
+
   for (Node* child = lastChild(); child; child = child->previousSibling()) {
     if (child->IsTextNode()) {
       ToText(child)->RecalcTextStyle(change);
     } else if (child->IsElementNode()) {
       Element* element = ToElement(child);
-      if (element->ShouldCallRecalcStyle(change))
-        element->RecalcStyle(change);
+      if (!element->ShouldCallRecalcStyle(change))
+        continue;
+      unsigned elements_styled = stats ? stats->elements_styled : 0;
+      element->RecalcStyle(change);
+      if (stats && stats->elements_styled != elements_styled) {
+        children_styled++;
+        elements_styled_in_children += stats->elements_styled - elements_styled;
+      }
     }
   }
+
+  // Matching the children sets the structural flag, so it can only be checked
+  // now. The children's subtrees replace the ones counted inside of them.
+  if (stats && !HasRestyleFlag(
+                   DynamicRestyleFlags::kChildrenAffectedByStructuralRules)) {
+    stats->independent_subtrees_styled =
+        independent_subtrees_styled + children_styled;
+    stats->elements_styled_in_independent_subtrees =
+        elements_styled_in_independent_subtrees + elements_styled_in_children;
+  }
 }
 
 void ContainerNode::RebuildLayoutTreeForChild(
@@ -1569,8 +1605,12 @@ void ContainerNode::InvalidateNodeListCachesInAncestors(
   GetDocument().InvalidateNodeListCaches(attr_name);
 
   for (ContainerNode* node = this; node; node = node->parentNode()) {
-    if (NodeListsNodeData* lists = node->NodeLists())
-      lists->InvalidateCaches(attr_name);
+    if (NodeListsNodeData* lists = node->NodeLists()) {
+      if (change)
+        lists->InvalidateCachesForChildrenChange(*this, *change);
+      else
+        lists->InvalidateCaches(attr_name);
+    }
   }
 }
 
@@ -7056,6 +7056,12 @@ AnimationClock& Document::GetAnimationClock() {
   return GetPage()->Animator().Clock();
 }
 
+NthIndexCacheStore& Document::EnsureNthIndexCacheStore() {
+  if (!nth_index_cache_store_)
+    nth_index_cache_store_ = new NthIndexCacheStore();
+  return *nth_index_cache_store_;
+}
+
 Document& Document::EnsureTemplateDocument() {
   if (IsTemplateDocument())
     return *this;
@@ -7464,6 +7470,7 @@ void Document::Trace(blink::Visitor* visitor) {
   visitor->Trace(node_iterators_);
   visitor->Trace(ranges_);
   visitor->Trace(style_engine_);
+  visitor->Trace(nth_index_cache_store_);
   visitor->Trace(form_controller_);
   visitor->Trace(visited_link_state_);
   visitor->Trace(element_computed_style_map_);
@@ -148,6 +148,7 @@ class MediaQueryListListener;
 class MediaQueryMatcher;
 class NodeIterator;
 class NthIndexCache;
+class NthIndexCacheStore;
 class OriginAccessEntry;
 class Page;
 class PendingAnimations;
@@ -1314,6 +1315,10 @@ class CORE_EXPORT Document : public ContainerNode,
   }
 
   NthIndexCache* GetNthIndexCache() const { return nth_index_cache_; }
+  NthIndexCacheStore* GetNthIndexCacheStore() const {
+    return nth_index_cache_store_;
+  }
+  NthIndexCacheStore& EnsureNthIndexCacheStore();
 
   bool IsSecureContext(String& error_message) const override;
   bool IsSecureContext() const override;
@@ -1782,6 +1787,7 @@ class CORE_EXPORT Document : public ContainerNode,
   // the cache object's references will be traced by a stack walk.
   GC_PLUGIN_IGNORE("461878")
   NthIndexCache* nth_index_cache_ = nullptr;
+  Member<NthIndexCacheStore> nth_index_cache_store_;
 
   DocumentClassFlags document_classes_;
 
@@ -1735,6 +1735,12 @@ void Element::AttributeChanged(const AttributeModificationParams& params) {
         params.new_value, GetDocument().InQuirksMode());
     if (new_id != old_id) {
       GetElementData()->SetIdForStyleResolution(new_id);
+      if (isConnected()) {
+        ElementFeatureFilter& feature_filter =
+            GetDocument().GetStyleEngine().GetElementFeatureFilter();
+        feature_filter.RemoveId(old_id);
+        feature_filter.AddId(new_id);
+      }
       GetDocument().GetStyleEngine().IdChangedForElement(old_id, new_id, *this);
     }
   } else if (name == classAttr) {
@@ -1835,6 +1841,11 @@ void Element::ClassAttributeChanged(const AtomicString& new_class_string) {
   ClassStringContent class_string_content_type =
       ClassStringHasClassName(new_class_string);
   const bool should_fold_case = GetDocument().InQuirksMode();
+  ElementFeatureFilter* feature_filter =
+      isConnected() ? &GetDocument().GetStyleEngine().GetElementFeatureFilter()
+                    : nullptr;
+  if (feature_filter)
+    feature_filter->RemoveClasses(GetElementData()->ClassNames());
   if (class_string_content_type == ClassStringContent::kHasClasses) {
     const SpaceSplitString old_classes = GetElementData()->ClassNames();
     GetElementData()->SetClass(new_class_string, should_fold_case);
@@ -1849,6 +1860,8 @@ void Element::ClassAttributeChanged(const AtomicString& new_class_string) {
     else
       GetElementData()->ClearClass();
   }
+  if (feature_filter)
+    feature_filter->AddClasses(GetElementData()->ClassNames());
 }
 
 bool Element::ShouldInvalidateDistributionWhenAttributeChanged(
@@ -2020,6 +2033,9 @@ Node::InsertionNotificationRequest Element::InsertedInto(
 
   DCHECK(!HasRareData() || !GetElementRareData()->HasPseudoElements());
 
+  if (insertion_point.isConnected())
+    GetDocument().GetStyleEngine().GetElementFeatureFilter().AddElement(*this);
+
   if (!insertion_point.IsInTreeScope())
     return kInsertionDone;
 
@@ -2059,6 +2075,10 @@ Node::InsertionNotificationRequest Element::InsertedInto(
 
 void Element::RemovedFrom(ContainerNode& insertion_point) {
   bool was_in_document = insertion_point.isConnected();
+  if (was_in_document) {
+    GetDocument().GetStyleEngine().GetElementFeatureFilter().RemoveElement(
+        *this);
+  }
   if (HasRareData()) {
     // If we detached the layout tree with LazyReattachIfAttached, we might not
     // have cleared the pseudo elements if we remove the element before calling
@@ -4778,6 +4798,16 @@ void Element::CloneAttributesFrom(const Element& other) {
     DetachAllAttrNodesFromElement();
 
   other.SynchronizeAllAttributes();
+
+  // The element data is replaced before the AttributeChanged() calls below,
+  // which then see the new class names and id as the old ones. Account for
+  // the replacement here instead.
+  ElementFeatureFilter* feature_filter =
+      isConnected() ? &GetDocument().GetStyleEngine().GetElementFeatureFilter()
+                    : nullptr;
+  if (feature_filter)
+    feature_filter->RemoveElement(*this);
+
   if (!other.element_data_) {
     element_data_.Clear();
     return;
@@ -4821,6 +4851,9 @@ void Element::CloneAttributesFrom(const Element& other) {
   else
     element_data_ = other.element_data_->MakeUniqueCopy();
 
+  if (feature_filter)
+    feature_filter->AddElement(*this);
+
   for (const Attribute& attr : element_data_->Attributes()) {
     AttributeChanged(
         AttributeModificationParams(attr.GetName(), g_null_atom, attr.Value(),
@@ -36,6 +36,15 @@ void LiveNodeListBase::InvalidateCacheForAttribute(
     ToHTMLCollection(this)->InvalidateCacheForAttribute(attr_name);
 }
 
+void LiveNodeListBase::InvalidateCacheForChildrenChange(
+    const ContainerNode& parent,
+    const ContainerNode::ChildrenChange& change) const {
+  if (IsLiveNodeListType(GetType()))
+    ToLiveNodeList(this)->InvalidateCache();
+  else
+    ToHTMLCollection(this)->InvalidateCacheForChildrenChange(parent, change);
+}
+
 ContainerNode& LiveNodeListBase::RootNode() const {
   if (IsRootedAtTreeScope() && owner_node_->IsInTreeScope())
     return owner_node_->ContainingTreeScope().RootNode();
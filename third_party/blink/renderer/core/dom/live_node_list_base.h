@@ -73,6 +73,11 @@ class CORE_EXPORT LiveNodeListBase : public GarbageCollectedMixin {
 
   virtual void InvalidateCache(Document* old_document = nullptr) const = 0;
   void InvalidateCacheForAttribute(const QualifiedName*) const;
+  // Called for a change to the children of |parent|, which is an inclusive
+  // descendant of the owner node.
+  void InvalidateCacheForChildrenChange(
+      const ContainerNode& parent,
+      const ContainerNode::ChildrenChange&) const;
 
   static bool ShouldInvalidateTypeOnAttributeChange(NodeListInvalidationType,
                                                     const QualifiedName&);
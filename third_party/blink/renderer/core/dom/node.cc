@@ -54,6 +54,7 @@
 #include "third_party/blink/renderer/core/dom/node_lists_node_data.h"
 #include "third_party/blink/renderer/core/dom/node_rare_data.h"
 #include "third_party/blink/renderer/core/dom/node_traversal.h"
+#include "third_party/blink/renderer/core/dom/nth_index_cache.h"
 #include "third_party/blink/renderer/core/dom/processing_instruction.h"
 #include "third_party/blink/renderer/core/dom/range.h"
 #include "third_party/blink/renderer/core/dom/shadow_root.h"
@@ -2013,6 +2014,9 @@ void Node::DidMoveToNewDocument(Document& old_document) {
   }
 
   old_document.Markers().RemoveMarkersForNode(this);
+  if (NthIndexCacheStore* nth_index_cache_store =
+          old_document.GetNthIndexCacheStore())
+    nth_index_cache_store->NodeMovedToNewDocument(*this);
   if (GetDocument().GetPage() &&
       GetDocument().GetPage() != old_document.GetPage()) {
     GetDocument().GetFrame()->GetEventHandlerRegistry().DidMoveIntoPage(*this);
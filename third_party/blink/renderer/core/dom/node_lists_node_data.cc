@@ -45,6 +45,16 @@ void NodeListsNodeData::InvalidateCaches(const QualifiedName* attr_name) {
     cache.value->InvalidateCache();
 }
 
+void NodeListsNodeData::InvalidateCachesForChildrenChange(
+    const ContainerNode& parent,
+    const ContainerNode::ChildrenChange& change) {
+  for (const auto& cache : atomic_name_caches_)
+    cache.value->InvalidateCacheForChildrenChange(parent, change);
+
+  for (auto& cache : tag_collection_ns_caches_)
+    cache.value->InvalidateCacheForChildrenChange(parent, change);
+}
+
 void NodeListsNodeData::Trace(blink::Visitor* visitor) {
   visitor->Trace(child_node_list_);
   visitor->Trace(atomic_name_caches_);
@@ -35,6 +35,13 @@ namespace {
 
 const unsigned kCachedSiblingCountLimit = 32;
 
+// The frequency at which we cache the nth-index for a set of siblings.  A
+// spread value of 3 means every third Element (of its type, for nth-of-type)
+// will have its nth-index cached. Using a spread value > 1 is done to save
+// memory. Looking up the nth-index will still be done in constant time in
+// terms of sibling count, at most 'spread' elements will be traversed.
+const unsigned kSpread = 3;
+
 unsigned UncachedNthChildIndex(Element& element) {
   int index = 1;
   for (const Element* sibling = ElementTraversal::PreviousSibling(element);
@@ -78,16 +85,21 @@ unsigned UncachedNthLastOfTypeIndex(Element& element, unsigned& sibling_count) {
 
 }  // namespace
 
+NthIndexData* NthIndexCache::NthIndexDataForParent(Element& element) {
+  DCHECK(element.parentNode());
+  NthIndexCacheStore* store = element.GetDocument().GetNthIndexCacheStore();
+  if (!store)
+    return nullptr;
+  return store->parent_map_.at(element.parentNode());
+}
+
 unsigned NthIndexCache::NthChildIndex(Element& element) {
   if (element.IsPseudoElement() || !element.parentNode())
     return 1;
-  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
-  NthIndexData* nth_index_data = nullptr;
-  if (nth_index_cache && nth_index_cache->parent_map_)
-    nth_index_data = nth_index_cache->parent_map_->at(element.parentNode());
-  if (nth_index_data)
+  if (NthIndexData* nth_index_data = NthIndexDataForParent(element))
     return nth_index_data->NthIndex(element);
   unsigned index = UncachedNthChildIndex(element);
+  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
   if (nth_index_cache && index > kCachedSiblingCountLimit)
     nth_index_cache->CacheNthIndexDataForParent(element);
   return index;
@@ -96,23 +108,22 @@ unsigned NthIndexCache::NthChildIndex(Element& element) {
 unsigned NthIndexCache::NthLastChildIndex(Element& element) {
   if (element.IsPseudoElement() && !element.parentNode())
     return 1;
-  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
-  NthIndexData* nth_index_data = nullptr;
-  if (nth_index_cache && nth_index_cache->parent_map_)
-    nth_index_data = nth_index_cache->parent_map_->at(element.parentNode());
-  if (nth_index_data)
+  if (NthIndexData* nth_index_data = NthIndexDataForParent(element))
     return nth_index_data->NthLastIndex(element);
   unsigned index = UncachedNthLastChildIndex(element);
+  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
   if (nth_index_cache && index > kCachedSiblingCountLimit)
     nth_index_cache->CacheNthIndexDataForParent(element);
   return index;
 }
 
-NthIndexData* NthIndexCache::NthTypeIndexDataForParent(Element& element) const {
+NthIndexData* NthIndexCache::NthTypeIndexDataForParent(Element& element) {
   DCHECK(element.parentNode());
-  if (!parent_map_for_type_)
+  NthIndexCacheStore* store = element.GetDocument().GetNthIndexCacheStore();
+  if (!store)
     return nullptr;
-  if (const IndexByType* map = parent_map_for_type_->at(element.parentNode()))
+  if (const IndexByType* map =
+          store->parent_map_for_type_.at(element.parentNode()))
     return map->at(element.tagName());
   return nullptr;
 }
@@ -120,14 +131,11 @@ NthIndexData* NthIndexCache::NthTypeIndexDataForParent(Element& element) const {
 unsigned NthIndexCache::NthOfTypeIndex(Element& element) {
   if (element.IsPseudoElement() || !element.parentNode())
     return 1;
-  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
-  if (nth_index_cache) {
-    if (NthIndexData* nth_index_data =
-            nth_index_cache->NthTypeIndexDataForParent(element))
-      return nth_index_data->NthOfTypeIndex(element);
-  }
+  if (NthIndexData* nth_index_data = NthTypeIndexDataForParent(element))
+    return nth_index_data->NthOfTypeIndex(element);
   unsigned sibling_count = 0;
   unsigned index = UncachedNthOfTypeIndex(element, sibling_count);
+  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
   if (nth_index_cache && sibling_count > kCachedSiblingCountLimit)
     nth_index_cache->CacheNthOfTypeIndexDataForParent(element);
   return index;
@@ -136,14 +144,11 @@ unsigned NthIndexCache::NthOfTypeIndex(Element& element) {
 unsigned NthIndexCache::NthLastOfTypeIndex(Element& element) {
   if (element.IsPseudoElement() || !element.parentNode())
     return 1;
-  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
-  if (nth_index_cache) {
-    if (NthIndexData* nth_index_data =
-            nth_index_cache->NthTypeIndexDataForParent(element))
-      return nth_index_data->NthLastOfTypeIndex(element);
-  }
+  if (NthIndexData* nth_index_data = NthTypeIndexDataForParent(element))
+    return nth_index_data->NthLastOfTypeIndex(element);
   unsigned sibling_count = 0;
   unsigned index = UncachedNthLastOfTypeIndex(element, sibling_count);
+  NthIndexCache* nth_index_cache = element.GetDocument().GetNthIndexCache();
   if (nth_index_cache && sibling_count > kCachedSiblingCountLimit)
     nth_index_cache->CacheNthOfTypeIndexDataForParent(element);
   return index;
@@ -151,22 +156,22 @@ unsigned NthIndexCache::NthLastOfTypeIndex(Element& element) {
 
 void NthIndexCache::CacheNthIndexDataForParent(Element& element) {
   DCHECK(element.parentNode());
-  if (!parent_map_)
-    parent_map_ = new ParentMap();
+  if (!store_)
+    store_ = &document_->EnsureNthIndexCacheStore();
 
-  ParentMap::AddResult add_result =
-      parent_map_->insert(element.parentNode(), nullptr);
+  NthIndexCacheStore::ParentMap::AddResult add_result =
+      store_->parent_map_.insert(element.parentNode(), nullptr);
   DCHECK(add_result.is_new_entry);
   add_result.stored_value->value = new NthIndexData(*element.parentNode());
 }
 
 NthIndexCache::IndexByType& NthIndexCache::EnsureTypeIndexMap(
     ContainerNode& parent) {
-  if (!parent_map_for_type_)
-    parent_map_for_type_ = new ParentMapForType();
+  if (!store_)
+    store_ = &document_->EnsureNthIndexCacheStore();
 
-  ParentMapForType::AddResult add_result =
-      parent_map_for_type_->insert(&parent, nullptr);
+  NthIndexCacheStore::ParentMapForType::AddResult add_result =
+      store_->parent_map_for_type_.insert(&parent, nullptr);
   if (add_result.is_new_entry)
     add_result.stored_value->value = new IndexByType();
 
@@ -183,6 +188,47 @@ void NthIndexCache::CacheNthOfTypeIndexDataForParent(Element& element) {
       new NthIndexData(*element.parentNode(), element.TagQName());
 }
 
+void NthIndexCacheStore::ChildrenChanged(
+    ContainerNode& parent,
+    const ContainerNode::ChildrenChange& change) {
+  if (change.type == ContainerNode::kAllChildrenRemoved) {
+    parent_map_.erase(&parent);
+    parent_map_for_type_.erase(&parent);
+    return;
+  }
+  if (!change.IsChildElementChange())
+    return;
+
+  Element& element = ToElement(*change.sibling_changed);
+  auto update = [&change, &element](NthIndexData& data) {
+    if (change.type == ContainerNode::kElementInserted)
+      return data.SiblingInserted(element);
+    return data.SiblingRemoved(element, change.sibling_before_change);
+  };
+
+  auto it = parent_map_.find(&parent);
+  if (it != parent_map_.end() && !update(*it->value))
+    parent_map_.erase(it);
+
+  auto type_it = parent_map_for_type_.find(&parent);
+  if (type_it == parent_map_for_type_.end())
+    return;
+  IndexByType& index_by_type = *type_it->value;
+  auto data_it = index_by_type.find(element.tagName());
+  if (data_it != index_by_type.end() && !update(*data_it->value))
+    index_by_type.erase(data_it);
+}
+
+void NthIndexCacheStore::NodeMovedToNewDocument(Node& node) {
+  parent_map_.erase(&node);
+  parent_map_for_type_.erase(&node);
+}
+
+void NthIndexCacheStore::Trace(blink::Visitor* visitor) {
+  visitor->Trace(parent_map_);
+  visitor->Trace(parent_map_for_type_);
+}
+
 unsigned NthIndexData::NthIndex(Element& element) const {
   DCHECK(!element.IsPseudoElement());
 
@@ -219,45 +265,110 @@ unsigned NthIndexData::NthLastOfTypeIndex(Element& element) const {
   return count_ - NthOfTypeIndex(element) + 1;
 }
 
-NthIndexData::NthIndexData(ContainerNode& parent) {
-  // The frequency at which we cache the nth-index for a set of siblings.  A
-  // spread value of 3 means every third Element will have its nth-index cached.
-  // Using a spread value > 1 is done to save memory. Looking up the nth-index
-  // will still be done in constant time in terms of sibling count, at most
-  // 'spread' elements will be traversed.
-  const unsigned kSpread = 3;
+NthIndexData::NthIndexData(ContainerNode& parent)
+    : type_(QualifiedName::Null()) {
   unsigned count = 0;
   for (Element* sibling = ElementTraversal::FirstChild(parent); sibling;
        sibling = ElementTraversal::NextSibling(*sibling)) {
-    if (!(++count % kSpread))
+    if (!(++count % kSpread)) {
       element_index_map_.insert(sibling, count);
+      last_cached_sibling_ = sibling;
+    }
   }
   DCHECK(count);
   count_ = count;
 }
 
-NthIndexData::NthIndexData(ContainerNode& parent, const QualifiedName& type) {
-  // The frequency at which we cache the nth-index of type for a set of
-  // siblings.  A spread value of 3 means every third Element of its type will
-  // have its nth-index cached.  Using a spread value > 1 is done to save
-  // memory. Looking up the nth-index of its type will still be done in less
-  // time, as most number of elements traversed will be equal to find 'spread'
-  // elements in the sibling set.
-  const unsigned kSpread = 3;
+NthIndexData::NthIndexData(ContainerNode& parent, const QualifiedName& type)
+    : type_(type) {
   unsigned count = 0;
   for (Element* sibling =
            ElementTraversal::FirstChild(parent, HasTagName(type));
        sibling;
        sibling = ElementTraversal::NextSibling(*sibling, HasTagName(type))) {
-    if (!(++count % kSpread))
+    if (!(++count % kSpread)) {
       element_index_map_.insert(sibling, count);
+      last_cached_sibling_ = sibling;
+    }
   }
   DCHECK(count);
   count_ = count;
 }
 
+bool NthIndexData::Counts(const Element& element) const {
+  return type_ == QualifiedName::Null() || element.HasTagName(type_);
+}
+
+Element* NthIndexData::PreviousCountedSibling(const Node& node) const {
+  for (Element* sibling = ElementTraversal::PreviousSibling(node); sibling;
+       sibling = ElementTraversal::PreviousSibling(*sibling)) {
+    if (Counts(*sibling))
+      return sibling;
+  }
+  return nullptr;
+}
+
+Element* NthIndexData::FindCachedSibling(Element* element,
+                                         unsigned& index) const {
+  index = 0;
+  for (; element; element = PreviousCountedSibling(*element), index++) {
+    auto it = element_index_map_.find(element);
+    if (it != element_index_map_.end()) {
+      index += it->value;
+      return element;
+    }
+  }
+  return nullptr;
+}
+
+// The cached indices stay correct as long as siblings are only inserted or
+// removed after the last cached sibling, which is the case when appending to
+// or popping from a list. Then, the closest cached sibling before the changed
+// one is the last one.
+
+bool NthIndexData::SiblingInserted(Element& element) {
+  if (!Counts(element))
+    return true;
+  unsigned previous_index;
+  Element* cached_sibling =
+      FindCachedSibling(PreviousCountedSibling(element), previous_index);
+  if (cached_sibling != last_cached_sibling_)
+    return false;
+  count_++;
+  unsigned index = previous_index + 1;
+  if (!(index % kSpread)) {
+    element_index_map_.insert(&element, index);
+    last_cached_sibling_ = &element;
+  }
+  return true;
+}
+
+bool NthIndexData::SiblingRemoved(Element& element, Node* previous_sibling) {
+  if (!Counts(element))
+    return true;
+  Element* previous = nullptr;
+  if (previous_sibling) {
+    previous = previous_sibling->IsElementNode() &&
+                       Counts(ToElement(*previous_sibling))
+                   ? ToElement(previous_sibling)
+                   : PreviousCountedSibling(*previous_sibling);
+  }
+  unsigned previous_index;
+  Element* cached_sibling = FindCachedSibling(previous, previous_index);
+  if (&element == last_cached_sibling_) {
+    element_index_map_.erase(&element);
+    last_cached_sibling_ = cached_sibling;
+  } else if (cached_sibling != last_cached_sibling_) {
+    return false;
+  }
+  DCHECK(count_);
+  count_--;
+  return true;
+}
+
 void NthIndexData::Trace(blink::Visitor* visitor) {
   visitor->Trace(element_index_map_);
+  visitor->Trace(last_cached_sibling_);
 }
 
 }  // namespace blink
@@ -7,6 +7,7 @@
 
 #include "base/macros.h"
 #include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/dom/container_node.h"
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/wtf/hash_map.h"
@@ -25,14 +26,62 @@ class CORE_EXPORT NthIndexData final : public GarbageCollected<NthIndexData> {
   unsigned NthOfTypeIndex(Element&) const;
   unsigned NthLastOfTypeIndex(Element&) const;
 
+  // Update the data for a sibling inserted, or removed after the given
+  // sibling. Returns false if the data can't be updated cheaply, which is
+  // when the indices of cached siblings change; then the data must be
+  // dropped.
+  bool SiblingInserted(Element&);
+  bool SiblingRemoved(Element&, Node* previous_sibling);
+
   void Trace(blink::Visitor*);
 
  private:
+  bool Counts(const Element&) const;
+  Element* PreviousCountedSibling(const Node&) const;
+  // Walks back from |element| to the closest sibling with a cached index,
+  // which is returned, and sets |index| to the index of |element|.
+  Element* FindCachedSibling(Element* element, unsigned& index) const;
+
   HeapHashMap<Member<Element>, unsigned> element_index_map_;
+  // The sibling with the largest cached index.
+  Member<Element> last_cached_sibling_;
   unsigned count_ = 0;
+  // Set for nth-of-type data.
+  const QualifiedName type_;
   DISALLOW_COPY_AND_ASSIGN(NthIndexData);
 };
 
+// The nth-index data cached for the children of a parent outlives the
+// NthIndexCache it was created under: it is kept by the Document and updated
+// as children are inserted and removed, so that adding to a long list doesn't
+// rebuild the indices for every style recalc.
+class CORE_EXPORT NthIndexCacheStore final
+    : public GarbageCollected<NthIndexCacheStore> {
+ public:
+  NthIndexCacheStore() = default;
+
+  void ChildrenChanged(ContainerNode& parent,
+                       const ContainerNode::ChildrenChange&);
+  // The data for the children of |node| can't be updated once |node| moves
+  // to another document.
+  void NodeMovedToNewDocument(Node&);
+
+  void Trace(blink::Visitor*);
+
+ private:
+  friend class NthIndexCache;
+
+  using IndexByType = HeapHashMap<String, Member<NthIndexData>>;
+  using ParentMap = HeapHashMap<WeakMember<Node>, Member<NthIndexData>>;
+  using ParentMapForType = HeapHashMap<WeakMember<Node>, Member<IndexByType>>;
+
+  ParentMap parent_map_;
+  ParentMapForType parent_map_for_type_;
+  DISALLOW_COPY_AND_ASSIGN(NthIndexCacheStore);
+};
+
+// Enables caching nth-indices for the parents with many children while in
+// scope. No DOM mutations are allowed in the scope.
 class CORE_EXPORT NthIndexCache final {
   STACK_ALLOCATED();
 
@@ -46,18 +95,16 @@ class CORE_EXPORT NthIndexCache final {
   static unsigned NthLastOfTypeIndex(Element&);
 
  private:
-  using IndexByType = HeapHashMap<String, Member<NthIndexData>>;
-  using ParentMap = HeapHashMap<Member<Node>, Member<NthIndexData>>;
-  using ParentMapForType = HeapHashMap<Member<Node>, Member<IndexByType>>;
+  using IndexByType = NthIndexCacheStore::IndexByType;
 
+  static NthIndexData* NthIndexDataForParent(Element&);
+  static NthIndexData* NthTypeIndexDataForParent(Element&);
   void CacheNthIndexDataForParent(Element&);
   void CacheNthOfTypeIndexDataForParent(Element&);
   IndexByType& EnsureTypeIndexMap(ContainerNode&);
-  NthIndexData* NthTypeIndexDataForParent(Element&) const;
 
   Member<Document> document_;
-  Member<ParentMap> parent_map_;
-  Member<ParentMapForType> parent_map_for_type_;
+  Member<NthIndexCacheStore> store_;
 
 #if DCHECK_IS_ON()
   uint64_t dom_tree_version_;
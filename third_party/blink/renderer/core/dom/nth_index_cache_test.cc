@@ -7,8 +7,11 @@
 #include <memory>
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
+#include "third_party/blink/renderer/core/html_names.h"
 #include "third_party/blink/renderer/core/html/html_element.h"
 #include "third_party/blink/renderer/core/testing/page_test_base.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
 namespace blink {
 
@@ -37,4 +40,48 @@ TEST_F(NthIndexCacheTest, NthIndex) {
       12U);
 }
 
+TEST_F(NthIndexCacheTest, UpdatedOnMutations) {
+  StringBuilder markup;
+  markup.Append("<div id=list>");
+  for (unsigned i = 0; i < 40; ++i)
+    markup.Append(i % 2 ? "<span></span>" : "<b></b>");
+  markup.Append("</div>");
+  GetDocument().body()->SetInnerHTMLFromString(markup.ToString());
+  Element* list = GetElementById("list");
+
+  auto check_indices = [&]() {
+    NthIndexCache nth_index_cache(GetDocument());
+    unsigned count = 0;
+    for (Element* child = ElementTraversal::FirstChild(*list); child;
+         child = ElementTraversal::NextSibling(*child)) {
+      ++count;
+      unsigned of_type = 0;
+      EXPECT_EQ(count, NthIndexCache::NthChildIndex(*child));
+      EXPECT_EQ(list->CountChildren() - count + 1,
+                NthIndexCache::NthLastChildIndex(*child));
+      for (Element* sibling = child; sibling;
+           sibling = ElementTraversal::PreviousSibling(*sibling)) {
+        if (sibling->HasTagName(child->TagQName()))
+          ++of_type;
+      }
+      EXPECT_EQ(of_type, NthIndexCache::NthOfTypeIndex(*child));
+    }
+  };
+
+  check_indices();
+  ASSERT_TRUE(GetDocument().GetNthIndexCacheStore());
+
+  // Appending and removing at the end keeps the cached indices.
+  for (unsigned i = 0; i < 10; ++i)
+    list->AppendChild(GetDocument().CreateRawElement(HTMLNames::spanTag));
+  list->RemoveChild(list->lastChild());
+  check_indices();
+
+  // Changing the start of the list drops them.
+  list->InsertBefore(GetDocument().CreateRawElement(HTMLNames::spanTag),
+                     list->firstChild());
+  list->RemoveChild(list->lastChild()->previousSibling());
+  check_indices();
+}
+
 }  // namespace blink
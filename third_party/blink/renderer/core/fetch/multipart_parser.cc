@@ -8,6 +8,7 @@
 #include "third_party/blink/renderer/platform/network/http_names.h"
 #include "third_party/blink/renderer/platform/network/http_parsers.h"
 
+#include <string.h>
 #include <algorithm>
 #include <utility>
 
@@ -22,6 +23,27 @@ constexpr size_t kDashBoundaryOffset = 2u;  // The length of "\r\n".
 constexpr char kDelimiterSuffix[] = "\r\n";
 constexpr size_t kDelimiterSuffixSize = arraysize(kDelimiterSuffix) - 1u;
 
+// Returns the first occurrence of |delimiter| in [|first|, |last|), or |last|
+// if there is none. Candidate positions are found with memchr() on the first
+// delimiter byte, which skips through part octets much faster than a
+// byte-by-byte comparison.
+const char* FindDelimiter(const char* first,
+                          const char* last,
+                          const Vector<char>& delimiter) {
+  DCHECK(!delimiter.IsEmpty());
+  const size_t delimiter_size = delimiter.size();
+  while (static_cast<size_t>(last - first) >= delimiter_size) {
+    const char* candidate = static_cast<const char*>(
+        memchr(first, delimiter[0], last - first - delimiter_size + 1));
+    if (!candidate)
+      break;
+    if (!memcmp(candidate + 1, delimiter.data() + 1, delimiter_size - 1))
+      return candidate;
+    first = candidate + 1;
+  }
+  return last;
+}
+
 }  // namespace
 
 MultipartParser::Matcher::Matcher() = default;
@@ -250,8 +272,8 @@ void MultipartParser::ParseDataAndDelimiter(const char** bytes_pointer,
   DCHECK_EQ(0u, matcher_.NumMatchedBytes());
 
   // Search for a complete delimiter within the bytes.
-  const char* delimiter_begin = std::search(
-      *bytes_pointer, bytes_end, delimiter_.begin(), delimiter_.end());
+  const char* delimiter_begin =
+      FindDelimiter(*bytes_pointer, bytes_end, delimiter_);
   if (delimiter_begin != bytes_end) {
     // A complete delimiter was found. The bytes before that are octet
     // bytes.
@@ -56,6 +56,14 @@ class CollectionItemsCache : public CollectionIndexCache<Collection, NodeType> {
   NodeType* NodeAt(const Collection&, unsigned index);
   void Invalidate();
 
+  // The last node of the cached list if there is one, or else the cached
+  // node. Changes after it in the collection don't invalidate the cache.
+  NodeType* LastCachedNode() const;
+  // Updates the cache for |nodes| inserted into, or |count| nodes removed
+  // from, the collection after LastCachedNode().
+  void NodesInsertedAfterCachedNodes(const HeapVector<Member<NodeType>>& nodes);
+  void NodesRemovedAfterCachedNodes(unsigned count);
+
  private:
   bool list_valid_;
   HeapVector<Member<NodeType>> cached_list_;
@@ -77,6 +85,29 @@ void CollectionItemsCache<Collection, NodeType>::Invalidate() {
   }
 }
 
+template <typename Collection, typename NodeType>
+NodeType* CollectionItemsCache<Collection, NodeType>::LastCachedNode() const {
+  if (list_valid_)
+    return cached_list_.IsEmpty() ? nullptr : cached_list_.back().Get();
+  return this->CachedNode();
+}
+
+template <typename Collection, typename NodeType>
+void CollectionItemsCache<Collection, NodeType>::NodesInsertedAfterCachedNodes(
+    const HeapVector<Member<NodeType>>& nodes) {
+  Base::NodesInsertedAfterCachedNode(nodes.size());
+  if (list_valid_)
+    cached_list_.AppendVector(nodes);
+}
+
+template <typename Collection, typename NodeType>
+void CollectionItemsCache<Collection, NodeType>::NodesRemovedAfterCachedNodes(
+    unsigned count) {
+  Base::NodesRemovedAfterCachedNode(count);
+  // The cached list has all of the nodes, so there can't be any after it.
+  DCHECK(!list_valid_ || !count);
+}
+
 template <class Collection, class NodeType>
 unsigned CollectionItemsCache<Collection, NodeType>::NodeCount(
     const Collection& collection) {
@@ -203,6 +203,90 @@ void HTMLCollection::InvalidateCache(Document* old_document) const {
   InvalidateIdNameCacheMaps(old_document);
 }
 
+namespace {
+
+// Whether the collection only depends on the elements in it, and not on where
+// they are in the tree, so that inserting or removing elements after a node
+// in the collection doesn't change the collection before it.
+bool MatchesElementsRegardlessOfTree(CollectionType type) {
+  switch (type) {
+    case kClassCollectionType:
+    case kTagCollectionType:
+    case kHTMLTagCollectionType:
+    case kTagCollectionNSType:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether the child inserted into or removed from |parent| comes after |node|
+// in tree order.
+bool ChildrenChangeIsAfter(const ContainerNode& parent,
+                           const ContainerNode::ChildrenChange& change,
+                           const Node& node) {
+  const Node& changed = *change.sibling_changed;
+  const Node* reference = &changed;
+  unsigned short after_mask = Node::kDocumentPositionFollowing;
+  if (change.IsChildRemoval()) {
+    // The removed child is no longer in the tree, so compare with where it
+    // was instead: before its next sibling, or else at the end of |parent|.
+    if (changed.contains(&node))
+      return false;
+    if (change.sibling_after_change) {
+      reference = change.sibling_after_change;
+    } else {
+      if (&node == &parent)
+        return true;
+      reference = &parent;
+      after_mask |= Node::kDocumentPositionContains;
+    }
+  }
+  unsigned short position = node.compareDocumentPosition(reference);
+  return !(position & Node::kDocumentPositionDisconnected) &&
+         (position & after_mask);
+}
+
+}  // namespace
+
+void HTMLCollection::InvalidateCacheForChildrenChange(
+    const ContainerNode& parent,
+    const ContainerNode::ChildrenChange& change) const {
+  if (!MatchesElementsRegardlessOfTree(GetType()) ||
+      change.type == ContainerNode::kAllChildrenRemoved) {
+    InvalidateCache();
+    return;
+  }
+  // Text and comments are not in the collection.
+  if (!change.IsChildElementChange())
+    return;
+  InvalidateIdNameCacheMaps();
+
+  // Appending to a long collection, as infinite scrolling does, keeps the
+  // cache and only walks the appended elements.
+  if (Element* last_cached = collection_items_cache_.LastCachedNode()) {
+    if (!ChildrenChangeIsAfter(parent, change, *last_cached)) {
+      collection_items_cache_.Invalidate();
+      return;
+    }
+  }
+  if (!collection_items_cache_.IsCachedNodeCountValid())
+    return;
+
+  Element& changed = ToElement(*change.sibling_changed);
+  HeapVector<Member<Element>> matches;
+  if (ElementMatches(changed))
+    matches.push_back(&changed);
+  for (Element& descendant : ElementTraversal::DescendantsOf(changed)) {
+    if (ElementMatches(descendant))
+      matches.push_back(&descendant);
+  }
+  if (change.IsChildInsertion())
+    collection_items_cache_.NodesInsertedAfterCachedNodes(matches);
+  else
+    collection_items_cache_.NodesRemovedAfterCachedNodes(matches.size());
+}
+
 unsigned HTMLCollection::length() const {
   return collection_items_cache_.NodeCount(*this);
 }
@@ -80,6 +80,9 @@ class CORE_EXPORT HTMLCollection : public ScriptWrappable,
   ~HTMLCollection() override;
   void InvalidateCache(Document* old_document = nullptr) const override;
   void InvalidateCacheForAttribute(const QualifiedName*) const;
+  void InvalidateCacheForChildrenChange(
+      const ContainerNode& parent,
+      const ContainerNode::ChildrenChange&) const;
 
   // DOM API
   unsigned length() const;
@@ -0,0 +1,86 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/html/html_collection.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/dom/class_collection.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
+#include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/core/testing/page_test_base.h"
+
+namespace blink {
+
+class HTMLCollectionTest : public PageTestBase {
+ protected:
+  Element* CreateItem(const char* class_name) {
+    Element* item = GetDocument().CreateRawElement(HTMLNames::divTag);
+    item->setAttribute(HTMLNames::classAttr, class_name);
+    return item;
+  }
+
+  // Checks |collection| against the elements with class "item" in tree
+  // order.
+  void ExpectItems(HTMLCollection& collection) {
+    unsigned index = 0;
+    for (Element& element :
+         ElementTraversal::DescendantsOf(*GetDocument().body())) {
+      if (!element.HasClass() ||
+          !element.ClassNames().Contains(AtomicString("item")))
+        continue;
+      EXPECT_EQ(&element, collection.item(index)) << "at " << index;
+      ++index;
+    }
+    EXPECT_EQ(index, collection.length());
+    EXPECT_FALSE(collection.item(index));
+  }
+};
+
+TEST_F(HTMLCollectionTest, UpdatedForChildrenChanges) {
+  SetBodyInnerHTML(R"HTML(
+    <div id=list>
+      <div class=item></div><div class=other></div><div class=item></div>
+    </div>
+    <div id=after><div class=item></div></div>
+  )HTML");
+  Element* list = GetElementById("list");
+  HTMLCollection* collection =
+      GetDocument().getElementsByClassName(AtomicString("item"));
+  ExpectItems(*collection);
+
+  // Appending after the cached items, with matching descendants.
+  Element* nested = CreateItem("other");
+  nested->AppendChild(CreateItem("item"));
+  nested->AppendChild(CreateItem("item"));
+  GetElementById("after")->AppendChild(nested);
+  GetElementById("after")->AppendChild(GetDocument().createTextNode("text"));
+  ExpectItems(*collection);
+
+  // Changing the collection in the middle, before a cached item.
+  EXPECT_TRUE(collection->item(4));
+  list->AppendChild(CreateItem("item"));
+  ExpectItems(*collection);
+  list->InsertBefore(CreateItem("item"), list->firstChild());
+  ExpectItems(*collection);
+
+  // Removing after and before the cached item.
+  EXPECT_TRUE(collection->item(2));
+  nested->RemoveChild(nested->lastChild());
+  ExpectItems(*collection);
+  EXPECT_TRUE(collection->item(5));
+  list->RemoveChild(list->firstChild());
+  ExpectItems(*collection);
+
+  // Removing the parent of the cached item.
+  EXPECT_TRUE(collection->item(4));
+  GetElementById("after")->RemoveChild(nested);
+  ExpectItems(*collection);
+
+  list->RemoveChildren();
+  ExpectItems(*collection);
+}
+
+}  // namespace blink
@@ -33,11 +33,22 @@
 #include "third_party/blink/renderer/core/loader/document_loader.h"
 #include "third_party/blink/renderer/core/loader/frame_loader.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+#include "third_party/blink/renderer/platform/text/layout_locale.h"
+#include "third_party/blink/renderer/platform/wtf/functional.h"
 
 namespace blink {
 
 using namespace HTMLNames;
 
+namespace {
+
+void LoadHyphenation(const AtomicString& locale) {
+  if (const LayoutLocale* layout_locale = LayoutLocale::Get(locale))
+    layout_locale->GetHyphenation();
+}
+
+}  // namespace
+
 inline HTMLHtmlElement::HTMLHtmlElement(Document& document)
     : HTMLElement(htmlTag, document) {}
 
@@ -54,6 +65,7 @@ void HTMLHtmlElement::InsertedByParser() {
     return;
 
   MaybeSetupApplicationCache();
+  MaybePreloadHyphenation();
 
   GetDocument().Parser()->DocumentElementAvailable();
   if (GetDocument().GetFrame()) {
@@ -90,4 +102,19 @@ void HTMLHtmlElement::MaybeSetupApplicationCache() {
         GetDocument().CompleteURL(manifest));
 }
 
+void HTMLHtmlElement::MaybePreloadHyphenation() {
+  if (!RuntimeEnabledFeatures::HyphenationPreloadEnabled())
+    return;
+  const AtomicString& lang = FastGetAttribute(langAttr);
+  if (lang.IsEmpty())
+    return;
+
+  // Opening a hyphenation dictionary is a synchronous request to the browser.
+  // Do it while the parser is still waiting on the network rather than in the
+  // first layout of hyphenated text. LayoutLocale keeps the result.
+  GetDocument()
+      .GetTaskRunner(TaskType::kInternalLoading)
+      ->PostTask(FROM_HERE, WTF::Bind(&LoadHyphenation, lang));
+}
+
 }  // namespace blink
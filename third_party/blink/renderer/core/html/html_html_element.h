@@ -43,6 +43,7 @@ class CORE_EXPORT HTMLHtmlElement final : public HTMLElement {
   explicit HTMLHtmlElement(Document&);
 
   void MaybeSetupApplicationCache();
+  void MaybePreloadHyphenation();
 
   bool IsURLAttribute(const Attribute&) const override;
 };
@@ -40,6 +40,14 @@ struct SameSizeAsCompactHTMLToken {
 static_assert(sizeof(CompactHTMLToken) == sizeof(SameSizeAsCompactHTMLToken),
               "CompactHTMLToken should stay small");
 
+// The main thread atomizes tag and attribute names, see AtomicHTMLToken.
+// Hashing them on the parser thread leaves it only the lookup in its
+// AtomicStringTable.
+static void PrecomputeHash(const String& name) {
+  if (!name.IsEmpty())
+    name.Impl()->GetHash();
+}
+
 CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
                                    const TextPosition& text_position)
     : type_(token->GetType()),
@@ -65,14 +73,20 @@ CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
       break;
     case HTMLToken::kStartTag:
       attributes_.ReserveInitialCapacity(token->Attributes().size());
-      for (const HTMLToken::Attribute& attribute : token->Attributes())
+      for (const HTMLToken::Attribute& attribute : token->Attributes()) {
         attributes_.push_back(
             Attribute(attribute.NameAttemptStaticStringCreation(),
                       attribute.Value8BitIfNecessary()));
+        PrecomputeHash(attributes_.back().GetName());
+      }
       FALLTHROUGH;
     case HTMLToken::kEndTag:
       self_closing_ = token->SelfClosing();
-      FALLTHROUGH;
+      is_all8_bit_data_ = token->IsAll8BitData();
+      data_ = AttemptStaticStringCreation(
+          token->Data(), token->IsAll8BitData() ? kForce8Bit : kForce16Bit);
+      PrecomputeHash(data_);
+      break;
     case HTMLToken::kComment:
     case HTMLToken::kCharacter: {
       is_all8_bit_data_ = token->IsAll8BitData();
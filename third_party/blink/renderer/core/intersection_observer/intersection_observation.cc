@@ -47,17 +47,14 @@ IntersectionObservation::IntersectionObservation(IntersectionObserver& observer,
 }
 
 void IntersectionObservation::ComputeIntersectionObservations(
-    DOMHighResTimeStamp timestamp) {
+    DOMHighResTimeStamp timestamp,
+    const Vector<Length>& root_margin,
+    IntersectionGeometry::RootGeometry& root_geometry) {
   DCHECK(Observer());
   if (!target_)
     return;
-  Vector<Length> root_margin(4);
-  root_margin[0] = observer_->TopMargin();
-  root_margin[1] = observer_->RightMargin();
-  root_margin[2] = observer_->BottomMargin();
-  root_margin[3] = observer_->LeftMargin();
   IntersectionGeometry geometry(observer_->root(), *Target(), root_margin,
-                                should_report_root_bounds_);
+                                should_report_root_bounds_, &root_geometry);
   geometry.ComputeGeometry();
 
   // Some corner cases for threshold index:
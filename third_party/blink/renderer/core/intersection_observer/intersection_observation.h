@@ -6,6 +6,7 @@
 #define THIRD_PARTY_BLINK_RENDERER_CORE_INTERSECTION_OBSERVER_INTERSECTION_OBSERVATION_H_
 
 #include "third_party/blink/renderer/core/dom/dom_high_res_time_stamp.h"
+#include "third_party/blink/renderer/core/layout/intersection_geometry.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
 
 namespace blink {
@@ -25,7 +26,12 @@ class IntersectionObservation final
   IntersectionObserver* Observer() const { return observer_.Get(); }
   Element* Target() const { return target_; }
   unsigned LastThresholdIndex() const { return last_threshold_index_; }
-  void ComputeIntersectionObservations(DOMHighResTimeStamp);
+  // |root_geometry| is shared by all observations of the observer that are
+  // computed in one update.
+  void ComputeIntersectionObservations(
+      DOMHighResTimeStamp,
+      const Vector<Length>& root_margin,
+      IntersectionGeometry::RootGeometry& root_geometry);
   void Disconnect();
   void UpdateShouldReportRootBoundsAfterDomChange();
 
@@ -22,6 +22,7 @@
 #include "third_party/blink/renderer/core/intersection_observer/intersection_observer_delegate.h"
 #include "third_party/blink/renderer/core/intersection_observer/intersection_observer_entry.h"
 #include "third_party/blink/renderer/core/intersection_observer/intersection_observer_init.h"
+#include "third_party/blink/renderer/core/layout/intersection_geometry.h"
 #include "third_party/blink/renderer/core/layout/layout_view.h"
 #include "third_party/blink/renderer/core/timing/dom_window_performance.h"
 #include "third_party/blink/renderer/core/timing/window_performance.h"
@@ -327,8 +328,16 @@ void IntersectionObserver::ComputeIntersectionObservations() {
     return;
   }
   last_run_time_ = timestamp;
-  for (auto& observation : observations_)
-    observation->ComputeIntersectionObservations(last_run_time_);
+  Vector<Length> root_margin(4);
+  root_margin[0] = TopMargin();
+  root_margin[1] = RightMargin();
+  root_margin[2] = BottomMargin();
+  root_margin[3] = LeftMargin();
+  IntersectionGeometry::RootGeometry root_geometry;
+  for (auto& observation : observations_) {
+    observation->ComputeIntersectionObservations(last_run_time_, root_margin,
+                                                 root_geometry);
+  }
 }
 
 void IntersectionObserver::disconnect(ExceptionState& exception_state) {
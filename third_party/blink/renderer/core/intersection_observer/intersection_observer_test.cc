@@ -36,6 +36,9 @@ class TestIntersectionObserverDelegate : public IntersectionObserverDelegate {
   int CallCount() const { return call_count_; }
   int EntryCount() const { return entries_.size(); }
   const IntersectionObserverEntry* LastEntry() const { return entries_.back(); }
+  const IntersectionObserverEntry* EntryAt(int index) const {
+    return entries_[index];
+  }
   FloatRect LastIntersectionRect() const {
     if (entries_.IsEmpty())
       return FloatRect();
@@ -300,6 +303,47 @@ TEST_F(IntersectionObserverTest, RootIntersectionWithForceZeroLayoutHeight) {
   EXPECT_TRUE(observer_delegate->LastIntersectionRect().IsEmpty());
 }
 
+TEST_F(IntersectionObserverTest, RootMarginWithManyTargets) {
+  WebView().Resize(WebSize(800, 600));
+  SimRequest main_resource("https://example.com/", "text/html");
+  LoadURL("https://example.com/");
+  main_resource.Complete(R"HTML(
+    <!DOCTYPE html>
+    <style>
+      body { margin: 0; height: 2000px; }
+      div { position: absolute; left: 0; width: 100px; height: 100px; }
+    </style>
+    <div id='visible' style='top: 0'></div>
+    <div id='in-margin' style='top: 650px'></div>
+    <div id='outside' style='top: 1000px'></div>
+  )HTML");
+
+  IntersectionObserverInit observer_init;
+  observer_init.setRootMargin("0px 0px 100px 0px");
+  DummyExceptionStateForTesting exception_state;
+  TestIntersectionObserverDelegate* observer_delegate =
+      new TestIntersectionObserverDelegate(GetDocument());
+  IntersectionObserver* observer = IntersectionObserver::Create(
+      observer_init, *observer_delegate, exception_state);
+  ASSERT_FALSE(exception_state.HadException());
+
+  observer->observe(GetDocument().getElementById("visible"), exception_state);
+  observer->observe(GetDocument().getElementById("in-margin"),
+                    exception_state);
+  observer->observe(GetDocument().getElementById("outside"), exception_state);
+
+  Compositor().BeginFrame();
+  test::RunPendingTasks();
+  ASSERT_EQ(observer_delegate->CallCount(), 1);
+  ASSERT_EQ(observer_delegate->EntryCount(), 3);
+  EXPECT_TRUE(observer_delegate->EntryAt(0)->isIntersecting());
+  EXPECT_TRUE(observer_delegate->EntryAt(1)->isIntersecting());
+  EXPECT_FALSE(observer_delegate->EntryAt(2)->isIntersecting());
+  // All targets share the root, so they report the same root bounds.
+  EXPECT_EQ(700, observer_delegate->EntryAt(0)->rootBounds()->height());
+  EXPECT_EQ(700, observer_delegate->EntryAt(2)->rootBounds()->height());
+}
+
 TEST_F(IntersectionObserverV2Test, TrackVisibilityInit) {
   IntersectionObserverInit observer_init;
   DummyExceptionStateForTesting exception_state;
@@ -0,0 +1,45 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/core/testing/core_unit_test_helper.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+
+namespace blink {
+
+class GridPerfTest : public RenderingTest {};
+
+// A data grid with content-sized columns and spanning cells, relaid out after
+// each change of its width.
+TEST_F(GridPerfTest, ContentSizedDataGrid) {
+  StringBuilder html;
+  html.Append(
+      "<style>"
+      "#grid { display: grid; grid-template-columns: repeat(8, auto); }"
+      ".wide { grid-column: span 2; }"
+      "</style><div id=grid>");
+  for (unsigned row = 0; row < 500; row++) {
+    for (unsigned column = 0; column < 6; column++)
+      html.Append("<div>cell text</div>");
+    html.Append("<div class=wide>spanning cell text</div>");
+  }
+  html.Append("</div>");
+  SetBodyInnerHTML(html.ToString());
+  Element* grid = GetElementById("grid");
+
+  const unsigned kIterationCount = 20;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (unsigned count = 0; count < kIterationCount; count++) {
+    grid->setAttribute(HTMLNames::styleAttr,
+                       count % 2 ? "width: 800px" : "width: 900px");
+    UpdateAllLifecyclePhases();
+  }
+  LOG(ERROR) << "  Time to lay out a grid of 3500 items " << kIterationCount
+             << " times: " << (base::TimeTicks::Now() - start).InMilliseconds()
+             << "ms";
+}
+
+}  // namespace blink
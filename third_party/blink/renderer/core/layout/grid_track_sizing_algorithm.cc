@@ -933,20 +933,20 @@ void GridTrackSizingAlgorithm::SizeTrackToFitNonSpanningItem(
 
   if (track_size.HasMinContentMinTrackBreadth()) {
     track.SetBaseSize(
-        std::max(track.BaseSize(), strategy_->MinContentForChild(grid_item)));
+        std::max(track.BaseSize(), MinContentContribution(grid_item)));
   } else if (track_size.HasMaxContentMinTrackBreadth()) {
     track.SetBaseSize(
-        std::max(track.BaseSize(), strategy_->MaxContentForChild(grid_item)));
+        std::max(track.BaseSize(), MaxContentContribution(grid_item)));
   } else if (track_size.HasAutoMinTrackBreadth()) {
     track.SetBaseSize(
-        std::max(track.BaseSize(), strategy_->MinSizeForChild(grid_item)));
+        std::max(track.BaseSize(), MinSizeContribution(grid_item)));
   }
 
   if (track_size.HasMinContentMaxTrackBreadth()) {
     track.SetGrowthLimit(std::max(track.GrowthLimit(),
-                                  strategy_->MinContentForChild(grid_item)));
+                                  MinContentContribution(grid_item)));
   } else if (track_size.HasMaxContentOrAutoMaxTrackBreadth()) {
-    LayoutUnit growth_limit = strategy_->MaxContentForChild(grid_item);
+    LayoutUnit growth_limit = MaxContentContribution(grid_item);
     if (track_size.IsFitContent()) {
       growth_limit =
           std::min(growth_limit,
@@ -957,6 +957,36 @@ void GridTrackSizingAlgorithm::SizeTrackToFitNonSpanningItem(
   }
 }
 
+LayoutUnit GridTrackSizingAlgorithm::MinContentContribution(
+    LayoutBox& grid_item) const {
+  base::Optional<LayoutUnit>& min_content =
+      item_contributions_.insert(&grid_item, GridItemContributions())
+          .stored_value->value.min_content;
+  if (!min_content)
+    min_content = strategy_->MinContentForChild(grid_item);
+  return *min_content;
+}
+
+LayoutUnit GridTrackSizingAlgorithm::MaxContentContribution(
+    LayoutBox& grid_item) const {
+  base::Optional<LayoutUnit>& max_content =
+      item_contributions_.insert(&grid_item, GridItemContributions())
+          .stored_value->value.max_content;
+  if (!max_content)
+    max_content = strategy_->MaxContentForChild(grid_item);
+  return *max_content;
+}
+
+LayoutUnit GridTrackSizingAlgorithm::MinSizeContribution(
+    LayoutBox& grid_item) const {
+  base::Optional<LayoutUnit>& min_size =
+      item_contributions_.insert(&grid_item, GridItemContributions())
+          .stored_value->value.min_size;
+  if (!min_size)
+    min_size = strategy_->MinSizeForChild(grid_item);
+  return *min_size;
+}
+
 bool GridTrackSizingAlgorithm::SpanningItemCrossesFlexibleSizedTracks(
     const GridSpan& span) const {
   for (const auto& track_position : span) {
@@ -1123,12 +1153,12 @@ LayoutUnit GridTrackSizingAlgorithm::ItemSizeForTrackSizeComputationPhase(
   switch (phase) {
     case kResolveIntrinsicMinimums:
     case kResolveIntrinsicMaximums:
-      return strategy_->MinSizeForChild(grid_item);
+      return MinSizeContribution(grid_item);
     case kResolveContentBasedMinimums:
-      return strategy_->MinContentForChild(grid_item);
+      return MinContentContribution(grid_item);
     case kResolveMaxContentMinimums:
     case kResolveMaxContentMaximums:
-      return strategy_->MaxContentForChild(grid_item);
+      return MaxContentContribution(grid_item);
     case kMaximizeTracks:
       NOTREACHED();
       return LayoutUnit();
@@ -1309,6 +1339,7 @@ void GridTrackSizingAlgorithm::IncreaseSizesToAccommodateSpanningItems(
 }
 
 void GridTrackSizingAlgorithm::ResolveIntrinsicTrackSizes() {
+  DCHECK(item_contributions_.IsEmpty());
   Vector<GridItemWithSpan> items_sorted_by_increasing_span;
   if (grid_.HasGridItems()) {
     HashSet<LayoutBox*> items_set;
@@ -1348,6 +1379,7 @@ void GridTrackSizingAlgorithm::ResolveIntrinsicTrackSizes() {
         span_group_range);
     it = span_group_range.range_end;
   }
+  item_contributions_.clear();
 
   for (const auto& track_index : content_sized_tracks_index_) {
     GridTrack& track = Tracks(direction_)[track_index];
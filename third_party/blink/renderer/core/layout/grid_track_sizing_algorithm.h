@@ -13,6 +13,7 @@
 #include "third_party/blink/renderer/core/style/grid_positions_resolver.h"
 #include "third_party/blink/renderer/core/style/grid_track_size.h"
 #include "third_party/blink/renderer/platform/layout_unit.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
 #include "third_party/blink/renderer/platform/wtf/hash_set.h"
 
 namespace blink {
@@ -150,6 +151,9 @@ class GridTrackSizingAlgorithm final {
       const GridItemsSpanGroupRange& grid_items_with_span);
   LayoutUnit ItemSizeForTrackSizeComputationPhase(TrackSizeComputationPhase,
                                                   LayoutBox&) const;
+  LayoutUnit MinContentContribution(LayoutBox&) const;
+  LayoutUnit MaxContentContribution(LayoutBox&) const;
+  LayoutUnit MinSizeContribution(LayoutBox&) const;
   template <TrackSizeComputationPhase phase>
   void DistributeSpaceToTracks(
       Vector<GridTrack*>& tracks,
@@ -215,6 +219,16 @@ class GridTrackSizingAlgorithm final {
   Vector<size_t> flexible_sized_tracks_index_;
   Vector<size_t> auto_sized_tracks_for_stretch_index_;
 
+  // The contributions of the grid items to the tracks in |direction_| don't
+  // change while ResolveIntrinsicTrackSizes() runs, but the same item is
+  // measured for several tracks and phases, so they are computed once.
+  struct GridItemContributions {
+    base::Optional<LayoutUnit> min_content;
+    base::Optional<LayoutUnit> max_content;
+    base::Optional<LayoutUnit> min_size;
+  };
+  mutable HashMap<const LayoutBox*, GridItemContributions> item_contributions_;
+
   GridTrackSizingDirection direction_;
 
   Grid& grid_;
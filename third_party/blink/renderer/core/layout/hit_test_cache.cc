@@ -85,6 +85,15 @@ void HitTestCache::Clear() {
   items_.clear();
 }
 
+void HitTestCache::ClearIfAnyPointIsWithin(const LayoutRect& rect) {
+  for (const auto& cached_item : items_) {
+    if (rect.Contains(cached_item.location.Point())) {
+      Clear();
+      return;
+    }
+  }
+}
+
 void HitTestCache::Trace(blink::Visitor* visitor) {
   visitor->Trace(items_);
 }
@@ -57,6 +57,12 @@ class CORE_EXPORT HitTestCache final
 
   void Clear();
 
+  // Clears the cache if any cached hit test point is within |rect|. Cached
+  // results for points outside |rect| are kept.
+  void ClearIfAnyPointIsWithin(const LayoutRect& rect);
+
+  bool IsEmpty() const { return items_.IsEmpty(); }
+
   // Adds a HitTestResult to the cache.
   void AddCachedResult(const HitTestLocation&,
                        const HitTestResult&,
@@ -68,23 +68,24 @@ LayoutView* LocalRootView(Element& element) {
 IntersectionGeometry::IntersectionGeometry(Element* root,
                                            Element& target,
                                            const Vector<Length>& root_margin,
-                                           bool should_report_root_bounds)
+                                           bool should_report_root_bounds,
+                                           RootGeometry* root_geometry)
     : root_(root ? root->GetLayoutObject() : LocalRootView(target)),
       target_(target.GetLayoutObject()),
-      root_margin_(root_margin),
+      root_geometry_(root_geometry),
       does_intersect_(0),
       should_report_root_bounds_(should_report_root_bounds),
       root_is_implicit_(!root),
       can_compute_geometry_(InitializeCanComputeGeometry(root, target)) {
+  DCHECK(root_margin.IsEmpty() || root_margin.size() == 4);
   if (can_compute_geometry_)
-    InitializeGeometry();
+    InitializeGeometry(root_margin);
 }
 
 IntersectionGeometry::~IntersectionGeometry() = default;
 
 bool IntersectionGeometry::InitializeCanComputeGeometry(Element* root,
                                                         Element& target) const {
-  DCHECK(root_margin_.IsEmpty() || root_margin_.size() == 4);
   if (root && !root->isConnected())
     return false;
   if (!root_ || !root_->IsBox())
@@ -98,10 +99,20 @@ bool IntersectionGeometry::InitializeCanComputeGeometry(Element* root,
   return true;
 }
 
-void IntersectionGeometry::InitializeGeometry() {
+void IntersectionGeometry::InitializeGeometry(
+    const Vector<Length>& root_margin) {
   InitializeTargetRect();
   intersection_rect_ = target_rect_;
-  InitializeRootRect();
+  if (root_geometry_ && root_geometry_->root_ == root_) {
+    root_rect_ = root_geometry_->local_root_rect_;
+    return;
+  }
+  InitializeRootRect(root_margin);
+  if (root_geometry_) {
+    root_geometry_->root_ = root_;
+    root_geometry_->local_root_rect_ = root_rect_;
+    root_geometry_->root_rect_in_frame_.reset();
+  }
 }
 
 void IntersectionGeometry::InitializeTargetRect() {
@@ -115,7 +126,8 @@ void IntersectionGeometry::InitializeTargetRect() {
   }
 }
 
-void IntersectionGeometry::InitializeRootRect() {
+void IntersectionGeometry::InitializeRootRect(
+    const Vector<Length>& root_margin) {
   if (root_->IsLayoutView() && root_->GetDocument().IsInMainFrame()) {
     // The main frame is a bit special as the scrolling viewport can differ in
     // size from the LayoutView itself. There's two situations this occurs in:
@@ -131,20 +143,20 @@ void IntersectionGeometry::InitializeRootRect() {
   } else {
     root_rect_ = LayoutRect(ToLayoutBoxModelObject(root_)->BorderBoundingBox());
   }
-  ApplyRootMargin();
+  ApplyRootMargin(root_margin);
 }
 
-void IntersectionGeometry::ApplyRootMargin() {
-  if (root_margin_.IsEmpty())
+void IntersectionGeometry::ApplyRootMargin(const Vector<Length>& root_margin) {
+  if (root_margin.IsEmpty())
     return;
 
   // TODO(szager): Make sure the spec is clear that left/right margins are
   // resolved against width and not height.
-  LayoutUnit top_margin = ComputeMargin(root_margin_[0], root_rect_.Height());
-  LayoutUnit right_margin = ComputeMargin(root_margin_[1], root_rect_.Width());
+  LayoutUnit top_margin = ComputeMargin(root_margin[0], root_rect_.Height());
+  LayoutUnit right_margin = ComputeMargin(root_margin[1], root_rect_.Width());
   LayoutUnit bottom_margin =
-      ComputeMargin(root_margin_[2], root_rect_.Height());
-  LayoutUnit left_margin = ComputeMargin(root_margin_[3], root_rect_.Width());
+      ComputeMargin(root_margin[2], root_rect_.Height());
+  LayoutUnit left_margin = ComputeMargin(root_margin[3], root_rect_.Width());
 
   root_rect_.SetX(root_rect_.X() - left_margin);
   root_rect_.SetWidth(root_rect_.Width() + left_margin + right_margin);
@@ -195,6 +207,11 @@ void IntersectionGeometry::MapTargetRectToTargetFrameCoordinates() {
 }
 
 void IntersectionGeometry::MapRootRectToRootFrameCoordinates() {
+  if (root_geometry_ && root_geometry_->root_rect_in_frame_) {
+    DCHECK_EQ(root_geometry_->root_, root_);
+    root_rect_ = *root_geometry_->root_rect_in_frame_;
+    return;
+  }
   root_rect_ = LayoutRect(
       root_
           ->LocalToAncestorQuad(
@@ -202,6 +219,8 @@ void IntersectionGeometry::MapRootRectToRootFrameCoordinates() {
               RootIsImplicit() ? nullptr : root_->GetDocument().GetLayoutView(),
               kUseTransforms | kApplyContainerFlip)
           .BoundingBox());
+  if (root_geometry_)
+    root_geometry_->root_rect_in_frame_ = root_rect_;
 }
 
 void IntersectionGeometry::MapIntersectionRectToTargetFrameCoordinates() {
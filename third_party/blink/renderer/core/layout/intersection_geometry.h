@@ -5,6 +5,8 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_LAYOUT_INTERSECTION_GEOMETRY_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_LAYOUT_INTERSECTION_GEOMETRY_H_
 
+#include "base/macros.h"
+#include "base/optional.h"
 #include "third_party/blink/renderer/platform/geometry/layout_rect.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/length.h"
@@ -25,10 +27,35 @@ class IntersectionGeometry {
   STACK_ALLOCATED();
 
  public:
+  // The parts of the geometry that depend only on the root. When computing
+  // the intersections of many targets with the same root and root margin, e.g.
+  // for all targets of an IntersectionObserver in one update, pass the same
+  // RootGeometry to each IntersectionGeometry so they are computed once.
+  class RootGeometry {
+    STACK_ALLOCATED();
+
+   public:
+    RootGeometry() = default;
+
+   private:
+    friend class IntersectionGeometry;
+
+    LayoutObject* root_ = nullptr;
+    // The root rect with the root margin applied, in the coordinate system of
+    // the root.
+    LayoutRect local_root_rect_;
+    // |local_root_rect_| mapped to the frame containing the root, once it has
+    // been needed.
+    base::Optional<LayoutRect> root_rect_in_frame_;
+
+    DISALLOW_COPY_AND_ASSIGN(RootGeometry);
+  };
+
   IntersectionGeometry(Element* root,
                        Element& target,
                        const Vector<Length>& root_margin,
-                       bool should_report_root_bounds);
+                       bool should_report_root_bounds,
+                       RootGeometry* root_geometry = nullptr);
   ~IntersectionGeometry();
 
   void ComputeGeometry();
@@ -57,14 +84,14 @@ class IntersectionGeometry {
 
  private:
   bool InitializeCanComputeGeometry(Element* root, Element& target) const;
-  void InitializeGeometry();
+  void InitializeGeometry(const Vector<Length>& root_margin);
   void InitializeTargetRect();
-  void InitializeRootRect();
+  void InitializeRootRect(const Vector<Length>& root_margin);
   void ClipToRoot();
   void MapTargetRectToTargetFrameCoordinates();
   void MapRootRectToRootFrameCoordinates();
   void MapIntersectionRectToTargetFrameCoordinates();
-  void ApplyRootMargin();
+  void ApplyRootMargin(const Vector<Length>& root_margin);
 
   // Returns true iff it's possible to compute an intersection between root
   // and target.
@@ -74,7 +101,7 @@ class IntersectionGeometry {
 
   LayoutObject* root_;
   LayoutObject* target_;
-  const Vector<Length> root_margin_;
+  RootGeometry* root_geometry_;
   LayoutRect target_rect_;
   LayoutRect intersection_rect_;
   LayoutRect root_rect_;
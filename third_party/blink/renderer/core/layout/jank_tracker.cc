@@ -58,11 +58,11 @@ static bool SmallerThanRegionGranularity(const LayoutRect& rect,
 }
 
 #ifdef TRACE_JANK_REGIONS
-static void RegionToTracedValue(const Region& region,
+static void RegionToTracedValue(const Vector<IntRect>& region_rects,
                                 double granularity_scale,
                                 TracedValue& value) {
   value.BeginArray("region_rects");
-  for (const IntRect& rect : region.Rects()) {
+  for (const IntRect& rect : region_rects) {
     value.BeginArray();
     value.PushInteger(clampTo<int>(roundf(rect.X() / granularity_scale)));
     value.PushInteger(clampTo<int>(roundf(rect.Y() / granularity_scale)));
@@ -74,6 +74,58 @@ static void RegionToTracedValue(const Region& region,
 }
 #endif  // TRACE_JANK_REGIONS
 
+void JankTracker::JankRegion::AddRect(const IntRect& rect,
+                                      const IntRect& viewport) {
+  if (viewport != viewport_) {
+    // The viewport rarely changes within a frame. Cells of the old viewport
+    // can't be mapped to the new one, so start over.
+    viewport_ = viewport;
+    cells_.Fill(false, viewport.Width() * viewport.Height());
+    area_ = 0;
+  }
+  IntRect clipped = rect;
+  clipped.Intersect(viewport_);
+  if (clipped.IsEmpty())
+    return;
+  clipped.MoveBy(-viewport_.Location());
+  for (int y = clipped.Y(); y < clipped.MaxY(); ++y) {
+    bool* row = cells_.data() + y * viewport_.Width();
+    for (int x = clipped.X(); x < clipped.MaxX(); ++x) {
+      if (!row[x]) {
+        row[x] = true;
+        ++area_;
+      }
+    }
+  }
+}
+
+void JankTracker::JankRegion::Reset() {
+  if (area_)
+    cells_.Fill(false);
+  area_ = 0;
+}
+
+#ifdef TRACE_JANK_REGIONS
+Vector<IntRect> JankTracker::JankRegion::Rects() const {
+  Vector<IntRect> rects;
+  for (int y = 0; y < viewport_.Height(); ++y) {
+    const bool* row = cells_.data() + y * viewport_.Width();
+    for (int x = 0; x < viewport_.Width();) {
+      if (!row[x]) {
+        ++x;
+        continue;
+      }
+      int run_start = x;
+      while (x < viewport_.Width() && row[x])
+        ++x;
+      rects.push_back(IntRect(viewport_.X() + run_start, viewport_.Y() + y,
+                              x - run_start, 1));
+    }
+  }
+  return rects;
+}
+#endif  // TRACE_JANK_REGIONS
+
 JankTracker::JankTracker(LocalFrameView* frame_view)
     : frame_view_(frame_view),
       score_(0.0),
@@ -147,9 +199,10 @@ void JankTracker::NotifyObjectPrePaint(const LayoutObject& object,
 
   visible_old_visual_rect.Scale(scale);
   visible_new_visual_rect.Scale(scale);
+  viewport.Scale(scale);
 
-  region_.Unite(Region(visible_old_visual_rect));
-  region_.Unite(Region(visible_new_visual_rect));
+  region_.AddRect(visible_old_visual_rect, viewport);
+  region_.AddRect(visible_new_visual_rect, viewport);
 }
 
 void JankTracker::NotifyPrePaintFinished() {
@@ -161,7 +214,7 @@ void JankTracker::NotifyPrePaintFinished() {
   viewport.Scale(granularity_scale);
   double viewport_area = double(viewport.Width()) * double(viewport.Height());
 
-  double jank_fraction = region_.Area() / viewport_area;
+  double jank_fraction = static_cast<double>(region_.Area()) / viewport_area;
   score_ += jank_fraction;
 
   DVLOG(1) << "viewport " << (jank_fraction * 100)
@@ -172,7 +225,7 @@ void JankTracker::NotifyPrePaintFinished() {
                        PerFrameTraceData(jank_fraction, granularity_scale),
                        "frame", ToTraceValue(&frame_view_->GetFrame()));
 
-  region_ = Region();
+  region_.Reset();
 }
 
 void JankTracker::NotifyInput(const WebInputEvent& event) {
@@ -217,7 +270,7 @@ std::unique_ptr<TracedValue> JankTracker::PerFrameTraceData(
   // Jank regions can be included in trace event by defining TRACE_JANK_REGIONS
   // at the top of this file. This is useful for debugging and visualizing, but
   // might impact performance negatively.
-  RegionToTracedValue(region_, granularity_scale, *value);
+  RegionToTracedValue(region_.Rects(), granularity_scale, *value);
 #endif
 
   value->SetBoolean("is_main_frame", frame_view_->GetFrame().IsMainFrame());
@@ -6,9 +6,10 @@
 #define THIRD_PARTY_BLINK_RENDERER_CORE_LAYOUT_JANK_TRACKER_H_
 
 #include "third_party/blink/renderer/core/core_export.h"
-#include "third_party/blink/renderer/platform/geometry/region.h"
+#include "third_party/blink/renderer/platform/geometry/int_rect.h"
 #include "third_party/blink/renderer/platform/timer.h"
 #include "third_party/blink/renderer/platform/wtf/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
 
@@ -49,8 +50,33 @@ class CORE_EXPORT JankTracker {
   // The global jank score.
   double score_;
 
+  // The union of rects in the granularity-scaled viewport, kept as one cell
+  // per granularity step. Region::Unite() gets slow when thousands of small
+  // rects move in a frame; the cost of adding a rect here is bounded by the
+  // number of cells it covers, which is bounded by the viewport.
+  class JankRegion {
+    DISALLOW_NEW();
+
+   public:
+    // |viewport| is the granularity-scaled viewport. Rects outside of it are
+    // ignored.
+    void AddRect(const IntRect& rect, const IntRect& viewport);
+    bool IsEmpty() const { return area_ == 0; }
+    uint64_t Area() const { return area_; }
+    void Reset();
+#ifdef TRACE_JANK_REGIONS
+    // Returns runs of covered cells in each row, in scaled viewport space.
+    Vector<IntRect> Rects() const;
+#endif
+
+   private:
+    IntRect viewport_;
+    Vector<bool> cells_;
+    uint64_t area_ = 0;
+  };
+
   // The per-frame jank region.
-  Region region_;
+  JankRegion region_;
 
   // Tracks the short period after an input event during which we ignore jank.
   TaskRunnerTimer<JankTracker> timer_;
@@ -41,6 +41,25 @@ TEST_F(JankTrackerTest, SimpleBlockMovement) {
   EXPECT_FLOAT_EQ(60.0, GetJankTracker().MaxDistance());
 }
 
+TEST_F(JankTrackerTest, OverlappingMovementsCountedOnce) {
+  SetBodyInnerHTML(R"HTML(
+    <style>
+      body { margin: 0; }
+      .j { position: absolute; width: 300px; height: 100px; }
+    </style>
+    <div id='a' class='j'></div>
+    <div id='b' class='j'></div>
+  )HTML");
+
+  GetDocument().getElementById("a")->setAttribute(HTMLNames::styleAttr,
+                                                  AtomicString("top: 60px"));
+  GetDocument().getElementById("b")->setAttribute(HTMLNames::styleAttr,
+                                                  AtomicString("top: 60px"));
+  GetFrameView().UpdateAllLifecyclePhases();
+  // Both elements cover the same 300 * (100 + 60) area.
+  EXPECT_FLOAT_EQ(0.1, GetJankTracker().Score());
+}
+
 TEST_F(JankTrackerTest, GranularitySnapping) {
   SetBodyInnerHTML(R"HTML(
     <style>
@@ -201,6 +201,17 @@ void LayoutView::ClearHitTestCache() {
     object->View()->ClearHitTestCache();
 }
 
+void LayoutView::ClearHitTestCacheForScroll(const LayoutBox& scroller) {
+  DCHECK_EQ(scroller.View(), this);
+  if (!hit_test_cache_->IsEmpty()) {
+    hit_test_cache_->ClearIfAnyPointIsWithin(
+        LayoutRect(scroller.AbsoluteBoundingBoxRect()));
+  }
+  auto* object = GetFrame()->OwnerLayoutObject();
+  if (object)
+    object->View()->ClearHitTestCache();
+}
+
 void LayoutView::ComputeLogicalHeight(
     LayoutUnit logical_height,
     LayoutUnit,
@@ -71,7 +71,24 @@ class CORE_EXPORT LayoutView final : public LayoutBlockFlow {
   unsigned HitTestCount() const { return hit_test_count_; }
   unsigned HitTestCacheHits() const { return hit_test_cache_hits_; }
 
+  // Counts the lookups of the cached NGLayoutResult in NGBlockNode::Layout,
+  // for testing.
+  void CountLayoutResultCacheLookup(bool hit) {
+    if (hit)
+      layout_result_cache_hits_++;
+    else
+      layout_result_cache_misses_++;
+  }
+  unsigned LayoutResultCacheHits() const { return layout_result_cache_hits_; }
+  unsigned LayoutResultCacheMisses() const {
+    return layout_result_cache_misses_;
+  }
+
   void ClearHitTestCache();
+  // Clears cached hit test results that a scroll of |scroller| may change.
+  // Scrolled content is clipped by the scroller, so results for points outside
+  // the scroller in this view are kept. Ancestor frames are cleared entirely.
+  void ClearHitTestCacheForScroll(const LayoutBox& scroller);
 
   const char* GetName() const override { return "LayoutView"; }
 
@@ -317,6 +334,8 @@ class CORE_EXPORT LayoutView final : public LayoutBlockFlow {
 
   unsigned hit_test_count_;
   unsigned hit_test_cache_hits_;
+  unsigned layout_result_cache_hits_ = 0;
+  unsigned layout_result_cache_misses_ = 0;
   Persistent<HitTestCache> hit_test_cache_;
 
   // FrameViewAutoSizeInfo controls scrollbar appearance manually rather than
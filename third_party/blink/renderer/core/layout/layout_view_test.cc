@@ -4,6 +4,9 @@
 
 #include "third_party/blink/renderer/core/layout/layout_view.h"
 
+#include "third_party/blink/renderer/core/layout/hit_test_location.h"
+#include "third_party/blink/renderer/core/layout/hit_test_result.h"
+#include "third_party/blink/renderer/core/paint/paint_layer_scrollable_area.h"
 #include "third_party/blink/renderer/core/testing/core_unit_test_helper.h"
 
 namespace blink {
@@ -33,4 +36,42 @@ TEST_F(LayoutViewTest, UpdateCountersLayout) {
   EXPECT_TRUE(GetDocument().View()->NeedsLayout());
 }
 
+TEST_F(LayoutViewTest, ScrollKeepsHitTestCacheOutsideScroller) {
+  SetBodyInnerHTML(R"HTML(
+    <style>
+      body { margin: 0 }
+      #scroller { width: 100px; height: 100px; overflow: scroll }
+      #target { position: absolute; top: 300px; left: 300px;
+                width: 100px; height: 100px }
+    </style>
+    <div id=scroller><div style="height: 1000px"></div></div>
+    <div id=target></div>
+  )HTML");
+
+  auto hit_test = [this](int x, int y) {
+    HitTestRequest request(HitTestRequest::kReadOnly | HitTestRequest::kActive);
+    HitTestLocation location(LayoutPoint(x, y));
+    HitTestResult result(request, location);
+    GetLayoutView().HitTest(location, result);
+    return result.InnerNode();
+  };
+
+  Element* target = GetDocument().getElementById("target");
+  EXPECT_EQ(target, hit_test(350, 350));
+  unsigned cache_hits = GetLayoutView().HitTestCacheHits();
+
+  auto* scrollable_area =
+      ToLayoutBox(GetLayoutObjectByElementId("scroller"))->GetScrollableArea();
+  scrollable_area->SetScrollOffset(ScrollOffset(0, 50), kProgrammaticScroll);
+  EXPECT_EQ(target, hit_test(350, 350));
+  EXPECT_EQ(cache_hits + 1, GetLayoutView().HitTestCacheHits());
+
+  // A cached point inside the scroller is dropped when it scrolls.
+  hit_test(50, 50);
+  scrollable_area->SetScrollOffset(ScrollOffset(0, 100), kProgrammaticScroll);
+  cache_hits = GetLayoutView().HitTestCacheHits();
+  hit_test(50, 50);
+  EXPECT_EQ(cache_hits, GetLayoutView().HitTestCacheHits());
+}
+
 }  // namespace blink
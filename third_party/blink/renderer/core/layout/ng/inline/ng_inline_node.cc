@@ -202,6 +202,70 @@ static bool NeedsShaping(const NGInlineItem& item) {
   return item.Type() == NGInlineItem::kText && !item.TextShapeResult();
 }
 
+// Find the text item in |previous_items| that was created for the same
+// LayoutObject as |item| and starts at the same offset.
+const NGInlineItem* FindPreviousTextItem(
+    const Vector<NGInlineItem>& previous_items,
+    const NGInlineItem& item) {
+  const NGInlineItem* previous_item = std::lower_bound(
+      previous_items.begin(), previous_items.end(), item.StartOffset(),
+      [](const NGInlineItem& previous_item, unsigned offset) {
+        return previous_item.StartOffset() < offset;
+      });
+  for (; previous_item != previous_items.end() &&
+         previous_item->StartOffset() == item.StartOffset();
+       ++previous_item) {
+    if (previous_item->Type() == NGInlineItem::kText &&
+        previous_item->GetLayoutObject() == item.GetLayoutObject())
+      return previous_item->TextShapeResult() ? previous_item : nullptr;
+  }
+  return nullptr;
+}
+
+// Shape |item| by reusing the ShapeResult of |previous_item| up to the last
+// safe-to-break offset before the first character that differs from
+// |previous_text|. Returns nullptr if nothing can be reused.
+scoped_refptr<ShapeResult> ReshapeEditedItem(
+    const HarfBuzzShaper& shaper,
+    const String& text,
+    const NGInlineItem& item,
+    const String& previous_text,
+    const NGInlineItem& previous_item) {
+  const Font& font = item.Style()->GetFont();
+  if (previous_item.Style()->GetFont() != font ||
+      previous_item.Direction() != item.Direction() ||
+      !previous_item.EqualsRunSegment(item))
+    return nullptr;
+
+  // The preceding character is part of the shaping context.
+  const unsigned start = item.StartOffset();
+  if (start && text[start - 1] != previous_text[start - 1])
+    return nullptr;
+
+  const unsigned end = std::min(item.EndOffset(), previous_item.EndOffset());
+  unsigned edit_offset = start;
+  while (edit_offset < end && text[edit_offset] == previous_text[edit_offset])
+    edit_offset++;
+  if (edit_offset == start)
+    return nullptr;
+
+  // The glyphs of the character before the edit may have been affected by
+  // the characters that followed them.
+  const ShapeResult& previous_result = *previous_item.TextShapeResult();
+  const unsigned last_safe =
+      previous_result.PreviousSafeToBreakOffset(edit_offset - 1);
+  if (last_safe <= start)
+    return nullptr;
+
+  scoped_refptr<ShapeResult> shape_result =
+      previous_result.SubRange(start, last_safe);
+  RunSegmenter::RunSegmenterRange range = item.CreateRunSegmenterRange();
+  scoped_refptr<ShapeResult> rest_result = shaper.Shape(
+      &font, item.Direction(), last_safe, item.EndOffset(), &range);
+  rest_result->CopyRange(last_safe, item.EndOffset(), shape_result.get());
+  return shape_result;
+}
+
 // Determine if reshape is needed for ::first-line style.
 bool FirstLineNeedsReshape(const ComputedStyle& first_line_style,
                            const ComputedStyle& base_style) {
@@ -473,12 +537,14 @@ void NGInlineNode::SegmentBidiRuns(NGInlineNodeData* data) {
 void NGInlineNode::ShapeText(NGInlineItemsData* data,
                              NGInlineItemsData* previous_data) {
   ShapeText(data->text_content, &data->items,
-            previous_data ? &previous_data->text_content : nullptr);
+            previous_data ? &previous_data->text_content : nullptr,
+            previous_data ? &previous_data->items : nullptr);
 }
 
 void NGInlineNode::ShapeText(const String& text_content,
                              Vector<NGInlineItem>* items,
-                             const String* previous_text) {
+                             const String* previous_text,
+                             const Vector<NGInlineItem>* previous_items) {
   // Provide full context of the entire node to the shaper.
   HarfBuzzShaper shaper(text_content);
   ShapeResultSpacing<String> spacing(text_content);
@@ -560,6 +626,22 @@ void NGInlineNode::ShapeText(const String& text_content,
       continue;
     }
 
+    // If the text of a single item was edited, e.g. appended to, reuse the
+    // glyphs before the edit and only reshape the rest.
+    if (previous_items && end_offset == start_item.EndOffset() &&
+        !spacing.SetSpacing(font.GetFontDescription())) {
+      if (const NGInlineItem* previous_item =
+              FindPreviousTextItem(*previous_items, start_item)) {
+        scoped_refptr<ShapeResult> shape_result = ReshapeEditedItem(
+            shaper, text_content, start_item, *previous_text, *previous_item);
+        if (shape_result) {
+          start_item.shape_result_ = std::move(shape_result);
+          index++;
+          continue;
+        }
+      }
+    }
+
     // Shape each item with the full context of the entire node.
     RunSegmenter::RunSegmenterRange range =
         start_item.CreateRunSegmenterRange();
@@ -90,7 +90,8 @@ class CORE_EXPORT NGInlineNode : public NGLayoutInputNode {
                  NGInlineItemsData* previous_data = nullptr);
   void ShapeText(const String& text,
                  Vector<NGInlineItem>*,
-                 const String* previous_text);
+                 const String* previous_text,
+                 const Vector<NGInlineItem>* previous_items = nullptr);
   void ShapeTextForFirstLineIfNeeded(NGInlineNodeData*);
   void AssociateItemsWithInlines(NGInlineNodeData*);
 
@@ -0,0 +1,36 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/dom/text.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_layout_test.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+
+namespace blink {
+
+class NGInlineNodePerfTest : public NGLayoutTest {};
+
+// Appends to a long paragraph one word at a time, as chat and log views do,
+// and lays out after each append.
+TEST_F(NGInlineNodePerfTest, AppendToParagraph) {
+  StringBuilder paragraph;
+  for (unsigned i = 0; i < 2000; i++)
+    paragraph.Append("lorem ipsum ");
+  SetBodyInnerHTML("<div id=log style='width:400px'></div>");
+  Text* text = Text::Create(GetDocument(), paragraph.ToString());
+  GetElementById("log")->appendChild(text);
+  UpdateAllLifecyclePhases();
+
+  const unsigned kIterationCount = 200;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (unsigned count = 0; count < kIterationCount; count++) {
+    text->appendData("dolor ");
+    UpdateAllLifecyclePhases();
+  }
+  LOG(ERROR) << "  Time to append and lay out " << kIterationCount
+             << " words: "
+             << (base::TimeTicks::Now() - start).InMilliseconds() << "ms";
+}
+
+}  // namespace blink
@@ -532,6 +532,32 @@ TEST_F(NGInlineNodeTest, InvalidateSetTextWithOffset) {
   EXPECT_TRUE(layout_block_flow_->NeedsCollectInlines());
 }
 
+TEST_F(NGInlineNodeTest, ReshapeAppendedText) {
+  SetupHtml("t",
+            "<div id=t>before</div>"
+            "<div id=expected>before after</div>");
+  Text* text = ToText(GetElementById("t")->firstChild());
+  text->appendData(" after");
+  ForceLayout();
+  EXPECT_EQ(String("before after"), GetText());
+  ASSERT_EQ(1u, Items().size());
+
+  // The glyphs before the edit are reused; the result should be the same as
+  // shaping the whole text.
+  const ShapeResult* result = Items()[0].TextShapeResult();
+  ASSERT_TRUE(result);
+  LayoutNGBlockFlow* expected_block =
+      ToLayoutNGBlockFlow(GetLayoutObjectByElementId("expected"));
+  const ShapeResult* expected_result =
+      NGInlineNodeForTest::Items(*expected_block->GetNGInlineNodeData())[0]
+          .TextShapeResult();
+  ASSERT_TRUE(expected_result);
+  EXPECT_EQ(0u, result->StartIndexForResult());
+  EXPECT_EQ(12u, result->EndIndexForResult());
+  EXPECT_EQ(expected_result->NumCharacters(), result->NumCharacters());
+  EXPECT_EQ(expected_result->SnappedWidth(), result->SnappedWidth());
+}
+
 TEST_F(NGInlineNodeTest, InvalidateAddAbsolute) {
   SetupHtml("t",
             "<style>span { position: absolute; }</style>"
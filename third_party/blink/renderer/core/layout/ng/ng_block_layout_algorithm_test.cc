@@ -137,6 +137,42 @@ TEST_F(NGBlockLayoutAlgorithmTest, Caching) {
   EXPECT_EQ(result.get(), nullptr);
 }
 
+TEST_F(NGBlockLayoutAlgorithmTest, CachingCounters) {
+  ScopedLayoutNGFragmentCachingForTest layout_ng_fragment_caching(true);
+
+  SetBodyInnerHTML(R"HTML(
+    <div id="box" style="width:30px; height:40px"></div>
+  )HTML");
+
+  scoped_refptr<NGConstraintSpace> space =
+      ConstructBlockLayoutTestConstraintSpace(
+          WritingMode::kHorizontalTb, TextDirection::kLtr,
+          NGLogicalSize(LayoutUnit(100), NGSizeIndefinite));
+
+  LayoutBlockFlow* block_flow =
+      ToLayoutBlockFlow(GetLayoutObjectByElementId("box"));
+  NGBlockNode node(block_flow);
+  const LayoutView& view = GetLayoutView();
+  unsigned hits = view.LayoutResultCacheHits();
+  unsigned misses = view.LayoutResultCacheMisses();
+
+  // The document was laid out with a different available width.
+  node.Layout(*space, nullptr);
+  EXPECT_EQ(hits, view.LayoutResultCacheHits());
+  EXPECT_EQ(misses + 1, view.LayoutResultCacheMisses());
+
+  node.Layout(*space, nullptr);
+  EXPECT_EQ(hits + 1, view.LayoutResultCacheHits());
+  EXPECT_EQ(misses + 1, view.LayoutResultCacheMisses());
+
+  space = ConstructBlockLayoutTestConstraintSpace(
+      WritingMode::kHorizontalTb, TextDirection::kLtr,
+      NGLogicalSize(LayoutUnit(200), NGSizeIndefinite));
+  node.Layout(*space, nullptr);
+  EXPECT_EQ(hits + 1, view.LayoutResultCacheHits());
+  EXPECT_EQ(misses + 2, view.LayoutResultCacheMisses());
+}
+
 // Verifies that two children are laid out with the correct size and position.
 TEST_F(NGBlockLayoutAlgorithmTest, LayoutBlockChildren) {
   SetBodyInnerHTML(R"HTML(
@@ -157,6 +157,8 @@ scoped_refptr<NGLayoutResult> NGBlockNode::Layout(
   if (box_->IsLayoutNGMixin()) {
     layout_result = ToLayoutBlockFlow(box_)->CachedLayoutResult(
         constraint_space, break_token);
+    if (RuntimeEnabledFeatures::LayoutNGFragmentCachingEnabled())
+      box_->View()->CountLayoutResultCacheLookup(!!layout_result);
     if (layout_result) {
       // TODO(layoutng): Figure out why these two call can't be inside the
       // !constraint_space.IsIntermediateLayout() block below.
@@ -26,9 +26,15 @@
 
 #include "third_party/blink/renderer/core/loader/resource/css_style_sheet_resource.h"
 
+#include <utility>
+
 #include "services/network/public/mojom/request_context_frame_type.mojom-blink.h"
+#include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/public/platform/web_thread.h"
+#include "third_party/blink/renderer/core/css/parser/css_tokenized_sheet.h"
 #include "third_party/blink/renderer/core/css/style_sheet_contents.h"
 #include "third_party/blink/renderer/core/frame/web_feature.h"
+#include "third_party/blink/renderer/platform/cross_thread_functional.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_parameters.h"
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
@@ -37,6 +43,8 @@
 #include "third_party/blink/renderer/platform/network/http_names.h"
 #include "third_party/blink/renderer/platform/network/mime/mime_type_registry.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+#include "third_party/blink/renderer/platform/scheduler/public/background_scheduler.h"
+#include "third_party/blink/renderer/platform/web_task_runner.h"
 #include "third_party/blink/renderer/platform/weborigin/security_policy.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
 
@@ -128,6 +136,62 @@ void CSSStyleSheetResource::NotifyFinished() {
   if (Data())
     SetDecodedSheetText(DecodedText());
 
+  // Tokenize the sheet off the main thread before telling the clients, so
+  // that only parsing the rules is left for them to do on the main thread.
+  if (RuntimeEnabledFeatures::OffMainThreadCSSTokenizationEnabled() &&
+      !ErrorOccurred() && !decoded_sheet_text_.IsEmpty() &&
+      !is_tokenizing_sheet_) {
+    is_tokenizing_sheet_ = true;
+    BackgroundScheduler::PostOnBackgroundThread(
+        FROM_HERE,
+        CrossThreadBind(
+            &CSSStyleSheetResource::TokenizeSheetOnBackgroundThread,
+            WrapCrossThreadPersistent(this),
+            Platform::Current()->CurrentThread()->GetTaskRunner(),
+            WTF::Passed(std::make_unique<CSSTokenizedSheet>(
+                decoded_sheet_text_.IsolatedCopy())),
+            decoded_sheet_text_version_));
+    return;
+  }
+
+  NotifyClientsFinished();
+}
+
+// static
+void CSSStyleSheetResource::TokenizeSheetOnBackgroundThread(
+    CSSStyleSheetResource* resource,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+    std::unique_ptr<CSSTokenizedSheet> tokenized_sheet,
+    unsigned decoded_sheet_text_version) {
+  DCHECK(!IsMainThread());
+  tokenized_sheet->Tokenize();
+  PostCrossThreadTask(
+      *task_runner, FROM_HERE,
+      CrossThreadBind(&CSSStyleSheetResource::DidTokenizeSheet,
+                      WrapCrossThreadPersistent(resource),
+                      WTF::Passed(std::move(tokenized_sheet)),
+                      decoded_sheet_text_version));
+}
+
+void CSSStyleSheetResource::DidTokenizeSheet(
+    std::unique_ptr<CSSTokenizedSheet> tokenized_sheet,
+    unsigned decoded_sheet_text_version) {
+  DCHECK(is_tokenizing_sheet_);
+  is_tokenizing_sheet_ = false;
+  // The resource may be loading again, in which case the clients are told once
+  // that finishes.
+  if (!IsLoaded())
+    return;
+  if (decoded_sheet_text_version == decoded_sheet_text_version_)
+    tokenized_sheet_ = std::move(tokenized_sheet);
+  NotifyClientsFinished();
+}
+
+std::unique_ptr<CSSTokenizedSheet> CSSStyleSheetResource::TakeTokenizedSheet() {
+  return std::move(tokenized_sheet_);
+}
+
+void CSSStyleSheetResource::NotifyClientsFinished() {
   Resource::NotifyFinished();
 
   // Clear raw bytes as now we have the full decoded sheet text.
@@ -243,6 +307,8 @@ void CSSStyleSheetResource::SaveParsedStyleSheet(StyleSheetContents* sheet) {
 void CSSStyleSheetResource::SetDecodedSheetText(
     const String& decoded_sheet_text) {
   decoded_sheet_text_ = decoded_sheet_text;
+  ++decoded_sheet_text_version_;
+  tokenized_sheet_.reset();
   UpdateDecodedSize();
 }
 
@@ -26,6 +26,10 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_LOADER_RESOURCE_CSS_STYLE_SHEET_RESOURCE_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_LOADER_RESOURCE_CSS_STYLE_SHEET_RESOURCE_H_
 
+#include <memory>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/single_thread_task_runner.h"
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/core/loader/resource/text_resource.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
@@ -35,6 +39,7 @@
 namespace blink {
 
 class CSSParserContext;
+class CSSTokenizedSheet;
 class FetchParameters;
 class KURL;
 class ResourceFetcher;
@@ -57,6 +62,9 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
                          MIMETypeCheck = MIMETypeCheck::kStrict) const;
   StyleSheetContents* CreateParsedStyleSheetFromCache(const CSSParserContext*);
   void SaveParsedStyleSheet(StyleSheetContents*);
+  // Returns the tokens of SheetText() if it was tokenized off the main thread
+  // and they haven't been taken yet.
+  std::unique_ptr<CSSTokenizedSheet> TakeTokenizedSheet();
   ReferrerPolicy GetReferrerPolicy() const;
 
  private:
@@ -79,6 +87,15 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
 
   bool CanUseSheet(const CSSParserContext*, MIMETypeCheck) const;
   void NotifyFinished() override;
+  void NotifyClientsFinished();
+
+  static void TokenizeSheetOnBackgroundThread(
+      CSSStyleSheetResource*,
+      scoped_refptr<base::SingleThreadTaskRunner>,
+      std::unique_ptr<CSSTokenizedSheet>,
+      unsigned decoded_sheet_text_version);
+  void DidTokenizeSheet(std::unique_ptr<CSSTokenizedSheet>,
+                        unsigned decoded_sheet_text_version);
 
   void SetParsedStyleSheetCache(StyleSheetContents*);
   void SetDecodedSheetText(const String&);
@@ -90,6 +107,16 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
   // Decoded sheet text cache is available iff loading this CSS resource is
   // successfully complete.
   String decoded_sheet_text_;
+  // Changes with |decoded_sheet_text_|, so that tokens of an older text are
+  // dropped.
+  unsigned decoded_sheet_text_version_ = 0;
+
+  // Set while the sheet is tokenized off the main thread, during which the
+  // clients are not notified yet.
+  bool is_tokenizing_sheet_ = false;
+  // Only used by the first parse, which the parsed sheet cache saves the
+  // others from.
+  std::unique_ptr<CSSTokenizedSheet> tokenized_sheet_;
 
   Member<StyleSheetContents> parsed_style_sheet_cache_;
 };
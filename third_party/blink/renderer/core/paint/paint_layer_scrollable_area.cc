@@ -482,7 +482,13 @@ void PaintLayerScrollableArea::UpdateScrollOffset(
         GetLayoutBox()->GetNode());
   }
 
-  GetLayoutBox()->View()->ClearHitTestCache();
+  // Hit test results outside a scroller don't depend on its scroll offset.
+  // Layout clears the whole cache anyway, and the bounding box of the scroller
+  // may not be up to date during layout.
+  if (is_root_layer || frame_view->IsInPerformLayout())
+    GetLayoutBox()->View()->ClearHitTestCache();
+  else
+    GetLayoutBox()->View()->ClearHitTestCacheForScroll(*GetLayoutBox());
 
   // Inform the FrameLoader of the new scroll position, so it can be restored
   // when navigating back.
@@ -372,6 +372,30 @@ unsigned Internals::hitTestCacheHits(Document* doc,
   return doc->GetLayoutView()->HitTestCacheHits();
 }
 
+unsigned Internals::layoutResultCacheHits(
+    Document* doc,
+    ExceptionState& exception_state) const {
+  if (!doc) {
+    exception_state.ThrowDOMException(DOMExceptionCode::kInvalidAccessError,
+                                      "Must supply document to check");
+    return 0;
+  }
+
+  return doc->GetLayoutView()->LayoutResultCacheHits();
+}
+
+unsigned Internals::layoutResultCacheMisses(
+    Document* doc,
+    ExceptionState& exception_state) const {
+  if (!doc) {
+    exception_state.ThrowDOMException(DOMExceptionCode::kInvalidAccessError,
+                                      "Must supply document to check");
+    return 0;
+  }
+
+  return doc->GetLayoutView()->LayoutResultCacheMisses();
+}
+
 Element* Internals::elementFromPoint(Document* doc,
                                      double x,
                                      double y,
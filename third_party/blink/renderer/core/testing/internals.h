@@ -151,6 +151,8 @@ class Internals final : public ScriptWrappable {
   unsigned needsLayoutCount(ExceptionState&) const;
   unsigned hitTestCount(Document*, ExceptionState&) const;
   unsigned hitTestCacheHits(Document*, ExceptionState&) const;
+  unsigned layoutResultCacheHits(Document*, ExceptionState&) const;
+  unsigned layoutResultCacheMisses(Document*, ExceptionState&) const;
   Element* elementFromPoint(Document*,
                             double x,
                             double y,
@@ -29,6 +29,7 @@
 
 #include "third_party/blink/renderer/platform/fonts/font_cache.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 
@@ -199,14 +200,59 @@ ShapeCache* FontCache::GetShapeCache(const FallbackListCompositeKey& key) {
   if (it == fallback_list_shaper_cache_.end()) {
     result = new ShapeCache();
     fallback_list_shaper_cache_.Set(key, base::WrapUnique(result));
+    shape_caches_added_ = true;
   } else {
     result = it->value.get();
   }
+  shape_cache_last_use_.Set(result, ++shape_cache_use_count_);
 
   DCHECK(result);
   return result;
 }
 
+void FontCache::DidUseShapeCache(const ShapeCache* cache) {
+  auto it = shape_cache_last_use_.find(cache);
+  if (it != shape_cache_last_use_.end())
+    it->value = ++shape_cache_use_count_;
+}
+
+void FontCache::ShrinkShapeCaches(size_t byte_budget) {
+  // Shape caches handed out must stay valid while purging is disabled.
+  if (purge_prevent_count_)
+    return;
+  shape_caches_added_ = false;
+
+  struct CacheUse {
+    uint64_t last_use;
+    size_t byte_size;
+    FallbackListCompositeKey key;
+  };
+  Vector<CacheUse> caches;
+  caches.ReserveInitialCapacity(fallback_list_shaper_cache_.size());
+  size_t total_size = 0;
+  for (const auto& entry : fallback_list_shaper_cache_) {
+    size_t byte_size = entry.value->ByteSize();
+    total_size += byte_size;
+    caches.push_back(CacheUse{shape_cache_last_use_.at(entry.value.get()),
+                              byte_size, entry.key});
+  }
+  if (total_size <= byte_budget)
+    return;
+
+  std::sort(caches.begin(), caches.end(),
+            [](const CacheUse& a, const CacheUse& b) {
+              return a.last_use < b.last_use;
+            });
+  for (const CacheUse& cache : caches) {
+    if (total_size <= byte_budget)
+      break;
+    auto it = fallback_list_shaper_cache_.find(cache.key);
+    shape_cache_last_use_.erase(it->value.get());
+    fallback_list_shaper_cache_.erase(it);
+    total_size -= cache.byte_size;
+  }
+}
+
 void FontCache::SetFontManager(sk_sp<SkFontMgr> font_manager) {
   DCHECK(!static_font_manager_);
   static_font_manager_ = font_manager.release();
@@ -329,6 +375,8 @@ void FontCache::PurgeFallbackListShaperCache() {
     items += iter->value->size();
   }
   fallback_list_shaper_cache_.clear();
+  shape_cache_last_use_.clear();
+  shape_caches_added_ = false;
   DEFINE_THREAD_SAFE_STATIC_LOCAL(CustomCountHistogram, shape_cache_histogram,
                                   ("Blink.Fonts.ShapeCache", 1, 1000000, 50));
   shape_cache_histogram.Count(items);
@@ -345,8 +393,11 @@ void FontCache::Purge(PurgeSeverity purge_severity) {
   if (purge_prevent_count_)
     return;
 
-  if (!font_data_cache_.Purge(purge_severity))
+  if (!font_data_cache_.Purge(purge_severity)) {
+    if (shape_caches_added_)
+      ShrinkShapeCaches(kShapeCacheByteBudget);
     return;
+  }
 
   PurgePlatformFontDataCache();
   PurgeFallbackListShaperCache();
@@ -429,12 +480,15 @@ void FontCache::DumpShapeResultCache(
   base::trace_event::MemoryAllocatorDump* dump =
       memory_dump->CreateAllocatorDump("font_caches/shape_caches");
   size_t shape_result_cache_size = 0;
+  size_t shape_result_count = 0;
   FallbackListShaperCache::iterator iter;
   for (iter = fallback_list_shaper_cache_.begin();
        iter != fallback_list_shaper_cache_.end(); ++iter) {
     shape_result_cache_size += iter->value->ByteSize();
+    shape_result_count += iter->value->size();
   }
   dump->AddScalar("size", "bytes", shape_result_cache_size);
+  dump->AddScalar("object_count", "objects", shape_result_count);
   memory_dump->AddSuballocation(dump->guid(),
                                 WTF::Partitions::kAllocatedObjectPoolName);
 }
@@ -148,6 +148,19 @@ class PLATFORM_EXPORT FontCache {
   // disable/enablePurging.
   ShapeCache* GetShapeCache(const FallbackListCompositeKey&);
 
+  // Marks a shape cache which is looked up through a pointer kept from
+  // GetShapeCache() as used, so that ShrinkShapeCaches() keeps it longer.
+  void DidUseShapeCache(const ShapeCache*);
+
+  // The shape caches are shrunk to this many bytes when purging is enabled
+  // after new caches were created.
+  static const size_t kShapeCacheByteBudget = 16 * 1024 * 1024;
+
+  // Deletes the least recently used shape caches until the total size of
+  // the remaining ones is at most |byte_budget|. Does nothing while purging is
+  // disabled.
+  void ShrinkShapeCaches(size_t byte_budget);
+
   void AddClient(FontCacheClient*);
 
   unsigned short Generation();
@@ -336,6 +349,11 @@ class PLATFORM_EXPORT FontCache {
   Persistent<HeapHashSet<WeakMember<FontCacheClient>>> font_cache_clients_;
   FontPlatformDataCache font_platform_data_cache_;
   FallbackListShaperCache fallback_list_shaper_cache_;
+  // When each shape cache was last used, counted in GetShapeCache() and
+  // DidUseShapeCache() calls.
+  HashMap<const ShapeCache*, uint64_t> shape_cache_last_use_;
+  uint64_t shape_cache_use_count_ = 0;
+  bool shape_caches_added_ = false;
   FontDataCache font_data_cache_;
 
   void PurgePlatformFontDataCache();
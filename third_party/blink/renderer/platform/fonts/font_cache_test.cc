@@ -7,7 +7,9 @@
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/platform/fonts/fallback_list_composite_key.h"
 #include "third_party/blink/renderer/platform/fonts/font_description.h"
+#include "third_party/blink/renderer/platform/fonts/shaping/shape_cache.h"
 #include "third_party/blink/renderer/platform/fonts/simple_font_data.h"
 #include "third_party/blink/renderer/platform/testing/testing_platform_support.h"
 
@@ -63,6 +65,32 @@ TEST(FontCache, firstAvailableOrFirst) {
             FontCache::FirstAvailableOrFirst(", not exist, not exist"));
 }
 
+TEST(FontCache, ShrinkShapeCaches) {
+  FontCache* font_cache = FontCache::GetFontCache();
+  ASSERT_TRUE(font_cache);
+
+  FontDescription small_description;
+  small_description.SetComputedSize(12);
+  FontDescription large_description;
+  large_description.SetComputedSize(48);
+  base::WeakPtr<ShapeCache> small_cache =
+      font_cache
+          ->GetShapeCache(FallbackListCompositeKey(small_description))
+          ->GetWeakPtr();
+  base::WeakPtr<ShapeCache> large_cache =
+      font_cache
+          ->GetShapeCache(FallbackListCompositeKey(large_description))
+          ->GetWeakPtr();
+
+  // Caches within the budget are kept.
+  font_cache->ShrinkShapeCaches(FontCache::kShapeCacheByteBudget);
+  EXPECT_TRUE(small_cache);
+  EXPECT_TRUE(large_cache);
+  EXPECT_EQ(small_cache.get(),
+            font_cache->GetShapeCache(
+                FallbackListCompositeKey(small_description)));
+}
+
 #if !defined(OS_MACOSX)
 TEST(FontCache, systemFont) {
   FontCache::SystemFontFamily();
@@ -62,6 +62,8 @@ class PLATFORM_EXPORT FontFallbackList : public RefCounted<FontFallbackList> {
       FallbackListCompositeKey key = CompositeKey(font_description);
       shape_cache_ =
           FontCache::GetFontCache()->GetShapeCache(key)->GetWeakPtr();
+    } else {
+      FontCache::GetFontCache()->DidUseShapeCache(shape_cache_.get());
     }
     DCHECK(shape_cache_);
     if (GetFontSelector())
@@ -38,6 +38,13 @@ void FontGlobalContext::ClearMemory() {
   GetFontCache().Invalidate();
 }
 
+void FontGlobalContext::ReduceMemory() {
+  if (!Get(kDoNotCreate))
+    return;
+
+  GetFontCache().ShrinkShapeCaches(FontCache::kShapeCacheByteBudget / 4);
+}
+
 void FontGlobalContext::ClearForTesting() {
   FontGlobalContext* ctx = Get();
   ctx->font_cache_.Invalidate();
@@ -46,6 +46,10 @@ class PLATFORM_EXPORT FontGlobalContext {
   // Called by MemoryCoordinator to clear memory.
   static void ClearMemory();
 
+  // Called by MemoryCoordinator under moderate memory pressure. Only drops
+  // caches that don't require a relayout to be refilled.
+  static void ReduceMemory();
+
   static void ClearForTesting();
 
  private:
@@ -34,10 +34,44 @@
 #include "third_party/blink/renderer/platform/graphics/image_decoding_store.h"
 #include "third_party/blink/renderer/platform/image-decoders/image_decoder.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
 #include "third_party/skia/include/core/SkYUVSizeInfo.h"
 
 namespace blink {
 
+namespace {
+
+// The decoder that read the YUV component sizes of an image, kept so that its
+// planes can be decoded without parsing the headers again. Only the most
+// recent one is kept, and ImageFrameGenerator::ClearYUVDecoder() drops it.
+struct KeptYUVDecoder {
+  Mutex mutex;
+  const ImageFrameGenerator* generator = nullptr;
+  scoped_refptr<SegmentReader> data;
+  std::unique_ptr<ImageDecoder> decoder;
+};
+
+KeptYUVDecoder& GetKeptYUVDecoder() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(KeptYUVDecoder, kept_yuv_decoder, ());
+  return kept_yuv_decoder;
+}
+
+// Replaces the kept decoder, and returns the previous one so that it is
+// deleted outside of the lock.
+std::unique_ptr<ImageDecoder> SwapKeptYUVDecoder(
+    const ImageFrameGenerator* generator,
+    SegmentReader* data,
+    std::unique_ptr<ImageDecoder> decoder) {
+  KeptYUVDecoder& kept = GetKeptYUVDecoder();
+  MutexLocker lock(kept.mutex);
+  kept.generator = generator;
+  kept.data = data;
+  kept.decoder.swap(decoder);
+  return decoder;
+}
+
+}  // namespace
+
 static bool UpdateYUVComponentSizes(ImageDecoder* decoder,
                                     SkISize component_sizes[3],
                                     size_t component_width_bytes[3]) {
@@ -74,6 +108,22 @@ ImageFrameGenerator::ImageFrameGenerator(const SkISize& full_size,
 
 ImageFrameGenerator::~ImageFrameGenerator() {
   ImageDecodingStore::Instance().RemoveCacheIndexedByGenerator(this);
+
+  std::unique_ptr<ImageDecoder> kept_decoder;
+  {
+    KeptYUVDecoder& kept = GetKeptYUVDecoder();
+    MutexLocker lock(kept.mutex);
+    if (kept.generator == this) {
+      kept.generator = nullptr;
+      kept.data = nullptr;
+      kept_decoder = std::move(kept.decoder);
+    }
+  }
+}
+
+// static
+void ImageFrameGenerator::ClearYUVDecoder() {
+  SwapKeptYUVDecoder(nullptr, nullptr, nullptr);
 }
 
 bool ImageFrameGenerator::DecodeAndScale(
@@ -164,10 +214,7 @@ bool ImageFrameGenerator::DecodeToYUV(SegmentReader* data,
     return false;
   }
 
-  const bool data_complete = true;
-  std::unique_ptr<ImageDecoder> decoder = ImageDecoder::Create(
-      data, data_complete, ImageDecoder::kAlphaPremultiplied,
-      ImageDecoder::kDefaultBitDepth, decoder_color_behavior_);
+  std::unique_ptr<ImageDecoder> decoder = TakeYUVDecoder(data);
   // getYUVComponentSizes was already called and was successful, so
   // ImageDecoder::create must succeed.
   DCHECK(decoder);
@@ -218,10 +265,7 @@ bool ImageFrameGenerator::GetYUVComponentSizes(SegmentReader* data,
   if (yuv_decoding_failed_)
     return false;
 
-  const bool data_complete = true;
-  std::unique_ptr<ImageDecoder> decoder = ImageDecoder::Create(
-      data, data_complete, ImageDecoder::kAlphaPremultiplied,
-      ImageDecoder::kDefaultBitDepth, decoder_color_behavior_);
+  std::unique_ptr<ImageDecoder> decoder = TakeYUVDecoder(data);
   if (!decoder)
     return false;
 
@@ -231,8 +275,36 @@ bool ImageFrameGenerator::GetYUVComponentSizes(SegmentReader* data,
       std::make_unique<ImagePlanes>();
   decoder->SetImagePlanes(std::move(dummy_image_planes));
 
-  return UpdateYUVComponentSizes(decoder.get(), size_info->fSizes,
-                                 size_info->fWidthBytes);
+  if (!UpdateYUVComponentSizes(decoder.get(), size_info->fSizes,
+                               size_info->fWidthBytes)) {
+    return false;
+  }
+
+  // The planes are often requested right after their sizes, so keep the
+  // decoder that already parsed the headers for DecodeToYUV().
+  SwapKeptYUVDecoder(this, data, std::move(decoder));
+  return true;
+}
+
+std::unique_ptr<ImageDecoder> ImageFrameGenerator::TakeYUVDecoder(
+    SegmentReader* data) {
+  generator_mutex_.AssertAcquired();
+
+  {
+    KeptYUVDecoder& kept = GetKeptYUVDecoder();
+    MutexLocker lock(kept.mutex);
+    if (kept.decoder && kept.generator == this && kept.data.get() == data) {
+      kept.generator = nullptr;
+      kept.data = nullptr;
+      return std::move(kept.decoder);
+    }
+  }
+
+  const bool data_complete = true;
+  return ImageDecoder::Create(data, data_complete,
+                              ImageDecoder::kAlphaPremultiplied,
+                              ImageDecoder::kDefaultBitDepth,
+                              decoder_color_behavior_);
 }
 
 SkISize ImageFrameGenerator::GetSupportedDecodeSize(
@@ -114,6 +114,10 @@ class PLATFORM_EXPORT ImageFrameGenerator final
   // decodeToYUV().
   bool GetYUVComponentSizes(SegmentReader*, SkYUVSizeInfo*);
 
+  // GetYUVComponentSizes() keeps the last decoder it used for the following
+  // DecodeToYUV(). This drops it, e.g. to release memory.
+  static void ClearYUVDecoder();
+
  private:
   class ClientMutexLocker {
    public:
@@ -142,6 +146,10 @@ class PLATFORM_EXPORT ImageFrameGenerator final
 
   void SetHasAlpha(size_t index, bool has_alpha);
 
+  // Returns the decoder kept by GetYUVComponentSizes() for |data|, or a new
+  // one if it is gone.
+  std::unique_ptr<ImageDecoder> TakeYUVDecoder(SegmentReader* data);
+
   const SkISize full_size_;
   // Parameters used to create internal ImageDecoder objects.
   const ColorBehavior decoder_color_behavior_;
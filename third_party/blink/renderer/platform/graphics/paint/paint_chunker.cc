@@ -90,6 +90,18 @@ bool PaintChunker::IncrementDisplayItemIndex(const DisplayItem& item) {
   return true;
 }
 
+void PaintChunker::AppendCachedChunk(const PaintChunk& cached_chunk,
+                                     size_t begin_index) {
+  DCHECK_EQ(begin_index, chunks_.IsEmpty() ? 0u : LastChunk().end_index);
+  current_properties_ = cached_chunk.properties.GetPropertyTreeState();
+  chunks_.emplace_back(begin_index, begin_index + cached_chunk.size(),
+                       cached_chunk.id, current_properties_);
+  chunks_.back().outset_for_raster_effects =
+      cached_chunk.outset_for_raster_effects;
+  next_chunk_id_ = base::nullopt;
+  force_new_chunk_ = true;
+}
+
 Vector<PaintChunk> PaintChunker::ReleasePaintChunks() {
   next_chunk_id_ = base::nullopt;
   current_properties_ = UninitializedProperties();
@@ -40,6 +40,12 @@ class PLATFORM_EXPORT PaintChunker final {
   // Returns true if a new chunk is created.
   bool IncrementDisplayItemIndex(const DisplayItem&);
 
+  // Appends a chunk with the id, properties and raster effect outset of
+  // |cached_chunk|, for display items that have just been copied from it.
+  // |begin_index| is the index of the first of them in the new display item
+  // list. The next display item will start a new chunk.
+  void AppendCachedChunk(const PaintChunk& cached_chunk, size_t begin_index);
+
   const Vector<PaintChunk>& PaintChunks() const { return chunks_; }
 
   PaintChunk& PaintChunkAt(size_t i) { return chunks_[i]; }
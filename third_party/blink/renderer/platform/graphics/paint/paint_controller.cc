@@ -9,6 +9,7 @@
 #include "third_party/blink/renderer/platform/graphics/logging_canvas.h"
 #include "third_party/blink/renderer/platform/graphics/paint/drawing_display_item.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/traced_value.h"
 
 namespace blink {
 
@@ -133,6 +134,7 @@ bool PaintController::UseCachedSubsequenceIfPossible(
   }
 
   num_cached_new_items_ += markers->end - markers->start;
+  num_cached_new_subsequence_items_ += markers->end - markers->start;
 
   if (RuntimeEnabledFeatures::PaintUnderInvalidationCheckingEnabled()) {
     DCHECK(!IsCheckingUnderInvalidation());
@@ -255,6 +257,10 @@ void PaintController::ProcessNewItem(DisplayItem& display_item) {
       RuntimeEnabledFeatures::PaintUnderInvalidationCheckingEnabled())
     CheckUnderInvalidation();
 
+  UpdateFirstPainted(display_item);
+}
+
+void PaintController::UpdateFirstPainted(const DisplayItem& display_item) {
   if (!frame_first_paints_.back().first_painted && display_item.IsDrawing() &&
       // Here we ignore all document-background paintings because we don't
       // know if the background is default. ViewPainter should have called
@@ -416,14 +422,83 @@ void PaintController::CopyCachedSubsequence(size_t begin_index,
                                             size_t end_index) {
   DCHECK(!RuntimeEnabledFeatures::PaintUnderInvalidationCheckingEnabled());
 
+  auto properties_before_subsequence =
+      new_paint_chunks_.CurrentPaintChunkProperties();
+
+  if (!CopyCachedPaintChunks(begin_index, end_index))
+    CopyCachedDisplayItems(begin_index, end_index);
+
+  if (RuntimeEnabledFeatures::PaintUnderInvalidationCheckingEnabled()) {
+    under_invalidation_checking_end_ = end_index;
+    DCHECK(IsCheckingUnderInvalidation());
+  } else {
+    // Restore properties and force new chunk for any trailing display items
+    // after the cached subsequence without new properties.
+    new_paint_chunks_.ForceNewChunk();
+    UpdateCurrentPaintChunkProperties(base::nullopt,
+                                      properties_before_subsequence);
+  }
+}
+
+// A cached subsequence normally starts and ends at paint chunk boundaries
+// because BeginSubsequence() and EndSubsequence() force new chunks. In that
+// case the chunks are copied as a whole instead of feeding every display item
+// through the PaintChunker. Returns false without copying anything if the
+// subsequence doesn't cover whole chunks.
+bool PaintController::CopyCachedPaintChunks(size_t begin_index,
+                                            size_t end_index) {
+  const auto& cached_chunks = current_paint_artifact_->PaintChunks();
+  auto* begin_chunk =
+      current_paint_artifact_->FindChunkByDisplayItemIndex(begin_index);
+  DCHECK(begin_chunk != cached_chunks.end());
+  if (begin_chunk->begin_index != begin_index)
+    return false;
+  auto* end_chunk = begin_chunk;
+  while (end_chunk != cached_chunks.end() && end_chunk->end_index <= end_index)
+    ++end_chunk;
+  if (end_chunk == begin_chunk || (end_chunk - 1)->end_index != end_index)
+    return false;
+
+  auto& cached_items = current_paint_artifact_->GetDisplayItemList();
+  for (auto* cached_chunk = begin_chunk; cached_chunk != end_chunk;
+       ++cached_chunk) {
+    size_t new_chunk_begin_index = new_display_item_list_.size();
+    for (size_t current_index = cached_chunk->begin_index;
+         current_index < cached_chunk->end_index; ++current_index) {
+      SECURITY_CHECK(!cached_items[current_index].IsTombstone());
+#if DCHECK_IS_ON()
+      DCHECK(cached_items[current_index].Client().IsAlive());
+#endif
+      DisplayItem& item = MoveItemFromCurrentListToNewList(current_index);
+      UpdateFirstPainted(item);
+#if DCHECK_IS_ON()
+      if (usage_ == kMultiplePaints) {
+        AddToIndicesByClientMap(item.Client(),
+                                new_display_item_list_.size() - 1,
+                                new_display_item_indices_by_client_);
+      }
+#endif
+    }
+    new_paint_chunks_.AppendCachedChunk(*cached_chunk, new_chunk_begin_index);
+#if DCHECK_IS_ON()
+    if (new_paint_chunks_.LastChunk().is_cacheable) {
+      AddToIndicesByClientMap(new_paint_chunks_.LastChunk().id.client,
+                              new_paint_chunks_.LastChunkIndex(),
+                              new_paint_chunk_indices_by_client_);
+    }
+#endif
+  }
+  return true;
+}
+
+void PaintController::CopyCachedDisplayItems(size_t begin_index,
+                                             size_t end_index) {
   const DisplayItem* cached_item =
       &current_paint_artifact_->GetDisplayItemList()[begin_index];
 
   auto* cached_chunk =
       current_paint_artifact_->FindChunkByDisplayItemIndex(begin_index);
   DCHECK(cached_chunk != current_paint_artifact_->PaintChunks().end());
-  auto properties_before_subsequence =
-      new_paint_chunks_.CurrentPaintChunkProperties();
   UpdateCurrentPaintChunkPropertiesUsingIdWithFragment(
       cached_chunk->id, cached_chunk->properties.GetPropertyTreeState());
 
@@ -461,17 +536,6 @@ void PaintController::CopyCachedSubsequence(size_t begin_index,
             !cached_chunk->is_cacheable) ||
            new_paint_chunks_.LastChunk().Matches(*cached_chunk));
   }
-
-  if (RuntimeEnabledFeatures::PaintUnderInvalidationCheckingEnabled()) {
-    under_invalidation_checking_end_ = end_index;
-    DCHECK(IsCheckingUnderInvalidation());
-  } else {
-    // Restore properties and force new chunk for any trailing display items
-    // after the cached subsequence without new properties.
-    new_paint_chunks_.ForceNewChunk();
-    UpdateCurrentPaintChunkProperties(base::nullopt,
-                                      properties_before_subsequence);
-  }
 }
 
 void PaintController::ResetCurrentListIndices() {
@@ -483,13 +547,11 @@ void PaintController::ResetCurrentListIndices() {
 
 DISABLE_CFI_PERF
 void PaintController::CommitNewDisplayItems() {
-  TRACE_EVENT2("blink,benchmark", "PaintController::commitNewDisplayItems",
-               "current_display_list_size",
-               (int)current_paint_artifact_->GetDisplayItemList().size(),
-               "num_non_cached_new_items",
-               (int)new_display_item_list_.size() - num_cached_new_items_);
+  TRACE_EVENT1("blink,benchmark", "PaintController::commitNewDisplayItems",
+               "data", CommitStatsAsTracedValue());
 
   num_cached_new_items_ = 0;
+  num_cached_new_subsequence_items_ = 0;
 #if DCHECK_IS_ON()
   new_display_item_indices_by_client_.clear();
   new_paint_chunk_indices_by_client_.clear();
@@ -521,6 +583,21 @@ void PaintController::CommitNewDisplayItems() {
 #endif
 }
 
+std::unique_ptr<TracedValue> PaintController::CommitStatsAsTracedValue()
+    const {
+  std::unique_ptr<TracedValue> value = TracedValue::Create();
+  value->SetInteger(
+      "current_display_list_size",
+      static_cast<int>(current_paint_artifact_->GetDisplayItemList().size()));
+  value->SetInteger("num_cached_new_items", num_cached_new_items_);
+  value->SetInteger("num_cached_new_subsequence_items",
+                    num_cached_new_subsequence_items_);
+  value->SetInteger(
+      "num_non_cached_new_items",
+      static_cast<int>(new_display_item_list_.size()) - num_cached_new_items_);
+  return value;
+}
+
 void PaintController::FinishCycle() {
   if (usage_ == kTransient)
     return;
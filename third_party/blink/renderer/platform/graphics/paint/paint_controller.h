@@ -29,6 +29,8 @@
 
 namespace blink {
 
+class TracedValue;
+
 static const size_t kInitialDisplayItemListCapacityBytes = 512;
 
 // FrameFirstPaint stores first-paint, text or image painted for the
@@ -272,6 +274,7 @@ class PLATFORM_EXPORT PaintController {
 
   // Set new item state (cache skipping, etc) for a new item.
   void ProcessNewItem(DisplayItem&);
+  void UpdateFirstPainted(const DisplayItem&);
   DisplayItem& MoveItemFromCurrentListToNewList(size_t);
 
   // Maps clients to indices of display items or chunks of each client.
@@ -287,6 +290,10 @@ class PLATFORM_EXPORT PaintController {
   size_t FindCachedItem(const DisplayItem::Id&);
   size_t FindOutOfOrderCachedItemForward(const DisplayItem::Id&);
   void CopyCachedSubsequence(size_t begin_index, size_t end_index);
+  bool CopyCachedPaintChunks(size_t begin_index, size_t end_index);
+  void CopyCachedDisplayItems(size_t begin_index, size_t end_index);
+
+  std::unique_ptr<TracedValue> CommitStatsAsTracedValue() const;
 
   void UpdateCurrentPaintChunkPropertiesUsingIdWithFragment(
       const PaintChunk::Id& id_with_fragment,
@@ -356,7 +363,10 @@ class PLATFORM_EXPORT PaintController {
 
   int skipping_cache_count_ = 0;
 
+  // Numbers of display items copied from the cache since the last commit, in
+  // total and as part of cached subsequences. The rest have been re-recorded.
   int num_cached_new_items_ = 0;
+  int num_cached_new_subsequence_items_ = 0;
 
   // Stores indices to valid cacheable display items in
   // current_paint_artifact_.GetDisplayItemList() that have not been matched by
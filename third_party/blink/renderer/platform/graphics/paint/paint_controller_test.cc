@@ -632,18 +632,22 @@ TEST_P(PaintControllerTest, CachedSubsequenceForcePaintChunk) {
                                                          root_properties);
   DrawRect(context, root, kBackgroundType, FloatRect(100, 100, 100, 100));
   EXPECT_TRUE(GetPaintController().UseCachedSubsequenceIfPossible(container));
+  EXPECT_EQ(2, NumCachedNewItems());
+  EXPECT_EQ(2, NumCachedNewSubsequenceItems());
   DrawRect(context, root, kForegroundType, FloatRect(100, 100, 100, 100));
   CommitAndFinishCycle();
 
   // |container| should still receive its own PaintChunk because it is a cached
   // subsequence.
-  EXPECT_EQ(3u, GetPaintController().GetPaintArtifact().PaintChunks().size());
-  EXPECT_EQ(root,
-            GetPaintController().GetPaintArtifact().PaintChunks()[0].id.client);
-  EXPECT_EQ(container,
-            GetPaintController().GetPaintArtifact().PaintChunks()[1].id.client);
-  EXPECT_EQ(root,
-            GetPaintController().GetPaintArtifact().PaintChunks()[2].id.client);
+  const auto& chunks = GetPaintController().GetPaintArtifact().PaintChunks();
+  EXPECT_EQ(3u, chunks.size());
+  EXPECT_EQ(root, chunks[0].id.client);
+  EXPECT_EQ(container, chunks[1].id.client);
+  EXPECT_EQ(root, chunks[2].id.client);
+  EXPECT_EQ(1u, chunks[1].begin_index);
+  EXPECT_EQ(3u, chunks[1].end_index);
+  EXPECT_EQ(3u, chunks[2].begin_index);
+  EXPECT_EQ(0, NumCachedNewSubsequenceItems());
 }
 
 TEST_P(PaintControllerTest, CachedSubsequenceSwapOrder) {
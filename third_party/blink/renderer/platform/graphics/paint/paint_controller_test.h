@@ -54,6 +54,9 @@ class PaintControllerTestBase : public testing::Test {
   int NumCachedNewItems() const {
     return paint_controller_->num_cached_new_items_;
   }
+  int NumCachedNewSubsequenceItems() const {
+    return paint_controller_->num_cached_new_subsequence_items_;
+  }
 
 #if DCHECK_IS_ON()
   int NumSequentialMatches() const {
@@ -10,6 +10,7 @@
 #include "base/trace_event/process_memory_dump.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/heap/heap_stats_collector.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/web_memory_allocator_dump.h"
 #include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
 #include "third_party/blink/renderer/platform/wtf/threading.h"
@@ -33,6 +34,22 @@ void DumpMemoryTotals(base::trace_event::ProcessMemoryDump* memory_dump) {
                               ProcessHeap::TotalMarkedObjectSize());
 }
 
+void DumpCompactionStats(base::trace_event::ProcessMemoryDump* memory_dump) {
+  ThreadState* thread_state = ThreadState::Current();
+  if (!thread_state)
+    return;
+  // Compaction results of the last completed garbage collection. All values
+  // are zero if it did not compact.
+  const ThreadHeapStatsCollector::Event& event =
+      thread_state->Heap().stats_collector()->previous();
+  base::trace_event::MemoryAllocatorDump* compaction_dump =
+      memory_dump->CreateAllocatorDump("blink_gc/compaction");
+  compaction_dump->AddScalar("freed_size", "bytes",
+                             event.compaction_freed_bytes);
+  compaction_dump->AddScalar("freed_pages", "objects",
+                             event.compaction_freed_pages);
+}
+
 }  // namespace
 
 BlinkGCMemoryDumpProvider* BlinkGCMemoryDumpProvider::Instance() {
@@ -55,6 +72,7 @@ bool BlinkGCMemoryDumpProvider::OnMemoryDump(
         BlinkGC::kEagerSweeping, BlinkGC::GCReason::kForcedGC);
   }
   DumpMemoryTotals(memory_dump);
+  DumpCompactionStats(memory_dump);
 
   // Merge all dumps collected by ThreadHeap::collectGarbage.
   if (level_of_detail == MemoryDumpLevelOfDetail::DETAILED)
@@ -535,6 +535,11 @@ void ThreadHeap::TakeSnapshot(SnapshotType type) {
   thread_dump->AddScalar("dead_count", "objects", total_dead_count);
   thread_dump->AddScalar("live_size", "bytes", total_live_size);
   thread_dump->AddScalar("dead_size", "bytes", total_dead_size);
+  thread_dump->AddScalar("committed_size", "bytes",
+                         stats_collector()->allocated_space_bytes());
+  thread_dump->AddScalar("pooled_page_count", "objects",
+                         free_page_pool_->PooledPageCount());
+  thread_dump->AddScalar("pooled_size", "bytes", free_page_pool_->PooledSize());
 
   base::trace_event::MemoryAllocatorDump* heaps_dump =
       BlinkGCMemoryDumpProvider::Instance()
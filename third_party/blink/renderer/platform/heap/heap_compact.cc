@@ -42,6 +42,12 @@ class HeapCompact::MovableObjectFixups final {
     relocatable_pages_.insert(page);
   }
 
+  // Sizes the slot table for |count| slots upfront so that it is not rehashed
+  // repeatedly while the traced slots are added.
+  void ReserveCapacity(size_t count) {
+    fixups_.ReserveCapacityForSize(SafeCast<wtf_size_t>(count));
+  }
+
   void AddInteriorFixup(MovableReference* slot) {
     auto it = interior_fixups_.find(slot);
     // Ephemeron fixpoint iterations may cause repeated registrations.
@@ -489,6 +495,7 @@ void HeapCompact::StartThreadCompaction() {
     return;
 
   // The mapping between the slots and the backing stores are created
+  Fixups().ReserveCapacity(traced_slots_.size());
   for (auto** slot : traced_slots_) {
     if (*slot)
       Fixups().Add(slot);
@@ -919,8 +919,9 @@ Address NormalPageArena::OutOfLineAllocate(size_t allocation_size,
   if (result)
     return result;
 
-  // 5. Complete sweeping.
-  GetThreadState()->CompleteSweep();
+  // 5. Advance sweeping of the other arenas. Their free pages are not
+  // available to this arena, so sweeping is not completed all at once here.
+  GetThreadState()->AdvanceLazySweepOnAllocation();
 
   // 6. Check if we should trigger a GC.
   GetThreadState()->ScheduleGCIfNeeded();
@@ -981,9 +982,9 @@ Address LargeObjectArena::AllocateLargeObjectPage(size_t allocation_size,
   if (result)
     return result;
 
-  // 2. If we have failed in sweeping allocationSize bytes,
-  // we complete sweeping before allocating this large object.
-  GetThreadState()->CompleteSweep();
+  // 2. If we have failed in sweeping allocationSize bytes, we advance
+  // sweeping of the other arenas before allocating this large object.
+  GetThreadState()->AdvanceLazySweepOnAllocation();
 
   // 3. Check if we should trigger a GC.
   GetThreadState()->ScheduleGCIfNeeded();
@@ -110,11 +110,17 @@ TimeDelta ThreadHeapStatsCollector::estimated_marking_time() const {
 }
 
 double ThreadHeapStatsCollector::Event::marking_time_in_ms() const {
-  return (scope_data[kIncrementalMarkingStartMarking] +
-          scope_data[kIncrementalMarkingStep] +
-          scope_data[kIncrementalMarkingFinalizeMarking] +
-          scope_data[kAtomicPhaseMarking])
-      .InMillisecondsF();
+  return (incremental_marking_time() + atomic_marking_time()).InMillisecondsF();
+}
+
+TimeDelta ThreadHeapStatsCollector::Event::incremental_marking_time() const {
+  return scope_data[kIncrementalMarkingStartMarking] +
+         scope_data[kIncrementalMarkingStep];
+}
+
+TimeDelta ThreadHeapStatsCollector::Event::atomic_marking_time() const {
+  return scope_data[kIncrementalMarkingFinalizeMarking] +
+         scope_data[kAtomicPhaseMarking];
 }
 
 double ThreadHeapStatsCollector::Event::marking_time_in_bytes_per_second()
@@ -160,6 +160,10 @@ class PLATFORM_EXPORT ThreadHeapStatsCollector {
   struct PLATFORM_EXPORT Event {
     double marking_time_in_ms() const;
     double marking_time_in_bytes_per_second() const;
+    // The part of the marking time spent in incremental steps, interleaved
+    // with the mutator, and the part spent in the atomic pause.
+    TimeDelta incremental_marking_time() const;
+    TimeDelta atomic_marking_time() const;
     TimeDelta sweeping_time() const;
 
     // Marked bytes collected during sweeping.
@@ -229,6 +229,29 @@ TEST(ThreadHeapStatsCollectorTest, EventMarkingTimeInMsFromIncrementalGC) {
   EXPECT_DOUBLE_EQ(10.0, stats_collector.previous().marking_time_in_ms());
 }
 
+TEST(ThreadHeapStatsCollectorTest, EventIncrementalAndAtomicMarkingTime) {
+  ThreadHeapStatsCollector stats_collector;
+  stats_collector.NotifyMarkingStarted(BlinkGC::GCReason::kTesting);
+  stats_collector.IncreaseScopeTime(
+      ThreadHeapStatsCollector::kIncrementalMarkingStartMarking,
+      TimeDelta::FromMilliseconds(7));
+  stats_collector.IncreaseScopeTime(
+      ThreadHeapStatsCollector::kIncrementalMarkingStep,
+      TimeDelta::FromMilliseconds(2));
+  stats_collector.IncreaseScopeTime(
+      ThreadHeapStatsCollector::kIncrementalMarkingFinalizeMarking,
+      TimeDelta::FromMilliseconds(1));
+  stats_collector.IncreaseScopeTime(
+      ThreadHeapStatsCollector::kAtomicPhaseMarking,
+      TimeDelta::FromMilliseconds(4));
+  stats_collector.NotifyMarkingCompleted();
+  stats_collector.NotifySweepingCompleted();
+  EXPECT_EQ(TimeDelta::FromMilliseconds(9),
+            stats_collector.previous().incremental_marking_time());
+  EXPECT_EQ(TimeDelta::FromMilliseconds(5),
+            stats_collector.previous().atomic_marking_time());
+}
+
 TEST(ThreadHeapStatsCollectorTest, EventMarkingTimeInMsFromFullGC) {
   ThreadHeapStatsCollector stats_collector;
   stats_collector.NotifyMarkingStarted(BlinkGC::GCReason::kTesting);
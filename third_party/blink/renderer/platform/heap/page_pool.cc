@@ -35,6 +35,7 @@ void PagePool::Add(int index, PageMemory* memory) {
   memory->Decommit();
   PoolEntry* entry = new PoolEntry(memory, pool_[index]);
   pool_[index] = entry;
+  ++pooled_page_count_;
 }
 
 PageMemory* PagePool::Take(int index) {
@@ -43,6 +44,8 @@ PageMemory* PagePool::Take(int index) {
     PageMemory* memory = entry->data;
     DCHECK(memory);
     delete entry;
+    DCHECK(pooled_page_count_);
+    --pooled_page_count_;
     if (memory->Commit())
       return memory;
 
@@ -52,4 +55,8 @@ PageMemory* PagePool::Take(int index) {
   return nullptr;
 }
 
+size_t PagePool::PooledSize() const {
+  return pooled_page_count_ * kBlinkPageSize;
+}
+
 }  // namespace blink
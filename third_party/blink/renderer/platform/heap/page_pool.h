@@ -29,6 +29,11 @@ class PagePool {
   void Add(int, PageMemory*);
   PageMemory* Take(int);
 
+  // Number of pages held by the pool across all arenas. Pooled pages are
+  // decommitted, so they only account for reserved address space.
+  size_t PooledPageCount() const { return pooled_page_count_; }
+  size_t PooledSize() const;
+
  private:
   class PoolEntry {
     USING_FAST_MALLOC(PoolEntry);
@@ -41,6 +46,7 @@ class PagePool {
   };
 
   PoolEntry* pool_[BlinkGC::kNumberOfArenas];
+  size_t pooled_page_count_ = 0;
 };
 
 }  // namespace blink
@@ -94,6 +94,11 @@ const size_t kDefaultAllocatedObjectSizeThreshold = 100 * 1024;
 constexpr TimeDelta kDefaultIncrementalMarkingStepDuration =
     TimeDelta::FromMilliseconds(2);
 
+// Time spent sweeping other arenas when an allocation has exhausted its own
+// arena. AdvanceLazySweep() keeps 1ms of it as slack.
+constexpr TimeDelta kLazySweepOnAllocationDuration =
+    TimeDelta::FromMilliseconds(2);
+
 constexpr size_t kMaxTerminationGCLoops = 20;
 
 const char* GcReasonString(BlinkGC::GCReason reason) {
@@ -654,7 +659,12 @@ void ThreadState::ScheduleGCIfNeeded() {
   }
 
   if (ShouldForceConservativeGC()) {
-    CompleteSweep();
+    // The heuristics are based on the previous cycle until sweeping is done.
+    // Rather than sweeping everything at once from an allocation, sweeping is
+    // advanced in bounded steps and the heuristics are checked again once it
+    // has finished.
+    if (IsSweepingInProgress() && !AdvanceLazySweepOnAllocation())
+      return;
     if (ShouldForceConservativeGC()) {
       VLOG(2) << "[state:" << this << "] "
               << "ScheduleGCIfNeeded: Scheduled conservative GC";
@@ -665,6 +675,10 @@ void ThreadState::ScheduleGCIfNeeded() {
     }
   }
 
+  // Idle GCs are scheduled on allocations after sweeping is done.
+  if (IsSweepingInProgress())
+    return;
+
   if (ShouldScheduleIdleGC()) {
     VLOG(2) << "[state:" << this << "] "
             << "ScheduleGCIfNeeded: Scheduled idle GC";
@@ -1065,6 +1079,33 @@ void ThreadState::CompleteSweep() {
   PostSweep();
 }
 
+bool ThreadState::AdvanceLazySweepOnAllocation() {
+  DCHECK(CheckThread());
+  if (!IsSweepingInProgress())
+    return true;
+  if (SweepForbidden())
+    return false;
+
+  bool sweep_completed = false;
+  {
+    const bool was_in_atomic_pause = in_atomic_pause();
+    if (!was_in_atomic_pause)
+      EnterAtomicPause();
+    ScriptForbiddenScope script_forbidden;
+    SweepForbiddenScope scope(this);
+    ThreadHeapStatsCollector::EnabledScope stats_scope(
+        Heap().stats_collector(),
+        ThreadHeapStatsCollector::kLazySweepOnAllocation);
+    sweep_completed = Heap().AdvanceLazySweep(CurrentTimeTicks() +
+                                              kLazySweepOnAllocationDuration);
+    if (!was_in_atomic_pause)
+      LeaveAtomicPause();
+  }
+  if (sweep_completed)
+    PostSweep();
+  return sweep_completed;
+}
+
 BlinkGCObserver::BlinkGCObserver(ThreadState* thread_state)
     : thread_state_(thread_state) {
   thread_state_->AddObserver(this);
@@ -1141,6 +1182,14 @@ void UpdateHistograms(const ThreadHeapStatsCollector::Event& event) {
       "BlinkGC.AtomicPhaseMarking",
       event.scope_data[ThreadHeapStatsCollector::kAtomicPhaseMarking]);
 
+  // Marking time in incremental steps and in the atomic pause. Only the
+  // former can be hidden from the mutator, so the ratio shows how much of
+  // the marking work moved out of the pause.
+  UMA_HISTOGRAM_TIMES("BlinkGC.TimeForMarking.Incremental",
+                      event.incremental_marking_time());
+  UMA_HISTOGRAM_TIMES("BlinkGC.TimeForMarking.Atomic",
+                      event.atomic_marking_time());
+
   UMA_HISTOGRAM_TIMES(
       "BlinkGC.CompleteSweep",
       event.scope_data[ThreadHeapStatsCollector::kCompleteSweep]);
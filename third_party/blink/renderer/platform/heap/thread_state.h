@@ -310,6 +310,9 @@ class PLATFORM_EXPORT ThreadState final
   void DisableIncrementalMarkingBarrier();
 
   void CompleteSweep();
+  // Sweeps for a bounded amount of time from an allocation that ran out of
+  // memory in its own arena. Returns true if sweeping is completed.
+  bool AdvanceLazySweepOnAllocation();
   void FinishSnapshot();
   void PostSweep();
 
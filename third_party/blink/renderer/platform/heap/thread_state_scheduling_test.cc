@@ -126,6 +126,30 @@ TEST_F(ThreadStateSchedulingTest, ScheduleIdleGCWhileLazySweeping) {
   EXPECT_EQ(ThreadState::kIdleGCScheduled, test->state()->GetGCState());
 }
 
+TEST_F(ThreadStateSchedulingTest, AdvanceLazySweepOnAllocation) {
+  ThreadStateSchedulingTest* test = this;
+
+  test->StartLazySweepingForPreciseGC();
+
+  // The test heap is small enough to be swept within a single step.
+  EXPECT_TRUE(test->state()->AdvanceLazySweepOnAllocation());
+  EXPECT_FALSE(test->state()->IsSweepingInProgress());
+  EXPECT_EQ(1, test->GCCount());
+  EXPECT_TRUE(test->state()->AdvanceLazySweepOnAllocation());
+}
+
+TEST_F(ThreadStateSchedulingTest, ScheduleGCIfNeededWhileLazySweeping) {
+  ThreadStateSchedulingTest* test = this;
+
+  test->StartLazySweepingForPreciseGC();
+
+  // Without memory pressure, checking the heuristics from an allocation
+  // neither finishes lazy sweeping nor schedules another GC.
+  test->state()->ScheduleGCIfNeeded();
+  EXPECT_TRUE(test->state()->IsSweepingInProgress());
+  EXPECT_EQ(ThreadState::kNoGCScheduled, test->state()->GetGCState());
+}
+
 TEST_F(ThreadStateSchedulingTest, SchedulePreciseGCWhileLazySweeping) {
   ThreadStateSchedulingTest* test = this;
 
@@ -22,6 +22,8 @@
 
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
 
+#include <algorithm>
+
 #include "base/auto_reset.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
@@ -82,7 +84,9 @@ inline MemoryCache::MemoryCache()
       last_frame_paint_time_stamp_(0.0),
       capacity_(kCDefaultCacheCapacity),
       delay_before_live_decoded_prune_(kCMinDelayBeforeLiveDecodedPrune),
-      size_(0) {
+      size_(0),
+      hit_count_(0),
+      miss_count_(0) {
   MemoryCacheDumpProvider::Instance()->SetMemoryCache(this);
   if (MemoryCoordinator::IsLowEndDevice())
     MemoryCoordinator::Instance().RegisterClient(this);
@@ -197,15 +201,22 @@ void MemoryCache::RemoveInternal(ResourceMap* resource_map,
   resource_map->erase(it);
 }
 
-bool MemoryCache::Contains(const Resource* resource) const {
+MemoryCacheEntry* MemoryCache::GetEntryForResource(
+    const Resource* resource) const {
   if (!resource || resource->Url().IsEmpty())
-    return false;
+    return nullptr;
   const ResourceMap* resources = resource_maps_.at(resource->CacheIdentifier());
   if (!resources)
-    return false;
+    return nullptr;
   KURL url = RemoveFragmentIdentifierIfNeeded(resource->Url());
   MemoryCacheEntry* entry = resources->at(url);
-  return entry && resource == entry->GetResource();
+  if (!entry || resource != entry->GetResource())
+    return nullptr;
+  return entry;
+}
+
+bool MemoryCache::Contains(const Resource* resource) const {
+  return GetEntryForResource(resource);
 }
 
 Resource* MemoryCache::ResourceForURL(const KURL& resource_url) const {
@@ -253,23 +264,38 @@ void MemoryCache::PruneResources(PruneStrategy strategy) {
   size_t target_size =
       static_cast<size_t>(size_limit * kCTargetPrunePercentage);
 
+  HeapVector<Member<MemoryCacheEntry>> entries;
   for (const auto& resource_map_iter : resource_maps_) {
     for (const auto& resource_iter : *resource_map_iter.value) {
       Resource* resource = resource_iter.value->GetResource();
       DCHECK(resource);
-      if (resource->IsLoaded() && resource->DecodedSize()) {
-        // Check to see if the remaining resources are too new to prune.
-        double elapsed_time = prune_frame_time_stamp_ -
-                              resource_iter.value->last_decoded_access_time_;
-        if (strategy == kAutomaticPrune &&
-            elapsed_time < delay_before_live_decoded_prune_)
-          continue;
-        resource->Prune();
-        if (size_ <= target_size)
-          return;
-      }
+      if (resource->IsLoaded() && resource->DecodedSize())
+        entries.push_back(resource_iter.value);
     }
   }
+  std::sort(entries.begin(), entries.end(),
+            [](const Member<MemoryCacheEntry>& a,
+               const Member<MemoryCacheEntry>& b) {
+              if (a->IsProtected() != b->IsProtected())
+                return b->IsProtected();
+              return a->last_decoded_access_time_ <
+                     b->last_decoded_access_time_;
+            });
+
+  for (const auto& entry : entries) {
+    Resource* resource = entry->GetResource();
+    if (!resource)
+      continue;
+    // Check to see if the remaining resources are too new to prune.
+    double elapsed_time =
+        prune_frame_time_stamp_ - entry->last_decoded_access_time_;
+    if (strategy == kAutomaticPrune &&
+        elapsed_time < delay_before_live_decoded_prune_)
+      continue;
+    resource->Prune();
+    if (size_ <= target_size)
+      return;
+  }
 }
 
 void MemoryCache::SetCapacity(size_t total_bytes) {
@@ -291,9 +317,22 @@ void MemoryCache::RemoveURLFromCache(const KURL& url) {
     Remove(resource);
 }
 
-void MemoryCache::TypeStatistic::AddResource(Resource* o) {
+void MemoryCache::RecordRequest(Resource* resource) {
+  if (!resource) {
+    ++miss_count_;
+    return;
+  }
+  ++hit_count_;
+  if (MemoryCacheEntry* entry = GetEntryForResource(resource)) {
+    ++entry->reuse_count_;
+    entry->last_decoded_access_time_ = CurrentTime();
+  }
+}
+
+void MemoryCache::TypeStatistic::AddResource(Resource* o, bool is_protected) {
   count++;
   size += o->size();
+  protected_size += is_protected ? o->size() : 0;
   decoded_size += o->DecodedSize();
   encoded_size += o->EncodedSize();
   overhead_size += o->OverheadSize();
@@ -307,24 +346,25 @@ MemoryCache::Statistics MemoryCache::GetStatistics() const {
     for (const auto& resource_iter : *resource_map_iter.value) {
       Resource* resource = resource_iter.value->GetResource();
       DCHECK(resource);
+      bool is_protected = resource_iter.value->IsProtected();
       switch (resource->GetType()) {
         case Resource::kImage:
-          stats.images.AddResource(resource);
+          stats.images.AddResource(resource, is_protected);
           break;
         case Resource::kCSSStyleSheet:
-          stats.css_style_sheets.AddResource(resource);
+          stats.css_style_sheets.AddResource(resource, is_protected);
           break;
         case Resource::kScript:
-          stats.scripts.AddResource(resource);
+          stats.scripts.AddResource(resource, is_protected);
           break;
         case Resource::kXSLStyleSheet:
-          stats.xsl_style_sheets.AddResource(resource);
+          stats.xsl_style_sheets.AddResource(resource, is_protected);
           break;
         case Resource::kFont:
-          stats.fonts.AddResource(resource);
+          stats.fonts.AddResource(resource, is_protected);
           break;
         default:
-          stats.other.AddResource(resource);
+          stats.other.AddResource(resource, is_protected);
           break;
       }
     }
@@ -411,36 +451,34 @@ void MemoryCache::UpdateFramePaintTimestamp() {
   last_frame_paint_time_stamp_ = CurrentTime();
 }
 
+static void DumpTypeStatistic(const char* dump_name,
+                              const MemoryCache::TypeStatistic& stats,
+                              WebProcessMemoryDump* memory_dump) {
+  WebMemoryAllocatorDump* dump =
+      memory_dump->CreateMemoryAllocatorDump(dump_name);
+  dump->AddScalar("size", "bytes", stats.encoded_size + stats.overhead_size);
+  dump->AddScalar("object_count", "objects", stats.count);
+  dump->AddScalar("protected_size", "bytes", stats.protected_size);
+}
+
 bool MemoryCache::OnMemoryDump(WebMemoryDumpLevelOfDetail level_of_detail,
                                WebProcessMemoryDump* memory_dump) {
   if (level_of_detail == WebMemoryDumpLevelOfDetail::kBackground) {
     Statistics stats = GetStatistics();
-    WebMemoryAllocatorDump* dump1 =
-        memory_dump->CreateMemoryAllocatorDump("web_cache/Image_resources");
-    dump1->AddScalar("size", "bytes",
-                     stats.images.encoded_size + stats.images.overhead_size);
-    WebMemoryAllocatorDump* dump2 = memory_dump->CreateMemoryAllocatorDump(
-        "web_cache/CSS stylesheet_resources");
-    dump2->AddScalar("size", "bytes",
-                     stats.css_style_sheets.encoded_size +
-                         stats.css_style_sheets.overhead_size);
-    WebMemoryAllocatorDump* dump3 =
-        memory_dump->CreateMemoryAllocatorDump("web_cache/Script_resources");
-    dump3->AddScalar("size", "bytes",
-                     stats.scripts.encoded_size + stats.scripts.overhead_size);
-    WebMemoryAllocatorDump* dump4 = memory_dump->CreateMemoryAllocatorDump(
-        "web_cache/XSL stylesheet_resources");
-    dump4->AddScalar("size", "bytes",
-                     stats.xsl_style_sheets.encoded_size +
-                         stats.xsl_style_sheets.overhead_size);
-    WebMemoryAllocatorDump* dump5 =
-        memory_dump->CreateMemoryAllocatorDump("web_cache/Font_resources");
-    dump5->AddScalar("size", "bytes",
-                     stats.fonts.encoded_size + stats.fonts.overhead_size);
-    WebMemoryAllocatorDump* dump6 =
-        memory_dump->CreateMemoryAllocatorDump("web_cache/Other_resources");
-    dump6->AddScalar("size", "bytes",
-                     stats.other.encoded_size + stats.other.overhead_size);
+    DumpTypeStatistic("web_cache/Image_resources", stats.images, memory_dump);
+    DumpTypeStatistic("web_cache/CSS stylesheet_resources",
+                      stats.css_style_sheets, memory_dump);
+    DumpTypeStatistic("web_cache/Script_resources", stats.scripts,
+                      memory_dump);
+    DumpTypeStatistic("web_cache/XSL stylesheet_resources",
+                      stats.xsl_style_sheets, memory_dump);
+    DumpTypeStatistic("web_cache/Font_resources", stats.fonts, memory_dump);
+    DumpTypeStatistic("web_cache/Other_resources", stats.other, memory_dump);
+
+    WebMemoryAllocatorDump* requests_dump =
+        memory_dump->CreateMemoryAllocatorDump("web_cache/requests");
+    requests_dump->AddScalar("hit_count", "objects", hit_count_);
+    requests_dump->AddScalar("miss_count", "objects", miss_count_);
     return true;
   }
 
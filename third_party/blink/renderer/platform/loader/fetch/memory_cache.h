@@ -55,11 +55,17 @@ class MemoryCacheEntry final : public GarbageCollected<MemoryCacheEntry> {
   void Trace(blink::Visitor*);
   Resource* GetResource() const { return resource_; }
 
+  // Entries are probationary until their resource is reused for another
+  // request, and protected afterwards. Pruning goes through probationary
+  // entries before protected ones, least recently used first.
+  bool IsProtected() const { return reuse_count_; }
+
   double last_decoded_access_time_;  // Used as a thrash guard
+  unsigned reuse_count_;
 
  private:
   explicit MemoryCacheEntry(Resource* resource)
-      : last_decoded_access_time_(0.0), resource_(resource) {}
+      : last_decoded_access_time_(0.0), reuse_count_(0), resource_(resource) {}
 
   void ClearResourceWeak(Visitor*);
 
@@ -93,6 +99,7 @@ class PLATFORM_EXPORT MemoryCache final
     size_t encoded_size;
     size_t overhead_size;
     size_t encoded_size_duplicated_in_data_urls;
+    size_t protected_size;
 
     TypeStatistic()
         : count(0),
@@ -100,9 +107,10 @@ class PLATFORM_EXPORT MemoryCache final
           decoded_size(0),
           encoded_size(0),
           overhead_size(0),
-          encoded_size_duplicated_in_data_urls(0) {}
+          encoded_size_duplicated_in_data_urls(0),
+          protected_size(0) {}
 
-    void AddResource(Resource*);
+    void AddResource(Resource*, bool is_protected);
   };
 
   struct Statistics {
@@ -151,6 +159,12 @@ class PLATFORM_EXPORT MemoryCache final
 
   void RemoveURLFromCache(const KURL&);
 
+  // Called by ResourceFetcher for each request that looked up this cache, with
+  // the cached Resource it reuses, or null on a miss.
+  void RecordRequest(Resource*);
+  size_t HitCount() const { return hit_count_; }
+  size_t MissCount() const { return miss_count_; }
+
   Statistics GetStatistics() const;
 
   size_t Capacity() const { return capacity_; }
@@ -190,6 +204,7 @@ class PLATFORM_EXPORT MemoryCache final
 
   void AddInternal(ResourceMap*, MemoryCacheEntry*);
   void RemoveInternal(ResourceMap*, const ResourceMap::iterator&);
+  MemoryCacheEntry* GetEntryForResource(const Resource*) const;
 
   void PruneResources(PruneStrategy);
   void PruneNow(double current_time, PruneStrategy);
@@ -208,6 +223,10 @@ class PLATFORM_EXPORT MemoryCache final
   // The number of bytes currently consumed by resources in the cache.
   size_t size_;
 
+  // The number of requests that did and didn't reuse a cached resource.
+  size_t hit_count_;
+  size_t miss_count_;
+
   friend class MemoryCacheTest;
 };
 
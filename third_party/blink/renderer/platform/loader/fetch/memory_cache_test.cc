@@ -364,6 +364,41 @@ TEST_F(MemoryCacheTest, MAYBE_ClientRemoval_MultipleResourceMaps) {
   }
 }
 
+// Verifies that resources reused for another request are pruned after the
+// ones that were not.
+TEST_F(MemoryCacheTest, PruneProbationaryResourcesFirst) {
+  GetMemoryCache()->SetDelayBeforeLiveDecodedPrune(0);
+  const char kData[6] = "abcde";
+  FetchParameters params1(ResourceRequest("data:text/html,reused"));
+  Resource* reused = FakeDecodedResource::Fetch(params1, fetcher_, nullptr);
+  reused->AppendData(kData, 5u);
+  reused->FinishForTest();
+  FetchParameters params2(ResourceRequest("data:text/html,probationary"));
+  Resource* probationary =
+      FakeDecodedResource::Fetch(params2, fetcher_, nullptr);
+  probationary->AppendData(kData, 5u);
+  probationary->FinishForTest();
+  ASSERT_TRUE(GetMemoryCache()->Contains(reused));
+  ASSERT_TRUE(GetMemoryCache()->Contains(probationary));
+
+  size_t hit_count = GetMemoryCache()->HitCount();
+  size_t miss_count = GetMemoryCache()->MissCount();
+  GetMemoryCache()->RecordRequest(reused);
+  GetMemoryCache()->RecordRequest(nullptr);
+  EXPECT_EQ(hit_count + 1, GetMemoryCache()->HitCount());
+  EXPECT_EQ(miss_count + 1, GetMemoryCache()->MissCount());
+
+  // Leave room for all but half of the decoded data of one resource, which
+  // only pruning |probationary| frees.
+  GetMemoryCache()->SetCapacity(GetMemoryCache()->size() -
+                                probationary->DecodedSize() / 2);
+  EXPECT_EQ(0u, probationary->DecodedSize());
+  EXPECT_GT(reused->DecodedSize(), 0u);
+
+  MemoryCache::Statistics stats = GetMemoryCache()->GetStatistics();
+  EXPECT_EQ(reused->size(), stats.other.protected_size);
+}
+
 TEST_F(MemoryCacheTest, RemoveDuringRevalidation) {
   FakeResource* resource1 =
       FakeResource::Create("http://test/resource", Resource::kRaw);
@@ -868,6 +868,7 @@ Resource* ResourceFetcher::RequestResource(
         policy = DetermineRevalidationPolicy(resource_type, params, *resource,
                                              is_static_data);
       }
+      GetMemoryCache()->RecordRequest(policy == kUse ? resource : nullptr);
     }
   }
 
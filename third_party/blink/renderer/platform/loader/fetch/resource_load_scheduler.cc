@@ -9,7 +9,9 @@
 #include "base/strings/string_number_conversions.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/histogram.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_context.h"
+#include "third_party/blink/renderer/platform/network/network_state_notifier.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/scheduler/renderer/frame_status.h"
 #include "third_party/blink/renderer/platform/scheduler/util/aggregated_metric_reporter.h"
@@ -48,10 +50,14 @@ constexpr char kRendererSideResourceScheduler[] =
 constexpr size_t kTightLimitForRendererSideResourceScheduler = 2u;
 // Used in the normal mode (see the header file for details).
 constexpr size_t kLimitForRendererSideResourceScheduler = 1024u;
+// Used on 2G or slower connections (see the header file for details).
+constexpr size_t kSlowConnectionLimitForRendererSideResourceScheduler = 4u;
 
 constexpr char kTightLimitForRendererSideResourceSchedulerName[] =
     "tight_limit";
 constexpr char kLimitForRendererSideResourceSchedulerName[] = "limit";
+constexpr char kSlowConnectionLimitForRendererSideResourceSchedulerName[] =
+    "slow_connection_limit";
 
 // Represents a resource load circumstance, e.g. from main frame vs sub-frames,
 // or on throttled state vs on not-throttled state.
@@ -118,6 +124,21 @@ bool IsResourceLoadThrottlingEnabled() {
   return RuntimeEnabledFeatures::ResourceLoadSchedulerEnabled();
 }
 
+bool IsSlowConnection() {
+  switch (GetNetworkStateNotifier().EffectiveType()) {
+    case WebEffectiveConnectionType::kTypeSlow2G:
+    case WebEffectiveConnectionType::kType2G:
+      return true;
+    case WebEffectiveConnectionType::kTypeUnknown:
+    case WebEffectiveConnectionType::kTypeOffline:
+    case WebEffectiveConnectionType::kType3G:
+    case WebEffectiveConnectionType::kType4G:
+      return false;
+  }
+  NOTREACHED();
+  return false;
+}
+
 }  // namespace
 
 // A class to gather throttling and traffic information to report histograms.
@@ -345,6 +366,10 @@ constexpr ResourceLoadScheduler::ClientId
 ResourceLoadScheduler::ResourceLoadScheduler(FetchContext* context)
     : outstanding_limit_for_throttled_frame_scheduler_(
           GetOutstandingThrottledLimit(context)),
+      outstanding_limit_for_slow_connection_(GetFieldTrialUint32Param(
+          kRendererSideResourceScheduler,
+          kSlowConnectionLimitForRendererSideResourceSchedulerName,
+          kSlowConnectionLimitForRendererSideResourceScheduler)),
       context_(context) {
   traffic_monitor_ =
       std::make_unique<ResourceLoadScheduler::TrafficMonitor>(context_);
@@ -423,6 +448,7 @@ void ResourceLoadScheduler::Request(ResourceLoadSchedulerClient* client,
   pending_requests_[option].insert(request_info);
   pending_request_map_.insert(
       *id, new ClientInfo(client, option, priority, intra_priority));
+  TraceRequestCounts();
 
   // Remember the ClientId since MaybeRun() below may destruct the caller
   // instance and |id| may be inaccessible after the call.
@@ -480,6 +506,7 @@ bool ResourceLoadScheduler::Release(
     if (traffic_monitor_)
       traffic_monitor_->Report(hints);
 
+    TraceRequestCounts();
     if (option == ReleaseOption::kReleaseAndSchedule)
       MaybeRun();
     return true;
@@ -489,6 +516,8 @@ bool ResourceLoadScheduler::Release(
     pending_request_map_.erase(found);
     // Intentionally does not remove it from |pending_requests_|.
 
+    TraceRequestCounts();
+
     // Didn't release any running requests, but the outstanding limit might be
     // changed to allow another request.
     if (option == ReleaseOption::kReleaseAndSchedule)
@@ -668,6 +697,11 @@ void ResourceLoadScheduler::MaybeRun() {
       continue;  // Already released.
     ResourceLoadSchedulerClient* client = found->value->client;
     ThrottleOption option = found->value->option;
+    TRACE_EVENT_INSTANT2(
+        "blink", "ResourceLoadScheduler::RunPendingRequest",
+        TRACE_EVENT_SCOPE_THREAD, "priority",
+        static_cast<int>(found->value->priority), "waiting_ms",
+        (CurrentTimeTicks() - found->value->request_time).InMillisecondsF());
     pending_request_map_.erase(found);
     Run(id, client, option == ThrottleOption::kThrottleable);
   }
@@ -682,6 +716,7 @@ void ResourceLoadScheduler::Run(ResourceLoadScheduler::ClientId id,
   if (running_requests_.size() > maximum_running_requests_seen_) {
     maximum_running_requests_seen_ = running_requests_.size();
   }
+  TraceRequestCounts();
   client->Run();
 }
 
@@ -708,9 +743,20 @@ size_t ResourceLoadScheduler::GetOutstandingLimit() const {
       limit = std::min(limit, normal_outstanding_limit_);
       break;
   }
+
+  // Note that nothing is scheduled when the connection gets faster, so
+  // pending requests wait for the next Request() or Release() to run.
+  if (IsSlowConnection())
+    limit = std::min(limit, outstanding_limit_for_slow_connection_);
   return limit;
 }
 
+void ResourceLoadScheduler::TraceRequestCounts() const {
+  TRACE_COUNTER_ID2("blink", "ResourceLoadScheduler", this, "pending",
+                    pending_request_map_.size(), "running",
+                    running_requests_.size());
+}
+
 bool ResourceLoadScheduler::IsThrottledState() const {
   switch (frame_scheduler_lifecycle_state_) {
     case scheduler::SchedulingLifecycleState::kHidden:
@@ -14,6 +14,7 @@
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loader_options.h"
 #include "third_party/blink/renderer/platform/scheduler/public/frame_scheduler.h"
 #include "third_party/blink/renderer/platform/wtf/hash_set.h"
+#include "third_party/blink/renderer/platform/wtf/time.h"
 
 namespace blink {
 
@@ -66,6 +67,10 @@ class PLATFORM_EXPORT ResourceLoadSchedulerClient
 //     ResourceLoadScheduler considers a request throttleable if its priority
 //     is less than |kMedium|.
 //
+//  On top of that, throttleable requests get a smaller threshold while the
+//  effective connection type is 2G or slower, so that low priority requests
+//  don't take bandwidth from the requests that block rendering.
+//
 // Here are running experiments (as of M65):
 //  - "ResourceLoadScheduler"
 //   - Resource loading requests are not at throttled when the frame is in
@@ -234,7 +239,8 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
         : client(client),
           option(option),
           priority(priority),
-          intra_priority(intra_priority) {}
+          intra_priority(intra_priority),
+          request_time(CurrentTimeTicks()) {}
 
     void Trace(blink::Visitor* visitor) { visitor->Trace(client); }
 
@@ -242,6 +248,8 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
     ThrottleOption option;
     ResourceLoadPriority priority;
     int intra_priority;
+    // When Request() queued the client, to trace how long it waited.
+    TimeTicks request_time;
   };
 
   // Gets the highest priority pending request that is allowed to be run.
@@ -267,6 +275,9 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
 
   bool IsThrottledState() const;
 
+  // Records the number of pending and running requests in the trace.
+  void TraceRequestCounts() const;
+
   // A flag to indicate an internal running state.
   // TODO(toyoshim): We may want to use enum once we start to have more states.
   bool is_shutdown_ = false;
@@ -286,6 +297,9 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   // Used when |frame_scheduler_throttling_state_| is |kThrottled|.
   const size_t outstanding_limit_for_throttled_frame_scheduler_;
 
+  // Used when the effective connection type is 2G or slower.
+  const size_t outstanding_limit_for_slow_connection_;
+
   // The last used ClientId to calculate the next.
   ClientId current_id_ = kInvalidClientId;
 
@@ -6,6 +6,7 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/platform/loader/testing/mock_fetch_context.h"
+#include "third_party/blink/renderer/platform/network/network_state_notifier.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/testing/testing_platform_support.h"
 
@@ -604,5 +605,46 @@ TEST_F(ResourceLoadSchedulerTest, LoosenThrottlingPolicy) {
   EXPECT_TRUE(Release(id1));
 }
 
+TEST_F(ResourceLoadSchedulerTest, SlowConnectionLimit) {
+  Scheduler()->LoosenThrottlingPolicy();
+  Scheduler()->SetOutstandingLimitForTesting(10);
+  GetNetworkStateNotifier().SetNetworkConnectionInfoOverride(
+      true, WebConnectionType::kWebConnectionTypeCellular2G,
+      WebEffectiveConnectionType::kType2G, 1800 /* http_rtt_msec */,
+      0.05 /* max_bandwidth_mbps */);
+
+  // Only the default limit for slow connections of low priority requests
+  // run.
+  std::vector<MockClient*> clients;
+  std::vector<ResourceLoadScheduler::ClientId> ids;
+  for (int i = 0; i < 5; ++i) {
+    clients.push_back(new MockClient);
+    ids.push_back(ResourceLoadScheduler::kInvalidClientId);
+    Scheduler()->Request(clients.back(), ThrottleOption::kThrottleable,
+                         ResourceLoadPriority::kLow, 0 /* intra_priority */,
+                         &ids.back());
+  }
+  EXPECT_TRUE(clients[3]->WasRun());
+  EXPECT_FALSE(clients[4]->WasRun());
+
+  // High priority requests are not throttled.
+  MockClient* high_client = new MockClient;
+  ResourceLoadScheduler::ClientId high_id =
+      ResourceLoadScheduler::kInvalidClientId;
+  Scheduler()->Request(high_client, ThrottleOption::kThrottleable,
+                       ResourceLoadPriority::kHigh, 0 /* intra_priority */,
+                       &high_id);
+  EXPECT_TRUE(high_client->WasRun());
+
+  // Once the connection is faster, the normal limit applies again.
+  GetNetworkStateNotifier().ClearOverride();
+  EXPECT_TRUE(ReleaseAndSchedule(ids[0]));
+  EXPECT_TRUE(clients[4]->WasRun());
+
+  EXPECT_TRUE(Release(high_id));
+  for (int i = 1; i < 5; ++i)
+    EXPECT_TRUE(Release(ids[i]));
+}
+
 }  // namespace
 }  // namespace blink
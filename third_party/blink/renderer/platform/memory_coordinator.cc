@@ -12,6 +12,7 @@
 #include "third_party/blink/renderer/platform/cross_thread_functional.h"
 #include "third_party/blink/renderer/platform/fonts/font_global_context.h"
 #include "third_party/blink/renderer/platform/graphics/image_decoding_store.h"
+#include "third_party/blink/renderer/platform/graphics/image_frame_generator.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/web_task_runner.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/partitions.h"
@@ -92,6 +93,8 @@ void MemoryCoordinator::OnMemoryPressure(WebMemoryPressureLevel level) {
     client->OnMemoryPressure(level);
   if (level == kWebMemoryPressureLevelCritical)
     ClearMemory();
+  else if (level == kWebMemoryPressureLevelModerate)
+    FontGlobalContext::ReduceMemory();
   WTF::Partitions::DecommitFreeableMemory();
 }
 
@@ -108,6 +111,7 @@ void MemoryCoordinator::OnPurgeMemory() {
   // en.wikipedia.org/wiki/Wikipedia). So we should not invalidate the font
   // cache in purge+throttle.
   ImageDecodingStore::Instance().Clear();
+  ImageFrameGenerator::ClearYUVDecoder();
   WTF::Partitions::DecommitFreeableMemory();
 
   // Thread-specific data never issues a layout, so we are safe here.
@@ -127,6 +131,7 @@ void MemoryCoordinator::ClearMemory() {
   // TODO(tasak|bashi): Make ImageDecodingStore and FontCache be
   // MemoryCoordinatorClients rather than clearing caches here.
   ImageDecodingStore::Instance().Clear();
+  ImageFrameGenerator::ClearYUVDecoder();
   FontGlobalContext::ClearMemory();
 }
 
@@ -71,6 +71,8 @@ void PartitionStatsDumperImpl::PartitionDumpTotals(
                             memory_stats->total_decommittable_bytes);
   allocator_dump->AddScalar("discardable_size", "bytes",
                             memory_stats->total_discardable_bytes);
+  allocator_dump->AddScalar("thread_cache_size", "bytes",
+                            memory_stats->total_thread_cache_bytes);
 }
 
 void PartitionStatsDumperImpl::PartitionsDumpBucketStats(
@@ -0,0 +1,79 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/time/time.h"
+#include "cc/base/lap_timer.h"
+#include "third_party/blink/renderer/platform/wtf/hash_set.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace blink {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+// Enough keys for the table not to fit in the L2 cache.
+static const unsigned kKeyCount = 1 << 18;
+
+struct GroupProbingTraits : WTF::HashTraits<unsigned> {
+  static const unsigned kProbeGroupSize = 4;
+};
+
+using DoubleHashingSet = HashSet<unsigned>;
+using GroupProbingSet =
+    HashSet<unsigned, WTF::IntHash<unsigned>, GroupProbingTraits>;
+
+// Keys are odd, so that the even ones miss.
+unsigned Key(unsigned i) {
+  return 2 * i + 1;
+}
+
+}  // anonymous namespace
+
+class HashTablePerfTest : public testing::Test {
+ public:
+  HashTablePerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  template <typename SetType>
+  void RunLookups(const char* name) {
+    SetType set;
+    for (unsigned i = 0; i < kKeyCount; ++i)
+      set.insert(Key(i));
+
+    timer_.Reset();
+    do {
+      unsigned found = 0;
+      for (unsigned i = 0; i < kKeyCount; ++i) {
+        if (set.Contains(Key(i)))
+          ++found;
+        if (set.Contains(Key(i) + 1))
+          ++found;
+      }
+      EXPECT_EQ(kKeyCount, found);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("HashTablePerfTest", name, "",
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+  cc::LapTimer timer_;
+};
+
+TEST_F(HashTablePerfTest, DoubleHashingLookups) {
+  RunLookups<DoubleHashingSet>("double hashing lookups");
+}
+
+TEST_F(HashTablePerfTest, GroupProbingLookups) {
+  RunLookups<GroupProbingSet>("group probing lookups");
+}
+
+}  // namespace blink
@@ -0,0 +1,89 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "base/time/time.h"
+#include "cc/base/lap_timer.h"
+#include "third_party/blink/renderer/platform/wtf/text/text_codec.h"
+#include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
+#include "third_party/blink/renderer/platform/wtf/text/text_encoding_registry.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace blink {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+// About as much as a large document.
+static const size_t kInputSize = 1 << 20;
+
+std::string Repeat(const char* text) {
+  std::string result;
+  while (result.size() < kInputSize)
+    result += text;
+  return result;
+}
+
+}  // anonymous namespace
+
+class TextCodecUTF8PerfTest : public testing::Test {
+ public:
+  TextCodecUTF8PerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  void RunDecode(const char* name, const std::string& input) {
+    std::unique_ptr<TextCodec> codec(
+        WTF::NewTextCodec(WTF::TextEncoding("UTF-8")));
+    timer_.Reset();
+    do {
+      bool saw_error = false;
+      String result =
+          codec->Decode(input.data(), input.size(),
+                        WTF::FlushBehavior::kDataEOF, false, saw_error);
+      EXPECT_FALSE(saw_error);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult(
+        "TextCodecUTF8PerfTest", name, "",
+        timer_.LapsPerSecond() * input.size() / (1024 * 1024), "MB/s", true);
+  }
+
+  cc::LapTimer timer_;
+};
+
+// Markup and script are almost all ASCII.
+TEST_F(TextCodecUTF8PerfTest, DecodeMarkup) {
+  RunDecode("decode markup",
+            Repeat("<div class=\"article-body\"><p>The quick brown fox jumps "
+                   "over the lazy dog.</p><script>var x = f(1, 2);</script>"
+                   "</div>\n"));
+}
+
+// Western European text, which still decodes to 8 bits.
+TEST_F(TextCodecUTF8PerfTest, DecodeLatin1Text) {
+  RunDecode("decode latin1 text",
+            Repeat("<p>Le coeur a ses raisons que la raison ne "
+                   "conna\xc3\xaet point. \xc3\x80 bient\xc3\xb4t, "
+                   "gar\xc3\xa7on.</p>\n"));
+}
+
+// CJK text between ASCII markup, which decodes to 16 bits.
+TEST_F(TextCodecUTF8PerfTest, DecodeCJKText) {
+  RunDecode("decode cjk text",
+            Repeat("<p>\xe6\xbc\xa2\xe5\xad\x97\xe3\x81\xaf\xe4\xb8\xad"
+                   "\xe5\x9b\xbd\xe3\x81\x8b\xe3\x82\x89\xe4\xbc\x9d\xe3"
+                   "\x82\x8f\xe3\x81\xa3\xe3\x81\x9f\xe3\x80\x82</p>\n"));
+}
+
+}  // namespace blink
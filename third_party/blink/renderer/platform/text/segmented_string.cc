@@ -21,15 +21,6 @@
 
 namespace blink {
 
-unsigned SegmentedString::length() const {
-  unsigned length = current_string_.length();
-  if (IsComposite()) {
-    for (auto& substring : substrings_)
-      length += substring.length();
-  }
-  return length;
-}
-
 void SegmentedString::SetExcludeLineNumbers() {
   current_string_.SetExcludeLineNumbers();
   if (IsComposite()) {
@@ -44,6 +35,7 @@ void SegmentedString::Clear() {
   number_of_characters_consumed_prior_to_current_line_ = 0;
   current_line_ = 0;
   substrings_.clear();
+  substrings_length_ = 0;
   closed_ = false;
   empty_ = true;
 }
@@ -59,6 +51,7 @@ void SegmentedString::Append(const SegmentedSubstring& s) {
     current_string_ = s;
   } else {
     substrings_.push_back(s);
+    substrings_length_ += s.length();
   }
   empty_ = false;
 }
@@ -93,6 +86,7 @@ void SegmentedString::Prepend(const SegmentedSubstring& s, PrependType type) {
   } else {
     // Shift our m_currentString into our list.
     substrings_.push_front(current_string_);
+    substrings_length_ += current_string_.length();
     current_string_ = s;
   }
   empty_ = false;
@@ -129,6 +123,7 @@ void SegmentedString::AdvanceSubstring() {
     number_of_characters_consumed_prior_to_current_string_ +=
         current_string_.NumberOfCharactersConsumed() + 1;
     current_string_ = substrings_.TakeFirst();
+    substrings_length_ -= current_string_.length();
     // If we've previously consumed some characters of the non-current
     // string, we now account for those characters as part of the current
     // string, not as part of "prior to current string."
@@ -143,6 +143,7 @@ class PLATFORM_EXPORT SegmentedString {
       : number_of_characters_consumed_prior_to_current_string_(0),
         number_of_characters_consumed_prior_to_current_line_(0),
         current_line_(0),
+        substrings_length_(0),
         closed_(false),
         empty_(true) {}
 
@@ -151,6 +152,7 @@ class PLATFORM_EXPORT SegmentedString {
         number_of_characters_consumed_prior_to_current_string_(0),
         number_of_characters_consumed_prior_to_current_line_(0),
         current_line_(0),
+        substrings_length_(0),
         closed_(false),
         empty_(!str.length()) {}
 
@@ -172,7 +174,9 @@ class PLATFORM_EXPORT SegmentedString {
   void Push(UChar);
 
   bool IsEmpty() const { return empty_; }
-  unsigned length() const;
+  unsigned length() const {
+    return current_string_.length() + substrings_length_;
+  }
 
   bool IsClosed() const { return closed_; }
 
@@ -317,6 +321,9 @@ class PLATFORM_EXPORT SegmentedString {
   int number_of_characters_consumed_prior_to_current_line_;
   int current_line_;
   Deque<SegmentedSubstring> substrings_;
+  // Sum of the remaining lengths of |substrings_|, so that length() does not
+  // walk every segment of a heavily appended or document.write()n input.
+  unsigned substrings_length_;
   bool closed_;
   bool empty_;
 };
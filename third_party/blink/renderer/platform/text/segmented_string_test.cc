@@ -104,4 +104,30 @@ TEST(SegmentedStringTest, AdvanceSubstringConsumesCharacters) {
   EXPECT_EQ(s1.NumberOfCharactersConsumed(), 3);
 }
 
+TEST(SegmentedStringTest, LengthTracksSegments) {
+  SegmentedString s("ab");
+  s.Append(SegmentedString("cd"));
+  s.Append(SegmentedString("e"));
+  EXPECT_EQ(5u, s.length());
+
+  s.Advance();
+  EXPECT_EQ(4u, s.length());
+  s.Prepend(SegmentedString("xy"), SegmentedString::PrependType::kNewInput);
+  EXPECT_EQ(6u, s.length());
+  s.Push('w');
+  EXPECT_EQ(7u, s.length());
+
+  unsigned expected = 7;
+  while (!s.IsEmpty()) {
+    EXPECT_EQ(expected--, s.length());
+    s.Advance();
+  }
+  EXPECT_EQ(0u, s.length());
+
+  s.Append(SegmentedString("f"));
+  s.Append(SegmentedString("g"));
+  s.Clear();
+  EXPECT_EQ(0u, s.length());
+}
+
 }  // namespace blink
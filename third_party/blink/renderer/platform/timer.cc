@@ -117,21 +117,41 @@ void TimerBase::SetNextFireTime(TimeTicks now, TimeDelta delay) {
   if (next_fire_time_ != new_time) {
     next_fire_time_ = new_time;
 
-    // Cancel any previously posted task.
-    weak_ptr_factory_.InvalidateWeakPtrs();
+    // Postponing a timer is common (e.g. debouncing), so rather than leaving a
+    // cancelled task behind in the delayed queue on every restart, keep the
+    // posted task and let RunInternal() repost it for the remaining delay.
+    if (IsActive() && scheduled_run_time_ <= new_time)
+      return;
 
-    TimerTaskRunner()->PostDelayedTask(
-        location_,
-        WTF::Bind(&TimerBase::RunInternal, weak_ptr_factory_.GetWeakPtr()),
-        delay);
+    PostTask(delay);
   }
 }
 
+void TimerBase::PostTask(TimeDelta delay) {
+  // Cancel any previously posted task.
+  weak_ptr_factory_.InvalidateWeakPtrs();
+
+  scheduled_run_time_ = next_fire_time_;
+  TimerTaskRunner()->PostDelayedTask(
+      location_,
+      WTF::Bind(&TimerBase::RunInternal, weak_ptr_factory_.GetWeakPtr()),
+      delay);
+}
+
 NO_SANITIZE_ADDRESS
 void TimerBase::RunInternal() {
   if (!CanFire())
     return;
 
+  if (scheduled_run_time_ < next_fire_time_) {
+    // The timer was postponed after this task was posted.
+    TimeTicks now = TimerCurrentTimeTicks();
+    if (now < next_fire_time_) {
+      PostTask(next_fire_time_ - now);
+      return;
+    }
+  }
+
   weak_ptr_factory_.InvalidateWeakPtrs();
 
   TRACE_EVENT0("blink", "TimerBase::run");
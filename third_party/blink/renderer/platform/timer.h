@@ -93,10 +93,14 @@ class PLATFORM_EXPORT TimerBase {
   TimeTicks TimerCurrentTimeTicks() const;
 
   void SetNextFireTime(TimeTicks now, TimeDelta delay);
+  void PostTask(TimeDelta delay);
 
   void RunInternal();
 
   TimeTicks next_fire_time_;   // 0 if inactive
+  // Run time of the currently posted task. It may be earlier than
+  // |next_fire_time_| when the timer was postponed without reposting.
+  TimeTicks scheduled_run_time_;
   TimeDelta repeat_interval_;  // 0 if not repeating
   base::Location location_;
   scoped_refptr<base::SingleThreadTaskRunner> web_task_runner_;
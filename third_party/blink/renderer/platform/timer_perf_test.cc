@@ -114,4 +114,32 @@ TEST_F(TimerPerfTest, PostThenCancelTenThousandTimers) {
             << (run_end_ - run_start_).InMicroseconds();
 }
 
+TEST_F(TimerPerfTest, PostponeTenThousandTimers) {
+  const int kNumIterations = 10000;
+  const int kNumPostpones = 10;
+  Vector<std::unique_ptr<TaskRunnerTimer<TimerPerfTest>>> timers(
+      kNumIterations);
+  for (int i = 0; i < kNumIterations; i++) {
+    timers[i].reset(new TaskRunnerTimer<TimerPerfTest>(
+        scheduler::GetSingleThreadTaskRunnerForTesting(), this,
+        &TimerPerfTest::NopTask));
+  }
+
+  base::ThreadTicks post_start = base::ThreadTicks::Now();
+  for (int j = 1; j <= kNumPostpones; j++) {
+    for (int i = 0; i < kNumIterations; i++)
+      timers[i]->StartOneShot(TimeDelta::FromSeconds(j), FROM_HERE);
+  }
+  base::ThreadTicks post_end = base::ThreadTicks::Now();
+
+  for (int i = 0; i < kNumIterations; i++)
+    timers[i]->Stop();
+
+  double posting_time = (post_end - post_start).InMicroseconds();
+  double posting_time_us_per_call =
+      posting_time / static_cast<double>(kNumIterations * kNumPostpones);
+  LOG(INFO) << "TimerBase::startOneShot postpone cost (us/call) "
+            << posting_time_us_per_call << " (total " << posting_time << " us)";
+}
+
 }  // namespace blink
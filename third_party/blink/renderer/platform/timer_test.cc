@@ -321,6 +321,24 @@ TEST_F(TimerTest, PostingTimerTwiceWithLaterRunTimeCancelsOriginalTask) {
               ElementsAre(start_time_ + TimeDelta::FromSeconds(10)));
 }
 
+TEST_F(TimerTest, PostponingTimerDoesNotRepostTask) {
+  TaskRunnerTimer<TimerTest> timer(GetTaskRunner(), this,
+                                   &TimerTest::CountingTask);
+  timer.StartOneShot(TimeDelta::FromSeconds(10), FROM_HERE);
+  timer.StartOneShot(TimeDelta::FromSeconds(15), FROM_HERE);
+  timer.StartOneShot(TimeDelta::FromSeconds(20), FROM_HERE);
+
+  // The original task stays posted and is reposted when it runs early.
+  TimeDelta run_time;
+  EXPECT_TRUE(TimeTillNextDelayedTask(&run_time));
+  EXPECT_EQ(TimeDelta::FromSeconds(10), run_time);
+  EXPECT_EQ(TimeDelta::FromSeconds(20), timer.NextFireInterval());
+
+  platform_->RunUntilIdle();
+  EXPECT_THAT(run_times_,
+              ElementsAre(start_time_ + TimeDelta::FromSeconds(20)));
+}
+
 TEST_F(TimerTest, StartRepeatingTask) {
   TaskRunnerTimer<TimerTest> timer(GetTaskRunner(), this,
                                    &TimerTest::CountingTask);
@@ -409,6 +409,32 @@ TEST(HashSetTest, HasTraitsForEnum) {
   HashSet<std::pair<TestEnum, TestEnumClass>> set3;
 }
 
+struct GroupProbingTraits : HashTraits<unsigned> {
+  static const unsigned kProbeGroupSize = 4;
+};
+
+TEST(HashSetTest, GroupProbing) {
+  HashSet<unsigned, IntHash<unsigned>, GroupProbingTraits> set;
+  for (unsigned i = 1; i <= 1000; ++i)
+    EXPECT_TRUE(set.insert(i * 1024).is_new_entry);
+  EXPECT_EQ(1000u, set.size());
+  for (unsigned i = 1; i <= 1000; ++i)
+    EXPECT_TRUE(set.Contains(i * 1024));
+  EXPECT_FALSE(set.Contains(1023));
+
+  for (unsigned i = 1; i <= 1000; i += 2)
+    set.erase(i * 1024);
+  EXPECT_EQ(500u, set.size());
+  for (unsigned i = 1; i <= 1000; ++i)
+    EXPECT_EQ(i % 2 == 0, set.Contains(i * 1024));
+
+  // Reinserting reuses the deleted buckets.
+  for (unsigned i = 1; i <= 1000; i += 2)
+    EXPECT_TRUE(set.insert(i * 1024).is_new_entry);
+  EXPECT_FALSE(set.insert(1024).is_new_entry);
+  EXPECT_EQ(1000u, set.size());
+}
+
 static_assert(!IsTraceable<HashSet<int>>::value,
               "HashSet<int, int> must not be traceable.");
 
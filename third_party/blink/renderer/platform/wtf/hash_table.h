@@ -1024,6 +1024,49 @@ inline unsigned DoubleHash(unsigned key) {
   return key;
 }
 
+// The buckets probed for a hash, in order. By default, this is double
+// hashing: the first bucket is picked by the hash and the following ones are
+// a fixed step apart, which is computed from the hash on the first collision.
+//
+// A hash table whose KeyTraits::kProbeGroupSize is more than one probes groups
+// of that many adjacent buckets instead, and steps from group to group. For
+// small buckets, a group is usually in the same cache line, so a collision
+// rarely costs another cache miss. The group starts still go through all of
+// the buckets, so a probe always ends up at an empty one.
+template <unsigned groupSize>
+class HashTableProbeSequence {
+  STACK_ALLOCATED();
+
+ public:
+  HashTableProbeSequence(unsigned hash, size_t size_mask)
+      : hash_(hash),
+        size_mask_(size_mask),
+        group_start_(hash & size_mask),
+        index_(group_start_) {}
+
+  size_t Index() const { return index_; }
+
+  void Next() {
+    if (groupSize > 1 && ++offset_in_group_ < groupSize) {
+      index_ = (group_start_ + offset_in_group_) & size_mask_;
+      return;
+    }
+    offset_in_group_ = 0;
+    if (!step_)
+      step_ = 1 | DoubleHash(hash_);
+    group_start_ = (group_start_ + step_) & size_mask_;
+    index_ = group_start_;
+  }
+
+ private:
+  const unsigned hash_;
+  const size_t size_mask_;
+  size_t step_ = 0;
+  size_t group_start_;
+  unsigned offset_in_group_ = 0;
+  size_t index_;
+};
+
 inline unsigned CalculateCapacity(unsigned size) {
   for (unsigned mask = size; mask; mask >>= 1)
     size |= mask;         // 00110101010 -> 00111111111
@@ -1091,15 +1134,13 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   if (!table)
     return nullptr;
 
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<KeyTraits::kProbeGroupSize> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   while (1) {
-    const ValueType* entry = table + i;
+    const ValueType* entry = table + probe.Index();
 
     if (HashFunctions::safe_to_compare_to_empty_or_deleted) {
       if (HashTranslator::Equal(Extractor::Extract(*entry), key))
@@ -1116,9 +1157,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return entry;
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 }
 
@@ -1144,17 +1183,15 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   RegisterModification();
 
   ValueType* table = table_;
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<KeyTraits::kProbeGroupSize> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   ValueType* deleted_entry = nullptr;
 
   while (1) {
-    ValueType* entry = table + i;
+    ValueType* entry = table + probe.Index();
 
     if (IsEmptyBucket(*entry))
       return LookupType(deleted_entry ? deleted_entry : entry, false);
@@ -1172,9 +1209,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return LookupType(entry, true);
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 }
 
@@ -1200,17 +1235,15 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   RegisterModification();
 
   ValueType* table = table_;
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<KeyTraits::kProbeGroupSize> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   ValueType* deleted_entry = nullptr;
 
   while (1) {
-    ValueType* entry = table + i;
+    ValueType* entry = table + probe.Index();
 
     if (IsEmptyBucket(*entry))
       return MakeLookupResult(deleted_entry ? deleted_entry : entry, false, h);
@@ -1228,9 +1261,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return MakeLookupResult(entry, true, h);
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 }
 
@@ -1299,17 +1330,15 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   DCHECK(table_);
 
   ValueType* table = table_;
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<KeyTraits::kProbeGroupSize> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   ValueType* deleted_entry = nullptr;
   ValueType* entry;
   while (1) {
-    entry = table + i;
+    entry = table + probe.Index();
 
     if (IsEmptyBucket(*entry))
       break;
@@ -1327,9 +1356,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return AddResult(this, entry, false);
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 
   RegisterModification();
@@ -63,6 +63,12 @@ struct GenericHashTraitsBase<false, T> {
   static const unsigned kMinimumTableSize = 8;
 #endif
 
+  // The number of adjacent buckets probed before stepping to the next part
+  // of the table; see HashTableProbeSequence. Collisions are cheaper with
+  // larger groups when the buckets are small, but the tables also get more
+  // clustered.
+  static const unsigned kProbeGroupSize = 1;
+
   // When a hash table backing store is traced, its elements will be
   // traced if their class type has a trace method. However, weak-referenced
   // elements should not be traced then, but handled by the weak processing
@@ -358,6 +364,7 @@ struct PairHashTraits
   }
 
   static const unsigned kMinimumTableSize = FirstTraits::kMinimumTableSize;
+  static const unsigned kProbeGroupSize = FirstTraits::kProbeGroupSize;
 
   static void ConstructDeletedValue(TraitType& slot, bool zero_value) {
     FirstTraits::ConstructDeletedValue(slot.first, zero_value);
@@ -438,6 +445,7 @@ struct KeyValuePairHashTraits
           : kNoWeakHandling;
 
   static const unsigned kMinimumTableSize = KeyTraits::kMinimumTableSize;
+  static const unsigned kProbeGroupSize = KeyTraits::kProbeGroupSize;
 
   static void ConstructDeletedValue(TraitType& slot, bool zero_value) {
     KeyTraits::ConstructDeletedValue(slot.key, zero_value);
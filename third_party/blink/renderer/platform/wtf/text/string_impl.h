@@ -792,9 +792,13 @@ static inline bool IsSpaceOrNewline(UChar c) {
 }
 
 inline scoped_refptr<StringImpl> StringImpl::IsolatedCopy() const {
-  if (Is8Bit())
-    return Create(Characters8(), length_);
-  return Create(Characters16(), length_);
+  scoped_refptr<StringImpl> copy = Is8Bit() ? Create(Characters8(), length_)
+                                            : Create(Characters16(), length_);
+  // Keep the hash, so that atomizing the copy on the thread it is sent to
+  // doesn't compute it again. The empty string is shared.
+  if (length_ && HasHash())
+    copy->SetHash(ExistingHash());
+  return copy;
 }
 
 template <typename BufferType>
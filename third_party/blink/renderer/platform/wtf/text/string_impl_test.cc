@@ -158,4 +158,18 @@ TEST(StringImplTest, UpperASCII) {
       StringImpl::Create(kTestWithNonASCIIComparison, 2)->UpperASCII().get()));
 }
 
+TEST(StringImplTest, IsolatedCopyKeepsHash) {
+  scoped_refptr<StringImpl> string = StringImpl::Create("tagname");
+  scoped_refptr<StringImpl> copy = string->IsolatedCopy();
+  EXPECT_FALSE(copy->HasHash());
+
+  unsigned hash = string->GetHash();
+  copy = string->IsolatedCopy();
+  EXPECT_NE(string.get(), copy.get());
+  EXPECT_TRUE(copy->HasHash());
+  EXPECT_EQ(hash, copy->ExistingHash());
+
+  EXPECT_TRUE(StringImpl::empty_->IsolatedCopy()->IsEmpty());
+}
+
 }  // namespace WTF
@@ -26,12 +26,20 @@
 #include "third_party/blink/renderer/platform/wtf/text/text_codec_utf8.h"
 
 #include <memory>
+#include "base/bits.h"
 #include "base/memory/ptr_util.h"
+#include "build/build_config.h"
 #include "third_party/blink/renderer/platform/wtf/text/character_names.h"
 #include "third_party/blink/renderer/platform/wtf/text/cstring.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_buffer.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_codec_ascii_fast_path.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace WTF {
 
 // We'll use nonCharacter* constants to signal invalid utf-8.
@@ -156,6 +164,82 @@ static inline UChar* AppendCharacter(UChar* destination, int character) {
   return destination;
 }
 
+#if defined(ARCH_CPU_X86_FAMILY)
+static inline void StoreASCIIChunk(LChar* destination, __m128i chunk) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), chunk);
+}
+
+static inline void StoreASCIIChunk(UChar* destination, __m128i chunk) {
+  const __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),
+                   _mm_unpacklo_epi8(chunk, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 8),
+                   _mm_unpackhi_epi8(chunk, zero));
+}
+#elif defined(ARCH_CPU_ARM64)
+static inline void StoreASCIIChunk(LChar* destination, uint8x16_t chunk) {
+  vst1q_u8(destination, chunk);
+}
+
+static inline void StoreASCIIChunk(UChar* destination, uint8x16_t chunk) {
+  vst1q_u16(reinterpret_cast<uint16_t*>(destination),
+            vmovl_u8(vget_low_u8(chunk)));
+  vst1q_u16(reinterpret_cast<uint16_t*>(destination + 8),
+            vmovl_high_u8(chunk));
+}
+#endif
+
+// Copies the run of ASCII characters at |source|, which must start with one,
+// and advances |source| and |destination| past it. The run is copied 16 bytes
+// at a time where SIMD is available, and a machine word at a time otherwise.
+template <typename CharType>
+static inline void CopyASCIIRun(const uint8_t*& source,
+                                const uint8_t* end,
+                                CharType*& destination) {
+  DCHECK(IsASCII(*source));
+#if defined(ARCH_CPU_X86_FAMILY)
+  while (end - source >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    // One bit per byte that is not ASCII.
+    unsigned non_ascii = _mm_movemask_epi8(chunk);
+    if (non_ascii) {
+      unsigned ascii_length = base::bits::CountTrailingZeroBits(non_ascii);
+      for (unsigned i = 0; i < ascii_length; ++i)
+        *destination++ = *source++;
+      return;
+    }
+    StoreASCIIChunk(destination, chunk);
+    source += 16;
+    destination += 16;
+  }
+#elif defined(ARCH_CPU_ARM64)
+  while (end - source >= 16) {
+    uint8x16_t chunk = vld1q_u8(source);
+    if (vmaxvq_u8(chunk) & 0x80)
+      break;
+    StoreASCIIChunk(destination, chunk);
+    source += 16;
+    destination += 16;
+  }
+#else
+  while (source < end && !IsAlignedToMachineWord(source) && IsASCII(*source))
+    *destination++ = *source++;
+  const uint8_t* aligned_end = AlignToMachineWord(end);
+  if (IsAlignedToMachineWord(source)) {
+    while (source < aligned_end) {
+      MachineWord chunk = *reinterpret_cast_ptr<const MachineWord*>(source);
+      if (!IsAllASCII<LChar>(chunk))
+        break;
+      CopyASCIIMachineWord(destination, source);
+      source += sizeof(MachineWord);
+      destination += sizeof(MachineWord);
+    }
+  }
+#endif
+  while (source < end && IsASCII(*source))
+    *destination++ = *source++;
+}
+
 void TextCodecUTF8::ConsumePartialSequenceBytes(int num_bytes) {
   DCHECK_GE(partial_sequence_size_, num_bytes);
   partial_sequence_size_ -= num_bytes;
@@ -298,7 +382,6 @@ String TextCodecUTF8::Decode(const char* bytes,
 
   const uint8_t* source = reinterpret_cast<const uint8_t*>(bytes);
   const uint8_t* end = source + length;
-  const uint8_t* aligned_end = AlignToMachineWord(end);
   LChar* destination = buffer.Characters();
 
   do {
@@ -323,22 +406,7 @@ String TextCodecUTF8::Decode(const char* bytes,
     while (source < end) {
       if (IsASCII(*source)) {
         // Fast path for ASCII. Most UTF-8 text will be ASCII.
-        if (IsAlignedToMachineWord(source)) {
-          while (source < aligned_end) {
-            MachineWord chunk =
-                *reinterpret_cast_ptr<const MachineWord*>(source);
-            if (!IsAllASCII<LChar>(chunk))
-              break;
-            CopyASCIIMachineWord(destination, source);
-            source += sizeof(MachineWord);
-            destination += sizeof(MachineWord);
-          }
-          if (source == end)
-            break;
-          if (!IsASCII(*source))
-            continue;
-        }
-        *destination++ = *source++;
+        CopyASCIIRun(source, end, destination);
         continue;
       }
       int count = NonASCIISequenceLength(*source);
@@ -404,22 +472,7 @@ upConvertTo16Bit:
     while (source < end) {
       if (IsASCII(*source)) {
         // Fast path for ASCII. Most UTF-8 text will be ASCII.
-        if (IsAlignedToMachineWord(source)) {
-          while (source < aligned_end) {
-            MachineWord chunk =
-                *reinterpret_cast_ptr<const MachineWord*>(source);
-            if (!IsAllASCII<LChar>(chunk))
-              break;
-            CopyASCIIMachineWord(destination16, source);
-            source += sizeof(MachineWord);
-            destination16 += sizeof(MachineWord);
-          }
-          if (source == end)
-            break;
-          if (!IsASCII(*source))
-            continue;
-        }
-        *destination16++ = *source++;
+        CopyASCIIRun(source, end, destination16);
         continue;
       }
       int count = NonASCIISequenceLength(*source);
@@ -31,6 +31,7 @@
 #include "third_party/blink/renderer/platform/wtf/text/text_codec_utf8.h"
 
 #include <memory>
+#include <string>
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_codec.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
@@ -89,6 +90,37 @@ TEST(TextCodecUTF8, Decode0xFF) {
   EXPECT_EQ(0xFFFDU, result[0]);
 }
 
+TEST(TextCodecUTF8, DecodeLongRunsAroundNonASCII) {
+  TextEncoding encoding("UTF-8");
+  std::unique_ptr<TextCodec> codec(NewTextCodec(encoding));
+
+  // U+00E9 fits in 8 bits, and U+6F22 doesn't. Put each at every position of
+  // an ASCII run longer than the chunks the ASCII fast path copies.
+  struct {
+    const char* encoded;
+    UChar character;
+  } kNonASCII[] = {{"\xc3\xa9", 0xe9}, {"\xe6\xbc\xa2", 0x6f22}};
+  const unsigned kRunLength = 40;
+  for (const auto& non_ascii : kNonASCII) {
+    for (unsigned position = 0; position <= kRunLength; ++position) {
+      std::string input(kRunLength, 'a');
+      input.insert(position, non_ascii.encoded);
+
+      bool saw_error = false;
+      const String& result =
+          codec->Decode(input.data(), input.size(), FlushBehavior::kDataEOF,
+                        false, saw_error);
+      EXPECT_FALSE(saw_error);
+      ASSERT_EQ(kRunLength + 1, result.length());
+      EXPECT_EQ(non_ascii.character <= 0xff, result.Is8Bit());
+      for (unsigned i = 0; i <= kRunLength; ++i) {
+        EXPECT_EQ(i == position ? non_ascii.character : 'a', result[i])
+            << "at " << i;
+      }
+    }
+  }
+}
+
 }  // namespace
 
 }  // namespace WTF
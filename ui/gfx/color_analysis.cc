@@ -530,6 +530,9 @@ SkColor FindClosestColor(const uint8_t* image,
     if (distance_squared < best_distance_squared) {
       best_distance_squared = distance_squared;
       best_color = SkColorSetRGB(r, g, b);
+      // Nothing can be closer than an exact match.
+      if (distance_squared == 0)
+        break;
     }
   }
   return best_color;
@@ -632,6 +635,9 @@ SkColor CalculateKMeanColorOfBuffer(uint8_t* decoded_data,
           if (distance_sqr < distance_sqr_to_closest_cluster) {
             distance_sqr_to_closest_cluster = distance_sqr;
             closest_cluster = cluster;
+            // The pixel is at this centroid, so no later cluster can win.
+            if (distance_sqr == 0)
+              break;
           }
         }
 
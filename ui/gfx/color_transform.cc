@@ -901,7 +901,10 @@ class SkiaColorTransform : public ColorTransformStep {
  public:
   // Takes ownership of the profiles
   SkiaColorTransform(sk_sp<SkColorSpace> src, sk_sp<SkColorSpace> dst)
-      : src_(src), dst_(dst) {}
+      : src_(src), dst_(dst) {
+    src_->toProfile(&src_profile_);
+    dst_->toProfile(&dst_profile_);
+  }
   ~SkiaColorTransform() override {
     src_ = nullptr;
     dst_ = nullptr;
@@ -913,6 +916,7 @@ class SkiaColorTransform : public ColorTransformStep {
       return false;
     if (SkColorSpace::Equals(dst_.get(), next->src_.get())) {
       dst_ = next->dst_;
+      dst_profile_ = next->dst_profile_;
       return true;
     }
     return false;
@@ -925,21 +929,20 @@ class SkiaColorTransform : public ColorTransformStep {
   void Transform(ColorTransform::TriStim* colors, size_t num) const override {
     // We could do this either using Skia or skcms, but since skcms can handle
     // TriStim directly as skcms_PixelFormat_RGB_fff, let's use that.
-    skcms_ICCProfile src_profile, dst_profile;
-    src_->toProfile(&src_profile);
-    dst_->toProfile(&dst_profile);
-
     const skcms_PixelFormat kFFF = skcms_PixelFormat_RGB_fff;
     const skcms_AlphaFormat kUPM = skcms_AlphaFormat_Unpremul;
 
-    bool xform_result = skcms_Transform(colors, kFFF, kUPM, &src_profile,
-                                        colors, kFFF, kUPM, &dst_profile, num);
+    bool xform_result = skcms_Transform(colors, kFFF, kUPM, &src_profile_,
+                                        colors, kFFF, kUPM, &dst_profile_, num);
     DCHECK(xform_result);
   }
 
  private:
   sk_sp<SkColorSpace> src_;
   sk_sp<SkColorSpace> dst_;
+  // Profiles for |src_| and |dst_|, converted once rather than per call.
+  skcms_ICCProfile src_profile_;
+  skcms_ICCProfile dst_profile_;
 };
 
 sk_sp<SkColorSpace> ColorTransformInternal::GetSkColorSpaceIfNecessary(
@@ -5,8 +5,10 @@
 #include "ui/gfx/render_text_harfbuzz.h"
 
 #include <limits>
+#include <memory>
 #include <set>
 
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/containers/mru_cache.h"
 #include "base/feature_list.h"
@@ -16,6 +18,7 @@
 #include "base/i18n/break_iterator.h"
 #include "base/i18n/char_iterator.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ptr_util.h"
 #include "base/message_loop/message_loop_current.h"
 #include "base/no_destructor.h"
@@ -1082,6 +1085,24 @@ using ShapeRunCacheBase = base::HashingMRUCache<ShapeRunWithFontInput,
 class ShapeRunCache : public ShapeRunCacheBase {
  public:
   ShapeRunCache() : ShapeRunCacheBase(kShapeRunCacheSize) {}
+
+  // Drops all cached shapes under memory pressure from now on. Must be called
+  // on the thread that uses the cache.
+  void ListenForMemoryPressure() {
+    if (memory_pressure_listener_)
+      return;
+    memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+        base::BindRepeating(&ShapeRunCache::OnMemoryPressure,
+                            base::Unretained(this)));
+  }
+
+ private:
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level) {
+    Clear();
+  }
+
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 };
 
 void ShapeRunWithFont(const ShapeRunWithFontInput& in,
@@ -1899,6 +1920,7 @@ void RenderTextHarfBuzz::ShapeRunsWithFont(
         text, font_params, run->range, obscured(), glyph_width_for_test_,
         glyph_spacing(), subpixel_rendering_suppressed());
     if (can_use_cache) {
+      cache.get()->ListenForMemoryPressure();
       auto found = cache.get()->Get(cache_key);
       if (found != cache.get()->end()) {
         run->UpdateFontParamsAndShape(font_params, found->second);
@@ -0,0 +1,85 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <ctype.h>
+
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+namespace url {
+
+namespace {
+
+const int kNumIterations = 100000;
+
+// Returns typical URLs, already canonical, with a long path and query.
+std::vector<std::string> GenerateCanonicalUrls() {
+  std::vector<std::string> urls;
+  for (int i = 0; i < 100; ++i) {
+    urls.push_back("https://www.example" + std::to_string(i) +
+                   ".com/static/js/application.bundle.min.js?v=" +
+                   std::to_string(i * 7919) + "&lang=en-US&callback=init");
+  }
+  return urls;
+}
+
+void TestConstruction(const std::string& description,
+                      const std::vector<std::string>& urls) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  size_t total_length = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    GURL url(urls[i % urls.size()]);
+    total_length += url.spec().length();
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+  EXPECT_GT(total_length, 0u);
+  perf_test::PrintResult("GURL", "", description,
+                         elapsed.InMicrosecondsF() / kNumIterations,
+                         "us/url", true);
+}
+
+}  // namespace
+
+TEST(GURLPerfTest, CanonicalUrls) {
+  TestConstruction("canonical", GenerateCanonicalUrls());
+}
+
+TEST(GURLPerfTest, NonCanonicalUrls) {
+  std::vector<std::string> urls;
+  for (const std::string& url : GenerateCanonicalUrls()) {
+    // Upper case the host and escape some of the path and query.
+    std::string non_canonical = url;
+    for (size_t i = 8; i < 20; ++i)
+      non_canonical[i] = toupper(non_canonical[i]);
+    non_canonical += "&q=a b|c";
+    non_canonical.insert(non_canonical.find("/static"), "/./a/..");
+    urls.push_back(non_canonical);
+  }
+  TestConstruction("non-canonical", urls);
+}
+
+TEST(GURLPerfTest, WideUrls) {
+  std::vector<base::string16> urls;
+  for (const std::string& url : GenerateCanonicalUrls())
+    urls.push_back(base::string16(url.begin(), url.end()));
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  size_t total_length = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    GURL url(urls[i % urls.size()]);
+    total_length += url.spec().length();
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+  EXPECT_GT(total_length, 0u);
+  perf_test::PrintResult("GURL", "", "canonical UTF-16",
+                         elapsed.InMicrosecondsF() / kNumIterations,
+                         "us/url", true);
+}
+
+}  // namespace url
@@ -0,0 +1,103 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "url/interned_origin.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "base/hash.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+
+namespace url {
+
+namespace {
+
+// The scheme, host and port of a tuple origin, which identify it. The
+// serialization doesn't, as it leaves out the host of file origins.
+using Key = std::tuple<base::StringPiece, base::StringPiece, uint16_t>;
+
+struct KeyHash {
+  size_t operator()(const Key& key) const {
+    base::StringPieceHash string_hash;
+    return base::HashInts(base::HashInts(string_hash(std::get<0>(key)),
+                                         string_hash(std::get<1>(key))),
+                          std::get<2>(key));
+  }
+};
+
+Key GetKey(const Origin& origin) {
+  return Key(origin.scheme(), origin.host(), origin.port());
+}
+
+}  // namespace
+
+struct InternedOrigin::Entry {
+  explicit Entry(const Origin& origin)
+      : origin(origin),
+        serialization(origin.Serialize()),
+        hash(KeyHash()(GetKey(this->origin))) {}
+
+  const Origin origin;
+  const std::string serialization;
+  const size_t hash;
+};
+
+// static
+InternedOrigin InternedOrigin::Intern(const Origin& origin) {
+  return Lookup(origin, true /* insert */);
+}
+
+// static
+InternedOrigin InternedOrigin::Find(const Origin& origin) {
+  return Lookup(origin, false /* insert */);
+}
+
+// static
+InternedOrigin InternedOrigin::Lookup(const Origin& origin, bool insert) {
+  if (origin.unique())
+    return InternedOrigin();
+
+  // Maps the keys of interned origins to their entries. The keys point into
+  // the entries, which are never freed.
+  using EntryMap =
+      std::unordered_map<Key, std::unique_ptr<const Entry>, KeyHash>;
+  static base::NoDestructor<base::Lock> lock;
+  static base::NoDestructor<EntryMap> entries;
+
+  Key key = GetKey(origin);
+  base::AutoLock auto_lock(*lock);
+  auto it = entries->find(key);
+  if (it != entries->end())
+    return InternedOrigin(it->second.get());
+  if (!insert)
+    return InternedOrigin();
+  auto entry = std::make_unique<const Entry>(origin);
+  const Entry* result = entry.get();
+  entries->emplace(GetKey(result->origin), std::move(entry));
+  return InternedOrigin(result);
+}
+
+const Origin& InternedOrigin::origin() const {
+  static const base::NoDestructor<Origin> opaque_origin;
+  return entry_ ? entry_->origin : *opaque_origin;
+}
+
+const std::string& InternedOrigin::Serialize() const {
+  static const base::NoDestructor<std::string> opaque_serialization(
+      Origin().Serialize());
+  return entry_ ? entry_->serialization : *opaque_serialization;
+}
+
+size_t InternedOrigin::hash() const {
+  return entry_ ? entry_->hash : 0;
+}
+
+}  // namespace url
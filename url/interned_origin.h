@@ -0,0 +1,97 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef URL_INTERNED_ORIGIN_H_
+#define URL_INTERNED_ORIGIN_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "url/origin.h"
+#include "url/url_export.h"
+
+namespace url {
+
+// InternedOrigin is a compact handle to a tuple origin stored once per
+// process, along with its serialization and hash. Comparing, hashing and
+// serializing handles is constant time and copying one copies a pointer,
+// which makes them a good fit for origins that hot code keeps around and
+// compares against repeatedly, e.g. as keys of permission maps.
+//
+// Interning an origin looks up its scheme, host and port in a table guarded by
+// a lock, so it only pays off when the handle is reused. Interned origins are
+// never freed, so only intern origins from bounded sets, such as the ones a
+// process has been granted access to. Checks of arbitrary origins against
+// those must use Find(), which doesn't add to the table.
+//
+// Opaque origins aren't interned: the handle of an opaque origin is like a
+// default constructed url::Origin, cross-origin to every origin, including
+// itself, and serialized to "null". Code that needs the identity of opaque
+// origins must keep using url::Origin.
+class URL_EXPORT InternedOrigin {
+ public:
+  // For use in unordered containers.
+  struct Hash {
+    size_t operator()(const InternedOrigin& origin) const {
+      return origin.hash();
+    }
+  };
+
+  // Creates the handle of an opaque origin.
+  InternedOrigin() : entry_(nullptr) {}
+
+  // Returns the handle of |origin|, interning it if needed. Can be called on
+  // any thread.
+  static InternedOrigin Intern(const Origin& origin);
+
+  // Returns the handle of |origin| if it was interned, or the handle of an
+  // opaque origin otherwise, which is cross-origin to every interned origin.
+  // Can be called on any thread.
+  static InternedOrigin Find(const Origin& origin);
+
+  InternedOrigin(const InternedOrigin&) = default;
+  InternedOrigin& operator=(const InternedOrigin&) = default;
+
+  bool unique() const { return !entry_; }
+
+  // The interned origin, or an opaque origin.
+  const Origin& origin() const;
+
+  // Same as origin().Serialize(), without building the string.
+  const std::string& Serialize() const;
+
+  size_t hash() const;
+
+  // Same as origin().IsSameOriginWith(other.origin()).
+  bool IsSameOriginWith(const InternedOrigin& other) const {
+    return entry_ && entry_ == other.entry_;
+  }
+  bool operator==(const InternedOrigin& other) const {
+    return IsSameOriginWith(other);
+  }
+  bool operator!=(const InternedOrigin& other) const {
+    return !IsSameOriginWith(other);
+  }
+
+  // Orders interned origins by address, for use in std::map and base::flat_*
+  // containers. The order isn't meaningful, and changes across runs.
+  bool operator<(const InternedOrigin& other) const {
+    return entry_ < other.entry_;
+  }
+
+ private:
+  struct Entry;
+
+  explicit InternedOrigin(const Entry* entry) : entry_(entry) {}
+
+  // Implements Intern() and Find().
+  static InternedOrigin Lookup(const Origin& origin, bool insert);
+
+  const Entry* entry_;
+};
+
+}  // namespace url
+
+#endif  // URL_INTERNED_ORIGIN_H_
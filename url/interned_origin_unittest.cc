@@ -0,0 +1,105 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "url/interned_origin.h"
+
+#include <unordered_set>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace url {
+
+TEST(InternedOriginTest, SameOrigin) {
+  InternedOrigin a =
+      InternedOrigin::Intern(Origin::Create(GURL("https://example.com/a")));
+  InternedOrigin b =
+      InternedOrigin::Intern(Origin::Create(GURL("https://example.com:443/b")));
+  InternedOrigin c =
+      InternedOrigin::Intern(Origin::Create(GURL("https://example.com:8443")));
+  InternedOrigin d =
+      InternedOrigin::Intern(Origin::Create(GURL("http://example.com/")));
+
+  EXPECT_FALSE(a.unique());
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.hash(), b.hash());
+  EXPECT_NE(a, c);
+  EXPECT_NE(a, d);
+  EXPECT_NE(c, d);
+  EXPECT_TRUE(a.origin().IsSameOriginWith(b.origin()));
+  EXPECT_EQ("example.com", a.origin().host());
+}
+
+// File origins serialize to "file://" whatever their host, but different
+// hosts are still different origins.
+TEST(InternedOriginTest, FileHosts) {
+  InternedOrigin a =
+      InternedOrigin::Intern(Origin::Create(GURL("file://host-a/file")));
+  InternedOrigin b =
+      InternedOrigin::Intern(Origin::Create(GURL("file://host-b/file")));
+  InternedOrigin local =
+      InternedOrigin::Intern(Origin::Create(GURL("file:///file")));
+  EXPECT_EQ(a.Serialize(), b.Serialize());
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, local);
+  EXPECT_EQ("host-a", a.origin().host());
+  EXPECT_EQ("host-b", b.origin().host());
+  EXPECT_EQ(a, InternedOrigin::Intern(Origin::Create(GURL("file://host-a/"))));
+}
+
+TEST(InternedOriginTest, Find) {
+  const Origin origin = Origin::Create(GURL("https://find.example.com"));
+  EXPECT_TRUE(InternedOrigin::Find(origin).unique());
+  EXPECT_TRUE(InternedOrigin::Find(origin).unique());
+
+  InternedOrigin interned = InternedOrigin::Intern(origin);
+  EXPECT_EQ(interned, InternedOrigin::Find(origin));
+  EXPECT_TRUE(
+      InternedOrigin::Find(Origin::Create(GURL("https://other.example.com")))
+          .unique());
+  EXPECT_TRUE(
+      InternedOrigin::Find(Origin::Create(GURL("data:text/plain,hi"))).unique());
+}
+
+TEST(InternedOriginTest, Serialize) {
+  const char* const kUrls[] = {
+      "https://example.com/",  "http://example.com:8080/path",
+      "https://[::1]:8443/",   "file:///etc/passwd",
+      "blob:https://a.com/id", "filesystem:http://b.com/temporary/",
+  };
+  for (const char* url : kUrls) {
+    SCOPED_TRACE(url);
+    Origin origin = Origin::Create(GURL(url));
+    InternedOrigin interned = InternedOrigin::Intern(origin);
+    EXPECT_EQ(origin.Serialize(), interned.Serialize());
+    EXPECT_TRUE(origin.IsSameOriginWith(interned.origin()));
+  }
+}
+
+TEST(InternedOriginTest, Opaque) {
+  InternedOrigin opaque =
+      InternedOrigin::Intern(Origin::Create(GURL("data:text/plain,hi")));
+  EXPECT_TRUE(opaque.unique());
+  EXPECT_TRUE(opaque.origin().unique());
+  EXPECT_EQ("null", opaque.Serialize());
+  // Opaque origins are cross-origin to everything, even themselves.
+  EXPECT_NE(opaque, opaque);
+  EXPECT_NE(opaque, InternedOrigin());
+  EXPECT_TRUE(InternedOrigin().unique());
+}
+
+TEST(InternedOriginTest, UnorderedSet) {
+  std::unordered_set<InternedOrigin, InternedOrigin::Hash> origins;
+  origins.insert(InternedOrigin::Intern(Origin::Create(GURL("https://a.com"))));
+  origins.insert(InternedOrigin::Intern(Origin::Create(GURL("https://b.com"))));
+  origins.insert(
+      InternedOrigin::Intern(Origin::Create(GURL("https://a.com/path"))));
+  EXPECT_EQ(2u, origins.size());
+  EXPECT_EQ(1u, origins.count(InternedOrigin::Intern(
+                    Origin::Create(GURL("https://b.com:443")))));
+  EXPECT_EQ(0u, origins.count(InternedOrigin::Intern(
+                    Origin::Create(GURL("https://c.com")))));
+}
+
+}  // namespace url
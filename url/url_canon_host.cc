@@ -67,6 +67,12 @@ const unsigned char kHostCharLookup[0x80] = {
 //   p    q    r    s    t    u    v    w    x    y    z    {    |    }    ~
     'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',kEsc,kEsc,kEsc,  0 ,  0 };
 
+// Returns true if |ch| is its own canonical form in a host name, which is the
+// case of most characters of typical, lower case, host names.
+inline bool IsCanonicalHostChar(unsigned int ch) {
+  return ch > 0 && ch < 0x80 && kHostCharLookup[ch] == ch;
+}
+
 // RFC1034 maximum FQDN length.
 constexpr int kMaxHostLength = 253;
 
@@ -132,6 +138,16 @@ bool DoSimpleHost(const INCHAR* host,
   bool success = true;
   for (int i = 0; i < host_len; ++i) {
     unsigned int source = host[i];
+    if (IsCanonicalHostChar(source)) {
+      // Copy the whole run of characters that are already canonical at once.
+      int run_end = i + 1;
+      while (run_end < host_len && IsCanonicalHostChar(host[run_end]))
+        run_end++;
+      AppendASCIIRun(&host[i], run_end - i, output);
+      i = run_end - 1;
+      continue;
+    }
+
     if (source == '%') {
       // Unescape first, if possible.
       // Source will be used only if decode operation was successful.
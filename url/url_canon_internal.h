@@ -136,6 +136,27 @@ inline void AppendEscapedChar(UINCHAR ch,
   output->push_back(kHexCharLookup[ch & 0xf]);
 }
 
+// Appends the |length| 7-bit characters at |source| to |output|. Copying a
+// run of characters that need no canonicalization at once is much faster
+// than pushing them back one at a time.
+inline void AppendASCIIRun(const char* source,
+                           int length,
+                           CanonOutputT<char>* output) {
+  output->Append(source, length);
+}
+inline void AppendASCIIRun(const base::char16* source,
+                           int length,
+                           CanonOutputT<base::char16>* output) {
+  output->Append(source, length);
+}
+template <typename INCHAR, typename OUTCHAR>
+inline void AppendASCIIRun(const INCHAR* source,
+                           int length,
+                           CanonOutputT<OUTCHAR>* output) {
+  for (int i = 0; i < length; i++)
+    output->push_back(static_cast<OUTCHAR>(source[i]));
+}
+
 // The character we'll substitute for undecodable or invalid characters.
 extern const base::char16 kUnicodeReplacementCharacter;
 
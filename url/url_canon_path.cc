@@ -77,6 +77,21 @@ const unsigned char kPathCharLookup[0x100] = {
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE};
 
+// Returns the end of the run of characters starting at |begin| that are
+// copied to the output unchanged, which is most of a typical path.
+template <typename CHAR, typename UCHAR>
+int FindEndOfPassThroughRun(const CHAR* spec, int begin, int end) {
+  int i = begin;
+  for (; i < end; i++) {
+    UCHAR uch = static_cast<UCHAR>(spec[i]);
+    // Non-7-bit characters are all ESCAPE in the table, but wide ones are
+    // outside of it.
+    if (uch >= 0x80 || (kPathCharLookup[uch] & SPECIAL))
+      break;
+  }
+  return i;
+}
+
 enum DotDisposition {
   // The given dot is just part of a filename and is not special.
   NOT_A_DIRECTORY,
@@ -369,8 +384,11 @@ bool DoPartialPath(const CHAR* spec,
           AppendEscapedChar(out_ch, output);
         }
       } else {
-        // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        // Nothing special about this character, nor usually about the ones
+        // following it: append them all at once.
+        int run_end = FindEndOfPassThroughRun<CHAR, UCHAR>(spec, i + 1, end);
+        AppendASCIIRun(&spec[i], run_end - i, output);
+        i = run_end - 1;
       }
     }
   }
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "url/url_canon.h"
 #include "url/url_canon_internal.h"
 
@@ -40,15 +42,14 @@ namespace url {
 namespace {
 
 // Returns true if the characters starting at |begin| and going until |end|
-// (non-inclusive) are all representable in 7-bits.
-template<typename CHAR, typename UCHAR>
-bool IsAllASCII(const CHAR* spec, const Component& query) {
-  int end = query.end();
-  for (int i = query.begin; i < end; i++) {
-    if (static_cast<UCHAR>(spec[i]) >= 0x80)
-      return false;
-  }
-  return true;
+// (non-inclusive) are all representable in 7-bits. base::IsStringASCII()
+// checks a machine word at a time.
+bool IsAllASCII(const char* spec, const Component& query) {
+  return base::IsStringASCII(base::StringPiece(&spec[query.begin], query.len));
+}
+bool IsAllASCII(const base::char16* spec, const Component& query) {
+  return base::IsStringASCII(
+      base::StringPiece16(&spec[query.begin], query.len));
 }
 
 // Appends the given string to the output, escaping characters that do not
@@ -59,10 +60,19 @@ template<typename CHAR>
 void AppendRaw8BitQueryString(const CHAR* source, int length,
                               CanonOutput* output) {
   for (int i = 0; i < length; i++) {
-    if (!IsQueryChar(static_cast<unsigned char>(source[i])))
+    if (!IsQueryChar(static_cast<unsigned char>(source[i]))) {
       AppendEscapedChar(static_cast<unsigned char>(source[i]), output);
-    else  // Doesn't need escaping.
-      output->push_back(static_cast<char>(source[i]));
+    } else {
+      // Doesn't need escaping, and neither do most of the following
+      // characters: append them all at once.
+      int run_end = i + 1;
+      while (run_end < length &&
+             IsQueryChar(static_cast<unsigned char>(source[run_end]))) {
+        run_end++;
+      }
+      AppendASCIIRun(&source[i], run_end - i, output);
+      i = run_end - 1;
+    }
   }
 }
 
@@ -94,7 +104,7 @@ void DoConvertToQueryEncoding(const CHAR* spec,
                               const Component& query,
                               CharsetConverter* converter,
                               CanonOutput* output) {
-  if (IsAllASCII<CHAR, UCHAR>(spec, query)) {
+  if (IsAllASCII(spec, query)) {
     // Easy: the input can just appended with no character set conversions.
     AppendRaw8BitQueryString(&spec[query.begin], query.len, output);
 
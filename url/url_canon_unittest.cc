@@ -1153,6 +1153,8 @@ TEST(URLCanonTest, Path) {
       // Don't erroneously downcast a UTF-16 charater in a way that makes it
       // look like part of an escape sequence.
     {NULL, L"/%%41\x0130", "/%A%C4%B0", Component(0, 9), true},
+      // Long runs of characters copied unchanged, around ones that aren't.
+    {"/abcdefghijklmnopqrstuvwxyz/0123456789%41\\ABC.D/-_~\tZ", L"/abcdefghijklmnopqrstuvwxyz/0123456789%41\\ABC.D/-_~\tZ", "/abcdefghijklmnopqrstuvwxyz/0123456789A/ABC.D/-_~%09Z", Component(0, 53), true},
 
     // ----- encoding tests -----
       // Basic conversions